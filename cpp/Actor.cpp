@@ -44,9 +44,24 @@ https://opensource.org/licenses/MIT
 #include <thread>
 #include "actors/Queue.hpp"
 #include "actors/BQueue.hpp"
+#include "actors/SPSCQueue.hpp"
+#include "actors/MPSCQueue.hpp"
+#include "actors/ConflatingQueue.hpp"
+#include "actors/LaneQueue.hpp"
+#include "actors/Backoff.hpp"
+#include "actors/Scheduler.hpp"
 #include "actors/msg/Shutdown.hpp"
+#include "actors/msg/Start.hpp"
+#include "actors/msg/Timeout.hpp"
+#include "actors/msg/Resume.hpp"
+#include "actors/msg/MailboxFull.hpp"
+#include "actors/act/Group.hpp"
+#include "actors/act/Manager.hpp"
 #include "actors/Actor.hpp"
 #include "actors/ActorRef.hpp"
+#include "actors/Coroutine.hpp"
+#include "actors/Journal.hpp"
+#include "actors/Trace.hpp"
 
 #include <unistd.h>
 #include <sys/syscall.h>
@@ -55,6 +70,38 @@ https://opensource.org/licenses/MIT
 using namespace std;
 using namespace actors;
 
+// Offsets of an Actor that is not standard-layout; fine with g++ and clang
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+namespace
+{
+  constexpr size_t line(size_t offset) { return offset / 64; }
+}
+
+struct Actor::Layout
+{
+  static constexpr size_t send_line = line(offsetof(Actor, msgq));
+  static constexpr size_t own_line = line(offsetof(Actor, reply_to));
+
+  // See the comment above the data members in Actor.hpp
+  static_assert(line(offsetof(Actor, scheduler)) == send_line && line(offsetof(Actor, group)) == send_line &&
+                line(offsetof(Actor, queue_limit)) == send_line && line(offsetof(Actor, high_watermark)) == send_line &&
+                line(offsetof(Actor, intake)) == send_line && line(offsetof(Actor, sched_state)) == send_line &&
+                line(offsetof(Actor, mailbox)) == send_line && line(offsetof(Actor, overflow)) == send_line &&
+                line(offsetof(Actor, actor_id)) == send_line && line(offsetof(Actor, above_high)) == send_line &&
+                line(offsetof(Actor, terminated)) == send_line,
+                "what send() reads must fit one cache line");
+  static_assert(own_line > send_line, "the sender line must not hold per-message state");
+  static_assert(line(offsetof(Actor, current)) == own_line && line(offsetof(Actor, current_from)) == own_line &&
+                line(offsetof(Actor, reply_message)) == own_line && line(offsetof(Actor, journal_)) == own_line,
+                "per-message state should start on one line");
+  static_assert(line(offsetof(Actor, counters_.dropped)) != line(offsetof(Actor, counters_.messages)),
+                "sender and handler counters must not share a line");
+  static_assert(offsetof(Actor, name) % 64 == 0 && offsetof(Actor, name) > offsetof(Actor, peers_),
+                "configuration must come after the hot state");
+};
+#pragma GCC diagnostic pop
+
 Actor::~Actor()
 {
   delete msgq;
@@ -62,9 +109,7 @@ Actor::~Actor()
 
 Actor::Actor()
 {
-  msgq = new BQueue<const Message *>(ACTOR_BQUEUE_SIZE);
-  handler_cache.resize(ACTOR_HANDLER_CACHE_SIZE, nullptr);
-  dont_have_handler.resize(ACTOR_HANDLER_CACHE_SIZE, false);
+  msgq = new BQueue<Delivery>(ACTOR_BQUEUE_SIZE);
 
   // Initialize name with typeid
   const char* type_name = typeid(*this).name();
@@ -76,79 +121,209 @@ void Actor::send(const Message *m, Actor *sender) noexcept
 {
   assert(this != nullptr && "send to null actor");
 
-  if (terminated)
+  assert(m != nullptr && "null message");
+
+  if (terminated) {
+    m->release();
     return;
+  }
 
+  // The message itself is not touched: it may be shared
+  Delivery d{m, sender, this};
+  if (mailbox == MailboxType::PRIORITY)
+    d.lane = lane_for(m);
+  enqueue(d);
+}
+
+void Actor::send_lane(const Message *m, Lane lane, Actor *sender) noexcept
+{
   assert(m != nullptr && "null message");
-  assert(m->destination == nullptr && "cannot reuse message");
 
-  m->is_fast = false;
-  m->last = false;
-  m->sender = sender;
-  m->destination = this;
+  if (terminated) {
+    m->release();
+    return;
+  }
 
-  add_message_to_queue(m);
+  Delivery d{m, sender, this};
+  if (mailbox == MailboxType::PRIORITY)
+    d.lane = lane;
+  enqueue(d);
+}
+
+void Actor::enqueue(Delivery &d) noexcept
+{
+  if (intake.load(std::memory_order_relaxed) != INTAKE_OPEN && !admitted(d)) {
+    counters_.dropped.fetch_add(1, std::memory_order_relaxed);
+    d.msg->release();
+    return;
+  }
+
+#ifdef ACTOR_LATENCY
+  d.enqueue_tsc = read_tsc();
+#endif
+#ifdef ACTOR_TRACE
+  if (trace::enabled()) {
+    d.trace_flow = trace::new_flow();
+    trace::record(trace::Kind::ENQUEUE, d.msg->id(), d.sender ? d.sender->actor_id : NO_ACTOR_ID,
+                  actor_id, d.trace_flow);
+  }
+#endif
+
+  // Group members share the group's mailbox
+  if (group) {
+    group->post(d);
+    return;
+  }
+  add_message_to_queue(d);
+}
+
+// While draining, only managed actors of our manager may still send (and the manager its Shutdown)
+bool Actor::admitted(const Delivery &d) const noexcept
+{
+  if (d.msg->id() == msg::Shutdown::message_id)
+    return true;
+  return d.sender && d.sender->manager && d.sender->manager == manager;
 }
 
 bool Actor::call_handler(const Message *m) noexcept
 {
-  auto id = m->get_message_id();
-  auto f0 = handler_cache[id];
-  if (f0) {
-    (this->*f0)(m);
+  if (handlers_dirty)
+    seal_handlers();
+
+  auto id = m->id();
+  auto f = handler_table.find(id);
+  if (f) {
+    (this->*f)(m);
     return true;
   }
-  if (dont_have_handler[id]) {
+
+  if (handlers.empty())
     return false;
-  }
-  auto midx = std::type_index(typeid(*m));
-  auto p = handlers.find(midx);
-  if (p == handlers.end()) {
-    dont_have_handler[id] = true;
+
+  // Type registered without a compile-time ID: resolve once, then by ID
+  auto p = handlers.find(std::type_index(typeid(*m)));
+  if (p == handlers.end())
     return false;
-  }
-  auto f = p->second;
+  f = p->second;
+  add_handler(id, f);
   (this->*f)(m);
-  handler_cache[id] = f;
   return true;
 }
 
-void Actor::process_message_internal(const Message *m) noexcept
+void Actor::seal_handlers()
+{
+  handler_table.build({id_handlers.begin(), id_handlers.end()});
+  handlers_dirty = false;
+}
+
+void Actor::process_message_internal(const Delivery &d) noexcept
+{
+  if (dispatch_mode == DispatchMode::ASYNC_ONLY) {
+    dispatch(d);
+    return;
+  }
+  std::lock_guard<DispatchLock> lock(fast_send_mutex);
+  dispatch(d);
+}
+
+void Actor::dispatch(const Delivery &d) noexcept
 {
-  std::lock_guard<std::mutex> lock(fast_send_mutex);
   assert(this != nullptr && "no actor to handle message");
 
-  msg_cnt++;
+  const Message *m = d.msg;
+  counters_.count_message();
   using_fast_send = false;
 
+#ifdef ACTOR_LATENCY
+  auto t0 = read_tsc();
+  auto id = m->id();
+  auto waited = t0 - d.enqueue_tsc;
+#endif
+
+#ifdef ACTOR_TRACE
+  const ActorId from = d.sender ? d.sender->actor_id : NO_ACTOR_ID;
+  trace::record(trace::Kind::HANDLER_BEGIN, m->id(), from, actor_id, d.trace_flow);
+#endif
+
+  if (track_peers && d.sender && d.sender->actor_id != NO_ACTOR_ID)
+    peers_.record(d.sender->actor_id);
+
+  current = m;
+  current_from = d.sender;
   bool called = call_handler(m);
   if (!called)
     process_message(m);
+  current = nullptr;
+  current_from = nullptr;
+
+#ifdef ACTOR_TRACE
+  trace::record(trace::Kind::HANDLER_END, m->id(), from, actor_id);
+#endif
+
+#ifdef ACTOR_LATENCY
+  auto ran = read_tsc() - t0;
+  latency_.queue_wait.record(waited);
+  latency_.handler.record(ran);
+  if (latency_by_id) {
+    auto &h = latency_.for_id(id);
+    h.queue_wait.record(waited);
+    h.handler.record(ran);
+  }
+#endif
 
-  delete m;
+  if (keep_current)
+    keep_current = false;  // a suspended coroutine handler releases it
+  else
+    m->release();
 }
 
 std::unique_ptr<const Message> Actor::fast_send(const Message *m, Actor *sender) noexcept
 {
-  std::lock_guard<std::mutex> lock(fast_send_mutex);
+  assert(accepts_fast_send() && "fast_send to running ASYNC_ONLY actor");
+  std::lock_guard<DispatchLock> lock(fast_send_mutex);
 
   assert(this != nullptr && "fast send to null actor");
   assert(m != nullptr && "fast send with no message");
   assert(this != sender && "fast send to itself");
 
-  m->sender = sender;
-  m->is_fast = true;
-  m->last = true;
   reply_message = nullptr;
   using_fast_send = true;
-  msg_cnt++;
+  counters_.count_message();
 
   if (terminated)
     return std::unique_ptr<const Message>(reply_message);
 
+#ifdef ACTOR_LATENCY
+  auto t0 = read_tsc();
+#endif
+
+#ifdef ACTOR_TRACE
+  const ActorId from = sender ? sender->actor_id : NO_ACTOR_ID;
+  trace::record(trace::Kind::HANDLER_BEGIN, m->id(), from, actor_id);
+#endif
+
+  if (track_peers && sender && sender->actor_id != NO_ACTOR_ID)
+    peers_.record(sender->actor_id);
+
+  current = m;
+  current_from = sender;
+  batch_drained = true;
   bool called = call_handler(m);
   if (!called)
     process_message(m);
+  current = nullptr;
+  current_from = nullptr;
+
+#ifdef ACTOR_TRACE
+  trace::record(trace::Kind::HANDLER_END, m->id(), from, actor_id);
+#endif
+
+#ifdef ACTOR_LATENCY
+  auto ran = read_tsc() - t0;
+  latency_.handler.record(ran);
+  if (latency_by_id)
+    latency_.for_id(m->id()).handler.record(ran);
+#endif
 
   return std::unique_ptr<const Message>(reply_message);
 }
@@ -156,33 +331,155 @@ std::unique_ptr<const Message> Actor::fast_send(const Message *m, Actor *sender)
 void Actor::operator()() noexcept
 {
   tid = syscall(SYS_gettid);
-  std::cerr << endl << get_name() << " tid: " << tid << endl;
+  running.store(true, std::memory_order_relaxed);
+  seal_handlers();
   init();
+  if (manager)
+    manager->actor_ready();  // startup barrier; returns once Start is queued for everyone
+
+  const std::size_t max_batch = batch_size > 0 ? batch_size : 1;
+  std::vector<Delivery> batch(max_batch);
+  bool done = false;
+
+  while (!done) {
+    bool last = false;
+    std::size_t n = wait_for_messages(batch.data(), max_batch, last);
+    done = process_batch(batch.data(), n, last);
+    if (above_high.load(std::memory_order_relaxed))
+      check_low_watermark();
+  }
+
+  terminated = true;
+  end();
+  if (manager)
+    manager->actor_stopped(this);
+}
+
+// Returns true once Shutdown has been handled or the actor terminated
+bool Actor::process_batch(Delivery *batch, std::size_t n, bool last) noexcept
+{
+  bool done = false;
+
+  // The mailbox only grows between drains, so sampling here catches its peak
+  counters_.observe_queue(last ? n : n + msgq->length());
 
-  while (true) {
-    auto r = msgq->pop();
-    auto *m = std::get<0>(r);
-    auto last = std::get<1>(r);
-    m->last = last;
-    reply_to = m->sender;
+  // One lock acquisition covers the whole batch; async-only actors need none
+  const bool locked = dispatch_mode != DispatchMode::ASYNC_ONLY;
+  if (locked)
+    fast_send_mutex.lock();
 
-    bool is_shutdown = m->get_message_id() == 5;
+  for (std::size_t i = 0; i < n; i++) {
+    const Delivery &d = batch[i];
+    if (done) {
+      d.msg->release();  // drained after Shutdown, never delivered
+      continue;
+    }
+    if (intake.load(std::memory_order_relaxed) == INTAKE_DISCARDING &&
+        d.msg->id() != msg::Shutdown::message_id) {
+      d.msg->release();  // still queued at the drain deadline
+      continue;
+    }
 
-    process_message_internal(m);
+    batch_drained = last && i == n - 1;
 
-    if (is_shutdown || terminated) {
-      break;
+#ifdef ACTOR_TRACE
+    trace::record(trace::Kind::DEQUEUE, d.msg->id(), d.sender ? d.sender->actor_id : NO_ACTOR_ID,
+                  d.to->actor_id, d.trace_flow);
+#endif
+
+    // Only a Group queues messages for other actors: its members
+    if (d.to != this) {
+      assert(d.to->group == this && "message for another actor");
+      static_cast<Group *>(this)->deliver(d);
+      continue;
     }
+
+    if (journal_)
+      journal_->append(d.msg);
+    reply_to = d.sender;
+
+    bool is_shutdown = d.msg->id() == msg::Shutdown::message_id;
+    bool is_start = d.msg->id() == msg::Start::message_id;
+
+    dispatch(d);
+
+    if (is_start && manager)
+      manager->actor_started(this);
+    if (is_shutdown || terminated)
+      done = true;
   }
 
-  terminated = true;
-  end();
+  if (locked)
+    fast_send_mutex.unlock();
+
+  return done;
+}
+
+// Pooled counterpart of the prologue of operator()(), run before any worker starts
+void Actor::start_pooled()
+{
+  running.store(true, std::memory_order_relaxed);
+  seal_handlers();
+  init();
+}
+
+// Called by a pool worker: drain up to budget messages without blocking.
+// Returns false once the actor has shut down.
+bool Actor::run_slice(std::size_t budget) noexcept
+{
+  Delivery batch[ACTOR_POOL_SLICE];
+  std::size_t chunk = batch_size > 0 ? batch_size : 1;
+  if (chunk > ACTOR_POOL_SLICE)
+    chunk = ACTOR_POOL_SLICE;
+
+  std::size_t handled = 0;
+  while (handled < budget) {
+    bool last = false;
+    std::size_t want = budget - handled < chunk ? budget - handled : chunk;
+    std::size_t n = msgq->try_pop_batch(batch, want, last);
+    if (n == 0)
+      return true;
+
+    if (process_batch(batch, n, last)) {
+      terminated = true;
+      end();
+      if (manager)
+        manager->actor_stopped(this);
+      return false;
+    }
+    handled += n;
+  }
+  if (above_high.load(std::memory_order_relaxed))
+    check_low_watermark();
+  return true;
+}
+
+std::size_t Actor::wait_for_messages(Delivery *out, std::size_t max, bool &last) noexcept
+{
+  std::size_t n;
+
+  switch (wait) {
+  case WaitStrategy::SPIN:
+    while ((n = msgq->try_pop_batch(out, max, last)) == 0)
+      cpu_relax();
+    return n;
+  case WaitStrategy::SPIN_THEN_PARK:
+    for (int i = 0; i < ACTOR_WAIT_SPIN_LIMIT; i++) {
+      if ((n = msgq->try_pop_batch(out, max, last)) != 0)
+        return n;
+      cpu_relax();
+    }
+    break;
+  case WaitStrategy::BLOCK:
+    break;
+  }
+
+  return msgq->pop_batch(out, max, last);
 }
 
 void Actor::reply(const Message *m) noexcept
 {
   if (using_fast_send) {
-    m->sender = this;
     reply_message = m;
   } else {
     assert(reply_to != nullptr && "no return address");
@@ -194,18 +491,118 @@ void Actor::terminate() noexcept
 {
   terminate_called = true;
   this->send(new msg::Shutdown());
-  sleep(3);
 }
 
 void Actor::fast_terminate() noexcept
 {
   terminate_called = true;
+  if (dispatch_mode == DispatchMode::ASYNC_ONLY && running.load(std::memory_order_relaxed)) {
+    this->send(new msg::Shutdown());  // must not run handlers beside the actor thread
+    return;
+  }
   this->fast_send(new msg::Shutdown(), nullptr);
 }
 
-void Actor::add_message_to_queue(const Message *m)
+Lane Actor::lane_for(const Message *m) const noexcept
+{
+  int id = m->id();
+  auto it = lanes_by_id.find(id);
+  if (it != lanes_by_id.end())
+    return it->second;
+  if (id == msg::Shutdown::message_id || id == msg::Start::message_id)
+    return Lane::CONTROL;
+  return Lane::NORMAL;
+}
+
+// Sent by the Manager, the TimerWheel or a coroutine, from threads of their own
+static bool framework_message(int id) noexcept
+{
+  return id == msg::Start::message_id || id == msg::Shutdown::message_id ||
+         id == msg::Timeout::message_id || id == msg::Resume::message_id;
+}
+
+void Actor::add_message_to_queue(const Delivery &d)
+{
+  // An SPSC ring has room for one producer: the framework's messages go beside it.
+  // CONTROL is only ever set on a PRIORITY mailbox.
+  // Shutdown is never held back or dropped by a limit.
+  if (mailbox == MailboxType::SPSC && framework_message(d.msg->id()))
+    msgq->push_control(d);
+  else if (queue_limit == 0 || d.lane == Lane::CONTROL || d.msg->id() == msg::Shutdown::message_id)
+    msgq->push(d);
+  else if (!push_bounded(d))
+    return;
+
+  if (high_watermark && !above_high.load(std::memory_order_relaxed))
+    check_high_watermark();
+  if (scheduler)
+    scheduler->notify(this);
+}
+
+// Apply the overflow policy; returns false if d was not queued
+bool Actor::push_bounded(const Delivery &d) noexcept
+{
+  switch (overflow) {
+  case OverflowPolicy::BLOCK:
+    msgq->push_wait(d, queue_limit);
+    return true;
+  case OverflowPolicy::DROP_OLDEST: {
+    Delivery evicted;
+    bool queued;
+    if (!msgq->push_evict(d, queue_limit, evicted, queued))
+      return true;
+    counters_.dropped.fetch_add(1, std::memory_order_relaxed);
+    evicted.msg->release();
+    return queued;
+  }
+  case OverflowPolicy::DROP_NEWEST:
+    if (msgq->try_push(d, queue_limit))
+      return true;
+    break;
+  case OverflowPolicy::REJECT:
+    if (msgq->try_push(d, queue_limit))
+      return true;
+    counters_.rejected.fetch_add(1, std::memory_order_relaxed);
+    // Never bounce a MailboxFull, or two full actors could ping-pong forever
+    if (d.sender && d.msg->id() != msg::MailboxFull::message_id)
+      d.sender->send(new msg::MailboxFull(d.msg, this), this);
+    else
+      d.msg->release();
+    return false;
+  }
+
+  counters_.dropped.fetch_add(1, std::memory_order_relaxed);
+  d.msg->release();
+  return false;
+}
+
+void Actor::check_high_watermark() noexcept
 {
-  msgq->push(m);
+  auto len = msgq->length();
+  if (len < high_watermark || above_high.exchange(true))
+    return;
+  if (manager)
+    manager->on_mailbox_watermark(this, len, true);
+}
+
+void Actor::check_low_watermark() noexcept
+{
+  auto len = msgq->length();
+  if (len > low_watermark || !above_high.exchange(false))
+    return;
+  if (manager)
+    manager->on_mailbox_watermark(this, len, false);
+}
+
+void Actor::set_mailbox_limit(std::size_t max_queued, OverflowPolicy policy,
+                              std::size_t high, std::size_t low)
+{
+  assert(!running.load(std::memory_order_relaxed) && "set_mailbox_limit on a running actor");
+  assert((high == 0 || low < high) && "low watermark must be below the high watermark");
+  queue_limit = max_queued;
+  overflow = policy;
+  high_watermark = high;
+  low_watermark = low;
 }
 
 std::size_t Actor::queue_length() const noexcept
@@ -213,12 +610,72 @@ std::size_t Actor::queue_length() const noexcept
   return msgq->length();
 }
 
+std::size_t Actor::queue_length(Lane lane) const noexcept
+{
+  if (mailbox == MailboxType::PRIORITY)
+    return static_cast<const LaneQueue<Delivery, LANE_COUNT> *>(msgq)->length(std::size_t(lane));
+  return lane == Lane::NORMAL ? msgq->length() : 0;
+}
+
 const Message* Actor::peek() const
+{
+  return msgq->peek().msg;
+}
+
+Delivery Actor::peek_delivery() const
 {
   return msgq->peek();
 }
 
-// Stub for RemoteActorRef::send (ZMQ not implemented yet)
-void RemoteActorRef::send(const Message* /*m*/, Actor* /*sender*/) {
-  // TODO: Implement ZMQ send
+void Actor::set_mailbox(MailboxType type, std::size_t size)
+{
+  Queue<Delivery> *q = nullptr;
+  switch (type) {
+  case MailboxType::BLOCKING:
+    q = new BQueue<Delivery>(size);
+    break;
+  case MailboxType::SPSC:
+    q = new SPSCQueue<Delivery>(size);
+    break;
+  case MailboxType::MPSC:
+    q = new MPSCQueue<Delivery>(size);
+    break;
+  case MailboxType::CONFLATING:
+    q = new ConflatingQueue<Delivery>(
+        size,
+        [this](const Delivery &d, std::string &key) { return conflation_key(d.msg, key); },
+        [](const Delivery &old) { old.msg->release(); });
+    break;
+  case MailboxType::PRIORITY:
+    q = new LaneQueue<Delivery, LANE_COUNT>(
+        size, [](const Delivery &d) { return std::size_t(d.lane); });
+    break;
+  }
+
+  // Carry over anything sent before the actor was managed
+  while (!msgq->is_empty())
+    q->push(std::get<0>(msgq->pop()));
+
+  delete msgq;
+  msgq = q;
+  mailbox = type;
+}
+
+// Key is the message ID followed by the type's conflation_key()
+bool Actor::conflation_key(const Message *m, std::string &key) const noexcept
+{
+  auto it = conflation_keys.find(m->get_message_id());
+  if (it == conflation_keys.end())
+    return false;
+  int id = it->first;
+  key.append(reinterpret_cast<const char *>(&id), sizeof id);
+  it->second(m, key);
+  return true;
+}
+
+std::size_t Actor::conflated_count() const noexcept
+{
+  if (mailbox != MailboxType::CONFLATING)
+    return 0;
+  return static_cast<const ConflatingQueue<Delivery> *>(msgq)->conflated();
 }
@@ -0,0 +1,254 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+#include <climits>
+#include <cstdio>
+#include <stdexcept>
+#include "actors/Coroutine.hpp"
+#include "actors/msg/Timeout.hpp"
+#include "actors/remote/ZmqSender.hpp"
+
+using namespace std;
+using namespace actors;
+
+// Resumes are sent as from the owner, so a draining Manager still admits them
+
+/**
+ * Receives the TimerWheel's msg::Timeout(token) for a sleep_for() or a
+ * local ask's timeout, and posts msg::Resume(token) to the owner.
+ */
+class CoroutineHost::Waker : public Actor
+{
+  Actor *owner_;
+
+public:
+  explicit Waker(Actor *owner) : owner_(owner)
+  {
+    snprintf(name, sizeof(name), "%s", owner->get_name());
+  }
+
+  void send(const Message *m, Actor *) noexcept override
+  {
+    int token = static_cast<const msg::Timeout *>(m)->data;  // only timers send here
+    m->release();
+    owner_->send(new msg::Resume(token), owner_);
+  }
+};
+
+/**
+ * Sender of a local ask's request: the target's reply() comes here and
+ * is posted to the owner as msg::Resume(token, reply). Reused once its
+ * ask is answered; one whose ask timed out is kept but not reused, since
+ * its reply may still come.
+ */
+class CoroutineHost::ReplyCatcher : public Actor
+{
+  Actor *owner_;
+
+public:
+  std::atomic<int> token{0};
+
+  explicit ReplyCatcher(Actor *owner) : owner_(owner)
+  {
+    snprintf(name, sizeof(name), "%s", owner->get_name());
+  }
+
+  void send(const Message *m, Actor *) noexcept override
+  {
+    owner_->send(new msg::Resume(token.load(std::memory_order_relaxed), m), owner_);
+  }
+};
+
+CoroutineHost::CoroutineHost(Actor *owner) : owner_(owner), waker_(make_unique<Waker>(owner)) {}
+
+CoroutineHost::~CoroutineHost()
+{
+  for (auto &[token, p] : pending_)
+    if (p.timer)
+      TimerWheel::instance().cancel_and_wait(p.timer);
+  for (void *frame : live_) {
+    auto h = Task::handle_t::from_address(frame);
+    if (h.promise().owns_msg)
+      h.promise().msg->release();
+    h.destroy();
+  }
+}
+
+void CoroutineHost::add_handler(int id, Handler h)
+{
+  handlers_[id] = std::move(h);
+  owner_->add_handler(id, &Actor::run_coroutine);
+}
+
+void CoroutineHost::adopt(Task::handle_t h) noexcept
+{
+  CoroutineHost &host = h.promise().owner->coroutine_host();
+  if (h.done())
+    host.finish(h);
+  else
+    host.live_.insert(h.address());
+}
+
+void CoroutineHost::run(const Message *m)
+{
+  auto it = handlers_.find(m->id());
+  if (it == handlers_.end())
+    return;
+
+  auto h = it->second(owner_, m).release();
+  if (h.done()) {
+    h.destroy();
+    return;
+  }
+
+  // Suspended: keep what the rest of the handler needs after we return
+  auto &p = h.promise();
+  p.msg = m;
+  p.sender = owner_->current_from;
+  if (!owner_->using_fast_send) {
+    p.owns_msg = true;
+    owner_->keep_current = true;
+  }
+  live_.insert(h.address());
+}
+
+void CoroutineHost::resume(const msg::Resume *r)
+{
+  auto it = pending_.find(r->token);
+  if (it == pending_.end())
+    return;  // the other of reply and timeout came first
+  Pending p = it->second;
+  pending_.erase(it);
+
+  if (p.timer)
+    TimerWheel::instance().cancel(p.timer);
+  if (p.catcher && r->reply)
+    idle_catchers_.push_back(p.catcher);
+  if (p.slot)
+    *p.slot = std::move(r->reply);
+
+  auto &promise = p.h.promise();
+  owner_->current = promise.owns_msg ? promise.msg : nullptr;
+  owner_->current_from = promise.sender;
+  owner_->reply_to = promise.sender;
+  p.h.resume();
+  if (p.h.done())
+    finish(p.h);
+}
+
+void CoroutineHost::finish(Task::handle_t h) noexcept
+{
+  auto &p = h.promise();
+  if (p.owns_msg)
+    p.msg->release();
+  live_.erase(h.address());
+  h.destroy();
+}
+
+int CoroutineHost::next_token() noexcept
+{
+  do
+    last_token_ = last_token_ == INT_MAX ? 1 : last_token_ + 1;
+  while (pending_.count(last_token_));
+  return last_token_;
+}
+
+CoroutineHost::ReplyCatcher *CoroutineHost::catcher()
+{
+  if (!idle_catchers_.empty()) {
+    ReplyCatcher *c = idle_catchers_.back();
+    idle_catchers_.pop_back();
+    return c;
+  }
+  catchers_.push_back(make_unique<ReplyCatcher>(owner_));
+  return catchers_.back().get();
+}
+
+void CoroutineHost::ask(Task::handle_t h, Reply *slot, const ActorRef &ref, const Message *m,
+                        chrono::milliseconds timeout)
+{
+  if (ref.is_rust()) {
+    m->release();
+    throw runtime_error("ask not supported for Rust actors");
+  }
+
+  int token = next_token();
+  if (ref.is_local()) {
+    ReplyCatcher *c = catcher();
+    c->token.store(token, memory_order_relaxed);
+    TimerHandle timer = TimerWheel::instance().schedule(waker_.get(), timeout, token);
+    pending_.emplace(token, Pending{h, slot, timer, c});
+    ref.actor()->send(m, c);
+    return;
+  }
+
+  // The reply, or nullptr after timeout, comes on the ZmqReceiver's thread
+  pending_.emplace(token, Pending{h, slot, TimerHandle{}, nullptr});
+  Actor *owner = owner_;
+  try {
+    ActorRef(ref).ask(m, [owner, token](unique_ptr<const Message> reply) {
+      owner->send(new msg::Resume(token, reply.release()), owner);
+    }, timeout);
+  } catch (...) {
+    pending_.erase(token);
+    throw;
+  }
+}
+
+void CoroutineHost::sleep(Task::handle_t h, chrono::nanoseconds d)
+{
+  int token = next_token();
+  TimerHandle timer = TimerWheel::instance().schedule(waker_.get(), d, token);
+  pending_.emplace(token, Pending{h, nullptr, timer, nullptr});
+}
+
+CoroutineHost &Actor::coroutine_host()
+{
+  if (!coroutines_) {
+    coroutines_ = make_unique<CoroutineHost>(this);
+    add_handler(msg::Resume::message_id, &Actor::resume_coroutine);
+  }
+  return *coroutines_;
+}
+
+void Actor::run_coroutine(const Message *m)
+{
+  coroutines_->run(m);
+}
+
+void Actor::resume_coroutine(const Message *m)
+{
+  coroutines_->resume(static_cast<const msg::Resume *>(m));
+}
@@ -0,0 +1,582 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+*/
+
+#include "actors/registry/GlobalRegistry.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace actors::registry {
+
+namespace {
+
+constexpr const char* SNAPSHOT_HEADER = "actors-registry-snapshot 1";
+
+std::string subscription_key(const std::string& subscriber, const std::string& endpoint) {
+    return subscriber + '\n' + endpoint;
+}
+
+std::vector<std::string> split_tabs(const std::string& line) {
+    std::vector<std::string> fields;
+    std::string field;
+    std::istringstream in(line);
+    while (std::getline(in, field, '\t')) {
+        fields.push_back(field);
+    }
+    if (!line.empty() && line.back() == '\t') {
+        fields.emplace_back();  // Trailing empty endpoint
+    }
+    return fields;
+}
+
+} // namespace
+
+GlobalRegistry::GlobalRegistry() {
+    strncpy(name, "GlobalRegistry", sizeof(name));
+
+    MESSAGE_HANDLER(msg::Start, on_start);
+    MESSAGE_HANDLER(msg::Timeout, on_timeout);
+    MESSAGE_HANDLER(RegisterActor, on_register);
+    MESSAGE_HANDLER(RegisterActors, on_register_actors);
+    MESSAGE_HANDLER(UnregisterActor, on_unregister);
+    MESSAGE_HANDLER(LookupActor, on_lookup);
+    MESSAGE_HANDLER(Heartbeat, on_heartbeat);
+    MESSAGE_HANDLER(SubscribeRegistry, on_subscribe);
+    MESSAGE_HANDLER(UnsubscribeRegistry, on_unsubscribe);
+}
+
+GlobalRegistry::~GlobalRegistry() {
+    if (sweep_timer_) {
+        TimerWheel::instance().cancel_and_wait(sweep_timer_);
+    }
+}
+
+void GlobalRegistry::set_push(PushFn push) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    push_ = std::move(push);
+}
+
+void GlobalRegistry::set_heartbeat_timeout(std::chrono::milliseconds timeout) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    default_timeout_ = timeout;
+}
+
+void GlobalRegistry::set_miss_threshold(unsigned misses) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    miss_threshold_ = std::max(1u, misses);
+}
+
+void GlobalRegistry::set_snapshot(const std::string& path, std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    snapshot_path_ = path;
+    snapshot_interval_ = interval;
+    next_snapshot_ = Clock::now() + interval;
+}
+
+// ---- Registration ----
+
+std::string GlobalRegistry::register_actor(const std::string& manager_id, const std::string& actor_name,
+                                           const std::string& endpoint, const ActorRef& ref) {
+    std::vector<Push> pushes;
+    std::string reason;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reason = register_locked(manager_id, actor_name, endpoint, ref, pushes);
+    }
+    deliver(pushes);
+    return reason;
+}
+
+std::vector<RegisterActorsResult::Failure> GlobalRegistry::register_actors(const RegisterActors& m) {
+    std::vector<Push> pushes;
+    std::vector<RegisterActorsResult::Failure> failed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& e : m.actors) {
+            std::string reason = register_locked(m.manager_id, e.actor_name, e.actor_endpoint,
+                                                 ActorRef(), pushes);
+            if (!reason.empty()) {
+                failed.push_back({e.actor_name, std::move(reason)});
+            }
+        }
+    }
+    deliver(pushes);
+    return failed;
+}
+
+std::string GlobalRegistry::register_locked(const std::string& manager_id, const std::string& actor_name,
+                                            const std::string& endpoint, const ActorRef& ref,
+                                            std::vector<Push>& out) {
+    auto now = Clock::now();
+    auto it = actors_.find(actor_name);
+    if (it != actors_.end() && it->second.manager_id != manager_id) {
+        auto owner = managers_.find(it->second.manager_id);
+        if (owner != managers_.end() && owner->second.online &&
+            now - owner->second.last_heartbeat < timeout_locked(owner->second)) {
+            return "Name already registered";
+        }
+        // Taking over from a manager that went offline
+        if (owner != managers_.end()) {
+            owner->second.actors.erase(actor_name);
+        }
+    }
+
+    bool changed = it == actors_.end() || it->second.endpoint != endpoint ||
+                   it->second.manager_id != manager_id;
+    actors_[actor_name] = ActorEntry{manager_id, endpoint, ref};
+    managers_[manager_id].actors.insert(actor_name);
+    dirty_ = true;
+
+    // Registration counts as heartbeat
+    heartbeat_locked(manager_id, 0, now, out);
+    if (changed) {
+        notify_actor(actor_name, endpoint, out);
+    }
+    return {};
+}
+
+bool GlobalRegistry::unregister_actor(const std::string& actor_name) {
+    std::vector<Push> pushes;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = actors_.find(actor_name);
+        if (it == actors_.end()) {
+            return false;
+        }
+        auto mgr = managers_.find(it->second.manager_id);
+        if (mgr != managers_.end()) {
+            mgr->second.actors.erase(actor_name);
+        }
+        actors_.erase(it);
+        dirty_ = true;
+        notify_actor(actor_name, "", pushes);
+    }
+    deliver(pushes);
+    return true;
+}
+
+GlobalRegistry::Lookup GlobalRegistry::lookup(const std::string& actor_name) {
+    lookups_.fetch_add(1, std::memory_order_relaxed);
+
+    Lookup result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = actors_.find(actor_name);
+    if (it == actors_.end()) {
+        return result;
+    }
+
+    result.found = true;
+    result.endpoint = it->second.endpoint;
+    result.manager_id = it->second.manager_id;
+    if (it->second.ref.is_valid() || result.endpoint.empty()) {
+        result.ref = it->second.ref;
+    } else {
+        result.ref = ActorRef(actor_name, result.endpoint, nullptr);
+    }
+
+    auto mgr = managers_.find(it->second.manager_id);
+    result.online = mgr != managers_.end() && mgr->second.online &&
+                    Clock::now() - mgr->second.last_heartbeat < timeout_locked(mgr->second);
+    return result;
+}
+
+// ---- Heartbeats ----
+
+void GlobalRegistry::heartbeat(const std::string& manager_id, uint32_t interval_ms) {
+    heartbeats_.fetch_add(1, std::memory_order_relaxed);
+
+    std::vector<Push> pushes;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        heartbeat_locked(manager_id, interval_ms, Clock::now(), pushes);
+    }
+    deliver(pushes);
+}
+
+void GlobalRegistry::heartbeat_locked(const std::string& manager_id, uint32_t interval_ms,
+                                      Clock::time_point now, std::vector<Push>& out) {
+    ManagerEntry& m = managers_[manager_id];
+    bool was_online = m.online;
+    bool interval_changed = interval_ms != 0 && interval_ms != m.interval_ms;
+
+    m.last_heartbeat = now;
+    if (interval_ms != 0) {
+        m.interval_ms = interval_ms;
+    }
+    m.online = true;
+
+    // One live heap entry per online manager. expire() moves it to the
+    // real deadline, so a steady heartbeat only stamps last_heartbeat.
+    if (!was_online || interval_changed) {
+        m.queued = now + timeout_locked(m);
+        deadlines_.push({m.queued, manager_id});
+    }
+    if (!was_online) {
+        notify_manager(manager_id, true, out);
+    }
+}
+
+bool GlobalRegistry::is_manager_online(const std::string& manager_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = managers_.find(manager_id);
+    return it != managers_.end() && it->second.online &&
+           Clock::now() - it->second.last_heartbeat < timeout_locked(it->second);
+}
+
+std::chrono::milliseconds GlobalRegistry::heartbeat_timeout(const std::string& manager_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = managers_.find(manager_id);
+    if (it == managers_.end()) {
+        return default_timeout_;
+    }
+    return timeout_locked(it->second);
+}
+
+std::chrono::milliseconds GlobalRegistry::timeout_locked(const ManagerEntry& m) const {
+    if (m.interval_ms == 0) {
+        return default_timeout_;
+    }
+    return std::chrono::milliseconds(m.interval_ms) * miss_threshold_;
+}
+
+size_t GlobalRegistry::expire(Clock::time_point now) {
+    std::vector<Push> pushes;
+    size_t offline = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!deadlines_.empty() && deadlines_.top().when <= now) {
+            Deadline d = deadlines_.top();
+            deadlines_.pop();
+
+            auto it = managers_.find(d.manager_id);
+            if (it == managers_.end() || !it->second.online || it->second.queued != d.when) {
+                continue;  // Superseded entry
+            }
+            ManagerEntry& m = it->second;
+            auto due = m.last_heartbeat + timeout_locked(m);
+            if (due > now) {
+                m.queued = due;  // Heard from since; check again then
+                deadlines_.push({due, d.manager_id});
+                continue;
+            }
+
+            m.online = false;
+            offline++;
+            std::cerr << "GlobalRegistry: manager '" << d.manager_id << "' missed heartbeats, "
+                      << m.actors.size() << " actors offline" << std::endl;
+            notify_manager(d.manager_id, false, pushes);
+        }
+    }
+    expired_.fetch_add(offline, std::memory_order_relaxed);
+    deliver(pushes);
+    return offline;
+}
+
+// ---- Subscriptions ----
+
+void GlobalRegistry::subscribe(const std::string& subscriber, const std::string& endpoint,
+                               const std::vector<std::string>& actor_names,
+                               const std::vector<std::string>& manager_ids) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Subscription& sub = subscriptions_[subscription_key(subscriber, endpoint)];
+    sub.actors.insert(actor_names.begin(), actor_names.end());
+    sub.managers.insert(manager_ids.begin(), manager_ids.end());
+    dirty_ = true;
+}
+
+void GlobalRegistry::unsubscribe(const std::string& subscriber, const std::string& endpoint,
+                                 const std::vector<std::string>& actor_names,
+                                 const std::vector<std::string>& manager_ids) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = subscriptions_.find(subscription_key(subscriber, endpoint));
+    if (it == subscriptions_.end()) {
+        return;
+    }
+    for (const auto& n : actor_names) {
+        it->second.actors.erase(n);
+    }
+    for (const auto& n : manager_ids) {
+        it->second.managers.erase(n);
+    }
+    bool everything = actor_names.empty() && manager_ids.empty();
+    if (everything || (it->second.actors.empty() && it->second.managers.empty())) {
+        subscriptions_.erase(it);
+    }
+    dirty_ = true;
+}
+
+void GlobalRegistry::notify_actor(const std::string& actor_name, const std::string& endpoint,
+                                  std::vector<Push>& out) {
+    for (const auto& [key, sub] : subscriptions_) {
+        if (sub.actors.count(actor_name)) {
+            auto split = key.find('\n');
+            out.push_back({key.substr(0, split), key.substr(split + 1),
+                           new ActorMoved(actor_name, endpoint)});
+        }
+    }
+}
+
+void GlobalRegistry::notify_manager(const std::string& manager_id, bool online, std::vector<Push>& out) {
+    const auto& actors = managers_[manager_id].actors;
+    for (const auto& [key, sub] : subscriptions_) {
+        bool wanted = sub.managers.count(manager_id) > 0;
+        for (auto a = sub.actors.begin(); !wanted && a != sub.actors.end(); ++a) {
+            wanted = actors.count(*a) > 0;
+        }
+        if (!wanted) {
+            continue;
+        }
+
+        const Message* event;
+        if (online) {
+            event = new ManagerOnline(manager_id);
+        } else {
+            std::vector<std::string> names(actors.begin(), actors.end());
+            std::sort(names.begin(), names.end());
+            event = new ManagerOffline(manager_id, std::move(names));
+        }
+        auto split = key.find('\n');
+        out.push_back({key.substr(0, split), key.substr(split + 1), event});
+    }
+}
+
+void GlobalRegistry::deliver(std::vector<Push>& pushes) {
+    if (pushes.empty()) {
+        return;
+    }
+    PushFn push;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        push = push_;
+    }
+    for (auto& p : pushes) {
+        if (!push) {
+            delete p.event;
+            continue;
+        }
+        try {
+            push(p.subscriber, p.endpoint, p.event);
+        } catch (const std::exception& e) {
+            std::cerr << "GlobalRegistry: push to '" << p.subscriber << "' at "
+                      << p.endpoint << " failed: " << e.what() << std::endl;
+        }
+    }
+    pushes.clear();
+}
+
+// ---- Snapshots ----
+
+bool GlobalRegistry::save_snapshot(const std::string& path) const {
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        out << SNAPSHOT_HEADER << '\n';
+        for (const auto& [id, m] : managers_) {
+            out << "M\t" << id << '\t' << m.interval_ms << '\n';
+        }
+        for (const auto& [actor_name, e] : actors_) {
+            out << "A\t" << actor_name << '\t' << e.manager_id << '\t' << e.endpoint << '\n';
+        }
+        for (const auto& [key, sub] : subscriptions_) {
+            auto split = key.find('\n');
+            std::string who = key.substr(0, split) + '\t' + key.substr(split + 1);
+            for (const auto& a : sub.actors) {
+                out << "S\t" << who << "\ta\t" << a << '\n';
+            }
+            for (const auto& m : sub.managers) {
+                out << "S\t" << who << "\tm\t" << m << '\n';
+            }
+        }
+        out.flush();
+        if (!out) {
+            return false;
+        }
+    }
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool GlobalRegistry::load_snapshot(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != SNAPSHOT_HEADER) {
+        return false;
+    }
+
+    std::unordered_map<std::string, ActorEntry> actors;
+    std::unordered_map<std::string, ManagerEntry> managers;
+    std::unordered_map<std::string, Subscription> subscriptions;
+    while (std::getline(in, line)) {
+        auto f = split_tabs(line);
+        if (f.size() == 3 && f[0] == "M") {
+            managers[f[1]].interval_ms = static_cast<uint32_t>(std::stoul(f[2]));
+        } else if (f.size() == 4 && f[0] == "A") {
+            actors[f[1]] = ActorEntry{f[2], f[3], ActorRef()};
+            managers[f[2]].actors.insert(f[1]);
+        } else if (f.size() == 5 && f[0] == "S") {
+            Subscription& sub = subscriptions[subscription_key(f[1], f[2])];
+            (f[3] == "a" ? sub.actors : sub.managers).insert(f[4]);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = Clock::now();
+    deadlines_ = {};
+    for (auto& [id, m] : managers) {
+        // Grace period: a restored manager has one timeout to check in
+        m.last_heartbeat = now;
+        m.online = true;
+        m.queued = now + timeout_locked(m);
+        deadlines_.push({m.queued, id});
+    }
+    actors_ = std::move(actors);
+    managers_ = std::move(managers);
+    subscriptions_ = std::move(subscriptions);
+    dirty_ = false;
+    return true;
+}
+
+void GlobalRegistry::maybe_snapshot(Clock::time_point now) {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (snapshot_path_.empty() || !dirty_ || now < next_snapshot_) {
+            return;
+        }
+        path = snapshot_path_;
+        dirty_ = false;
+        next_snapshot_ = now + snapshot_interval_;
+    }
+    if (!save_snapshot(path)) {
+        std::cerr << "GlobalRegistry: failed to write snapshot " << path << std::endl;
+    }
+}
+
+// ---- Queries ----
+
+std::vector<std::string> GlobalRegistry::actor_names() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> names;
+    names.reserve(actors_.size());
+    for (const auto& [actor_name, e] : actors_) {
+        names.push_back(actor_name);
+    }
+    return names;
+}
+
+std::vector<std::string> GlobalRegistry::manager_ids() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> ids;
+    ids.reserve(managers_.size());
+    for (const auto& [id, m] : managers_) {
+        ids.push_back(id);
+    }
+    return ids;
+}
+
+RegistryStats GlobalRegistry::stats() const {
+    RegistryStats s;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        s.actors = actors_.size();
+        s.managers = managers_.size();
+        for (const auto& [id, m] : managers_) {
+            s.managers_online += m.online;
+        }
+        s.subscriptions = subscriptions_.size();
+    }
+    s.lookups = lookups_.load(std::memory_order_relaxed);
+    s.heartbeats = heartbeats_.load(std::memory_order_relaxed);
+    s.expired = expired_.load(std::memory_order_relaxed);
+    return s;
+}
+
+// ---- Actor protocol ----
+
+void GlobalRegistry::on_start(const msg::Start*) noexcept {
+    sweep_timer_ = TimerWheel::instance().schedule(this, sweep_interval_, 0, sweep_interval_);
+}
+
+void GlobalRegistry::on_timeout(const msg::Timeout*) noexcept {
+    auto now = Clock::now();
+    expire(now);
+    maybe_snapshot(now);
+}
+
+void GlobalRegistry::end() {
+    if (sweep_timer_) {
+        TimerWheel::instance().cancel(sweep_timer_);
+        sweep_timer_ = TimerHandle{};
+    }
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        path = snapshot_path_;
+    }
+    if (!path.empty() && !save_snapshot(path)) {
+        std::cerr << "GlobalRegistry: failed to write snapshot " << path << std::endl;
+    }
+}
+
+void GlobalRegistry::on_register(const RegisterActor* m) noexcept {
+    std::string endpoint;
+    if (m->actor_ref.is_remote() || m->actor_ref.is_shm()) {
+        endpoint = m->actor_ref.remote_ref().endpoint();
+    }
+    std::string reason = register_actor(m->manager_id, m->actor_name, endpoint, m->actor_ref);
+    if (reason.empty()) {
+        reply(new RegistrationOk(m->actor_name));
+    } else {
+        reply(new RegistrationFailed(m->actor_name, reason));
+    }
+}
+
+void GlobalRegistry::on_register_actors(const RegisterActors* m) noexcept {
+    auto failed = register_actors(*m);
+    reply(new RegisterActorsResult(m->actors.size() - failed.size(), std::move(failed)));
+}
+
+void GlobalRegistry::on_unregister(const UnregisterActor* m) noexcept {
+    if (unregister_actor(m->actor_name)) {
+        reply(new RegistrationOk(m->actor_name));
+    } else {
+        reply(new RegistrationFailed(m->actor_name, "Not registered"));
+    }
+}
+
+void GlobalRegistry::on_lookup(const LookupActor* m) noexcept {
+    Lookup found = lookup(m->actor_name);
+    if (!found.found) {
+        reply(new LookupResult(m->actor_name, std::nullopt, false));
+        return;
+    }
+    reply(new LookupResult(m->actor_name, found.ref, found.online, found.manager_id));
+}
+
+void GlobalRegistry::on_heartbeat(const Heartbeat* m) noexcept {
+    heartbeat(m->manager_id, m->interval_ms);
+    reply(new HeartbeatAck());
+}
+
+void GlobalRegistry::on_subscribe(const SubscribeRegistry* m) noexcept {
+    subscribe(m->subscriber, m->subscriber_endpoint, m->actor_names, m->manager_ids);
+    reply(new SubscriptionOk(m->subscriber));
+}
+
+void GlobalRegistry::on_unsubscribe(const UnsubscribeRegistry* m) noexcept {
+    unsubscribe(m->subscriber, m->subscriber_endpoint, m->actor_names, m->manager_ids);
+    reply(new SubscriptionOk(m->subscriber));
+}
+
+} // namespace actors::registry
@@ -0,0 +1,356 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "actors/Actor.hpp"
+#include "actors/Journal.hpp"
+#include "actors/remote/Serialization.hpp"
+
+using namespace std;
+using namespace actors;
+using namespace actors::journal;
+using serialization::MessageRegistry;
+
+namespace
+{
+  constexpr size_t pad8(size_t n) { return (n + 7) & ~size_t(7); }
+
+  uint64_t now_ns() noexcept
+  {
+    return chrono::duration_cast<chrono::nanoseconds>(
+               chrono::system_clock::now().time_since_epoch()).count();
+  }
+
+  string segment_path(const string &dir, const string &name, uint32_t index)
+  {
+    char suffix[24];
+    snprintf(suffix, sizeof(suffix), ".%06u.jnl", index);
+    return dir + "/" + name + suffix;
+  }
+
+  // Index of a "<name>.<digits>.jnl" file name, or -1 for anything else
+  long segment_index(const string &file, const string &name)
+  {
+    const size_t ext = 4;  // ".jnl"
+    if (file.size() <= name.size() + 1 + ext || file.compare(0, name.size(), name) != 0 ||
+        file[name.size()] != '.' || file.compare(file.size() - ext, ext, ".jnl") != 0)
+      return -1;
+    string digits = file.substr(name.size() + 1, file.size() - name.size() - 1 - ext);
+    if (digits.empty() || !all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; }))
+      return -1;
+    return stol(digits);
+  }
+
+  // Header of the complete record at pos; false at the end of the segment
+  bool record_at(const char *base, size_t size, size_t pos, RecordHeader &h) noexcept
+  {
+    if (pos + sizeof(h) > size)
+      return false;
+    memcpy(&h, base + pos, sizeof(h));
+    return h.seq != 0 && pos + sizeof(h) + pad8(h.length) <= size;
+  }
+
+  struct Mapping
+  {
+    const char *base = nullptr;
+    size_t size = 0;
+  };
+
+  // Map a segment read-only and check its header
+  Mapping map_segment(const string &path)
+  {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      throw runtime_error("open " + path + ": " + strerror(errno));
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      int err = errno;
+      ::close(fd);
+      throw runtime_error("stat " + path + ": " + strerror(err));
+    }
+    Mapping m;
+    m.size = size_t(st.st_size);
+    if (m.size >= sizeof(SegmentHeader)) {
+      void *p = ::mmap(nullptr, m.size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED) {
+        int err = errno;
+        ::close(fd);
+        throw runtime_error("mmap " + path + ": " + strerror(err));
+      }
+      m.base = static_cast<const char *>(p);
+    }
+    ::close(fd);
+
+    SegmentHeader h{};
+    if (m.base)
+      memcpy(&h, m.base, sizeof(h));
+    if (h.magic != MAGIC || h.version != VERSION || h.header_size < sizeof(h) || h.header_size > m.size) {
+      if (m.base)
+        ::munmap(const_cast<char *>(m.base), m.size);
+      throw runtime_error("not a journal segment: " + path);
+    }
+    return m;
+  }
+
+  // Sequence number following the last complete record of a segment
+  uint64_t seq_after(const string &path)
+  {
+    Mapping m = map_segment(path);
+    SegmentHeader sh;
+    memcpy(&sh, m.base, sizeof(sh));
+    uint64_t next = sh.first_seq;
+    RecordHeader h;
+    for (size_t pos = sh.header_size; record_at(m.base, m.size, pos, h);
+         pos += sizeof(h) + pad8(h.length))
+      next = h.seq + 1;
+    ::munmap(const_cast<char *>(m.base), m.size);
+    return next;
+  }
+}
+
+vector<string> journal::segments(const string &dir, const string &name)
+{
+  vector<pair<long, string>> found;
+  error_code ec;
+  for (auto &entry : filesystem::directory_iterator(dir, ec)) {
+    string file = entry.path().filename().string();
+    long index = segment_index(file, name);
+    if (index >= 0)
+      found.emplace_back(index, entry.path().string());
+  }
+  sort(found.begin(), found.end());
+
+  vector<string> paths;
+  for (auto &f : found)
+    paths.push_back(move(f.second));
+  return paths;
+}
+
+// ---- Journal ----
+
+Journal::Journal(string dir, string name, size_t segment_bytes)
+    : dir_(move(dir)), name_(move(name)), segment_bytes_(segment_bytes)
+{
+  error_code ec;
+  filesystem::create_directories(dir_, ec);
+
+  // Continue after whatever an earlier run left behind
+  auto existing = segments(dir_, name_);
+  if (!existing.empty()) {
+    index_ = uint32_t(segment_index(filesystem::path(existing.back()).filename().string(), name_)) + 1;
+    seq_ = seq_after(existing.back());
+  }
+
+  if (!open_segment(0))
+    throw runtime_error("journal segment " + segment_path(dir_, name_, index_) + ": " + strerror(errno));
+}
+
+Journal::~Journal()
+{
+  close_segment();
+}
+
+bool Journal::open_segment(size_t need) noexcept
+{
+  const size_t size = max(segment_bytes_, sizeof(SegmentHeader) + need);
+  const string path = segment_path(dir_, name_, index_);
+
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+  if (fd < 0)
+    return false;
+  // Reserve the blocks now: a full disk fails here instead of as SIGBUS on a store
+  int err = ::posix_fallocate(fd, 0, off_t(size));
+  void *p = err == 0 ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+  if (p == MAP_FAILED) {
+    if (err == 0)
+      err = errno;
+    ::close(fd);
+    ::unlink(path.c_str());
+    errno = err;
+    return false;
+  }
+
+  SegmentHeader h{MAGIC, VERSION, uint16_t(sizeof(SegmentHeader)), index_, 0, seq_, now_ns()};
+  memcpy(p, &h, sizeof(h));
+  fd_ = fd;
+  base_ = static_cast<char *>(p);
+  size_ = size;
+  used_ = sizeof(h);
+  return true;
+}
+
+// Trim the segment to its records and move on to the next index
+void Journal::close_segment() noexcept
+{
+  if (!base_)
+    return;
+  ::munmap(base_, size_);
+  if (::ftruncate(fd_, off_t(used_)) == 0)
+    ::fdatasync(fd_);
+  ::close(fd_);
+  base_ = nullptr;
+  fd_ = -1;
+  index_++;
+}
+
+bool Journal::append(const Message *m) noexcept
+{
+  try {
+    scratch_.clear();
+    wire::BinaryWriter w(scratch_);
+    if (!MessageRegistry::instance().encode(m, w)) {
+      skipped_++;
+      return false;
+    }
+  } catch (...) {
+    skipped_++;
+    return false;
+  }
+
+  const size_t need = sizeof(RecordHeader) + pad8(scratch_.size());
+  if (!base_ || used_ + need > size_) {
+    close_segment();
+    if (!open_segment(need)) {
+      skipped_++;  // Retried with a new segment on the next append
+      return false;
+    }
+  }
+
+  char *p = base_ + used_;
+  RecordHeader h{0, now_ns(), m->id(), uint32_t(scratch_.size())};
+  memcpy(p, &h, sizeof(h));
+  memcpy(p + sizeof(h), scratch_.data(), scratch_.size());
+  atomic_ref<uint64_t>(reinterpret_cast<RecordHeader *>(p)->seq).store(seq_, memory_order_release);
+
+  used_ += need;
+  seq_++;
+  recorded_++;
+  return true;
+}
+
+bool Journal::sync() noexcept
+{
+  return !base_ || ::msync(base_, used_, MS_SYNC) == 0;
+}
+
+// ---- JournalReader ----
+
+JournalReader::JournalReader(const string &dir, const string &name)
+    : paths_(segments(dir, name))
+{
+  if (paths_.empty())
+    throw runtime_error("no journal segments for " + dir + "/" + name);
+  open(0);
+}
+
+JournalReader::~JournalReader()
+{
+  unmap();
+}
+
+bool JournalReader::open(size_t i)
+{
+  unmap();
+  current_ = i;
+  if (i >= paths_.size())
+    return false;
+  Mapping m = map_segment(paths_[i]);
+  base_ = m.base;
+  size_ = m.size;
+  SegmentHeader h;
+  memcpy(&h, base_, sizeof(h));
+  pos_ = h.header_size;
+  return true;
+}
+
+void JournalReader::unmap() noexcept
+{
+  if (base_)
+    ::munmap(const_cast<char *>(base_), size_);
+  base_ = nullptr;
+  size_ = 0;
+}
+
+bool JournalReader::next(Entry &e)
+{
+  RecordHeader h;
+  while (base_ && !record_at(base_, size_, pos_, h))
+    open(current_ + 1);
+  if (!base_)
+    return false;
+
+  wire::BinaryReader r(base_ + pos_ + sizeof(h), h.length);
+  e.seq = h.seq;
+  e.time_ns = h.time_ns;
+  e.msg_id = h.msg_id;
+  e.msg.reset(MessageRegistry::instance().decode(h.msg_id, r));
+  pos_ += sizeof(h) + pad8(h.length);
+  return true;
+}
+
+// ---- Replay ----
+
+size_t actors::replay(JournalReader &reader, Actor *to, ReplaySpeed speed, Actor *sender)
+{
+  const auto start = chrono::steady_clock::now();
+  uint64_t first_ns = 0;
+  size_t sent = 0;
+
+  JournalReader::Entry e;
+  while (reader.next(e)) {
+    if (!e.msg)
+      continue;
+    if (speed == ReplaySpeed::RECORDED) {
+      if (sent == 0)
+        first_ns = e.time_ns;
+      else if (e.time_ns > first_ns)
+        this_thread::sleep_until(start + chrono::nanoseconds(e.time_ns - first_ns));
+    }
+    to->send(e.msg.release(), sender);
+    sent++;
+  }
+  return sent;
+}
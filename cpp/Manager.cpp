@@ -41,12 +41,22 @@ https://opensource.org/licenses/MIT
 #include <cassert>
 #include <thread>
 #include <chrono>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
 #include "actors/Actor.hpp"
+#include "actors/Queue.hpp"
+#include "actors/act/Group.hpp"
+#include "actors/act/Router.hpp"
+#include "actors/act/TimerWheel.hpp"
 #include "actors/msg/Start.hpp"
 #include "actors/msg/Shutdown.hpp"
 #include "actors/act/Manager.hpp"
 #include "actors/registry/RegistryClient.hpp"
+#include "actors/remote/ShmTransport.hpp"
 #include "actors/remote/ZmqSender.hpp"
+#include "actors/Trace.hpp"
 
 using namespace actors;
 using namespace std;
@@ -58,11 +68,10 @@ static int set_thread_affinity(set<int> core_ids, pthread_t thread)
 
   cpu_set_t cpuset;
   CPU_ZERO(&cpuset);
-  int num_cores = sysconf(_SC_NPROCESSORS_ONLN);
 
   for (auto core_id : core_ids)
   {
-    if (core_id < 0 || core_id >= num_cores)
+    if (!Topology::system().find(core_id))
     {
       cerr << "bad core id: " << core_id << endl;
       return EINVAL;
@@ -83,6 +92,9 @@ Manager::~Manager()
     registry_client_->stop_heartbeat();
   }
 
+  if (scheduler_)
+    scheduler_->stop();
+
   for (auto p : thread_list)
     delete p;
 }
@@ -104,30 +116,38 @@ void Manager::set_registry(const string& registry_endpoint,
 
 void Manager::init()
 {
-  for (auto actor : actor_list)
+  assert(!deterministic_ && "init() after run_deterministic()");
+  using clock = chrono::steady_clock;
+  auto t0 = clock::now();
+
+  size_t threads = 0;
   {
-    auto initmsg = new actors::msg::Start();
-    cout << "Manager::init sending start to " << actor->get_name() << endl;
-    actor->fast_send(initmsg, nullptr);
+    lock_guard<mutex> lock(life_mut_);
+    starting_ = true;
+    ready_ = 0;
+    running_ = actor_list.size();
+    awaiting_start_.insert(actor_list.begin(), actor_list.end());
   }
+  if (memory_mode_ == MemoryMode::LOCKED)
+    lock_memory();
 
   for (auto actor : actor_list)
   {
+    if (actor->scheduler)
+      continue;  // runs on the worker pool
+
     auto t = new std::thread([actor]() { (*actor)(); });
     thread_list.push_back(t);
+    threads++;
 
     if (!actor->affinity.empty())
     {
-      cout << actor->get_name() << " setting affinity" << endl;
       if (set_thread_affinity(actor->affinity, t->native_handle()) != 0)
-      {
-        perror("could not assign affinity\n");
-      }
+        cerr << "could not set affinity for " << actor->get_name() << endl;
     }
 
     if (actor->priority > 0)
     {
-      cout << actor->get_name() << " setting priority to SCHED_FIFO " << actor->priority << endl;
       struct sched_param sp;
       sp.sched_priority = actor->priority;
       if (pthread_setschedparam(t->native_handle(), SCHED_FIFO, &sp) != 0)
@@ -135,25 +155,298 @@ void Manager::init()
         perror("sched_setscheduler");
         cerr << "could not set priority for " << actor->get_name() << endl;
       }
-      else
-        cout << " priority set ok\n";
     }
+  }
+
+  // Startup barrier: every thread has run Actor::init() and waits
+  {
+    unique_lock<mutex> lock(life_mut_);
+    life_cv_.wait(lock, [&]() { return ready_ == threads; });
+  }
+  auto t1 = clock::now();
+
+  if (memory_mode_ == MemoryMode::LOCKED)
+  {
+    memory_.locked_bytes = memory::locked_bytes();
+    memory_.huge_bytes = memory::huge_bytes();
+    if (memory_.locked)
+      cout << "Manager: locked " << memory_.locked_bytes / 1024 << " KB";
     else
+      cout << "Manager: mlockall failed (" << strerror(memory_.lock_error) << ")";
+    cout << ", prefaulted " << memory_.stack_bytes / 1024 << " KB of stacks, "
+         << memory_.mailbox_bytes / 1024 << " KB of mailboxes, " << memory_.pool_bytes / 1024
+         << " KB of message pool, " << memory_.huge_bytes / 1024 << " KB on huge pages" << endl;
+  }
+
+  // No handler has run yet, but Start may queue behind what Actor::init() or
+  // other threads already sent, except in a PRIORITY mailbox's CONTROL lane
+  for (auto actor : actor_list)
+    actor->send(new msg::Start());
+  if (scheduler_)
+    scheduler_->start();
+  {
+    lock_guard<mutex> lock(life_mut_);
+    starting_ = false;
+  }
+  life_cv_.notify_all();
+
+  {
+    unique_lock<mutex> lock(life_mut_);
+    if (!life_cv_.wait_for(lock, chrono::milliseconds(ACTOR_START_TIMEOUT_MS),
+                           [this]() { return awaiting_start_.empty(); }))
     {
-      cout << actor->get_name() << " NOT setting priority " << actor->priority << endl;
+      for (auto *actor : awaiting_start_)
+        cerr << "Manager: " << actor->get_name() << " has not handled Start" << endl;
     }
   }
+  auto t2 = clock::now();
+
+  // After the threads start: a remote registry replies through them
+  register_all();
+  started_ = true;
+
+  lifecycle_.ready = t1 - t0;
+  lifecycle_.start = t2 - t1;
+  cout << "Manager: " << actor_list.size() << " actors ready in "
+       << chrono::duration<double, milli>(lifecycle_.ready).count() << " ms, started in "
+       << chrono::duration<double, milli>(lifecycle_.start).count() << " ms" << endl;
 
   this->send(new msg::Start());
 }
 
+void Manager::lock_memory()
+{
+  memory_ = MemoryReport{};
+  // MCL_FUTURE locks, and so faults in, the thread stacks created next
+  memory_.locked = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+  if (!memory_.locked)
+    memory_.lock_error = errno;
+
+  // mlockall already backed them; this covers a failed lock
+  for (auto &[name, actor] : expanded_name_map)
+  {
+    auto ring = actor->msgq->storage();
+    memory_.mailbox_bytes += memory::prefault(ring.first, ring.second);
+  }
+  memory_.pool_bytes = memory::reserve_slabs();
+}
+
+void Manager::actor_ready()
+{
+  // Fault the stack in before the barrier rather than in the first handlers
+  size_t stack = memory_mode_ == MemoryMode::LOCKED ? memory::prefault_stack(ACTOR_PREFAULT_STACK_BYTES) : 0;
+
+  unique_lock<mutex> lock(life_mut_);
+  if (!starting_)
+    return;  // run outside init()
+  memory_.stack_bytes += stack;
+  ready_++;
+  life_cv_.notify_all();
+  life_cv_.wait(lock, [this]() { return !starting_; });
+}
+
+void Manager::actor_started(Actor *actor)
+{
+  lock_guard<mutex> lock(life_mut_);
+  if (awaiting_start_.erase(actor))
+    life_cv_.notify_all();
+}
+
+void Manager::actor_stopped(Actor *actor)
+{
+  lock_guard<mutex> lock(life_mut_);
+  if (running_ > 0)
+    running_--;
+  awaiting_start_.erase(actor);  // Shut down before it got to Start
+  life_cv_.notify_all();
+}
+
+void Manager::terminate() noexcept
+{
+  terminate_called = true;
+  lock_guard<mutex> lock(life_mut_);
+  stop_requested_ = true;
+  life_cv_.notify_all();
+}
+
 void Manager::end()
+{
+  if (deterministic_)
+  {
+    run_deterministic();
+    shutdown();
+    return;
+  }
+
+  bool stop;
+  {
+    unique_lock<mutex> lock(life_mut_);
+    life_cv_.wait(lock, [this]() { return stop_requested_ || running_ == 0; });
+    stop = stop_requested_;
+  }
+
+  if (stop)
+    shutdown();
+  join_all();
+}
+
+void Manager::join_all()
 {
   for (auto t : thread_list)
   {
     if (t->joinable())
       t->join();
   }
+
+  if (scheduler_)
+    scheduler_->join();
+}
+
+void Manager::shutdown(chrono::milliseconds deadline)
+{
+  using clock = chrono::steady_clock;
+  {
+    lock_guard<mutex> lock(life_mut_);
+    if (stopping_)
+      return;
+    stopping_ = true;
+  }
+  auto t0 = clock::now();
+
+  // Refuse new work from outside; managed actors still finish what they have
+  for (auto &[name, actor] : expanded_name_map)
+    actor->intake.store(Actor::INTAKE_DRAINING, memory_order_relaxed);
+  for (auto *actor : actor_list)
+    actor->on_drain();
+
+  bool drained = deterministic_ ? step_drained(t0 + deadline) : wait_drained(t0 + deadline);
+  size_t discarded = 0;
+  if (!drained)
+  {
+    for (auto *actor : actor_list)
+      discarded += actor->queue_length();
+    for (auto &[name, actor] : expanded_name_map)
+      actor->intake.store(Actor::INTAKE_DISCARDING, memory_order_relaxed);
+  }
+  auto t1 = clock::now();
+
+  for (auto *actor : actor_list)
+    actor->send(new msg::Shutdown());
+  if (deterministic_)
+  {
+    while (step_all())
+      ;
+    TimerWheel::instance().set_virtual(false);
+  }
+  else
+    join_all();
+  auto t2 = clock::now();
+  if (memory_.locked)
+    munlockall();  // The report still says what init() locked
+
+  lifecycle_.drain = t1 - t0;
+  lifecycle_.join = t2 - t1;
+  lifecycle_.drained = drained;
+  lifecycle_.discarded = discarded;
+  cout << "Manager: drained in " << chrono::duration<double, milli>(lifecycle_.drain).count() << " ms";
+  if (!drained)
+    cout << " (deadline passed, " << discarded << " messages discarded)";
+  cout << ", joined in " << chrono::duration<double, milli>(lifecycle_.join).count() << " ms" << endl;
+}
+
+uint64_t Manager::handled_total() const noexcept
+{
+  uint64_t handled = 0;
+  for (auto &[name, actor] : expanded_name_map)
+    handled += actor->message_count();
+  return handled;
+}
+
+bool Manager::stop_requested()
+{
+  lock_guard<mutex> lock(life_mut_);
+  return stop_requested_;
+}
+
+// True once every mailbox is empty and no message was handled since the last look
+bool Manager::wait_drained(chrono::steady_clock::time_point deadline) const
+{
+  bool quiet = false;
+  uint64_t last = 0;
+  for (;;)
+  {
+    size_t queued = 0;
+    for (auto *actor : actor_list)
+      queued += actor->queue_length();
+    uint64_t handled = handled_total();
+
+    if (queued == 0 && quiet && handled == last)
+      return true;
+    quiet = queued == 0;
+    last = handled;
+
+    if (chrono::steady_clock::now() >= deadline)
+      return false;
+    this_thread::sleep_for(chrono::microseconds(ACTOR_DRAIN_POLL_US));
+  }
+}
+
+size_t Manager::run_deterministic(chrono::nanoseconds horizon)
+{
+  auto &wheel = TimerWheel::instance();
+  if (!deterministic_)
+  {
+    deterministic_ = true;
+    wheel.set_virtual(true);
+    {
+      lock_guard<mutex> lock(life_mut_);
+      running_ = actor_list.size();
+      awaiting_start_.insert(actor_list.begin(), actor_list.end());
+    }
+    // As under init(): every init() first, then Start
+    for (auto *actor : actor_list)
+      actor->start_pooled();
+    for (auto *actor : actor_list)
+      actor->send(new msg::Start());
+  }
+
+  auto now = wheel.now();
+  auto limit = horizon >= chrono::steady_clock::time_point::max() - now
+                   ? chrono::steady_clock::time_point::max()
+                   : now + chrono::duration_cast<chrono::steady_clock::duration>(horizon);
+
+  uint64_t before = handled_total();
+  while (!stop_requested())
+  {
+    if (!step_all() && wheel.advance(limit) == 0)
+      break;
+  }
+  return size_t(handled_total() - before);
+}
+
+// One pass over the mailboxes in manage() order; false if they were all empty
+bool Manager::step_all() noexcept
+{
+  bool busy = false;
+  for (auto *actor : actor_list)
+  {
+    if (actor->terminated || actor->queue_length() == 0)
+      continue;
+    busy = true;
+    actor->run_slice(ACTOR_POOL_SLICE);
+  }
+  return busy;
+}
+
+// wait_drained() for deterministic mode: step until the mailboxes are empty
+bool Manager::step_drained(chrono::steady_clock::time_point deadline) noexcept
+{
+  while (step_all())
+  {
+    if (chrono::steady_clock::now() >= deadline)
+      return false;
+  }
+  return true;
 }
 
 void Manager::process_message(const Message *m)
@@ -164,21 +457,16 @@ void Manager::process_message(const Message *m)
   }
   else if (typeid(*m) == typeid(actors::msg::Shutdown))
   {
-    for (auto actor : actor_list)
-    {
-      actor->end();
-      actor->fast_terminate();
-      actor->terminated = true;
-    }
-    exit(0);
+    terminate();  // end() drains and stops the actors
   }
 }
 
-void Manager::manage(actor_ptr actor, set<int> affinity, int priority, int priority_type)
+void Manager::manage(actor_ptr actor, set<int> affinity, int priority, int priority_type,
+                     MailboxType mailbox, size_t mailbox_size, WaitStrategy wait)
 {
   assert(actor != nullptr && "cannot manage null actor");
 
-  if (actor->is_managed || managed_name_map.find(actor->get_name()) != managed_name_map.end())
+  if (actor->is_managed || expanded_name_map.find(actor->get_name()) != expanded_name_map.end())
   {
     cout << "actors already managed:\n";
     for (const auto &p : managed_name_map)
@@ -191,7 +479,7 @@ void Manager::manage(actor_ptr actor, set<int> affinity, int priority, int prior
   // Check affinity
   for (auto core_id : affinity)
   {
-    if (core_id < 0 || core_id >= sysconf(_SC_NPROCESSORS_ONLN))
+    if (!Topology::system().find(core_id))
     {
       cerr << "bad core id: " << core_id << endl;
       assert(false && "core id out of range");
@@ -199,25 +487,203 @@ void Manager::manage(actor_ptr actor, set<int> affinity, int priority, int prior
   }
 
   managed_name_map[actor->get_name()] = actor;
-  expanded_name_map[actor->get_name()] = actor;
-
-  actor->set_manager(this);
   actor_list.push_back(actor);
 
-  actor->is_managed = true;
+  // A group's members are addressable by name and ID, but only the group runs
+  vector<actor_ptr> named = {actor};
+  if (auto *group = dynamic_cast<Group *>(actor))
+    named.insert(named.end(), group->members().begin(), group->members().end());
+
+  for (auto *a : named)
+  {
+    if (a != actor && expanded_name_map.count(a->get_name()))
+    {
+      cerr << "group member name already managed: " << a->get_name() << endl;
+      assert(false && "actor with this name already managed");
+    }
+    expanded_name_map[a->get_name()] = a;
+    a->set_manager(this);
+    a->is_managed = true;
+    a->track_peers = placement_ == Placement::NUMA;
+    a->actor_id = ++last_id_;
+    if (!id_table_.set(a->actor_id, a))
+      assert(false && "too many actors for ACTOR_ID_MAX_CHUNKS");
+#ifdef ACTOR_TRACE
+    trace::name_actor(a->actor_id, a->get_name());
+#endif
+  }
+
   actor->affinity = affinity;
   actor->priority = priority;
   actor->priority_type = priority_type;
+  actor->wait = wait;
+
+  if (mailbox_size == 0)
+    mailbox_size = mailbox == MailboxType::SPSC || mailbox == MailboxType::MPSC
+                       ? ACTOR_LFQUEUE_SIZE : ACTOR_BQUEUE_SIZE;
+  {
+    // The mailbox is written by senders but drained on the actor's node
+    PreferNode local(placement_ == Placement::NUMA ? Topology::system().node_of(affinity) : -1);
+    actor->set_mailbox(mailbox, mailbox_size);
+  }
+  if (placement_ == Placement::NUMA && affinity.empty())
+    auto_placed_.insert(actor);
+
+  // Auto-register with GlobalRegistry if connected; init() registers the
+  // actors managed before it in one batch
+  if (started_ && registry_client_ && !local_endpoint_.empty()) {
+    for (auto *a : named) {
+      try {
+        registry_client_->register_actor(a->get_name(), local_endpoint_);
+        cout << "Manager: Registered '" << a->get_name() << "' with GlobalRegistry" << endl;
+      } catch (const registry::RegistryError& e) {
+        cerr << "Manager: Failed to register '" << a->get_name() << "': " << e.what() << endl;
+      }
+    }
+  }
+
+  // A router's workers run on their own threads, pinned as given to Router::add()
+  if (auto *router = dynamic_cast<Router *>(actor))
+  {
+    for (size_t i = 0; i < router->workers().size(); i++)
+    {
+      auto *worker = router->workers()[i];
+      if (!worker->is_managed)
+        manage(worker, router->worker_affinity(i));
+    }
+  }
+}
+
+void Manager::register_all()
+{
+  if (!registry_client_ || local_endpoint_.empty() || expanded_name_map.empty())
+    return;
+
+  // Group members are registered too; they receive their own messages
+  vector<string> names;
+  names.reserve(expanded_name_map.size());
+  for (auto &[name, actor] : expanded_name_map)
+    names.push_back(name);
+
+  try {
+    auto failed = registry_client_->register_actors(names, local_endpoint_);
+    for (const auto &f : failed)
+      cerr << "Manager: Failed to register '" << f.actor_name << "': " << f.reason << endl;
+    cout << "Manager: Registered " << names.size() - failed.size() << " of " << names.size()
+         << " actors with GlobalRegistry" << endl;
+  } catch (const registry::RegistryError& e) {
+    cerr << "Manager: Failed to register actors: " << e.what() << endl;
+  }
+}
+
+void Manager::set_scheduler(size_t workers, set<int> affinity)
+{
+  assert(!scheduler_ && "scheduler already configured");
+
+  for (auto core_id : affinity)
+  {
+    if (!Topology::system().find(core_id))
+    {
+      cerr << "bad core id: " << core_id << endl;
+      assert(false && "core id out of range");
+    }
+  }
+
+  scheduler_ = make_unique<Scheduler>(workers, affinity);
+}
 
-  // Auto-register with GlobalRegistry if connected
-  if (registry_client_ && !local_endpoint_.empty()) {
-    try {
-      registry_client_->register_actor(actor->get_name(), local_endpoint_);
-      cout << "Manager: Registered '" << actor->get_name() << "' with GlobalRegistry" << endl;
-    } catch (const registry::RegistryError& e) {
-      cerr << "Manager: Failed to register '" << actor->get_name() << "': " << e.what() << endl;
+void Manager::manage_pooled(actor_ptr actor, MailboxType mailbox, size_t mailbox_size)
+{
+  manage(actor, {}, 0, SCHED_OTHER, mailbox, mailbox_size);
+
+  if (!scheduler_)
+    scheduler_ = make_unique<Scheduler>(0);
+  scheduler_->add(actor);
+}
+
+vector<Traffic> Manager::get_traffic() const
+{
+  vector<Traffic> ret;
+  for (auto &[name, actor] : expanded_name_map)
+  {
+    const PeerCounts &p = actor->peers_;
+    for (int i = 0; i < PeerCounts::SLOTS; i++)
+    {
+      auto n = p.count[i].load(memory_order_relaxed);
+      if (n > 0)
+        ret.push_back({p.id[i].load(memory_order_relaxed), actor->actor_id, n});
+    }
+  }
+  return ret;
+}
+
+map<string, int> Manager::colocate(set<int> cpus)
+{
+  const Topology &topo = Topology::system();
+
+  // Only actors with a thread of their own move
+  vector<actor_ptr> movable;
+  for (auto actor : actor_list)
+  {
+    if (auto_placed_.count(actor) && !actor->scheduler)
+      movable.push_back(actor);
+  }
+
+  if (cpus.empty())
+  {
+    for (auto &c : topo.cpus())
+      cpus.insert(c.cpu);
+    set<int> pinned;
+    for (auto actor : actor_list)
+    {
+      if (!auto_placed_.count(actor))
+        pinned.insert(actor->affinity.begin(), actor->affinity.end());
     }
+    if (pinned.size() < cpus.size())
+      for (int cpu : pinned)
+        cpus.erase(cpu);
+  }
+
+  // Group members talk through their group's thread
+  map<ActorId, ActorId> owner;
+  for (auto actor : actor_list)
+  {
+    owner[actor->actor_id] = actor->actor_id;
+    if (auto *group = dynamic_cast<Group *>(actor))
+      for (auto *member : group->members())
+        owner[member->actor_id] = actor->actor_id;
+  }
+  vector<Traffic> traffic;
+  for (auto t : get_traffic())
+  {
+    auto from = owner.find(t.from);
+    auto to = owner.find(t.to);
+    if (from != owner.end() && to != owner.end())
+      traffic.push_back({from->second, to->second, t.messages});
   }
+
+  vector<ActorId> ids;
+  for (auto actor : movable)
+    ids.push_back(actor->actor_id);
+  auto plan = place_by_traffic(topo, vector<int>(cpus.begin(), cpus.end()), ids, traffic);
+
+  map<string, int> ret;
+  for (size_t i = 0; i < movable.size(); i++)
+  {
+    auto actor = movable[i];
+    actor->affinity = {plan[i]};
+    ret[actor->get_name()] = plan[i];
+
+    // Not started yet: init() pins it
+    if (actor->tid == 0)
+      continue;
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(plan[i], &cpuset);
+    if (sched_setaffinity(actor->tid, sizeof(cpu_set_t), &cpuset) != 0)
+      perror("could not move actor");
+  }
+  return ret;
 }
 
 map<string, size_t> Manager::get_queue_lengths() const noexcept
@@ -230,14 +696,90 @@ map<string, size_t> Manager::get_queue_lengths() const noexcept
   return ret;
 }
 
-map<string, tuple<pid_t, int>> Manager::get_message_counts() const noexcept
+map<string, size_t> Manager::get_queue_lengths(Lane lane) const noexcept
+{
+  map<string, size_t> ret;
+  for (auto &[name, actor] : managed_name_map)
+  {
+    ret[name] = actor->queue_length(lane);
+  }
+  return ret;
+}
+
+list<string> Manager::get_backpressured() const noexcept
+{
+  list<string> ret;
+  for (auto &[name, actor] : managed_name_map)
+  {
+    if (actor->above_watermark())
+      ret.push_back(name);
+  }
+  return ret;
+}
+
+map<string, size_t> Manager::get_conflation_counts() const noexcept
+{
+  map<string, size_t> ret;
+  for (auto &[name, actor] : managed_name_map)
+  {
+    if (actor->mailbox_type() == MailboxType::CONFLATING)
+      ret[name] = actor->conflated_count();
+  }
+  return ret;
+}
+
+map<string, tuple<pid_t, uint64_t>> Manager::get_message_counts() const noexcept
+{
+  map<string, tuple<pid_t, uint64_t>> ret;
+  for (auto &[name, actor] : managed_name_map)
+    ret[name] = make_tuple(actor->tid, actor->message_count());
+  return ret;
+}
+
+map<string, ActorMetrics> Manager::get_metrics() const noexcept
+{
+  map<string, ActorMetrics> ret;
+  double ns_per_tick = tsc_ns_per_tick();
+  for (auto &[name, actor] : managed_name_map)
+  {
+    const ActorCounters &c = actor->counters();
+    ActorMetrics &m = ret[name];
+    m.id = actor->get_id();
+    m.tid = actor->tid;
+    m.messages = c.messages.load(memory_order_relaxed);
+    m.bytes_in = c.bytes_in.load(memory_order_relaxed);
+    m.dropped = c.dropped.load(memory_order_relaxed);
+    m.rejected = c.rejected.load(memory_order_relaxed);
+    m.queue_length = actor->queue_length();
+    m.queue_high_water = max<uint64_t>(c.queue_high_water.load(memory_order_relaxed), m.queue_length);
+    if (actor->mailbox_type() == MailboxType::CONFLATING)
+      m.conflated = actor->conflated_count();
+    if (auto *l = actor->latency())
+      m.handler_ns = double(l->handler.sum()) * ns_per_tick;
+  }
+  return ret;
+}
+
+map<string, LatencyReport> Manager::get_latencies() const noexcept
 {
-  map<string, tuple<pid_t, int>> ret;
+  map<string, LatencyReport> ret;
+  double ns_per_tick = tsc_ns_per_tick();
   for (auto &[name, actor] : managed_name_map)
-    ret[name] = make_tuple(actor->tid, int(actor->msg_cnt));
+  {
+    if (auto *l = actor->latency())
+      ret[name] = {l->queue_wait.summary(ns_per_tick), l->handler.summary(ns_per_tick)};
+  }
   return ret;
 }
 
+map<int, LatencyReport> Manager::get_latencies_by_id(const string &name) const
+{
+  auto *actor = get_local_actor(name);
+  if (!actor || !actor->latency())
+    return {};
+  return actor->latency()->report_by_id(tsc_ns_per_tick());
+}
+
 list<string> Manager::get_managed_names() const noexcept
 {
   list<string> ret;
@@ -254,6 +796,12 @@ actor_ptr Manager::get_local_actor(const string &name) const noexcept
   return nullptr;
 }
 
+ActorId Manager::get_actor_id(const string &name) const noexcept
+{
+  auto *actor = get_local_actor(name);
+  return actor ? actor->get_id() : NO_ACTOR_ID;
+}
+
 ActorRef Manager::get_actor_by_name(const string &name)
 {
   // First check local actors
@@ -265,6 +813,17 @@ ActorRef Manager::get_actor_by_name(const string &name)
   if (registry_client_ && zmq_sender_) {
     // This will throw ActorNotFoundError or ActorOfflineError if not found/offline
     string endpoint = registry_client_->lookup(name);
+
+    // Same host and the target serves a ring: bypass TCP
+    if (shm_transport_ && shm::is_local_host(endpoint)) {
+      lock_guard<mutex> lock(shm_mut_);  // Actor threads look up names too
+      auto& ring = shm_rings_[endpoint];
+      if (!ring || ring->closed())  // closed: target exited, crashed or restarted
+        ring = ShmRing::open(shm::ring_name(endpoint));
+      if (ring)
+        return ActorRef(ShmActorRef(ring, RemoteActorRef(name, endpoint, zmq_sender_)));
+      shm_rings_.erase(endpoint);
+    }
     return zmq_sender_->remote_ref(name, endpoint);
   }
 
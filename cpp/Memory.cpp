@@ -0,0 +1,207 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#include <algorithm>
+#include <alloca.h>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "actors/Memory.hpp"
+
+using namespace std;
+using namespace actors;
+
+namespace
+{
+  atomic<bool> huge_enabled{false};
+  atomic<size_t> huge_total{0};
+
+  // Bump allocator over huge-page chunks, for pool slabs
+  struct Arena
+  {
+    mutex mut;
+    char *next = nullptr;
+    size_t left = 0;
+
+    // Caller holds mut
+    void grow(size_t bytes)
+    {
+      size_t mapped;
+      next = static_cast<char *>(memory::map_huge(max<size_t>(bytes, ACTOR_POOL_ARENA_BYTES), mapped));
+      left = mapped;
+    }
+  };
+
+  Arena &arena()
+  {
+    static Arena *a = new Arena();  // never destroyed: slabs outlive statics
+    return *a;
+  }
+
+  size_t page_size()
+  {
+    static const size_t size = size_t(sysconf(_SC_PAGESIZE));
+    return size;
+  }
+}
+
+size_t memory::huge_page_size() noexcept
+{
+  static const size_t size = []() {
+    size_t n = 0;
+    ifstream in("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+    return in >> n && n ? n : size_t(2 * 1024 * 1024);
+  }();
+  return size;
+}
+
+void memory::set_huge_pages(bool enabled) noexcept
+{
+  huge_enabled.store(enabled, memory_order_relaxed);
+}
+
+bool memory::huge_pages() noexcept
+{
+  return huge_enabled.load(memory_order_relaxed);
+}
+
+void *memory::map_huge(size_t bytes, size_t &mapped)
+{
+  const size_t unit = huge_page_size();
+  mapped = (max<size_t>(bytes, 1) + unit - 1) / unit * unit;
+
+  // Over-map by one huge page, then trim to an aligned range
+  void *p = ::mmap(nullptr, mapped + unit, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED)
+    throw bad_alloc();
+  char *base = static_cast<char *>(p);
+  char *aligned = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(base) + unit - 1) / unit * unit);
+  if (aligned > base)
+    ::munmap(base, size_t(aligned - base));
+  if (size_t tail = unit - size_t(aligned - base))
+    ::munmap(aligned + mapped, tail);
+#ifdef MADV_HUGEPAGE
+  ::madvise(aligned, mapped, MADV_HUGEPAGE);  // Best effort: THP may be off
+#endif
+  huge_total.fetch_add(mapped, memory_order_relaxed);
+  return aligned;
+}
+
+void memory::unmap_huge(void *p, size_t mapped) noexcept
+{
+  if (!p)
+    return;
+  ::munmap(p, mapped);
+  huge_total.fetch_sub(mapped, memory_order_relaxed);
+}
+
+void *memory::slab(size_t bytes, size_t align)
+{
+  if (!huge_pages())
+    return ::operator new(bytes, align_val_t(align));
+
+  Arena &a = arena();
+  lock_guard<mutex> lock(a.mut);
+  size_t pad = (align - reinterpret_cast<uintptr_t>(a.next) % align) % align;
+  if (!a.next || a.left < pad + bytes) {
+    a.grow(bytes + align);
+    pad = 0;  // Chunks are huge-page aligned
+  }
+  char *p = a.next + pad;
+  a.next = p + bytes;
+  a.left -= pad + bytes;
+  return p;
+}
+
+size_t memory::reserve_slabs() noexcept
+{
+  if (!huge_pages())
+    return 0;
+  Arena &a = arena();
+  lock_guard<mutex> lock(a.mut);
+  try {
+    if (a.left < ACTOR_POOL_ARENA_BYTES / 2)
+      a.grow(ACTOR_POOL_ARENA_BYTES);
+  } catch (const bad_alloc &) {
+    return 0;
+  }
+  return prefault(a.next, a.left);
+}
+
+size_t memory::prefault(void *p, size_t bytes) noexcept
+{
+  if (!p || bytes == 0)
+    return 0;
+  const uintptr_t page = page_size();
+  uintptr_t at = reinterpret_cast<uintptr_t>(p);
+  const uintptr_t end = at + bytes;
+  // An atomic add of zero writes the page without racing its users
+  for (; at < end; at = (at / page + 1) * page)
+    __atomic_fetch_add(reinterpret_cast<char *>(at), 0, __ATOMIC_RELAXED);
+  return bytes;
+}
+
+size_t memory::prefault_stack(size_t bytes) noexcept
+{
+  volatile char *stack = static_cast<volatile char *>(alloca(bytes));
+  const size_t page = page_size();
+  for (size_t i = 0; i < bytes; i += page)
+    stack[i] = 0;
+  return bytes;
+}
+
+size_t memory::huge_bytes() noexcept
+{
+  return huge_total.load(memory_order_relaxed);
+}
+
+size_t memory::locked_bytes()
+{
+  ifstream in("/proc/self/status");
+  string line;
+  while (getline(in, line)) {
+    size_t kb;
+    if (sscanf(line.c_str(), "VmLck: %zu kB", &kb) == 1)
+      return kb * 1024;
+  }
+  return 0;
+}
@@ -7,13 +7,47 @@ Copyright 2025 Vincent Maciejewski, & M2 Tech
 */
 
 #include "actors/registry/RegistryClient.hpp"
+#include "actors/msg/Timeout.hpp"
+#include "actors/remote/ZmqSender.hpp"
+#include <cstdio>
 #include <iostream>
 
 namespace actors::registry {
 
+// Pushed events and subscription replies travel as JSON
+REGISTER_REMOTE_MESSAGE_2(ActorMoved, actor_name, std::string, actor_endpoint, std::string)
+REGISTER_REMOTE_MESSAGE_2(ManagerOffline, manager_id, std::string, actor_names, std::vector<std::string>)
+REGISTER_REMOTE_MESSAGE_1(ManagerOnline, manager_id, std::string)
+REGISTER_REMOTE_MESSAGE_4(SubscribeRegistry, subscriber, std::string, subscriber_endpoint, std::string,
+                          actor_names, std::vector<std::string>, manager_ids, std::vector<std::string>)
+REGISTER_REMOTE_MESSAGE_4(UnsubscribeRegistry, subscriber, std::string, subscriber_endpoint, std::string,
+                          actor_names, std::vector<std::string>, manager_ids, std::vector<std::string>)
+REGISTER_REMOTE_MESSAGE_1(SubscriptionOk, subscriber, std::string)
+
+// Heartbeat timer target and receiver of pushed events. Never started with
+// a thread; like RemoteReplyProxy it handles each message inside send().
+class RegistryClient::Listener : public Actor {
+public:
+    explicit Listener(RegistryClient* client) : client_(client) {
+        snprintf(name, sizeof(name), "$registry:%s", client->manager_id_.c_str());
+    }
+
+    void send(const Message* m, Actor* /*sender*/ = nullptr) noexcept override {
+        if (dynamic_cast<const msg::Timeout*>(m))
+            client_->send_heartbeat();
+        else
+            client_->on_push(m);
+        m->release();
+    }
+
+private:
+    RegistryClient* client_;
+};
+
 RegistryClient::RegistryClient(const std::string& manager_id, ActorRef registry_ref)
     : manager_id_(manager_id)
     , registry_ref_(std::move(registry_ref))
+    , listener_(std::make_unique<Listener>(this))
 {
 }
 
@@ -30,34 +64,101 @@ void RegistryClient::start_heartbeat() {
 
     running_.store(true);
 
-    heartbeat_thread_ = std::make_unique<std::thread>([this]() {
-        heartbeat_loop();
-    });
+    send_heartbeat();
+    heartbeat_timer_ = TimerWheel::instance().schedule(listener_.get(), heartbeat_interval_, 0,
+                                                       heartbeat_interval_);
 }
 
 void RegistryClient::stop_heartbeat() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
     running_.store(false);
 
-    if (heartbeat_thread_ && heartbeat_thread_->joinable()) {
-        heartbeat_thread_->join();
+    if (heartbeat_timer_) {
+        // A heartbeat being sent still uses listener_ and *this
+        TimerWheel::instance().cancel_and_wait(heartbeat_timer_);
+        heartbeat_timer_ = TimerHandle{};
     }
-    heartbeat_thread_.reset();
 }
 
-void RegistryClient::heartbeat_loop() {
-    while (running_.load()) {
-        try {
-            Heartbeat hb(manager_id_);
-            registry_ref_.send(new Heartbeat(hb), nullptr);
-        } catch (const std::exception& e) {
-            std::cerr << "RegistryClient: heartbeat failed: " << e.what() << std::endl;
-        }
+void RegistryClient::send_heartbeat() {
+    if (!running_.load()) {
+        return;
+    }
+    try {
+        auto interval = static_cast<uint32_t>(heartbeat_interval_.count());
+        registry_ref_.send(new Heartbeat(manager_id_, interval), nullptr);
+    } catch (const std::exception& e) {
+        std::cerr << "RegistryClient: heartbeat failed: " << e.what() << std::endl;
+    }
+}
+
+void RegistryClient::on_push(const Message* m) {
+    handle_update(m);
 
-        // Sleep for 2 seconds
-        std::this_thread::sleep_for(std::chrono::seconds(2));
+    EventCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(event_mutex_);
+        callback = on_event_;
+    }
+    if (callback) {
+        callback(*m);
     }
 }
 
+void RegistryClient::on_event(EventCallback callback) {
+    std::lock_guard<std::mutex> lock(event_mutex_);
+    on_event_ = std::move(callback);
+}
+
+Actor* RegistryClient::listener() const {
+    return listener_.get();
+}
+
+std::string RegistryClient::listener_name() const {
+    return listener_->get_name();
+}
+
+void RegistryClient::subscribe(const std::vector<std::string>& actor_names,
+                               const std::vector<std::string>& manager_ids,
+                               const std::string& endpoint) {
+    subscriber_endpoint_ = endpoint;
+
+    auto reply = request(new SubscribeRegistry(listener_name(), endpoint, actor_names, manager_ids));
+
+    if (!reply) {
+        throw TimeoutError("No response from registry for subscription");
+    }
+
+    if (!dynamic_cast<const SubscriptionOk*>(reply.get())) {
+        throw RegistryError("Unexpected response type from registry");
+    }
+}
+
+void RegistryClient::unsubscribe(const std::vector<std::string>& actor_names,
+                                 const std::vector<std::string>& manager_ids) {
+    auto reply = request(new UnsubscribeRegistry(listener_name(), subscriber_endpoint_,
+                                                 actor_names, manager_ids));
+
+    if (!reply) {
+        throw TimeoutError("No response from registry for unsubscription");
+    }
+
+    if (!dynamic_cast<const SubscriptionOk*>(reply.get())) {
+        throw RegistryError("Unexpected response type from registry");
+    }
+}
+
+std::unique_ptr<const Message> RegistryClient::request(const Message* m) {
+    // A local registry answers before ask() returns; a remote ask times
+    // out through the timer service, the extra bound only covers a
+    // ZmqSender that is not running yet
+    AskFuture reply = registry_ref_.ask(m, timeout_);
+    if (reply.wait_for(timeout_ + std::chrono::milliseconds(100)) != std::future_status::ready)
+        return nullptr;
+    return reply.get();
+}
+
 void RegistryClient::register_actor(const std::string& actor_name, const std::string& endpoint) {
     RegisterActor msg(manager_id_, actor_name, ActorRef());
     // For remote registration, we pass endpoint as string in a modified message
@@ -66,15 +167,16 @@ void RegistryClient::register_actor(const std::string& actor_name, const std::st
     // Create a registration message
     // Note: The Python GlobalRegistry expects actor_endpoint as a string
     // For C++ -> Python communication, we'll need serialization
-    // For now, use fast_send with local registry
+    // For now this only works with a local registry
 
-    auto reply = registry_ref_.fast_send(new RegisterActor(msg), nullptr);
+    auto reply = request(new RegisterActor(msg));
 
     if (!reply) {
         throw TimeoutError("No response from registry for registration");
     }
 
     if (dynamic_cast<const RegistrationOk*>(reply.get())) {
+        invalidate(actor_name);  // A cached "not found" is stale now
         return;  // Success
     }
 
@@ -88,13 +190,14 @@ void RegistryClient::register_actor(const std::string& actor_name, const std::st
 void RegistryClient::register_actor(const std::string& actor_name, const ActorRef& actor_ref) {
     RegisterActor msg(manager_id_, actor_name, actor_ref);
 
-    auto reply = registry_ref_.fast_send(new RegisterActor(msg), nullptr);
+    auto reply = request(new RegisterActor(msg));
 
     if (!reply) {
         throw TimeoutError("No response from registry for registration");
     }
 
     if (dynamic_cast<const RegistrationOk*>(reply.get())) {
+        invalidate(actor_name);  // A cached "not found" is stale now
         return;  // Success
     }
 
@@ -105,59 +208,155 @@ void RegistryClient::register_actor(const std::string& actor_name, const ActorRe
     throw RegistryError("Unexpected response type from registry");
 }
 
-std::string RegistryClient::lookup(const std::string& actor_name) {
+RegistryClient::CacheEntry RegistryClient::resolve(const std::string& actor_name) {
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        auto it = cache_.find(actor_name);
+        if (it != cache_.end()) {
+            if (it->second.expires > now) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return it->second;
+            }
+            cache_.erase(it);
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+
     LookupActor msg(actor_name);
 
-    auto reply = registry_ref_.fast_send(new LookupActor(msg), nullptr);
+    auto reply = request(new LookupActor(msg));
 
     if (!reply) {
         throw TimeoutError("No response from registry for lookup");
     }
 
-    if (auto* result = dynamic_cast<const LookupResult*>(reply.get())) {
-        if (!result->actor_ref.has_value()) {
-            throw ActorNotFoundError(actor_name);
-        }
-
-        if (!result->online) {
-            throw ActorOfflineError(actor_name);
-        }
+    auto* result = dynamic_cast<const LookupResult*>(reply.get());
+    if (!result) {
+        throw RegistryError("Unexpected response type from registry");
+    }
 
+    CacheEntry entry;
+    entry.found = result->actor_ref.has_value();
+    entry.online = result->online;
+    entry.manager_id = result->manager_id;
+    if (entry.found) {
         // Return the endpoint from the ActorRef if it's remote
+        // For local refs, leave it empty (caller should use get_actor_by_name)
         const auto& ref = result->actor_ref.value();
         if (ref.is_remote()) {
-            return ref.remote_ref().endpoint();
+            entry.endpoint = ref.remote_ref().endpoint();
         }
-        // For local refs, return empty string (caller should use get_actor_by_name)
-        return "";
     }
 
-    throw RegistryError("Unexpected response type from registry");
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto ttl = entry.found && entry.online ? positive_ttl_ : negative_ttl_;
+    if (ttl.count() > 0) {
+        entry.expires = std::chrono::steady_clock::now() + ttl;
+        cache_[actor_name] = entry;
+    }
+    return entry;
 }
 
-std::pair<std::string, bool> RegistryClient::lookup_allow_offline(const std::string& actor_name) {
-    LookupActor msg(actor_name);
+std::vector<RegisterActorsResult::Failure> RegistryClient::register_actors(
+    const std::vector<std::string>& actor_names, const std::string& endpoint) {
+    std::vector<RegisterActors::Entry> entries;
+    entries.reserve(actor_names.size());
+    for (const auto& name : actor_names) {
+        entries.push_back({name, endpoint});
+    }
 
-    auto reply = registry_ref_.fast_send(new LookupActor(msg), nullptr);
+    auto reply = request(new RegisterActors(manager_id_, std::move(entries)));
 
     if (!reply) {
-        throw TimeoutError("No response from registry for lookup");
+        throw TimeoutError("No response from registry for bulk registration");
     }
 
-    if (auto* result = dynamic_cast<const LookupResult*>(reply.get())) {
-        if (!result->actor_ref.has_value()) {
-            throw ActorNotFoundError(actor_name);
-        }
+    auto* result = dynamic_cast<const RegisterActorsResult*>(reply.get());
+    if (!result) {
+        throw RegistryError("Unexpected response type from registry");
+    }
 
-        const auto& ref = result->actor_ref.value();
-        std::string endpoint;
-        if (ref.is_remote()) {
-            endpoint = ref.remote_ref().endpoint();
+    // Cached "not found" entries are stale for the ones that went through
+    for (const auto& name : actor_names) {
+        invalidate(name);
+    }
+    return result->failed;
+}
+
+std::string RegistryClient::lookup(const std::string& actor_name) {
+    CacheEntry entry = resolve(actor_name);
+
+    if (!entry.found) {
+        throw ActorNotFoundError(actor_name);
+    }
+
+    if (!entry.online) {
+        throw ActorOfflineError(actor_name);
+    }
+
+    return entry.endpoint;
+}
+
+std::pair<std::string, bool> RegistryClient::lookup_allow_offline(const std::string& actor_name) {
+    CacheEntry entry = resolve(actor_name);
+
+    if (!entry.found) {
+        throw ActorNotFoundError(actor_name);
+    }
+
+    return {entry.endpoint, entry.online};
+}
+
+void RegistryClient::set_cache_ttl(std::chrono::milliseconds positive, std::chrono::milliseconds negative) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    positive_ttl_ = positive;
+    negative_ttl_ = negative;
+}
+
+bool RegistryClient::handle_update(const Message* m) {
+    if (auto* moved = dynamic_cast<const ActorMoved*>(m)) {
+        invalidate(moved->actor_name);
+        return true;
+    }
+    if (auto* offline = dynamic_cast<const ManagerOffline*>(m)) {
+        invalidate_manager(offline->manager_id);
+        for (const auto& name : offline->actor_names) {
+            invalidate(name);
         }
-        return {endpoint, result->online};
+        return true;
     }
+    if (auto* online = dynamic_cast<const ManagerOnline*>(m)) {
+        invalidate_manager(online->manager_id);  // Cached "offline" is stale
+        return true;
+    }
+    return false;
+}
 
-    throw RegistryError("Unexpected response type from registry");
+void RegistryClient::invalidate(const std::string& actor_name) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    invalidations_.fetch_add(cache_.erase(actor_name), std::memory_order_relaxed);
+}
+
+void RegistryClient::invalidate_manager(const std::string& manager_id) {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto n = std::erase_if(cache_, [&](const auto& item) {
+        return item.second.manager_id == manager_id;
+    });
+    invalidations_.fetch_add(n, std::memory_order_relaxed);
+}
+
+void RegistryClient::clear_cache() {
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    cache_.clear();
+}
+
+LookupCacheStats RegistryClient::cache_stats() const {
+    LookupCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+    return stats;
 }
 
 } // namespace actors::registry
@@ -0,0 +1,38 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+RemoteActorRef - sends over the ZmqSender the reference was made from.
+Defined here once, so every program gets the same definitions.
+
+*/
+
+#include "actors/ActorRef.hpp"
+#include "actors/remote/ZmqSender.hpp"
+
+namespace actors {
+
+void RemoteActorRef::send(const Message* m, Actor* sender) {
+    sender_->send_to(endpoint_, name_, m, sender);
+}
+
+void RemoteActorRef::send_to_each(const std::vector<std::string>& names, const Message* m,
+                                  Actor* sender) const {
+    sender_->send_to_each(endpoint_, names, m, sender);
+}
+
+void RemoteActorRef::set_batching(const BatchPolicy& policy) const {
+    sender_->set_batching(endpoint_, policy);
+}
+
+AskFuture RemoteActorRef::ask(const Message* m, std::chrono::milliseconds timeout) const {
+    return sender_->ask(endpoint_, name_, m, timeout);
+}
+
+void RemoteActorRef::ask(const Message* m, AskCallback done, std::chrono::milliseconds timeout) const {
+    sender_->ask(endpoint_, name_, m, std::move(done), timeout);
+}
+
+} // namespace actors
@@ -15,7 +15,7 @@ If you're using C++/Rust interop, link with the interop library instead.
 namespace actors {
 
 void RustActorRef::send(const Message* m, Actor*) {
-    delete m;
+    m->release();
     throw std::runtime_error("RustActorRef::send() not available - link with interop library for C++/Rust communication");
 }
 
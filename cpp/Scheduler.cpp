@@ -0,0 +1,243 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#include <iostream>
+#include <cassert>
+#include <pthread.h>
+#include <unistd.h>
+#include "actors/Scheduler.hpp"
+#include "actors/Actor.hpp"
+#include "actors/Queue.hpp"
+#include "actors/Backoff.hpp"
+
+using namespace std;
+using namespace actors;
+
+Scheduler::Scheduler(size_t workers, set<int> affinity) : affinity_(std::move(affinity))
+{
+  if (workers == 0)
+    workers = max<long>(1, sysconf(_SC_NPROCESSORS_ONLN));
+  for (size_t i = 0; i < workers; i++)
+    queues_.push_back(make_unique<RunQueue>());
+}
+
+Scheduler::~Scheduler()
+{
+  stop();
+}
+
+void Scheduler::add(Actor *actor)
+{
+  assert(workers_.empty() && "add() after start()");
+  assert(actor->scheduler == nullptr && "actor already pooled");
+  actor->scheduler = this;
+  actors_.push_back(actor);
+  live_.fetch_add(1, memory_order_relaxed);
+
+  // Anything already in the mailbox (e.g. Start) must not be stranded
+  if (!actor->msgq->is_empty())
+    notify(actor);
+}
+
+void Scheduler::start()
+{
+  assert(workers_.empty() && "scheduler already started");
+
+  for (auto *actor : actors_)
+    actor->start_pooled();
+
+  vector<int> cores(affinity_.begin(), affinity_.end());
+  for (size_t i = 0; i < queues_.size(); i++) {
+    workers_.emplace_back([this, i]() { worker_loop(i); });
+    if (cores.empty())
+      continue;
+
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cores[i % cores.size()], &cpuset);
+    if (pthread_setaffinity_np(workers_.back().native_handle(), sizeof(cpu_set_t), &cpuset) != 0)
+      cerr << "Scheduler: could not pin worker " << i << " to core " << cores[i % cores.size()] << endl;
+  }
+}
+
+void Scheduler::join()
+{
+  {
+    unique_lock<mutex> lock(done_mut_);
+    done_cv_.wait(lock, [this]() { return live_.load(memory_order_acquire) == 0; });
+  }
+  stop();
+}
+
+void Scheduler::stop() noexcept
+{
+  stopping_.store(true, memory_order_seq_cst);
+  {
+    lock_guard<mutex> lock(sleep_mut_);
+    sleep_cv_.notify_all();
+  }
+  for (auto &t : workers_) {
+    if (t.joinable())
+      t.join();
+  }
+}
+
+void Scheduler::notify(Actor *actor) noexcept
+{
+  // Pairs with the fence in run(): either we see IDLE, or the worker sees our message
+  atomic_thread_fence(memory_order_seq_cst);
+  if (actor->sched_state.load(memory_order_relaxed) != Actor::POOL_IDLE)
+    return;
+
+  int expected = Actor::POOL_IDLE;
+  if (actor->sched_state.compare_exchange_strong(expected, Actor::POOL_QUEUED,
+                                                 memory_order_acq_rel))
+    submit(actor);
+}
+
+void Scheduler::submit(Actor *actor) noexcept
+{
+  // Workers keep their own actors local; everyone else spreads round-robin
+  size_t index = current_ == this
+    ? current_index_
+    : next_queue_.fetch_add(1, memory_order_relaxed) % queues_.size();
+
+  {
+    auto &rq = *queues_[index];
+    lock_guard<mutex> lock(rq.mut);
+    rq.q.push_back(actor);
+    rq.size.store(rq.q.size(), memory_order_relaxed);
+  }
+
+  pending_.fetch_add(1, memory_order_seq_cst);
+  if (sleepers_.load(memory_order_seq_cst) > 0) {
+    lock_guard<mutex> lock(sleep_mut_);
+    sleep_cv_.notify_one();
+  }
+}
+
+Actor *Scheduler::next(size_t index) noexcept
+{
+  const size_t n = queues_.size();
+  for (size_t k = 0; k < n; k++) {
+    auto &rq = *queues_[(index + k) % n];
+    if (rq.size.load(memory_order_relaxed) == 0)
+      continue;
+
+    lock_guard<mutex> lock(rq.mut);
+    if (rq.q.empty())
+      continue;
+
+    Actor *actor;
+    if (k == 0) {
+      actor = rq.q.front();  // own queue: oldest first, for fairness
+      rq.q.pop_front();
+    } else {
+      actor = rq.q.back();   // steal from the far end
+      rq.q.pop_back();
+      steals_.fetch_add(1, memory_order_relaxed);
+    }
+    rq.size.store(rq.q.size(), memory_order_relaxed);
+    pending_.fetch_sub(1, memory_order_relaxed);
+    return actor;
+  }
+  return nullptr;
+}
+
+void Scheduler::run(Actor *actor) noexcept
+{
+  if (!actor->run_slice(ACTOR_POOL_SLICE)) {
+    actor->sched_state.store(Actor::POOL_DONE, memory_order_release);
+    retire();
+    return;
+  }
+
+  // Slice used up: go to the back of the line, still marked QUEUED
+  if (!actor->msgq->is_empty()) {
+    submit(actor);
+    return;
+  }
+
+  actor->sched_state.store(Actor::POOL_IDLE, memory_order_release);
+  atomic_thread_fence(memory_order_seq_cst);
+
+  // A producer may have pushed after our last pop but before it could see IDLE
+  if (!actor->msgq->is_empty()) {
+    int expected = Actor::POOL_IDLE;
+    if (actor->sched_state.compare_exchange_strong(expected, Actor::POOL_QUEUED,
+                                                   memory_order_acq_rel))
+      submit(actor);
+  }
+}
+
+void Scheduler::retire() noexcept
+{
+  if (live_.fetch_sub(1, memory_order_acq_rel) == 1) {
+    lock_guard<mutex> lock(done_mut_);
+    done_cv_.notify_all();
+  }
+}
+
+void Scheduler::worker_loop(size_t index) noexcept
+{
+  current_ = this;
+  current_index_ = index;
+  unsigned idle = 0;
+
+  while (true) {
+    if (Actor *actor = next(index)) {
+      run(actor);
+      idle = 0;
+      continue;
+    }
+
+    if (stopping_.load(memory_order_relaxed))
+      return;
+
+    if (++idle < ACTOR_POOL_SPIN) {
+      cpu_relax();
+      continue;
+    }
+
+    unique_lock<mutex> lock(sleep_mut_);
+    sleepers_.fetch_add(1, memory_order_seq_cst);
+    sleep_cv_.wait(lock, [this]() {
+      return pending_.load(memory_order_seq_cst) > 0 || stopping_.load(memory_order_relaxed);
+    });
+    sleepers_.fetch_sub(1, memory_order_relaxed);
+    idle = 0;
+  }
+}
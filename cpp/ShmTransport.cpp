@@ -0,0 +1,35 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+ShmActorRef::send() - producer side of the same-host shared-memory transport.
+
+*/
+
+#include "actors/ActorRef.hpp"
+#include "actors/remote/ShmRing.hpp"
+#include "actors/remote/ZmqSender.hpp"
+
+namespace actors {
+
+void ShmActorRef::send(const Message* m, Actor* sender) {
+    // One encode buffer per thread; it keeps its capacity between sends
+    thread_local std::string buf;
+    const auto& zmq = tcp_.sender();
+    try {
+        zmq->encode(tcp_.endpoint(), tcp_.name(), m, sender, buf, true);
+    } catch (...) {
+        m->release();
+        throw;
+    }
+
+    if (ring_->push(buf.data(), buf.size())) {
+        m->release();
+        return;
+    }
+    tcp_.send(m, sender);  // larger than a ring slot, full for too long, or closed
+}
+
+} // namespace actors
@@ -0,0 +1,442 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include "actors/act/TimerWheel.hpp"
+#include "actors/msg/Timeout.hpp"
+#include "actors/Actor.hpp"
+
+using namespace std;
+using namespace std::chrono;
+using namespace actors;
+
+TimerWheel::TimerWheel(microseconds resolution)
+  : resolution_(resolution), start_(steady_clock::now())
+{
+  assert(resolution.count() > 0 && "timer resolution must be positive");
+  wheel_[0].resize(size_t(1) << L0_BITS, nullptr);
+  for (int level = 1; level < LEVELS; level++)
+    wheel_[level].resize(size_t(1) << LN_BITS, nullptr);
+  thread_ = std::thread([this]() { run(); });
+}
+
+TimerWheel::~TimerWheel()
+{
+  {
+    lock_guard<mutex> lock(mut_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+
+  for (auto &[id, e] : active_)
+    delete e;
+}
+
+TimerWheel& TimerWheel::instance()
+{
+  // Leaked on purpose: actors may still set timers while statics are torn down
+  static TimerWheel *wheel = new TimerWheel();
+  return *wheel;
+}
+
+uint64_t TimerWheel::clock_tick() const noexcept
+{
+  return uint64_t((steady_clock::now() - start_) / resolution_);
+}
+
+// Caller holds mut_
+uint64_t TimerWheel::now_tick() const noexcept
+{
+  return virtual_ ? virtual_now_ : clock_tick() + offset_;
+}
+
+steady_clock::time_point TimerWheel::now() const noexcept
+{
+  lock_guard<mutex> lock(mut_);
+  return start_ + resolution_ * int64_t(now_tick());
+}
+
+void TimerWheel::set_virtual(bool on)
+{
+  {
+    lock_guard<mutex> lock(mut_);
+    if (on == virtual_)
+      return;
+    if (on) {
+      virtual_now_ = now_tick();
+    } else {
+      uint64_t clock = clock_tick();
+      if (virtual_now_ > clock + offset_)
+        offset_ = virtual_now_ - clock;
+    }
+    virtual_ = on;
+  }
+  cv_.notify_all();
+}
+
+bool TimerWheel::is_virtual() const noexcept
+{
+  lock_guard<mutex> lock(mut_);
+  return virtual_;
+}
+
+size_t TimerWheel::advance(steady_clock::time_point limit)
+{
+  vector<Fire> due;
+  {
+    lock_guard<mutex> lock(mut_);
+    assert(virtual_ && "advance() needs virtual time");
+    if (active_.empty())
+      return 0;
+
+    uint64_t first = UINT64_MAX;
+    for (auto &[id, e] : active_)
+      first = min(first, e->expires);
+    first = max(first, next_);  // overdue timers fire on the next tick
+    if (start_ + resolution_ * int64_t(first) > limit)
+      return 0;
+
+    jump(first);
+    virtual_now_ = max(virtual_now_, first);
+    expire(first, due);
+  }
+
+  return deliver(due);
+}
+
+uint64_t TimerWheel::to_ticks(nanoseconds d) const noexcept
+{
+  if (d.count() <= 0)
+    return 1;
+  nanoseconds res = resolution_;
+  return uint64_t((d.count() + res.count() - 1) / res.count());
+}
+
+TimerHandle TimerWheel::schedule(Actor *target, nanoseconds delay, int data, nanoseconds period)
+{
+  assert(target != nullptr && "timer for null actor");
+
+  auto *e = new Entry();
+  e->target = target;
+  e->data = data;
+  e->period = period.count() > 0 ? to_ticks(period) : 0;
+
+  bool wake;
+  TimerHandle h;
+  {
+    lock_guard<mutex> lock(mut_);
+    // An empty wheel may have been left behind while the thread slept
+    bool empty = active_.empty();
+    auto now = now_tick();
+    if (empty)
+      next_ = now;
+    e->expires = now + to_ticks(delay);
+    wake = empty || e->expires < wake_;
+    e->id = next_id_++;
+    active_[e->id] = e;
+    add(e);
+    h.id = e->id;
+  }
+  if (wake)
+    cv_.notify_one();
+  return h;
+}
+
+bool TimerWheel::cancel(TimerHandle handle) noexcept
+{
+  return remove(handle, false);
+}
+
+bool TimerWheel::cancel_and_wait(TimerHandle handle) noexcept
+{
+  return remove(handle, true);
+}
+
+bool TimerWheel::remove(TimerHandle handle, bool wait) noexcept
+{
+  unique_lock<mutex> lock(mut_);
+  bool found = false;
+  auto it = active_.find(handle.id);
+  if (it != active_.end()) {
+    unlink(it->second);
+    delete it->second;
+    active_.erase(it);
+    found = true;
+  }
+  // Fired but not sent yet: it never will be
+  if (firing_.erase(handle.id))
+    found = true;
+
+  if (wait) {
+    auto self = this_thread::get_id();
+    delivered_.wait(lock, [&]() {
+      auto d = delivering_.find(handle.id);
+      return d == delivering_.end() || d->second == self;
+    });
+  }
+  return found;
+}
+
+size_t TimerWheel::pending() const noexcept
+{
+  lock_guard<mutex> lock(mut_);
+  return active_.size();
+}
+
+void TimerWheel::link(Entry *&head, Entry *e) noexcept
+{
+  e->next = head;
+  if (head)
+    head->pprev = &e->next;
+  head = e;
+  e->pprev = &head;
+}
+
+void TimerWheel::unlink(Entry *e) noexcept
+{
+  *e->pprev = e->next;
+  if (e->next)
+    e->next->pprev = e->pprev;
+  e->next = nullptr;
+  e->pprev = nullptr;
+}
+
+// File e by how far away it is; caller holds mut_
+void TimerWheel::add(Entry *e) noexcept
+{
+  if (e->expires < next_) {
+    link(wheel_[0][next_ & ((1u << L0_BITS) - 1)], e);  // overdue: next tick
+    return;
+  }
+
+  uint64_t delta = e->expires - next_;
+  uint64_t when = delta > MAX_SPAN ? next_ + MAX_SPAN : e->expires;  // re-filed on cascade
+  if (delta > MAX_SPAN)
+    delta = MAX_SPAN;
+
+  if (delta < (uint64_t(1) << L0_BITS)) {
+    link(wheel_[0][when & ((1u << L0_BITS) - 1)], e);
+    return;
+  }
+  for (int level = 1; level < LEVELS; level++) {
+    int shift = L0_BITS + level * LN_BITS;
+    if (level == LEVELS - 1 || delta < (uint64_t(1) << shift)) {
+      int slot = int((when >> (shift - LN_BITS)) & ((1u << LN_BITS) - 1));
+      link(wheel_[level][slot], e);
+      return;
+    }
+  }
+}
+
+// Move the current slot of a coarse level down; caller holds mut_
+void TimerWheel::cascade(int level) noexcept
+{
+  int shift = L0_BITS + (level - 1) * LN_BITS;
+  int slot = int((next_ >> shift) & ((1u << LN_BITS) - 1));
+  Entry *e = wheel_[level][slot];
+  wheel_[level][slot] = nullptr;
+  while (e) {
+    Entry *n = e->next;
+    e->next = nullptr;
+    e->pprev = nullptr;
+    add(e);
+    e = n;
+  }
+
+  if (slot == 0 && level + 1 < LEVELS)
+    cascade(level + 1);
+}
+
+/*
+ * First tick at or after next_ that has work: an occupied level 0 slot, or
+ * the cascade of an occupied coarse slot. Every tick before it is empty.
+ * Caller holds mut_.
+ */
+uint64_t TimerWheel::next_due() const noexcept
+{
+  uint64_t due = UINT64_MAX;
+  const uint64_t l0_mask = (1u << L0_BITS) - 1;
+  for (uint64_t i = 0; i <= l0_mask; i++) {
+    if (wheel_[0][(next_ + i) & l0_mask]) {
+      due = next_ + i;
+      break;
+    }
+  }
+
+  // Level n slot s moves down on the first multiple of 2^shift whose slot bits are s
+  const uint64_t ln_mask = (1u << LN_BITS) - 1;
+  for (int level = 1; level < LEVELS; level++) {
+    int shift = L0_BITS + (level - 1) * LN_BITS;
+    uint64_t first = (next_ + (uint64_t(1) << shift) - 1) >> shift;
+    for (uint64_t i = 0; i <= ln_mask; i++) {
+      uint64_t turn = first + i;
+      if (wheel_[level][turn & ln_mask]) {
+        due = min(due, turn << shift);
+        break;
+      }
+    }
+  }
+  return due;
+}
+
+/*
+ * Move next_ straight to tick, refiling every timer against it, rather
+ * than stepping through empty ticks: virtual time can skip hours at once.
+ * Timers are refiled newest first so those sharing a slot fire oldest
+ * first. Caller holds mut_.
+ */
+void TimerWheel::jump(uint64_t tick)
+{
+  if (tick <= next_)
+    return;
+
+  vector<Entry *> entries;
+  entries.reserve(active_.size());
+  for (auto &[id, e] : active_)
+    entries.push_back(e);
+  sort(entries.begin(), entries.end(), [](Entry *a, Entry *b) { return a->id > b->id; });
+
+  for (auto &level : wheel_)
+    fill(level.begin(), level.end(), nullptr);
+  next_ = tick;
+  for (auto *e : entries) {
+    e->next = nullptr;
+    e->pprev = nullptr;
+    add(e);
+  }
+}
+
+// Process every tick up to upto, collecting the timers that fire; caller holds mut_
+void TimerWheel::expire(uint64_t upto, vector<Fire> &due)
+{
+  while (next_ <= upto) {
+    auto index = next_ & ((1u << L0_BITS) - 1);
+    if (index == 0)
+      cascade(1);
+
+    Entry *e = wheel_[0][index];
+    wheel_[0][index] = nullptr;
+    next_++;
+
+    while (e) {
+      Entry *n = e->next;
+      e->next = nullptr;
+      e->pprev = nullptr;
+      due.push_back({e->target, e->data, e->id});
+      firing_[e->id]++;
+      if (e->period) {
+        e->expires += e->period;
+        add(e);
+      } else {
+        active_.erase(e->id);
+        delete e;
+      }
+      e = n;
+    }
+  }
+}
+
+/*
+ * Send each fired timer's Timeout, skipping timers cancelled since they
+ * fired; returns how many were sent. Each send is recorded in delivering_
+ * so cancel_and_wait() can wait for it. Called without mut_: a full
+ * mailbox may block the send.
+ */
+size_t TimerWheel::deliver(vector<Fire> &due)
+{
+  auto self = this_thread::get_id();
+  size_t sent = 0;
+  for (auto &f : due) {
+    {
+      lock_guard<mutex> lock(mut_);
+      auto it = firing_.find(f.id);
+      if (it == firing_.end())
+        continue;
+      if (--it->second == 0)
+        firing_.erase(it);
+      delivering_[f.id] = self;
+    }
+    f.target->send(new msg::Timeout(f.data), nullptr);
+    sent++;
+    {
+      lock_guard<mutex> lock(mut_);
+      delivering_.erase(f.id);
+    }
+    delivered_.notify_all();
+  }
+  return sent;
+}
+
+void TimerWheel::run()
+{
+  vector<Fire> due;
+  unique_lock<mutex> lock(mut_);
+
+  while (!stop_) {
+    // Virtual time moves only in advance()
+    if (active_.empty() || virtual_) {
+      cv_.wait(lock, [this]() { return stop_ || (!active_.empty() && !virtual_); });
+      continue;
+    }
+
+    // Nothing happens before the next occupied slot: skip the empty ticks
+    // up to it, or up to the present, and sleep if it is still ahead
+    auto now = now_tick();
+    auto due_tick = next_due();
+    if (due_tick > next_)
+      next_ = min(due_tick, now + 1);
+    if (due_tick > now) {
+      wake_ = due_tick;
+      cv_.wait_until(lock, start_ + resolution_ * int64_t(due_tick - offset_));
+      wake_ = 0;
+      continue;
+    }
+
+    // Catch up to the present, one tick at a time
+    expire(now, due);
+
+    if (due.empty())
+      continue;
+
+    lock.unlock();
+    deliver(due);
+    due.clear();
+    lock.lock();
+  }
+}
@@ -0,0 +1,271 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#include <algorithm>
+#include <climits>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include "actors/Topology.hpp"
+
+using namespace std;
+using namespace actors;
+
+namespace
+{
+  // "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+  set<int> parse_list(const string &text)
+  {
+    set<int> out;
+    stringstream ss(text);
+    string part;
+    while (getline(ss, part, ',')) {
+      int lo, hi;
+      if (sscanf(part.c_str(), "%d-%d", &lo, &hi) == 2) {
+        for (int i = lo; i <= hi; i++)
+          out.insert(i);
+      } else if (sscanf(part.c_str(), "%d", &lo) == 1) {
+        out.insert(lo);
+      }
+    }
+    return out;
+  }
+
+  string read_line(const string &path)
+  {
+    ifstream f(path);
+    string line;
+    getline(f, line);
+    return line;
+  }
+
+  int read_int(const string &path, int fallback)
+  {
+    string line = read_line(path);
+    return line.empty() ? fallback : atoi(line.c_str());
+  }
+}
+
+Topology::Topology(vector<CpuInfo> cpus) : cpus_(std::move(cpus))
+{
+  sort(cpus_.begin(), cpus_.end(), [](const CpuInfo &a, const CpuInfo &b) {
+    return tie(a.node, a.package, a.core, a.cpu) < tie(b.node, b.package, b.core, b.cpu);
+  });
+  set<int> nodes;
+  for (size_t i = 0; i < cpus_.size(); i++) {
+    int cpu = cpus_[i].cpu;
+    if (cpu >= int(by_cpu_.size()))
+      by_cpu_.resize(cpu + 1, -1);
+    by_cpu_[cpu] = int(i);
+    nodes.insert(cpus_[i].node);
+  }
+  nodes_ = max<int>(1, int(nodes.size()));
+}
+
+const Topology &Topology::system()
+{
+  static const Topology topo = discover();
+  return topo;
+}
+
+Topology Topology::discover(const string &root)
+{
+  set<int> online = parse_list(read_line(root + "/cpu/online"));
+  if (online.empty()) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    for (int i = 0; i < n; i++)
+      online.insert(i);
+  }
+
+  map<int, int> node_of_cpu;
+  error_code ec;
+  for (auto &entry : filesystem::directory_iterator(root + "/node", ec)) {
+    int node;
+    string name = entry.path().filename().string();
+    if (sscanf(name.c_str(), "node%d", &node) != 1)
+      continue;
+    for (int cpu : parse_list(read_line(entry.path().string() + "/cpulist")))
+      node_of_cpu[cpu] = node;
+  }
+
+  vector<CpuInfo> cpus;
+  for (int cpu : online) {
+    string dir = root + "/cpu/cpu" + to_string(cpu) + "/topology/";
+    CpuInfo info;
+    info.cpu = cpu;
+    info.core = read_int(dir + "core_id", cpu);
+    info.package = read_int(dir + "physical_package_id", 0);
+    auto it = node_of_cpu.find(cpu);
+    info.node = it != node_of_cpu.end() ? it->second : 0;
+    cpus.push_back(info);
+  }
+  return Topology(std::move(cpus));
+}
+
+const CpuInfo *Topology::find(int cpu) const noexcept
+{
+  if (cpu < 0 || cpu >= int(by_cpu_.size()) || by_cpu_[cpu] < 0)
+    return nullptr;
+  return &cpus_[by_cpu_[cpu]];
+}
+
+int Topology::node_of(int cpu) const noexcept
+{
+  const CpuInfo *c = find(cpu);
+  return c ? c->node : -1;
+}
+
+int Topology::node_of(const set<int> &cpus) const noexcept
+{
+  int node = -1;
+  for (int cpu : cpus) {
+    int n = node_of(cpu);
+    if (n < 0 || (node >= 0 && n != node))
+      return -1;
+    node = n;
+  }
+  return node;
+}
+
+int Topology::distance(int a, int b) const noexcept
+{
+  if (a == b)
+    return 0;
+  const CpuInfo *x = find(a);
+  const CpuInfo *y = find(b);
+  if (!x || !y || x->node != y->node)
+    return 4;
+  if (x->package != y->package)
+    return 3;
+  return x->core == y->core ? 1 : 2;
+}
+
+PreferNode::PreferNode(int node) noexcept
+{
+  constexpr int BITS = int(sizeof(old_mask_) * CHAR_BIT);
+  if (node < 0 || node >= BITS)
+    return;
+  if (syscall(SYS_get_mempolicy, &old_mode_, old_mask_, BITS, nullptr, 0UL) != 0)
+    return;
+
+  unsigned long mask[sizeof(old_mask_) / sizeof(long)] = {};
+  mask[node / (sizeof(long) * CHAR_BIT)] = 1UL << (node % (sizeof(long) * CHAR_BIT));
+  active_ = syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask, BITS) == 0;
+}
+
+PreferNode::~PreferNode()
+{
+  if (active_)
+    syscall(SYS_set_mempolicy, old_mode_, old_mask_, int(sizeof(old_mask_) * CHAR_BIT));
+}
+
+vector<int> actors::place_by_traffic(const Topology &topo, const vector<int> &cpus,
+                                     const vector<ActorId> &actors, vector<Traffic> traffic)
+{
+  vector<int> placed(actors.size(), -1);
+  if (cpus.empty())
+    return placed;
+
+  // CPUs in topology order, so neighbours in the list are siblings
+  auto key = [&](int cpu) {
+    const CpuInfo *c = topo.find(cpu);
+    return c ? make_tuple(c->node, c->package, c->core, cpu) : make_tuple(INT_MAX, 0, 0, cpu);
+  };
+  vector<int> order = cpus;
+  sort(order.begin(), order.end(), [&](int a, int b) { return key(a) < key(b); });
+  vector<bool> taken(order.size(), false);
+  size_t free_count = order.size();
+
+  auto take = [&](int near) {
+    if (free_count == 0) {
+      fill(taken.begin(), taken.end(), false);  // More actors than CPUs: go round again
+      free_count = order.size();
+    }
+    size_t best = order.size();
+    for (size_t i = 0; i < order.size(); i++) {
+      if (taken[i])
+        continue;
+      if (near < 0) {
+        best = i;
+        break;
+      }
+      if (best == order.size() || topo.distance(near, order[i]) < topo.distance(near, order[best]))
+        best = i;
+    }
+    taken[best] = true;
+    free_count--;
+    return order[best];
+  };
+
+  map<ActorId, size_t> index;
+  for (size_t i = 0; i < actors.size(); i++)
+    index[actors[i]] = i;
+
+  // Both directions of a pair count together
+  map<pair<size_t, size_t>, uint64_t> pairs;
+  for (auto &t : traffic) {
+    auto a = index.find(t.from);
+    auto b = index.find(t.to);
+    if (a == index.end() || b == index.end() || a->second == b->second)
+      continue;
+    pairs[minmax(a->second, b->second)] += t.messages;
+  }
+  vector<pair<uint64_t, pair<size_t, size_t>>> heaviest;
+  for (auto &[ends, n] : pairs)
+    heaviest.push_back({n, ends});
+  stable_sort(heaviest.begin(), heaviest.end(),
+              [](const auto &x, const auto &y) { return x.first > y.first; });
+
+  for (auto &[n, ends] : heaviest) {
+    auto [a, b] = ends;
+    if (placed[a] >= 0 && placed[b] >= 0)
+      continue;
+    if (placed[a] < 0 && placed[b] < 0)
+      placed[a] = take(-1);
+    if (placed[a] < 0)
+      placed[a] = take(placed[b]);
+    else if (placed[b] < 0)
+      placed[b] = take(placed[a]);
+  }
+  for (auto &cpu : placed)
+    if (cpu < 0)
+      cpu = take(-1);
+  return placed;
+}
@@ -0,0 +1,268 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "actors/Trace.hpp"
+
+using namespace std;
+using namespace actors;
+using namespace actors::trace;
+
+namespace
+{
+  // Rings outlive their threads so a dump still shows exited ones
+  struct Registry
+  {
+    mutex mut;
+    vector<unique_ptr<Ring>> rings;
+    unordered_map<ActorId, string> names;
+  };
+
+  Registry &registry()
+  {
+    static Registry *r = new Registry;  // Never destroyed: threads may record during exit
+    return *r;
+  }
+
+  int signal_pipe[2] = {-1, -1};
+
+  void on_signal(int)
+  {
+    char c = 1;
+    if (write(signal_pipe[1], &c, 1) < 0) {
+      // Nothing to do in a signal handler; the dump is skipped
+    }
+  }
+
+  void append_escaped(string &out, const string &s)
+  {
+    for (char c : s) {
+      if (c == '"' || c == '\\') {
+        out += '\\';
+        out += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        char buf[8];
+        snprintf(buf, sizeof(buf), "\\u%04x", c);
+        out += buf;
+      } else {
+        out += c;
+      }
+    }
+  }
+}
+
+vector<Event> Ring::snapshot() const
+{
+  uint64_t end = head_.load(memory_order_acquire);
+  uint64_t begin = max(floor_.load(memory_order_relaxed), end > SIZE ? end - SIZE : 0);
+  vector<Event> out;
+  out.reserve(end - begin);
+  for (uint64_t i = begin; i < end; i++)
+    out.push_back(events_[i & (SIZE - 1)]);
+
+  // The owner kept writing: drop copies of slots it may have reused, including the one in progress
+  atomic_thread_fence(memory_order_acquire);
+  uint64_t now = head_.load(memory_order_relaxed);
+  uint64_t valid = now + 1 > SIZE ? now + 1 - SIZE : 0;
+  if (valid > begin)
+    out.erase(out.begin(), out.begin() + min<uint64_t>(valid - begin, out.size()));
+  return out;
+}
+
+Ring *trace::attach() noexcept
+{
+  auto &reg = registry();
+  lock_guard<mutex> lock(reg.mut);
+  auto index = static_cast<uint32_t>(reg.rings.size() + 1);
+  reg.rings.push_back(make_unique<Ring>(index, static_cast<pid_t>(syscall(SYS_gettid))));
+  current_ring = reg.rings.back().get();
+  return current_ring;
+}
+
+void trace::enable(bool on) noexcept
+{
+  active.store(on, memory_order_relaxed);
+}
+
+void trace::name_actor(ActorId id, const string &name)
+{
+  auto &reg = registry();
+  lock_guard<mutex> lock(reg.mut);
+  reg.names[id] = name;
+}
+
+vector<ThreadEvents> trace::snapshot()
+{
+  auto &reg = registry();
+  lock_guard<mutex> lock(reg.mut);
+  vector<ThreadEvents> all;
+  all.reserve(reg.rings.size());
+  for (auto &r : reg.rings)
+    all.push_back({r->tid(), r->snapshot()});
+  return all;
+}
+
+void trace::clear() noexcept
+{
+  auto &reg = registry();
+  lock_guard<mutex> lock(reg.mut);
+  for (auto &r : reg.rings)
+    r->clear();
+}
+
+bool trace::write_chrome_json(const string &path)
+{
+  auto threads = snapshot();
+  unordered_map<ActorId, string> names;
+  {
+    auto &reg = registry();
+    lock_guard<mutex> lock(reg.mut);
+    names = reg.names;
+  }
+
+  uint64_t base = UINT64_MAX;
+  for (auto &t : threads)
+    if (!t.events.empty())
+      base = min(base, t.events.front().tsc);
+  const double us_per_tick = tsc_ns_per_tick() / 1000.0;
+  const int pid = getpid();
+
+  auto name_of = [&](ActorId id) {
+    auto it = names.find(id);
+    return it != names.end() ? it->second : "#" + to_string(id);
+  };
+
+  string out = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  auto begin_event = [&](const char *ph, const Event &e, pid_t tid) {
+    char buf[128];
+    snprintf(buf, sizeof(buf), "%s{\"ph\":\"%s\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f",
+             first ? "\n" : ",\n", ph, pid, int(tid), double(e.tsc - base) * us_per_tick);
+    out += buf;
+    first = false;
+  };
+  auto actor_args = [&](const Event &e) {
+    out += ",\"args\":{\"msg_id\":" + to_string(e.msg_id) + ",\"from\":\"";
+    append_escaped(out, name_of(e.from));
+    out += "\",\"to\":\"";
+    append_escaped(out, name_of(e.to));
+    out += "\"}}";
+  };
+  auto flow_id = [](const Event &e) {
+    char buf[24];
+    snprintf(buf, sizeof(buf), "\"0x%llx\"", static_cast<unsigned long long>(e.flow));
+    return string(buf);
+  };
+
+  for (auto &t : threads) {
+    int depth = 0;
+    for (auto &e : t.events) {
+      switch (e.kind) {
+      case Kind::ENQUEUE:
+        begin_event("i", e, t.tid);
+        out += ",\"s\":\"t\",\"cat\":\"mailbox\",\"name\":\"send\"";
+        actor_args(e);
+        if (e.flow) {
+          begin_event("s", e, t.tid);
+          out += ",\"cat\":\"flow\",\"name\":\"message\",\"id\":" + flow_id(e) + "}";
+        }
+        break;
+      case Kind::DEQUEUE:
+        begin_event("i", e, t.tid);
+        out += ",\"s\":\"t\",\"cat\":\"mailbox\",\"name\":\"dequeue\"";
+        actor_args(e);
+        break;
+      case Kind::HANDLER_BEGIN:
+        depth++;
+        begin_event("B", e, t.tid);
+        out += ",\"cat\":\"handler\",\"name\":\"";
+        append_escaped(out, name_of(e.to));
+        out += " msg " + to_string(e.msg_id) + "\"";
+        actor_args(e);
+        if (e.flow) {
+          begin_event("f", e, t.tid);
+          out += ",\"bp\":\"e\",\"cat\":\"flow\",\"name\":\"message\",\"id\":" + flow_id(e) + "}";
+        }
+        break;
+      case Kind::HANDLER_END:
+        if (depth == 0)
+          break;  // Its begin was overwritten
+        depth--;
+        begin_event("E", e, t.tid);
+        out += "}";
+        break;
+      }
+    }
+  }
+  out += "\n]}\n";
+
+  ofstream f(path, ios::binary | ios::trunc);
+  if (!f)
+    return false;
+  f << out;
+  return bool(f);
+}
+
+bool trace::dump_on_signal(int signo, const string &path)
+{
+  if (signal_pipe[0] >= 0 || pipe(signal_pipe) != 0)
+    return false;
+
+  try {
+    thread([path]() {
+      char c;
+      while (read(signal_pipe[0], &c, 1) == 1)
+        write_chrome_json(path);
+    }).detach();
+  } catch (const system_error &) {
+    return false;
+  }
+
+  struct sigaction sa = {};
+  sa.sa_handler = on_signal;
+  sigemptyset(&sa.sa_mask);
+  sa.sa_flags = SA_RESTART;
+  return sigaction(signo, &sa, nullptr) == 0;
+}
@@ -0,0 +1,200 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+*/
+
+/**
+ * Shared helpers for the bench/bench_*.cpp programs
+ *
+ * Each benchmark adds its results to a Report, which prints a table for
+ * people and, when BENCH_JSON names a file, appends one JSON object per
+ * result to it for tracking regressions between releases:
+ *
+ *   {"bench":"ping_pong","case":"unpinned","metric":"p99","value":8.1,"unit":"us"}
+ *
+ * Iteration counts are fixed; BENCH_SCALE (default 1) multiplies them.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <utility>
+#include <string>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace bench {
+
+using clk = std::chrono::steady_clock;
+
+inline std::uint64_t now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(clk::now().time_since_epoch()).count();
+}
+
+/// Iteration count n scaled by BENCH_SCALE
+inline long scaled(long n)
+{
+  const char* s = std::getenv("BENCH_SCALE");
+  double k = s ? std::atof(s) : 1.0;
+  return k > 0 ? std::max(1L, long(n * k)) : n;
+}
+
+/// Cores for pinned cases: BENCH_CORES="2,3", else the last online CPUs
+inline std::vector<int> bench_cores(std::size_t want)
+{
+  std::vector<int> cores;
+  if (const char* s = std::getenv("BENCH_CORES")) {
+    for (const char* p = s; *p;) {
+      cores.push_back(std::atoi(p));
+      while (*p && *p != ',')
+        p++;
+      if (*p == ',')
+        p++;
+    }
+  } else {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    // Leave CPU 0 to the OS and the main thread where possible
+    for (long c = n - 1; c >= 1 && cores.size() < want; c--)
+      cores.insert(cores.begin(), int(c));
+  }
+  if (cores.size() < want)
+    cores.clear();
+  cores.resize(std::min(cores.size(), want));
+  return cores;
+}
+
+/**
+ * Hardware cache-miss counter for this process
+ *
+ * Counts threads created after the constructor, whose counts are added
+ * once they exit, so read() after joining them. ok() is false where
+ * perf events are unavailable (containers, perf_event_paranoid > 2).
+ */
+class CacheMisses
+{
+  int fd_ = -1;
+
+public:
+  CacheMisses()
+  {
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    if (fd_ >= 0)
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+  }
+  ~CacheMisses()
+  {
+    if (fd_ >= 0)
+      close(fd_);
+  }
+  CacheMisses(const CacheMisses&) = delete;
+  CacheMisses& operator=(const CacheMisses&) = delete;
+
+  bool ok() const { return fd_ >= 0; }
+
+  std::uint64_t read() const
+  {
+    std::uint64_t n = 0;
+    if (fd_ < 0 || ::read(fd_, &n, sizeof(n)) != sizeof(n))
+      return 0;
+    return n;
+  }
+};
+
+/// Percentiles of a set of samples (sorts them)
+struct Percentiles
+{
+  double min = 0, p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0, mean = 0;
+
+  explicit Percentiles(std::vector<std::uint64_t>& v)
+  {
+    if (v.empty())
+      return;
+    std::sort(v.begin(), v.end());
+    auto at = [&v](double q) { return double(v[std::size_t(q * double(v.size() - 1))]); };
+    min = double(v.front());
+    p50 = at(0.50);
+    p90 = at(0.90);
+    p99 = at(0.99);
+    p999 = at(0.999);
+    max = double(v.back());
+    double sum = 0;
+    for (auto x : v)
+      sum += double(x);
+    mean = sum / double(v.size());
+  }
+};
+
+class Report
+{
+  struct Row
+  {
+    std::string name, metric, unit;
+    double value;
+  };
+
+  std::string bench_;
+  std::vector<Row> rows_;
+
+public:
+  explicit Report(std::string bench) : bench_(std::move(bench)) {}
+
+  void add(const std::string& name, const std::string& metric, double value, const std::string& unit)
+  {
+    rows_.push_back({name, metric, unit, value});
+  }
+
+  /// Latency samples in ns, reported in us
+  void add_latency(const std::string& name, std::vector<std::uint64_t>& samples_ns)
+  {
+    Percentiles p(samples_ns);
+    add(name, "p50", p.p50 / 1000, "us");
+    add(name, "p90", p.p90 / 1000, "us");
+    add(name, "p99", p.p99 / 1000, "us");
+    add(name, "p99.9", p.p999 / 1000, "us");
+    add(name, "max", p.max / 1000, "us");
+  }
+
+  /// Print the table, and append JSON lines to $BENCH_JSON if set
+  void print() const
+  {
+    printf("%-40s %-10s %14s %s\n", "case", "metric", "value", "unit");
+    for (auto& r : rows_)
+      printf("%-40s %-10s %14.3f %s\n", r.name.c_str(), r.metric.c_str(), r.value, r.unit.c_str());
+
+    const char* path = std::getenv("BENCH_JSON");
+    if (!path || !*path)
+      return;
+    FILE* f = std::fopen(path, "a");
+    if (!f) {
+      std::perror(path);
+      return;
+    }
+    long long ts = (long long)std::time(nullptr);
+    for (auto& r : rows_)
+      std::fprintf(f, "{\"bench\":\"%s\",\"case\":\"%s\",\"metric\":\"%s\",\"value\":%.6g,\"unit\":\"%s\",\"time\":%lld}\n",
+                   bench_.c_str(), r.name.c_str(), r.metric.c_str(), r.value, r.unit.c_str(), ts);
+    std::fclose(f);
+  }
+};
+
+}  // namespace bench
@@ -0,0 +1,93 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+*/
+
+/**
+ * Handler dispatch benchmark - cost vs. number of registered handlers
+ *
+ * Registers K handlers and fast_send()s stack messages cycling over all K
+ * IDs, so each call is one handler table lookup plus the handler. Dense
+ * IDs use HandlerTable's direct-indexed layout, sparse IDs its sorted
+ * array. K = 1 is the baseline cost of fast_send() itself.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Bench.hpp"
+#include "actors/Actor.hpp"
+
+using namespace actors;
+
+// A message whose ID is chosen at run time
+struct Any : public Message {
+  explicit Any(int id) : Message(id) {}
+  int get_message_id() const override { return id(); }
+};
+
+class Dispatcher : public Actor {
+public:
+  long calls = 0;
+
+  explicit Dispatcher(const std::vector<int>& ids) {
+    strncpy(name, "Dispatcher", sizeof(name));
+    for (int id : ids)
+      add_handler(id, reinterpret_cast<generic_handler_t>(&Dispatcher::on_any));
+  }
+
+  void on_any(const Message*) noexcept { calls++; }
+};
+
+static double ns_per_dispatch(const std::vector<int>& ids, long count)
+{
+  Dispatcher d(ids);
+  std::vector<std::unique_ptr<Any>> msgs;
+  for (int id : ids)
+    msgs.push_back(std::make_unique<Any>(id));
+
+  const std::size_t k = msgs.size();
+  auto t0 = bench::now_ns();
+  for (long i = 0; i < count; i++)
+    d.fast_send(msgs[std::size_t(i) % k].get(), nullptr);
+  auto t1 = bench::now_ns();
+  return double(t1 - t0) / double(count);
+}
+
+int main()
+{
+  const long count = bench::scaled(5000000);
+  bench::Report report("dispatch");
+
+  std::atomic<bool> stop{false};
+  std::thread idle([&stop]() {  // keep glibc on its multi-threaded paths
+    while (!stop.load())
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+
+  ns_per_dispatch({100}, count / 10);  // warm up
+
+  for (int k : {1, 8, 64, 512, 4096}) {
+    std::vector<int> dense, sparse;
+    for (int i = 0; i < k; i++) {
+      dense.push_back(1000 + i);
+      sparse.push_back(1000 + i * 7919);
+    }
+    std::string n = std::to_string(k) + " handler" + (k > 1 ? "s" : "");
+    report.add(n + " dense IDs", "dispatch", ns_per_dispatch(dense, count), "ns/msg");
+    if (k > 1)
+      report.add(n + " sparse IDs", "dispatch", ns_per_dispatch(sparse, count), "ns/msg");
+  }
+
+  report.print();
+  stop.store(true);
+  idle.join();
+  return 0;
+}
@@ -0,0 +1,106 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+*/
+
+/**
+ * Dispatch lock benchmark - per-message cost of the fast_send exclusion
+ *
+ * Pre-fills an actor's mailbox, then times its run loop draining it on
+ * the current thread. Compares the default SHARED mode (DispatchLock per
+ * batch) with ASYNC_ONLY (no lock), plus a bare std::mutex for reference.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include "Bench.hpp"
+#include "actors/Actor.hpp"
+#include "actors/DispatchLock.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+using namespace actors;
+using clk = std::chrono::steady_clock;
+
+struct Tick : public Message_N<100> {
+  long seq;
+  Tick(long s) : seq(s) {}
+};
+
+class Sink : public Actor {
+public:
+  long sum = 0;
+
+  Sink(DispatchMode mode) {
+    strncpy(name, "Sink", sizeof(name));
+    dispatch_mode = mode;
+    MESSAGE_HANDLER(Tick, on_tick);
+  }
+
+  void on_tick(const Tick* m) noexcept { sum += m->seq; }
+};
+
+static double drain_ns_per_msg(DispatchMode mode, long count)
+{
+  Sink sink(mode);
+  for (long i = 0; i < count; i++)
+    sink.send(new Tick(i));
+  sink.send(new msg::Shutdown());
+
+  auto t0 = clk::now();
+  sink();  // runs the actor loop on this thread until Shutdown
+  auto t1 = clk::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / count;
+}
+
+template <class Lock>
+static double lock_ns(long count)
+{
+  Lock lock;
+  volatile long x = 0;
+  auto t0 = clk::now();
+  for (long i = 0; i < count; i++) {
+    lock.lock();
+    x = x + 1;
+    lock.unlock();
+  }
+  auto t1 = clk::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / count;
+}
+
+int main()
+{
+  const long count = bench::scaled(1000000);
+
+  // glibc skips atomics while only one thread is running; actor processes never are
+  std::atomic<bool> stop{false};
+  std::thread idle([&stop]() {
+    while (!stop.load())
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+
+  // Warm up allocator and caches
+  drain_ns_per_msg(DispatchMode::SHARED, count / 10);
+
+  double shared = drain_ns_per_msg(DispatchMode::SHARED, count);
+  double async_only = drain_ns_per_msg(DispatchMode::ASYNC_ONLY, count);
+  double mutex = lock_ns<std::mutex>(count);
+  double dlock = lock_ns<DispatchLock>(count);
+
+  bench::Report report("dispatch_lock");
+  report.add("drain SHARED (DispatchLock)", "cost", shared, "ns/msg");
+  report.add("drain ASYNC_ONLY (no lock)", "cost", async_only, "ns/msg");
+  report.add("std::mutex lock+unlock", "cost", mutex, "ns/op");
+  report.add("DispatchLock lock+unlock", "cost", dlock, "ns/op");
+  report.add("saving per message", "cost", shared - async_only, "ns/msg");
+  report.print();
+
+  stop.store(true);
+  idle.join();
+  return 0;
+}
@@ -0,0 +1,113 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+*/
+
+/**
+ * Fan-in benchmark - throughput of N producer threads into one actor
+ *
+ * Each producer thread send()s its share of the messages as fast as it
+ * can; the time runs from the release of the producers until the consumer
+ * has handled the last message. Compares the BLOCKING and MPSC mailboxes.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Bench.hpp"
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+using namespace actors;
+
+struct Tick : public Message_N<100> {
+  long seq;
+  explicit Tick(long s) : seq(s) {}
+};
+
+class Consumer : public Actor {
+  long expected_;
+
+public:
+  long sum = 0;
+  long received = 0;
+  std::atomic<std::uint64_t> done_ns{0};
+
+  explicit Consumer(long expected) : expected_(expected) {
+    strncpy(name, "Consumer", sizeof(name));
+    dispatch_mode = DispatchMode::ASYNC_ONLY;
+    batch_size = 32;
+    MESSAGE_HANDLER(Tick, on_tick);
+  }
+
+  void on_tick(const Tick* m) noexcept {
+    sum += m->seq;
+    if (++received == expected_)
+      done_ns.store(bench::now_ns(), std::memory_order_release);
+  }
+};
+
+class FanInManager : public Manager {
+public:
+  Consumer* consumer;
+
+  FanInManager(MailboxType mailbox, long total) {
+    strncpy(name, "FanInManager", sizeof(name));
+    consumer = new Consumer(total);
+    manage(consumer, {}, 0, SCHED_OTHER, mailbox);
+  }
+};
+
+// Messages per second with producers senders sharing total messages
+static double run(MailboxType mailbox, int producers, long total)
+{
+  const long each = total / producers;
+  total = each * producers;
+  FanInManager mgr(mailbox, total);
+  mgr.init();
+
+  std::atomic<bool> go{false};
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; p++)
+    threads.emplace_back([&go, &mgr, each]() {
+      while (!go.load(std::memory_order_acquire))
+        std::this_thread::yield();
+      for (long i = 0; i < each; i++)
+        mgr.consumer->send(new Tick(i));
+    });
+
+  std::uint64_t t0 = bench::now_ns();
+  go.store(true, std::memory_order_release);
+  for (auto& t : threads)
+    t.join();
+  while (mgr.consumer->done_ns.load(std::memory_order_acquire) == 0)
+    std::this_thread::yield();
+  std::uint64_t t1 = mgr.consumer->done_ns.load();
+
+  mgr.consumer->send(new msg::Shutdown());
+  mgr.end();
+  return double(total) / (double(t1 - t0) / 1e9);
+}
+
+int main()
+{
+  const long total = bench::scaled(2000000);
+  bench::Report report("fan_in");
+
+  run(MailboxType::BLOCKING, 1, total / 10);  // warm up allocator and caches
+
+  for (int producers : {1, 2, 4, 8}) {
+    std::string n = std::to_string(producers) + " producer" + (producers > 1 ? "s" : "");
+    report.add(n + " BLOCKING", "throughput", run(MailboxType::BLOCKING, producers, total) / 1e6, "Mmsg/s");
+    report.add(n + " MPSC", "throughput", run(MailboxType::MPSC, producers, total) / 1e6, "Mmsg/s");
+  }
+
+  report.print();
+  return 0;
+}
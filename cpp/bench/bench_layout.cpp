@@ -0,0 +1,138 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+*/
+
+/**
+ * Layout benchmark - cost of a cross-core send into an actor's mailbox
+ *
+ * A producer actor pinned to one core sends a stream of messages to a
+ * consumer pinned to another, so every message moves the mailbox's
+ * cache lines between the two. Reports ns per message and, where perf
+ * events are available, cache misses per message for each mailbox; a
+ * field added to the wrong group of Actor or a queue shows up here.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Bench.hpp"
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Shutdown.hpp"
+#include "actors/msg/Start.hpp"
+
+using namespace actors;
+
+struct Tick : public Message_N<100> {
+  long seq;
+  explicit Tick(long s) : seq(s) {}
+};
+
+class Consumer : public Actor {
+  long expected_;
+
+public:
+  long sum = 0;
+  long received = 0;
+  std::atomic<std::uint64_t> done_ns{0};
+
+  explicit Consumer(long expected) : expected_(expected) {
+    strncpy(name, "Consumer", sizeof(name));
+    dispatch_mode = DispatchMode::ASYNC_ONLY;
+    MESSAGE_HANDLER(Tick, on_tick);
+  }
+
+  void on_tick(const Tick* m) noexcept {
+    sum += m->seq;
+    if (++received == expected_)
+      done_ns.store(bench::now_ns(), std::memory_order_release);
+  }
+};
+
+class Producer : public Actor {
+  Actor* to_;
+  long count_;
+
+public:
+  std::atomic<std::uint64_t> start_ns{0};
+
+  Producer(Actor* to, long count) : to_(to), count_(count) {
+    strncpy(name, "Producer", sizeof(name));
+    MESSAGE_HANDLER(msg::Start, on_start);
+  }
+
+  void on_start(const msg::Start*) noexcept {
+    start_ns.store(bench::now_ns(), std::memory_order_release);
+    for (long i = 0; i < count_; i++)
+      to_->send(new Tick(i), this);
+  }
+};
+
+class LayoutManager : public Manager {
+public:
+  Producer* producer;
+  Consumer* consumer;
+
+  LayoutManager(const std::vector<int>& cores, WaitStrategy wait, MailboxType mailbox, long count) {
+    strncpy(name, "LayoutManager", sizeof(name));
+    consumer = new Consumer(count);
+    producer = new Producer(consumer, count);
+    std::set<int> producer_core, consumer_core;
+    if (cores.size() == 2) {
+      producer_core = {cores[0]};
+      consumer_core = {cores[1]};
+    }
+    manage(consumer, consumer_core, 0, SCHED_OTHER, mailbox, 0, wait);
+    manage(producer, producer_core, 0, SCHED_OTHER, MailboxType::BLOCKING, 0, wait);
+  }
+};
+
+static void run(bench::Report& report, const std::string& label, const std::vector<int>& cores,
+                WaitStrategy wait, MailboxType mailbox, long count)
+{
+  bench::CacheMisses misses;  // Before init() so it inherits the actor threads
+  LayoutManager mgr(cores, wait, mailbox, count);
+  mgr.init();
+  while (mgr.consumer->done_ns.load(std::memory_order_acquire) == 0)
+    std::this_thread::yield();
+  std::uint64_t ns = mgr.consumer->done_ns.load() - mgr.producer->start_ns.load();
+
+  mgr.producer->send(new msg::Shutdown());
+  mgr.consumer->send(new msg::Shutdown());
+  mgr.end();
+  report.add(label, "send", double(ns) / double(count), "ns/msg");
+  if (misses.ok())
+    report.add(label, "misses", double(misses.read()) / double(count), "miss/msg");
+}
+
+int main()
+{
+  const long count = bench::scaled(2000000);
+  bench::Report report("layout");
+
+  auto cores = bench::bench_cores(2);
+  std::string on;
+  if (cores.empty())
+    fprintf(stderr, "layout: fewer than 3 CPUs, running unpinned\n");
+  else
+    on = " cpu" + std::to_string(cores[0]) + "," + std::to_string(cores[1]);
+  if (!bench::CacheMisses().ok())
+    fprintf(stderr, "layout: perf events unavailable, not counting cache misses\n");
+
+  bench::Report warmup("layout");
+  run(warmup, "warmup", cores, WaitStrategy::BLOCK, MailboxType::BLOCKING, count / 10);
+
+  run(report, "BLOCK BLOCKING" + on, cores, WaitStrategy::BLOCK, MailboxType::BLOCKING, count);
+  run(report, "SPIN MPSC" + on, cores, WaitStrategy::SPIN, MailboxType::MPSC, count);
+  run(report, "SPIN SPSC" + on, cores, WaitStrategy::SPIN, MailboxType::SPSC, count);
+
+  report.print();
+  return 0;
+}
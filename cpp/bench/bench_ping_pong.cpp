@@ -0,0 +1,125 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+*/
+
+/**
+ * Local ping-pong benchmark - send/reply round-trip latency
+ *
+ * Ping sends a Ping, Pong reply()s with a Pong, Ping times the round trip
+ * and sends the next one. Runs unpinned, pinned to two cores, and pinned
+ * with spinning lock-free mailboxes (the low-latency configuration).
+ */
+
+#include <cstdio>
+#include <set>
+#include <string>
+#include <vector>
+#include "Bench.hpp"
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Shutdown.hpp"
+#include "actors/msg/Start.hpp"
+
+using namespace actors;
+
+struct Ping : public Message_N<100> {};
+struct Pong : public Message_N<101> {};
+
+class PongActor : public Actor {
+public:
+  PongActor() {
+    strncpy(name, "Pong", sizeof(name));
+    MESSAGE_HANDLER(Ping, on_ping);
+  }
+
+  void on_ping(const Ping*) noexcept { reply(new Pong()); }
+};
+
+class PingActor : public Actor {
+  Actor* pong_;
+  long warmup_, count_, sent_ = 0;
+  std::uint64_t t0_ = 0;
+
+public:
+  std::vector<std::uint64_t> rtt;
+
+  PingActor(Actor* pong, long warmup, long count) : pong_(pong), warmup_(warmup), count_(count) {
+    strncpy(name, "Ping", sizeof(name));
+    rtt.reserve(count);
+    MESSAGE_HANDLER(msg::Start, on_start);
+    MESSAGE_HANDLER(Pong, on_pong);
+  }
+
+  void on_start(const msg::Start*) noexcept { ping(); }
+
+  void on_pong(const Pong*) noexcept {
+    std::uint64_t t1 = bench::now_ns();
+    if (sent_ > warmup_)
+      rtt.push_back(t1 - t0_);
+    if (sent_ < warmup_ + count_) {
+      ping();
+      return;
+    }
+    pong_->send(new msg::Shutdown());
+    send(new msg::Shutdown());
+  }
+
+private:
+  void ping() {
+    sent_++;
+    t0_ = bench::now_ns();
+    pong_->send(new Ping(), this);
+  }
+};
+
+class PingPongManager : public Manager {
+public:
+  PingActor* ping;
+
+  PingPongManager(std::vector<int> cores, WaitStrategy wait, MailboxType mailbox, long warmup, long count) {
+    strncpy(name, "PingPongManager", sizeof(name));
+    auto* pong = new PongActor();
+    ping = new PingActor(pong, warmup, count);
+    std::set<int> ping_core, pong_core;
+    if (cores.size() == 2) {
+      ping_core = {cores[0]};
+      pong_core = {cores[1]};
+    }
+    manage(pong, pong_core, 0, SCHED_OTHER, mailbox, 0, wait);
+    manage(ping, ping_core, 0, SCHED_OTHER, mailbox, 0, wait);
+  }
+};
+
+static void run(bench::Report& report, const std::string& label, std::vector<int> cores,
+                WaitStrategy wait, MailboxType mailbox, long warmup, long count)
+{
+  PingPongManager mgr(cores, wait, mailbox, warmup, count);
+  mgr.init();
+  mgr.end();
+  report.add_latency(label, mgr.ping->rtt);
+}
+
+int main()
+{
+  const long warmup = bench::scaled(10000);
+  const long count = bench::scaled(200000);
+  bench::Report report("ping_pong");
+
+  run(report, "unpinned BLOCK", {}, WaitStrategy::BLOCK, MailboxType::BLOCKING, warmup, count);
+
+  auto cores = bench::bench_cores(2);
+  if (cores.empty()) {
+    fprintf(stderr, "ping_pong: fewer than 3 CPUs, skipping pinned cases\n");
+  } else {
+    std::string on = " cpu" + std::to_string(cores[0]) + "," + std::to_string(cores[1]);
+    run(report, "pinned BLOCK" + on, cores, WaitStrategy::BLOCK, MailboxType::BLOCKING, warmup, count);
+    run(report, "pinned SPIN SPSC" + on, cores, WaitStrategy::SPIN, MailboxType::SPSC, warmup, count);
+  }
+
+  report.print();
+  return 0;
+}
@@ -0,0 +1,153 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+*/
+
+/**
+ * Remote round-trip benchmark - ZMQ over loopback, JSON vs. binary frames
+ *
+ * Ping and Pong live in one process but talk only through a ZmqSender and
+ * a ZmqReceiver bound to 127.0.0.1, so every round trip is two encodes,
+ * two TCP hops and two decodes. One run keeps the JSON envelopes (binary
+ * not advertised), the other negotiates binary frames during warm-up.
+ * BENCH_PORT (default 5591) and the next port are used.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Bench.hpp"
+#include "actors/Actor.hpp"
+#include "actors/ActorRef.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Shutdown.hpp"
+#include "actors/msg/Start.hpp"
+#include "actors/remote/Serialization.hpp"
+#include "actors/remote/ZmqSender.hpp"
+#include "actors/remote/ZmqReceiver.hpp"
+
+using namespace actors;
+
+struct Quote : public Message_N<100> {
+  int seq = 0;
+  double px = 0;
+  std::string symbol;
+  Quote() = default;
+  Quote(int s, double p, std::string sym) : seq(s), px(p), symbol(std::move(sym)) {}
+};
+
+struct QuoteAck : public Message_N<101> {
+  int seq = 0;
+  QuoteAck() = default;
+  explicit QuoteAck(int s) : seq(s) {}
+};
+
+REGISTER_REMOTE_MESSAGE_3(Quote, seq, int, px, double, symbol, std::string)
+REGISTER_REMOTE_MESSAGE_1(QuoteAck, seq, int)
+
+class PongActor : public Actor {
+public:
+  PongActor() {
+    strncpy(name, "pong", sizeof(name));
+    MESSAGE_HANDLER(Quote, on_quote);
+  }
+
+  void on_quote(const Quote* m) noexcept { reply(new QuoteAck(m->seq)); }
+};
+
+class PingActor : public Actor {
+  ActorRef pong_;
+  long warmup_, count_;
+  int sent_ = 0;
+  std::uint64_t t0_ = 0;
+
+public:
+  std::vector<std::uint64_t> rtt;
+  std::vector<Actor*> stop_after;  // shut down with this actor
+
+  PingActor(ActorRef pong, long warmup, long count) : pong_(std::move(pong)), warmup_(warmup), count_(count) {
+    strncpy(name, "ping", sizeof(name));
+    rtt.reserve(count);
+    MESSAGE_HANDLER(msg::Start, on_start);
+    MESSAGE_HANDLER(QuoteAck, on_ack);
+  }
+
+  void on_start(const msg::Start*) noexcept { ping(); }
+
+  void on_ack(const QuoteAck*) noexcept {
+    std::uint64_t t1 = bench::now_ns();
+    if (sent_ > warmup_)
+      rtt.push_back(t1 - t0_);
+    if (sent_ < warmup_ + count_) {
+      ping();
+      return;
+    }
+    for (auto* a : stop_after)
+      a->send(new msg::Shutdown());
+    send(new msg::Shutdown());
+  }
+
+private:
+  void ping() {
+    sent_++;
+    t0_ = bench::now_ns();
+    pong_.send(new Quote(sent_, 101.25, "AAPL"), this);
+  }
+};
+
+class RemoteManager : public Manager {
+  std::shared_ptr<ZmqSender> sender_;
+
+public:
+  PingActor* ping;
+
+  RemoteManager(int port, bool binary, long warmup, long count) {
+    strncpy(name, "RemoteManager", sizeof(name));
+    const std::string endpoint = "tcp://127.0.0.1:" + std::to_string(port);
+
+    sender_ = std::make_shared<ZmqSender>(endpoint);
+    sender_->set_advertise_binary(binary);
+    manage(sender_.get());
+
+    auto* pong = new PongActor();
+    manage(pong);
+    ping = new PingActor(ActorRef("pong", endpoint, sender_), warmup, count);
+    manage(ping);
+
+    auto* receiver = new ZmqReceiver(endpoint, sender_);
+    receiver->register_actor(pong);
+    receiver->register_actor(ping);
+    manage(receiver);
+
+    ping->stop_after = {pong, receiver, sender_.get()};
+  }
+};
+
+static void run(bench::Report& report, const std::string& label, int port, bool binary,
+                long warmup, long count)
+{
+  RemoteManager mgr(port, binary, warmup, count);
+  mgr.init();
+  mgr.end();
+  report.add_latency(label, mgr.ping->rtt);
+}
+
+int main()
+{
+  const char* p = std::getenv("BENCH_PORT");
+  const int port = p ? std::atoi(p) : 5591;
+  const long warmup = bench::scaled(2000);
+  const long count = bench::scaled(20000);
+  bench::Report report("remote");
+
+  run(report, "zmq loopback JSON", port, false, warmup, count);
+  run(report, "zmq loopback binary", port + 1, true, warmup, count);
+
+  report.print();
+  return 0;
+}
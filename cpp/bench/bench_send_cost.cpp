@@ -0,0 +1,169 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+*/
+
+/**
+ * send() vs fast_send() benchmark - per-message cost on one thread
+ *
+ * send(): heap-allocate and enqueue (caller side), then the receiver's
+ * dequeue, dispatch and release, measured by draining the mailbox on the
+ * current thread. fast_send(): the handler runs in the caller under the
+ * DispatchLock, with a stack message, with and without a reply. The
+ * enqueue is also timed through an ActorRef and a TypedRef, along with
+ * copying each kind of ref into a list.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Bench.hpp"
+#include "actors/Actor.hpp"
+#include "actors/ActorRef.hpp"
+#include "actors/TypedRef.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+using namespace actors;
+
+struct Tick : public Message_N<100> {
+  long seq;
+  explicit Tick(long s) : seq(s) {}
+};
+
+struct Ask : public Message_N<101> {
+  long seq;
+  explicit Ask(long s) : seq(s) {}
+};
+
+struct Answer : public Message_N<102> {
+  long seq;
+  explicit Answer(long s) : seq(s) {}
+};
+
+class Sink : public Actor {
+public:
+  long sum = 0;
+
+  Sink() {
+    strncpy(name, "Sink", sizeof(name));
+    MESSAGE_HANDLER(Tick, on_tick);
+    MESSAGE_HANDLER(Ask, on_ask);
+  }
+
+  void on_tick(const Tick* m) noexcept { sum += m->seq; }
+  void on_ask(const Ask* m) noexcept { reply(new Answer(m->seq)); }
+};
+
+static double per_op(std::uint64_t t0, std::uint64_t t1, long count)
+{
+  return double(t1 - t0) / double(count);
+}
+
+// ns per send() of a Tick through each ref, in alternating chunks so
+// both see the same allocator and mailbox growth
+template <class RefA, class RefB>
+static std::pair<double, double> enqueue_via(RefA a, RefB b, long count)
+{
+  const long chunk = 1024;
+  std::uint64_t ns_a = 0, ns_b = 0;
+  for (long i = 0; i < count; i += chunk) {
+    auto t0 = bench::now_ns();
+    for (long j = i; j < i + chunk; j++)
+      a.send(new Tick(j));
+    auto t1 = bench::now_ns();
+    for (long j = i; j < i + chunk; j++)
+      b.send(new Tick(j));
+    auto t2 = bench::now_ns();
+    ns_a += t1 - t0;
+    ns_b += t2 - t1;
+  }
+  long sent = (count + chunk - 1) / chunk * chunk;
+  return {double(ns_a) / double(sent), double(ns_b) / double(sent)};
+}
+
+// ns to copy ref into a list, as a publisher does per subscriber
+template <class Ref>
+static double copy_cost(const Ref& ref, long count)
+{
+  std::vector<Ref> list;
+  list.reserve(1024);
+  auto t0 = bench::now_ns();
+  for (long i = 0; i < count; i++) {
+    if (list.size() == 1024)
+      list.clear();
+    list.push_back(ref);
+  }
+  auto t1 = bench::now_ns();
+  return per_op(t0, t1, count);
+}
+
+int main()
+{
+  const long count = bench::scaled(1000000);
+  bench::Report report("send_cost");
+
+  // glibc skips atomics while only one thread is running; actor processes never are
+  std::atomic<bool> stop{false};
+  std::thread idle([&stop]() {
+    while (!stop.load())
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+
+  for (int round = 0; round < 2; round++) {  // first round warms up
+    Sink sink;
+    auto t0 = bench::now_ns();
+    for (long i = 0; i < count; i++)
+      sink.send(new Tick(i));
+    auto t1 = bench::now_ns();
+    sink.send(new msg::Shutdown());
+    sink();  // runs the actor loop on this thread until Shutdown
+    auto t2 = bench::now_ns();
+
+    Sink direct;
+    auto t3 = bench::now_ns();
+    for (long i = 0; i < count; i++) {
+      Tick m(i);
+      direct.fast_send(&m, nullptr);
+    }
+    auto t4 = bench::now_ns();
+    for (long i = 0; i < count; i++) {
+      Ask m(i);
+      auto r = direct.fast_send(&m, nullptr);
+      direct.sum += static_cast<const Answer*>(r.get())->seq;
+    }
+    auto t5 = bench::now_ns();
+
+    Sink via_ref, via_typed;
+    auto [actor_ref, typed_ref] = enqueue_via(ActorRef(&via_ref), TypedRef<Tick, Ask>(&via_typed), count);
+    double actor_ref_copy = copy_cost(ActorRef(&via_ref), count);
+    double typed_ref_copy = copy_cost(TypedRef<Tick, Ask>(&via_typed), count);
+    for (Sink* s : {&via_ref, &via_typed}) {
+      s->send(new msg::Shutdown());
+      (*s)();
+    }
+
+    if (round == 0)
+      continue;
+    report.add("send (alloc + enqueue)", "cost", per_op(t0, t1, count), "ns/msg");
+    report.add("send (dequeue + dispatch)", "cost", per_op(t1, t2, count), "ns/msg");
+    report.add("send total", "cost", per_op(t0, t2, count), "ns/msg");
+    report.add("fast_send", "cost", per_op(t3, t4, count), "ns/msg");
+    report.add("fast_send + reply", "cost", per_op(t4, t5, count), "ns/msg");
+    report.add("ActorRef send (alloc + enqueue)", "cost", actor_ref, "ns/msg");
+    report.add("TypedRef send (alloc + enqueue)", "cost", typed_ref, "ns/msg");
+    report.add("ActorRef copy", "cost", actor_ref_copy, "ns/copy");
+    report.add("TypedRef copy", "cost", typed_ref_copy, "ns/copy");
+  }
+
+  report.print();
+  stop.store(true);
+  idle.join();
+  return 0;
+}
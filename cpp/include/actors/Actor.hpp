@@ -41,17 +41,26 @@ https://opensource.org/licenses/MIT
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <set>
+#include "actors/ActorId.hpp"
 #include "actors/Message.hpp"
+#include "actors/DispatchLock.hpp"
+#include "actors/HandlerTable.hpp"
+#include "actors/Latency.hpp"
+#include "actors/Metrics.hpp"
 #include <mutex>
 #include <typeindex>
 #include <atomic>
 #include <cstring>
 #include <cassert>
+#include <tuple>
 
 #define ACTOR_BQUEUE_SIZE 64
-#define ACTOR_HANDLER_CACHE_SIZE 2048
+#define ACTOR_LFQUEUE_SIZE 4096
+#define ACTOR_WAIT_SPIN_LIMIT 20000
 
 // Register a message handler for this actor
 // Usage: MESSAGE_HANDLER(MessageType, handler_method)
@@ -64,7 +73,13 @@ https://opensource.org/licenses/MIT
 namespace actors
 {
   class Actor;
+  class CoroutineHost;
+  class Group;
+  class Journal;
   class Manager;
+  class RemoteActorRef;
+  class Scheduler;
+  class Task;
 }
 
 // Pointer to an Actor
@@ -76,6 +91,77 @@ namespace actors
   typedef void (Actor::*generic_handler_t)(const Message *);
   template <class T> class Queue;
 
+  /**
+   * Mailbox implementation used for an actor's message queue
+   *
+   * BLOCKING - BQueue, mutex + condition variable (default, idle friendly)
+   * SPSC     - SPSCQueue, lock-free ring; only one thread may send to the actor
+   *            (Start, Shutdown, Timeout and Resume take a locked side channel)
+   * MPSC     - MPSCQueue, lock-free ring; any number of senders
+   * CONFLATING - ConflatingQueue, like BLOCKING, but a message of a type
+   *              registered with Actor::conflate() replaces the queued one
+   *              with the same key
+   * PRIORITY - LaneQueue, like BLOCKING, but split into LANE_COUNT lanes
+   *            drained highest first (see Actor::set_lane, Actor::send_lane)
+   */
+  enum class MailboxType
+  {
+    BLOCKING,
+    SPSC,
+    MPSC,
+    CONFLATING,
+    PRIORITY
+  };
+
+  /**
+   * What send() does when a bounded mailbox is full (see set_mailbox_limit)
+   *
+   * BLOCK       - Wait until the actor drains below the limit (default)
+   * DROP_OLDEST - Discard the oldest queued message to make room; lock-free
+   *               mailboxes cannot, and discard the new message instead
+   * DROP_NEWEST - Discard the message being sent
+   * REJECT      - Return it to the sender wrapped in msg::MailboxFull
+   *               (discarded if there is no sender)
+   */
+  enum class OverflowPolicy
+  {
+    BLOCK,
+    DROP_OLDEST,
+    DROP_NEWEST,
+    REJECT
+  };
+
+  /**
+   * How an actor's thread waits for its next message
+   *
+   * BLOCK          - Sleep in the mailbox until a message arrives (default)
+   * SPIN           - Busy-poll with a pause instruction, never sleep.
+   *                  Use only on an isolated core.
+   * SPIN_THEN_PARK - Busy-poll up to ACTOR_WAIT_SPIN_LIMIT times, then sleep
+   */
+  enum class WaitStrategy
+  {
+    BLOCK,
+    SPIN,
+    SPIN_THEN_PARK
+  };
+
+  /**
+   * Which paths may run an actor's handlers
+   *
+   * SHARED     - Mailbox and fast_send() callers; they are serialized by a
+   *              per-actor DispatchLock (default)
+   * ASYNC_ONLY - Mailbox only; the run loop takes no lock at all. fast_send()
+   *              is only allowed until the actor starts running (see
+   *              accepts_fast_send()); Start, like everything after it,
+   *              arrives by the mailbox
+   */
+  enum class DispatchMode
+  {
+    SHARED,
+    ASYNC_ONLY
+  };
+
   /**
    * Actor - Base class for all actors in the system
    *
@@ -99,7 +185,10 @@ namespace actors
    */
   class Actor
   {
+    friend class CoroutineHost;
+    friend class Group;
     friend class Manager;
+    friend class Scheduler;
 
   public:
     Actor();
@@ -112,11 +201,18 @@ namespace actors
     /**
      * Send a message asynchronously (fire-and-forget)
      * Message is queued and processed later by receiver's thread
-     * @param m Message to send (must be heap-allocated, Actor takes ownership)
+     * @param m Message to send (must be heap-allocated, Actor takes ownership;
+     *        for a shared message, one reference - see Shared::share())
      * @param sender The sending actor (for reply routing)
      */
     virtual void send(const Message *m, Actor *sender = nullptr) noexcept;
 
+    /**
+     * send() in a given lane, overriding the message type's lane
+     * (plain send() on anything but a PRIORITY mailbox)
+     */
+    void send_lane(const Message *m, Lane lane, Actor *sender = nullptr) noexcept;
+
     /**
      * Send a message synchronously and wait for reply
      * Handler runs immediately in caller's thread
@@ -133,12 +229,126 @@ namespace actors
     void reply(const Message *m) noexcept;
 
     virtual const char* get_name() const { return name; }
+    /// Remote actor this actor forwards to (a reply proxy), else nullptr
+    virtual const RemoteActorRef* remote_route() const noexcept { return nullptr; }
+    /// Dense ID assigned by Manager::manage(), NO_ACTOR_ID until managed
+    ActorId get_id() const noexcept { return actor_id; }
     std::size_t queue_length() const noexcept;
+    /// Messages queued in one lane (all are NORMAL unless the mailbox is PRIORITY)
+    std::size_t queue_length(Lane lane) const noexcept;
+    MailboxType mailbox_type() const noexcept { return mailbox; }
+    WaitStrategy wait_strategy() const noexcept { return wait; }
+    /// False once an ASYNC_ONLY actor is running: fast_send() must not be used
+    bool accepts_fast_send() const noexcept
+    {
+      return dispatch_mode == DispatchMode::SHARED || !running.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Bound the mailbox. By default it is unbounded: a BLOCKING mailbox
+     * spills into an overflow list and grows without limit.
+     * Call from the derived constructor or before Manager::init().
+     * A BLOCK policy deadlocks if the actor sends to its own full mailbox.
+     * @param limit Maximum queued messages (0 = unbounded)
+     * @param policy What send() does when the limit is reached
+     * @param high_watermark Tell the Manager when the queue reaches this length (0 = off)
+     * @param low_watermark Tell it again once the queue drains to this length
+     */
+    void set_mailbox_limit(std::size_t limit,
+                           OverflowPolicy policy = OverflowPolicy::BLOCK,
+                           std::size_t high_watermark = 0,
+                           std::size_t low_watermark = 0);
+    std::size_t mailbox_limit() const noexcept { return queue_limit; }
+    OverflowPolicy overflow_policy() const noexcept { return overflow; }
+    /// Messages discarded or rejected because the mailbox was full
+    std::size_t dropped_count() const noexcept
+    {
+      return counters_.dropped.load(std::memory_order_relaxed) +
+             counters_.rejected.load(std::memory_order_relaxed);
+    }
+    /// Messages bounced with MailboxFull by a REJECT mailbox limit
+    std::size_t rejected_count() const noexcept { return counters_.rejected.load(std::memory_order_relaxed); }
+    /// True between crossing the high watermark and draining to the low one
+    bool above_watermark() const noexcept { return above_high.load(std::memory_order_relaxed); }
+
+    /**
+     * Append every message taken from the mailbox to j before its handler
+     * runs (see Journal). fast_send() calls are not recorded. The journal
+     * must outlive the actor's run; nullptr turns journaling off. Call
+     * from the derived constructor or before Manager::init().
+     */
+    void set_journal(Journal *j) noexcept
+    {
+      assert(!running.load(std::memory_order_relaxed) && "set_journal on a running actor");
+      journal_ = j;
+    }
+    Journal *journal() const noexcept { return journal_; }
+
+    /**
+     * Conflate queued M messages by M::conflation_key(), an integer or
+     * anything convertible to std::string_view (e.g. a symbol). A new M
+     * replaces the queued M with the same key in place, so the handler
+     * sees only the latest value per key, keys in first-arrival order.
+     * Needs a CONFLATING mailbox; call from the derived constructor.
+     */
+    template <class M>
+    void conflate()
+    {
+      static_assert(requires { M::message_id; }, "conflate() needs a Message_N type");
+      assert(!running.load(std::memory_order_relaxed) && "conflate on a running actor");
+      conflation_keys[M::message_id] = [](const Message *m, std::string &key) {
+        append_conflation_key(key, static_cast<const M *>(m)->conflation_key());
+      };
+    }
+    /// Queued messages replaced by a newer one with the same conflation key
+    std::size_t conflated_count() const noexcept;
+
+    /**
+     * Lane for M messages sent to this actor (default NORMAL; CONTROL for
+     * msg::Start and msg::Shutdown). Needs a PRIORITY mailbox; call from
+     * the derived constructor.
+     */
+    template <class M>
+    void set_lane(Lane lane)
+    {
+      static_assert(requires { M::message_id; }, "set_lane() needs a Message_N type");
+      assert(!running.load(std::memory_order_relaxed) && "set_lane on a running actor");
+      lanes_by_id[M::message_id] = lane;
+    }
+
+    /**
+     * Queue-wait and handler-time histograms (nullptr unless the library
+     * was built with ACTOR_LATENCY)
+     */
+    const ActorLatency* latency() const noexcept
+    {
+#ifdef ACTOR_LATENCY
+      return &latency_;
+#else
+      return nullptr;
+#endif
+    }
+
+    /// Counters readable from any thread; Manager::get_metrics() snapshots them
+    const ActorCounters& counters() const noexcept { return counters_; }
+    /// Messages handled so far, including fast_send() calls
+    std::uint64_t message_count() const noexcept { return counters_.messages.load(std::memory_order_relaxed); }
+    /// For transports: n wire bytes arrived for this actor
+    void count_bytes_in(std::size_t n) noexcept { counters_.bytes_in.fetch_add(n, std::memory_order_relaxed); }
+
     const Message* peek() const;
+    /// Oldest queued mailbox entry (msg is nullptr if the mailbox is empty)
+    Delivery peek_delivery() const;
+
+    /// Message whose handler is running on this actor, or nullptr
+    const Message* current_message() const noexcept { return current; }
+    /// Sender of current_message(), or nullptr
+    Actor* current_sender() const noexcept { return current_from; }
 
     /**
      * Main processing loop - runs in dedicated thread
-     * Called by Manager via std::thread
+     * Called by Manager via std::thread. Pooled actors (see Scheduler)
+     * never run this; a pool worker drains their mailbox instead.
      */
     void operator()() noexcept;
 
@@ -146,10 +356,25 @@ namespace actors
     virtual void terminate() noexcept;
 
   protected:
-    bool terminated = false;
-    Actor *reply_to = nullptr;
-    long long msg_cnt = 0;
-    char name[256];
+    /**
+     * Maximum messages drained from the mailbox per wake-up (default 1).
+     * Larger values amortize mailbox and fast_send locking over a burst,
+     * at the cost of fast_send() callers waiting for the whole batch.
+     * Set in the derived constructor.
+     */
+    std::size_t batch_size = 1;
+
+    /**
+     * Declare ASYNC_ONLY in the derived constructor if this actor never
+     * receives fast_send() once running; removes the per-batch lock.
+     */
+    DispatchMode dispatch_mode = DispatchMode::SHARED;
+
+    /**
+     * With ACTOR_LATENCY, also keep histograms per message ID (one
+     * hash lookup per message). Set in the derived constructor.
+     */
+    bool latency_by_id = false;
 
     /**
      * Override to handle messages not registered via MESSAGE_HANDLER
@@ -166,36 +391,145 @@ namespace actors
      */
     virtual void end() {}
 
+    /**
+     * Called from Manager::shutdown() when draining starts: stop taking in
+     * work from outside the process (sockets, polling loops). Runs on the
+     * manager's thread; messages from other managed actors still arrive.
+     */
+    virtual void on_drain() noexcept {}
+
+    /**
+     * True while handling the last message of a batch that drained the
+     * mailbox: nothing more to coalesce with for now
+     */
+    bool mailbox_drained() const noexcept { return batch_drained; }
+
     virtual void fast_terminate() noexcept;
-    void process_message_internal(const Message *m) noexcept;
+    void process_message_internal(const Delivery &d) noexcept;
 
   private:
-    Queue<const Message *> *msgq;
-    std::mutex fast_send_mutex;
-    bool using_fast_send = false;
+    /*
+     * Data is grouped by who touches it, each group on cache lines of its
+     * own: what every send() reads, then what the actor's thread uses per
+     * message, then configuration that stays cold once running. Senders
+     * thus never pull in the lines the handlers write. The mailbox keeps
+     * its producer and consumer state apart the same way. Actor.cpp checks
+     * the grouping; keep new members in the right group.
+     */
+    struct Layout;
+
+    // Read by senders on every send()
+    alignas(64) Queue<Delivery> *msgq;
+    Scheduler *scheduler = nullptr;  // set when run by a pool instead of a thread
+    Group *group = nullptr;          // set when run by a Group on its thread
+    std::size_t queue_limit = 0;
+    std::size_t high_watermark = 0;
+    // Set by Manager::shutdown(): DRAINING refuses sends from outside, DISCARDING
+    // also drops what is still queued
+    enum { INTAKE_OPEN, INTAKE_DRAINING, INTAKE_DISCARDING };
+    std::atomic<int> intake{INTAKE_OPEN};
+    enum { POOL_IDLE, POOL_QUEUED, POOL_DONE };
+    std::atomic<int> sched_state{POOL_IDLE};
+    MailboxType mailbox = MailboxType::BLOCKING;
+    OverflowPolicy overflow = OverflowPolicy::BLOCK;
+    ActorId actor_id = NO_ACTOR_ID;
+    std::atomic<bool> above_high{false};
+  protected:
+    bool terminated = false;
+
+    // Used by the actor's own thread for every message
+    alignas(64) Actor *reply_to = nullptr;
+  private:
+    const Message *current = nullptr;
+    Actor *current_from = nullptr;
     const Message *reply_message = nullptr;
-    inline static bool terminate_called = false;
-    std::vector<generic_handler_t> handler_cache;
-    std::vector<bool> dont_have_handler;
+    Journal *journal_ = nullptr;
+    HandlerTable<generic_handler_t> handler_table;
+    DispatchLock fast_send_mutex;
+    WaitStrategy wait = WaitStrategy::BLOCK;
+    std::size_t low_watermark = 0;
+    bool using_fast_send = false;
+    bool batch_drained = false;
+    bool keep_current = false;  // A coroutine handler suspended and holds current
+    bool handlers_dirty = false;
+    bool track_peers = false;
+    ActorCounters counters_;   // Handler and sender counters on separate lines
+    PeerCounts peers_;         // Senders to this actor, kept under Placement::NUMA
+#ifdef ACTOR_LATENCY
+    ActorLatency latency_;
+#endif
+
+    // Cold: configuration and bookkeeping
+  protected:
+    alignas(64) char name[256];
+  private:
+    std::atomic<bool> running{false};
     bool is_managed = false;
+    inline static bool terminate_called = false;
+    // Conflation key extractors by message ID; read by senders, fixed once running
+    std::map<int, void (*)(const Message *, std::string &)> conflation_keys;
+    // Lanes assigned by set_lane(); read by senders, fixed once running
+    std::map<int, Lane> lanes_by_id;
     std::set<int> affinity;
     int priority = 0;
     int priority_type = 0;
     Manager *manager = nullptr;
     pid_t tid = 0;
+    std::unique_ptr<CoroutineHost> coroutines_;
 
     // Handler registration (public for macro, but only used internally)
   public:
+    // Handlers for Message_N types, keyed by message ID; compiled into handler_table
+    std::map<int, generic_handler_t> id_handlers;
+    // Handlers for types without a compile-time ID, looked up by typeid on a table miss
     std::map<std::type_index, generic_handler_t> handlers;
 
+    void add_handler(int id, generic_handler_t f)
+    {
+      id_handlers[id] = f;
+      handlers_dirty = true;
+    }
+
+    /// Coroutine handlers of this actor (see Coroutine.hpp), created on first use
+    CoroutineHost &coroutine_host();
+
   private:
-    void add_message_to_queue(const Message *m);
+    void enqueue(Delivery &d) noexcept;
+    bool admitted(const Delivery &d) const noexcept;
+    Lane lane_for(const Message *m) const noexcept;
+    void add_message_to_queue(const Delivery &d);
+    bool push_bounded(const Delivery &d) noexcept;
+    void check_high_watermark() noexcept;
+    void check_low_watermark() noexcept;
+    void set_mailbox(MailboxType type, std::size_t size);
+    bool conflation_key(const Message *m, std::string &key) const noexcept;
+
+    template <class K>
+    static void append_conflation_key(std::string &key, const K &k)
+    {
+      if constexpr (std::is_integral_v<K> || std::is_enum_v<K>)
+        key.append(reinterpret_cast<const char *>(&k), sizeof k);
+      else
+        key.append(std::string_view(k));
+    }
+    std::size_t wait_for_messages(Delivery *out, std::size_t max, bool &last) noexcept;
+    void dispatch(const Delivery &d) noexcept;
+    bool process_batch(Delivery *batch, std::size_t n, bool last) noexcept;
+    void start_pooled();
+    bool run_slice(std::size_t budget) noexcept;
     bool call_handler(const Message *m) noexcept;
+    void seal_handlers();
+    void run_coroutine(const Message *m);     // Handler of every coroutine MESSAGE_HANDLER
+    void resume_coroutine(const Message *m);  // Handler of msg::Resume
 
     void set_manager(Manager *mgr) { manager = mgr; }
     Manager *get_manager() const { return manager; }
   };
 
+  // Defined in Coroutine.hpp
+  template <typename ActorT, typename MsgT, typename Ret>
+  void register_coroutine_handler(Actor *a, Ret (ActorT::*ptr)(const MsgT *));
+
   // Helper template for registering handlers
   template <typename ActorT, typename MsgT>
   struct register_handler
@@ -207,7 +541,18 @@ namespace actors
     void operator()(handler_t ptr) const
     {
       generic_handler_t generic_ptr = reinterpret_cast<generic_handler_t>(ptr);
-      actor->handlers[std::type_index(typeid(MsgT))] = generic_ptr;
+      if constexpr (requires { MsgT::message_id; })
+        actor->add_handler(MsgT::message_id, generic_ptr);
+      else
+        actor->handlers[std::type_index(typeid(MsgT))] = generic_ptr;
+    }
+
+    // Handlers returning actors::Task
+    template <typename Ret>
+      requires(!std::is_void_v<Ret>)
+    void operator()(Ret (ActorT::*ptr)(const MsgT *)) const
+    {
+      register_coroutine_handler<ActorT, MsgT>(actor, ptr);
     }
   };
 
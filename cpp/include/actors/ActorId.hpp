@@ -0,0 +1,118 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Chunks of 1024 IDs in an IdTable; bounds the largest ID at 1024 * this
+#ifndef ACTOR_ID_MAX_CHUNKS
+#define ACTOR_ID_MAX_CHUNKS 1024
+#endif
+
+namespace actors
+{
+  /**
+   * Dense actor ID, assigned by Manager::manage() in order from 1
+   *
+   * Resolve a name once with Manager::get_actor_id() and look the actor
+   * up by ID afterwards; IDs are never reused while the Manager lives.
+   */
+  using ActorId = std::uint32_t;
+  constexpr ActorId NO_ACTOR_ID = 0;
+
+  /**
+   * IdTable - Grow-only map from dense IDs to pointers
+   *
+   * get() is lock-free and wait-free: two loads, no hashing. Entries live
+   * in chunks allocated on first use and kept until the table is
+   * destroyed, so readers never see memory move. set() must be
+   * serialized by the caller.
+   */
+  template <class T>
+  class IdTable
+  {
+    static constexpr std::size_t CHUNK_BITS = 10;
+    static constexpr std::size_t CHUNK_SIZE = std::size_t(1) << CHUNK_BITS;
+
+    using Chunk = std::atomic<T *>[CHUNK_SIZE];
+    std::atomic<Chunk *> chunks_[ACTOR_ID_MAX_CHUNKS] = {};
+
+  public:
+    /// Largest ID the table can hold
+    static constexpr std::uint32_t MAX_ID = std::uint32_t(CHUNK_SIZE * ACTOR_ID_MAX_CHUNKS - 1);
+
+    IdTable() = default;
+    IdTable(const IdTable &) = delete;
+    IdTable &operator=(const IdTable &) = delete;
+
+    ~IdTable()
+    {
+      for (auto &c : chunks_)
+        delete[] c.load(std::memory_order_relaxed);
+    }
+
+    /// Entry for id, or nullptr if none was set
+    T *get(std::uint32_t id) const noexcept
+    {
+      if (id > MAX_ID)
+        return nullptr;
+      Chunk *chunk = chunks_[id >> CHUNK_BITS].load(std::memory_order_acquire);
+      if (!chunk)
+        return nullptr;
+      return (*chunk)[id & (CHUNK_SIZE - 1)].load(std::memory_order_acquire);
+    }
+
+    /// Set the entry for id; false if id is above MAX_ID
+    bool set(std::uint32_t id, T *p)
+    {
+      if (id > MAX_ID)
+        return false;
+      auto &slot = chunks_[id >> CHUNK_BITS];
+      Chunk *chunk = slot.load(std::memory_order_relaxed);
+      if (!chunk) {
+        chunk = new Chunk[1];
+        for (auto &e : *chunk)
+          e.store(nullptr, std::memory_order_relaxed);
+        slot.store(chunk, std::memory_order_release);
+      }
+      (*chunk)[id & (CHUNK_SIZE - 1)].store(p, std::memory_order_release);
+      return true;
+    }
+  };
+}
@@ -8,16 +8,32 @@ Copyright 2025 Vincent Maciejewski, & M2 Tech
 
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <variant>
+#include <vector>
 #include "actors/Actor.hpp"
 
+// Default time an ask() waits for its reply
+#ifndef ACTOR_ASK_TIMEOUT_MS
+#define ACTOR_ASK_TIMEOUT_MS 5000
+#endif
+
 namespace actors {
 
 // Forward declarations
 class ZmqSender;
+class ShmRing;
+struct BatchPolicy;
+
+/// Completion of an ask(); reply is nullptr if none came before the timeout
+using AskCallback = std::function<void(std::unique_ptr<const Message> reply)>;
+using AskFuture = std::future<std::unique_ptr<const Message>>;
+constexpr std::chrono::milliseconds DEFAULT_ASK_TIMEOUT{ACTOR_ASK_TIMEOUT_MS};
 
 /**
  * LocalActorRef - Reference to an actor in the same process
@@ -49,17 +65,20 @@ public:
 class RustActorRef {
     std::string target_name_;
     std::string sender_name_;
+    int32_t handle_;               // From rust_actor_resolve(); 0 = send by name
 
 public:
-    RustActorRef(std::string target, std::string sender = "")
+    RustActorRef(std::string target, std::string sender = "", int32_t handle = 0)
         : target_name_(std::move(target))
-        , sender_name_(std::move(sender)) {}
+        , sender_name_(std::move(sender))
+        , handle_(handle) {}
 
     // Implemented in actors-interop (RustActorRef.cpp)
     void send(const Message* m, Actor* sender = nullptr);
 
     const std::string& name() const { return target_name_; }
     const std::string& sender() const { return sender_name_; }
+    int32_t handle() const { return handle_; }
 };
 
 /**
@@ -78,12 +97,51 @@ public:
         , endpoint_(std::move(endpoint))
         , sender_(std::move(sender)) {}
 
-    // Implemented in ZmqSender.cpp to avoid circular dependency
+    // Implemented in RemoteActorRef.cpp to avoid circular dependency
     void send(const Message* m, Actor* sender = nullptr);
 
+    // Send m to each of names at this ref's endpoint in one wire send
+    // (see ZmqSender::send_to_each())
+    void send_to_each(const std::vector<std::string>& names, const Message* m,
+                      Actor* sender = nullptr) const;
+
+    // Batch sends to this ref's endpoint
+    void set_batching(const BatchPolicy& policy) const;
+
+    // Request/response with a correlation ID
+    AskFuture ask(const Message* m, std::chrono::milliseconds timeout = DEFAULT_ASK_TIMEOUT) const;
+    void ask(const Message* m, AskCallback done,
+             std::chrono::milliseconds timeout = DEFAULT_ASK_TIMEOUT) const;
+
     const std::string& name() const { return name_; }
     const std::string& endpoint() const { return endpoint_; }
-    std::shared_ptr<ZmqSender> sender() const { return sender_; }
+    const std::shared_ptr<ZmqSender>& sender() const { return sender_; }
+};
+
+/**
+ * ShmActorRef - Reference to an actor in another process on this host
+ *
+ * Messages go through the target's shared-memory ring (ShmRing) instead of
+ * TCP. Replies still come back over ZMQ. A message too large for a ring
+ * slot is sent through the TCP route to the same actor instead; its order
+ * relative to ring traffic is then not guaranteed.
+ */
+class ShmActorRef {
+    std::shared_ptr<ShmRing> ring_;
+    RemoteActorRef tcp_;
+
+public:
+    ShmActorRef(std::shared_ptr<ShmRing> ring, RemoteActorRef tcp)
+        : ring_(std::move(ring))
+        , tcp_(std::move(tcp)) {}
+
+    // Implemented in ShmTransport.cpp
+    void send(const Message* m, Actor* sender = nullptr);
+
+    const std::string& name() const { return tcp_.name(); }
+    const std::string& endpoint() const { return tcp_.endpoint(); }
+    const RemoteActorRef& tcp_ref() const { return tcp_; }
+    const std::shared_ptr<ShmRing>& ring() const { return ring_; }
 };
 
 /**
@@ -100,7 +158,7 @@ public:
  *   remote_ref.send(new Ping{1}, this);  // remote - same syntax!
  */
 class ActorRef {
-    std::variant<LocalActorRef, RemoteActorRef, RustActorRef> ref_;
+    std::variant<LocalActorRef, RemoteActorRef, RustActorRef, ShmActorRef> ref_;
 
 public:
     // Default constructor - creates an empty/invalid ref
@@ -116,6 +174,9 @@ public:
     // Construct from Rust actor
     explicit ActorRef(RustActorRef rust_ref) : ref_(std::move(rust_ref)) {}
 
+    // Construct from same-host shared-memory actor
+    explicit ActorRef(ShmActorRef shm_ref) : ref_(std::move(shm_ref)) {}
+
     // Copy/move constructors
     ActorRef(const ActorRef&) = default;
     ActorRef(ActorRef&&) = default;
@@ -130,12 +191,42 @@ public:
         std::visit([&](auto& r) { r.send(m, sender); }, ref_);
     }
 
+    /**
+     * Send in a mailbox lane (see Actor::send_lane). Only a local actor
+     * honours the lane; other refs send normally, and the receiving
+     * actor's per-type lanes apply.
+     */
+    void send(const Message* m, Lane lane, Actor* sender = nullptr) {
+        if (auto* local = std::get_if<LocalActorRef>(&ref_)) {
+            local->actor()->send_lane(m, lane, sender);
+            return;
+        }
+        send(m, sender);
+    }
+
+    /**
+     * Send a request and get its reply (implemented in ZmqSender.hpp)
+     *
+     * Remote and shared-memory refs tag the message with a correlation ID
+     * and return at once; many asks can be outstanding per connection. The
+     * reply, or nullptr after timeout, completes the future or is passed to
+     * done on the ZmqReceiver's thread. A local ref runs fast_send() and
+     * completes before returning. Takes ownership of m. Throws for Rust refs
+     * and for a running ASYNC_ONLY actor, whose handlers only its own thread
+     * may run; send() to it, or co_await ask() from a coroutine handler.
+     */
+    AskFuture ask(const Message* m, std::chrono::milliseconds timeout = DEFAULT_ASK_TIMEOUT);
+    void ask(const Message* m, AskCallback done,
+             std::chrono::milliseconds timeout = DEFAULT_ASK_TIMEOUT);
+
     /**
      * Send a message synchronously (local only)
-     * Throws if called on remote actor
+     * Throws if called on remote actor or a running ASYNC_ONLY actor
      */
     std::unique_ptr<const Message> fast_send(const Message* m, Actor* sender) {
         if (auto* local = std::get_if<LocalActorRef>(&ref_)) {
+            if (!local->actor()->accepts_fast_send())
+                throw std::runtime_error("fast_send to a running ASYNC_ONLY actor");
             return local->fast_send(m, sender);
         }
         throw std::runtime_error("fast_send not supported for remote actors");
@@ -144,6 +235,7 @@ public:
     bool is_local() const { return std::holds_alternative<LocalActorRef>(ref_); }
     bool is_remote() const { return std::holds_alternative<RemoteActorRef>(ref_); }
     bool is_rust() const { return std::holds_alternative<RustActorRef>(ref_); }
+    bool is_shm() const { return std::holds_alternative<ShmActorRef>(ref_); }
 
     // Check if this is a valid (non-null) reference
     bool is_valid() const {
@@ -166,6 +258,14 @@ public:
         }, ref_);
     }
 
+    // ActorId of a local actor; NO_ACTOR_ID for other refs or an unmanaged actor
+    ActorId id() const {
+        if (auto* local = std::get_if<LocalActorRef>(&ref_)) {
+            return local->actor() ? local->actor()->get_id() : NO_ACTOR_ID;
+        }
+        return NO_ACTOR_ID;
+    }
+
     // Access underlying local actor (throws if remote)
     Actor* actor() const {
         if (auto* local = std::get_if<LocalActorRef>(&ref_)) {
@@ -174,11 +274,15 @@ public:
         throw std::runtime_error("Cannot get actor pointer for remote actor");
     }
 
-    // Access underlying remote ref (throws if local)
+    // Access underlying remote ref (throws if local); for a shared-memory
+    // ref this is its TCP route to the same actor
     const RemoteActorRef& remote_ref() const {
         if (auto* remote = std::get_if<RemoteActorRef>(&ref_)) {
             return *remote;
         }
+        if (auto* shm = std::get_if<ShmActorRef>(&ref_)) {
+            return shm->tcp_ref();
+        }
         throw std::runtime_error("Cannot get remote ref for local actor");
     }
 };
@@ -40,6 +40,7 @@ https://opensource.org/licenses/MIT
 #include <condition_variable>
 #include <boost/circular_buffer.hpp>
 #include <deque>
+#include <atomic>
 #include <tuple>
 #include "actors/Queue.hpp"
 #include <type_traits>
@@ -56,21 +57,19 @@ namespace actors
   class BQueue : public Queue<T>
   {
   private:
-    mutable std::mutex mut;
+    // Everything touched under the lock shares a line; size_ has its own so
+    // a consumer polling it doesn't pull the lock away from a producer
+    alignas(64) mutable std::mutex mut;
     mutable std::condition_variable cv;
+    std::size_t push_waiters_ = 0;
     boost::circular_buffer<T> cb_;
     std::deque<T> overflow_;
+    alignas(64) std::atomic<std::size_t> size_{0};  // lets try_pop() skip the lock when empty
+    alignas(64) std::condition_variable space_cv;   // producers waiting in push_wait()
 
-  public:
-    explicit BQueue(size_t n) : cb_(n) {}
-
-    std::tuple<T, bool> pop() noexcept override
+    // Caller holds mut and the queue is not empty
+    std::tuple<T, bool> take_front() noexcept
     {
-      std::unique_lock<std::mutex> lock(mut);
-      cv.wait(lock, [this]() {
-        return !cb_.empty() || !overflow_.empty();
-      });
-
       T ret;
       if (!cb_.empty()) {
         ret = cb_.front();
@@ -79,10 +78,86 @@ namespace actors
         ret = overflow_.front();
         overflow_.pop_front();
       }
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      if (push_waiters_)
+        space_cv.notify_all();
       bool last = cb_.empty() && overflow_.empty();
       return std::make_tuple(ret, last);
     }
 
+    // Caller holds mut
+    void put(const T& x) noexcept
+    {
+      if (!overflow_.empty() || cb_.full()) {
+        overflow_.push_back(x);
+      } else {
+        cb_.push_back(x);
+      }
+      size_.fetch_add(1, std::memory_order_release);
+    }
+
+    // Caller holds mut
+    std::size_t take_batch(T* out, std::size_t max, bool& last) noexcept
+    {
+      std::size_t n = 0;
+      while (n < max && !cb_.empty()) {
+        out[n++] = cb_.front();
+        cb_.pop_front();
+      }
+      while (n < max && !overflow_.empty()) {
+        out[n++] = overflow_.front();
+        overflow_.pop_front();
+      }
+      size_.fetch_sub(n, std::memory_order_relaxed);
+      if (n && push_waiters_)
+        space_cv.notify_all();
+      last = cb_.empty() && overflow_.empty();
+      return n;
+    }
+
+  public:
+    explicit BQueue(size_t n) : cb_(n) {}
+
+    std::tuple<T, bool> pop() noexcept override
+    {
+      std::unique_lock<std::mutex> lock(mut);
+      cv.wait(lock, [this]() {
+        return !cb_.empty() || !overflow_.empty();
+      });
+
+      return take_front();
+    }
+
+    bool try_pop(std::tuple<T, bool>& out) noexcept override
+    {
+      if (size_.load(std::memory_order_acquire) == 0)
+        return false;
+
+      std::lock_guard<std::mutex> lock(mut);
+      if (cb_.empty() && overflow_.empty())
+        return false;
+      out = take_front();
+      return true;
+    }
+
+    std::size_t pop_batch(T* out, std::size_t max, bool& last) noexcept override
+    {
+      std::unique_lock<std::mutex> lock(mut);
+      cv.wait(lock, [this]() {
+        return !cb_.empty() || !overflow_.empty();
+      });
+      return take_batch(out, max, last);
+    }
+
+    std::size_t try_pop_batch(T* out, std::size_t max, bool& last) noexcept override
+    {
+      if (max == 0 || size_.load(std::memory_order_acquire) == 0)
+        return 0;
+
+      std::lock_guard<std::mutex> lock(mut);
+      return take_batch(out, max, last);
+    }
+
     T peek() const noexcept override
     {
       std::lock_guard<std::mutex> lock(mut);
@@ -99,25 +174,62 @@ namespace actors
     {
       {
         std::lock_guard<std::mutex> lock(mut);
-        if (!overflow_.empty() || cb_.full()) {
-          overflow_.push_back(x);
-        } else {
-          cb_.push_back(x);
+        put(x);
+      }
+      cv.notify_one();
+    }
+
+    bool try_push(const T& x, std::size_t limit) noexcept override
+    {
+      {
+        std::lock_guard<std::mutex> lock(mut);
+        if (cb_.size() + overflow_.size() >= limit)
+          return false;
+        put(x);
+      }
+      cv.notify_one();
+      return true;
+    }
+
+    void push_wait(const T& x, std::size_t limit) noexcept override
+    {
+      {
+        std::unique_lock<std::mutex> lock(mut);
+        if (cb_.size() + overflow_.size() >= limit) {
+          push_waiters_++;
+          space_cv.wait(lock, [this, limit]() {
+            return cb_.size() + overflow_.size() < limit;
+          });
+          push_waiters_--;
         }
+        put(x);
       }
       cv.notify_one();
     }
 
+    bool push_evict(const T& x, std::size_t limit, T& evicted, bool& queued) noexcept override
+    {
+      queued = true;
+      bool full;
+      {
+        std::lock_guard<std::mutex> lock(mut);
+        full = cb_.size() + overflow_.size() >= limit;
+        if (full)
+          evicted = std::get<0>(take_front());
+        put(x);
+      }
+      cv.notify_one();
+      return full;
+    }
+
     bool is_empty() const noexcept override
     {
-      std::lock_guard<std::mutex> lock(mut);
-      return cb_.empty() && overflow_.empty();
+      return size_.load(std::memory_order_acquire) == 0;
     }
 
     std::size_t length() const noexcept override
     {
-      std::lock_guard<std::mutex> lock(mut);
-      return cb_.size() + overflow_.size();
+      return size_.load(std::memory_order_acquire);
     }
   };
 }
@@ -0,0 +1,133 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace actors
+{
+  /// Hint to the CPU that we are in a spin-wait loop
+  inline void cpu_relax() noexcept
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+  }
+
+  /**
+   * Backoff - Escalating wait used by the lock-free queues
+   *
+   * Spins with cpu_relax() first, then yields the CPU, then sleeps
+   * briefly so an idle actor does not burn a whole core forever.
+   * Call reset() once the awaited condition becomes true.
+   */
+  class Backoff
+  {
+    unsigned count_ = 0;
+
+  public:
+    static constexpr unsigned SPIN_LIMIT = 128;
+    static constexpr unsigned YIELD_LIMIT = SPIN_LIMIT + 1024;
+
+    void pause() noexcept
+    {
+      if (count_ < SPIN_LIMIT) {
+        cpu_relax();
+      } else if (count_ < YIELD_LIMIT) {
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        return;
+      }
+      ++count_;
+    }
+
+    void reset() noexcept { count_ = 0; }
+  };
+
+  /**
+   * Parker - Lets a single consumer sleep until a producer publishes
+   *
+   * The consumer spins briefly, then parks on a futex via C++20
+   * atomic wait. Producers call unpark() after publishing an item;
+   * when nobody is parked that is a fence and a load, no syscall.
+   */
+  class Parker
+  {
+    std::atomic<int> parked_{0};
+
+  public:
+    static constexpr unsigned SPIN_LIMIT = 256;
+
+    /// Consumer: return once ready() is true
+    template <class Pred>
+    void park_until(Pred ready) noexcept
+    {
+      for (unsigned i = 0; i < SPIN_LIMIT; i++) {
+        if (ready())
+          return;
+        cpu_relax();
+      }
+
+      while (!ready()) {
+        parked_.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (ready()) {
+          parked_.store(0, std::memory_order_relaxed);
+          return;
+        }
+        parked_.wait(1, std::memory_order_acquire);
+      }
+    }
+
+    /// Producer: wake the consumer if it is parked
+    void unpark() noexcept
+    {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (parked_.load(std::memory_order_relaxed)) {
+        parked_.store(0, std::memory_order_release);
+        parked_.notify_one();
+      }
+    }
+  };
+}
@@ -0,0 +1,298 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <atomic>
+#include <tuple>
+#include "actors/Queue.hpp"
+
+namespace actors
+{
+  /**
+   * ConflatingQueue - Blocking queue that keeps only the latest item per key
+   *
+   * An item with a key replaces the queued, not yet popped item with the
+   * same key in place, so it keeps the first item's position: consumers
+   * see keys in the order they first arrived and only the newest value of
+   * each. Items without a key queue normally. The replaced item is passed
+   * to the replaced callback after the lock is released (e.g. to free it).
+   *
+   * Same locking as BQueue: one mutex, condition variable wakeups.
+   */
+  template <class T, class Key = std::string>
+  class ConflatingQueue : public Queue<T>
+  {
+  public:
+    /// Set key and return true if x conflates; called outside the lock
+    using KeyFn = std::function<bool(const T& x, Key& key)>;
+    using ReplacedFn = std::function<void(const T& old)>;
+
+  private:
+    struct Slot
+    {
+      T item;
+      Key key;
+      bool keyed;
+    };
+
+    // Same split as BQueue: locked state, lock-free counters, cold path
+    alignas(64) mutable std::mutex mut;
+    mutable std::condition_variable cv;
+    std::size_t push_waiters_ = 0;
+    std::deque<Slot> q_;
+    std::unordered_map<Key, std::uint64_t> index_;  // key -> sequence number of its slot
+    std::uint64_t head_seq_ = 0;                     // sequence number of q_.front()
+    KeyFn key_of_;
+    ReplacedFn replaced_;
+    alignas(64) std::atomic<std::size_t> size_{0};
+    std::atomic<std::size_t> conflated_{0};
+    alignas(64) std::condition_variable space_cv;   // producers waiting in push_wait()
+
+    // Caller holds mut and the queue is not empty
+    std::tuple<T, bool> take_front() noexcept
+    {
+      Slot& s = q_.front();
+      T ret = s.item;
+      if (s.keyed)
+        index_.erase(s.key);
+      q_.pop_front();
+      head_seq_++;
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      if (push_waiters_)
+        space_cv.notify_all();
+      return std::make_tuple(ret, q_.empty());
+    }
+
+    // Caller holds mut
+    bool replaces(const Key& key, bool keyed) const noexcept
+    {
+      return keyed && index_.count(key) != 0;
+    }
+
+    // Caller holds mut; returns true if x replaced a queued item (now in old)
+    bool put(const T& x, Key& key, bool keyed, T& old) noexcept
+    {
+      if (keyed) {
+        auto [it, fresh] = index_.try_emplace(key, head_seq_ + q_.size());
+        if (!fresh) {
+          Slot& s = q_[it->second - head_seq_];
+          old = s.item;
+          s.item = x;
+          return true;
+        }
+      }
+      q_.push_back(Slot{x, keyed ? std::move(key) : Key{}, keyed});
+      size_.fetch_add(1, std::memory_order_release);
+      return false;
+    }
+
+    // Caller has released mut
+    void after_put(bool replaced, const T& old) noexcept
+    {
+      if (replaced) {
+        conflated_.fetch_add(1, std::memory_order_relaxed);
+        if (replaced_)
+          replaced_(old);
+      } else {
+        cv.notify_one();
+      }
+    }
+
+    bool key_of(const T& x, Key& key) const noexcept
+    {
+      return key_of_ && key_of_(x, key);
+    }
+
+  public:
+    /**
+     * @param n Expected number of distinct queued keys (hash table reserve)
+     * @param key_of Extracts an item's key; a null function never conflates
+     * @param replaced Called with each item a newer one replaced
+     */
+    ConflatingQueue(std::size_t n, KeyFn key_of, ReplacedFn replaced = {})
+      : key_of_(std::move(key_of)), replaced_(std::move(replaced))
+    {
+      index_.reserve(n);
+    }
+
+    std::tuple<T, bool> pop() noexcept override
+    {
+      std::unique_lock<std::mutex> lock(mut);
+      cv.wait(lock, [this]() { return !q_.empty(); });
+      return take_front();
+    }
+
+    bool try_pop(std::tuple<T, bool>& out) noexcept override
+    {
+      if (size_.load(std::memory_order_acquire) == 0)
+        return false;
+
+      std::lock_guard<std::mutex> lock(mut);
+      if (q_.empty())
+        return false;
+      out = take_front();
+      return true;
+    }
+
+    std::size_t pop_batch(T* out, std::size_t max, bool& last) noexcept override
+    {
+      std::unique_lock<std::mutex> lock(mut);
+      cv.wait(lock, [this]() { return !q_.empty(); });
+      std::size_t n = 0;
+      do {
+        auto r = take_front();
+        out[n++] = std::get<0>(r);
+        last = std::get<1>(r);
+      } while (n < max && !last);
+      return n;
+    }
+
+    std::size_t try_pop_batch(T* out, std::size_t max, bool& last) noexcept override
+    {
+      if (size_.load(std::memory_order_acquire) == 0)
+        return 0;
+
+      std::lock_guard<std::mutex> lock(mut);
+      std::size_t n = 0;
+      while (n < max && !q_.empty()) {
+        auto r = take_front();
+        out[n++] = std::get<0>(r);
+        last = std::get<1>(r);
+      }
+      return n;
+    }
+
+    T peek() const noexcept override
+    {
+      std::lock_guard<std::mutex> lock(mut);
+      if (q_.empty())
+        return T{};
+      return q_.front().item;
+    }
+
+    void push(const T& x) noexcept override
+    {
+      Key key;
+      bool keyed = key_of(x, key);
+      T old{};
+      bool replaced;
+      {
+        std::lock_guard<std::mutex> lock(mut);
+        replaced = put(x, key, keyed, old);
+      }
+      after_put(replaced, old);
+    }
+
+    // A replacement never grows the queue, so it succeeds even when full
+    bool try_push(const T& x, std::size_t limit) noexcept override
+    {
+      Key key;
+      bool keyed = key_of(x, key);
+      T old{};
+      bool replaced;
+      {
+        std::lock_guard<std::mutex> lock(mut);
+        if (q_.size() >= limit && !replaces(key, keyed))
+          return false;
+        replaced = put(x, key, keyed, old);
+      }
+      after_put(replaced, old);
+      return true;
+    }
+
+    void push_wait(const T& x, std::size_t limit) noexcept override
+    {
+      Key key;
+      bool keyed = key_of(x, key);
+      T old{};
+      bool replaced;
+      {
+        std::unique_lock<std::mutex> lock(mut);
+        if (q_.size() >= limit && !replaces(key, keyed)) {
+          push_waiters_++;
+          space_cv.wait(lock, [&]() {
+            return q_.size() < limit || replaces(key, keyed);
+          });
+          push_waiters_--;
+        }
+        replaced = put(x, key, keyed, old);
+      }
+      after_put(replaced, old);
+    }
+
+    bool push_evict(const T& x, std::size_t limit, T& evicted, bool& queued) noexcept override
+    {
+      queued = true;
+      Key key;
+      bool keyed = key_of(x, key);
+      T old{};
+      bool full, replaced;
+      {
+        std::lock_guard<std::mutex> lock(mut);
+        full = q_.size() >= limit && !replaces(key, keyed);
+        if (full)
+          evicted = std::get<0>(take_front());
+        replaced = put(x, key, keyed, old);
+      }
+      after_put(replaced, old);
+      return full;
+    }
+
+    bool is_empty() const noexcept override
+    {
+      return size_.load(std::memory_order_acquire) == 0;
+    }
+
+    std::size_t length() const noexcept override
+    {
+      return size_.load(std::memory_order_acquire);
+    }
+
+    /// Items replaced in place by a newer one with the same key
+    std::size_t conflated() const noexcept
+    {
+      return conflated_.load(std::memory_order_relaxed);
+    }
+  };
+}
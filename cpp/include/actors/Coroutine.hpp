@@ -0,0 +1,369 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+#pragma once
+
+#include <bit>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "actors/Actor.hpp"
+#include "actors/ActorRef.hpp"
+#include "actors/act/TimerWheel.hpp"
+#include "actors/msg/Resume.hpp"
+
+// Largest coroutine frame kept for reuse (power of two); bigger ones use operator new
+#ifndef ACTOR_FRAME_POOL_MAX
+#define ACTOR_FRAME_POOL_MAX 2048
+#endif
+
+// Free frames kept per size class and thread
+#ifndef ACTOR_FRAME_POOL_DEPTH
+#define ACTOR_FRAME_POOL_DEPTH 64
+#endif
+
+static_assert(ACTOR_FRAME_POOL_MAX >= 64 && (ACTOR_FRAME_POOL_MAX & (ACTOR_FRAME_POOL_MAX - 1)) == 0,
+              "ACTOR_FRAME_POOL_MAX must be a power of two of at least 64");
+
+namespace actors
+{
+  /// Owned reply of an ask(); nullptr after a timeout
+  using Reply = std::unique_ptr<const Message, ReleaseMessage>;
+
+  /**
+   * FramePool - Per-thread free lists for coroutine frames
+   *
+   * Sizes are rounded up to a power of two from 64 bytes to
+   * ACTOR_FRAME_POOL_MAX. A handler's frame is normally allocated and
+   * freed on its actor's thread, so steady traffic recycles the same
+   * blocks without locking or calling the heap.
+   */
+  class FramePool
+  {
+  public:
+    static void *allocate(std::size_t n)
+    {
+      int c = size_class(n);
+      if (c < 0)
+        return ::operator new(n);
+      Lists &lists = local();
+      if (Block *b = lists.free[c]) {
+        lists.free[c] = b->next;
+        lists.count[c]--;
+        return b;
+      }
+      return ::operator new(MIN << c);
+    }
+
+    static void deallocate(void *p, std::size_t n) noexcept
+    {
+      int c = size_class(n);
+      if (c < 0) {
+        ::operator delete(p);
+        return;
+      }
+      Lists &lists = local();
+      if (lists.count[c] == ACTOR_FRAME_POOL_DEPTH) {
+        ::operator delete(p);
+        return;
+      }
+      auto *b = static_cast<Block *>(p);
+      b->next = lists.free[c];
+      lists.free[c] = b;
+      lists.count[c]++;
+    }
+
+    /// Free blocks cached by the calling thread
+    static std::size_t cached() noexcept
+    {
+      std::size_t n = 0;
+      for (int c : local().count)
+        n += c;
+      return n;
+    }
+
+  private:
+    static constexpr std::size_t MIN = 64;
+    static constexpr int CLASSES = std::bit_width(std::size_t(ACTOR_FRAME_POOL_MAX) / MIN);
+
+    struct Block
+    {
+      Block *next;
+    };
+
+    struct Lists
+    {
+      Block *free[CLASSES] = {};
+      int count[CLASSES] = {};
+
+      ~Lists()
+      {
+        for (Block *b : free)
+          while (b) {
+            Block *next = b->next;
+            ::operator delete(b);
+            b = next;
+          }
+      }
+    };
+
+    static Lists &local() noexcept
+    {
+      thread_local Lists lists;
+      return lists;
+    }
+
+    static int size_class(std::size_t n) noexcept
+    {
+      if (n > ACTOR_FRAME_POOL_MAX)
+        return -1;
+      if (n <= MIN)
+        return 0;
+      return std::bit_width((n - 1) / MIN);
+    }
+  };
+
+  /**
+   * Task - Return type of a coroutine message handler
+   *
+   *   actors::Task Frontend::on_request(const Request *m)
+   *   {
+   *     actors::Reply r = co_await actors::ask(backend, new Lookup(m->key));
+   *     if (!r)
+   *       co_await actors::sleep_for(std::chrono::milliseconds(10));  // timed out; back off
+   *     reply(new Answer(...));
+   *   }
+   *
+   *   MESSAGE_HANDLER(Request, on_request);
+   *
+   * The handler runs like any other until its first co_await, then returns
+   * and the actor goes on with its mailbox. The awaited reply, timeout or
+   * sleep arrives as msg::Resume, and the rest of the handler runs on the
+   * same actor as the handler for that message, so one actor never runs
+   * two handlers at once. Meanwhile the actor keeps the message (no copy),
+   * and on resume reply(), current_message() and current_sender() refer to
+   * it and its sender again. Other messages, including more of the same
+   * request, may be handled between the suspension and the resume.
+   *
+   * Only Message_N types can have coroutine handlers. Reached through
+   * fast_send(), the handler must not use its message after the first
+   * co_await (the caller owns it and fast_send() has returned), and a
+   * later reply() is sent to the caller rather than returned. An
+   * exception leaving the handler terminates, as from any handler. Frames
+   * come from FramePool.
+   */
+  class Task
+  {
+  public:
+    struct promise_type
+    {
+      Actor *owner;
+      const Message *msg = nullptr;  // The handled message; released at the end if owned
+      Actor *sender = nullptr;
+      bool owns_msg = false;
+
+      // Member handlers get their actor first; anything else has no actor to run on
+      template <class A, class... Args>
+      promise_type(A &self, Args &...) noexcept : owner(&self) {}
+
+      Task get_return_object() noexcept
+      {
+        return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+      }
+      std::suspend_never initial_suspend() noexcept { return {}; }
+      std::suspend_always final_suspend() noexcept { return {}; }
+      void return_void() noexcept {}
+      void unhandled_exception() noexcept { std::terminate(); }
+
+      static void *operator new(std::size_t n) { return FramePool::allocate(n); }
+      static void operator delete(void *p, std::size_t n) noexcept { FramePool::deallocate(p, n); }
+    };
+
+    using handle_t = std::coroutine_handle<promise_type>;
+
+    Task(Task &&other) noexcept : h_(std::exchange(other.h_, {})) {}
+    Task &operator=(Task &&) = delete;
+    /// A handler called directly rather than by its actor keeps running there
+    ~Task();
+
+    handle_t release() noexcept { return std::exchange(h_, {}); }
+
+  private:
+    explicit Task(handle_t h) noexcept : h_(h) {}
+    handle_t h_;
+  };
+
+  /**
+   * CoroutineHost - An actor's coroutine handlers and what they await
+   *
+   * Created by the first coroutine MESSAGE_HANDLER and owned by the
+   * actor. Everything but the two proxy actors runs on the actor's thread,
+   * so none of it is locked. Destroying the actor destroys handlers that
+   * are still suspended and cancels their timers; for remote asks the
+   * actor must outlive the ask's timeout.
+   */
+  class CoroutineHost
+  {
+  public:
+    using Handler = std::function<Task(Actor *, const Message *)>;
+
+    explicit CoroutineHost(Actor *owner);
+    ~CoroutineHost();
+
+    CoroutineHost(const CoroutineHost &) = delete;
+    CoroutineHost &operator=(const CoroutineHost &) = delete;
+
+    void add_handler(int id, Handler h);
+
+    /// Handlers suspended in co_await
+    std::size_t suspended() const noexcept { return live_.size(); }
+
+    // Used by the awaiters below. Takes ownership of m; throws for Rust refs.
+    void ask(Task::handle_t h, Reply *slot, const ActorRef &ref, const Message *m,
+             std::chrono::milliseconds timeout);
+    void sleep(Task::handle_t h, std::chrono::nanoseconds d);
+    static void adopt(Task::handle_t h) noexcept;
+
+  private:
+    friend class Actor;
+    class Waker;
+    class ReplyCatcher;
+
+    struct Pending
+    {
+      Task::handle_t h;
+      Reply *slot;              // Where await_resume() finds the reply
+      TimerHandle timer;
+      ReplyCatcher *catcher;    // Local asks only
+    };
+
+    void run(const Message *m);
+    void resume(const msg::Resume *r);
+    void finish(Task::handle_t h) noexcept;
+    int next_token() noexcept;
+    ReplyCatcher *catcher();
+
+    Actor *owner_;
+    std::unordered_map<int, Handler> handlers_;
+    std::unordered_map<int, Pending> pending_;
+    std::unordered_set<void *> live_;                      // Suspended frames by address
+    std::unique_ptr<Waker> waker_;                         // Turns timeouts into msg::Resume
+    std::vector<std::unique_ptr<ReplyCatcher>> catchers_;
+    std::vector<ReplyCatcher *> idle_catchers_;            // Their last ask was answered
+    int last_token_ = 0;
+  };
+
+  inline Task::~Task()
+  {
+    if (h_)
+      CoroutineHost::adopt(h_);
+  }
+
+  /// co_await ask(...) yields the Reply
+  class [[nodiscard]] AskAwaiter
+  {
+  public:
+    AskAwaiter(ActorRef ref, const Message *m, std::chrono::milliseconds timeout)
+        : ref_(std::move(ref)), m_(m), timeout_(timeout) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Task::handle_t h)
+    {
+      h.promise().owner->coroutine_host().ask(h, &reply_, ref_, m_, timeout_);
+    }
+    Reply await_resume() noexcept { return std::move(reply_); }
+
+  private:
+    ActorRef ref_;
+    const Message *m_;
+    std::chrono::milliseconds timeout_;
+    Reply reply_;
+  };
+
+  class [[nodiscard]] SleepAwaiter
+  {
+  public:
+    explicit SleepAwaiter(std::chrono::nanoseconds d) : d_(d) {}
+
+    bool await_ready() const noexcept { return d_ <= std::chrono::nanoseconds::zero(); }
+    void await_suspend(Task::handle_t h) { h.promise().owner->coroutine_host().sleep(h, d_); }
+    void await_resume() const noexcept {}
+
+  private:
+    std::chrono::nanoseconds d_;
+  };
+
+  /**
+   * In a coroutine handler: send m to ref and suspend until the reply, or
+   * nullptr once timeout passes. A local target answers with reply() as
+   * usual; remote and shared-memory refs go through ActorRef::ask().
+   * Takes ownership of m. Throws std::runtime_error for Rust refs.
+   */
+  inline AskAwaiter ask(ActorRef ref, const Message *m,
+                        std::chrono::milliseconds timeout = DEFAULT_ASK_TIMEOUT)
+  {
+    return AskAwaiter(std::move(ref), m, timeout);
+  }
+
+  inline AskAwaiter ask(Actor *target, const Message *m,
+                        std::chrono::milliseconds timeout = DEFAULT_ASK_TIMEOUT)
+  {
+    return AskAwaiter(ActorRef(target), m, timeout);
+  }
+
+  /// In a coroutine handler: suspend for d (TimerWheel resolution)
+  inline SleepAwaiter sleep_for(std::chrono::nanoseconds d)
+  {
+    return SleepAwaiter(d);
+  }
+
+  template <typename ActorT, typename MsgT, typename Ret>
+  void register_coroutine_handler(Actor *a, Ret (ActorT::*ptr)(const MsgT *))
+  {
+    static_assert(std::is_same_v<Ret, Task>, "coroutine handlers return actors::Task");
+    static_assert(requires { MsgT::message_id; }, "coroutine handlers need a Message_N message type");
+    a->coroutine_host().add_handler(MsgT::message_id, [ptr](Actor *self, const Message *m) {
+      return (static_cast<ActorT *>(self)->*ptr)(static_cast<const MsgT *>(m));
+    });
+  }
+}
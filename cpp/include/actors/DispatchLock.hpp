@@ -0,0 +1,91 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <atomic>
+
+namespace actors
+{
+  /**
+   * DispatchLock - Futex-based mutex guarding an actor's handlers
+   *
+   * Serializes the actor thread against fast_send() callers. The
+   * uncontended path is a single exchange to lock and one to unlock,
+   * inlined at the call site; a contended lock sleeps on the futex
+   * (C++20 atomic wait) rather than spinning, because the holder may
+   * be running an arbitrarily long handler.
+   *
+   * Satisfies BasicLockable, so std::lock_guard works with it.
+   */
+  class DispatchLock
+  {
+    // 0 = free, 1 = held, 2 = held with waiters
+    std::atomic<int> state_{0};
+
+    void lock_contended() noexcept
+    {
+      while (state_.exchange(2, std::memory_order_acquire) != 0)
+        state_.wait(2, std::memory_order_relaxed);
+    }
+
+  public:
+    DispatchLock() = default;
+    DispatchLock(const DispatchLock&) = delete;
+    DispatchLock& operator=(const DispatchLock&) = delete;
+
+    void lock() noexcept
+    {
+      int expected = 0;
+      if (!state_.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                          std::memory_order_relaxed))
+        lock_contended();
+    }
+
+    bool try_lock() noexcept
+    {
+      int expected = 0;
+      return state_.compare_exchange_strong(expected, 1, std::memory_order_acquire,
+                                            std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept
+    {
+      if (state_.exchange(0, std::memory_order_release) == 2)
+        state_.notify_one();
+    }
+  };
+}
@@ -0,0 +1,123 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace actors
+{
+  /**
+   * HandlerTable - Immutable message ID -> handler lookup
+   *
+   * Built once from an actor's registered handlers and sized to them:
+   * - IDs clustered in a small range use a dense array indexed by
+   *   (id - base), one bounds check and one load per dispatch
+   * - Sparse IDs use a sorted array searched with lower_bound
+   *
+   * Any 32-bit ID is safe to look up; unknown IDs return a null handler.
+   */
+  template <class Fn>
+  class HandlerTable
+  {
+    // Dense layout: slots for [base_, base_ + dense_.size())
+    std::vector<Fn> dense_;
+    std::int64_t base_ = 0;
+
+    // Sparse layout: parallel sorted arrays
+    std::vector<int> ids_;
+    std::vector<Fn> fns_;
+
+  public:
+    // A range up to this many slots per handler (plus slack) stays dense
+    static constexpr std::size_t DENSE_FACTOR = 4;
+    static constexpr std::size_t DENSE_SLACK = 16;
+
+    /// Replace the table contents; entries need not be sorted
+    void build(std::vector<std::pair<int, Fn>> entries)
+    {
+      dense_.clear();
+      ids_.clear();
+      fns_.clear();
+      if (entries.empty())
+        return;
+
+      std::sort(entries.begin(), entries.end(),
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+
+      const std::int64_t lo = entries.front().first;
+      const std::int64_t hi = entries.back().first;
+      const std::uint64_t range = std::uint64_t(hi - lo) + 1;
+
+      if (range <= entries.size() * DENSE_FACTOR + DENSE_SLACK) {
+        base_ = lo;
+        dense_.assign(range, nullptr);
+        for (auto& [id, fn] : entries)
+          dense_[std::size_t(id - lo)] = fn;
+        return;
+      }
+
+      ids_.reserve(entries.size());
+      fns_.reserve(entries.size());
+      for (auto& [id, fn] : entries) {
+        ids_.push_back(id);
+        fns_.push_back(fn);
+      }
+    }
+
+    Fn find(int id) const noexcept
+    {
+      if (!dense_.empty()) {
+        const std::uint64_t idx = std::uint64_t(std::int64_t(id) - base_);
+        return idx < dense_.size() ? dense_[idx] : nullptr;
+      }
+
+      auto it = std::lower_bound(ids_.begin(), ids_.end(), id);
+      if (it == ids_.end() || *it != id)
+        return nullptr;
+      return fns_[std::size_t(it - ids_.begin())];
+    }
+
+    bool is_dense() const noexcept { return !dense_.empty(); }
+
+    /// Number of slots held (dense) or handlers (sparse)
+    std::size_t slots() const noexcept { return dense_.empty() ? ids_.size() : dense_.size(); }
+  };
+}
@@ -0,0 +1,215 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "actors/Message.hpp"
+
+// Bytes per journal segment file; a record larger than this gets a segment of its own
+#ifndef ACTOR_JOURNAL_SEGMENT_BYTES
+#define ACTOR_JOURNAL_SEGMENT_BYTES (64u << 20)
+#endif
+
+namespace actors
+{
+  class Actor;
+
+  namespace journal
+  {
+    constexpr std::uint32_t MAGIC = 0x4C4E524A;  // "JRNL"
+    constexpr std::uint16_t VERSION = 1;
+
+    /// Start of every segment file
+    struct SegmentHeader
+    {
+      std::uint32_t magic;
+      std::uint16_t version;
+      std::uint16_t header_size;  // sizeof(SegmentHeader)
+      std::uint32_t index;        // Position in the journal, from 0
+      std::uint32_t reserved;
+      std::uint64_t first_seq;    // Sequence number of the first record
+      std::uint64_t created_ns;   // system_clock time the segment was opened
+    };
+
+    /**
+     * In front of every record, followed by the binary payload (see
+     * Wire.hpp) and padding to 8 bytes. seq is written last, so a record
+     * cut short by a crash reads as the end of the journal (seq 0).
+     */
+    struct RecordHeader
+    {
+      std::uint64_t seq;      // From 1, consecutive across segments
+      std::uint64_t time_ns;  // system_clock time the actor took the message
+      std::int32_t msg_id;
+      std::uint32_t length;   // Payload bytes
+    };
+
+    static_assert(sizeof(SegmentHeader) == 32 && sizeof(RecordHeader) == 24,
+                  "journal headers are part of the file format");
+
+    /// Segment files of journal name in dir, oldest first
+    std::vector<std::string> segments(const std::string &dir, const std::string &name);
+  }
+
+  /**
+   * Journal - Append-only log of the messages an actor handled
+   *
+   * Attach one with Actor::set_journal(): the actor then appends each
+   * message it takes from its mailbox, in the order its handlers see
+   * them, as a sequence number, a timestamp and the message's binary
+   * encoding. Only the actor's own thread appends, so nothing is locked.
+   *
+   * Records go into memory-mapped segment files <dir>/<name>.<index>.jnl
+   * of segment_bytes each; a full segment is trimmed to what it holds and
+   * the next one is opened. A journal reopened over existing segments
+   * continues after them. Types without a binary codec (e.g. Start and
+   * Shutdown) are counted in skipped() rather than recorded.
+   *
+   * Records survive the process crashing once append() returns; call
+   * sync() to also have them survive the machine going down.
+   */
+  class Journal
+  {
+  public:
+    /// Throws std::runtime_error if a segment cannot be created or an existing one is not a journal
+    Journal(std::string dir, std::string name,
+            std::size_t segment_bytes = ACTOR_JOURNAL_SEGMENT_BYTES);
+    ~Journal();
+
+    Journal(const Journal &) = delete;
+    Journal &operator=(const Journal &) = delete;
+
+    /**
+     * Record m. Called by the owning actor; call it yourself only from
+     * that actor's thread or when no actor uses this journal.
+     * @return false if m's type has no binary codec or the disk is full
+     */
+    bool append(const Message *m) noexcept;
+
+    /// Flush mapped records to disk (msync); false on error
+    bool sync() noexcept;
+
+    /// Sequence number the next record gets
+    std::uint64_t next_seq() const noexcept { return seq_; }
+    /// Records appended by this Journal object
+    std::uint64_t recorded() const noexcept { return recorded_; }
+    /// Messages not recorded: no binary codec, or a segment could not be opened
+    std::uint64_t skipped() const noexcept { return skipped_; }
+
+    const std::string &dir() const noexcept { return dir_; }
+    const std::string &name() const noexcept { return name_; }
+
+  private:
+    bool open_segment(std::size_t need) noexcept;
+    void close_segment() noexcept;
+
+    std::string dir_;
+    std::string name_;
+    std::size_t segment_bytes_;
+    std::string scratch_;  // Encoded payload of the record being appended
+    char *base_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t used_ = 0;
+    int fd_ = -1;
+    std::uint32_t index_ = 0;
+    std::uint64_t seq_ = 1;
+    std::uint64_t recorded_ = 0;
+    std::uint64_t skipped_ = 0;
+  };
+
+  /**
+   * JournalReader - Read back the records of a journal
+   *
+   * Walks the segments oldest first, decoding each payload with the
+   * MessageRegistry, so the message types must be registered in the
+   * reading process too. Reading stops at the end of the last complete
+   * record; a journal that is still being written can be reopened later
+   * to see more.
+   */
+  class JournalReader
+  {
+  public:
+    using Owned = std::unique_ptr<const Message, ReleaseMessage>;
+
+    struct Entry
+    {
+      std::uint64_t seq = 0;
+      std::uint64_t time_ns = 0;
+      int msg_id = 0;
+      Owned msg;  // nullptr if msg_id has no binary codec in this process
+    };
+
+    /// Throws std::runtime_error if there are no segments or one is not a journal
+    JournalReader(const std::string &dir, const std::string &name);
+    ~JournalReader();
+
+    JournalReader(const JournalReader &) = delete;
+    JournalReader &operator=(const JournalReader &) = delete;
+
+    /// Read the next record into e; false at the end of the journal
+    bool next(Entry &e);
+
+  private:
+    bool open(std::size_t i);
+    void unmap() noexcept;
+
+    std::vector<std::string> paths_;
+    std::size_t current_ = 0;
+    const char *base_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t pos_ = 0;
+  };
+
+  enum class ReplaySpeed
+  {
+    RECORDED,  // Keep the recorded gaps between messages
+    MAX,       // Send everything as fast as the mailbox takes it
+  };
+
+  /**
+   * Send the rest of reader's journal to to, as if from sender, on the
+   * calling thread: any thread once Manager::init() has returned. At
+   * RECORDED speed the call sleeps out the recorded gaps. Records whose
+   * type has no binary codec in this process are skipped.
+   * @return Number of messages sent
+   */
+  std::size_t replay(JournalReader &reader, Actor *to,
+                     ReplaySpeed speed = ReplaySpeed::MAX, Actor *sender = nullptr);
+}
@@ -0,0 +1,243 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <atomic>
+#include <tuple>
+#include "actors/Queue.hpp"
+
+namespace actors
+{
+  /**
+   * LaneQueue - Blocking queue with Lanes priority classes
+   *
+   * Each item goes to the lane lane_of() picks for it; pops always take
+   * the oldest item of the highest non-empty lane, so a high lane never
+   * waits behind a backlog in a lower one. Order is FIFO within a lane.
+   *
+   * Same locking as BQueue: one mutex, condition variable wakeups.
+   */
+  template <class T, std::size_t Lanes>
+  class LaneQueue : public Queue<T>
+  {
+  public:
+    /// Lane of x, 0 (lowest) to Lanes - 1 (highest); called under the lock
+    using LaneFn = std::size_t (*)(const T& x);
+
+  private:
+    // Same split as BQueue: locked state, lock-free counters, cold path
+    alignas(64) mutable std::mutex mut;
+    mutable std::condition_variable cv;
+    std::size_t push_waiters_ = 0;
+    LaneFn lane_of_;
+    std::deque<T> lanes_[Lanes];
+    alignas(64) std::atomic<std::size_t> size_{0};  // lets try_pop() skip the lock when empty
+    std::atomic<std::size_t> lane_size_[Lanes] = {};
+    alignas(64) std::condition_variable space_cv;   // producers waiting in push_wait()
+
+    // Caller holds mut and lane l is not empty
+    T take(std::size_t l) noexcept
+    {
+      T ret = lanes_[l].front();
+      lanes_[l].pop_front();
+      lane_size_[l].fetch_sub(1, std::memory_order_relaxed);
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      if (push_waiters_)
+        space_cv.notify_all();
+      return ret;
+    }
+
+    // Caller holds mut and the queue is not empty
+    std::tuple<T, bool> take_front() noexcept
+    {
+      std::size_t l = Lanes - 1;
+      while (lanes_[l].empty())
+        l--;
+      T ret = take(l);
+      return std::make_tuple(ret, size_.load(std::memory_order_relaxed) == 0);
+    }
+
+    // Caller holds mut
+    std::size_t take_batch(T* out, std::size_t max, bool& last) noexcept
+    {
+      std::size_t n = 0;
+      for (std::size_t l = Lanes; l-- > 0 && n < max;) {
+        while (n < max && !lanes_[l].empty())
+          out[n++] = take(l);
+      }
+      last = size_.load(std::memory_order_relaxed) == 0;
+      return n;
+    }
+
+    // Caller holds mut
+    void put(const T& x) noexcept
+    {
+      std::size_t l = lane_of_(x);
+      if (l >= Lanes)
+        l = Lanes - 1;
+      lanes_[l].push_back(x);
+      lane_size_[l].fetch_add(1, std::memory_order_relaxed);
+      size_.fetch_add(1, std::memory_order_release);
+    }
+
+  public:
+    // n is accepted for symmetry with the other mailboxes; lanes grow freely
+    LaneQueue(std::size_t /*n*/, LaneFn lane_of) : lane_of_(lane_of) {}
+
+    std::tuple<T, bool> pop() noexcept override
+    {
+      std::unique_lock<std::mutex> lock(mut);
+      cv.wait(lock, [this]() { return size_.load(std::memory_order_relaxed) != 0; });
+      return take_front();
+    }
+
+    bool try_pop(std::tuple<T, bool>& out) noexcept override
+    {
+      if (size_.load(std::memory_order_acquire) == 0)
+        return false;
+
+      std::lock_guard<std::mutex> lock(mut);
+      if (size_.load(std::memory_order_relaxed) == 0)
+        return false;
+      out = take_front();
+      return true;
+    }
+
+    std::size_t pop_batch(T* out, std::size_t max, bool& last) noexcept override
+    {
+      std::unique_lock<std::mutex> lock(mut);
+      cv.wait(lock, [this]() { return size_.load(std::memory_order_relaxed) != 0; });
+      return take_batch(out, max, last);
+    }
+
+    std::size_t try_pop_batch(T* out, std::size_t max, bool& last) noexcept override
+    {
+      if (size_.load(std::memory_order_acquire) == 0)
+        return 0;
+
+      std::lock_guard<std::mutex> lock(mut);
+      return take_batch(out, max, last);
+    }
+
+    T peek() const noexcept override
+    {
+      std::lock_guard<std::mutex> lock(mut);
+      for (std::size_t l = Lanes; l-- > 0;) {
+        if (!lanes_[l].empty())
+          return lanes_[l].front();
+      }
+      return T{};
+    }
+
+    void push(const T& x) noexcept override
+    {
+      {
+        std::lock_guard<std::mutex> lock(mut);
+        put(x);
+      }
+      cv.notify_one();
+    }
+
+    bool try_push(const T& x, std::size_t limit) noexcept override
+    {
+      {
+        std::lock_guard<std::mutex> lock(mut);
+        if (size_.load(std::memory_order_relaxed) >= limit)
+          return false;
+        put(x);
+      }
+      cv.notify_one();
+      return true;
+    }
+
+    void push_wait(const T& x, std::size_t limit) noexcept override
+    {
+      {
+        std::unique_lock<std::mutex> lock(mut);
+        if (size_.load(std::memory_order_relaxed) >= limit) {
+          push_waiters_++;
+          space_cv.wait(lock, [this, limit]() {
+            return size_.load(std::memory_order_relaxed) < limit;
+          });
+          push_waiters_--;
+        }
+        put(x);
+      }
+      cv.notify_one();
+    }
+
+    // Evicts the oldest item of the lowest non-empty lane
+    bool push_evict(const T& x, std::size_t limit, T& evicted, bool& queued) noexcept override
+    {
+      queued = true;
+      bool full;
+      {
+        std::lock_guard<std::mutex> lock(mut);
+        full = size_.load(std::memory_order_relaxed) >= limit;
+        if (full) {
+          std::size_t l = 0;
+          while (lanes_[l].empty())
+            l++;
+          evicted = take(l);
+        }
+        put(x);
+      }
+      cv.notify_one();
+      return full;
+    }
+
+    bool is_empty() const noexcept override
+    {
+      return size_.load(std::memory_order_acquire) == 0;
+    }
+
+    std::size_t length() const noexcept override
+    {
+      return size_.load(std::memory_order_acquire);
+    }
+
+    /// Items queued in lane l
+    std::size_t length(std::size_t l) const noexcept
+    {
+      return l < Lanes ? lane_size_[l].load(std::memory_order_relaxed) : 0;
+    }
+  };
+}
@@ -0,0 +1,253 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*
+ * Latency instrumentation is compiled in only with -DACTOR_LATENCY
+ * (make LATENCY=1). Build the library and the application with the same
+ * setting: the flag adds an enqueue timestamp to every Delivery.
+ */
+
+namespace actors
+{
+  /// Raw timestamp counter: rdtsc on x86, cntvct on ARM, steady_clock elsewhere
+  inline std::uint64_t read_tsc() noexcept
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    std::uint64_t v;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+  }
+
+  /**
+   * Nanoseconds per read_tsc() tick, measured against steady_clock since
+   * the first call. The estimate sharpens as the process runs; it is only
+   * used when reporting, never on the hot path.
+   */
+  inline double tsc_ns_per_tick() noexcept
+  {
+    using namespace std::chrono;
+    static const auto t0 = steady_clock::now();
+    static const auto c0 = read_tsc();
+
+    auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - t0).count();
+    auto ticks = read_tsc() - c0;
+    if (elapsed < 1000000 || ticks == 0) {
+      // Too early to tell: take a 1 ms sample
+      auto s0 = steady_clock::now();
+      auto k0 = read_tsc();
+      while (steady_clock::now() - s0 < milliseconds(1)) {}
+      return double(duration_cast<nanoseconds>(steady_clock::now() - s0).count()) /
+             double(read_tsc() - k0);
+    }
+    return double(elapsed) / double(ticks);
+  }
+
+  /// Percentiles of a LatencyHistogram, in nanoseconds
+  struct LatencySummary
+  {
+    std::uint64_t count = 0;
+    double min = 0;
+    double mean = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double p999 = 0;
+    double max = 0;
+  };
+
+  /**
+   * LatencyHistogram - Log-linear (HDR-style) histogram of tick counts
+   *
+   * Each power of two is split into 16 linear sub-buckets, so any
+   * recorded value is reported within 1/16 (6.25%) of its true value.
+   * Values up to 2^40 ticks are tracked; larger ones land in the last
+   * bucket.
+   *
+   * One thread records, any thread may summarize: counters are relaxed
+   * atomics written with a plain load+store, so recording takes no lock
+   * and no read-modify-write.
+   */
+  class LatencyHistogram
+  {
+  public:
+    static constexpr int SUB_BITS = 4;
+    static constexpr int SUB = 1 << SUB_BITS;
+    static constexpr int MAGNITUDES = 40;
+    static constexpr int BUCKETS = (MAGNITUDES - SUB_BITS + 1) * SUB;
+
+    void record(std::uint64_t ticks) noexcept
+    {
+      bump(counts_[index(ticks)], 1);
+      bump(total_, 1);
+      bump(sum_, ticks);
+      if (ticks > max_.load(std::memory_order_relaxed))
+        max_.store(ticks, std::memory_order_relaxed);
+      if (ticks < min_.load(std::memory_order_relaxed))
+        min_.store(ticks, std::memory_order_relaxed);
+    }
+
+    std::uint64_t count() const noexcept { return total_.load(std::memory_order_relaxed); }
+    /// Sum of all recorded tick counts
+    std::uint64_t sum() const noexcept { return sum_.load(std::memory_order_relaxed); }
+
+    /// Summarize; ns_per_tick converts ticks to nanoseconds
+    LatencySummary summary(double ns_per_tick = tsc_ns_per_tick()) const noexcept
+    {
+      LatencySummary s;
+      std::array<std::uint64_t, BUCKETS> c;
+      std::uint64_t n = 0;
+      for (int i = 0; i < BUCKETS; i++)
+        n += c[i] = counts_[i].load(std::memory_order_relaxed);
+      if (n == 0)
+        return s;
+
+      s.count = n;
+      s.min = double(min_.load(std::memory_order_relaxed)) * ns_per_tick;
+      s.max = double(max_.load(std::memory_order_relaxed)) * ns_per_tick;
+      s.mean = double(sum_.load(std::memory_order_relaxed)) / double(n) * ns_per_tick;
+
+      const double q[] = {0.50, 0.90, 0.99, 0.999};
+      double *out[] = {&s.p50, &s.p90, &s.p99, &s.p999};
+      std::uint64_t seen = 0;
+      int k = 0;
+      for (int i = 0; i < BUCKETS && k < 4; i++) {
+        seen += c[i];
+        while (k < 4 && seen >= std::uint64_t(q[k] * double(n) + 0.5) && seen > 0) {
+          *out[k] = double(upper(i)) * ns_per_tick;
+          if (*out[k] > s.max)
+            *out[k] = s.max;
+          k++;
+        }
+      }
+      return s;
+    }
+
+    /// Bucket holding a tick count (exposed for tests)
+    static int index(std::uint64_t v) noexcept
+    {
+      if (v < SUB)
+        return int(v);
+      int msb = 63 - __builtin_clzll(v);
+      if (msb >= MAGNITUDES)
+        return BUCKETS - 1;
+      int shift = msb - SUB_BITS;
+      return (shift + 1) * SUB + int((v >> shift) & (SUB - 1));
+    }
+
+    /// Largest tick count that falls in bucket i
+    static std::uint64_t upper(int i) noexcept
+    {
+      if (i < SUB)
+        return std::uint64_t(i);
+      int shift = i / SUB - 1;
+      std::uint64_t base = std::uint64_t(SUB + i % SUB) << shift;
+      return base + ((std::uint64_t(1) << shift) - 1);
+    }
+
+  private:
+    static void bump(std::atomic<std::uint64_t> &c, std::uint64_t by) noexcept
+    {
+      c.store(c.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<std::uint64_t>, BUCKETS> counts_{};
+    std::atomic<std::uint64_t> total_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> max_{0};
+    std::atomic<std::uint64_t> min_{UINT64_MAX};
+  };
+
+  /// Queue-wait and handler-time summaries of one actor (or one message ID)
+  struct LatencyReport
+  {
+    LatencySummary queue_wait;
+    LatencySummary handler;
+  };
+
+  /**
+   * Per-actor latency state, present only when built with ACTOR_LATENCY.
+   * queue_wait runs from send() to the start of the handler; handler covers
+   * the handler call itself (fast_send() calls have no queue wait).
+   */
+  struct ActorLatency
+  {
+    LatencyHistogram queue_wait;
+    LatencyHistogram handler;
+
+    // Optional per message ID breakdown; only the actor's thread inserts
+    struct ById { LatencyHistogram queue_wait, handler; };
+    mutable std::mutex by_id_mut;
+    std::unordered_map<int, std::unique_ptr<ById>> by_id;
+
+    ById &for_id(int id)
+    {
+      auto it = by_id.find(id);
+      if (it != by_id.end())
+        return *it->second;
+      std::lock_guard<std::mutex> lock(by_id_mut);
+      return *(by_id[id] = std::make_unique<ById>());
+    }
+
+    std::map<int, LatencyReport> report_by_id(double ns_per_tick) const
+    {
+      std::map<int, LatencyReport> ret;
+      std::lock_guard<std::mutex> lock(by_id_mut);
+      for (auto &[id, h] : by_id)
+        ret[id] = {h->queue_wait.summary(ns_per_tick), h->handler.summary(ns_per_tick)};
+      return ret;
+    }
+  };
+}
@@ -0,0 +1,215 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include "actors/Queue.hpp"
+#include "actors/Backoff.hpp"
+#include "actors/Memory.hpp"
+
+namespace actors
+{
+  /**
+   * MPSCQueue - Bounded lock-free multi-producer/single-consumer ring
+   *
+   * Any number of threads may push; exactly one thread may pop.
+   * Producers claim a slot with a single fetch_add on the enqueue index
+   * and publish it through the slot's sequence number (Vyukov style),
+   * so pushing never takes a lock and never allocates.
+   *
+   * push() spins while the claimed slot is still occupied, so size the
+   * ring for the largest burst the actor must absorb. pop() spins
+   * briefly and then parks until a producer publishes.
+   */
+  template <class T>
+  class MPSCQueue : public Queue<T>
+  {
+  private:
+    struct alignas(64) Cell
+    {
+      std::atomic<std::size_t> seq;
+      T data;
+    };
+
+    static std::size_t round_up(std::size_t n)
+    {
+      std::size_t cap = 2;
+      while (cap < n)
+        cap <<= 1;
+      return cap;
+    }
+
+    const std::size_t mask_;
+    PageArray<Cell> buf_;  // on huge pages under MemoryMode::LOCKED
+
+    // Producer side
+    alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+
+    // Consumer side
+    alignas(64) std::atomic<std::size_t> dequeue_pos_{0};
+
+    alignas(64) Parker parker_;
+
+    // Consumer only; cell at pos is known to be published
+    std::tuple<T, bool> take(Cell& cell, std::size_t pos) noexcept
+    {
+      T ret = cell.data;
+      cell.seq.store(pos + mask_ + 1, std::memory_order_release);
+      dequeue_pos_.store(pos + 1, std::memory_order_release);
+
+      bool last = enqueue_pos_.load(std::memory_order_acquire) == pos + 1;
+      return std::make_tuple(ret, last);
+    }
+
+    // Consumer only; takes published cells from pos until max or a gap
+    std::size_t take_batch(std::size_t pos, T* out, std::size_t max, bool& last) noexcept
+    {
+      std::size_t n = 0;
+      while (n < max) {
+        Cell& cell = buf_[(pos + n) & mask_];
+        if (cell.seq.load(std::memory_order_acquire) != pos + n + 1)
+          break;
+        out[n] = cell.data;
+        cell.seq.store(pos + n + mask_ + 1, std::memory_order_release);
+        n++;
+      }
+      if (n == 0)
+        return 0;
+
+      dequeue_pos_.store(pos + n, std::memory_order_release);
+      last = enqueue_pos_.load(std::memory_order_acquire) == pos + n;
+      return n;
+    }
+
+  public:
+    explicit MPSCQueue(std::size_t n)
+      : mask_(round_up(n) - 1), buf_(mask_ + 1)
+    {
+      for (std::size_t i = 0; i <= mask_; i++)
+        buf_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+
+    std::pair<void*, std::size_t> storage() noexcept override { return {buf_.data(), buf_.bytes()}; }
+
+    std::tuple<T, bool> pop() noexcept override
+    {
+      const std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+      Cell& cell = buf_[pos & mask_];
+      if (cell.seq.load(std::memory_order_acquire) != pos + 1) {
+        parker_.park_until([&cell, pos]() {
+          return cell.seq.load(std::memory_order_acquire) == pos + 1;
+        });
+      }
+      return take(cell, pos);
+    }
+
+    bool try_pop(std::tuple<T, bool>& out) noexcept override
+    {
+      const std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+      Cell& cell = buf_[pos & mask_];
+      if (cell.seq.load(std::memory_order_acquire) != pos + 1)
+        return false;
+      out = take(cell, pos);
+      return true;
+    }
+
+    std::size_t pop_batch(T* out, std::size_t max, bool& last) noexcept override
+    {
+      const std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+      Cell& cell = buf_[pos & mask_];
+      if (cell.seq.load(std::memory_order_acquire) != pos + 1) {
+        parker_.park_until([&cell, pos]() {
+          return cell.seq.load(std::memory_order_acquire) == pos + 1;
+        });
+      }
+      return take_batch(pos, out, max, last);
+    }
+
+    std::size_t try_pop_batch(T* out, std::size_t max, bool& last) noexcept override
+    {
+      return max == 0 ? 0 : take_batch(dequeue_pos_.load(std::memory_order_relaxed), out, max, last);
+    }
+
+    T peek() const noexcept override
+    {
+      const std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+      const Cell& cell = buf_[pos & mask_];
+      if (cell.seq.load(std::memory_order_acquire) != pos + 1) {
+        if constexpr (std::is_pointer<T>::value)
+          return nullptr;
+        else
+          return T{};
+      }
+      return cell.data;
+    }
+
+    void push(const T& x) noexcept override
+    {
+      const std::size_t pos = enqueue_pos_.fetch_add(1, std::memory_order_relaxed);
+      Cell& cell = buf_[pos & mask_];
+
+      // Slot still holds an unconsumed item from the previous lap
+      if (cell.seq.load(std::memory_order_acquire) != pos) {
+        Backoff backoff;
+        while (cell.seq.load(std::memory_order_acquire) != pos)
+          backoff.pause();
+      }
+
+      cell.data = x;
+      cell.seq.store(pos + 1, std::memory_order_release);
+      parker_.unpark();
+    }
+
+    bool is_empty() const noexcept override
+    {
+      return length() == 0;
+    }
+
+    std::size_t length() const noexcept override
+    {
+      const std::size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+      const std::size_t head = dequeue_pos_.load(std::memory_order_acquire);
+      return tail > head ? tail - head : 0;
+    }
+  };
+}
@@ -0,0 +1,145 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+// Stack each actor thread prefaults under MemoryMode::LOCKED
+#ifndef ACTOR_PREFAULT_STACK_BYTES
+#define ACTOR_PREFAULT_STACK_BYTES (256 * 1024)
+#endif
+
+// Huge-page chunk that message pool slabs are carved from
+#ifndef ACTOR_POOL_ARENA_BYTES
+#define ACTOR_POOL_ARENA_BYTES (4 * 1024 * 1024)
+#endif
+
+namespace actors
+{
+  /**
+   * Page-level helpers behind Manager::set_memory_mode()
+   *
+   * With huge pages on, mailbox rings and message pool slabs are mapped
+   * on transparent huge pages: each ring takes whole huge pages, and
+   * slabs are carved from ACTOR_POOL_ARENA_BYTES chunks that are never
+   * returned (pool slabs never were). The flag is process-wide and only
+   * affects memory allocated after it is set.
+   */
+  namespace memory
+  {
+    /// Transparent huge page size, usually 2 MB
+    std::size_t huge_page_size() noexcept;
+
+    void set_huge_pages(bool enabled) noexcept;
+    bool huge_pages() noexcept;
+
+    /**
+     * Map zeroed anonymous memory aligned to and rounded up to whole huge
+     * pages, advised for THP (madvise MADV_HUGEPAGE). Throws std::bad_alloc.
+     * @param mapped Set to the length to pass to unmap_huge()
+     */
+    void *map_huge(std::size_t bytes, std::size_t &mapped);
+    void unmap_huge(void *p, std::size_t mapped) noexcept;
+
+    /// Memory for a message pool slab; never freed
+    void *slab(std::size_t bytes, std::size_t align);
+
+    /**
+     * Write to every page of [p, p + bytes) without changing its content,
+     * so each is backed before first use. Safe while other threads use
+     * the memory. Returns bytes covered.
+     */
+    std::size_t prefault(void *p, std::size_t bytes) noexcept;
+
+    /// Fault in this much of the calling thread's stack below the caller
+    std::size_t prefault_stack(std::size_t bytes) noexcept;
+
+    /// Map one pool arena chunk now (when huge_pages()) so the first slabs are warm
+    std::size_t reserve_slabs() noexcept;
+
+    /// Bytes currently mapped by map_huge(), pool arena chunks included
+    std::size_t huge_bytes() noexcept;
+
+    /// VmLck from /proc/self/status, 0 if unavailable
+    std::size_t locked_bytes();
+  }
+
+  /**
+   * Fixed array of T for ring buffers: from map_huge() when huge pages
+   * are on, else new T[n]. Elements are default-initialized either way.
+   */
+  template <class T>
+  class PageArray
+  {
+    T *p_ = nullptr;
+    std::size_t n_ = 0;
+    std::size_t mapped_ = 0;  // 0: allocated with new[]
+
+  public:
+    explicit PageArray(std::size_t n) : n_(n)
+    {
+      if (!memory::huge_pages()) {
+        p_ = new T[n];
+        return;
+      }
+      p_ = static_cast<T *>(memory::map_huge(n * sizeof(T), mapped_));
+      std::uninitialized_default_construct_n(p_, n);
+    }
+
+    ~PageArray()
+    {
+      if (!mapped_) {
+        delete[] p_;
+        return;
+      }
+      std::destroy_n(p_, n_);
+      memory::unmap_huge(p_, mapped_);
+    }
+
+    PageArray(const PageArray &) = delete;
+    PageArray &operator=(const PageArray &) = delete;
+
+    T &operator[](std::size_t i) noexcept { return p_[i]; }
+    const T &operator[](std::size_t i) const noexcept { return p_[i]; }
+
+    void *data() noexcept { return p_; }
+    std::size_t bytes() const noexcept { return n_ * sizeof(T); }
+    bool on_huge_pages() const noexcept { return mapped_ != 0; }
+  };
+}
@@ -36,44 +36,122 @@ https://opensource.org/licenses/MIT
 
 #pragma once
 
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
 namespace actors
 {
   class Actor;
 
+  template <class M> class Shared;
+
   /**
    * Base class for all messages in the actor system
    *
    * Messages are the only way actors communicate.
-   * Each message type has a unique ID (0-511 for optimal performance).
+   * Each message type has a unique 32-bit ID.
+   *
+   * A message carries only its payload: who sent it, and to whom, belong
+   * to the mailbox entry (Delivery), so the body is never written once
+   * sent. A plain message has one owner and is deleted after its one
+   * delivery. A shared message (make_shared_message()) is counted: every
+   * send() consumes a reference and every delivery releases one.
    */
   struct Message
   {
+    static constexpr int NO_ID = INT_MIN;
+
     virtual int get_message_id() const = 0;
-    mutable Actor *sender = nullptr;
-    mutable Actor *destination = nullptr;
-    mutable bool is_fast = false;
-    mutable bool last = false;
 
-    Message() = default;
+    /**
+     * Message ID without a virtual call
+     * Read from the header for Message_N types; falls back to
+     * get_message_id() for classes deriving from Message directly.
+     */
+    int id() const noexcept { return msg_id != NO_ID ? msg_id : get_message_id(); }
 
-    Message(const Message& other)
-      : sender(other.sender)
-      , destination(nullptr)
-      , is_fast(other.is_fast)
-      , last(other.last)
-    {}
-
-    Message& operator=(const Message& other) {
-      if (this != &other) {
-        sender = other.sender;
-        destination = nullptr;
-        is_fast = other.is_fast;
-        last = other.last;
-      }
-      return *this;
+    /// True if made by make_shared_message()
+    bool is_shared() const noexcept { return refs.load(std::memory_order_relaxed) != 0; }
+
+    /// Add a reference to a shared message; no-op for a plain one
+    void retain() const noexcept
+    {
+      if (is_shared())
+        refs.fetch_add(1, std::memory_order_relaxed);
     }
 
+    /**
+     * Give up a reference: deletes a plain message, and a shared one
+     * once its last reference is released. Whatever consumes a sent
+     * message (mailbox, transport) calls this instead of delete.
+     */
+    void release() const noexcept
+    {
+      if (!is_shared() || refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete this;
+    }
+
+    Message() = default;
+
+    // A copy is a new, plain message
+    Message(const Message& other) noexcept : msg_id(other.msg_id) {}
+    Message& operator=(const Message&) noexcept { return *this; }
+
     virtual ~Message() = default;
+
+  protected:
+    explicit Message(int id) noexcept : msg_id(id) {}
+
+  private:
+    template <class M> friend class Shared;
+
+    int msg_id = NO_ID;
+    mutable std::atomic<std::uint32_t> refs{0};  // 0 = plain; keeps the header at 16 bytes
+  };
+
+  /**
+   * Mailbox priority class. A PRIORITY mailbox always drains the highest
+   * non-empty lane first; other mailboxes ignore lanes.
+   */
+  enum class Lane : std::uint8_t
+  {
+    LOW,
+    NORMAL,   // default
+    HIGH,
+    CONTROL   // msg::Start and msg::Shutdown unless reassigned; never blocked by a mailbox limit
+  };
+
+  inline constexpr std::size_t LANE_COUNT = 4;
+
+  /**
+   * Delivery - One mailbox entry: a message and this delivery of it
+   *
+   * Per-delivery metadata lives here rather than in the message, so a
+   * shared message can sit in many mailboxes at once.
+   */
+  struct Delivery
+  {
+    const Message *msg = nullptr;
+    Actor *sender = nullptr;  // For reply(); may be nullptr
+    Actor *to = nullptr;      // Receiver; a Group's mailbox holds its members'
+    Lane lane = Lane::NORMAL; // Set by Actor::send() for a PRIORITY mailbox
+#ifdef ACTOR_LATENCY
+    std::uint64_t enqueue_tsc = 0;  // stamped by Actor::send()
+#endif
+#ifdef ACTOR_TRACE
+    std::uint64_t trace_flow = 0;   // trace::Event::flow, 0 while tracing is off
+#endif
+  };
+
+  /**
+   * unique_ptr deleter for holders of a message that may be shared
+   */
+  struct ReleaseMessage
+  {
+    void operator()(const Message *m) const noexcept { m->release(); }
   };
 
   /**
@@ -85,14 +163,93 @@ namespace actors
    *     MyMessage(int d) : data(d) {}
    *   };
    *
-   * Use IDs 0-511 for best performance (handler cache optimization)
+   * Any int may be used as an ID; an actor's handler table is sized to
+   * the handlers it registers, so IDs that cluster together dispatch fastest.
    */
   template <int N>
   struct Message_N : public Message
   {
+    static constexpr int message_id = N;
+
+    Message_N() noexcept : Message(N) {}
+    Message_N(const Message_N&) = default;
+    Message_N& operator=(const Message_N&) = default;
+
     constexpr int get_message_id() const override { return N; }
   };
 }
 
+namespace actors
+{
+  /**
+   * Shared<M> - Owning handle to a shared message
+   *
+   * Broadcasts one immutable message instead of a copy per receiver.
+   * share() hands out a new reference for each send(); the handle keeps
+   * its own and releases it when destroyed. Receivers see an ordinary
+   * const M* and must not keep it past the handler without retain().
+   *
+   * Usage:
+   *   auto depth = actors::make_shared_message<MarketDepth>(...);
+   *   for (auto *s : strategies)
+   *     s->send(depth.share(), this);
+   */
+  template <class M>
+  class Shared
+  {
+  public:
+    Shared() = default;
+    Shared(const Shared &other) noexcept : m_(other.m_)
+    {
+      if (m_)
+        m_->retain();
+    }
+    Shared(Shared &&other) noexcept : m_(std::exchange(other.m_, nullptr)) {}
+    Shared &operator=(Shared other) noexcept
+    {
+      std::swap(m_, other.m_);
+      return *this;
+    }
+    ~Shared()
+    {
+      if (m_)
+        m_->release();
+    }
+
+    /// A new reference, for one send()
+    const M *share() const noexcept
+    {
+      m_->retain();
+      return m_;
+    }
+
+    const M *get() const noexcept { return m_; }
+    const M *operator->() const noexcept { return m_; }
+    const M &operator*() const noexcept { return *m_; }
+    explicit operator bool() const noexcept { return m_ != nullptr; }
+
+    /// References held, by this handle and by undelivered sends
+    std::uint32_t use_count() const noexcept { return m_ ? m_->refs.load(std::memory_order_relaxed) : 0; }
+
+    /// Share a plain message not sent yet; the handle holds the first reference
+    static Shared adopt(const M *m) noexcept { return Shared(m); }
+
+  private:
+    template <class T, class... Args>
+    friend Shared<T> make_shared_message(Args &&...args);
+
+    explicit Shared(const M *m) noexcept : m_(m) { m_->refs.store(1, std::memory_order_relaxed); }
+
+    const M *m_ = nullptr;
+  };
+
+  /// Construct a shared M; the handle holds the first reference
+  template <class M, class... Args>
+  Shared<M> make_shared_message(Args &&...args)
+  {
+    return Shared<M>(new M(std::forward<Args>(args)...));
+  }
+}
+
 typedef actors::Message* msg_ptr;
 typedef const actors::Message* const_msg_ptr;
@@ -0,0 +1,305 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include "actors/Memory.hpp"
+#include "actors/Message.hpp"
+
+#define ACTOR_POOL_BATCH 64
+
+namespace actors
+{
+  /// Counters for one message pool
+  struct PoolStats
+  {
+    std::uint64_t hits = 0;      // allocations served from the thread-local cache
+    std::uint64_t misses = 0;    // allocations that had to refill from the shared depot or a new slab
+    std::uint64_t blocks = 0;    // blocks carved from slabs so far (pool high-water mark)
+    std::uint64_t returns = 0;   // batches handed back to the shared depot
+    std::size_t block_size = 0;
+  };
+
+  namespace detail
+  {
+    struct FreeBlock
+    {
+      FreeBlock *next;
+    };
+
+    class PoolDepotBase
+    {
+    public:
+      virtual ~PoolDepotBase() = default;
+      virtual PoolStats stats() const noexcept = 0;
+      virtual const char *type_name() const noexcept = 0;
+    };
+
+    struct PoolDirectory
+    {
+      std::mutex mutex;
+      std::vector<PoolDepotBase *> pools;
+
+      static PoolDirectory &instance()
+      {
+        static PoolDirectory *dir = new PoolDirectory();  // never destroyed
+        return *dir;
+      }
+    };
+
+    /**
+     * Shared per-type store of free blocks, exchanged with the
+     * thread-local caches in chains so the lock is taken once per
+     * ACTOR_POOL_BATCH allocations or frees.
+     */
+    template <class T>
+    class PoolDepot : public PoolDepotBase
+    {
+      mutable std::mutex mutex_;
+      std::vector<std::pair<FreeBlock *, std::size_t>> chains_;
+
+    public:
+      static constexpr std::size_t BLOCK_SIZE =
+        sizeof(T) < sizeof(FreeBlock) ? sizeof(FreeBlock) : sizeof(T);
+      static constexpr std::size_t BLOCK_ALIGN =
+        alignof(T) < alignof(FreeBlock) ? alignof(FreeBlock) : alignof(T);
+      static constexpr std::size_t STRIDE = (BLOCK_SIZE + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+
+      std::atomic<std::uint64_t> hits{0};
+      std::atomic<std::uint64_t> misses{0};
+      std::atomic<std::uint64_t> blocks{0};
+      std::atomic<std::uint64_t> returns{0};
+
+      static PoolDepot &instance()
+      {
+        static PoolDepot *depot = []() {
+          auto *d = new PoolDepot();  // never destroyed: thread caches may outlive statics
+          auto &dir = PoolDirectory::instance();
+          std::lock_guard<std::mutex> lock(dir.mutex);
+          dir.pools.push_back(d);
+          return d;
+        }();
+        return *depot;
+      }
+
+      /// Take a chain of free blocks, carving a new slab if the depot is empty
+      std::pair<FreeBlock *, std::size_t> take()
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (!chains_.empty()) {
+            auto chain = chains_.back();
+            chains_.pop_back();
+            return chain;
+          }
+        }
+
+        char *slab = static_cast<char *>(memory::slab(STRIDE * ACTOR_POOL_BATCH, BLOCK_ALIGN));
+        FreeBlock *head = nullptr;
+        for (std::size_t i = ACTOR_POOL_BATCH; i-- > 0;) {
+          auto *b = reinterpret_cast<FreeBlock *>(slab + i * STRIDE);
+          b->next = head;
+          head = b;
+        }
+        blocks.fetch_add(ACTOR_POOL_BATCH, std::memory_order_relaxed);
+        return {head, ACTOR_POOL_BATCH};
+      }
+
+      void give(FreeBlock *head, std::size_t count)
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        chains_.emplace_back(head, count);
+        returns.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      PoolStats stats() const noexcept override
+      {
+        PoolStats s;
+        s.hits = hits.load(std::memory_order_relaxed);
+        s.misses = misses.load(std::memory_order_relaxed);
+        s.blocks = blocks.load(std::memory_order_relaxed);
+        s.returns = returns.load(std::memory_order_relaxed);
+        s.block_size = STRIDE;
+        return s;
+      }
+
+      const char *type_name() const noexcept override { return typeid(T).name(); }
+    };
+
+    /**
+     * Per-thread free list for one message type. Blocks freed on this
+     * thread are reused here; when the list grows past two batches one
+     * batch is handed back to the depot for the allocating thread.
+     */
+    template <class T>
+    class PoolCache
+    {
+      FreeBlock *head_ = nullptr;
+      std::size_t count_ = 0;
+      std::uint64_t hits_ = 0;
+      PoolDepot<T> &depot_ = PoolDepot<T>::instance();
+
+      void flush_hits() noexcept
+      {
+        depot_.hits.fetch_add(hits_, std::memory_order_relaxed);
+        hits_ = 0;
+      }
+
+    public:
+      ~PoolCache()
+      {
+        flush_hits();
+        if (head_)
+          depot_.give(head_, count_);
+      }
+
+      void *allocate()
+      {
+        if (!head_) {
+          flush_hits();
+          depot_.misses.fetch_add(1, std::memory_order_relaxed);
+          auto chain = depot_.take();
+          head_ = chain.first;
+          count_ = chain.second;
+        } else {
+          hits_++;
+        }
+        FreeBlock *b = head_;
+        head_ = b->next;
+        count_--;
+        return b;
+      }
+
+      void release(void *p) noexcept
+      {
+        auto *b = static_cast<FreeBlock *>(p);
+        b->next = head_;
+        head_ = b;
+        if (++count_ < 2 * ACTOR_POOL_BATCH)
+          return;
+
+        // Split off one batch and return it to the depot
+        FreeBlock *chain = head_;
+        FreeBlock *tail = head_;
+        for (std::size_t i = 1; i < ACTOR_POOL_BATCH; i++)
+          tail = tail->next;
+        head_ = tail->next;
+        tail->next = nullptr;
+        count_ -= ACTOR_POOL_BATCH;
+        flush_hits();
+        depot_.give(chain, ACTOR_POOL_BATCH);
+      }
+
+      static PoolCache &local()
+      {
+        static thread_local PoolCache cache;
+        return cache;
+      }
+    };
+  }
+
+  /**
+   * Template for message types allocated from a per-type pool
+   *
+   * Drop-in replacement for Message_N<N>: messages are still created with
+   * new and deleted by the receiving actor, but the memory comes from a
+   * thread-local free list instead of the global allocator. Blocks freed
+   * on the receiver's thread flow back to the sender's thread in batches.
+   *
+   * Usage:
+   *   struct MarketUpdate : public actors::PooledMessage_N<MarketUpdate, 120> {
+   *     double price;
+   *     MarketUpdate(double p) : price(p) {}
+   *   };
+   *
+   *   target->send(new MarketUpdate(1.5), this);  // no malloc after warm-up
+   *
+   * Classes derived from a pooled message with a larger size fall back to
+   * the global allocator.
+   */
+  template <class T, int N>
+  struct PooledMessage_N : public Message_N<N>
+  {
+    static void *operator new(std::size_t size)
+    {
+      if (size != sizeof(T))
+        return ::operator new(size);
+      return detail::PoolCache<T>::local().allocate();
+    }
+
+    static void operator delete(void *p, std::size_t size) noexcept
+    {
+      if (!p)
+        return;
+      if (size != sizeof(T)) {
+        ::operator delete(p);
+        return;
+      }
+      detail::PoolCache<T>::local().release(p);
+    }
+
+    /// Counters for this message type's pool
+    static PoolStats pool_stats() noexcept
+    {
+      return detail::PoolDepot<T>::instance().stats();
+    }
+  };
+
+  /**
+   * Counters for every message pool used so far, keyed by type name.
+   * Hits are published in batches, so they may lag by up to
+   * ACTOR_POOL_BATCH allocations per thread.
+   */
+  inline std::map<std::string, PoolStats> message_pool_stats()
+  {
+    std::map<std::string, PoolStats> ret;
+    auto &dir = detail::PoolDirectory::instance();
+    std::lock_guard<std::mutex> lock(dir.mutex);
+    for (auto *pool : dir.pools)
+      ret[pool->type_name()] = pool->stats();
+    return ret;
+  }
+}
@@ -0,0 +1,129 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+#include "actors/ActorId.hpp"
+
+namespace actors
+{
+  /**
+   * ActorCounters - Per-actor counters, safe to read from any thread
+   *
+   * Counters written by the thread running the actor's handlers sit on
+   * one cache line, those bumped by senders on another, so a busy sender
+   * does not slow the receiver down. The handler side is written with a
+   * relaxed load+store (one writer at a time: handlers hold the dispatch
+   * lock), the sender side with relaxed fetch_add.
+   */
+  struct ActorCounters
+  {
+    // Written by the thread running the handlers
+    alignas(64) std::atomic<std::uint64_t> messages{0};  // Handled, including fast_send()
+    std::atomic<std::uint64_t> queue_high_water{0};      // Longest mailbox seen when draining
+
+    // Written by senders
+    alignas(64) std::atomic<std::uint64_t> dropped{0};  // Discarded by a DROP_* limit or a draining Manager
+    std::atomic<std::uint64_t> rejected{0};             // Bounced by a REJECT mailbox limit
+    std::atomic<std::uint64_t> bytes_in{0};             // Wire bytes of messages received remotely
+
+    void count_message() noexcept
+    {
+      messages.store(messages.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void observe_queue(std::uint64_t len) noexcept
+    {
+      if (len > queue_high_water.load(std::memory_order_relaxed))
+        queue_high_water.store(len, std::memory_order_relaxed);
+    }
+  };
+
+  /**
+   * PeerCounts - Approximate top senders to one actor
+   *
+   * Space-Saving over a few slots: a sender not tracked yet takes over
+   * the smallest count, so the heaviest senders stay, with their counts
+   * overestimated by at most the count they took over. Written only by
+   * the thread running the actor's handlers.
+   */
+  struct PeerCounts
+  {
+    static constexpr int SLOTS = 4;
+    std::atomic<ActorId> id[SLOTS]{};
+    std::atomic<std::uint64_t> count[SLOTS]{};
+
+    void record(ActorId from) noexcept
+    {
+      int min = 0;
+      for (int i = 0; i < SLOTS; i++) {
+        if (id[i].load(std::memory_order_relaxed) == from) {
+          bump(i);
+          return;
+        }
+        if (count[i].load(std::memory_order_relaxed) < count[min].load(std::memory_order_relaxed))
+          min = i;
+      }
+      id[min].store(from, std::memory_order_relaxed);
+      bump(min);
+    }
+
+  private:
+    void bump(int i) noexcept
+    {
+      count[i].store(count[i].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+  };
+
+  /// Snapshot of one actor's counters, see Manager::get_metrics()
+  struct ActorMetrics
+  {
+    ActorId id = NO_ACTOR_ID;
+    pid_t tid = 0;
+    std::uint64_t messages = 0;
+    std::uint64_t bytes_in = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t rejected = 0;
+    std::uint64_t conflated = 0;
+    std::uint64_t queue_length = 0;
+    std::uint64_t queue_high_water = 0;
+    double handler_ns = 0;  // Total handler time; 0 unless built with ACTOR_LATENCY
+  };
+}
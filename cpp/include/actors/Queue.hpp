@@ -38,6 +38,8 @@ https://opensource.org/licenses/MIT
 
 #include <tuple>
 #include <cstddef>
+#include <utility>
+#include "actors/Backoff.hpp"
 
 namespace actors
 {
@@ -53,10 +55,92 @@ namespace actors
     Queue(const Queue&) = delete;
     Queue& operator=(const Queue&) = delete;
 
+    // Block until an item is available; bool is true if it was the last one
     virtual std::tuple<T, bool> pop() = 0;
+    // Non-blocking pop; returns false (leaving out untouched) if empty
+    virtual bool try_pop(std::tuple<T, bool>& out) = 0;
+
+    /**
+     * Block until at least one item is available, then move up to max
+     * items into out. last is true if the queue was empty afterwards.
+     * Implementations override this to drain under a single acquisition.
+     * @return Number of items written to out (>= 1)
+     */
+    virtual std::size_t pop_batch(T* out, std::size_t max, bool& last)
+    {
+      auto r = pop();
+      out[0] = std::get<0>(r);
+      last = std::get<1>(r);
+      return last ? 1 : 1 + try_pop_batch(out + 1, max - 1, last);
+    }
+
+    /// Non-blocking pop_batch(); returns 0 if the queue is empty
+    virtual std::size_t try_pop_batch(T* out, std::size_t max, bool& last)
+    {
+      std::size_t n = 0;
+      std::tuple<T, bool> r;
+      while (n < max && try_pop(r)) {
+        out[n++] = std::get<0>(r);
+        last = std::get<1>(r);
+        if (last)
+          break;
+      }
+      return n;
+    }
+
     virtual T peek() const = 0;
     virtual void push(const T& x) = 0;
+
+    /**
+     * Push from a thread that is not the queue's producer, such as the
+     * framework's Start, Shutdown and Timeout. Only single-producer queues
+     * need to do anything else than push().
+     */
+    virtual void push_control(const T& x) { push(x); }
+
     virtual bool is_empty() const = 0;
     virtual std::size_t length() const = 0;
+
+    /// Memory allocated up front (a ring), for prefaulting; empty if none
+    virtual std::pair<void*, std::size_t> storage() noexcept { return {nullptr, 0}; }
+
+    /*
+     * Bounded pushes used for mailbox limits. The defaults check length()
+     * before pushing, so concurrent producers can overshoot limit by one
+     * item each; BQueue overrides them to check and push atomically.
+     */
+
+    /// Push only if fewer than limit items are queued; false if full
+    virtual bool try_push(const T& x, std::size_t limit)
+    {
+      if (length() >= limit)
+        return false;
+      push(x);
+      return true;
+    }
+
+    /// Wait until fewer than limit items are queued, then push
+    virtual void push_wait(const T& x, std::size_t limit)
+    {
+      Backoff backoff;
+      while (length() >= limit)
+        backoff.pause();
+      push(x);
+    }
+
+    /**
+     * Push, evicting the oldest item if limit items are already queued.
+     * Queues that cannot remove items on the producer side evict x itself.
+     * @param queued set to whether x was queued (false when x itself is evicted)
+     * @return true if an item was evicted (it is stored in evicted)
+     */
+    virtual bool push_evict(const T& x, std::size_t limit, T& evicted, bool& queued)
+    {
+      queued = try_push(x, limit);
+      if (queued)
+        return false;
+      evicted = x;
+      return true;
+    }
   };
 }
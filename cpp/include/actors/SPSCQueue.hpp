@@ -0,0 +1,294 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include "actors/Queue.hpp"
+#include "actors/Backoff.hpp"
+#include "actors/Memory.hpp"
+
+namespace actors
+{
+  /**
+   * SPSCQueue - Bounded lock-free single-producer/single-consumer ring
+   *
+   * Exactly one thread may push and exactly one thread may pop.
+   * Producer and consumer indices live on separate cache lines and each
+   * side caches the other's index so the common case touches no shared
+   * line. Capacity is rounded up to a power of two.
+   *
+   * push() spins while the ring is full (there is no overflow area), so
+   * size the ring for the largest burst the actor must absorb. pop()
+   * spins briefly and then parks until a producer publishes.
+   * Use as an actor mailbox only when a single actor sends to it.
+   *
+   * Other threads may still push_control(): those items go through a
+   * locked side channel, each after every ring item pushed before it.
+   * The consumer only looks at the side channel while it is non-empty.
+   */
+  template <class T>
+  class SPSCQueue : public Queue<T>
+  {
+  private:
+    static std::size_t round_up(std::size_t n)
+    {
+      std::size_t cap = 2;
+      while (cap < n)
+        cap <<= 1;
+      return cap;
+    }
+
+    const std::size_t mask_;
+    PageArray<T> buf_;  // on huge pages under MemoryMode::LOCKED
+
+    // Consumer side
+    alignas(64) std::atomic<std::size_t> head_{0};
+    std::size_t tail_cache_ = 0;
+
+    // Producer side
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::size_t head_cache_ = 0;
+
+    alignas(64) Parker parker_;
+
+    // Side channel for push_control(); ticket is the ring tail at the push
+    struct Side
+    {
+      T item;
+      std::size_t ticket;
+    };
+    alignas(64) std::atomic<std::size_t> side_count_{0};
+    mutable std::mutex side_mut_;
+    std::deque<Side> side_;
+
+    // Consumer only; ring items from head due before the oldest side item
+    // (0: take the side item now, SIZE_MAX: the side channel is empty)
+    std::size_t ring_before_side(std::size_t head) const noexcept
+    {
+      if (side_count_.load(std::memory_order_acquire) == 0)
+        return SIZE_MAX;
+      std::lock_guard<std::mutex> lock(side_mut_);
+      std::size_t ticket = side_.front().ticket;
+      return ticket > head ? ticket - head : 0;
+    }
+
+    // Consumer only; the oldest side item is due
+    std::tuple<T, bool> take_side(std::size_t head) noexcept
+    {
+      std::lock_guard<std::mutex> lock(side_mut_);
+      T ret = side_.front().item;
+      side_.pop_front();
+      side_count_.fetch_sub(1, std::memory_order_release);
+      bool last = side_.empty() && head == (tail_cache_ = tail_.load(std::memory_order_acquire));
+      return std::make_tuple(ret, last);
+    }
+
+    // Consumer only; ring empty after head, side channel included
+    bool drained(std::size_t head) noexcept
+    {
+      return head == tail_cache_ &&
+             head == (tail_cache_ = tail_.load(std::memory_order_acquire)) &&
+             side_count_.load(std::memory_order_acquire) == 0;
+    }
+
+    // Consumer only; slot at head is known to be published
+    std::tuple<T, bool> take(std::size_t head) noexcept
+    {
+      T ret = buf_[head & mask_];
+      head_.store(head + 1, std::memory_order_release);
+      return std::make_tuple(ret, drained(head + 1));
+    }
+
+    // Consumer only; wait until the ring or the side channel has an item
+    void park(std::size_t head) noexcept
+    {
+      parker_.park_until([this, head]() {
+        return (tail_cache_ = tail_.load(std::memory_order_acquire)) != head ||
+               side_count_.load(std::memory_order_acquire) != 0;
+      });
+    }
+
+    // Consumer only; true (refreshing the cache) if the ring has an item at head
+    bool ring_ready(std::size_t head) noexcept
+    {
+      return head != tail_cache_ || head != (tail_cache_ = tail_.load(std::memory_order_acquire));
+    }
+
+    // Consumer only; at least one slot from head is published
+    std::size_t take_batch(std::size_t head, T* out, std::size_t max, bool& last) noexcept
+    {
+      std::size_t n = tail_cache_ - head;
+      if (n > max)
+        n = max;
+      for (std::size_t i = 0; i < n; i++)
+        out[i] = buf_[(head + i) & mask_];
+      head_.store(head + n, std::memory_order_release);
+
+      last = drained(head + n);
+      return n;
+    }
+
+    // Consumer only; one side item as a batch
+    std::size_t take_side_batch(std::size_t head, T* out, bool& last) noexcept
+    {
+      auto r = take_side(head);
+      out[0] = std::get<0>(r);
+      last = std::get<1>(r);
+      return 1;
+    }
+
+  public:
+    explicit SPSCQueue(std::size_t n)
+      : mask_(round_up(n) - 1), buf_(mask_ + 1) {}
+
+    std::size_t capacity() const noexcept { return mask_ + 1; }
+
+    std::pair<void*, std::size_t> storage() noexcept override { return {buf_.data(), buf_.bytes()}; }
+
+    std::tuple<T, bool> pop() noexcept override
+    {
+      const std::size_t head = head_.load(std::memory_order_relaxed);
+      for (;;) {
+        if (ring_before_side(head) == 0)
+          return take_side(head);
+        if (ring_ready(head))
+          return take(head);
+        park(head);
+      }
+    }
+
+    bool try_pop(std::tuple<T, bool>& out) noexcept override
+    {
+      const std::size_t head = head_.load(std::memory_order_relaxed);
+      if (ring_before_side(head) == 0) {
+        out = take_side(head);
+        return true;
+      }
+      if (!ring_ready(head))
+        return false;
+      out = take(head);
+      return true;
+    }
+
+    std::size_t pop_batch(T* out, std::size_t max, bool& last) noexcept override
+    {
+      const std::size_t head = head_.load(std::memory_order_relaxed);
+      for (;;) {
+        std::size_t ring = ring_before_side(head);
+        if (ring == 0)
+          return take_side_batch(head, out, last);
+        if (ring_ready(head))
+          return take_batch(head, out, max < ring ? max : ring, last);
+        park(head);
+      }
+    }
+
+    std::size_t try_pop_batch(T* out, std::size_t max, bool& last) noexcept override
+    {
+      const std::size_t head = head_.load(std::memory_order_relaxed);
+      if (max == 0)
+        return 0;
+      std::size_t ring = ring_before_side(head);
+      if (ring == 0)
+        return take_side_batch(head, out, last);
+      if (!ring_ready(head))
+        return 0;
+      return take_batch(head, out, max < ring ? max : ring, last);
+    }
+
+    T peek() const noexcept override
+    {
+      const std::size_t head = head_.load(std::memory_order_relaxed);
+      if (ring_before_side(head) == 0) {
+        std::lock_guard<std::mutex> lock(side_mut_);
+        return side_.front().item;
+      }
+      if (head == tail_.load(std::memory_order_acquire)) {
+        if constexpr (std::is_pointer<T>::value)
+          return nullptr;
+        else
+          return T{};
+      }
+      return buf_[head & mask_];
+    }
+
+    void push(const T& x) noexcept override
+    {
+      const std::size_t tail = tail_.load(std::memory_order_relaxed);
+      if (tail - head_cache_ > mask_) {
+        Backoff backoff;
+        while (tail - (head_cache_ = head_.load(std::memory_order_acquire)) > mask_)
+          backoff.pause();
+      }
+
+      buf_[tail & mask_] = x;
+      tail_.store(tail + 1, std::memory_order_release);
+      parker_.unpark();
+    }
+
+    /// Any thread; delivered after every item push() has already published
+    void push_control(const T& x) noexcept override
+    {
+      {
+        std::lock_guard<std::mutex> lock(side_mut_);
+        side_.push_back({x, tail_.load(std::memory_order_acquire)});
+        side_count_.fetch_add(1, std::memory_order_release);
+      }
+      parker_.unpark();
+    }
+
+    bool is_empty() const noexcept override
+    {
+      return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire) &&
+             side_count_.load(std::memory_order_acquire) == 0;
+    }
+
+    std::size_t length() const noexcept override
+    {
+      const std::size_t tail = tail_.load(std::memory_order_acquire);
+      const std::size_t head = head_.load(std::memory_order_acquire);
+      return tail - head + side_count_.load(std::memory_order_acquire);
+    }
+  };
+}
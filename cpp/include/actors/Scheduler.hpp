@@ -0,0 +1,139 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#define ACTOR_POOL_SLICE 64
+#define ACTOR_POOL_SPIN 2000
+
+namespace actors
+{
+  class Actor;
+
+  /**
+   * Scheduler - Work-stealing pool that runs many actors on a few threads
+   *
+   * An actor added to the pool has no thread of its own. Sending it a
+   * message marks it runnable and puts it on a worker's run queue; a
+   * worker then drains up to ACTOR_POOL_SLICE messages and moves on, so
+   * one busy actor cannot starve the rest. Idle workers steal runnable
+   * actors from the others, spin briefly, then sleep.
+   *
+   * An actor is on at most one run queue and is run by at most one worker
+   * at a time, so its handlers still execute strictly one after another.
+   *
+   * Usually driven by Manager (set_scheduler / manage_pooled).
+   */
+  class Scheduler
+  {
+  public:
+    /**
+     * @param workers Number of worker threads (0 = one per online CPU)
+     * @param affinity Cores for the workers; worker i is pinned to the
+     *                 i-th core, wrapping around (empty = no pinning)
+     */
+    explicit Scheduler(std::size_t workers, std::set<int> affinity = {});
+    ~Scheduler();
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    /// Hand an actor to the pool; must be called before start()
+    void add(Actor *actor);
+
+    /// Run init() of every pooled actor, then launch the workers
+    void start();
+
+    /// Block until every pooled actor has processed Shutdown, then stop the workers
+    void join();
+
+    /// Stop the workers without waiting for the actors
+    void stop() noexcept;
+
+    std::size_t worker_count() const noexcept { return queues_.size(); }
+    std::size_t actor_count() const noexcept { return actors_.size(); }
+
+    /// Number of times a worker took an actor from another worker's queue
+    std::size_t steal_count() const noexcept { return steals_.load(std::memory_order_relaxed); }
+
+    /// Producer side: make the actor runnable after a push to its mailbox
+    void notify(Actor *actor) noexcept;
+
+  private:
+    struct alignas(64) RunQueue
+    {
+      std::mutex mut;
+      std::deque<Actor *> q;
+      std::atomic<std::size_t> size{0};  // lets thieves skip empty queues without locking
+    };
+
+    std::vector<std::unique_ptr<RunQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::vector<Actor *> actors_;
+    std::set<int> affinity_;
+
+    alignas(64) std::atomic<std::size_t> pending_{0};  // actors sitting on run queues
+    alignas(64) std::atomic<int> sleepers_{0};
+    std::atomic<bool> stopping_{false};
+    std::atomic<std::size_t> next_queue_{0};
+    std::atomic<std::size_t> steals_{0};
+    std::mutex sleep_mut_;
+    std::condition_variable sleep_cv_;
+
+    std::atomic<std::size_t> live_{0};  // pooled actors not yet shut down
+    std::mutex done_mut_;
+    std::condition_variable done_cv_;
+
+    inline static thread_local Scheduler *current_ = nullptr;
+    inline static thread_local std::size_t current_index_ = 0;
+
+    void submit(Actor *actor) noexcept;
+    Actor *next(std::size_t index) noexcept;
+    void run(Actor *actor) noexcept;
+    void retire() noexcept;
+    void worker_loop(std::size_t index) noexcept;
+  };
+}
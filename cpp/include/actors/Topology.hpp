@@ -0,0 +1,137 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "actors/ActorId.hpp"
+
+namespace actors
+{
+  /// One online CPU and where it sits
+  struct CpuInfo
+  {
+    int cpu = 0;
+    int core = 0;     // Physical core; hyperthread siblings share it
+    int package = 0;  // Socket
+    int node = 0;     // NUMA node
+  };
+
+  /**
+   * Topology - Online CPUs with their core, socket and NUMA node
+   *
+   * system() reads /sys/devices/system once. A machine without NUMA
+   * information reports every CPU on node 0.
+   */
+  class Topology
+  {
+  public:
+    explicit Topology(std::vector<CpuInfo> cpus);
+
+    /// Topology of this machine, discovered on first use
+    static const Topology &system();
+    /// Read a sysfs tree rooted at root (e.g. a copy of /sys/devices/system)
+    static Topology discover(const std::string &root = "/sys/devices/system");
+
+    /// Online CPUs ordered by node, socket, core, then CPU number
+    const std::vector<CpuInfo> &cpus() const noexcept { return cpus_; }
+    const CpuInfo *find(int cpu) const noexcept;
+    int node_count() const noexcept { return nodes_; }
+
+    /// NUMA node of a CPU, -1 if it is not online
+    int node_of(int cpu) const noexcept;
+    /// Node shared by every CPU in cpus, -1 if they span nodes (or cpus is empty)
+    int node_of(const std::set<int> &cpus) const noexcept;
+
+    /**
+     * How far apart two CPUs are: 0 same CPU, 1 hyperthread siblings,
+     * 2 same socket, 3 same node, 4 different nodes
+     */
+    int distance(int a, int b) const noexcept;
+
+  private:
+    std::vector<CpuInfo> cpus_;
+    std::vector<int> by_cpu_;  // CPU number -> index in cpus_, -1 if offline
+    int nodes_ = 1;
+  };
+
+  /**
+   * Prefer node for the calling thread's new memory while in scope, then
+   * restore its previous policy (set_mempolicy(2)). Only pages faulted in
+   * meanwhile move: memory the allocator already holds stays where it is.
+   * A no-op for node < 0 or where the kernel refuses.
+   */
+  class PreferNode
+  {
+  public:
+    explicit PreferNode(int node) noexcept;
+    ~PreferNode();
+    PreferNode(const PreferNode &) = delete;
+    PreferNode &operator=(const PreferNode &) = delete;
+
+    /// False if the policy could not be set
+    bool active() const noexcept { return active_; }
+
+  private:
+    bool active_ = false;
+    int old_mode_ = 0;
+    unsigned long old_mask_[16] = {};
+  };
+
+  /// Messages from one actor to another, e.g. from Manager::get_traffic()
+  struct Traffic
+  {
+    ActorId from;
+    ActorId to;
+    std::uint64_t messages;
+  };
+
+  /**
+   * Assign each of actors a CPU from cpus, heaviest-talking pairs first:
+   * the two ends of a pair go on hyperthread siblings if free, else as
+   * close as topology allows (same socket, then same node). Actors with
+   * no traffic take the CPUs left over. With more actors than CPUs the
+   * CPUs are reused in order.
+   * @return CPU per actor, in the order of actors
+   */
+  std::vector<int> place_by_traffic(const Topology &topo, const std::vector<int> &cpus,
+                                    const std::vector<ActorId> &actors,
+                                    std::vector<Traffic> traffic);
+}
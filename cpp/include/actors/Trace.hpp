@@ -0,0 +1,194 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include "actors/ActorId.hpp"
+#include "actors/Latency.hpp"
+
+/*
+ * Event tracing is compiled into the runtime only with -DACTOR_TRACE
+ * (make TRACE=1); without it Actor records nothing and this header only
+ * serves code that records its own events. Like ACTOR_LATENCY the flag
+ * changes Delivery, so build the library and the application alike.
+ */
+
+// Events kept per thread (power of two); older ones are overwritten
+#ifndef ACTOR_TRACE_EVENTS
+#define ACTOR_TRACE_EVENTS 16384
+#endif
+
+static_assert((ACTOR_TRACE_EVENTS & (ACTOR_TRACE_EVENTS - 1)) == 0,
+              "ACTOR_TRACE_EVENTS must be a power of two");
+
+namespace actors
+{
+  namespace trace
+  {
+    enum class Kind : std::uint8_t
+    {
+      ENQUEUE,       // Actor::send() queued the message
+      DEQUEUE,       // the receiver took it off its mailbox
+      HANDLER_BEGIN,
+      HANDLER_END,
+    };
+
+    /// One 32-byte binary event; converted to text only when dumped
+    struct Event
+    {
+      std::uint64_t tsc;   // read_tsc()
+      std::uint64_t flow;  // Links ENQUEUE to HANDLER_BEGIN of a message; 0 for none
+      std::int32_t msg_id;
+      ActorId from;
+      ActorId to;
+      Kind kind;
+    };
+
+    /**
+     * Ring - Events recorded by one thread
+     *
+     * Only the owning thread writes; head_ is published with a release
+     * store so a dumper can copy the ring while it is being written and
+     * then discard whatever was overwritten during the copy.
+     */
+    class Ring
+    {
+    public:
+      static constexpr std::size_t SIZE = ACTOR_TRACE_EVENTS;
+
+      Ring(std::uint32_t index, pid_t tid) : index_(index), tid_(tid) {}
+
+      void record(Kind kind, std::int32_t msg_id, ActorId from, ActorId to,
+                  std::uint64_t flow) noexcept
+      {
+        std::uint64_t h = head_.load(std::memory_order_relaxed);
+        events_[h & (SIZE - 1)] = Event{read_tsc(), flow, msg_id, from, to, kind};
+        head_.store(h + 1, std::memory_order_release);
+      }
+
+      /// Flow ID unique across all rings
+      std::uint64_t next_flow() noexcept
+      {
+        return (std::uint64_t(index_) << 40) | ++flows_;
+      }
+
+      /// Copy out the events still held, oldest first
+      std::vector<Event> snapshot() const;
+
+      pid_t tid() const noexcept { return tid_; }
+      std::uint64_t recorded() const noexcept { return head_.load(std::memory_order_acquire); }
+
+      /// Forget what is recorded so far; the owner never writes floor_
+      void clear() noexcept { floor_.store(recorded(), std::memory_order_relaxed); }
+
+    private:
+      Event events_[SIZE];
+      std::atomic<std::uint64_t> head_{0};
+      std::atomic<std::uint64_t> floor_{0};
+      std::uint64_t flows_ = 0;
+      const std::uint32_t index_;
+      const pid_t tid_;
+    };
+
+    /// Runtime switch; off until enable(true), so a TRACE=1 build costs one load per event
+    inline std::atomic<bool> active{false};
+    inline thread_local Ring *current_ring = nullptr;
+
+    /// Ring of the calling thread, created and registered on first use
+    Ring *attach() noexcept;
+
+    inline Ring *ring() noexcept
+    {
+      Ring *r = current_ring;
+      return r ? r : attach();
+    }
+
+    inline bool enabled() noexcept { return active.load(std::memory_order_relaxed); }
+    void enable(bool on = true) noexcept;
+
+    inline void record(Kind kind, std::int32_t msg_id, ActorId from, ActorId to,
+                       std::uint64_t flow = 0) noexcept
+    {
+      if (enabled())
+        ring()->record(kind, msg_id, from, to, flow);
+    }
+
+    /// New flow ID from the calling thread's ring, 0 while tracing is off
+    inline std::uint64_t new_flow() noexcept
+    {
+      return enabled() ? ring()->next_flow() : 0;
+    }
+
+    /// Name shown for an actor ID in dumps; Manager::manage() fills this in
+    void name_actor(ActorId id, const std::string &name);
+
+    /// Events of one thread, oldest first
+    struct ThreadEvents
+    {
+      pid_t tid;
+      std::vector<Event> events;
+    };
+
+    /// Copy every thread's ring; safe while other threads keep recording
+    std::vector<ThreadEvents> snapshot();
+
+    /// Drop all recorded events (rings stay registered)
+    void clear() noexcept;
+
+    /**
+     * Write a Chrome trace event JSON file, readable by ui.perfetto.dev
+     * and chrome://tracing: one track per thread, a slice per handler
+     * call, instants for enqueue/dequeue and a flow arrow from each send
+     * to the handler that ran it.
+     * @return false if the file could not be written
+     */
+    bool write_chrome_json(const std::string &path);
+
+    /**
+     * Dump to path whenever the process receives signo (e.g. SIGUSR2).
+     * The handler only writes a byte to a pipe; a background thread
+     * takes the snapshot and writes the file. Call once per process.
+     * @return false if the pipe, thread or handler could not be set up
+     */
+    bool dump_on_signal(int signo, const std::string &path);
+  }
+}
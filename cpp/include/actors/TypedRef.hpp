@@ -0,0 +1,130 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <cassert>
+#include <type_traits>
+#include "actors/Actor.hpp"
+#include "actors/ActorRef.hpp"
+
+namespace actors {
+
+/**
+ * TypedRef<Msgs...> - Reference to a local actor that handles Msgs
+ *
+ * One pointer, trivially copyable, so it costs nothing to keep in every
+ * message or subscriber list. send() only compiles for one of Msgs and
+ * goes straight to the actor's send(), with no variant to visit. Every
+ * one of Msgs needs a static ID (Message_N), and binding to an actor
+ * without a handler for one of them fails an assert; a Router, which
+ * only forwards, can't be bound.
+ *
+ * For actors that may live in another process, keep using ActorRef.
+ *
+ * Usage:
+ *   TypedRef<Order, Cancel> book(book_actor);
+ *   book.send(new Order{...}, this);   // OK
+ *   book.send(new Quote{...}, this);   // Does not compile
+ *
+ *   TypedRef<Cancel> canceller = book;  // Narrowing to fewer types is free
+ */
+template <class... Msgs>
+class TypedRef {
+    static_assert(sizeof...(Msgs) > 0, "TypedRef needs at least one message type");
+    static_assert((std::is_base_of_v<Message, Msgs> && ...), "TypedRef types must be messages");
+
+    Actor* actor_ = nullptr;
+
+    template <class... Other>
+    friend class TypedRef;
+
+public:
+    /// True if M is one of the message types this ref accepts
+    template <class M>
+    static constexpr bool accepts = (std::is_same_v<std::remove_cv_t<M>, Msgs> || ...);
+
+    TypedRef() = default;
+
+    explicit TypedRef(Actor* a) : actor_(a) {
+        assert((!a || (a->id_handlers.count(Msgs::message_id) && ...)) &&
+               "actor has no handler for a TypedRef message type");
+    }
+
+    // Narrow a ref that accepts at least these types
+    template <class... Other>
+        requires (TypedRef<Other...>::template accepts<Msgs> && ...)
+    TypedRef(const TypedRef<Other...>& other) : actor_(other.actor_) {}
+
+    /**
+     * Send a message asynchronously, as Actor::send()
+     * @param m Message to send (heap-allocated, ownership passes to the actor)
+     * @param sender The sending actor (for reply routing)
+     */
+    template <class M>
+    void send(const M* m, Actor* sender = nullptr) const noexcept {
+        static_assert(accepts<M>, "message type not accepted by this TypedRef");
+        actor_->send(m, sender);
+    }
+
+    /// send() in a given lane (see Actor::send_lane)
+    template <class M>
+    void send(const M* m, Lane lane, Actor* sender = nullptr) const noexcept {
+        static_assert(accepts<M>, "message type not accepted by this TypedRef");
+        actor_->send_lane(m, lane, sender);
+    }
+
+    /// Send synchronously and return the reply (see Actor::fast_send)
+    template <class M>
+    std::unique_ptr<const Message> fast_send(const M* m, Actor* sender) const noexcept {
+        static_assert(accepts<M>, "message type not accepted by this TypedRef");
+        return actor_->fast_send(m, sender);
+    }
+
+    bool is_valid() const { return actor_ != nullptr; }
+    explicit operator bool() const { return is_valid(); }
+
+    Actor* actor() const { return actor_; }
+    const char* name() const { return actor_->get_name(); }
+    ActorId id() const { return actor_ ? actor_->get_id() : NO_ACTOR_ID; }
+
+    /// Location-transparent ref to the same actor
+    ActorRef ref() const { return ActorRef(actor_); }
+
+    bool operator==(const TypedRef& other) const = default;
+};
+
+} // namespace actors
@@ -0,0 +1,197 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+#include "actors/Actor.hpp"
+#include "actors/Journal.hpp"
+#include "actors/msg/Shutdown.hpp"
+#include "actors/msg/Start.hpp"
+
+namespace actors
+{
+  /**
+   * Group - Several actors sharing one thread and one mailbox
+   *
+   * Messages sent to a member are queued in the group's mailbox and run
+   * by the member's own handlers on the group's thread. A member sending
+   * to another member from one of its handlers doesn't touch the mailbox
+   * or wake anyone: the message is queued locally and runs right after the
+   * handler returns, before the group takes its next mailbox message. A
+   * loop of members that keep sending to each other never yields to the
+   * mailbox, so keep intra-group exchanges finite.
+   *
+   * Members keep their names (Manager::get_local_actor() and the registry
+   * find them), handlers and ActorIds; the Manager runs only the group.
+   * Mailbox, wait and affinity settings apply to the group, not to its
+   * members. Shutdown sent to a member stops that member; Shutdown sent
+   * to the group stops every member, then the group.
+   *
+   * Usage:
+   *   actors::Group grp("pipeline");
+   *   grp.add(new Parser());
+   *   grp.add(new Normalizer());
+   *   grp.add(new BookBuilder());
+   *   mgr.manage(&grp, {2});  // All three share one thread on core 2
+   */
+  class Group : public Actor
+  {
+    friend class Actor;
+
+    std::vector<Actor *> members_;
+    std::deque<Delivery> local_;  // Sent between members while the group runs them
+
+    // Group running a member's handler on this thread, if any
+    static inline thread_local Group *delivering_ = nullptr;
+
+  public:
+    explicit Group(const char *group_name)
+    {
+      strncpy(name, group_name, sizeof(name) - 1);
+      name[sizeof(name) - 1] = '\0';
+      dispatch_mode = DispatchMode::ASYNC_ONLY;  // Everything, Start included, arrives by the mailbox
+      MESSAGE_HANDLER(msg::Start, on_start);
+      MESSAGE_HANDLER(msg::Shutdown, on_shutdown);
+    }
+
+    ~Group() override
+    {
+      for (auto &d : local_)
+        d.msg->release();
+    }
+
+    /**
+     * Add a member. Call before passing the group to Manager::manage().
+     * The member must not be managed on its own or belong to another group.
+     */
+    void add(Actor *member)
+    {
+      assert(member != nullptr && "cannot add null actor");
+      assert(!member->is_managed && member->group == nullptr && "actor already managed");
+      assert(!is_managed && "add members before managing the group");
+      member->group = this;
+      members_.push_back(member);
+    }
+
+    const std::vector<Actor *> &members() const noexcept { return members_; }
+
+  protected:
+    void init() override
+    {
+      for (auto *member : members_) {
+        member->running.store(true, std::memory_order_relaxed);
+        member->tid = tid;
+        member->seal_handlers();
+        member->init();
+      }
+    }
+
+    void end() override
+    {
+      for (auto *member : members_)
+        if (!member->terminated)
+          stop(member);
+    }
+
+  private:
+    // Actor::send() to a member
+    void post(const Delivery &d)
+    {
+      if (delivering_ == this)
+        local_.push_back(d);  // From a member's handler on our thread
+      else
+        add_message_to_queue(d);
+    }
+
+    // Actor::process_batch() for a mailbox message addressed to a member
+    void deliver(const Delivery &d) noexcept
+    {
+      Group *outer = delivering_;
+      delivering_ = this;
+      run(d);
+      while (!local_.empty()) {
+        Delivery next = local_.front();
+        local_.pop_front();
+        run(next);
+      }
+      delivering_ = outer;
+    }
+
+    void run(const Delivery &d) noexcept
+    {
+      Actor *to = d.to;
+      if (to->terminated) {
+        d.msg->release();
+        return;
+      }
+      bool is_shutdown = d.msg->id() == msg::Shutdown::message_id;
+      if (to->journal_)
+        to->journal_->append(d.msg);
+      to->reply_to = d.sender;
+      to->process_message_internal(d);
+      if (is_shutdown)
+        stop(to);
+    }
+
+    void stop(Actor *member) noexcept
+    {
+      member->terminated = true;
+      member->end();
+    }
+
+    void on_start(const msg::Start *) noexcept
+    {
+      for (auto *member : members_)
+        deliver(Delivery{new msg::Start(), nullptr, member});  // as if from the mailbox
+    }
+
+    void on_shutdown(const msg::Shutdown *) noexcept
+    {
+      for (auto *member : members_) {
+        if (member->terminated)
+          continue;
+        member->reply_to = nullptr;
+        member->process_message_internal(Delivery{new msg::Shutdown(), nullptr, member});
+        stop(member);
+      }
+    }
+  };
+}
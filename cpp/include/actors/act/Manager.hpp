@@ -36,15 +36,37 @@ https://opensource.org/licenses/MIT
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <thread>
 
 #include "actors/Actor.hpp"
 #include "actors/ActorRef.hpp"
+#include "actors/Memory.hpp"
+#include "actors/MessagePool.hpp"
+#include "actors/Scheduler.hpp"
+#include "actors/Topology.hpp"
+
+// Longest shutdown() waits for mailboxes to empty before discarding the rest
+#ifndef ACTOR_DRAIN_TIMEOUT_MS
+#define ACTOR_DRAIN_TIMEOUT_MS 5000
+#endif
+
+// Longest init() waits for every actor to handle Start
+#ifndef ACTOR_START_TIMEOUT_MS
+#define ACTOR_START_TIMEOUT_MS 10000
+#endif
+
+// How often shutdown() looks at the mailboxes while draining
+#ifndef ACTOR_DRAIN_POLL_US
+#define ACTOR_DRAIN_POLL_US 200
+#endif
 
 // Forward declarations
 namespace actors::registry {
@@ -56,6 +78,63 @@ namespace actors
 
 class ZmqSender;
 class ZmqReceiver;
+class ShmRing;
+
+  /**
+   * How Manager places actors (see Manager::set_placement)
+   *
+   * MANUAL - affinity exactly as given to manage() (default)
+   * NUMA   - each mailbox is allocated on the NUMA node of its actor's
+   *          pinned CPUs, and senders are counted so colocate() can pin
+   *          the actors managed without affinity next to their peers
+   */
+  enum class Placement
+  {
+    MANUAL,
+    NUMA,
+  };
+
+  /**
+   * How Manager::init() prepares memory (see Manager::set_memory_mode)
+   *
+   * DEFAULT - pages are faulted in on first touch
+   * LOCKED  - mailbox rings and message pool slabs go on huge pages, and
+   *           init() locks the process in RAM (mlockall), then prefaults
+   *           every ring, a message pool chunk and the first
+   *           ACTOR_PREFAULT_STACK_BYTES of each actor thread's stack
+   */
+  enum class MemoryMode
+  {
+    DEFAULT,
+    LOCKED,
+  };
+
+  /**
+   * What init() locked and prefaulted under MemoryMode::LOCKED
+   */
+  struct MemoryReport
+  {
+    bool locked = false;            // mlockall(MCL_CURRENT | MCL_FUTURE) succeeded
+    int lock_error = 0;             // errno from mlockall when it failed
+    std::size_t locked_bytes = 0;   // VmLck once every thread was ready
+    std::size_t stack_bytes = 0;    // Prefaulted, summed over actor threads
+    std::size_t mailbox_bytes = 0;  // Prefaulted mailbox rings
+    std::size_t pool_bytes = 0;     // Prefaulted message pool chunk
+    std::size_t huge_bytes = 0;     // Mapped for huge pages: rings and pool chunks
+  };
+
+  /**
+   * How long the phases of Manager::init() and Manager::shutdown() took
+   */
+  struct LifecycleReport
+  {
+    std::chrono::nanoseconds ready{0};  // Threads launched until all were past Actor::init()
+    std::chrono::nanoseconds start{0};  // Start fanned out until every actor had handled it
+    std::chrono::nanoseconds drain{0};  // Until the mailboxes stayed empty, or the deadline
+    std::chrono::nanoseconds join{0};   // Shutdown sent until every thread had exited
+    bool drained = false;               // Emptied before the deadline
+    std::size_t discarded = 0;          // Messages still queued at the deadline
+  };
 
   /**
    * Manager - Manages the lifecycle of actors
@@ -72,6 +151,11 @@ class ZmqReceiver;
    *     MyManager() {
    *       set_registry("tcp://localhost:5555");  // Connect to GlobalRegistry
    *       manage(new MyActor(), {0}, 50, SCHED_FIFO);  // Pin to CPU 0
+   *       manage(new FastActor(), {1}, 50, SCHED_FIFO,  // Busy-poll a lock-free mailbox
+   *              MailboxType::MPSC, 0, WaitStrategy::SPIN);
+   *       set_scheduler(4, {2, 3, 4, 5});             // 4 pool workers on cores 2-5
+   *       for (auto* book : books)
+   *         manage_pooled(book);                      // Shares the pool, no own thread
    *     }
    *   };
    *
@@ -83,18 +167,81 @@ class ZmqReceiver;
    *   ref.send(new MyMessage{}, this);
    *
    *   mgr.end();   // Wait for actors to finish
+   *
+   * Lifecycle: init() starts every thread and holds it after Actor::init()
+   * until all are ready. Start then goes into every mailbox, behind any
+   * messages sent from Actor::init() (PRIORITY mailboxes take it first),
+   * and init() returns once each actor has handled it. terminate(), from any
+   * thread, makes end() run shutdown(). shutdown() drains: managed actors
+   * still message each other, but sends from elsewhere (timers, the main
+   * thread, remote peers) are refused and ingress actors get on_drain().
+   * When the mailboxes stay empty, or at the deadline when anything still
+   * queued is discarded, every actor gets Shutdown and is joined.
+   *
+   * run_deterministic() replaces init() for benchmarks and simulations:
+   * no actor gets a thread; the caller steps every mailbox in manage()
+   * order and timers run on a virtual clock.
    */
   class Manager : public Actor
   {
+    friend class Actor;  // reports watermarks
+
     std::list<actor_ptr> actor_list;
     std::list<std::thread*> thread_list;
     std::map<std::string, actor_ptr> managed_name_map;
     std::map<std::string, actor_ptr> expanded_name_map;
+    IdTable<Actor> id_table_;  // ActorId -> actor, lock-free reads
+    ActorId last_id_ = NO_ACTOR_ID;
+    std::unique_ptr<Scheduler> scheduler_;
 
     // Registry support
     std::unique_ptr<registry::RegistryClient> registry_client_;
     std::shared_ptr<ZmqSender> zmq_sender_;
     std::string local_endpoint_;
+    bool started_ = false;  // init() ran; later manage() calls register one by one
+
+    Placement placement_ = Placement::MANUAL;
+    std::set<actor_ptr> auto_placed_;  // Managed without affinity under Placement::NUMA
+
+    // Lifecycle (see init() and shutdown()), guarded by life_mut_
+    std::mutex life_mut_;
+    std::condition_variable life_cv_;
+    bool starting_ = false;            // Threads wait in actor_ready() while set
+    std::size_t ready_ = 0;
+    std::set<Actor*> awaiting_start_;
+    std::size_t running_ = 0;          // Actors started and not yet stopped
+    bool stop_requested_ = false;
+    bool stopping_ = false;
+    std::chrono::milliseconds drain_timeout_{ACTOR_DRAIN_TIMEOUT_MS};
+    LifecycleReport lifecycle_;
+    bool deterministic_ = false;       // run_deterministic() steps the actors, no threads
+    MemoryMode memory_mode_ = MemoryMode::DEFAULT;
+    MemoryReport memory_;              // stack_bytes guarded by life_mut_ during init()
+
+    // Called by Actor on its own thread
+    void actor_ready();
+    void actor_started(Actor* actor);
+    void actor_stopped(Actor* actor);
+    bool wait_drained(std::chrono::steady_clock::time_point deadline) const;
+    void join_all();
+    bool stop_requested();
+    std::uint64_t handled_total() const noexcept;
+
+    // Deterministic mode, on the caller's thread
+    bool step_all() noexcept;
+    bool step_drained(std::chrono::steady_clock::time_point deadline) noexcept;
+
+    // MemoryMode::LOCKED, from init() before the threads start
+    void lock_memory();
+
+    // Register every managed actor with GlobalRegistry in one RegisterActors
+    void register_all();
+
+    // Same-host shared-memory rings opened by get_actor_by_name(), by endpoint,
+    // guarded by shm_mut_
+    bool shm_transport_ = true;
+    std::mutex shm_mut_;
+    std::map<std::string, std::shared_ptr<ShmRing>> shm_rings_;
 
   protected:
     Manager();
@@ -103,6 +250,18 @@ class ZmqReceiver;
     /// Handle internal messages (Start, Shutdown)
     void process_message(const Message* m) override;
 
+    /**
+     * Called when an actor's mailbox reaches its high watermark (high = true)
+     * and again when it drains back to its low watermark (high = false).
+     * See Actor::set_mailbox_limit(). Runs on the thread that crossed the
+     * mark - a sender for high, the actor itself for low - so keep it short
+     * and never block. Override to throttle producers.
+     */
+    virtual void on_mailbox_watermark(Actor* actor, std::size_t length, bool high) noexcept
+    {
+      (void)actor; (void)length; (void)high;
+    }
+
   public:
     /**
      * Start all managed actors
@@ -113,25 +272,148 @@ class ZmqReceiver;
 
     /**
      * Wait for all actors to finish
-     * Blocks until all actor threads have terminated.
+     * Blocks until all actor threads have terminated, or until terminate()
+     * is called and then runs shutdown().
      */
     void end();
 
+    /**
+     * Drain and stop every actor, then join their threads (see the class
+     * comment). Call from outside the actors; from an actor use terminate().
+     * @param deadline Longest wait for the mailboxes to empty
+     */
+    void shutdown(std::chrono::milliseconds deadline);
+    void shutdown() { shutdown(drain_timeout_); }
+
+    /// Ask end() to shut down; safe to call from any thread, returns at once
+    void terminate() noexcept override;
+
+    /**
+     * Run every managed actor on the calling thread instead of calling
+     * init(). The first call runs each Actor::init() and sends Start, in
+     * manage() order like everything else here. Then each pass hands every
+     * actor with mail up to ACTOR_POOL_SLICE messages; when a pass finds
+     * all mailboxes empty, TimerWheel's virtual clock jumps to the next
+     * timer (see TimerWheel::set_virtual()). Returns when nothing is
+     * queued and no timer falls within horizon, or once terminate() was
+     * called. Call it again after sending more messages; end() runs it one
+     * last time and then shutdown().
+     *
+     * With a single thread a given input always gives the same order of
+     * handler calls, and nothing waits on the wall clock. Actors must not
+     * block: a full OverflowPolicy::BLOCK mailbox waits forever, and
+     * transports with threads of their own (ZMQ, shared memory) keep
+     * delivering from them.
+     * @param horizon Virtual time this call may move the clock forward
+     * @return Messages handled during the call
+     */
+    std::size_t run_deterministic(std::chrono::nanoseconds horizon = std::chrono::nanoseconds::max());
+    bool deterministic() const noexcept { return deterministic_; }
+
+    /// Drain deadline used by terminate() (default ACTOR_DRAIN_TIMEOUT_MS)
+    void set_drain_timeout(std::chrono::milliseconds timeout) noexcept { drain_timeout_ = timeout; }
+
+    /// Phase timings of the last init() and shutdown()
+    const LifecycleReport& lifecycle() const noexcept { return lifecycle_; }
+
+    /**
+     * Choose how init() prepares memory (default DEFAULT). Call before
+     * managing the actors: rings and pool slabs allocated earlier stay on
+     * normal pages. Huge pages are a process-wide setting, and each ring
+     * then takes at least one. Locking needs CAP_IPC_LOCK or an
+     * RLIMIT_MEMLOCK covering the whole process, thread stacks included;
+     * without it init() still prefaults and reports lock_error. shutdown()
+     * unlocks once the threads are joined.
+     */
+    void set_memory_mode(MemoryMode mode) noexcept
+    {
+      memory_mode_ = mode;
+      memory::set_huge_pages(mode == MemoryMode::LOCKED);
+    }
+    MemoryMode memory_mode() const noexcept { return memory_mode_; }
+
+    /// What the last init() locked and prefaulted under MemoryMode::LOCKED
+    const MemoryReport& memory_report() const noexcept { return memory_; }
+
     /**
      * Register an actor to be managed
+     * Assigns the actor its ActorId (see get_id()). For a Group, its
+     * members get names and IDs too but run on the group's thread. A
+     * Router's unmanaged workers are managed with the affinity given to
+     * Router::add().
      * @param actor The actor to manage (takes ownership)
      * @param affinity Set of CPU cores to pin the actor to (empty = no pinning)
      * @param priority Thread priority 1-99 (requires CAP_SYS_NICE, 0 = default)
      * @param priority_type SCHED_OTHER (default), SCHED_FIFO, or SCHED_RR
+     * @param mailbox Mailbox implementation (BLOCKING, SPSC, MPSC, CONFLATING or PRIORITY).
+     *        SPSC admits one sending thread; Start, Shutdown, timers and
+     *        coroutine resumes reach it through a side channel.
+     * @param mailbox_size Ring capacity for the mailbox (0 = library default)
+     * @param wait How the actor thread waits for messages (BLOCK, SPIN, SPIN_THEN_PARK)
      */
     void manage(actor_ptr actor,
                 std::set<int> affinity = {},
                 int priority = 0,
-                int priority_type = SCHED_OTHER);
+                int priority_type = SCHED_OTHER,
+                MailboxType mailbox = MailboxType::BLOCKING,
+                std::size_t mailbox_size = 0,
+                WaitStrategy wait = WaitStrategy::BLOCK);
+
+    /**
+     * Choose how later manage() calls place actors (default MANUAL).
+     * Call before managing the actors it should apply to.
+     */
+    void set_placement(Placement placement) noexcept { placement_ = placement; }
+    Placement placement() const noexcept { return placement_; }
+
+    /**
+     * Messages seen between managed actors, heaviest senders per receiver
+     * Counted only for actors managed under Placement::NUMA (fast_send
+     * included). A Group's members are reported under their own IDs.
+     */
+    std::vector<Traffic> get_traffic() const;
+
+    /**
+     * Pin every actor managed without affinity under Placement::NUMA to
+     * one CPU, putting the actors that message each other most on
+     * hyperthread siblings, else on the same socket or node (see
+     * place_by_traffic()). Running threads are moved at once; their
+     * mailbox stays where it was allocated. Call after a warm-up period.
+     * @param cpus CPUs to use (empty = every online CPU no other actor is pinned to)
+     * @return CPU chosen per actor name
+     */
+    std::map<std::string, int> colocate(std::set<int> cpus = {});
+
+    /**
+     * Configure the worker pool used by manage_pooled().
+     * Call before the first manage_pooled(); if never called, the pool
+     * gets one unpinned worker per online CPU.
+     * @param workers Number of worker threads (0 = one per online CPU)
+     * @param affinity Cores for the workers, one core per worker in order
+     *                 (wraps around; empty = no pinning)
+     */
+    void set_scheduler(std::size_t workers, std::set<int> affinity = {});
+
+    /**
+     * Register an actor that runs on the shared worker pool instead of
+     * its own thread. Its messages are still handled one at a time, in
+     * order. Use for large numbers of low-traffic actors; keep
+     * latency-critical actors on manage() with a pinned thread.
+     * @param actor The actor to manage (takes ownership)
+     * @param mailbox Mailbox implementation (BLOCKING, SPSC or MPSC)
+     * @param mailbox_size Ring capacity for the mailbox (0 = library default)
+     */
+    void manage_pooled(actor_ptr actor,
+                       MailboxType mailbox = MailboxType::BLOCKING,
+                       std::size_t mailbox_size = 0);
+
+    /// Worker pool, or nullptr if no actor is pooled
+    Scheduler* get_scheduler() const noexcept { return scheduler_.get(); }
 
     /**
      * Connect to a GlobalRegistry for cross-process actor lookup.
-     * Must be called before manage() if you want actors auto-registered.
+     * Managed actors are registered in one batch by init(); actors managed
+     * after init() are registered one at a time.
      *
      * @param registry_endpoint ZMQ endpoint of GlobalRegistry (e.g., "tcp://localhost:5555")
      * @param local_endpoint ZMQ endpoint where this Manager's actors are reachable
@@ -145,6 +427,9 @@ class ZmqReceiver;
      * Find an actor by name (local or remote via GlobalRegistry).
      *
      * First checks local actors, then queries GlobalRegistry if connected.
+     * If the registry reports an endpoint on this host whose manager runs
+     * a ShmReceiver, returns a shared-memory ShmActorRef instead of a TCP
+     * ref (see set_shm_transport()).
      *
      * @param name Actor name to search for
      * @return ActorRef for the actor (local or remote)
@@ -153,6 +438,12 @@ class ZmqReceiver;
      */
     ActorRef get_actor_by_name(const std::string& name);
 
+    /**
+     * Prefer same-host shared memory in get_actor_by_name() (default true).
+     * With false, registry lookups always return TCP refs.
+     */
+    void set_shm_transport(bool enabled) { shm_transport_ = enabled; }
+
     /**
      * Find a local actor by name (does not query registry).
      * @param name Actor name to search for
@@ -160,6 +451,20 @@ class ZmqReceiver;
      */
     actor_ptr get_local_actor(const std::string& name) const noexcept;
 
+    /**
+     * Find a local actor by ID without hashing or comparing names.
+     * Lock-free, so it may be called from any thread.
+     * @param id ID from get_actor_id() or Actor::get_id()
+     * @return Pointer to actor, or nullptr if no actor has this ID
+     */
+    actor_ptr get_local_actor(ActorId id) const noexcept { return id_table_.get(id); }
+
+    /**
+     * Resolve a local actor name to its ActorId, once at startup.
+     * @return ID of the actor, or NO_ACTOR_ID if not found locally
+     */
+    ActorId get_actor_id(const std::string& name) const noexcept;
+
     /**
      * Get map of all actor names to actor pointers
      * Includes actors inside groups.
@@ -192,10 +497,59 @@ class ZmqReceiver;
      */
     std::map<std::string, std::size_t> get_queue_lengths() const noexcept;
 
+    /**
+     * Get pending message count per actor in one mailbox lane
+     * @param lane Lane to report (only PRIORITY mailboxes use lanes other than NORMAL)
+     * @return Map of actor name to queue length in that lane
+     */
+    std::map<std::string, std::size_t> get_queue_lengths(Lane lane) const noexcept;
+
+    /**
+     * Get actors whose mailbox is above its high watermark
+     * @return Names of actors currently under backpressure
+     */
+    std::list<std::string> get_backpressured() const noexcept;
+
+    /**
+     * Get conflated message count per actor with a CONFLATING mailbox
+     * @return Map of actor name to messages replaced by a newer one
+     */
+    std::map<std::string, std::size_t> get_conflation_counts() const noexcept;
+
     /**
      * Get thread ID and message count per actor
      * @return Map of actor name to (tid, message_count) tuple
      */
-    std::map<std::string, std::tuple<pid_t, int>> get_message_counts() const noexcept;
+    std::map<std::string, std::tuple<pid_t, std::uint64_t>> get_message_counts() const noexcept;
+
+    /**
+     * Get every counter per actor (see ActorCounters)
+     * Reads relaxed atomics only; no mailbox or dispatch locks are taken.
+     * @return Map of actor name to a snapshot of its counters
+     */
+    std::map<std::string, ActorMetrics> get_metrics() const noexcept;
+
+    /**
+     * Get queue-wait and handler-time percentiles per actor, in ns
+     * Empty unless the library was built with ACTOR_LATENCY.
+     * @return Map of actor name to latency report
+     */
+    std::map<std::string, LatencyReport> get_latencies() const noexcept;
+
+    /**
+     * Get latency percentiles per message ID for one actor
+     * Needs ACTOR_LATENCY and latency_by_id set in the actor.
+     * @return Map of message ID to latency report
+     */
+    std::map<int, LatencyReport> get_latencies_by_id(const std::string& name) const;
+
+    /**
+     * Get hit/miss counters for every PooledMessage_N type used so far
+     * Useful for sizing message pools.
+     * @return Map of message type name to pool counters
+     */
+    std::map<std::string, PoolStats> get_message_pool_stats() const noexcept {
+      return message_pool_stats();
+    }
   };
 }
@@ -0,0 +1,237 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <system_error>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "actors/Actor.hpp"
+#include "actors/Metrics.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Continue.hpp"
+#include "actors/msg/Start.hpp"
+
+// Longest the exporter blocks waiting for a scrape before rechecking its mailbox
+#ifndef ACTOR_METRICS_POLL_MS
+#define ACTOR_METRICS_POLL_MS 100
+#endif
+
+namespace actors
+{
+  /**
+   * MetricsExporter - Serves Manager::get_metrics() in Prometheus text format
+   *
+   * Listens for plain HTTP on a TCP port and answers GET /metrics with one
+   * sample per actor of every counter in ActorMetrics, labelled with the
+   * actor name. Like ZmqReceiver it polls from its own mailbox by sending
+   * itself Continue messages, so it needs a thread of its own (not a Group
+   * or the worker pool). A scrape only reads relaxed atomics: it never
+   * takes a mailbox or dispatch lock of the actors it reports on.
+   *
+   * Usage:
+   *   mgr.manage(new MetricsExporter(mgr, 9464));
+   *   mgr.init();
+   *   // curl http://localhost:9464/metrics
+   */
+  class MetricsExporter : public Actor
+  {
+  public:
+    /**
+     * Bind and listen; port 0 picks a free port (see port())
+     * @throws std::system_error if the socket cannot be bound
+     */
+    MetricsExporter(const Manager &mgr, std::uint16_t port,
+                    const char *exporter_name = "MetricsExporter",
+                    const std::string &bind_address = "0.0.0.0")
+      : mgr_(mgr)
+    {
+      strncpy(name, exporter_name, sizeof(name) - 1);
+      name[sizeof(name) - 1] = '\0';
+      MESSAGE_HANDLER(msg::Start, on_start);
+      MESSAGE_HANDLER(msg::Continue, on_continue);
+
+      fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if (fd_ < 0)
+        throw std::system_error(errno, std::generic_category(), "metrics socket");
+      int one = 1;
+      ::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof one);
+
+      sockaddr_in addr = {};
+      addr.sin_family = AF_INET;
+      addr.sin_port = htons(port);
+      socklen_t len = sizeof addr;
+      if (::inet_pton(AF_INET, bind_address.c_str(), &addr.sin_addr) != 1 ||
+          ::bind(fd_, reinterpret_cast<sockaddr *>(&addr), sizeof addr) != 0 ||
+          ::listen(fd_, 16) != 0 ||
+          ::getsockname(fd_, reinterpret_cast<sockaddr *>(&addr), &len) != 0) {
+        int err = errno;
+        ::close(fd_);
+        throw std::system_error(err, std::generic_category(), "metrics bind " + bind_address);
+      }
+      port_ = ntohs(addr.sin_port);
+    }
+
+    ~MetricsExporter() override { ::close(fd_); }
+
+    /// Port actually listened on
+    std::uint16_t port() const noexcept { return port_; }
+
+    /// Prometheus text exposition of a get_metrics() snapshot
+    static std::string render(const std::map<std::string, ActorMetrics> &metrics)
+    {
+      struct Family
+      {
+        const char *name;
+        const char *type;
+        const char *help;
+        double (*value)(const ActorMetrics &);
+      };
+      static const Family families[] = {
+        {"actors_messages_total", "counter", "Messages handled",
+         [](const ActorMetrics &m) { return double(m.messages); }},
+        {"actors_received_bytes_total", "counter", "Wire bytes received from remote senders",
+         [](const ActorMetrics &m) { return double(m.bytes_in); }},
+        {"actors_dropped_total", "counter", "Messages discarded by a full or draining mailbox",
+         [](const ActorMetrics &m) { return double(m.dropped); }},
+        {"actors_rejected_total", "counter", "Messages bounced with MailboxFull",
+         [](const ActorMetrics &m) { return double(m.rejected); }},
+        {"actors_conflated_total", "counter", "Queued messages replaced by a newer one",
+         [](const ActorMetrics &m) { return double(m.conflated); }},
+        {"actors_queue_length", "gauge", "Messages waiting in the mailbox",
+         [](const ActorMetrics &m) { return double(m.queue_length); }},
+        {"actors_queue_high_water", "gauge", "Longest mailbox seen",
+         [](const ActorMetrics &m) { return double(m.queue_high_water); }},
+        {"actors_handler_seconds_total", "counter", "Time spent in handlers (needs ACTOR_LATENCY)",
+         [](const ActorMetrics &m) { return m.handler_ns / 1e9; }},
+      };
+
+      std::string out;
+      char buf[64];
+      for (auto &f : families) {
+        out += std::string("# HELP ") + f.name + " " + f.help + "\n";
+        out += std::string("# TYPE ") + f.name + " " + f.type + "\n";
+        for (auto &[actor, m] : metrics) {
+          out += f.name;
+          out += "{actor=\"";
+          append_label(out, actor);
+          snprintf(buf, sizeof buf, "\"} %.17g\n", f.value(m));
+          out += buf;
+        }
+      }
+      return out;
+    }
+
+  private:
+    const Manager &mgr_;
+    int fd_ = -1;
+    std::uint16_t port_ = 0;
+
+    void on_start(const msg::Start *) noexcept { send(new msg::Continue(), this); }
+
+    void on_continue(const msg::Continue *) noexcept
+    {
+      pollfd p{fd_, POLLIN, 0};
+      if (::poll(&p, 1, ACTOR_METRICS_POLL_MS) > 0 && (p.revents & POLLIN)) {
+        int client = ::accept4(fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client >= 0) {
+          serve(client);
+          ::close(client);
+        }
+      }
+      if (!terminated)
+        send(new msg::Continue(), this);
+    }
+
+    // One request per connection; anything but GET of /metrics (or /) is a 404
+    void serve(int client) noexcept
+    {
+      timeval timeout{1, 0};
+      ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof timeout);
+      ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof timeout);
+
+      std::string request;
+      char buf[1024];
+      while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+        ssize_t n = ::recv(client, buf, sizeof buf, 0);
+        if (n <= 0)
+          return;
+        request.append(buf, size_t(n));
+      }
+
+      std::string status = "404 Not Found";
+      std::string body = "not found\n";
+      if (request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET / ", 0) == 0) {
+        status = "200 OK";
+        body = render(mgr_.get_metrics());
+      }
+      std::string response = "HTTP/1.1 " + status +
+                             "\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                             std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+      for (size_t sent = 0; sent < response.size();) {
+        ssize_t n = ::send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+          return;
+        sent += size_t(n);
+      }
+    }
+
+    static void append_label(std::string &out, const std::string &value)
+    {
+      for (char c : value) {
+        if (c == '\\' || c == '"')
+          out += '\\';
+        if (c == '\n') {
+          out += "\\n";
+          continue;
+        }
+        out += c;
+      }
+    }
+  };
+}
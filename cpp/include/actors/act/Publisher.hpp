@@ -0,0 +1,286 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "actors/Actor.hpp"
+#include "actors/ActorRef.hpp"
+#include "actors/msg/Subscribe.hpp"
+#include "actors/msg/Unsubscribe.hpp"
+
+namespace actors
+{
+  /**
+   * Publisher - Topic pub/sub with fan-out
+   *
+   * Keeps the subscribers of each topic. Actors join with
+   * msg::Subscribe{topic} ("" = every topic) and leave with
+   * msg::Unsubscribe{topic} ("" = every subscription of theirs); the
+   * publisher's own code may also subscribe any ActorRef - local, remote,
+   * Rust or shared-memory. A remote actor subscribing through a
+   * ZmqReceiver is kept as its RemoteActorRef, not its reply proxy.
+   *
+   * publish() hands a message to every subscriber of its topic in one pass
+   * over a fan-out list that is rebuilt only when subscriptions change.
+   * Remote subscribers reached through the same ZmqSender and endpoint
+   * share one wire send (ZmqSender::send_to_each()): the message is
+   * serialized once and goes out as one multipart message. Every other
+   * subscriber gets its own copy, or with a Shared<M>, a reference to the
+   * one message. A subscriber to both the topic and to every topic gets
+   * the message once.
+   *
+   * Subscriptions and publish() belong to the publisher's thread: use them
+   * from its handlers, or before it is managed.
+   *
+   * Usage:
+   *   class Quotes : public actors::Publisher {
+   *   public:
+   *     Quotes() : Publisher("quotes") { MESSAGE_HANDLER(Tick, on_tick); }
+   *   private:
+   *     void on_tick(const Tick *t) noexcept { publish(t->symbol, Quote{t->symbol, t->px}); }
+   *   };
+   *
+   *   quotes.send(new actors::msg::Subscribe("AAPL"), this);
+   */
+  class Publisher : public Actor
+  {
+  public:
+    explicit Publisher(const char *publisher_name)
+    {
+      strncpy(name, publisher_name, sizeof(name) - 1);
+      name[sizeof(name) - 1] = '\0';
+
+      MESSAGE_HANDLER(msg::Subscribe, on_subscribe);
+      MESSAGE_HANDLER(msg::Unsubscribe, on_unsubscribe);
+    }
+
+    /**
+     * Subscribe to topic ("" = every topic)
+     * @return false if subscriber already has this subscription
+     */
+    bool subscribe(const std::string &topic, ActorRef subscriber)
+    {
+      std::vector<ActorRef> &subs = topics_[topic];
+      for (const ActorRef &s : subs)
+        if (same(s, subscriber))
+          return false;
+      subs.push_back(std::move(subscriber));
+      rebuild(topic);
+      return true;
+    }
+
+    /**
+     * Drop subscriber's subscription to topic; "" drops all of them
+     * @return Subscriptions dropped
+     */
+    std::size_t unsubscribe(const std::string &topic, const ActorRef &subscriber)
+    {
+      std::size_t dropped = 0;
+      for (auto it = topics_.begin(); it != topics_.end();) {
+        if (!topic.empty() && it->first != topic) {
+          ++it;
+          continue;
+        }
+        std::size_t n = std::erase_if(it->second, [&](const ActorRef &s) { return same(s, subscriber); });
+        if (n == 0) {
+          ++it;
+          continue;
+        }
+        dropped += n;
+        std::string t = it->first;
+        it = it->second.empty() ? topics_.erase(it) : std::next(it);
+        rebuild(t);
+      }
+      return dropped;
+    }
+
+    /**
+     * Send a copy of m (copy-constructed) to every subscriber of topic
+     * @return Subscribers reached
+     */
+    template <class M>
+    std::size_t publish(const std::string &topic, const M &m)
+    {
+      auto it = fan_outs_.find(topic);
+      FanOut &f = it == fan_outs_.end() ? all_ : it->second;
+      for (ActorRef &ref : f.direct)
+        ref.send(new M(m), this);
+      for (const RemoteGroup &g : f.remote)
+        g.route.send_to_each(g.names, new M(m), this);
+      return f.count;
+    }
+
+    /**
+     * Send one shared message to every subscriber of topic, without copies
+     * @return Subscribers reached
+     */
+    template <class M>
+    std::size_t publish(const std::string &topic, const Shared<M> &m)
+    {
+      auto it = fan_outs_.find(topic);
+      FanOut &f = it == fan_outs_.end() ? all_ : it->second;
+      for (ActorRef &ref : f.direct)
+        ref.send(m.share(), this);
+      for (const RemoteGroup &g : f.remote)
+        g.route.send_to_each(g.names, m.share(), this);
+      return f.count;
+    }
+
+    /// Subscribers publish(topic, ...) would reach
+    std::size_t subscriber_count(const std::string &topic) const { return fan_out(topic).count; }
+
+    /// Topics with their own subscribers ("" if any subscribe to all)
+    std::vector<std::string> topics() const
+    {
+      std::vector<std::string> out;
+      for (const auto &[topic, subs] : topics_)
+        out.push_back(topic);
+      return out;
+    }
+
+  protected:
+    void on_subscribe(const msg::Subscribe *m) noexcept
+    {
+      if (Actor *from = current_sender())
+        subscribe(m->topic, subscriber_ref(from));
+    }
+
+    void on_unsubscribe(const msg::Unsubscribe *m) noexcept
+    {
+      if (Actor *from = current_sender())
+        unsubscribe(m->topic, subscriber_ref(from));
+    }
+
+  private:
+    // Remote subscribers sharing a ZmqSender and endpoint
+    struct RemoteGroup
+    {
+      RemoteActorRef route;
+      std::vector<std::string> names;
+    };
+
+    struct FanOut
+    {
+      std::vector<ActorRef> direct;  // One copy each
+      std::vector<RemoteGroup> remote;
+      std::size_t count = 0;
+    };
+
+    std::unordered_map<std::string, std::vector<ActorRef>> topics_;  // "" = all topics
+    std::unordered_map<std::string, FanOut> fan_outs_;  // Topics with their own subscribers
+    FanOut all_;  // Topics without: the "" subscribers
+
+    const FanOut &fan_out(const std::string &topic) const
+    {
+      auto it = fan_outs_.find(topic);
+      return it == fan_outs_.end() ? all_ : it->second;
+    }
+
+    static ActorRef subscriber_ref(Actor *a)
+    {
+      if (const RemoteActorRef *r = a->remote_route())
+        return ActorRef(r->name(), r->endpoint(), r->sender());
+      return ActorRef(a);
+    }
+
+    static bool same(const ActorRef &a, const ActorRef &b)
+    {
+      if (a.is_local() || b.is_local())
+        return a.is_local() && b.is_local() && a.actor() == b.actor();
+      if (a.is_rust() || b.is_rust())
+        return a.is_rust() && b.is_rust() && a.name() == b.name();
+      return a.is_shm() == b.is_shm() && a.name() == b.name()
+             && a.remote_ref().endpoint() == b.remote_ref().endpoint();
+    }
+
+    static void add(FanOut &f, const ActorRef &ref)
+    {
+      f.count++;
+      if (!ref.is_remote()) {
+        f.direct.push_back(ref);
+        return;
+      }
+      const RemoteActorRef &r = ref.remote_ref();
+      for (RemoteGroup &g : f.remote) {
+        if (g.route.sender() == r.sender() && g.route.endpoint() == r.endpoint()) {
+          g.names.push_back(r.name());
+          return;
+        }
+      }
+      f.remote.push_back(RemoteGroup{r, {r.name()}});
+    }
+
+    void build(FanOut &f, const std::vector<ActorRef> *subs)
+    {
+      f = FanOut();
+      if (subs)
+        for (const ActorRef &s : *subs)
+          add(f, s);
+      auto all = topics_.find("");
+      if (all == topics_.end())
+        return;
+      for (const ActorRef &s : all->second) {
+        bool dup = false;
+        for (std::size_t i = 0; subs && i < subs->size() && !dup; i++)
+          dup = same((*subs)[i], s);
+        if (!dup)
+          add(f, s);
+      }
+    }
+
+    // Fan-out lists affected by a change to topic's subscribers
+    void rebuild(const std::string &topic)
+    {
+      if (!topic.empty()) {
+        auto it = topics_.find(topic);
+        if (it == topics_.end())
+          fan_outs_.erase(topic);
+        else
+          build(fan_outs_[topic], &it->second);
+        return;
+      }
+      build(all_, nullptr);
+      for (auto &[t, f] : fan_outs_)
+        build(f, &topics_.at(t));
+    }
+  };
+}
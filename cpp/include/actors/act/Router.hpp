@@ -0,0 +1,246 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "actors/Actor.hpp"
+#include "actors/HandlerTable.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+// Points per worker on a HASH router's ring; more spread keys more evenly
+#ifndef ACTOR_ROUTER_VNODES
+#define ACTOR_ROUTER_VNODES 64
+#endif
+
+namespace actors
+{
+  /**
+   * How a Router picks the worker for each message
+   *
+   * ROUND_ROBIN  - Workers in turn (default)
+   * LEAST_LOADED - Worker with the shortest mailbox (queue_length())
+   * HASH         - Consistent hash of the key from key_by(), so equal keys
+   *                always reach the same worker; types without a key go
+   *                round-robin
+   * BROADCAST    - A copy to every worker for types registered with
+   *                copyable(); other types go round-robin
+   */
+  enum class RouteStrategy
+  {
+    ROUND_ROBIN,
+    LEAST_LOADED,
+    HASH,
+    BROADCAST
+  };
+
+  /**
+   * Router - One logical actor fronting N workers
+   *
+   * Messages sent to the router are passed to a worker from the sender's
+   * thread, keeping the original sender, so the worker's reply() goes
+   * straight back to it and the router's own thread never handles them.
+   * Workers not yet managed are managed along with the router, each on
+   * its own thread with its own affinity. Shutdown sent to the router
+   * stops every worker, then the router.
+   *
+   * Routing only happens in send(): fast_send() to a router runs the
+   * router's own handlers. Configure the router before Manager::manage().
+   *
+   * Usage:
+   *   auto* books = new actors::Router("books", actors::RouteStrategy::HASH);
+   *   for (int core = 2; core < 6; core++)
+   *     books->add(new BookWorker(core), {core});
+   *   books->key_by<Quote>([](const Quote& q) { return q.instrument_id; });
+   *   mgr.manage(books);
+   *
+   *   mgr.get_actor_by_name("books").send(new Quote{...}, this);
+   */
+  class Router : public Actor
+  {
+  public:
+    using KeyFn = std::function<std::uint64_t(const Message *)>;
+    using CopyFn = const Message *(*)(const Message *);
+
+    explicit Router(const char *router_name, RouteStrategy strategy = RouteStrategy::ROUND_ROBIN)
+      : strategy_(strategy)
+    {
+      strncpy(name, router_name, sizeof(name) - 1);
+      name[sizeof(name) - 1] = '\0';
+    }
+
+    /**
+     * Add a worker. Unmanaged workers are managed with the router.
+     * @param worker Actor that handles the routed messages
+     * @param affinity CPU cores for the worker's thread (empty = no pinning)
+     */
+    void add(Actor *worker, std::set<int> affinity = {})
+    {
+      assert(worker != nullptr && worker != this && "bad router worker");
+      workers_.push_back(worker);
+      affinity_.push_back(std::move(affinity));
+      build_ring();
+    }
+
+    /**
+     * Route M by a key for HASH
+     * @param f Returns the key of a message, as std::uint64_t(const M&)
+     */
+    template <class M, class F>
+    void key_by(F f)
+    {
+      key_fns_.emplace_back([f](const Message *m) { return std::uint64_t(f(*static_cast<const M *>(m))); });
+      key_entries_.emplace_back(M::message_id, &key_fns_.back());
+      keys_.build(key_entries_);
+    }
+
+    /// Let BROADCAST copy M (copy-constructed) to every worker
+    template <class M>
+    void copyable()
+    {
+      copy_entries_.emplace_back(M::message_id, [](const Message *m) -> const Message * {
+        return new M(*static_cast<const M *>(m));
+      });
+      copies_.build(copy_entries_);
+    }
+
+    RouteStrategy strategy() const noexcept { return strategy_; }
+    const std::vector<Actor *> &workers() const noexcept { return workers_; }
+
+    /// Affinity given to add() for worker i
+    const std::set<int> &worker_affinity(std::size_t i) const { return affinity_.at(i); }
+
+    void send(const Message *m, Actor *sender = nullptr) noexcept override
+    {
+      if (m->id() == msg::Shutdown::message_id || workers_.empty()) {
+        if (m->id() == msg::Shutdown::message_id)
+          for (auto *w : workers_)
+            w->send(new msg::Shutdown(), sender);
+        Actor::send(m, sender);
+        return;
+      }
+
+      if (strategy_ == RouteStrategy::BROADCAST) {
+        if (CopyFn copy = copies_.find(m->id())) {
+          // Copy before the original is handed over and may be deleted
+          for (std::size_t i = 1; i < workers_.size(); i++)
+            workers_[i]->send(copy(m), sender);
+          workers_[0]->send(m, sender);
+          return;
+        }
+      }
+
+      pick(m)->send(m, sender);
+    }
+
+    /// Worker the next send of m would go to (not for BROADCAST copies)
+    Actor *pick(const Message *m) noexcept
+    {
+      switch (strategy_) {
+      case RouteStrategy::LEAST_LOADED: {
+        Actor *best = workers_[0];
+        std::size_t best_len = best->queue_length();
+        for (std::size_t i = 1; i < workers_.size() && best_len > 0; i++) {
+          std::size_t len = workers_[i]->queue_length();
+          if (len < best_len) {
+            best = workers_[i];
+            best_len = len;
+          }
+        }
+        return best;
+      }
+      case RouteStrategy::HASH:
+        if (const KeyFn *key = keys_.find(m->id()))
+          return by_key((*key)(m));
+        break;
+      case RouteStrategy::ROUND_ROBIN:
+      case RouteStrategy::BROADCAST:
+        break;
+      }
+      return workers_[next_.fetch_add(1, std::memory_order_relaxed) % workers_.size()];
+    }
+
+  private:
+    RouteStrategy strategy_;
+    std::vector<Actor *> workers_;
+    std::vector<std::set<int>> affinity_;
+    std::atomic<std::uint64_t> next_{0};
+
+    // HASH: ACTOR_ROUTER_VNODES points per worker, sorted by hash
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> ring_;
+    std::deque<KeyFn> key_fns_;  // Stable addresses for keys_
+    std::vector<std::pair<int, const KeyFn *>> key_entries_;
+    HandlerTable<const KeyFn *> keys_;
+    std::vector<std::pair<int, CopyFn>> copy_entries_;
+    HandlerTable<CopyFn> copies_;
+
+    static std::uint64_t mix(std::uint64_t x) noexcept
+    {
+      x += 0x9E3779B97F4A7C15ull;
+      x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+      x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+      return x ^ (x >> 31);
+    }
+
+    void build_ring()
+    {
+      ring_.clear();
+      for (std::uint32_t w = 0; w < workers_.size(); w++)
+        for (std::uint64_t v = 0; v < ACTOR_ROUTER_VNODES; v++)
+          ring_.emplace_back(mix((std::uint64_t(w) << 32) | v), w);
+      std::sort(ring_.begin(), ring_.end());
+    }
+
+    // First ring point at or after the key's hash, wrapping around
+    Actor *by_key(std::uint64_t key) const noexcept
+    {
+      auto it = std::lower_bound(ring_.begin(), ring_.end(), std::make_pair(mix(key), std::uint32_t(0)));
+      if (it == ring_.end())
+        it = ring_.begin();
+      return workers_[it->second];
+    }
+  };
+}
@@ -40,6 +40,7 @@ https://opensource.org/licenses/MIT
 #include <chrono>
 #include <functional>
 #include "actors/msg/Timeout.hpp"
+#include "actors/act/TimerWheel.hpp"
 #include "actors/Actor.hpp"
 
 namespace actors
@@ -47,24 +48,26 @@ namespace actors
   /**
    * Timer - Simple timer utility for actors
    *
+   * All timers are served by TimerWheel::instance() (one thread, 1 ms ticks).
+   *
    * Usage:
-   *   Timer::wake_up_in(my_actor, 5, 0);  // Wake up in 5 seconds
-   *   Timer::wake_up_at(my_actor, 1000);  // Wake up at next 1-second boundary
+   *   Timer::wake_up_in(my_actor, 5, 0);            // Wake up in 5 seconds
+   *   Timer::wake_up_at(my_actor, 1000);            // Wake up at next 1-second boundary
+   *   auto h = Timer::wake_up_every(my_actor, 100); // Every 100 ms until cancelled
+   *   Timer::cancel(h);
    */
   class Timer
   {
   public:
     /// Wake up actor after specified delay
-    static void wake_up_in(Actor* subscriber, int seconds, int msecs = 0, int data = 0)
+    static TimerHandle wake_up_in(Actor* subscriber, int seconds, int msecs = 0, int data = 0)
     {
-      std::thread([=]() {
-        sleep(seconds, msecs);
-        subscriber->send(new msg::Timeout(data), nullptr);
-      }).detach();
+      return TimerWheel::instance().schedule(
+        subscriber, std::chrono::milliseconds(seconds * 1000LL + msecs), data);
     }
 
     /// Wake up actor at next interval boundary (e.g., every 1000ms)
-    static void wake_up_at(Actor* subscriber, int interval_ms, int data = 0)
+    static TimerHandle wake_up_at(Actor* subscriber, int interval_ms, int data = 0)
     {
       using namespace std::chrono;
       auto now = system_clock::now();
@@ -75,10 +78,20 @@ namespace actors
       auto next_timeout = rounded_down + interval_ms;
       auto time_to_wait = next_timeout - curr_ms;
 
-      std::thread([=]() {
-        sleep(0, int(time_to_wait));
-        subscriber->send(new msg::Timeout(data), nullptr);
-      }).detach();
+      return TimerWheel::instance().schedule(subscriber, milliseconds(time_to_wait), data);
+    }
+
+    /// Wake up actor every interval_ms until cancelled
+    static TimerHandle wake_up_every(Actor* subscriber, int interval_ms, int data = 0)
+    {
+      std::chrono::milliseconds interval(interval_ms);
+      return TimerWheel::instance().schedule(subscriber, interval, data, interval);
+    }
+
+    /// Cancel a timer; false if it already fired
+    static bool cancel(TimerHandle handle) noexcept
+    {
+      return TimerWheel::instance().cancel(handle);
     }
 
     static void sleep(int seconds, int msecs = 0)
@@ -0,0 +1,201 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski,  & M2 Tech
+Contact:
+v@m2te.ch
+mayeski@gmail.com
+https://www.linkedin.com/in/vmayeski/
+http://m2te.ch/
+
+Permission is hereby granted, free of charge, to any person
+obtaining a copy of this software and associated documentation
+files (the "Software"), to deal in the Software without
+restriction, including without limitation the rights to use,
+copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the
+Software is furnished to do so, subject to the following
+conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+OTHER DEALINGS IN THE SOFTWARE.
+
+https://opensource.org/licenses/MIT
+
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace actors
+{
+  class Actor;
+
+  /// Identifies a scheduled timer; pass to cancel(). Default value is "no timer".
+  struct TimerHandle
+  {
+    std::uint64_t id = 0;
+    explicit operator bool() const noexcept { return id != 0; }
+  };
+
+  /**
+   * TimerWheel - One thread serving any number of timers
+   *
+   * Timers live in a hierarchical timing wheel: 256 slots of one tick
+   * each, then three levels of 64 slots, each 64 times coarser. Adding,
+   * cancelling and firing are O(1); a timer moves down a level at most
+   * three times before it fires. Delays beyond the top level (2^26 ticks,
+   * about 18 hours at 1 ms) wait in the top level and are re-filed.
+   *
+   * A fired timer sends msg::Timeout(data) to its actor. Periodic timers
+   * stay scheduled until cancelled. The service thread sleeps until the
+   * next occupied slot comes due, skipping empty ticks, or while no timer
+   * is pending.
+   *
+   * Fired timers are delivered without the lock, so a delivery may still
+   * be running when cancel() returns. Before destroying a timer's actor,
+   * stop it with cancel_and_wait().
+   *
+   * With set_virtual(true) time stands still until advance() moves it to
+   * the next due timer, which fires on the calling thread. Manager's
+   * deterministic mode uses this to run timers without waiting for them.
+   *
+   * Usage:
+   *   auto h = TimerWheel::instance().schedule(actor, std::chrono::milliseconds(50), 7);
+   *   TimerWheel::instance().cancel(h);
+   */
+  class TimerWheel
+  {
+  public:
+    /// @param resolution Tick length; delays are rounded up to whole ticks
+    explicit TimerWheel(std::chrono::microseconds resolution = std::chrono::milliseconds(1));
+    ~TimerWheel();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * Send msg::Timeout(data) to target after delay, then every period
+     * if period is non-zero. Thread safe.
+     */
+    TimerHandle schedule(Actor *target,
+                         std::chrono::nanoseconds delay,
+                         int data = 0,
+                         std::chrono::nanoseconds period = std::chrono::nanoseconds::zero());
+
+    /// Stop a timer; false if it already fired (one-shot) or was never scheduled
+    bool cancel(TimerHandle handle) noexcept;
+
+    /**
+     * cancel(), then wait while the timer's Timeout is being sent, so
+     * the target may be destroyed once this returns. Does not wait when
+     * called from that send() itself. Don't call it holding a lock the
+     * target's send() takes, or while the target's BLOCK mailbox is full.
+     */
+    bool cancel_and_wait(TimerHandle handle) noexcept;
+
+    /// Number of scheduled timers
+    std::size_t pending() const noexcept;
+
+    std::chrono::microseconds resolution() const noexcept { return resolution_; }
+
+    /// Current time on the wheel's clock (virtual while set_virtual(true))
+    std::chrono::steady_clock::time_point now() const noexcept;
+
+    /**
+     * Stop (on) or resume (off) following the steady clock. The service
+     * thread fires nothing while virtual; time carries on from where it
+     * was, and never goes backwards when switching back.
+     */
+    void set_virtual(bool on);
+    bool is_virtual() const noexcept;
+
+    /**
+     * Virtual time only: jump to the earliest pending timer and fire every
+     * timer due then, on the calling thread. Timers due at the same time
+     * fire in the order they were scheduled.
+     * @param limit Fire nothing due after this
+     * @return Number of timers fired (0 = none due by limit)
+     */
+    std::size_t advance(std::chrono::steady_clock::time_point limit);
+
+    /// Process-wide wheel with 1 ms resolution, used by Timer
+    static TimerWheel& instance();
+
+  private:
+    static constexpr int L0_BITS = 8;
+    static constexpr int LN_BITS = 6;
+    static constexpr int LEVELS = 4;
+    static constexpr std::uint64_t MAX_SPAN = (std::uint64_t(1) << (L0_BITS + (LEVELS - 1) * LN_BITS)) - 1;
+
+    struct Entry
+    {
+      Entry *next = nullptr;
+      Entry **pprev = nullptr;   // the pointer that points at us, for O(1) unlink
+      Actor *target = nullptr;
+      std::uint64_t expires = 0; // absolute tick
+      std::uint64_t period = 0;  // ticks, 0 = one-shot
+      std::uint64_t id = 0;
+      int data = 0;
+    };
+
+    // A fired timer, delivered after mut_ is released
+    struct Fire
+    {
+      Actor *target;
+      int data;
+      std::uint64_t id;
+    };
+
+    const std::chrono::microseconds resolution_;
+    const std::chrono::steady_clock::time_point start_;
+
+    mutable std::mutex mut_;
+    std::condition_variable cv_;
+    std::condition_variable delivered_;  // a delivery finished
+    std::vector<Entry *> wheel_[LEVELS];
+    std::unordered_map<std::uint64_t, Entry *> active_;
+    std::unordered_map<std::uint64_t, std::size_t> firing_;          // fired, sends not started
+    std::unordered_map<std::uint64_t, std::thread::id> delivering_;  // being sent, by thread
+    std::uint64_t next_ = 0;     // next tick to process
+    std::uint64_t wake_ = 0;     // tick run() sleeps until, 0 while awake
+    std::uint64_t next_id_ = 1;
+    bool stop_ = false;
+    bool virtual_ = false;
+    std::uint64_t virtual_now_ = 0;  // tick while virtual_
+    std::uint64_t offset_ = 0;       // ticks virtual time ran ahead of the clock
+    std::thread thread_;
+
+    std::uint64_t now_tick() const noexcept;
+    std::uint64_t clock_tick() const noexcept;
+    std::uint64_t to_ticks(std::chrono::nanoseconds d) const noexcept;
+    void add(Entry *e) noexcept;
+    static void link(Entry *&head, Entry *e) noexcept;
+    static void unlink(Entry *e) noexcept;
+    void cascade(int level) noexcept;
+    std::uint64_t next_due() const noexcept;
+    void expire(std::uint64_t upto, std::vector<Fire> &due);
+    std::size_t deliver(std::vector<Fire> &due);
+    bool remove(TimerHandle handle, bool wait) noexcept;
+    void jump(std::uint64_t tick);
+    void run();
+  };
+}
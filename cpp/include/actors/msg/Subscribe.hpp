@@ -37,8 +37,14 @@ https://opensource.org/licenses/MIT
 #pragma once
 
 #include "actors/Message.hpp"
+#include <string>
 
 namespace actors::msg {
-  /// Subscribe to events from another actor
-  struct Subscribe : public Message_N<7> {};
+  /// Subscribe to events from another actor; for a Publisher, to one
+  /// topic ("" = every topic)
+  struct Subscribe : public Message_N<7> {
+    std::string topic;
+    Subscribe() = default;
+    explicit Subscribe(std::string t) : topic(std::move(t)) {}
+  };
 }
@@ -0,0 +1,270 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "actors/Actor.hpp"
+#include "actors/ActorRef.hpp"
+#include "actors/act/TimerWheel.hpp"
+#include "actors/msg/Start.hpp"
+#include "actors/msg/Timeout.hpp"
+#include "actors/registry/RegistryMessages.hpp"
+
+// How often GlobalRegistry expires managers that stopped sending heartbeats
+#ifndef ACTOR_REGISTRY_SWEEP_MS
+#define ACTOR_REGISTRY_SWEEP_MS 1000
+#endif
+
+// Missed heartbeat intervals before a manager is marked offline
+#ifndef ACTOR_REGISTRY_MISS_THRESHOLD
+#define ACTOR_REGISTRY_MISS_THRESHOLD 3
+#endif
+
+// Timeout for managers whose heartbeats don't state an interval
+#ifndef ACTOR_REGISTRY_HEARTBEAT_TIMEOUT_MS
+#define ACTOR_REGISTRY_HEARTBEAT_TIMEOUT_MS 6000
+#endif
+
+namespace actors::registry {
+
+/// Registry counters (GlobalRegistry::stats())
+struct RegistryStats {
+    size_t actors = 0;
+    size_t managers = 0;
+    size_t managers_online = 0;
+    size_t subscriptions = 0;
+    uint64_t lookups = 0;
+    uint64_t heartbeats = 0;
+    uint64_t expired = 0;          // Times a manager went offline
+};
+
+/**
+ * GlobalRegistry - Native registry server
+ *
+ * Keeps actor name -> endpoint mappings for every Manager, the same
+ * protocol and semantics as the Python registry:
+ * - Name and manager indexes are hash maps, so register, lookup and
+ *   heartbeat are O(1)
+ * - A heartbeat only stamps the manager. Expiry runs in batches from a
+ *   TimerWheel timer every sweep interval and pops due managers off a
+ *   deadline heap, so it does not scan managers that are healthy.
+ * - A manager is offline after missing miss_threshold of the intervals
+ *   its heartbeats state. Its actors stay registered and look up with
+ *   online=false until heartbeats resume or a new owner registers them.
+ * - ActorMoved / ManagerOnline / ManagerOffline are pushed to subscribers
+ *   through the push function (see set_push())
+ * - save_snapshot() / load_snapshot() keep registrations across a
+ *   restart; set_snapshot() saves periodically and on shutdown
+ *
+ * Native messages (RegisterActor, LookupActor, ...) are handled in the
+ * mailbox. The synchronous methods are thread safe; RegistryServer uses
+ * them to serve the JSON clients.
+ *
+ * Usage:
+ *   auto* registry = new GlobalRegistry();
+ *   registry->set_push([sender](const std::string& name, const std::string& endpoint,
+ *                               const Message* event) {
+ *       sender->send_to(endpoint, name, event, nullptr);
+ *   });
+ *   mgr.manage(registry);
+ *   mgr.manage(new RegistryServer("tcp://0.0.0.0:5555", registry));
+ */
+class GlobalRegistry : public Actor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Delivers event to subscriber at endpoint; takes ownership of event
+    using PushFn = std::function<void(const std::string& subscriber,
+                                      const std::string& endpoint,
+                                      const Message* event)>;
+
+    /// Outcome of lookup()
+    struct Lookup {
+        bool found = false;
+        bool online = false;
+        std::string endpoint;      // Empty for in-process actors
+        std::string manager_id;
+        ActorRef ref;              // As registered; a remote ref without sender otherwise
+    };
+
+    GlobalRegistry();
+    ~GlobalRegistry() override;
+
+    /// Set how pushed events are delivered. Without one, events are dropped.
+    void set_push(PushFn push);
+
+    /// Timeout for managers that don't state a heartbeat interval
+    void set_heartbeat_timeout(std::chrono::milliseconds timeout);
+
+    /// Missed intervals before a manager is offline (default ACTOR_REGISTRY_MISS_THRESHOLD)
+    void set_miss_threshold(unsigned misses);
+
+    /// Time between expiry sweeps (default ACTOR_REGISTRY_SWEEP_MS). Call before init().
+    void set_sweep_interval(std::chrono::milliseconds interval) { sweep_interval_ = interval; }
+
+    /**
+     * Save to path every interval when something changed, and in end().
+     * Call before init(); load_snapshot() to restore.
+     */
+    void set_snapshot(const std::string& path, std::chrono::milliseconds interval);
+
+    /**
+     * Register actor_name for manager_id. A name held by another manager
+     * that is still online is rejected; the same manager, or any manager
+     * taking over from an offline one, replaces the entry.
+     * Counts as a heartbeat from manager_id.
+     *
+     * @return Empty on success, else the reason it failed
+     */
+    std::string register_actor(const std::string& manager_id, const std::string& actor_name,
+                               const std::string& endpoint, const ActorRef& ref = ActorRef());
+
+    /// Register each entry of m; returns those that failed
+    std::vector<RegisterActorsResult::Failure> register_actors(const RegisterActors& m);
+
+    /// False if actor_name was not registered
+    bool unregister_actor(const std::string& actor_name);
+
+    Lookup lookup(const std::string& actor_name);
+
+    /// Record a heartbeat; interval_ms 0 means the manager didn't state one
+    void heartbeat(const std::string& manager_id, uint32_t interval_ms = 0);
+
+    bool is_manager_online(const std::string& manager_id) const;
+
+    /// Silence after which manager_id counts as offline
+    std::chrono::milliseconds heartbeat_timeout(const std::string& manager_id) const;
+
+    /// Add to the subscription of subscriber at endpoint
+    void subscribe(const std::string& subscriber, const std::string& endpoint,
+                   const std::vector<std::string>& actor_names,
+                   const std::vector<std::string>& manager_ids);
+
+    /// Remove from it, or drop it entirely when both lists are empty
+    void unsubscribe(const std::string& subscriber, const std::string& endpoint,
+                     const std::vector<std::string>& actor_names,
+                     const std::vector<std::string>& manager_ids);
+
+    /**
+     * Mark every manager whose heartbeat deadline passed before now as
+     * offline and push ManagerOffline. Run by the sweep timer.
+     *
+     * @return Number of managers that went offline
+     */
+    size_t expire(Clock::time_point now = Clock::now());
+
+    /**
+     * Write managers, actors and subscriptions to path (through a
+     * temporary file, so a crash leaves the previous snapshot).
+     * In-process ActorRefs are not saved, only endpoints.
+     */
+    bool save_snapshot(const std::string& path) const;
+
+    /**
+     * Replace the registry's contents with a snapshot. Restored managers
+     * get one full timeout to send a heartbeat before they expire.
+     *
+     * @return false if path can't be read or isn't a snapshot
+     */
+    bool load_snapshot(const std::string& path);
+
+    std::vector<std::string> actor_names() const;
+    std::vector<std::string> manager_ids() const;
+    RegistryStats stats() const;
+
+protected:
+    void end() override;
+
+private:
+    struct ActorEntry {
+        std::string manager_id;
+        std::string endpoint;
+        ActorRef ref;
+    };
+
+    struct ManagerEntry {
+        std::unordered_set<std::string> actors;
+        Clock::time_point last_heartbeat;
+        Clock::time_point queued;      // Deadline of its live entry in deadlines_
+        uint32_t interval_ms = 0;
+        bool online = false;
+    };
+
+    struct Subscription {
+        std::unordered_set<std::string> actors;
+        std::unordered_set<std::string> managers;
+    };
+
+    struct Deadline {
+        Clock::time_point when;
+        std::string manager_id;
+        bool operator>(const Deadline& o) const { return when > o.when; }
+    };
+
+    struct Push {
+        std::string subscriber;
+        std::string endpoint;
+        const Message* event;
+    };
+
+    std::unordered_map<std::string, ActorEntry> actors_;
+    std::unordered_map<std::string, ManagerEntry> managers_;
+    std::unordered_map<std::string, Subscription> subscriptions_;  // Key: subscriber + '\n' + endpoint
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines_;
+    mutable std::mutex mutex_;
+
+    PushFn push_;
+    std::chrono::milliseconds default_timeout_{ACTOR_REGISTRY_HEARTBEAT_TIMEOUT_MS};
+    unsigned miss_threshold_ = ACTOR_REGISTRY_MISS_THRESHOLD;
+    std::chrono::milliseconds sweep_interval_{ACTOR_REGISTRY_SWEEP_MS};
+    TimerHandle sweep_timer_;
+
+    std::string snapshot_path_;
+    std::chrono::milliseconds snapshot_interval_{0};
+    Clock::time_point next_snapshot_;
+    bool dirty_ = false;
+
+    std::atomic<uint64_t> lookups_{0};
+    std::atomic<uint64_t> heartbeats_{0};
+    std::atomic<uint64_t> expired_{0};
+
+    // Callers hold mutex_; events are queued and pushed after unlocking
+    std::string register_locked(const std::string& manager_id, const std::string& actor_name,
+                                const std::string& endpoint, const ActorRef& ref,
+                                std::vector<Push>& out);
+    void heartbeat_locked(const std::string& manager_id, uint32_t interval_ms,
+                          Clock::time_point now, std::vector<Push>& out);
+    std::chrono::milliseconds timeout_locked(const ManagerEntry& m) const;
+    void notify_actor(const std::string& actor_name, const std::string& endpoint, std::vector<Push>& out);
+    void notify_manager(const std::string& manager_id, bool online, std::vector<Push>& out);
+    void deliver(std::vector<Push>& pushes);
+    void maybe_snapshot(Clock::time_point now);
+
+    void on_start(const msg::Start*) noexcept;
+    void on_timeout(const msg::Timeout*) noexcept;
+    void on_register(const RegisterActor* m) noexcept;
+    void on_register_actors(const RegisterActors* m) noexcept;
+    void on_unregister(const UnregisterActor* m) noexcept;
+    void on_lookup(const LookupActor* m) noexcept;
+    void on_heartbeat(const Heartbeat* m) noexcept;
+    void on_subscribe(const SubscribeRegistry* m) noexcept;
+    void on_unsubscribe(const UnsubscribeRegistry* m) noexcept;
+};
+
+} // namespace actors::registry
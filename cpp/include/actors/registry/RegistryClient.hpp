@@ -14,10 +14,27 @@ Copyright 2025 Vincent Maciejewski, & M2 Tech
 #include <memory>
 #include <mutex>
 #include <string>
-#include <thread>
+#include <unordered_map>
+#include <vector>
 #include "actors/ActorRef.hpp"
+#include "actors/act/TimerWheel.hpp"
 #include "actors/registry/RegistryMessages.hpp"
 
+// Default time between heartbeats (RegistryClient::set_heartbeat_interval())
+#ifndef ACTOR_HEARTBEAT_INTERVAL_MS
+#define ACTOR_HEARTBEAT_INTERVAL_MS 2000
+#endif
+
+// How long a lookup result stays cached; 0 disables the cache
+#ifndef ACTOR_LOOKUP_CACHE_TTL_MS
+#define ACTOR_LOOKUP_CACHE_TTL_MS 5000
+#endif
+
+// How long "not found" and "offline" results stay cached
+#ifndef ACTOR_LOOKUP_NEGATIVE_TTL_MS
+#define ACTOR_LOOKUP_NEGATIVE_TTL_MS 1000
+#endif
+
 namespace actors::registry {
 
 /**
@@ -63,12 +80,25 @@ public:
     explicit TimeoutError(const std::string& msg) : RegistryError("Timeout: " + msg) {}
 };
 
+/// Lookup cache counters (RegistryClient::cache_stats())
+struct LookupCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;           // Lookups that went to the registry
+    uint64_t invalidations = 0;    // Entries dropped by handle_update() / invalidate()
+};
+
 /**
  * RegistryClient - Client for communicating with GlobalRegistry
  *
  * The RegistryClient:
- * - Sends heartbeats every 2 seconds in a background thread
+ * - Sends heartbeats every 2 seconds (configurable) from the shared
+ *   TimerWheel, so it needs no thread of its own
  * - Provides sync lookup for actors by name
+ * - Caches lookup results: found actors for the positive TTL, "not found"
+ *   and "offline" for the shorter negative TTL. ActorMoved and
+ *   ManagerOffline from the registry drop entries early.
+ * - Subscribes to liveness events for chosen actors and managers; the
+ *   registry pushes them to listener()
  * - Handles registration of local actors
  *
  * Usage:
@@ -81,6 +111,11 @@ public:
  *
  *   // Lookup a remote actor
  *   auto endpoint = client.lookup("OtherActor");
+ *
+ *   // Get pushed events instead of finding out on the next lookup
+ *   receiver->register_actor(client.listener_name(), client.listener());
+ *   client.on_event([](const Message& e) { ... });
+ *   client.subscribe({"OtherActor"}, {}, "tcp://localhost:5001");
  */
 class RegistryClient {
 public:
@@ -100,17 +135,29 @@ public:
     RegistryClient(RegistryClient&&) = default;
     RegistryClient& operator=(RegistryClient&&) = default;
 
+    /// Called with each event the registry pushes (see subscribe())
+    using EventCallback = std::function<void(const Message& event)>;
+
     /**
-     * Start the heartbeat background thread.
-     * Sends Heartbeat messages every 2 seconds to keep actors marked as online.
+     * Start sending Heartbeat messages, one now and then one every
+     * heartbeat interval, to keep actors marked as online. They are sent
+     * from the TimerWheel thread.
      */
     void start_heartbeat();
 
     /**
-     * Stop the heartbeat background thread.
+     * Stop sending heartbeats. Returns once a heartbeat being sent has gone.
      */
     void stop_heartbeat();
 
+    /**
+     * Time between heartbeats (default ACTOR_HEARTBEAT_INTERVAL_MS). Each
+     * Heartbeat carries it, and the registry counts missed beats in units
+     * of it. Takes effect on the next start_heartbeat().
+     */
+    void set_heartbeat_interval(std::chrono::milliseconds interval) { heartbeat_interval_ = interval; }
+    std::chrono::milliseconds heartbeat_interval() const { return heartbeat_interval_; }
+
     /**
      * Register an actor with the GlobalRegistry.
      *
@@ -131,6 +178,19 @@ public:
      */
     void register_actor(const std::string& actor_name, const ActorRef& actor_ref);
 
+    /**
+     * Register several actors reachable at endpoint in one round trip.
+     * The registry handles each name separately, so some may fail while
+     * the rest are registered.
+     *
+     * @param actor_names Unique names for the actors
+     * @param endpoint ZMQ endpoint where the actors can be reached
+     * @return The actors the registry rejected, with reasons (empty on success)
+     * @throws TimeoutError if no response from registry
+     */
+    std::vector<RegisterActorsResult::Failure> register_actors(const std::vector<std::string>& actor_names,
+                                                               const std::string& endpoint);
+
     /**
      * Lookup an actor by name.
      *
@@ -152,24 +212,124 @@ public:
      */
     std::pair<std::string, bool> lookup_allow_offline(const std::string& actor_name);
 
+    /**
+     * Set how long lookup results are cached. positive applies to online
+     * actors, negative to "not found" and "offline" results. Zero turns
+     * caching off for that kind. Existing entries keep their expiry.
+     */
+    void set_cache_ttl(std::chrono::milliseconds positive, std::chrono::milliseconds negative);
+
+    /**
+     * Apply a registry push (ActorMoved, ManagerOffline, ManagerOnline)
+     * to the cache.
+     * Does not take ownership of m.
+     *
+     * @return true if m is a registry update
+     */
+    bool handle_update(const Message* m);
+
+    /// Drop the cached lookup for actor_name
+    void invalidate(const std::string& actor_name);
+
+    /// Drop cached lookups of every actor registered by manager_id
+    void invalidate_manager(const std::string& manager_id);
+
+    void clear_cache();
+
+    LookupCacheStats cache_stats() const;
+
+    /**
+     * Ask the registry to push ActorMoved for actor_names, and
+     * ManagerOnline / ManagerOffline for manager_ids and for the managers
+     * of actor_names. Events go to listener() as listener_name() at
+     * endpoint, so register listener() with the ZmqReceiver bound there.
+     * Subscribing again adds to the lists.
+     *
+     * @throws TimeoutError if no response from registry
+     */
+    void subscribe(const std::vector<std::string>& actor_names,
+                   const std::vector<std::string>& manager_ids,
+                   const std::string& endpoint);
+
+    /**
+     * Stop events for actor_names and manager_ids, or for everything when
+     * both are empty.
+     *
+     * @throws TimeoutError if no response from registry
+     */
+    void unsubscribe(const std::vector<std::string>& actor_names = {},
+                     const std::vector<std::string>& manager_ids = {});
+
+    /// Set the callback run for each pushed event, after the cache is updated
+    void on_event(EventCallback callback);
+
+    /**
+     * Actor that receives pushed events. It has no thread: each event is
+     * applied to the cache and passed to the on_event() callback on the
+     * thread that delivers it.
+     */
+    Actor* listener() const;
+
+    /// Name the registry sends events to: "$registry:<manager_id>"
+    std::string listener_name() const;
+
+    /**
+     * How long registration and lookup wait for the registry's reply
+     * (default ACTOR_ASK_TIMEOUT_MS) before throwing TimeoutError.
+     */
+    void set_timeout(std::chrono::milliseconds timeout) { timeout_ = timeout; }
+
     /**
      * Get the manager ID.
      */
     const std::string& manager_id() const { return manager_id_; }
 
     /**
-     * Check if heartbeat thread is running.
+     * Check if heartbeats are being sent.
      */
     bool is_heartbeat_running() const { return running_.load(); }
 
 private:
+    class Listener;
+
     std::string manager_id_;
     ActorRef registry_ref_;
     std::atomic<bool> running_{false};
-    std::unique_ptr<std::thread> heartbeat_thread_;
+    std::unique_ptr<Listener> listener_;  // Heartbeat timer target and event sink
+    TimerHandle heartbeat_timer_;
+    std::chrono::milliseconds heartbeat_interval_{ACTOR_HEARTBEAT_INTERVAL_MS};
     mutable std::mutex mutex_;
+    std::chrono::milliseconds timeout_{DEFAULT_ASK_TIMEOUT};
+
+    std::string subscriber_endpoint_;
+    EventCallback on_event_;
+    std::mutex event_mutex_;
+
+    // Cached lookup result
+    struct CacheEntry {
+        bool found = false;
+        bool online = false;
+        std::string endpoint;
+        std::string manager_id;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    std::unordered_map<std::string, CacheEntry> cache_;
+    mutable std::mutex cache_mutex_;
+    std::chrono::milliseconds positive_ttl_{ACTOR_LOOKUP_CACHE_TTL_MS};
+    std::chrono::milliseconds negative_ttl_{ACTOR_LOOKUP_NEGATIVE_TTL_MS};
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> invalidations_{0};
+
+    void send_heartbeat();
+    void on_push(const Message* m);
+
+    // Cached or fresh lookup of actor_name
+    CacheEntry resolve(const std::string& actor_name);
 
-    void heartbeat_loop();
+    // ask() the registry; nullptr if no reply within timeout_
+    std::unique_ptr<const Message> request(const Message* m);
 };
 
 } // namespace actors::registry
@@ -11,6 +11,7 @@ Copyright 2025 Vincent Maciejewski, & M2 Tech
 #include <string>
 #include <optional>
 #include <chrono>
+#include <vector>
 #include "actors/Message.hpp"
 #include "actors/ActorRef.hpp"
 
@@ -25,6 +26,14 @@ constexpr int MSG_LOOKUP_ACTOR = 904;
 constexpr int MSG_LOOKUP_RESULT = 905;
 constexpr int MSG_HEARTBEAT = 906;
 constexpr int MSG_HEARTBEAT_ACK = 907;
+constexpr int MSG_ACTOR_MOVED = 908;
+constexpr int MSG_MANAGER_OFFLINE = 909;
+constexpr int MSG_REGISTER_ACTORS = 910;
+constexpr int MSG_REGISTER_ACTORS_RESULT = 911;
+constexpr int MSG_SUBSCRIBE_REGISTRY = 912;
+constexpr int MSG_UNSUBSCRIBE_REGISTRY = 913;
+constexpr int MSG_SUBSCRIPTION_OK = 914;
+constexpr int MSG_MANAGER_ONLINE = 915;
 
 /**
  * RegisterActor - Manager registers an actor with GlobalRegistry
@@ -44,6 +53,49 @@ struct RegisterActor : public Message_N<MSG_REGISTER_ACTOR> {
     , actor_ref(std::move(ref)) {}
 };
 
+/**
+ * RegisterActors - Register many actors in one round trip
+ *
+ * Sent once by Manager::init() with every managed actor. Each actor is
+ * registered as if by its own RegisterActor; one failing does not stop
+ * the rest. GlobalRegistry replies with RegisterActorsResult.
+ */
+struct RegisterActors : public Message_N<MSG_REGISTER_ACTORS> {
+  struct Entry {
+    std::string actor_name;
+    std::string actor_endpoint;  // ZMQ endpoint for reaching this actor
+  };
+
+  std::string manager_id;
+  std::vector<Entry> actors;
+
+  RegisterActors() = default;
+  RegisterActors(std::string mgr, std::vector<Entry> entries)
+    : manager_id(std::move(mgr))
+    , actors(std::move(entries)) {}
+};
+
+/**
+ * RegisterActorsResult - Reply to RegisterActors
+ *
+ * registered counts the actors that were registered; failed lists the
+ * others with the reason for each (empty when all succeeded).
+ */
+struct RegisterActorsResult : public Message_N<MSG_REGISTER_ACTORS_RESULT> {
+  struct Failure {
+    std::string actor_name;
+    std::string reason;
+  };
+
+  size_t registered = 0;
+  std::vector<Failure> failed;
+
+  RegisterActorsResult() = default;
+  RegisterActorsResult(size_t ok, std::vector<Failure> failures)
+    : registered(ok)
+    , failed(std::move(failures)) {}
+};
+
 /**
  * UnregisterActor - Remove an actor from the registry
  *
@@ -103,34 +155,41 @@ struct LookupActor : public Message_N<MSG_LOOKUP_ACTOR> {
  * Contains the ActorRef if found, and online status.
  * If actor_ref is empty, the actor was not found.
  * If online is false, the actor's Manager has missed heartbeats.
+ * manager_id names the Manager that registered it (empty if unknown).
  */
 struct LookupResult : public Message_N<MSG_LOOKUP_RESULT> {
   std::string actor_name;
   std::optional<ActorRef> actor_ref;
   bool online;
+  std::string manager_id;
 
   LookupResult() : online(false) {}
-  LookupResult(std::string name, std::optional<ActorRef> ref, bool is_online)
+  LookupResult(std::string name, std::optional<ActorRef> ref, bool is_online,
+               std::string mgr = {})
     : actor_name(std::move(name))
     , actor_ref(std::move(ref))
-    , online(is_online) {}
+    , online(is_online)
+    , manager_id(std::move(mgr)) {}
 };
 
 /**
  * Heartbeat - Manager health check
  *
- * Managers send this every 2 seconds.
- * GlobalRegistry marks Manager offline after 6 seconds without heartbeat.
+ * Managers send this every interval_ms (2 seconds by default).
+ * GlobalRegistry marks a Manager offline once it misses its configured
+ * number of intervals (3 by default, so 6 seconds).
  */
 struct Heartbeat : public Message_N<MSG_HEARTBEAT> {
   std::string manager_id;
   uint64_t timestamp;  // milliseconds since epoch
+  uint32_t interval_ms = 2000;
 
   Heartbeat() : timestamp(0) {}
-  explicit Heartbeat(std::string mgr)
+  explicit Heartbeat(std::string mgr, uint32_t interval = 2000)
     : manager_id(std::move(mgr))
     , timestamp(std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count()) {}
+        std::chrono::steady_clock::now().time_since_epoch()).count())
+    , interval_ms(interval) {}
 };
 
 /**
@@ -140,4 +199,106 @@ struct HeartbeatAck : public Message_N<MSG_HEARTBEAT_ACK> {
   HeartbeatAck() = default;
 };
 
+/**
+ * ActorMoved - Pushed by GlobalRegistry when an actor is unregistered or
+ * registered again (possibly by another Manager, at another endpoint)
+ *
+ * Clients drop any cached lookup for actor_name (RegistryClient::handle_update()).
+ * actor_endpoint is the new endpoint, or empty if the actor is gone.
+ */
+struct ActorMoved : public Message_N<MSG_ACTOR_MOVED> {
+  std::string actor_name;
+  std::string actor_endpoint;
+
+  ActorMoved() = default;
+  explicit ActorMoved(std::string name, std::string endpoint = {})
+    : actor_name(std::move(name))
+    , actor_endpoint(std::move(endpoint)) {}
+};
+
+/**
+ * ManagerOffline - Pushed by GlobalRegistry when a Manager misses its
+ * heartbeats
+ *
+ * Clients drop cached lookups of every actor that Manager registered.
+ * actor_names lists them, for subscribers that watch actors rather than
+ * the Manager.
+ */
+struct ManagerOffline : public Message_N<MSG_MANAGER_OFFLINE> {
+  std::string manager_id;
+  std::vector<std::string> actor_names;
+
+  ManagerOffline() = default;
+  explicit ManagerOffline(std::string mgr, std::vector<std::string> actors = {})
+    : manager_id(std::move(mgr))
+    , actor_names(std::move(actors)) {}
+};
+
+/**
+ * ManagerOnline - Pushed by GlobalRegistry when a Manager sends its first
+ * heartbeat or registration, or comes back after being offline
+ */
+struct ManagerOnline : public Message_N<MSG_MANAGER_ONLINE> {
+  std::string manager_id;
+
+  ManagerOnline() = default;
+  explicit ManagerOnline(std::string mgr)
+    : manager_id(std::move(mgr)) {}
+};
+
+/**
+ * SubscribeRegistry - Ask GlobalRegistry to push liveness events
+ *
+ * The registry sends ActorMoved for the listed actors, and ManagerOnline /
+ * ManagerOffline for the listed managers and for the managers of the
+ * listed actors, to the actor named subscriber at subscriber_endpoint.
+ * Subscribing again adds to the lists. GlobalRegistry replies with
+ * SubscriptionOk.
+ */
+struct SubscribeRegistry : public Message_N<MSG_SUBSCRIBE_REGISTRY> {
+  std::string subscriber;
+  std::string subscriber_endpoint;
+  std::vector<std::string> actor_names;
+  std::vector<std::string> manager_ids;
+
+  SubscribeRegistry() = default;
+  SubscribeRegistry(std::string name, std::string endpoint,
+                    std::vector<std::string> actors, std::vector<std::string> managers)
+    : subscriber(std::move(name))
+    , subscriber_endpoint(std::move(endpoint))
+    , actor_names(std::move(actors))
+    , manager_ids(std::move(managers)) {}
+};
+
+/**
+ * UnsubscribeRegistry - Stop events for the listed actors and managers,
+ * or for everything when both lists are empty. Replied to with
+ * SubscriptionOk.
+ */
+struct UnsubscribeRegistry : public Message_N<MSG_UNSUBSCRIBE_REGISTRY> {
+  std::string subscriber;
+  std::string subscriber_endpoint;
+  std::vector<std::string> actor_names;
+  std::vector<std::string> manager_ids;
+
+  UnsubscribeRegistry() = default;
+  UnsubscribeRegistry(std::string name, std::string endpoint,
+                      std::vector<std::string> actors = {}, std::vector<std::string> managers = {})
+    : subscriber(std::move(name))
+    , subscriber_endpoint(std::move(endpoint))
+    , actor_names(std::move(actors))
+    , manager_ids(std::move(managers)) {}
+};
+
+/**
+ * SubscriptionOk - Reply to SubscribeRegistry and UnsubscribeRegistry
+ */
+struct SubscriptionOk : public Message_N<MSG_SUBSCRIPTION_OK> {
+  std::string subscriber;
+
+  SubscriptionOk() = default;
+  explicit SubscriptionOk(std::string name)
+    : subscriber(std::move(name)) {}
+};
+
 } // namespace actors::registry
@@ -0,0 +1,189 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+RegistryServer - Serves GlobalRegistry to JSON clients over a ZeroMQ
+REP socket. Implemented as an Actor that polls the socket.
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <zmq.hpp>
+#include <nlohmann/json.hpp>
+#include "actors/Actor.hpp"
+#include "actors/msg/Start.hpp"
+#include "actors/msg/Continue.hpp"
+#include "actors/registry/GlobalRegistry.hpp"
+
+namespace actors::registry {
+
+/**
+ * Answer one request from a Python, Rust or other JSON client. Requests
+ * and replies are flat objects with a "message_type" and the message's
+ * fields, the format the Python registry's run_registry() speaks.
+ * Throws nlohmann::json::exception if a field is missing.
+ */
+inline nlohmann::json handle_json_request(GlobalRegistry& registry, const nlohmann::json& request) {
+    using nlohmann::json;
+    const std::string type = request.value("message_type", "");
+
+    if (type == "RegisterActor") {
+        const std::string actor_name = request.at("actor_name").get<std::string>();
+        std::string reason = registry.register_actor(request.at("manager_id").get<std::string>(),
+                                                     actor_name,
+                                                     request.at("actor_endpoint").get<std::string>());
+        if (!reason.empty()) {
+            return {{"message_type", "RegistrationFailed"}, {"actor_name", actor_name}, {"reason", reason}};
+        }
+        return {{"message_type", "RegistrationOk"}, {"actor_name", actor_name}};
+    }
+
+    if (type == "RegisterActors") {
+        RegisterActors batch;
+        batch.manager_id = request.at("manager_id").get<std::string>();
+        for (const auto& a : request.at("actors")) {
+            batch.actors.push_back({a.at("actor_name").get<std::string>(),
+                                    a.at("actor_endpoint").get<std::string>()});
+        }
+        auto failed = registry.register_actors(batch);
+        json failures = json::array();
+        for (const auto& f : failed) {
+            failures.push_back({{"actor_name", f.actor_name}, {"reason", f.reason}});
+        }
+        return {{"message_type", "RegisterActorsResult"},
+                {"registered", batch.actors.size() - failed.size()},
+                {"failed", failures}};
+    }
+
+    if (type == "UnregisterActor") {
+        const std::string actor_name = request.at("actor_name").get<std::string>();
+        registry.unregister_actor(actor_name);
+        return {{"message_type", "RegistrationOk"}, {"actor_name", actor_name}};
+    }
+
+    if (type == "LookupActor") {
+        const std::string actor_name = request.at("actor_name").get<std::string>();
+        auto found = registry.lookup(actor_name);
+        json reply = {{"message_type", "LookupResult"}, {"actor_name", actor_name},
+                      {"endpoint", nullptr}, {"online", found.online}};
+        if (found.found) {
+            reply["endpoint"] = found.endpoint;
+            reply["manager_id"] = found.manager_id;
+        }
+        return reply;
+    }
+
+    if (type == "Heartbeat") {
+        registry.heartbeat(request.at("manager_id").get<std::string>(),
+                           request.value("interval_ms", uint32_t(0)));
+        return {{"message_type", "HeartbeatAck"}};
+    }
+
+    if (type == "SubscribeRegistry" || type == "UnsubscribeRegistry") {
+        const std::string subscriber = request.at("subscriber").get<std::string>();
+        const std::string endpoint = request.at("subscriber_endpoint").get<std::string>();
+        auto actors = request.value("actor_names", std::vector<std::string>{});
+        auto managers = request.value("manager_ids", std::vector<std::string>{});
+        if (type == "SubscribeRegistry") {
+            registry.subscribe(subscriber, endpoint, actors, managers);
+        } else {
+            registry.unsubscribe(subscriber, endpoint, actors, managers);
+        }
+        return {{"message_type", "SubscriptionOk"}, {"subscriber", subscriber}};
+    }
+
+    return {{"error", "Unknown message type: " + type}};
+}
+
+/**
+ * RegistryServer - Actor that answers JSON registry requests
+ *
+ * Binds a REP socket and polls it from its own mailbox with Continue
+ * messages, like ZmqReceiver. Every request gets exactly one reply;
+ * malformed requests get {"error": ...}.
+ *
+ * Usage:
+ *   auto* registry = new GlobalRegistry();
+ *   mgr.manage(registry);
+ *   mgr.manage(new RegistryServer("tcp://0.0.0.0:5555", registry));
+ */
+class RegistryServer : public Actor {
+public:
+    RegistryServer(const std::string& bind_endpoint, GlobalRegistry* registry)
+        : context_(1)
+        , socket_(context_, zmq::socket_type::rep)
+        , registry_(registry)
+        , running_(false) {
+        strncpy(name, "RegistryServer", sizeof(name));
+
+        MESSAGE_HANDLER(msg::Start, on_start);
+        MESSAGE_HANDLER(msg::Continue, on_continue);
+
+        std::string bind_addr = bind_endpoint;
+        // Convert tcp://*:PORT to tcp://0.0.0.0:PORT
+        size_t pos = bind_addr.find("*:");
+        if (pos != std::string::npos) {
+            bind_addr.replace(pos, 1, "0.0.0.0");
+        }
+        socket_.bind(bind_addr);
+
+        // Set receive timeout for non-blocking polls
+        socket_.set(zmq::sockopt::rcvtimeo, 10);  // 10ms timeout
+    }
+
+    uint64_t requests() const { return requests_.load(std::memory_order_relaxed); }
+
+protected:
+    void end() override {
+        running_ = false;
+        socket_.close();
+    }
+
+private:
+    zmq::context_t context_;
+    zmq::socket_t socket_;
+    GlobalRegistry* registry_;
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> requests_{0};
+
+    void on_start(const msg::Start*) noexcept {
+        running_ = true;
+        send(new msg::Continue(), this);
+    }
+
+    void on_continue(const msg::Continue*) noexcept {
+        if (!running_) return;
+
+        try {
+            zmq::message_t request;
+            if (socket_.recv(request, zmq::recv_flags::none).has_value()) {
+                requests_.fetch_add(1, std::memory_order_relaxed);
+                std::string out = answer(request).dump();
+                socket_.send(zmq::buffer(out.data(), out.size()), zmq::send_flags::none);
+            }
+        } catch (const zmq::error_t& e) {
+            // Timeouts are expected; anything else ends this poll
+        }
+
+        if (running_) {
+            send(new msg::Continue(), this);
+        }
+    }
+
+    nlohmann::json answer(const zmq::message_t& request) {
+        try {
+            auto data = static_cast<const char*>(request.data());
+            return handle_json_request(*registry_, nlohmann::json::parse(data, data + request.size()));
+        } catch (const nlohmann::json::exception& e) {
+            return {{"error", std::string("Bad request: ") + e.what()}};
+        }
+    }
+};
+
+} // namespace actors::registry
@@ -0,0 +1,74 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+CreditGrant message - credit-based flow control between C++ peers.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "actors/Message.hpp"
+#include "actors/remote/Serialization.hpp"
+
+namespace actors::msg {
+
+/**
+ * CreditGrant - Sent by a ZmqReceiver to a peer whose messages carry a
+ * flow tag (see ZmqSender::set_flow_control())
+ *
+ * Counts are cumulative over the sender's flow session: the peer may
+ * have sent up to `limit` tagged messages to `endpoint`, of which
+ * `consumed` have arrived. Always travels as JSON, addressed to "$flow".
+ * Never delivered to an actor.
+ *
+ * Message ID: 14 (reserved for internal use)
+ */
+class CreditGrant : public Message_N<14> {
+public:
+    std::string endpoint;       // Endpoint string the peer sends to
+    std::uint64_t session = 0;  // Sender's flow session (restarts start over)
+    std::uint64_t consumed = 0;
+    std::uint64_t limit = 0;
+
+    CreditGrant() = default;
+
+    CreditGrant(std::string ep, std::uint64_t s, std::uint64_t c, std::uint64_t l)
+        : endpoint(std::move(ep))
+        , session(s)
+        , consumed(c)
+        , limit(l) {}
+};
+
+} // namespace actors::msg
+
+// Register CreditGrant for remote serialization (JSON only)
+namespace {
+    static bool CreditGrant_registered_ = []() {
+        actors::serialization::register_message(14, "CreditGrant",
+            // Serialize
+            [](const actors::Message* m) -> nlohmann::json {
+                const actors::msg::CreditGrant* msg = static_cast<const actors::msg::CreditGrant*>(m);
+                return nlohmann::json{
+                    {"endpoint", msg->endpoint},
+                    {"session", msg->session},
+                    {"consumed", msg->consumed},
+                    {"limit", msg->limit}
+                };
+            },
+            // Deserialize
+            [](const nlohmann::json& j) -> actors::Message* {
+                return new actors::msg::CreditGrant(
+                    j["endpoint"].get<std::string>(),
+                    j["session"].get<std::uint64_t>(),
+                    j["consumed"].get<std::uint64_t>(),
+                    j["limit"].get<std::uint64_t>()
+                );
+            });
+        return true;
+    }();
+}
@@ -0,0 +1,82 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+Compile-time field descriptors for remote messages and the structs they
+contain. Serialization.hpp and Wire.hpp generate JSON and binary codecs
+from them.
+
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace actors::serialization {
+
+/**
+ * Field - Wire name plus member pointer for one field of C
+ */
+template <class C, class T>
+struct Field {
+    using owner = C;
+    using type = T;
+    std::string_view name;
+    T C::* member;
+};
+
+template <class C, class T>
+constexpr Field<C, T> field(std::string_view name, T C::* member) noexcept {
+    return {name, member};
+}
+
+/**
+ * ACTOR_FIELD - Describe a member under its own name
+ *
+ * Usage:
+ *   struct Level {
+ *       double price = 0;
+ *       std::int64_t qty = 0;
+ *       static constexpr auto fields() {
+ *           return std::make_tuple(ACTOR_FIELD(Level, price), ACTOR_FIELD(Level, qty));
+ *       }
+ *   };
+ */
+#define ACTOR_FIELD(Type, member) actors::serialization::field(#member, &Type::member)
+
+/// A type that lists its fields with a static fields() function
+template <class T>
+concept has_fields = requires { T::fields(); };
+
+template <class T> struct is_std_vector : std::false_type {};
+template <class T, class A> struct is_std_vector<std::vector<T, A>> : std::true_type {};
+
+template <class T> struct is_std_array : std::false_type {};
+template <class T, std::size_t N> struct is_std_array<std::array<T, N>> : std::true_type {};
+
+/// True if T is, or holds in a vector/array, a described struct
+template <class T>
+constexpr bool contains_fields() {
+    if constexpr (has_fields<T>)
+        return true;
+    else if constexpr (is_std_vector<T>::value || is_std_array<T>::value)
+        return contains_fields<typename T::value_type>();
+    else
+        return false;
+}
+
+/// Call fn(field) for every descriptor in a fields() tuple, in order
+template <class Tuple, class Fn>
+constexpr void for_each_field(const Tuple& fields, Fn&& fn) {
+    std::apply([&](const auto&... f) { (fn(f), ...); }, fields);
+}
+
+} // namespace actors::serialization
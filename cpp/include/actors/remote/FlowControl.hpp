@@ -0,0 +1,317 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+FlowControl - Credit windows for remote senders and the receiver side ledger.
+
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "actors/Actor.hpp"
+
+// Credits a ZmqReceiver lets each flow-controlled sender have outstanding.
+// Keep it at or below the sender's ZMQ_SNDHWM (1000) so a send never blocks.
+#ifndef ACTOR_FLOW_WINDOW
+#define ACTOR_FLOW_WINDOW 512
+#endif
+
+// Target mailbox depth at which a ZmqReceiver stops granting credits
+#ifndef ACTOR_FLOW_MAX_DEPTH
+#define ACTOR_FLOW_MAX_DEPTH 4096
+#endif
+
+// Messages a sender holds per endpoint while out of credits, then rejects
+#ifndef ACTOR_FLOW_MAX_QUEUED
+#define ACTOR_FLOW_MAX_QUEUED 4096
+#endif
+
+namespace actors {
+
+/**
+ * FlowPolicy - Credit-based flow control for one endpoint (off unless set)
+ *
+ * Once the peer's ZmqReceiver has granted credits, each message to the
+ * endpoint uses one. Out of credits, messages are held in order, up to
+ * max_queued, and sent as new credits arrive; beyond that they are
+ * dropped and counted as rejected. max_queued = 0 rejects at once.
+ */
+struct FlowPolicy {
+    size_t max_queued = ACTOR_FLOW_MAX_QUEUED;
+};
+
+/// Flow control counters for one endpoint (see ZmqSender::flow_stats())
+struct FlowStats {
+    bool enabled = false;       // set_flow_control() is in effect
+    bool metered = false;       // The peer has granted credits
+    std::uint64_t sent = 0;     // Tagged messages handed to zmq
+    std::uint64_t acked = 0;    // Of those, known to have arrived
+    std::uint64_t limit = 0;    // sent may grow up to this
+    size_t queued = 0;          // Held for credits
+    std::uint64_t rejected = 0; // Dropped with the queue full
+
+    std::uint64_t in_flight() const noexcept { return sent > acked ? sent - acked : 0; }
+};
+
+/**
+ * CreditWindow - Sender side of one flow-controlled endpoint
+ *
+ * Counts are cumulative, as in CreditGrant, so a lost or reordered grant
+ * only delays sends. Until the first grant the window is unmetered:
+ * peers that do not grant (Rust, Python, or receivers with flow control
+ * off) see no change. Not thread-safe; ZmqSenderShard locks around it.
+ *
+ * Item is what is held while out of credits (the shard keeps zmq parts).
+ */
+template <class Item>
+class CreditWindow {
+public:
+    explicit CreditWindow(const FlowPolicy& policy = {}) : policy_(policy) {}
+
+    /// (Re)enable with policy; counters carry on from before
+    void set_policy(const FlowPolicy& policy) {
+        policy_ = policy;
+        enabled_ = true;
+    }
+
+    /// True if a message may go now: credit left and nothing held before it
+    bool can_send() const noexcept {
+        return !metered_ || (held_.empty() && sent_ < limit_);
+    }
+
+    /// Count parts messages handed to zmq
+    void sent(size_t parts) noexcept { sent_ += parts; }
+
+    /**
+     * Hold item (parts messages) until credits arrive
+     * @return false, counting it as rejected, if max_queued are held
+     */
+    bool hold(Item&& item, size_t parts) {
+        if (queued_ + parts > policy_.max_queued) {
+            rejected_ += parts;
+            return false;
+        }
+        held_.push_back({std::move(item), parts});
+        queued_ += parts;
+        return true;
+    }
+
+    /// Apply a grant; returns false for a stale one (other session)
+    bool grant(std::uint64_t session, std::uint64_t consumed, std::uint64_t limit) noexcept {
+        if (session != session_)
+            return false;
+        metered_ = true;
+        acked_ = std::max(acked_, std::min(consumed, sent_));
+        limit_ = std::max(limit_, limit);
+        return true;
+    }
+
+    /// Pass held items to send(Item&) while credits last, oldest first
+    template <class Send>
+    void release(Send&& send) {
+        while (!held_.empty() && (!metered_ || sent_ < limit_)) {
+            Held h = std::move(held_.front());
+            held_.pop_front();
+            queued_ -= h.parts;
+            sent_ += h.parts;
+            send(h.item);
+        }
+    }
+
+    /**
+     * Stop metering and hand every held item to send(Item&). Later grants
+     * still update the counters, so set_policy() can pick up from them.
+     */
+    template <class Send>
+    void disable(Send&& send) {
+        enabled_ = false;
+        metered_ = false;
+        release(send);
+    }
+
+    bool enabled() const noexcept { return enabled_; }
+
+    std::uint64_t session() const noexcept { return session_; }
+    void set_session(std::uint64_t session) noexcept { session_ = session; }
+
+    FlowStats stats() const noexcept {
+        FlowStats s;
+        s.enabled = enabled_;
+        s.metered = metered_;
+        s.sent = sent_;
+        s.acked = acked_;
+        s.limit = limit_;
+        s.queued = queued_;
+        s.rejected = rejected_;
+        return s;
+    }
+
+private:
+    struct Held {
+        Item item;
+        size_t parts;
+    };
+
+    FlowPolicy policy_;
+    std::deque<Held> held_;
+    std::uint64_t session_ = 0;
+    bool enabled_ = true;
+    bool metered_ = false;
+    std::uint64_t sent_ = 0;
+    std::uint64_t acked_ = 0;
+    std::uint64_t limit_ = 0;
+    size_t queued_ = 0;
+    std::uint64_t rejected_ = 0;
+};
+
+/**
+ * CreditLedger - Receiver side: credits owed to each flow-tagged sender
+ *
+ * A sender is known by the endpoint replies go to, the endpoint it sent
+ * to, and its flow session. Each tagged message counts as consumed. Once
+ * a sender has used half its window, it is granted
+ * min(window, max_depth - depth) more, where depth is the mailbox length
+ * of the target of its latest message. A grant that small (under a
+ * quarter of the window) is withheld instead, and recheck() tries again
+ * as the mailbox drains. Thread-safe.
+ */
+class CreditLedger {
+public:
+    struct Grant {
+        std::string reply_to;   // Where the CreditGrant goes
+        std::string endpoint;   // As the sender names us
+        std::uint64_t session = 0;
+        std::uint64_t consumed = 0;
+        std::uint64_t limit = 0;
+    };
+
+    explicit CreditLedger(size_t window = ACTOR_FLOW_WINDOW, size_t max_depth = ACTOR_FLOW_MAX_DEPTH) {
+        configure(window, max_depth);
+    }
+
+    /// window = 0 grants nothing, so senders stay unmetered
+    void configure(size_t window, size_t max_depth) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        window_ = window;
+        max_depth_ = std::max<size_t>(max_depth, 1);
+        step_ = std::max<size_t>(std::min(window_, max_depth_) / 4, 1);
+    }
+
+    size_t window() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return window_;
+    }
+
+    /**
+     * Count one message from a sender, bound for target (nullptr if none)
+     * @return true if out holds a grant to send back now
+     */
+    bool consume(std::string_view reply_to, std::string_view endpoint, std::uint64_t session,
+                 const Actor* target, Grant& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (window_ == 0)
+            return false;
+        key_.assign(reply_to);
+        key_ += '\n';
+        key_.append(endpoint);
+        auto it = peers_.find(key_);
+        if (it == peers_.end())
+            it = peers_.emplace(key_, Peer{std::string(reply_to), std::string(endpoint)}).first;
+        Peer& p = it->second;
+        if (p.session != session) {
+            // The sender restarted its session: its counts start over
+            if (p.withheld)
+                withheld_.fetch_sub(1, std::memory_order_relaxed);
+            p = Peer{std::move(p.reply_to), std::move(p.endpoint), session};
+        }
+        p.consumed++;
+        p.target = target;
+        if (p.withheld || p.consumed + window_ / 2 < p.limit)
+            return false;
+        return offer(p, out);
+    }
+
+    /// Grants withheld for a deep mailbox that can go out now
+    void recheck(std::vector<Grant>& out) {
+        if (withheld_.load(std::memory_order_relaxed) == 0)
+            return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [key, p] : peers_) {
+            if (!p.withheld)
+                continue;
+            p.withheld = false;
+            withheld_.fetch_sub(1, std::memory_order_relaxed);
+            Grant g;
+            if (offer(p, g))
+                out.push_back(std::move(g));
+        }
+    }
+
+    /// Senders currently waiting for their target to drain (lock-free)
+    size_t withheld() const noexcept { return withheld_.load(std::memory_order_relaxed); }
+
+    size_t peers() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return peers_.size();
+    }
+
+    /// Forget target, e.g. when it is unregistered
+    void forget(const Actor* target) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [key, p] : peers_)
+            if (p.target == target)
+                p.target = nullptr;
+    }
+
+private:
+    struct Peer {
+        std::string reply_to;
+        std::string endpoint;
+        std::uint64_t session = 0;
+        std::uint64_t consumed = 0;
+        std::uint64_t limit = 0;        // Last limit granted
+        const Actor* target = nullptr;  // Of the latest message
+        bool withheld = false;
+    };
+
+    // Grant p what its target's mailbox has room for. Caller holds mutex_.
+    bool offer(Peer& p, Grant& out) {
+        size_t depth = p.target ? p.target->queue_length() : 0;
+        size_t room = depth >= max_depth_ ? 0 : std::min(window_, max_depth_ - depth);
+        if (room < step_) {
+            p.withheld = true;
+            withheld_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        p.limit = p.consumed + room;
+        out.reply_to = p.reply_to;
+        out.endpoint = p.endpoint;
+        out.session = p.session;
+        out.consumed = p.consumed;
+        out.limit = p.limit;
+        return true;
+    }
+
+    size_t window_ = ACTOR_FLOW_WINDOW;
+    size_t max_depth_ = ACTOR_FLOW_MAX_DEPTH;
+    size_t step_ = 1;
+    std::unordered_map<std::string, Peer> peers_;
+    std::string key_;  // Scratch for lookups
+    std::atomic<size_t> withheld_{0};
+    mutable std::mutex mutex_;
+};
+
+} // namespace actors
@@ -0,0 +1,164 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+ProxyCache - Bounded LRU cache of reply proxies keyed by remote sender.
+
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Reply proxies kept per ZmqReceiver (distinct sender actor + endpoint)
+#ifndef ACTOR_REPLY_PROXY_CACHE
+#define ACTOR_REPLY_PROXY_CACHE 1024
+#endif
+
+namespace actors {
+
+/**
+ * ProxyCache - One proxy per (sender actor, sender endpoint)
+ *
+ * get() returns the cached proxy, creating it on a miss. A hit does a
+ * heterogeneous hash lookup on the two string views and relinks an
+ * intrusive LRU list, so it allocates nothing.
+ *
+ * When full, the least recently used proxy is evicted. Messages still
+ * queued or being handled may carry it as their sender, so a proxy whose
+ * in_use() is true is retired rather than deleted, and collect() frees
+ * it once no delivery holds it. An actor that keeps reply_to past its
+ * message (for example to publish to remote subscribers) should send
+ * through an ActorRef instead.
+ */
+template <class Proxy>
+class ProxyCache {
+    struct Key {
+        std::string actor;
+        std::string endpoint;
+    };
+    using KeyView = std::pair<std::string_view, std::string_view>;
+
+    struct Hash {
+        using is_transparent = void;
+        size_t operator()(const KeyView& k) const noexcept {
+            size_t h = std::hash<std::string_view>{}(k.first);
+            return h ^ (std::hash<std::string_view>{}(k.second) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+        }
+        size_t operator()(const Key& k) const noexcept { return (*this)(KeyView(k.actor, k.endpoint)); }
+    };
+
+    struct Eq {
+        using is_transparent = void;
+        static KeyView view(const Key& k) noexcept { return KeyView(k.actor, k.endpoint); }
+        static KeyView view(const KeyView& k) noexcept { return k; }
+        template <class A, class B>
+        bool operator()(const A& a, const B& b) const noexcept { return view(a) == view(b); }
+    };
+
+    struct Node {
+        std::unique_ptr<Proxy> proxy;
+        Node* prev = nullptr;  // towards most recently used
+        Node* next = nullptr;
+        const Key* key = nullptr;
+    };
+
+public:
+    explicit ProxyCache(size_t capacity = ACTOR_REPLY_PROXY_CACHE)
+        : capacity_(capacity > 0 ? capacity : 1) {
+        map_.reserve(capacity_);
+    }
+
+    ProxyCache(const ProxyCache&) = delete;
+    ProxyCache& operator=(const ProxyCache&) = delete;
+
+    /// Cached proxy for the sender, or make(actor, endpoint) on a miss
+    template <class Make>
+    Proxy* get(std::string_view actor, std::string_view endpoint, Make&& make) {
+        auto it = map_.find(KeyView(actor, endpoint));
+        if (it != map_.end()) {
+            touch(&it->second);
+            return it->second.proxy.get();
+        }
+
+        if (map_.size() >= capacity_)
+            evict();
+
+        auto [ins, ok] = map_.emplace(Key{std::string(actor), std::string(endpoint)}, Node{});
+        (void)ok;
+        Node* n = &ins->second;
+        n->key = &ins->first;
+        n->proxy.reset(make(n->key->actor, n->key->endpoint));
+        link_front(n);
+        return n->proxy.get();
+    }
+
+    /// Change the bound; evicts down to it right away
+    void set_capacity(size_t capacity) {
+        capacity_ = capacity > 0 ? capacity : 1;
+        while (map_.size() > capacity_)
+            evict();
+    }
+
+    /// Free the retired proxies no delivery holds any more
+    void collect() {
+        std::erase_if(retired_, [](const std::unique_ptr<Proxy>& p) { return !p->in_use(); });
+    }
+
+    size_t capacity() const noexcept { return capacity_; }
+    size_t size() const noexcept { return map_.size(); }
+    size_t retired() const noexcept { return retired_.size(); }
+    size_t evictions() const noexcept { return evictions_; }
+
+private:
+    void unlink(Node* n) noexcept {
+        (n->prev ? n->prev->next : head_) = n->next;
+        (n->next ? n->next->prev : tail_) = n->prev;
+        n->prev = n->next = nullptr;
+    }
+
+    void link_front(Node* n) noexcept {
+        n->next = head_;
+        if (head_)
+            head_->prev = n;
+        head_ = n;
+        if (!tail_)
+            tail_ = n;
+    }
+
+    void touch(Node* n) noexcept {
+        if (head_ == n)
+            return;
+        unlink(n);
+        link_front(n);
+    }
+
+    void evict() {
+        Node* victim = tail_;
+        if (!victim)
+            return;
+        unlink(victim);
+        if (victim->proxy->in_use())
+            retired_.push_back(std::move(victim->proxy));
+        map_.erase(map_.find(KeyView(victim->key->actor, victim->key->endpoint)));
+        evictions_++;
+    }
+
+    size_t capacity_;
+    std::unordered_map<Key, Node, Hash, Eq> map_;
+    Node* head_ = nullptr;
+    Node* tail_ = nullptr;
+    std::vector<std::unique_ptr<Proxy>> retired_;  // Evicted while in use
+    size_t evictions_ = 0;
+};
+
+} // namespace actors
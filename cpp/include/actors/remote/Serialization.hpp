@@ -5,19 +5,29 @@ THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
 Copyright 2025 Vincent Maciejewski, & M2 Tech
 
 Remote message serialization for ZeroMQ communication.
-Uses nlohmann/json for JSON serialization.
+Uses nlohmann/json for JSON serialization, plus a compact binary codec
+(see Wire.hpp) for messages whose fields all have a binary encoding.
+Codecs for described types (see Fields.hpp) are generated at compile time.
 
 */
 
 #pragma once
 
+#include <atomic>
+#include <bitset>
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <mutex>
+#include <tuple>
+#include <vector>
 #include <nlohmann/json.hpp>
+#include "actors/HandlerTable.hpp"
 #include "actors/Message.hpp"
+#include "actors/remote/Fields.hpp"
+#include "actors/remote/Wire.hpp"
 
 namespace actors::serialization {
 
@@ -26,18 +36,67 @@ using json = nlohmann::json;
 // Function types for serialize/deserialize
 using SerializeFn = std::function<json(const Message*)>;
 using DeserializeFn = std::function<Message*(const json&)>;
+using EncodeFn = std::function<void(const Message*, wire::BinaryWriter&)>;
+using DecodeFn = std::function<Message*(wire::BinaryReader&)>;
+
+/**
+ * Codec - Generated functions for a described message type
+ *
+ * Plain function pointers: calling one is a single indirect call with no
+ * std::function in between. encode/decode are nullptr for types without a
+ * binary encoding.
+ */
+struct Codec {
+    json (*to_json)(const Message*) = nullptr;
+    Message* (*from_json)(const json&) = nullptr;
+    void (*encode)(const Message*, wire::BinaryWriter&) = nullptr;
+    Message* (*decode)(wire::BinaryReader&) = nullptr;
+};
 
 /**
  * Registry entry for a message type
+ * A generated codec takes precedence over the std::function slots, which
+ * hold hand-written functions. Both binary slots may be empty for types
+ * without a binary codec.
  */
 struct RegistryEntry {
     std::string type_name;
     SerializeFn serialize;
     DeserializeFn deserialize;
+    EncodeFn encode;
+    DecodeFn decode;
+    Codec codec;
+
+    bool has_json() const noexcept {
+        return (codec.to_json || serialize) && (codec.from_json || deserialize);
+    }
+    bool has_binary() const noexcept {
+        return (codec.encode || encode) && (codec.decode || decode);
+    }
+    json to_json(const Message* m) const {
+        return codec.to_json ? codec.to_json(m) : serialize(m);
+    }
+    Message* from_json(const json& j) const {
+        return codec.from_json ? codec.from_json(j) : deserialize(j);
+    }
+    void write(const Message* m, wire::BinaryWriter& w) const {
+        codec.encode ? codec.encode(m, w) : encode(m, w);
+    }
+    Message* read(wire::BinaryReader& r) const {
+        return codec.decode ? codec.decode(r) : decode(r);
+    }
 };
 
 /**
  * Global message registry singleton
+ *
+ * Registration takes a mutex. Once seal() has been called (ZmqSender and
+ * ZmqReceiver do so on Start, i.e. at Manager::init()), lookups read an
+ * immutable table - a HandlerTable indexed by message ID plus a name index
+ * over interned type names - without locking. Registering after seal()
+ * still works: it rebuilds and republishes the table. Entries are never
+ * modified or freed once published, so pointers returned by find() stay
+ * valid for the life of the process.
  */
 class MessageRegistry {
 public:
@@ -59,32 +118,123 @@ public:
                           SerializeFn serialize,
                           DeserializeFn deserialize) {
         std::lock_guard<std::mutex> lock(mutex_);
-        RegistryEntry entry{type_name, std::move(serialize), std::move(deserialize)};
-        id_to_entry_[msg_id] = entry;
-        name_to_entry_[type_name] = std::move(entry);
+        RegistryEntry entry{type_name, std::move(serialize), std::move(deserialize), {}, {}, {}};
+        auto old = by_id_.find(msg_id);
+        if (old != by_id_.end()) {  // keep a binary codec registered first
+            entry.encode = old->second->encode;
+            entry.decode = old->second->decode;
+            entry.codec.encode = old->second->codec.encode;
+            entry.codec.decode = old->second->codec.decode;
+        }
+        publish(msg_id, std::move(entry));
     }
 
     /**
-     * Get type name for a message ID
+     * Register a generated codec (see register_fields()). Replaces any
+     * earlier registration for msg_id, except that a hand-written binary
+     * codec is kept when the generated one has none.
      */
-    std::string get_type_name(int msg_id) const {
+    void register_codec(int msg_id, const std::string& type_name, const Codec& codec) {
         std::lock_guard<std::mutex> lock(mutex_);
-        auto it = id_to_entry_.find(msg_id);
-        if (it != id_to_entry_.end()) {
-            return it->second.type_name;
+        RegistryEntry entry;
+        entry.type_name = type_name;
+        entry.codec = codec;
+        auto old = by_id_.find(msg_id);
+        if (old != by_id_.end() && !codec.encode) {
+            entry.encode = old->second->encode;
+            entry.decode = old->second->decode;
         }
-        return "";
+        publish(msg_id, std::move(entry));
     }
 
     /**
-     * Serialize a message to JSON
+     * Add a binary codec for an already registered (or later registered)
+     * message ID. The REGISTER_REMOTE_MESSAGE_N macros do this automatically.
      */
-    json serialize(const Message* msg) const {
+    void register_binary(int msg_id, EncodeFn encode, DecodeFn decode) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        RegistryEntry entry;
+        auto old = by_id_.find(msg_id);
+        if (old != by_id_.end())
+            entry = *old->second;
+        entry.encode = std::move(encode);
+        entry.decode = std::move(decode);
+        entry.codec.encode = nullptr;
+        entry.codec.decode = nullptr;
+        publish(msg_id, std::move(entry));
+    }
+
+    /**
+     * Freeze the current registrations into the lock-free lookup table.
+     * Idempotent; safe to call from several threads.
+     */
+    void seal() {
         std::lock_guard<std::mutex> lock(mutex_);
-        auto it = id_to_entry_.find(msg->get_message_id());
-        if (it != id_to_entry_.end()) {
-            return it->second.serialize(msg);
+        if (!table_.load(std::memory_order_relaxed))
+            rebuild();
+    }
+
+    bool is_sealed() const noexcept {
+        return table_.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /// Entry for msg_id, or nullptr. Lock-free once sealed.
+    const RegistryEntry* find(int msg_id) const {
+        if (const Table* t = table_.load(std::memory_order_acquire))
+            return t->by_id.find(msg_id);
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = by_id_.find(msg_id);
+        return it != by_id_.end() ? it->second : nullptr;
+    }
+
+    /// Entry for a wire type name, or nullptr. Lock-free once sealed.
+    const RegistryEntry* find(std::string_view type_name) const {
+        if (const Table* t = table_.load(std::memory_order_acquire)) {
+            auto it = t->by_name.find(type_name);
+            return it != t->by_name.end() ? it->second : nullptr;
         }
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = by_name_.find(std::string(type_name));
+        return it != by_name_.end() ? it->second : nullptr;
+    }
+
+    /// True if msg_id can travel as a binary frame
+    bool has_binary(int msg_id) const {
+        const RegistryEntry* e = find(msg_id);
+        return e && e->has_binary();
+    }
+
+    /// Append msg's binary payload; false if its type has no binary codec
+    bool encode(const Message* msg, wire::BinaryWriter& w) const {
+        const RegistryEntry* e = find(msg->id());
+        if (!e || !e->has_binary())
+            return false;
+        e->write(msg, w);
+        return true;
+    }
+
+    /// Decode a binary payload; nullptr if msg_id has no binary codec
+    Message* decode(int msg_id, wire::BinaryReader& r) const {
+        const RegistryEntry* e = find(msg_id);
+        if (!e || !e->has_binary())
+            return nullptr;
+        return e->read(r);
+    }
+
+    /**
+     * Get type name for a message ID
+     */
+    std::string get_type_name(int msg_id) const {
+        const RegistryEntry* e = find(msg_id);
+        return e ? e->type_name : "";
+    }
+
+    /**
+     * Serialize a message to JSON
+     */
+    json serialize(const Message* msg) const {
+        if (const RegistryEntry* e = find(msg->id()))
+            return e->to_json(msg);
         throw std::runtime_error("Message type not registered: " + std::to_string(msg->get_message_id()));
     }
 
@@ -92,11 +242,8 @@ public:
      * Deserialize JSON to a message
      */
     Message* deserialize(const std::string& type_name, const json& data) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = name_to_entry_.find(type_name);
-        if (it != name_to_entry_.end()) {
-            return it->second.deserialize(data);
-        }
+        if (const RegistryEntry* e = find(std::string_view(type_name)))
+            return e->from_json(data);
         return nullptr;  // Unknown message type
     }
 
@@ -104,15 +251,49 @@ public:
      * Check if a type name is registered
      */
     bool is_registered(const std::string& type_name) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return name_to_entry_.find(type_name) != name_to_entry_.end();
+        return find(std::string_view(type_name)) != nullptr;
     }
 
 private:
+    // Immutable snapshot read without locks; names view entry->type_name
+    struct Table {
+        HandlerTable<const RegistryEntry*> by_id;
+        std::unordered_map<std::string_view, const RegistryEntry*> by_name;
+    };
+
     MessageRegistry() = default;
+
+    // Caller holds mutex_
+    void publish(int msg_id, RegistryEntry entry) {
+        auto old = by_id_.find(msg_id);
+        if (old != by_id_.end() && old->second->type_name != entry.type_name)
+            by_name_.erase(old->second->type_name);
+        entries_.push_back(std::make_unique<RegistryEntry>(std::move(entry)));
+        const RegistryEntry* e = entries_.back().get();
+        by_id_[msg_id] = e;
+        if (!e->type_name.empty())
+            by_name_[e->type_name] = e;
+        if (table_.load(std::memory_order_relaxed))
+            rebuild();  // late registration: republish
+    }
+
+    // Caller holds mutex_
+    void rebuild() {
+        auto t = std::make_unique<Table>();
+        std::vector<std::pair<int, const RegistryEntry*>> ids(by_id_.begin(), by_id_.end());
+        t->by_id.build(std::move(ids));
+        for (const auto& [name, e] : by_name_)
+            t->by_name.emplace(std::string_view(e->type_name), e);
+        table_.store(t.get(), std::memory_order_release);
+        tables_.push_back(std::move(t));  // Readers may still hold older tables
+    }
+
     mutable std::mutex mutex_;
-    std::unordered_map<int, RegistryEntry> id_to_entry_;
-    std::unordered_map<std::string, RegistryEntry> name_to_entry_;
+    std::vector<std::unique_ptr<RegistryEntry>> entries_;  // Never freed
+    std::unordered_map<int, const RegistryEntry*> by_id_;
+    std::unordered_map<std::string, const RegistryEntry*> by_name_;
+    std::vector<std::unique_ptr<Table>> tables_;
+    std::atomic<const Table*> table_{nullptr};
 };
 
 // Convenience functions
@@ -141,195 +322,253 @@ inline bool is_registered(const std::string& type_name) {
     return MessageRegistry::instance().is_registered(type_name);
 }
 
+inline void seal() {
+    MessageRegistry::instance().seal();
+}
+
+namespace detail {
+
+template <class T> void write_json(json& out, const T& v);
+template <class T> void read_json(const json& j, T& v);
+
+template <class C, class Fields>
+void write_json_fields(json& out, const C& obj, const Fields& fields) {
+    out = json::object();
+    for_each_field(fields, [&](const auto& f) {
+        write_json(out[std::string(f.name)], obj.*f.member);
+    });
+}
+
 /**
- * REGISTER_REMOTE_MESSAGE_1 - Register a message with 1 field
+ * Walk the object's members once and match each key against the field
+ * names; no per-field hash or tree lookup. Unknown keys are ignored. A
+ * missing field throws the same nlohmann exception j.at() would.
+ */
+template <class C, class Fields>
+void read_json_fields(const json& j, C& obj, const Fields& fields) {
+    constexpr std::size_t N = std::tuple_size_v<Fields>;
+    std::bitset<N> seen;
+    auto match = [&]<std::size_t... I>(const std::string& key, const json& value,
+                                       std::index_sequence<I...>) {
+        (void)((key == std::get<I>(fields).name
+                && (read_json(value, obj.*std::get<I>(fields).member), seen.set(I), true)) || ...);
+    };
+    if (j.is_object()) {
+        for (auto it = j.begin(); it != j.end(); ++it)
+            match(it.key(), it.value(), std::make_index_sequence<N>{});
+    }
+    if (!seen.all()) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((seen[I] ? void() : void(j.at(std::string(std::get<I>(fields).name)))), ...);
+        }(std::make_index_sequence<N>{});
+    }
+}
+
+template <class T>
+void write_json(json& out, const T& v) {
+    if constexpr (has_fields<T>) {
+        write_json_fields(out, v, T::fields());
+    } else if constexpr ((is_std_vector<T>::value || is_std_array<T>::value) && contains_fields<T>()) {
+        out = json::array();
+        for (const auto& e : v)
+            write_json(out.emplace_back(), e);
+    } else {
+        out = v;
+    }
+}
+
+template <class T>
+void read_json(const json& j, T& v) {
+    if constexpr (has_fields<T>) {
+        read_json_fields(j, v, T::fields());
+    } else if constexpr (is_std_vector<T>::value && contains_fields<T>()) {
+        const auto& a = j.get_ref<const json::array_t&>();
+        v.clear();
+        v.resize(a.size());
+        for (std::size_t i = 0; i < a.size(); i++)
+            read_json(a[i], v[i]);
+    } else if constexpr (is_std_array<T>::value && contains_fields<T>()) {
+        for (std::size_t i = 0; i < v.size(); i++)
+            read_json(j.at(i), v[i]);
+    } else {
+        j.get_to(v);
+    }
+}
+
+} // namespace detail
+
+/**
+ * FieldCodec - JSON and binary codecs for Type, generated from the field
+ * list Desc::fields() (Type's own by default). Decoding default-constructs
+ * Type and assigns the members.
+ */
+template <class Type, class Desc = Type>
+struct FieldCodec {
+    static constexpr bool binary = wire::fields_encodable<decltype(Desc::fields())>();
+
+    static json to_json(const Message* m) {
+        json j;
+        detail::write_json_fields(j, *static_cast<const Type*>(m), Desc::fields());
+        return j;
+    }
+
+    static Message* from_json(const json& j) {
+        auto msg = std::make_unique<Type>();
+        detail::read_json_fields(j, *msg, Desc::fields());
+        return msg.release();
+    }
+
+    static void encode(const Message* m, wire::BinaryWriter& w) {
+        w.put_fields(*static_cast<const Type*>(m), Desc::fields());
+    }
+
+    static Message* decode(wire::BinaryReader& r) {
+        auto msg = std::make_unique<Type>();
+        r.get_fields(*msg, Desc::fields());
+        return msg.release();
+    }
+
+    static Codec codec() {
+        Codec c;
+        c.to_json = &to_json;
+        c.from_json = &from_json;
+        if constexpr (binary) {
+            c.encode = &encode;
+            c.decode = &decode;
+        }
+        return c;
+    }
+};
+
+/**
+ * Register Type under type_name with codecs generated from its fields().
+ * Members may be anything nlohmann/json converts, plus described structs
+ * and std::vector/std::array of them; the binary codec is added when every
+ * member is encodable (see wire::is_encodable).
+ */
+template <class Type, class Desc = Type>
+void register_fields(int msg_id, const std::string& type_name) {
+    MessageRegistry::instance().register_codec(msg_id, type_name, FieldCodec<Type, Desc>::codec());
+}
+
+/**
+ * REGISTER_REMOTE_FIELDS - Register a message that describes its fields
  *
  * Usage:
- *   class Ping : public Message_N<100> {
- *   public:
- *       int count;
- *       Ping(int c = 0) : count(c) {}
+ *   struct Book : public Message_N<120> {
+ *       std::string symbol;
+ *       std::vector<Level> bids;          // Level has its own fields()
+ *       std::array<double, 4> stats{};
+ *       static constexpr auto fields() {
+ *           return std::make_tuple(ACTOR_FIELD(Book, symbol),
+ *                                  ACTOR_FIELD(Book, bids),
+ *                                  ACTOR_FIELD(Book, stats));
+ *       }
  *   };
  *
- *   REGISTER_REMOTE_MESSAGE_1(Ping, count, int)
- *
- * This expands to the full registration boilerplate automatically.
+ *   REGISTER_REMOTE_FIELDS(Book)
  */
-#define REGISTER_REMOTE_MESSAGE_1(Type, field1, type1)                          \
+#define REGISTER_REMOTE_FIELDS(Type)                                            \
     namespace {                                                                  \
         static bool Type##_registered_ = []() {                                  \
-            actors::serialization::register_message(Type().get_message_id(), #Type, \
-                [](const actors::Message* m) -> nlohmann::json {                 \
-                    const Type* msg = static_cast<const Type*>(m);               \
-                    return nlohmann::json{{#field1, msg->field1}};               \
-                },                                                               \
-                [](const nlohmann::json& j) -> actors::Message* {                \
-                    return new Type(j[#field1].get<type1>());                    \
-                });                                                              \
+            actors::serialization::register_fields<Type>(Type().get_message_id(), #Type); \
             return true;                                                         \
         }();                                                                     \
     }
 
-/**
- * REGISTER_REMOTE_MESSAGE_2 - Register a message with 2 fields
- */
-#define REGISTER_REMOTE_MESSAGE_2(Type, field1, type1, field2, type2)           \
+// Shared body of REGISTER_REMOTE_MESSAGE_0..10: a local descriptor for Type
+#define ACTOR_REGISTER_DESCRIBED_(Type, ...)                                    \
     namespace {                                                                  \
         static bool Type##_registered_ = []() {                                  \
-            actors::serialization::register_message(Type().get_message_id(), #Type, \
-                [](const actors::Message* m) -> nlohmann::json {                 \
-                    const Type* msg = static_cast<const Type*>(m);               \
-                    return nlohmann::json{{#field1, msg->field1}, {#field2, msg->field2}}; \
-                },                                                               \
-                [](const nlohmann::json& j) -> actors::Message* {                \
-                    return new Type(j[#field1].get<type1>(), j[#field2].get<type2>()); \
-                });                                                              \
+            struct Desc {                                                        \
+                static constexpr auto fields() { return std::make_tuple(__VA_ARGS__); } \
+            };                                                                   \
+            actors::serialization::register_fields<Type, Desc>(Type().get_message_id(), #Type); \
             return true;                                                         \
         }();                                                                     \
     }
 
+/**
+ * REGISTER_REMOTE_MESSAGE_1 - Register a message with 1 field
+ *
+ * Usage:
+ *   class Ping : public Message_N<100> {
+ *   public:
+ *       int count;
+ *       Ping(int c = 0) : count(c) {}
+ *   };
+ *
+ *   REGISTER_REMOTE_MESSAGE_1(Ping, count, int)
+ *
+ * Same codecs as REGISTER_REMOTE_FIELDS with the listed fields. The type
+ * arguments are kept for compatibility; each member's declared type is
+ * what goes on the wire. New code can use REGISTER_REMOTE_FIELDS, which
+ * has no field limit.
+ */
+#define REGISTER_REMOTE_MESSAGE_1(Type, f1, t1)                                 \
+    ACTOR_REGISTER_DESCRIBED_(Type, ACTOR_FIELD(Type, f1))
+
+/**
+ * REGISTER_REMOTE_MESSAGE_2 - Register a message with 2 fields
+ */
+#define REGISTER_REMOTE_MESSAGE_2(Type, f1, t1, f2, t2)                         \
+    ACTOR_REGISTER_DESCRIBED_(Type, ACTOR_FIELD(Type, f1), ACTOR_FIELD(Type, f2))
+
 /**
  * REGISTER_REMOTE_MESSAGE_3 - Register a message with 3 fields
  */
 #define REGISTER_REMOTE_MESSAGE_3(Type, f1, t1, f2, t2, f3, t3)                 \
-    namespace {                                                                  \
-        static bool Type##_registered_ = []() {                                  \
-            actors::serialization::register_message(Type().get_message_id(), #Type, \
-                [](const actors::Message* m) -> nlohmann::json {                 \
-                    const Type* msg = static_cast<const Type*>(m);               \
-                    return nlohmann::json{{#f1, msg->f1}, {#f2, msg->f2}, {#f3, msg->f3}}; \
-                },                                                               \
-                [](const nlohmann::json& j) -> actors::Message* {                \
-                    return new Type(j[#f1].get<t1>(), j[#f2].get<t2>(), j[#f3].get<t3>()); \
-                });                                                              \
-            return true;                                                         \
-        }();                                                                     \
-    }
+    ACTOR_REGISTER_DESCRIBED_(Type, ACTOR_FIELD(Type, f1), ACTOR_FIELD(Type, f2), \
+                              ACTOR_FIELD(Type, f3))
 
 /**
  * REGISTER_REMOTE_MESSAGE_0 - Register a message with no fields
  */
 #define REGISTER_REMOTE_MESSAGE_0(Type)                                         \
-    namespace {                                                                  \
-        static bool Type##_registered_ = []() {                                  \
-            actors::serialization::register_message(Type().get_message_id(), #Type, \
-                [](const actors::Message*) -> nlohmann::json {                   \
-                    return nlohmann::json::object();                             \
-                },                                                               \
-                [](const nlohmann::json&) -> actors::Message* {                  \
-                    return new Type();                                           \
-                });                                                              \
-            return true;                                                         \
-        }();                                                                     \
-    }
+    ACTOR_REGISTER_DESCRIBED_(Type)
 
 /**
  * REGISTER_REMOTE_MESSAGE_4 through REGISTER_REMOTE_MESSAGE_10 for larger messages
  */
 #define REGISTER_REMOTE_MESSAGE_4(Type, f1, t1, f2, t2, f3, t3, f4, t4)         \
-    namespace {                                                                  \
-        static bool Type##_registered_ = []() {                                  \
-            actors::serialization::register_message(Type().get_message_id(), #Type, \
-                [](const actors::Message* m) -> nlohmann::json {                 \
-                    const Type* msg = static_cast<const Type*>(m);               \
-                    return nlohmann::json{{#f1, msg->f1}, {#f2, msg->f2}, {#f3, msg->f3}, {#f4, msg->f4}}; \
-                },                                                               \
-                [](const nlohmann::json& j) -> actors::Message* {                \
-                    return new Type(j[#f1].get<t1>(), j[#f2].get<t2>(), j[#f3].get<t3>(), j[#f4].get<t4>()); \
-                });                                                              \
-            return true;                                                         \
-        }();                                                                     \
-    }
+    ACTOR_REGISTER_DESCRIBED_(Type, ACTOR_FIELD(Type, f1), ACTOR_FIELD(Type, f2), \
+                              ACTOR_FIELD(Type, f3), ACTOR_FIELD(Type, f4))
 
 #define REGISTER_REMOTE_MESSAGE_5(Type, f1, t1, f2, t2, f3, t3, f4, t4, f5, t5) \
-    namespace {                                                                  \
-        static bool Type##_registered_ = []() {                                  \
-            actors::serialization::register_message(Type().get_message_id(), #Type, \
-                [](const actors::Message* m) -> nlohmann::json {                 \
-                    const Type* msg = static_cast<const Type*>(m);               \
-                    return nlohmann::json{{#f1, msg->f1}, {#f2, msg->f2}, {#f3, msg->f3}, {#f4, msg->f4}, {#f5, msg->f5}}; \
-                },                                                               \
-                [](const nlohmann::json& j) -> actors::Message* {                \
-                    return new Type(j[#f1].get<t1>(), j[#f2].get<t2>(), j[#f3].get<t3>(), j[#f4].get<t4>(), j[#f5].get<t5>()); \
-                });                                                              \
-            return true;                                                         \
-        }();                                                                     \
-    }
+    ACTOR_REGISTER_DESCRIBED_(Type, ACTOR_FIELD(Type, f1), ACTOR_FIELD(Type, f2), \
+                              ACTOR_FIELD(Type, f3), ACTOR_FIELD(Type, f4),      \
+                              ACTOR_FIELD(Type, f5))
 
 #define REGISTER_REMOTE_MESSAGE_6(Type, f1, t1, f2, t2, f3, t3, f4, t4, f5, t5, f6, t6) \
-    namespace {                                                                  \
-        static bool Type##_registered_ = []() {                                  \
-            actors::serialization::register_message(Type().get_message_id(), #Type, \
-                [](const actors::Message* m) -> nlohmann::json {                 \
-                    const Type* msg = static_cast<const Type*>(m);               \
-                    return nlohmann::json{{#f1, msg->f1}, {#f2, msg->f2}, {#f3, msg->f3}, {#f4, msg->f4}, {#f5, msg->f5}, {#f6, msg->f6}}; \
-                },                                                               \
-                [](const nlohmann::json& j) -> actors::Message* {                \
-                    return new Type(j[#f1].get<t1>(), j[#f2].get<t2>(), j[#f3].get<t3>(), j[#f4].get<t4>(), j[#f5].get<t5>(), j[#f6].get<t6>()); \
-                });                                                              \
-            return true;                                                         \
-        }();                                                                     \
-    }
+    ACTOR_REGISTER_DESCRIBED_(Type, ACTOR_FIELD(Type, f1), ACTOR_FIELD(Type, f2), \
+                              ACTOR_FIELD(Type, f3), ACTOR_FIELD(Type, f4),      \
+                              ACTOR_FIELD(Type, f5), ACTOR_FIELD(Type, f6))
 
 #define REGISTER_REMOTE_MESSAGE_7(Type, f1, t1, f2, t2, f3, t3, f4, t4, f5, t5, f6, t6, f7, t7) \
-    namespace {                                                                  \
-        static bool Type##_registered_ = []() {                                  \
-            actors::serialization::register_message(Type().get_message_id(), #Type, \
-                [](const actors::Message* m) -> nlohmann::json {                 \
-                    const Type* msg = static_cast<const Type*>(m);               \
-                    return nlohmann::json{{#f1, msg->f1}, {#f2, msg->f2}, {#f3, msg->f3}, {#f4, msg->f4}, {#f5, msg->f5}, {#f6, msg->f6}, {#f7, msg->f7}}; \
-                },                                                               \
-                [](const nlohmann::json& j) -> actors::Message* {                \
-                    return new Type(j[#f1].get<t1>(), j[#f2].get<t2>(), j[#f3].get<t3>(), j[#f4].get<t4>(), j[#f5].get<t5>(), j[#f6].get<t6>(), j[#f7].get<t7>()); \
-                });                                                              \
-            return true;                                                         \
-        }();                                                                     \
-    }
+    ACTOR_REGISTER_DESCRIBED_(Type, ACTOR_FIELD(Type, f1), ACTOR_FIELD(Type, f2), \
+                              ACTOR_FIELD(Type, f3), ACTOR_FIELD(Type, f4),      \
+                              ACTOR_FIELD(Type, f5), ACTOR_FIELD(Type, f6),      \
+                              ACTOR_FIELD(Type, f7))
 
 #define REGISTER_REMOTE_MESSAGE_8(Type, f1, t1, f2, t2, f3, t3, f4, t4, f5, t5, f6, t6, f7, t7, f8, t8) \
-    namespace {                                                                  \
-        static bool Type##_registered_ = []() {                                  \
-            actors::serialization::register_message(Type().get_message_id(), #Type, \
-                [](const actors::Message* m) -> nlohmann::json {                 \
-                    const Type* msg = static_cast<const Type*>(m);               \
-                    return nlohmann::json{{#f1, msg->f1}, {#f2, msg->f2}, {#f3, msg->f3}, {#f4, msg->f4}, {#f5, msg->f5}, {#f6, msg->f6}, {#f7, msg->f7}, {#f8, msg->f8}}; \
-                },                                                               \
-                [](const nlohmann::json& j) -> actors::Message* {                \
-                    return new Type(j[#f1].get<t1>(), j[#f2].get<t2>(), j[#f3].get<t3>(), j[#f4].get<t4>(), j[#f5].get<t5>(), j[#f6].get<t6>(), j[#f7].get<t7>(), j[#f8].get<t8>()); \
-                });                                                              \
-            return true;                                                         \
-        }();                                                                     \
-    }
+    ACTOR_REGISTER_DESCRIBED_(Type, ACTOR_FIELD(Type, f1), ACTOR_FIELD(Type, f2), \
+                              ACTOR_FIELD(Type, f3), ACTOR_FIELD(Type, f4),      \
+                              ACTOR_FIELD(Type, f5), ACTOR_FIELD(Type, f6),      \
+                              ACTOR_FIELD(Type, f7), ACTOR_FIELD(Type, f8))
 
 #define REGISTER_REMOTE_MESSAGE_9(Type, f1, t1, f2, t2, f3, t3, f4, t4, f5, t5, f6, t6, f7, t7, f8, t8, f9, t9) \
-    namespace {                                                                  \
-        static bool Type##_registered_ = []() {                                  \
-            actors::serialization::register_message(Type().get_message_id(), #Type, \
-                [](const actors::Message* m) -> nlohmann::json {                 \
-                    const Type* msg = static_cast<const Type*>(m);               \
-                    return nlohmann::json{{#f1, msg->f1}, {#f2, msg->f2}, {#f3, msg->f3}, {#f4, msg->f4}, {#f5, msg->f5}, {#f6, msg->f6}, {#f7, msg->f7}, {#f8, msg->f8}, {#f9, msg->f9}}; \
-                },                                                               \
-                [](const nlohmann::json& j) -> actors::Message* {                \
-                    return new Type(j[#f1].get<t1>(), j[#f2].get<t2>(), j[#f3].get<t3>(), j[#f4].get<t4>(), j[#f5].get<t5>(), j[#f6].get<t6>(), j[#f7].get<t7>(), j[#f8].get<t8>(), j[#f9].get<t9>()); \
-                });                                                              \
-            return true;                                                         \
-        }();                                                                     \
-    }
+    ACTOR_REGISTER_DESCRIBED_(Type, ACTOR_FIELD(Type, f1), ACTOR_FIELD(Type, f2), \
+                              ACTOR_FIELD(Type, f3), ACTOR_FIELD(Type, f4),      \
+                              ACTOR_FIELD(Type, f5), ACTOR_FIELD(Type, f6),      \
+                              ACTOR_FIELD(Type, f7), ACTOR_FIELD(Type, f8),      \
+                              ACTOR_FIELD(Type, f9))
 
 #define REGISTER_REMOTE_MESSAGE_10(Type, f1, t1, f2, t2, f3, t3, f4, t4, f5, t5, f6, t6, f7, t7, f8, t8, f9, t9, f10, t10) \
-    namespace {                                                                  \
-        static bool Type##_registered_ = []() {                                  \
-            actors::serialization::register_message(Type().get_message_id(), #Type, \
-                [](const actors::Message* m) -> nlohmann::json {                 \
-                    const Type* msg = static_cast<const Type*>(m);               \
-                    return nlohmann::json{{#f1, msg->f1}, {#f2, msg->f2}, {#f3, msg->f3}, {#f4, msg->f4}, {#f5, msg->f5}, {#f6, msg->f6}, {#f7, msg->f7}, {#f8, msg->f8}, {#f9, msg->f9}, {#f10, msg->f10}}; \
-                },                                                               \
-                [](const nlohmann::json& j) -> actors::Message* {                \
-                    return new Type(j[#f1].get<t1>(), j[#f2].get<t2>(), j[#f3].get<t3>(), j[#f4].get<t4>(), j[#f5].get<t5>(), j[#f6].get<t6>(), j[#f7].get<t7>(), j[#f8].get<t8>(), j[#f9].get<t9>(), j[#f10].get<t10>()); \
-                });                                                              \
-            return true;                                                         \
-        }();                                                                     \
-    }
+    ACTOR_REGISTER_DESCRIBED_(Type, ACTOR_FIELD(Type, f1), ACTOR_FIELD(Type, f2), \
+                              ACTOR_FIELD(Type, f3), ACTOR_FIELD(Type, f4),      \
+                              ACTOR_FIELD(Type, f5), ACTOR_FIELD(Type, f6),      \
+                              ACTOR_FIELD(Type, f7), ACTOR_FIELD(Type, f8),      \
+                              ACTOR_FIELD(Type, f9), ACTOR_FIELD(Type, f10))
 
 /**
  * REGISTER_REMOTE_MESSAGE - Legacy macro for custom serialize/deserialize
@@ -0,0 +1,121 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+ShmReceiver - Consumer side of the same-host shared-memory transport.
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include "actors/Actor.hpp"
+#include "actors/Backoff.hpp"
+#include "actors/msg/Start.hpp"
+#include "actors/remote/ShmRing.hpp"
+#include "actors/remote/ShmTransport.hpp"
+#include "actors/remote/ZmqReceiver.hpp"
+
+namespace actors {
+
+/**
+ * ShmReceiver - Consumes the shared-memory ring for a ZmqReceiver
+ *
+ * Creates the ring named after the receiver's TCP port, so managers on
+ * this host that look its actors up through the registry get ShmActorRefs
+ * instead of TCP refs. Each record is routed by the ZmqReceiver exactly
+ * like a socket message (same actor registry, rejects and reply proxies).
+ *
+ * Runs a dedicated thread that drains the ring, optionally spins for
+ * busy_poll, then sleeps on the ring's futex doorbell.
+ *
+ * Usage:
+ *   auto* receiver = new ZmqReceiver("tcp://0.0.0.0:5001", sender);
+ *   auto* shm = new ShmReceiver("tcp://0.0.0.0:5001", receiver);
+ *   mgr.manage(receiver);
+ *   mgr.manage(shm);
+ */
+class ShmReceiver : public Actor {
+public:
+    ShmReceiver(const std::string& bind_endpoint, ZmqReceiver* router,
+                std::size_t slots = ACTOR_SHM_SLOTS,
+                std::size_t slot_size = ACTOR_SHM_SLOT_SIZE,
+                std::chrono::microseconds busy_poll = std::chrono::microseconds(0))
+        : router_(router)
+        , busy_poll_(busy_poll) {
+        strncpy(name, "ShmReceiver", sizeof(name));
+        std::string ring = shm::ring_name(bind_endpoint);
+        if (ring.empty())
+            throw std::invalid_argument("ShmReceiver needs a tcp://host:port endpoint: " + bind_endpoint);
+        ring_ = ShmRing::create(ring, slots, slot_size);
+
+        MESSAGE_HANDLER(msg::Start, on_start);
+    }
+
+    ~ShmReceiver() {
+        stop();
+    }
+
+    const ShmRing& ring() const { return *ring_; }
+
+private:
+    void on_start(const msg::Start*) noexcept {
+        running_ = true;
+        thread_ = std::thread(&ShmReceiver::run, this);
+    }
+
+    void run() noexcept {
+        auto spin_until = std::chrono::steady_clock::now();
+        while (running_.load(std::memory_order_acquire)) {
+            size_t n = ring_->pop([this](const char* data, size_t len) {
+                try {
+                    router_->route(data, len);
+                } catch (const std::exception&) {
+                    // Same as a bad socket message: dropped
+                }
+            });
+            if (n > 0) {
+                spin_until = std::chrono::steady_clock::now() + busy_poll_;
+                continue;
+            }
+            if (std::chrono::steady_clock::now() < spin_until) {
+                cpu_relax();
+                continue;
+            }
+            ring_->wait(std::chrono::milliseconds(ACTOR_ZMQ_POLL_MS));
+        }
+    }
+
+    void stop() noexcept {
+        running_ = false;
+        if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id())
+            thread_.join();
+    }
+
+    void end() override {
+        stop();
+    }
+
+    void terminate() noexcept override {
+        stop();
+        Actor::terminate();
+    }
+
+    void on_drain() noexcept override {
+        stop();
+    }
+
+    ZmqReceiver* router_;
+    std::unique_ptr<ShmRing> ring_;
+    std::chrono::microseconds busy_poll_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+} // namespace actors
@@ -0,0 +1,328 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+ShmRing - Lock-free multi-producer ring in POSIX shared memory (/dev/shm)
+for same-host transport between managers.
+
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <signal.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "actors/Backoff.hpp"
+
+// Default ring geometry: slots (power of two) x bytes per slot
+#ifndef ACTOR_SHM_SLOTS
+#define ACTOR_SHM_SLOTS 4096
+#endif
+#ifndef ACTOR_SHM_SLOT_SIZE
+#define ACTOR_SHM_SLOT_SIZE 1024
+#endif
+
+// How long push() backs off on a full ring before giving up (the sender then uses TCP)
+#ifndef ACTOR_SHM_PUSH_WAIT_MS
+#define ACTOR_SHM_PUSH_WAIT_MS 1000
+#endif
+
+// How often push() checks that the consumer process is still alive
+#ifndef ACTOR_SHM_LIVENESS_MS
+#define ACTOR_SHM_LIVENESS_MS 1
+#endif
+
+namespace actors {
+
+/**
+ * ShmRing - Bounded MPSC queue of byte records in a shared mapping
+ *
+ * The receiving process create()s the ring; any number of processes on
+ * the same host open() it and push(). Records are at most
+ * max_record() bytes (one fixed-size slot each). Slots carry a sequence
+ * number, so producers claim a slot with one CAS and publish it with a
+ * release store, and the single consumer needs no atomics beyond loads.
+ *
+ * The consumer can sleep in wait(); producers ring a futex doorbell in
+ * the mapping only when the consumer says it is asleep, so a busy ring
+ * makes no system calls.
+ *
+ * The header records the consumer's pid. A consumer that dies without
+ * closing the ring is noticed by push() within ACTOR_SHM_LIVENESS_MS, and
+ * the ring then counts as closed; records still in it are lost. This
+ * needs producers and consumer in one pid namespace.
+ *
+ * A producer that dies between claiming and publishing a slot stalls the
+ * ring at that slot; recreate the ring to recover.
+ */
+class ShmRing {
+    static constexpr std::uint32_t MAGIC = 0x53484d52;  // "SHMR"
+    static constexpr std::uint32_t VERSION = 2;
+
+    struct Header {
+        std::atomic<std::uint32_t> magic;
+        std::uint32_t version;
+        std::uint64_t slots;
+        std::uint64_t slot_size;
+        std::int32_t consumer_pid;
+        alignas(64) std::atomic<std::uint64_t> tail;      // next slot to claim
+        alignas(64) std::atomic<std::uint64_t> head;      // next slot to read
+        alignas(64) std::atomic<std::uint32_t> doorbell;  // futex word
+        std::atomic<std::uint32_t> sleeping;
+        std::atomic<std::uint32_t> closed;                // consumer has gone away
+    };
+
+    // Slot header; the record bytes follow it, up to slot_size in total
+    struct Slot {
+        std::atomic<std::uint64_t> seq;
+        std::uint32_t len;
+        std::uint32_t reserved;
+        char* data() noexcept { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared-memory atomics must be lock-free");
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free, "shared-memory atomics must be lock-free");
+
+public:
+    /**
+     * Create (or replace) the ring name ("/actors-5001") as its consumer
+     * @throws std::runtime_error on failure
+     */
+    static std::unique_ptr<ShmRing> create(const std::string& name,
+                                           std::size_t slots = ACTOR_SHM_SLOTS,
+                                           std::size_t slot_size = ACTOR_SHM_SLOT_SIZE) {
+        if (slots < 2 || (slots & (slots - 1)) != 0)
+            throw std::invalid_argument("ShmRing slots must be a power of two");
+        slot_size = (std::max(slot_size, sizeof(Slot) + 16) + 63) & ~std::size_t(63);
+
+        ::shm_unlink(name.c_str());  // stale ring from a previous run
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+            throw std::runtime_error("shm_open " + name + ": " + std::strerror(errno));
+        std::size_t size = sizeof(Header) + slots * slot_size;
+        if (::ftruncate(fd, off_t(size)) != 0) {
+            int e = errno;
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            throw std::runtime_error("ftruncate " + name + ": " + std::strerror(e));
+        }
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            ::shm_unlink(name.c_str());
+            throw std::runtime_error("mmap " + name + ": " + std::strerror(errno));
+        }
+
+        auto* h = new (p) Header;
+        h->version = VERSION;
+        h->slots = slots;
+        h->slot_size = slot_size;
+        h->consumer_pid = std::int32_t(::getpid());
+        h->tail.store(0, std::memory_order_relaxed);
+        h->head.store(0, std::memory_order_relaxed);
+        h->doorbell.store(0, std::memory_order_relaxed);
+        h->sleeping.store(0, std::memory_order_relaxed);
+        h->closed.store(0, std::memory_order_relaxed);
+        std::unique_ptr<ShmRing> ring(new ShmRing(name, p, size, true));
+        for (std::size_t i = 0; i < slots; i++)
+            new (&ring->slot(i)->seq) std::atomic<std::uint64_t>(i);
+        h->magic.store(MAGIC, std::memory_order_release);  // now visible to open()
+        return ring;
+    }
+
+    /// Map an existing ring as a producer; nullptr if there is none, or its consumer is gone
+    static std::unique_ptr<ShmRing> open(const std::string& name) {
+        int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0)
+            return nullptr;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || std::size_t(st.st_size) < sizeof(Header)) {
+            ::close(fd);
+            return nullptr;
+        }
+        std::size_t size = std::size_t(st.st_size);
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED)
+            return nullptr;
+        auto* h = static_cast<Header*>(p);
+        if (h->magic.load(std::memory_order_acquire) != MAGIC || h->version != VERSION
+            || sizeof(Header) + h->slots * h->slot_size > size) {
+            ::munmap(p, size);
+            return nullptr;
+        }
+        std::unique_ptr<ShmRing> ring(new ShmRing(name, p, size, false));
+        if (ring->closed())
+            return nullptr;  // left behind by a consumer that crashed
+        return ring;
+    }
+
+    ~ShmRing() {
+        if (owner_) {
+            hdr_->closed.store(1, std::memory_order_release);  // producers fall back
+            ::shm_unlink(name_.c_str());
+        }
+        ::munmap(base_, size_);
+    }
+
+    ShmRing(const ShmRing&) = delete;
+    ShmRing& operator=(const ShmRing&) = delete;
+
+    /// Append one record; false if the ring is full or closed, or len > max_record()
+    bool try_push(const void* data, std::size_t len) noexcept {
+        if (len > max_record() || hdr_->closed.load(std::memory_order_acquire))
+            return false;
+        const std::uint64_t mask = hdr_->slots - 1;
+        std::uint64_t pos = hdr_->tail.load(std::memory_order_relaxed);
+        Slot* s;
+        for (;;) {
+            s = slot(pos & mask);
+            std::uint64_t seq = s->seq.load(std::memory_order_acquire);
+            std::int64_t dif = std::int64_t(seq) - std::int64_t(pos);
+            if (dif == 0) {
+                if (hdr_->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false;  // full
+            } else {
+                pos = hdr_->tail.load(std::memory_order_relaxed);
+            }
+        }
+        s->len = std::uint32_t(len);
+        std::memcpy(s->data(), data, len);
+        s->seq.store(pos + 1, std::memory_order_release);
+
+        // Ring the doorbell only if the consumer went to sleep
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (hdr_->sleeping.load(std::memory_order_relaxed)) {
+            hdr_->doorbell.fetch_add(1, std::memory_order_relaxed);
+            futex(&hdr_->doorbell, FUTEX_WAKE, 1, nullptr);
+        }
+        return true;
+    }
+
+    /**
+     * try_push(), backing off while the ring is full, for up to max_wait
+     * @return false if too large, closed, or still full after max_wait
+     */
+    bool push(const void* data, std::size_t len,
+              std::chrono::milliseconds max_wait = std::chrono::milliseconds(ACTOR_SHM_PUSH_WAIT_MS)) noexcept {
+        // Look for a dead consumer now and then, not on every record
+        auto now = std::chrono::steady_clock::now();
+        if (now.time_since_epoch().count() >= next_check_.load(std::memory_order_relaxed)) {
+            next_check_.store((now + std::chrono::milliseconds(ACTOR_SHM_LIVENESS_MS)).time_since_epoch().count(),
+                              std::memory_order_relaxed);
+            if (closed())
+                return false;
+        }
+        if (try_push(data, len))
+            return true;
+        auto deadline = now + max_wait;
+        Backoff backoff;
+        do {
+            if (len > max_record() || closed() || std::chrono::steady_clock::now() >= deadline)
+                return false;
+            backoff.pause();
+        } while (!try_push(data, len));
+        return true;
+    }
+
+    /**
+     * True once the consumer has destroyed the ring or its process has
+     * died. The latter is checked with kill(pid, 0), a system call, and
+     * then recorded in the ring for the other producers.
+     */
+    bool closed() const noexcept {
+        if (hdr_->closed.load(std::memory_order_acquire) != 0)
+            return true;
+        if (::kill(pid_t(hdr_->consumer_pid), 0) == 0 || errno == EPERM)
+            return false;
+        hdr_->closed.store(1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer only: call fn(const char* data, size_t len) for up to max
+     * records; returns how many. The data is valid only during fn.
+     */
+    template <class Fn>
+    std::size_t pop(Fn&& fn, std::size_t max = SIZE_MAX) {
+        const std::uint64_t mask = hdr_->slots - 1;
+        std::size_t n = 0;
+        std::uint64_t pos = hdr_->head.load(std::memory_order_relaxed);
+        while (n < max) {
+            Slot* s = slot(pos & mask);
+            if (s->seq.load(std::memory_order_acquire) != pos + 1)
+                break;
+            fn(static_cast<const char*>(s->data()), std::size_t(s->len));
+            s->seq.store(pos + mask + 1, std::memory_order_release);
+            hdr_->head.store(++pos, std::memory_order_relaxed);
+            n++;
+        }
+        return n;
+    }
+
+    /// Consumer only: sleep until a record may be available or timeout passes
+    void wait(std::chrono::milliseconds timeout) noexcept {
+        std::uint32_t bell = hdr_->doorbell.load(std::memory_order_relaxed);
+        hdr_->sleeping.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (empty()) {
+            struct timespec ts;
+            ts.tv_sec = timeout.count() / 1000;
+            ts.tv_nsec = (timeout.count() % 1000) * 1000000;
+            futex(&hdr_->doorbell, FUTEX_WAIT, bell, &ts);
+        }
+        hdr_->sleeping.store(0, std::memory_order_relaxed);
+    }
+
+    bool empty() const noexcept {
+        std::uint64_t pos = hdr_->head.load(std::memory_order_relaxed);
+        return slot(pos & (hdr_->slots - 1))->seq.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    std::size_t capacity() const noexcept { return std::size_t(hdr_->slots); }
+    std::size_t max_record() const noexcept { return std::size_t(hdr_->slot_size) - sizeof(Slot); }
+    const std::string& name() const noexcept { return name_; }
+
+private:
+    ShmRing(std::string name, void* base, std::size_t size, bool owner)
+        : name_(std::move(name)), base_(base), size_(size), owner_(owner)
+        , hdr_(static_cast<Header*>(base)) {}
+
+    Slot* slot(std::uint64_t i) const noexcept {
+        return reinterpret_cast<Slot*>(static_cast<char*>(base_) + sizeof(Header) + i * hdr_->slot_size);
+    }
+
+    static long futex(std::atomic<std::uint32_t>* addr, int op, std::uint32_t val,
+                      const struct timespec* ts) noexcept {
+        // Shared (not FUTEX_PRIVATE) so it works across processes
+        return ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(addr), op, val, ts, nullptr, 0);
+    }
+
+    std::string name_;
+    void* base_;
+    std::size_t size_;
+    bool owner_;
+    Header* hdr_;
+    std::atomic<std::int64_t> next_check_{0};  // steady_clock tick of the next liveness check
+};
+
+} // namespace actors
@@ -0,0 +1,53 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+Same-host shared-memory transport: ring naming and host detection
+shared by ShmActorRef producers and ShmReceiver.
+
+*/
+
+#pragma once
+
+#include <string>
+#include <unistd.h>
+#include "actors/remote/ShmRing.hpp"
+
+// Shared-memory ring names are this prefix plus the TCP port
+#ifndef ACTOR_SHM_PREFIX
+#define ACTOR_SHM_PREFIX "/actors-"
+#endif
+
+namespace actors::shm {
+
+/// "tcp://host:5001" -> "/actors-5001"; empty if endpoint is not tcp://host:port
+inline std::string ring_name(const std::string& endpoint) {
+    if (endpoint.rfind("tcp://", 0) != 0)
+        return "";
+    size_t colon = endpoint.rfind(':');
+    if (colon == std::string::npos || colon < 6 || colon + 1 >= endpoint.size())
+        return "";
+    std::string port = endpoint.substr(colon + 1);
+    if (port.find_first_not_of("0123456789") != std::string::npos)
+        return "";
+    return ACTOR_SHM_PREFIX + port;
+}
+
+/// True if a tcp endpoint names this machine (loopback, wildcard or our hostname)
+inline bool is_local_host(const std::string& endpoint) {
+    if (endpoint.rfind("tcp://", 0) != 0)
+        return false;
+    size_t colon = endpoint.rfind(':');
+    if (colon == std::string::npos || colon < 6)
+        return false;
+    std::string host = endpoint.substr(6, colon - 6);
+    if (host == "localhost" || host == "127.0.0.1" || host == "[::1]" || host == "::1"
+        || host == "0.0.0.0" || host == "*")
+        return true;
+    char self[256] = {0};
+    return ::gethostname(self, sizeof(self) - 1) == 0 && host == self;
+}
+
+} // namespace actors::shm
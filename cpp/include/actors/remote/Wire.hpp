@@ -0,0 +1,408 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+Compact binary wire format for C++ to C++ remote messages.
+JSON envelopes remain the default and the format used with Rust/Python.
+
+*/
+
+#pragma once
+
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "actors/remote/Fields.hpp"
+
+namespace actors::wire {
+
+/**
+ * Binary frame layout (all integers little-endian):
+ *
+ *   u8  magic (0xA5 - never '{', so receivers can tell it from JSON)
+ *   u8  version (1)
+ *   u8  flags (FLAG_SENDER, FLAG_REQUEST, FLAG_REPLY, FLAG_FLOW, FLAG_SESSION)
+ *   u8  reserved
+ *   i32 message_id
+ *   u32 receiver_id   (interned by the receiving process; 0 = name follows)
+ *   u32 payload_len
+ *   [u16 len + receiver name]                        if receiver_id == 0
+ *   [u16 len + sender actor, u16 len + sender endpoint]  if FLAG_SENDER
+ *   [u64 correlation id]                             if FLAG_REQUEST or FLAG_REPLY
+ *   [u64 session, u16 len + reply_to, u16 len + endpoint]  if FLAG_FLOW
+ *   [u64 receiver session, [u16 len + reply_to] unless FLAG_SENDER]  if FLAG_SESSION
+ *   payload: the message fields in registration order
+ */
+constexpr std::uint8_t MAGIC = 0xA5;
+constexpr std::uint8_t VERSION = 1;
+constexpr std::uint8_t FLAG_SENDER = 0x01;
+constexpr std::uint8_t FLAG_REQUEST = 0x02;  // ask(): the reply must carry the id
+constexpr std::uint8_t FLAG_REPLY = 0x04;    // answers the request with the id
+constexpr std::uint8_t FLAG_FLOW = 0x08;     // counts against the sender's credits
+constexpr std::uint8_t FLAG_SESSION = 0x10;  // receiver IDs are from this WireHello session
+constexpr std::size_t HEADER_SIZE = 16;
+
+/// Name advertised in JSON envelopes by peers that accept binary frames
+constexpr const char* FORMAT_NAME = "bin1";
+
+/// Random nonzero ID for a session (a WireHello, a flow-control run)
+inline std::uint64_t new_session() {
+    std::random_device rd;
+    std::uint64_t s = (std::uint64_t(rd()) << 32) ^ rd()
+        ^ std::uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+    return s != 0 ? s : 1;
+}
+
+/// Thrown when a frame is truncated or malformed
+struct WireError : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+template <class T>
+inline T to_little(T v) noexcept {
+    if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1) {
+        if constexpr (sizeof(T) == 2) return T(__builtin_bswap16(std::uint16_t(v)));
+        if constexpr (sizeof(T) == 4) return T(__builtin_bswap32(std::uint32_t(v)));
+        if constexpr (sizeof(T) == 8) return T(__builtin_bswap64(std::uint64_t(v)));
+    }
+    return v;
+}
+
+template <class T>
+using is_vector = serialization::is_std_vector<T>;
+
+template <class Fields>
+constexpr bool fields_encodable();
+
+/**
+ * Types a field may have to get a binary codec (others fall back to JSON):
+ * arithmetic, enums, std::string, std::vector and std::array of those, and
+ * structs described by fields() whose members are all encodable
+ */
+template <class T>
+constexpr bool is_encodable() {
+    if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+        return true;
+    else if constexpr (std::is_same_v<T, std::string>)
+        return true;
+    else if constexpr (is_vector<T>::value)
+        return !std::is_same_v<T, std::vector<bool>> && is_encodable<typename T::value_type>();
+    else if constexpr (serialization::is_std_array<T>::value)
+        return is_encodable<typename T::value_type>();
+    else if constexpr (serialization::has_fields<T>)
+        return fields_encodable<decltype(T::fields())>();
+    else
+        return false;
+}
+
+/// True if every member named in a fields() tuple type is encodable
+template <class Fields>
+constexpr bool fields_encodable() {
+    return []<class... Fs>(std::tuple<Fs...>*) {
+        return (is_encodable<typename Fs::type>() && ...);
+    }(static_cast<Fields*>(nullptr));
+}
+
+template <class T>
+constexpr bool is_encodable_v = is_encodable<T>();
+
+/// Fewest bytes an encoded T can take; bounds untrusted vector lengths
+template <class T>
+constexpr std::size_t min_encoded_size() {
+    if constexpr (std::is_same_v<T, bool>)
+        return 1;
+    else if constexpr (std::is_enum_v<T>)
+        return sizeof(std::underlying_type_t<T>);
+    else if constexpr (std::is_arithmetic_v<T>)
+        return sizeof(T);
+    else if constexpr (std::is_same_v<T, std::string> || is_vector<T>::value)
+        return sizeof(std::uint32_t);
+    else if constexpr (serialization::is_std_array<T>::value)
+        return std::tuple_size_v<T> * min_encoded_size<typename T::value_type>();
+    else
+        return []<class... Fs>(std::tuple<Fs...>*) {
+            return (std::size_t(0) + ... + min_encoded_size<typename Fs::type>());
+        }(static_cast<decltype(T::fields())*>(nullptr));
+}
+
+/**
+ * BinaryWriter - Appends little-endian fields to a byte string
+ */
+class BinaryWriter {
+public:
+    explicit BinaryWriter(std::string& out) : out_(out) {}
+
+    template <class T>
+    void put(const T& v) {
+        if constexpr (std::is_same_v<T, bool>) {
+            out_.push_back(v ? 1 : 0);
+        } else if constexpr (std::is_enum_v<T>) {
+            put(static_cast<std::underlying_type_t<T>>(v));
+        } else if constexpr (std::is_integral_v<T>) {
+            T le = to_little(v);
+            out_.append(reinterpret_cast<const char*>(&le), sizeof(T));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            using U = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+            static_assert(sizeof(T) == sizeof(U), "unsupported floating point size");
+            put(std::bit_cast<U>(v));
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            put(std::uint32_t(v.size()));
+            out_.append(v);
+        } else if constexpr (is_vector<T>::value) {
+            put(std::uint32_t(v.size()));
+            for (const auto& e : v)
+                put(e);
+        } else if constexpr (serialization::is_std_array<T>::value) {
+            for (const auto& e : v)  // fixed length, no prefix
+                put(e);
+        } else if constexpr (serialization::has_fields<T> && is_encodable_v<T>) {
+            put_fields(v, T::fields());
+        } else {
+            static_assert(is_encodable_v<T>, "type has no binary encoding");
+        }
+    }
+
+    /// Write obj's members in the order listed by a fields() tuple
+    template <class C, class Fields>
+    void put_fields(const C& obj, const Fields& fields) {
+        serialization::for_each_field(fields, [&](const auto& f) { put(obj.*f.member); });
+    }
+
+    /// Short string with a u16 length, used in the frame header
+    void put_short(std::string_view s) {
+        if (s.size() > 0xFFFF)
+            throw WireError("string too long for frame header");
+        put(std::uint16_t(s.size()));
+        out_.append(s.data(), s.size());
+    }
+
+    std::size_t size() const noexcept { return out_.size(); }
+    std::string& buffer() noexcept { return out_; }
+
+private:
+    std::string& out_;
+};
+
+/**
+ * BinaryReader - Reads fields written by BinaryWriter; throws WireError
+ * instead of reading past the end
+ */
+class BinaryReader {
+public:
+    BinaryReader(const char* data, std::size_t size) : p_(data), end_(data + size) {}
+
+    template <class T>
+    T get() {
+        if constexpr (std::is_same_v<T, bool>) {
+            return take(1)[0] != 0;
+        } else if constexpr (std::is_enum_v<T>) {
+            return static_cast<T>(get<std::underlying_type_t<T>>());
+        } else if constexpr (std::is_integral_v<T>) {
+            T v;
+            std::memcpy(&v, take(sizeof(T)), sizeof(T));
+            return to_little(v);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            using U = std::conditional_t<sizeof(T) == 8, std::uint64_t, std::uint32_t>;
+            return std::bit_cast<T>(get<U>());
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            auto n = get<std::uint32_t>();
+            const char* s = take(n);
+            return std::string(s, n);
+        } else if constexpr (is_vector<T>::value) {
+            auto n = get<std::uint32_t>();
+            if (std::uint64_t(n) * min_encoded_size<typename T::value_type>() > remaining())
+                throw WireError("vector length exceeds frame");
+            T v;
+            v.reserve(n);
+            for (std::uint32_t i = 0; i < n; i++)
+                v.push_back(get<typename T::value_type>());
+            return v;
+        } else if constexpr (serialization::is_std_array<T>::value) {
+            T v;
+            for (auto& e : v)
+                e = get<typename T::value_type>();
+            return v;
+        } else if constexpr (serialization::has_fields<T> && is_encodable_v<T>) {
+            T v{};
+            get_fields(v, T::fields());
+            return v;
+        } else {
+            static_assert(is_encodable_v<T>, "type has no binary encoding");
+        }
+    }
+
+    /// Read into obj's members in the order listed by a fields() tuple
+    template <class C, class Fields>
+    void get_fields(C& obj, const Fields& fields) {
+        serialization::for_each_field(fields, [&](const auto& f) {
+            obj.*f.member = get<typename std::decay_t<decltype(f)>::type>();
+        });
+    }
+
+    std::string_view get_short() {
+        auto n = get<std::uint16_t>();
+        return std::string_view(take(n), n);
+    }
+
+    std::size_t remaining() const noexcept { return std::size_t(end_ - p_); }
+
+private:
+    const char* take(std::size_t n) {
+        if (n > remaining())
+            throw WireError("truncated frame");
+        const char* r = p_;
+        p_ += n;
+        return r;
+    }
+
+    const char* p_;
+    const char* end_;
+};
+
+/// Who to grant credits for a flow-controlled frame (see FlowControl.hpp)
+struct FlowTag {
+    std::uint64_t session = 0;
+    std::string_view reply_to;   // The sender's own endpoint
+    std::string_view endpoint;   // Ours, as the sender names it
+};
+
+/**
+ * Which WireHello the frame's receiver IDs come from, and where the
+ * receiver can ask for a new one. reply_to is the sender endpoint when
+ * the frame has a sender, so it is only written without one.
+ */
+struct SessionTag {
+    std::uint64_t session = 0;
+    std::string_view reply_to;
+};
+
+/// Decoded frame header; string views point into the received buffer
+struct Frame {
+    std::int32_t message_id = 0;
+    std::uint32_t receiver_id = 0;
+    std::string_view receiver;
+    bool has_sender = false;
+    std::string_view sender_actor;
+    std::string_view sender_endpoint;
+    std::uint64_t correlation_id = 0;
+    bool is_request = false;
+    bool is_reply = false;
+    bool has_flow = false;
+    FlowTag flow;
+    bool has_session = false;
+    SessionTag session;
+    const char* payload = nullptr;
+    std::size_t payload_len = 0;
+};
+
+inline bool is_binary(const void* data, std::size_t size) noexcept {
+    return size >= HEADER_SIZE && static_cast<const std::uint8_t*>(data)[0] == MAGIC;
+}
+
+/**
+ * Start a frame in out; append the payload with a BinaryWriter on the
+ * same string, then call finish_frame(). A nonzero correlation_id marks
+ * the frame as an ask() request, or with is_reply, as the answer to one.
+ * A flow tag makes it count against the sender's credits, and a session
+ * tag names the WireHello receiver_id was taken from.
+ */
+inline void begin_frame(std::string& out, std::int32_t message_id,
+                        std::uint32_t receiver_id, std::string_view receiver,
+                        std::string_view sender_actor, std::string_view sender_endpoint,
+                        std::uint64_t correlation_id = 0, bool is_reply = false,
+                        const FlowTag* flow = nullptr, const SessionTag* session = nullptr) {
+    out.clear();
+    BinaryWriter w(out);
+    bool has_sender = !sender_actor.empty();
+    std::uint8_t flags = has_sender ? FLAG_SENDER : 0;
+    if (correlation_id != 0)
+        flags |= is_reply ? FLAG_REPLY : FLAG_REQUEST;
+    if (flow)
+        flags |= FLAG_FLOW;
+    if (session)
+        flags |= FLAG_SESSION;
+    w.put(MAGIC);
+    w.put(VERSION);
+    w.put(flags);
+    w.put(std::uint8_t(0));
+    w.put(message_id);
+    w.put(receiver_id);
+    w.put(std::uint32_t(0));  // payload_len, patched by finish_frame()
+    if (receiver_id == 0)
+        w.put_short(receiver);
+    if (has_sender) {
+        w.put_short(sender_actor);
+        w.put_short(sender_endpoint);
+    }
+    if (correlation_id != 0)
+        w.put(correlation_id);
+    if (flow) {
+        w.put(flow->session);
+        w.put_short(flow->reply_to);
+        w.put_short(flow->endpoint);
+    }
+    if (session) {
+        w.put(session->session);
+        if (!has_sender)
+            w.put_short(session->reply_to);
+    }
+}
+
+/// Patch payload_len; payload_start is out.size() right after begin_frame()
+inline void finish_frame(std::string& out, std::size_t payload_start) {
+    std::uint32_t len = to_little(std::uint32_t(out.size() - payload_start));
+    std::memcpy(&out[12], &len, sizeof(len));
+}
+
+inline Frame parse_frame(const char* data, std::size_t size) {
+    if (!is_binary(data, size))
+        throw WireError("not a binary frame");
+    BinaryReader r(data, size);
+    Frame f;
+    r.get<std::uint8_t>();
+    if (r.get<std::uint8_t>() != VERSION)
+        throw WireError("unsupported frame version");
+    auto flags = r.get<std::uint8_t>();
+    r.get<std::uint8_t>();
+    f.message_id = r.get<std::int32_t>();
+    f.receiver_id = r.get<std::uint32_t>();
+    auto payload_len = r.get<std::uint32_t>();
+    if (f.receiver_id == 0)
+        f.receiver = r.get_short();
+    f.has_sender = flags & FLAG_SENDER;
+    if (f.has_sender) {
+        f.sender_actor = r.get_short();
+        f.sender_endpoint = r.get_short();
+    }
+    f.is_request = flags & FLAG_REQUEST;
+    f.is_reply = flags & FLAG_REPLY;
+    if (f.is_request || f.is_reply)
+        f.correlation_id = r.get<std::uint64_t>();
+    f.has_flow = flags & FLAG_FLOW;
+    if (f.has_flow) {
+        f.flow.session = r.get<std::uint64_t>();
+        f.flow.reply_to = r.get_short();
+        f.flow.endpoint = r.get_short();
+    }
+    f.has_session = flags & FLAG_SESSION;
+    if (f.has_session) {
+        f.session.session = r.get<std::uint64_t>();
+        f.session.reply_to = f.has_sender ? f.sender_endpoint : r.get_short();
+    }
+    if (payload_len != r.remaining())
+        throw WireError("payload length mismatch");
+    f.payload = data + (size - payload_len);
+    f.payload_len = payload_len;
+    return f;
+}
+
+} // namespace actors::wire
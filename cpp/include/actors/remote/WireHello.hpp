@@ -0,0 +1,107 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+WireHello and WireReset messages - binary wire format negotiation between C++ peers.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "actors/Message.hpp"
+#include "actors/remote/Serialization.hpp"
+
+namespace actors::msg {
+
+/**
+ * WireHello - Sent by a ZmqReceiver to a peer whose JSON envelope
+ * advertised the "bin1" wire format
+ *
+ * Tells the peer's ZmqSender that messages for `endpoint` may be sent
+ * as binary frames, and which interned IDs to use for receiver actors.
+ * The IDs hold for this run of the receiver only: every frame echoes
+ * `session`, and a receiver that does not know it answers WireReset.
+ * Always travels as JSON. Never delivered to an actor.
+ *
+ * Message ID: 11 (reserved for internal use)
+ */
+class WireHello : public Message_N<11> {
+public:
+    std::string endpoint;               // Endpoint string the peer sends to
+    std::vector<std::string> actors;    // Registered receiver names
+    std::vector<std::uint32_t> ids;     // Interned receiver IDs, same order
+    std::uint64_t session = 0;          // The receiver's run; 0 from older peers
+
+    WireHello() = default;
+
+    WireHello(std::string ep, std::vector<std::string> names, std::vector<std::uint32_t> actor_ids,
+              std::uint64_t s = 0)
+        : endpoint(std::move(ep))
+        , actors(std::move(names))
+        , ids(std::move(actor_ids))
+        , session(s) {}
+};
+
+/**
+ * WireReset - Sent by a ZmqReceiver for a binary frame whose session is
+ * not its own, e.g. after it restarted. The peer's ZmqSender goes back to
+ * JSON for every endpoint negotiated in `session`, and so advertises
+ * "bin1" again. Always travels as JSON. Never delivered to an actor.
+ *
+ * Message ID: 15 (reserved for internal use)
+ */
+class WireReset : public Message_N<15> {
+public:
+    std::uint64_t session = 0;  // The stale session
+
+    WireReset() = default;
+    explicit WireReset(std::uint64_t s) : session(s) {}
+};
+
+} // namespace actors::msg
+
+// Register WireHello and WireReset for remote serialization (JSON only)
+namespace {
+    static bool WireHello_registered_ = []() {
+        actors::serialization::register_message(11, "WireHello",
+            // Serialize
+            [](const actors::Message* m) -> nlohmann::json {
+                const actors::msg::WireHello* msg = static_cast<const actors::msg::WireHello*>(m);
+                return nlohmann::json{
+                    {"endpoint", msg->endpoint},
+                    {"actors", msg->actors},
+                    {"ids", msg->ids},
+                    {"session", msg->session}
+                };
+            },
+            // Deserialize
+            [](const nlohmann::json& j) -> actors::Message* {
+                return new actors::msg::WireHello(
+                    j["endpoint"].get<std::string>(),
+                    j["actors"].get<std::vector<std::string>>(),
+                    j["ids"].get<std::vector<std::uint32_t>>(),
+                    j.value("session", std::uint64_t(0))
+                );
+            });
+        return true;
+    }();
+
+    static bool WireReset_registered_ = []() {
+        actors::serialization::register_message(15, "WireReset",
+            // Serialize
+            [](const actors::Message* m) -> nlohmann::json {
+                const actors::msg::WireReset* msg = static_cast<const actors::msg::WireReset*>(m);
+                return nlohmann::json{{"session", msg->session}};
+            },
+            // Deserialize
+            [](const nlohmann::json& j) -> actors::Message* {
+                return new actors::msg::WireReset(j["session"].get<std::uint64_t>());
+            });
+        return true;
+    }();
+}
@@ -11,21 +11,43 @@ Implemented as an Actor that polls the socket and routes messages.
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <zmq.hpp>
 #include <nlohmann/json.hpp>
 #include "actors/Actor.hpp"
 #include "actors/ActorRef.hpp"
+#include "actors/Backoff.hpp"
 #include "actors/msg/Start.hpp"
 #include "actors/msg/Continue.hpp"
+#include "actors/remote/CreditGrant.hpp"
+#include "actors/remote/FlowControl.hpp"
+#include "actors/remote/ProxyCache.hpp"
 #include "actors/remote/Serialization.hpp"
 #include "actors/remote/Reject.hpp"
+#include "actors/remote/Wire.hpp"
+#include "actors/remote/WireHello.hpp"
 #include "actors/remote/ZmqSender.hpp"
 
+// Longest an I/O-thread receiver blocks in zmq_poll before rechecking shutdown
+#ifndef ACTOR_ZMQ_POLL_MS
+#define ACTOR_ZMQ_POLL_MS 100
+#endif
+
+// Deliveries with a reply proxy tracked before the first sweep for released ones
+#ifndef ACTOR_REPLY_REAP_MIN
+#define ACTOR_REPLY_REAP_MIN 64
+#endif
+
 namespace actors {
 
 /**
@@ -33,6 +55,26 @@ namespace actors {
  *
  * Binds to a ZMQ PULL socket and routes incoming messages to
  * registered local actors. Sends Reject messages for errors.
+ * Accepts JSON envelopes and binary frames (see Wire.hpp); a JSON
+ * envelope advertising "bin1" is answered once with a WireHello so the
+ * peer switches to binary frames. Its receiver IDs belong to this
+ * receiver's session: a frame echoing another session (we restarted, or
+ * another process took over the endpoint) is not routed by ID, and the
+ * peer gets a WireReset so it goes back to JSON and a fresh WireHello.
+ *
+ * By default the receiver polls from its own mailbox by sending itself
+ * Continue messages. use_io_thread() moves receiving to a dedicated
+ * thread that blocks in zmq_poll and drains every queued message per
+ * wake-up. Batched (multipart) sends are unpacked part by part.
+ *
+ * Replies to our own asks (ZmqSender::ask()) are matched by correlation
+ * ID and handed to the sender without involving an actor. Each ask from
+ * a peer is delivered with a reply proxy of its own that tags replies
+ * with the request's ID.
+ *
+ * Messages with a flow tag (ZmqSender::set_flow_control()) are counted
+ * per sender, and credits go back to it in CreditGrants as the target's
+ * mailbox has room (see CreditLedger, set_flow_window()).
  *
  * Usage:
  *   auto sender = std::make_shared<ZmqSender>("tcp://localhost:5001");
@@ -46,29 +88,49 @@ namespace actors {
 /**
  * RemoteReplyProxy - Proxy actor that forwards replies to remote actors
  *
- * When a remote message arrives, we create a proxy that the local actor
- * can use as reply_to. When the local actor calls reply(), the proxy
- * intercepts it and forwards via ZMQ.
+ * When a remote message arrives, the local actor gets a proxy as reply_to.
+ * When the local actor calls reply(), the proxy intercepts it and forwards
+ * via the shared ZmqSender (and its per-endpoint socket). ZmqReceiver keeps
+ * one proxy per remote sender in a bounded ProxyCache, and counts the
+ * deliveries that carry it, so an evicted proxy lives until they are all
+ * released.
+ *
+ * An ask gets a proxy of its own instead, made with the request's
+ * correlation ID and freed with its message. Every reply through it, in
+ * the handler or later while the message is retained, answers that ask.
  */
 class RemoteReplyProxy : public Actor {
-    std::shared_ptr<ZmqSender> sender_;
-    std::string remote_actor_;
-    std::string remote_endpoint_;
+    RemoteActorRef route_;
+    std::uint64_t ask_id_;   // Correlation ID this proxy answers, 0 if none
+    size_t deliveries_ = 0;  // Unreleased, with us as sender; under ZmqReceiver::route_mutex_
 
 public:
     RemoteReplyProxy(std::shared_ptr<ZmqSender> sender,
-                     std::string actor, std::string endpoint)
-        : sender_(std::move(sender))
-        , remote_actor_(std::move(actor))
-        , remote_endpoint_(std::move(endpoint)) {
+                     std::string actor, std::string endpoint, std::uint64_t ask_id = 0)
+        : route_(std::move(actor), std::move(endpoint), std::move(sender))
+        , ask_id_(ask_id) {
         strncpy(name, "RemoteReplyProxy", sizeof(name));
     }
 
+    /// The remote sender, so a Publisher can keep it as a subscriber
+    const RemoteActorRef* remote_route() const noexcept override { return &route_; }
+
+    std::uint64_t ask_id() const noexcept { return ask_id_; }
+
+    // Deliveries holding the proxy, counted by ZmqReceiver under route_mutex_
+    void hold() noexcept { deliveries_++; }
+    void drop() noexcept { deliveries_--; }
+    bool in_use() const noexcept { return deliveries_ != 0; }
+
     // Override send() to forward directly via ZMQ instead of queuing
     // This proxy is never started with a thread, so we handle it synchronously
     void send(const Message* m, Actor* /*sender*/ = nullptr) noexcept override {
+        if (ask_id_) {
+            route_.sender()->send_reply(route_.endpoint(), ask_id_, m);
+            return;
+        }
         // Forward this message to the remote actor
-        sender_->send_to(remote_endpoint_, remote_actor_, m, nullptr);
+        route_.sender()->send_to(route_.endpoint(), route_.name(), m, nullptr);
         // Note: ZmqSender::send_to deletes the message
     }
 };
@@ -107,10 +169,8 @@ public:
     }
 
     ~ZmqReceiver() {
-        // Clean up proxy actors
-        for (auto* proxy : proxies_) {
-            delete proxy;
-        }
+        stop_io_thread();
+        // proxies_ frees the reply proxies
     }
 
     /**
@@ -118,7 +178,75 @@ public:
      */
     void register_actor(const std::string& name, Actor* actor) {
         std::lock_guard<std::mutex> lock(registry_mutex_);
-        registry_[name] = actor;
+        Actor*& slot = registry_[name];
+        if (slot && slot != actor)
+            flow_.forget(slot);
+        slot = actor;
+        auto it = actor_ids_.find(name);
+        if (it == actor_ids_.end()) {
+            id_names_.push_back(name);
+            it = actor_ids_.emplace(name, std::uint32_t(id_names_.size())).first;  // 0 means "by name"
+        }
+        id_actors_.set(it->second, actor);
+    }
+
+    /// Register a local actor under its own name
+    void register_actor(Actor* actor) { register_actor(actor->get_name(), actor); }
+
+    /**
+     * Bound the reply proxy cache (default ACTOR_REPLY_PROXY_CACHE).
+     * Call before init().
+     */
+    void set_reply_proxy_limit(size_t limit) { proxies_.set_capacity(limit); }
+
+    size_t reply_proxy_count() const {
+        std::lock_guard<std::mutex> lock(route_mutex_);
+        return proxies_.size();
+    }
+
+    /**
+     * Route one raw inbound message (JSON envelope or binary frame) as if
+     * it had arrived on the socket. Thread-safe; used by ShmReceiver.
+     */
+    void route(const char* data, size_t size) {
+        if (wire::is_binary(data, size)) {
+            handle_binary_frame(data, size);
+            return;
+        }
+        try {
+            nlohmann::json envelope = nlohmann::json::parse(data, data + size);
+            handle_remote_message(envelope, size);
+        } catch (const nlohmann::json::exception& e) {
+            // JSON parse error - can't send reject (don't know sender)
+        }
+    }
+
+    /// Answer "bin1" adverts with a WireHello (default true). Call before init().
+    void set_accept_binary(bool accept) { accept_binary_ = accept; }
+
+    /**
+     * Credits each flow-controlled sender may have outstanding (default
+     * ACTOR_FLOW_WINDOW), and the target mailbox depth at which grants
+     * stop (default ACTOR_FLOW_MAX_DEPTH). window = 0 never grants, so
+     * senders stay unmetered.
+     */
+    void set_flow_window(size_t window, size_t max_depth = ACTOR_FLOW_MAX_DEPTH) {
+        flow_.configure(window, max_depth);
+    }
+
+    /// Flow-controlled senders seen, and those waiting for a mailbox to drain
+    size_t flow_peer_count() const { return flow_.peers(); }
+    size_t flow_withheld_count() const { return flow_.withheld(); }
+
+    /**
+     * Receive on a dedicated I/O thread instead of Continue polling.
+     * After draining the socket the thread keeps spinning on non-blocking
+     * receives for busy_poll before blocking in zmq_poll again; a nonzero
+     * value trades a core for latency on hot links. Call before init().
+     */
+    void use_io_thread(std::chrono::microseconds busy_poll = std::chrono::microseconds(0)) {
+        io_thread_mode_ = true;
+        busy_poll_ = busy_poll;
     }
 
     /**
@@ -126,16 +254,71 @@ public:
      */
     void unregister_actor(const std::string& name) {
         std::lock_guard<std::mutex> lock(registry_mutex_);
-        registry_.erase(name);
+        if (auto r = registry_.find(name); r != registry_.end()) {
+            flow_.forget(r->second);
+            registry_.erase(r);
+        }
+        auto it = actor_ids_.find(name);
+        if (it != actor_ids_.end())
+            id_actors_.set(it->second, nullptr);  // The ID stays interned for re-registration
     }
 
 private:
     void on_start(const msg::Start*) noexcept {
+        serialization::seal();
         running_ = true;
+        if (io_thread_mode_) {
+            io_thread_ = std::thread(&ZmqReceiver::io_loop, this);
+            return;
+        }
         // Send ourselves a Continue to start polling
         send(new msg::Continue(), this);
     }
 
+    void io_loop() noexcept {
+        zmq_pollitem_t item{socket_.handle(), 0, ZMQ_POLLIN, 0};
+        auto spin_until = std::chrono::steady_clock::now();
+        while (running_.load(std::memory_order_acquire)) {
+            recheck_flow();
+            if (drain() > 0) {
+                spin_until = std::chrono::steady_clock::now() + busy_poll_;
+                continue;
+            }
+            if (std::chrono::steady_clock::now() < spin_until) {
+                cpu_relax();
+                continue;
+            }
+            // Withheld credits are rechecked each millisecond
+            zmq_poll(&item, 1, flow_.withheld() ? 1 : ACTOR_ZMQ_POLL_MS);
+        }
+    }
+
+    // Handle every message queued on the socket without blocking
+    size_t drain() noexcept {
+        size_t n = 0;
+        try {
+            zmq::message_t message;
+            while (running_.load(std::memory_order_relaxed)
+                   && socket_.recv(message, zmq::recv_flags::dontwait).has_value()) {
+                handle_raw(message);
+                n++;
+            }
+        } catch (const zmq::error_t&) {
+            // EINTR, or context being torn down
+        }
+        return n;
+    }
+
+    void stop_io_thread() noexcept {
+        running_ = false;
+        if (io_thread_.joinable() && io_thread_.get_id() != std::this_thread::get_id())
+            io_thread_.join();
+    }
+
+    void end() override {
+        stop_io_thread();
+    }
+
     void on_continue(const msg::Continue*) noexcept {
         if (!running_) return;
 
@@ -145,14 +328,10 @@ private:
             auto result = socket_.recv(message, zmq::recv_flags::none);
 
             if (result.has_value()) {
-                // Parse JSON
-                std::string data(static_cast<char*>(message.data()), message.size());
-                try {
-                    nlohmann::json envelope = nlohmann::json::parse(data);
-                    handle_remote_message(envelope);
-                } catch (const nlohmann::json::exception& e) {
-                    // JSON parse error - can't send reject (don't know sender)
-                }
+                handle_raw(message);
+                // Rest of a batched (multipart) send is already here
+                while (message.more() && socket_.recv(message, zmq::recv_flags::dontwait).has_value())
+                    handle_raw(message);
             }
         } catch (const zmq::error_t& e) {
             // ZMQ error - ignore timeouts
@@ -161,35 +340,80 @@ private:
             }
         }
 
+        recheck_flow();
+
         // Continue polling
         if (running_) {
             send(new msg::Continue(), this);
         }
     }
 
-    void handle_remote_message(const nlohmann::json& envelope) {
+    void handle_raw(const zmq::message_t& message) {
+        route(static_cast<const char*>(message.data()), message.size());
+    }
+
+    void handle_remote_message(const nlohmann::json& envelope, size_t size) {
         std::string receiver_name = envelope["receiver"].get<std::string>();
         std::string msg_type = envelope["message_type"].get<std::string>();
 
         // Get sender info for replies
-        std::string sender_actor;
-        std::string sender_endpoint;
+        std::string_view sender_actor;
+        std::string_view sender_endpoint;
         bool has_sender = !envelope["sender_actor"].is_null();
         if (has_sender) {
-            sender_actor = envelope["sender_actor"].get<std::string>();
-            sender_endpoint = envelope["sender_endpoint"].get<std::string>();
+            sender_actor = envelope["sender_actor"].get_ref<const std::string&>();
+            sender_endpoint = envelope["sender_endpoint"].get_ref<const std::string&>();
         }
 
-        // Find target actor
-        Actor* target = nullptr;
-        {
-            std::lock_guard<std::mutex> lock(registry_mutex_);
-            auto it = registry_.find(receiver_name);
-            if (it != registry_.end()) {
-                target = it->second;
-            }
+        if (accept_binary_ && envelope.contains("wire_formats"))
+            offer_binary(envelope);
+
+        if (auto it = envelope.find("flow_reply_to"); it != envelope.end() && it->is_string()) {
+            auto ep = envelope.find("flow_endpoint");
+            auto session = envelope.find("flow_session");
+            if (ep != envelope.end() && ep->is_string() && session != envelope.end() && session->is_number_unsigned())
+                credit(it->get_ref<const std::string&>(), ep->get_ref<const std::string&>(),
+                       session->get<std::uint64_t>(), find_target(receiver_name));
         }
 
+        // Answer to one of our asks: no actor involved
+        std::uint64_t reply_id = ZmqSender::parse_ask_name(receiver_name);
+        if (auto it = envelope.find("in_reply_to"); it != envelope.end() && it->is_number_unsigned())
+            reply_id = it->get<std::uint64_t>();
+        if (reply_id != 0) {
+            if (Message* m = serialization::deserialize(msg_type, envelope["message"]))
+                sender_->complete_ask(reply_id, std::unique_ptr<const Message>(m));
+            return;
+        }
+        std::uint64_t ask_id = 0;
+        if (auto it = envelope.find("correlation_id"); it != envelope.end() && it->is_number_unsigned())
+            ask_id = it->get<std::uint64_t>();
+
+        if (msg_type == "WireHello") {
+            Message* m = serialization::deserialize(msg_type, envelope["message"]);
+            if (auto* hello = dynamic_cast<msg::WireHello*>(m))
+                sender_->enable_binary(hello->endpoint, hello->actors, hello->ids, hello->session);
+            delete m;
+            return;
+        }
+        if (msg_type == "WireReset") {
+            Message* m = serialization::deserialize(msg_type, envelope["message"]);
+            if (auto* reset = dynamic_cast<msg::WireReset*>(m))
+                sender_->reset_binary(reset->session);
+            delete m;
+            return;
+        }
+        if (msg_type == "CreditGrant") {
+            Message* m = serialization::deserialize(msg_type, envelope["message"]);
+            if (auto* g = dynamic_cast<msg::CreditGrant*>(m))
+                sender_->grant(g->endpoint, g->session, g->consumed, g->limit);
+            delete m;
+            return;
+        }
+
+        // Find target actor
+        Actor* target = find_target(receiver_name);
+
         if (!target) {
             // Actor not found - send Reject
             if (has_sender) {
@@ -212,42 +436,279 @@ private:
             return;
         }
 
-        // Create proxy for reply routing
-        Actor* reply_actor = nullptr;
+        deliver(target, msg, has_sender, sender_actor, sender_endpoint, ask_id, size);
+    }
+
+    void handle_binary_frame(const char* data, size_t size) {
+        wire::Frame f;
+        try {
+            f = wire::parse_frame(data, size);
+        } catch (const wire::WireError&) {
+            return;  // Malformed header - can't send reject (don't know sender)
+        }
+
+        // IDs from a WireHello of another session may name other receivers
+        // now; only the name is trusted, and the sender is told to reset
+        bool stale = f.has_session && f.session.session != session_;
+        if (stale)
+            reset_wire(f.session.reply_to, f.session.session);
+        std::uint32_t receiver_id = stale ? 0 : f.receiver_id;
+
+        if (f.has_flow)
+            credit(f.flow.reply_to, f.flow.endpoint, f.flow.session,
+                   receiver_id != 0 ? id_actors_.get(receiver_id) : find_target(f.receiver));
+
+        // Answer to one of our asks: no actor involved
+        std::uint64_t reply_id = f.is_reply ? f.correlation_id : ZmqSender::parse_ask_name(f.receiver);
+        if (reply_id != 0) {
+            const serialization::RegistryEntry* entry = serialization::MessageRegistry::instance().find(f.message_id);
+            if (!entry || !entry->has_binary())
+                return;
+            try {
+                wire::BinaryReader r(f.payload, f.payload_len);
+                std::unique_ptr<const Message> m(entry->read(r));
+                if (r.remaining() == 0)
+                    sender_->complete_ask(reply_id, std::move(m));
+            } catch (const wire::WireError&) {
+                // Malformed reply; the ask times out
+            }
+            return;
+        }
+
+        // Interned receiver IDs route without the lock or a string lookup;
+        // names are only resolved for frames addressed by name and rejects
+        Actor* target = receiver_id != 0 ? id_actors_.get(receiver_id) : nullptr;
+        if (!target && !(stale && f.receiver_id != 0))
+            target = find_target(receiver_name(receiver_id, f.receiver));
+        const serialization::RegistryEntry* entry = serialization::MessageRegistry::instance().find(f.message_id);
+
+        auto reject = [&](const std::string& reason) {
+            if (f.has_sender) {
+                send_reject(std::string(f.sender_endpoint), std::string(f.sender_actor),
+                           entry ? entry->type_name : std::to_string(f.message_id),
+                           reason, receiver_name(receiver_id, f.receiver));
+            }
+        };
+
+        if (stale && f.receiver_id != 0) {
+            reject("Stale wire session: receiver id " + std::to_string(f.receiver_id) + " not known");
+            return;
+        }
+        if (!target) {
+            reject("Actor '" + receiver_name(receiver_id, f.receiver) + "' not found");
+            return;
+        }
+        if (!entry || !entry->has_binary()) {
+            reject("Unknown message type: " + (entry ? entry->type_name : std::to_string(f.message_id)));
+            return;
+        }
+
+        Message* msg = nullptr;
+        try {
+            wire::BinaryReader r(f.payload, f.payload_len);
+            msg = entry->read(r);
+            if (r.remaining() != 0) {
+                delete msg;
+                reject("Deserialization failed: trailing bytes");
+                return;
+            }
+        } catch (const wire::WireError& e) {
+            reject(std::string("Deserialization failed: ") + e.what());
+            return;
+        }
+
+        deliver(target, msg, f.has_sender, f.sender_actor, f.sender_endpoint,
+                f.is_request ? f.correlation_id : 0, size);
+    }
+
+    Actor* find_target(std::string_view receiver_name) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        auto it = registry_.find(receiver_name);
+        return it != registry_.end() ? it->second : nullptr;
+    }
+
+    // Name an interned receiver ID stands for, or name if there is none
+    std::string receiver_name(std::uint32_t id, std::string_view name) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        if (id != 0 && id <= id_names_.size())
+            return id_names_[id - 1];
+        return std::string(name);
+    }
+
+    void deliver(Actor* target, Message* msg, bool has_sender,
+                 std::string_view sender_actor, std::string_view sender_endpoint,
+                 std::uint64_t ask_id, size_t wire_bytes) {
+        // Reply routing: one cached proxy per remote sender, and one of
+        // its own for each ask (its sender names a distinct "$ask:<id>")
+        RemoteReplyProxy* reply_actor = nullptr;
+        const Message* sent = msg;
         if (has_sender) {
-            // Create a proxy that forwards replies to the remote sender
-            auto* proxy = new RemoteReplyProxy(sender_, sender_actor, sender_endpoint);
-            proxies_.push_back(proxy);
-            reply_actor = proxy;
+            std::lock_guard<std::mutex> lock(route_mutex_);
+            // Our reference to the message shows when the target is done
+            // with it, and until then the proxy must stay
+            if (in_flight_.size() >= reap_at_)
+                reap();
+            auto held = Shared<Message>::adopt(msg);
+            sent = held.share();
+            if (ask_id) {
+                auto ask = std::make_unique<RemoteReplyProxy>(sender_, std::string(sender_actor),
+                                                              std::string(sender_endpoint), ask_id);
+                reply_actor = ask.get();
+                in_flight_.push_back({std::move(held), reply_actor, std::move(ask)});
+            } else {
+                reply_actor = proxies_.get(sender_actor, sender_endpoint,
+                    [this](const std::string& actor, const std::string& endpoint) {
+                        return new RemoteReplyProxy(sender_, actor, endpoint);
+                    });
+                reply_actor->hold();
+                in_flight_.push_back({std::move(held), reply_actor, nullptr});
+            }
         }
 
         // Send to target actor
-        target->send(msg, reply_actor);
+        target->count_bytes_in(wire_bytes);
+        target->send(sent, reply_actor);
+    }
+
+    // Drop the deliveries targets have released, with their ask proxies,
+    // then the cached proxies no delivery holds. Caller holds route_mutex_.
+    void reap() {
+        std::erase_if(in_flight_, [](InFlight& f) {
+            if (f.msg.use_count() > 1)
+                return false;
+            if (!f.ask)
+                f.proxy->drop();
+            return true;
+        });
+        proxies_.collect();
+        reap_at_ = std::max<size_t>(ACTOR_REPLY_REAP_MIN, 2 * in_flight_.size());
+    }
+
+    /**
+     * Answer a "bin1" advert once per (reply endpoint, endpoint) pair and
+     * sender session with our interned receiver IDs and session
+     */
+    void offer_binary(const nlohmann::json& envelope) {
+        const auto& formats = envelope["wire_formats"];
+        if (!formats.is_array() || std::find(formats.begin(), formats.end(), wire::FORMAT_NAME) == formats.end())
+            return;
+        if (!envelope.contains("wire_endpoint") || !envelope.contains("wire_reply_to"))
+            return;
+        std::string endpoint = envelope["wire_endpoint"].get<std::string>();
+        std::string reply_to = envelope["wire_reply_to"].get<std::string>();
+        std::uint64_t sender_session = 0;  // Absent from older senders
+        if (auto it = envelope.find("wire_session"); it != envelope.end() && it->is_number_unsigned())
+            sender_session = it->get<std::uint64_t>();
+        {
+            // A restarted sender (new session) has forgotten our hello
+            std::lock_guard<std::mutex> lock(route_mutex_);
+            auto [it, fresh] = hello_sent_.try_emplace(reply_to + '\n' + endpoint, sender_session);
+            if (!fresh && it->second == sender_session)
+                return;
+            it->second = sender_session;
+        }
+
+        std::vector<std::string> names;
+        std::vector<std::uint32_t> ids;
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex_);
+            for (const auto& [n, id] : actor_ids_) {
+                names.push_back(n);
+                ids.push_back(id);
+            }
+        }
+        sender_->send_to(reply_to, "$wire", new msg::WireHello(endpoint, std::move(names), std::move(ids), session_), nullptr);
+    }
+
+    // Tell a peer sending IDs from another session to go back to JSON, once
+    void reset_wire(std::string_view reply_to, std::uint64_t session) {
+        if (reply_to.empty())
+            return;
+        std::string key(reply_to);
+        key += '\n';
+        key += std::to_string(session);
+        {
+            std::lock_guard<std::mutex> lock(route_mutex_);
+            if (!reset_sent_.insert(std::move(key)).second)
+                return;
+        }
+        sender_->send_to(std::string(reply_to), "$wire", new msg::WireReset(session), nullptr);
+    }
+
+    // Count a flow-tagged message; send the sender credits if it is due some
+    void credit(std::string_view reply_to, std::string_view endpoint, std::uint64_t session, Actor* target) {
+        CreditLedger::Grant g;
+        if (flow_.consume(reply_to, endpoint, session, target, g))
+            send_grant(g);
     }
 
-    void send_reject(const std::string& endpoint,
-                     const std::string& actor_name,
+    // Grants withheld while a target's mailbox was too deep
+    void recheck_flow() {
+        if (flow_.withheld() == 0)
+            return;
+        std::vector<CreditLedger::Grant> grants;
+        flow_.recheck(grants);
+        for (const auto& g : grants)
+            send_grant(g);
+    }
+
+    void send_grant(const CreditLedger::Grant& g) {
+        sender_->send_to(g.reply_to, std::string(ZmqSender::FLOW_RECEIVER),
+                         new msg::CreditGrant(g.endpoint, g.session, g.consumed, g.limit), nullptr);
+    }
+
+    void send_reject(std::string_view endpoint,
+                     std::string_view actor_name,
                      const std::string& msg_type,
                      const std::string& reason,
                      const std::string& rejected_by) {
         auto* reject = new msg::Reject(msg_type, reason, rejected_by);
-        sender_->send_to(endpoint, actor_name, reject, nullptr);
+        sender_->send_to(std::string(endpoint), std::string(actor_name), reject, nullptr);
     }
 
     void terminate() noexcept override {
-        running_ = false;
+        stop_io_thread();
         Actor::terminate();
     }
 
+    // Manager::shutdown(): stop receiving; what arrived is still handled
+    void on_drain() noexcept override {
+        stop_io_thread();
+    }
+
 private:
     zmq::context_t context_;
     zmq::socket_t socket_;
     std::shared_ptr<ZmqSender> sender_;
     std::string bind_endpoint_;
-    std::unordered_map<std::string, Actor*> registry_;
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+    };
+    std::unordered_map<std::string, Actor*, NameHash, std::equal_to<>> registry_;
     std::mutex registry_mutex_;
-    bool running_;
-    std::vector<RemoteReplyProxy*> proxies_;
+    std::unordered_map<std::string, std::uint32_t> actor_ids_;  // Interned receiver IDs
+    std::vector<std::string> id_names_;                         // id - 1 -> name
+    IdTable<Actor> id_actors_;                                  // id -> actor, read without the lock
+    std::unordered_map<std::string, std::uint64_t> hello_sent_;  // reply_to + '\n' + endpoint -> sender session
+    std::unordered_set<std::string> reset_sent_;                // reply_to + '\n' + stale session
+    const std::uint64_t session_ = wire::new_session();        // Of our WireHellos
+    CreditLedger flow_;
+    bool accept_binary_ = true;
+    std::atomic<bool> running_;
+    bool io_thread_mode_ = false;
+    std::chrono::microseconds busy_poll_{0};
+    std::thread io_thread_;
+    ProxyCache<RemoteReplyProxy> proxies_;
+    // A delivery sent with a reply proxy, until the target releases the message
+    struct InFlight {
+        Shared<Message> msg;
+        RemoteReplyProxy* proxy;                // Cached, counted by hold()
+        std::unique_ptr<RemoteReplyProxy> ask;  // Or the delivery's own, for an ask
+    };
+    std::vector<InFlight> in_flight_;
+    size_t reap_at_ = ACTOR_REPLY_REAP_MIN;
+    mutable std::mutex route_mutex_;  // proxies_, in_flight_, hello_sent_, reset_sent_ (route() may run on several threads)
 };
 
 } // namespace actors
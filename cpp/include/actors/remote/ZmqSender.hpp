@@ -11,17 +11,39 @@ Runs on its own thread so sending never blocks the caller.
 
 #pragma once
 
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 #include <zmq.hpp>
 #include <nlohmann/json.hpp>
 #include "actors/Actor.hpp"
 #include "actors/ActorRef.hpp"
 #include "actors/Message.hpp"
+#include "actors/msg/Shutdown.hpp"
 #include "actors/msg/Start.hpp"
+#include "actors/msg/Timeout.hpp"
+#include "actors/act/TimerWheel.hpp"
+#include "actors/remote/CreditGrant.hpp"
+#include "actors/remote/FlowControl.hpp"
 #include "actors/remote/Serialization.hpp"
+#include "actors/remote/Wire.hpp"
+
+// JSON envelopes per endpoint that offer the binary format before giving up
+#ifndef ACTOR_WIRE_ADVERTS
+#define ACTOR_WIRE_ADVERTS 16
+#endif
 
 namespace actors {
 
@@ -31,26 +53,320 @@ class ZmqSender;
 
 /**
  * Internal message for async remote sends
- * Message ID 8 (reserved for internal use)
+ * Message ID 12 (reserved for internal use; was 8, which msg::Timeout uses)
+ *
+ * Carries the finished wire bytes (JSON envelope or binary frame), built
+ * once on the caller's thread. The sender thread moves them into the
+ * zmq::message_t without copying. With more parts they all go out as one
+ * multipart message (see ZmqSender::send_to_each()). flow marks bytes
+ * encoded with a flow tag, which count against the endpoint's credits.
  */
-class RemoteSendRequest : public Message_N<8> {
+class RemoteSendRequest : public Message_N<12> {
 public:
     std::string endpoint;
-    std::string actor_name;
-    std::string sender_name;      // Empty if no sender
-    std::string sender_endpoint;  // Empty if no sender
-    std::string message_type;
-    std::string message_json;     // Pre-serialized message JSON
-
-    RemoteSendRequest(std::string ep, std::string actor,
-                      std::string s_name, std::string s_ep,
-                      std::string msg_type, std::string msg_json)
+    mutable std::string data;     // Moved out by ZmqSenderShard::write()
+    mutable std::vector<std::string> more;  // Further parts, likewise
+    bool flow = false;
+
+    RemoteSendRequest(std::string ep, std::string bytes)
+        : endpoint(std::move(ep))
+        , data(std::move(bytes)) {}
+
+    RemoteSendRequest(std::string ep, std::string bytes, std::vector<std::string> parts)
         : endpoint(std::move(ep))
-        , actor_name(std::move(actor))
-        , sender_name(std::move(s_name))
-        , sender_endpoint(std::move(s_ep))
-        , message_type(std::move(msg_type))
-        , message_json(std::move(msg_json)) {}
+        , data(std::move(bytes))
+        , more(std::move(parts)) {}
+};
+
+/**
+ * BatchPolicy - Outbound batching for one endpoint (off unless set)
+ *
+ * Messages for the endpoint are held and sent together as one ZMQ
+ * multipart message. Each part is an ordinary envelope or frame, so any
+ * receiver - including Rust and Python ones that read one part at a
+ * time - handles a batch like separate sends. A batch is flushed when it
+ * reaches max_messages or max_bytes, and once the sender's mailbox is
+ * drained. A nonzero max_delay instead holds an idle batch until its
+ * oldest message is that old (timer-driven, so at 1 ms resolution).
+ */
+struct BatchPolicy {
+    size_t max_messages = 64;
+    size_t max_bytes = 64 * 1024;
+    std::chrono::microseconds max_delay{0};
+};
+
+/**
+ * ZmqSenderShard - PUSH sockets and batches for the endpoints hashed to it
+ *
+ * ZmqSender owns one or more shards. Each endpoint always maps to the same
+ * shard, so messages to one endpoint stay in order. Shard 0 does its I/O on
+ * the ZmqSender's own thread; the others are actors run on threads the
+ * ZmqSender starts. A socket is only used by its shard's thread, except by
+ * set_batching(), clear_batching(), grant() and close(), which lock.
+ */
+class ZmqSenderShard : public Actor {
+public:
+    /**
+     * @param timer_target Actor woken for max_delay batching; its
+     *        msg::Timeout (data 0) must call on_flush_timer()
+     */
+    ZmqSenderShard(zmq::context_t& context, size_t index, Actor* timer_target)
+        : context_(context)
+        , index_(index)
+        , timer_target_(timer_target ? timer_target : this) {
+        snprintf(name, sizeof(name), "ZmqSender.%zu", index);
+
+        MESSAGE_HANDLER(RemoteSendRequest, on_send_request);
+        MESSAGE_HANDLER(msg::Timeout, on_timeout);
+    }
+
+    size_t index() const { return index_; }
+
+    /**
+     * Hand the request's bytes to zmq (or its endpoint's batch)
+     * @param drained The calling actor's mailbox is empty (see Actor::mailbox_drained())
+     */
+    void write(const RemoteSendRequest* req, bool drained) {
+        zmq::message_t message = take(req->data);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto f = req->flow ? flows_.find(req->endpoint) : flows_.end();
+        if (f != flows_.end() && f->second.enabled()) {
+            size_t parts = 1 + req->more.size();
+            if (!f->second.can_send()) {
+                // Out of credits: hold (or drop) it rather than block this thread
+                Parts held;
+                held.reserve(parts);
+                held.push_back(std::move(message));
+                for (std::string& part : req->more)
+                    held.push_back(take(part));
+                f->second.hold(std::move(held), parts);
+                if (drained)
+                    flush_due();
+                return;
+            }
+            f->second.sent(parts);
+        }
+        emit(req->endpoint, message, req->more.size(), [&](size_t i) { return take(req->more[i]); });
+
+        // Mailbox drained: nothing more to coalesce with for now
+        if (drained)
+            flush_due();
+    }
+
+    void set_batching(const std::string& endpoint, const BatchPolicy& policy) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& b = batches_[endpoint];
+        flush(endpoint, b);
+        b.policy = policy;
+        if (b.policy.max_messages == 0)
+            b.policy.max_messages = 1;
+    }
+
+    void clear_batching(const std::string& endpoint) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = batches_.find(endpoint);
+        if (it == batches_.end())
+            return;
+        flush(endpoint, it->second);
+        batches_.erase(it);
+    }
+
+    void set_flow_control(const std::string& endpoint, const FlowPolicy& policy, std::uint64_t session) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = flows_.find(endpoint);
+        if (it == flows_.end()) {
+            it = flows_.emplace(endpoint, Window(policy)).first;
+            it->second.set_session(session);
+        }
+        it->second.set_policy(policy);
+    }
+
+    void clear_flow_control(const std::string& endpoint) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = flows_.find(endpoint);
+        if (it == flows_.end())
+            return;
+        it->second.disable([&](Parts& held) { emit_held(endpoint, held); });
+        flush_due();
+    }
+
+    /// Apply a CreditGrant from the peer and send what it lets through
+    void grant(const std::string& endpoint, std::uint64_t session, std::uint64_t consumed, std::uint64_t limit) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = flows_.find(endpoint);
+        if (it == flows_.end() || !it->second.grant(session, consumed, limit) || !it->second.enabled())
+            return;
+        it->second.release([&](Parts& held) { emit_held(endpoint, held); });
+        flush_due();
+    }
+
+    /// Counters for endpoint; all zero if it never had flow control
+    FlowStats flow_stats(const std::string& endpoint) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = flows_.find(endpoint);
+        return it == flows_.end() ? FlowStats{} : it->second.stats();
+    }
+
+    void collect_flow_stats(std::unordered_map<std::string, FlowStats>& out) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [endpoint, w] : flows_)
+            out.emplace(endpoint, w.stats());
+    }
+
+    /// Flush pending batches that are due and re-arm the batching timer
+    void on_flush_timer() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        timer_armed_ = false;
+        flush_due();
+    }
+
+    void flush_all() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [endpoint, b] : batches_)
+            flush(endpoint, b);
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [endpoint, b] : batches_)
+            flush(endpoint, b);
+        sockets_.clear();
+    }
+
+protected:
+    void end() override { flush_all(); }
+
+private:
+    void on_send_request(const RemoteSendRequest* req) noexcept { write(req, mailbox_drained()); }
+
+    void on_timeout(const msg::Timeout*) noexcept { on_flush_timer(); }
+
+    static void free_bytes(void* /*data*/, void* hint) noexcept {
+        delete static_cast<std::string*>(hint);
+    }
+
+    // Pure I/O: zmq frees the bytes when sent
+    static zmq::message_t take(std::string& data) {
+        auto* bytes = new std::string(std::move(data));
+        return zmq::message_t(bytes->data(), bytes->size(), free_bytes, bytes);
+    }
+
+    // Pending outbound batch for one endpoint
+    struct Batch {
+        BatchPolicy policy;
+        std::vector<zmq::message_t> parts;  // cleared, not freed, on flush
+        size_t bytes = 0;
+        std::chrono::steady_clock::time_point first;
+    };
+
+    using Parts = std::vector<zmq::message_t>;
+    using Window = CreditWindow<Parts>;
+
+    /**
+     * Send first and more further parts (part(i) makes the i-th) as one
+     * message, or add them to the endpoint's batch. Caller holds mutex_.
+     */
+    template <class Part>
+    void emit(const std::string& endpoint, zmq::message_t& first, size_t more, Part&& part) {
+        auto it = batches_.find(endpoint);
+        if (it == batches_.end()) {
+            zmq::socket_t& socket = socket_for(endpoint);
+            for (size_t i = 0; i < more; i++) {
+                socket.send(first, zmq::send_flags::sndmore);
+                first = part(i);
+            }
+            socket.send(first, zmq::send_flags::none);
+            return;
+        }
+        Batch& b = it->second;
+        if (b.parts.empty())
+            b.first = std::chrono::steady_clock::now();
+        b.bytes += first.size();
+        b.parts.push_back(std::move(first));
+        for (size_t i = 0; i < more; i++) {
+            b.parts.push_back(part(i));
+            b.bytes += b.parts.back().size();
+        }
+        if (b.parts.size() >= b.policy.max_messages || b.bytes >= b.policy.max_bytes
+            || (b.policy.max_delay.count() > 0
+                && std::chrono::steady_clock::now() - b.first >= b.policy.max_delay))
+            flush(endpoint, b);
+    }
+
+    // emit() a message held for credits. Caller holds mutex_.
+    void emit_held(const std::string& endpoint, Parts& held) {
+        emit(endpoint, held[0], held.size() - 1, [&](size_t i) { return std::move(held[i + 1]); });
+    }
+
+    // Caller holds mutex_
+    void flush(const std::string& endpoint, Batch& b) {
+        if (b.parts.empty())
+            return;
+        zmq::socket_t& socket = socket_for(endpoint);
+        for (size_t i = 0; i + 1 < b.parts.size(); i++)
+            socket.send(b.parts[i], zmq::send_flags::sndmore);
+        socket.send(b.parts.back(), zmq::send_flags::none);
+        b.parts.clear();
+        b.bytes = 0;
+    }
+
+    // Flush batches allowed to go out on idle; arm a timer for the rest.
+    // Caller holds mutex_.
+    void flush_due() {
+        auto now = std::chrono::steady_clock::now();
+        std::chrono::microseconds wait = std::chrono::microseconds::max();
+        for (auto& [endpoint, b] : batches_) {
+            if (b.parts.empty())
+                continue;
+            auto age = std::chrono::duration_cast<std::chrono::microseconds>(now - b.first);
+            if (age >= b.policy.max_delay)
+                flush(endpoint, b);
+            else if (b.policy.max_delay - age < wait)
+                wait = b.policy.max_delay - age;
+        }
+        if (wait != std::chrono::microseconds::max() && !timer_armed_) {
+            timer_armed_ = true;
+            auto ms = std::chrono::ceil<std::chrono::milliseconds>(wait);
+            TimerWheel::instance().schedule(timer_target_, ms.count() > 0 ? ms : std::chrono::milliseconds(1));
+        }
+    }
+
+    // Caller holds mutex_
+    zmq::socket_t& socket_for(const std::string& endpoint) {
+        // Get or create socket
+        auto it = sockets_.find(endpoint);
+        if (it == sockets_.end()) {
+            zmq::socket_t socket(context_, zmq::socket_type::push);
+
+            // Convert endpoint for connection
+            std::string connect_endpoint = endpoint;
+            // Replace *: with localhost: for connection
+            size_t pos = connect_endpoint.find("*:");
+            if (pos != std::string::npos) {
+                connect_endpoint.replace(pos, 2, "localhost:");
+            }
+            // Replace 0.0.0.0: with localhost: for connection
+            pos = connect_endpoint.find("0.0.0.0:");
+            if (pos != std::string::npos) {
+                connect_endpoint.replace(pos, 8, "localhost:");
+            }
+
+            socket.connect(connect_endpoint);
+            auto result = sockets_.emplace(endpoint, std::move(socket));
+            it = result.first;
+        }
+        return it->second;
+    }
+
+    zmq::context_t& context_;
+    size_t index_;
+    Actor* timer_target_;
+    std::unordered_map<std::string, zmq::socket_t> sockets_;
+    std::unordered_map<std::string, Batch> batches_;  // Endpoints with batching on
+    std::unordered_map<std::string, Window> flows_;   // Endpoints that had flow control
+    bool timer_armed_ = false;
+    mutable std::mutex mutex_;
 };
 
 /**
@@ -59,7 +375,12 @@ public:
  * Features:
  * - Async sending (never blocks caller)
  * - Connection caching (one socket per endpoint)
+ * - Optional sharding: endpoints hashed over N sender threads
  * - JSON wire protocol compatible with Rust/Python
+ * - Binary frames (Wire.hpp) to C++ peers that have answered with a WireHello
+ * - Opt-in per-endpoint batching (set_batching())
+ * - Opt-in per-endpoint credit-based flow control (set_flow_control())
+ * - Request/response with correlation IDs (ask())
  *
  * Usage:
  *   auto sender = std::make_shared<ZmqSender>("tcp://localhost:5002");
@@ -67,6 +388,9 @@ public:
  *
  *   // After init(), sends are async:
  *   sender->send_to("tcp://localhost:5001", "pong", new Ping{1}, this);
+ *
+ *   // Four sender threads and two zmq I/O threads:
+ *   auto sender = std::make_shared<ZmqSender>("tcp://localhost:5002", 4, 2);
  */
 class ZmqSender : public Actor, public std::enable_shared_from_this<ZmqSender> {
 public:
@@ -74,17 +398,31 @@ public:
      * Create a ZmqSender
      *
      * @param local_endpoint Our endpoint for reply routing (e.g., "tcp://localhost:5002")
+     * @param shards Sender threads; each endpoint is hashed to one of them.
+     *        Shard 0 is this actor's thread, the others start with it.
+     * @param io_threads I/O threads of the zmq context shared by all shards
      */
-    explicit ZmqSender(const std::string& local_endpoint)
-        : context_(1)
-        , local_endpoint_(local_endpoint) {
+    explicit ZmqSender(const std::string& local_endpoint, size_t shards = 1, int io_threads = 1)
+        : context_(io_threads)
+        , local_endpoint_(local_endpoint)
+        , flow_session_(new_flow_session()) {
         strncpy(name, "ZmqSender", sizeof(name));
 
+        if (shards == 0)
+            shards = 1;
+        shards_.reserve(shards);
+        shards_.push_back(std::make_unique<ZmqSenderShard>(context_, 0, this));
+        for (size_t i = 1; i < shards; i++)
+            shards_.push_back(std::make_unique<ZmqSenderShard>(context_, i, nullptr));
+
         MESSAGE_HANDLER(msg::Start, on_start);
         MESSAGE_HANDLER(RemoteSendRequest, on_send_request);
+        MESSAGE_HANDLER(msg::Timeout, on_timeout);
     }
 
     ~ZmqSender() {
+        fail_asks();
+        stop_shards();
         close();
     }
 
@@ -104,32 +442,306 @@ public:
                  const std::string& actor_name,
                  const Message* msg,
                  Actor* sender = nullptr) {
-        // Get type name and serialize message NOW (on caller's thread)
-        std::string type_name = serialization::get_type_name(msg->get_message_id());
-        if (type_name.empty()) {
-            delete msg;
-            throw std::runtime_error("Message type not registered: " + std::to_string(msg->get_message_id()));
+        // Encode the wire bytes NOW (on caller's thread)
+        std::string data;
+        bool flow = flowing(endpoint, actor_name);
+        try {
+            encode_as(endpoint, actor_name, msg, sender ? sender->get_name() : "", data, false, 0, false, flow);
+        } catch (...) {
+            msg->release();
+            throw;
         }
 
-        nlohmann::json msg_json = serialization::serialize(msg);
-
         // Delete original message - we've copied the data
-        delete msg;
+        msg->release();
+
+        // Queue to the endpoint's shard
+        post(endpoint, std::move(data), {}, flow);
+    }
+
+    /**
+     * Send msg to each of actor_names at endpoint in one wire send: a
+     * multipart message with a part per receiver, as a batch would carry
+     * them. The payload is serialized once; only each part's receiver
+     * differs. Used by Publisher for remote subscribers on one endpoint.
+     *
+     * @param msg Message to send (ownership transferred)
+     * @throws std::runtime_error if the message type is not registered
+     */
+    void send_to_each(const std::string& endpoint,
+                      const std::vector<std::string>& actor_names,
+                      const Message* msg,
+                      Actor* sender = nullptr) {
+        std::vector<std::string> parts;
+        bool flow = flowing(endpoint, "");
+        try {
+            encode_each(endpoint, actor_names, msg, sender ? sender->get_name() : "", parts, flow);
+        } catch (...) {
+            msg->release();
+            throw;
+        }
+        msg->release();
+
+        if (parts.empty())
+            return;
+        std::string first = std::move(parts.front());
+        parts.erase(parts.begin());
+        post(endpoint, std::move(first), std::move(parts), flow);
+    }
 
-        // Build request and queue it for async send
-        std::string sender_name = sender ? sender->get_name() : "";
-        std::string sender_ep = sender ? local_endpoint_ : "";
+    /**
+     * Encode msg for actor_name at endpoint into out, as send_to() puts it
+     * on the wire: a binary frame if the peer negotiated it and the type
+     * has a codec, otherwise a JSON envelope. force_binary uses a frame
+     * whenever the type has a codec (receiver addressed by name). Does not
+     * take ownership of msg.
+     *
+     * @throws std::runtime_error if the message type is not registered
+     */
+    void encode(const std::string& endpoint,
+                const std::string& actor_name,
+                const Message* msg,
+                Actor* sender,
+                std::string& out,
+                bool force_binary = false) const {
+        encode_as(endpoint, actor_name, msg, sender ? sender->get_name() : "", out, force_binary);
+    }
+
+    /**
+     * Send msg to actor_name at endpoint as a request; done gets the reply
+     * (see ActorRef::ask()). The envelope carries a correlation ID and names
+     * the pseudo-actor ask_name(id) as sender, so the reply is matched in our
+     * ZmqReceiver without a proxy actor, and any number of asks can be
+     * outstanding per endpoint. done runs on the receiver's thread, or on
+     * this sender's thread with nullptr once timeout passes (TimerWheel).
+     * Takes ownership of msg.
+     *
+     * @return The correlation ID
+     * @throws std::runtime_error if the message type is not registered
+     */
+    std::uint64_t ask(const std::string& endpoint,
+                      const std::string& actor_name,
+                      const Message* msg,
+                      AskCallback done,
+                      std::chrono::milliseconds timeout = DEFAULT_ASK_TIMEOUT) {
+        std::uint64_t id = next_ask_id_.fetch_add(1, std::memory_order_relaxed);
+        {
+            // Pending before sending: the reply may beat us back
+            std::lock_guard<std::mutex> lock(ask_mutex_);
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            asks_.emplace(id, PendingAsk{std::move(done), deadline});
+            ask_deadlines_.emplace(deadline, id);
+            arm_ask_timer(deadline);
+        }
 
-        auto* req = new RemoteSendRequest(
-            endpoint, actor_name,
-            sender_name, sender_ep,
-            type_name, msg_json.dump()
-        );
+        std::string data;
+        bool flow = flowing(endpoint, actor_name);
+        try {
+            encode_as(endpoint, actor_name, msg, ask_name(id), data, false, id, false, flow);
+        } catch (...) {
+            msg->release();
+            drop_ask(id);
+            throw;
+        }
+        msg->release();
+        post(endpoint, std::move(data), {}, flow);
+        return id;
+    }
 
-        // Queue to our own actor thread
-        this->Actor::send(req, nullptr);
+    /// ask() completing a future instead of calling back
+    AskFuture ask(const std::string& endpoint,
+                  const std::string& actor_name,
+                  const Message* msg,
+                  std::chrono::milliseconds timeout = DEFAULT_ASK_TIMEOUT) {
+        auto promise = std::make_shared<std::promise<std::unique_ptr<const Message>>>();
+        AskFuture future = promise->get_future();
+        ask(endpoint, actor_name, msg, [promise](std::unique_ptr<const Message> reply) {
+            promise->set_value(std::move(reply));
+        }, timeout);
+        return future;
     }
 
+    /**
+     * Complete ask id with reply. Called by ZmqReceiver. Returns false, and
+     * frees reply, if the ask already completed or timed out.
+     */
+    bool complete_ask(std::uint64_t id, std::unique_ptr<const Message> reply) {
+        AskCallback done;
+        {
+            std::lock_guard<std::mutex> lock(ask_mutex_);
+            auto it = asks_.find(id);
+            if (it == asks_.end())
+                return false;
+            done = std::move(it->second.done);
+            ask_deadlines_.erase({it->second.deadline, id});
+            asks_.erase(it);
+        }
+        if (done)
+            done(std::move(reply));
+        return true;
+    }
+
+    size_t pending_asks() const {
+        std::lock_guard<std::mutex> lock(ask_mutex_);
+        return asks_.size();
+    }
+
+    /**
+     * Send msg to endpoint as the reply to its ask id. Used by
+     * RemoteReplyProxy. Takes ownership of msg.
+     */
+    void send_reply(const std::string& endpoint, std::uint64_t id, const Message* msg) {
+        std::string data;
+        bool flow = flowing(endpoint, "");
+        try {
+            encode_as(endpoint, ask_name(id), msg, "", data, false, id, true, flow);
+        } catch (...) {
+            msg->release();
+            throw;
+        }
+        msg->release();
+        post(endpoint, std::move(data), {}, flow);
+    }
+
+    /**
+     * Pseudo-actor an ask is sent from. Replies are addressed to it, so
+     * peers that do not echo the correlation ID (Rust, Python) still reach
+     * the right ask through their ordinary reply path.
+     */
+    static std::string ask_name(std::uint64_t id) {
+        return std::string(ASK_PREFIX) + std::to_string(id);
+    }
+
+    /// Correlation ID named by an ask_name(), or 0
+    static std::uint64_t parse_ask_name(std::string_view name) noexcept {
+        if (name.size() <= ASK_PREFIX.size() || name.substr(0, ASK_PREFIX.size()) != ASK_PREFIX)
+            return 0;
+        std::uint64_t id = 0;
+        const char* end = name.data() + name.size();
+        auto [p, ec] = std::from_chars(name.data() + ASK_PREFIX.size(), end, id);
+        return ec == std::errc() && p == end ? id : 0;
+    }
+
+    static constexpr std::string_view ASK_PREFIX = "$ask:";
+
+    /// Pseudo-actor CreditGrants are addressed to
+    static constexpr std::string_view FLOW_RECEIVER = "$flow";
+
+private:
+    /**
+     * encode() with an explicit sender name ("" = none). A nonzero
+     * correlation_id marks an ask request, or with is_reply its answer.
+     * flow adds the tag the peer grants credits for.
+     */
+    void encode_as(const std::string& endpoint,
+                   const std::string& actor_name,
+                   const Message* msg,
+                   std::string_view sender_actor,
+                   std::string& out,
+                   bool force_binary,
+                   std::uint64_t correlation_id = 0,
+                   bool is_reply = false,
+                   bool flow = false) const {
+        int msg_id = msg->id();
+        const serialization::RegistryEntry* entry = serialization::MessageRegistry::instance().find(msg_id);
+        if (!entry || !entry->has_json())
+            throw std::runtime_error("Message type not registered: " + std::to_string(msg_id));
+
+        // Binary frame if the peer negotiated it and the type has a codec
+        std::uint32_t receiver_id = 0;
+        wire::SessionTag session{0, local_endpoint_};
+        if (entry->has_binary() && (force_binary || binary_peer(endpoint, actor_name, receiver_id, session.session))) {
+            wire::FlowTag tag{flow_session_, local_endpoint_, endpoint};
+            wire::begin_frame(out, msg_id, receiver_id, actor_name, sender_actor,
+                              sender_actor.empty() ? std::string_view() : std::string_view(local_endpoint_),
+                              correlation_id, is_reply, flow ? &tag : nullptr,
+                              session.session ? &session : nullptr);
+            size_t payload_start = out.size();
+            wire::BinaryWriter w(out);
+            entry->write(msg, w);
+            wire::finish_frame(out, payload_start);
+            return;
+        }
+
+        // Build envelope around the serialized message, dump it once
+        nlohmann::json envelope;
+        if (!sender_actor.empty()) {
+            envelope["sender_actor"] = sender_actor;
+            envelope["sender_endpoint"] = local_endpoint_;
+        } else {
+            envelope["sender_actor"] = nullptr;
+            envelope["sender_endpoint"] = nullptr;
+        }
+        envelope["receiver"] = actor_name;
+        envelope["message_type"] = entry->type_name;
+        envelope["message"] = entry->to_json(msg);
+        if (correlation_id != 0)
+            envelope[is_reply ? "in_reply_to" : "correlation_id"] = correlation_id;
+        if (flow)
+            tag_flow(envelope, endpoint);
+
+        advertise(envelope, endpoint);
+        out = envelope.dump();
+    }
+
+    /// encode_as() for several receivers at one endpoint, a part each
+    void encode_each(const std::string& endpoint,
+                     const std::vector<std::string>& actor_names,
+                     const Message* msg,
+                     std::string_view sender_actor,
+                     std::vector<std::string>& parts,
+                     bool flow = false) const {
+        int msg_id = msg->id();
+        const serialization::RegistryEntry* entry = serialization::MessageRegistry::instance().find(msg_id);
+        if (!entry || !entry->has_json())
+            throw std::runtime_error("Message type not registered: " + std::to_string(msg_id));
+        if (actor_names.empty())
+            return;
+
+        parts.resize(actor_names.size());
+        std::uint32_t receiver_id = 0;
+        wire::SessionTag session{0, local_endpoint_};
+        if (entry->has_binary() && binary_peer(endpoint, actor_names.front(), receiver_id, session.session)) {
+            std::string payload;
+            wire::BinaryWriter w(payload);
+            entry->write(msg, w);
+            wire::FlowTag tag{flow_session_, local_endpoint_, endpoint};
+            for (size_t i = 0; i < actor_names.size(); i++) {
+                if (i > 0)
+                    binary_peer(endpoint, actor_names[i], receiver_id, session.session);
+                std::string& out = parts[i];
+                wire::begin_frame(out, msg_id, receiver_id, actor_names[i], sender_actor,
+                                  sender_actor.empty() ? std::string_view() : std::string_view(local_endpoint_),
+                                  0, false, flow ? &tag : nullptr, session.session ? &session : nullptr);
+                size_t payload_start = out.size();
+                out += payload;
+                wire::finish_frame(out, payload_start);
+            }
+            return;
+        }
+
+        // One envelope; only the receiver changes between parts
+        nlohmann::json envelope;
+        if (!sender_actor.empty()) {
+            envelope["sender_actor"] = sender_actor;
+            envelope["sender_endpoint"] = local_endpoint_;
+        } else {
+            envelope["sender_actor"] = nullptr;
+            envelope["sender_endpoint"] = nullptr;
+        }
+        envelope["receiver"] = nullptr;
+        envelope["message_type"] = entry->type_name;
+        envelope["message"] = entry->to_json(msg);
+        advertise(envelope, endpoint);
+        if (flow)
+            tag_flow(envelope, endpoint);
+        for (size_t i = 0; i < actor_names.size(); i++) {
+            envelope["receiver"] = actor_names[i];
+            parts[i] = envelope.dump();
+        }
+    }
+
+public:
     /**
      * Create a remote actor reference
      */
@@ -139,77 +751,371 @@ public:
      * Close all sockets
      */
     void close() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        sockets_.clear();
+        for (auto& shard : shards_)
+            shard->close();
+    }
+
+    /**
+     * Batch messages sent to endpoint (see BatchPolicy). Can be changed
+     * at any time; pending messages are flushed first.
+     */
+    void set_batching(const std::string& endpoint, const BatchPolicy& policy) {
+        shard_for(endpoint).set_batching(endpoint, policy);
+    }
+
+    /// Send each message to endpoint on its own again
+    void clear_batching(const std::string& endpoint) {
+        shard_for(endpoint).clear_batching(endpoint);
+    }
+
+    /**
+     * Meter messages to endpoint by the credits its ZmqReceiver grants
+     * (see FlowPolicy). Messages carry a flow tag; until the first
+     * CreditGrant comes back they go out as before, so peers that never
+     * grant are unaffected. Out of credits, only this endpoint's messages
+     * wait: the shard thread never blocks on it. Keep the receiver's
+     * window at or below ZMQ_SNDHWM. Can be changed at any time.
+     */
+    void set_flow_control(const std::string& endpoint, const FlowPolicy& policy = {}) {
+        shard_for(endpoint).set_flow_control(endpoint, policy, flow_session_);
+        std::lock_guard<std::mutex> lock(wire_mutex_);
+        flow_endpoints_.insert(endpoint);
+        has_flow_.store(true, std::memory_order_relaxed);
+    }
+
+    /// Stop metering endpoint; messages held for credits are sent now
+    void clear_flow_control(const std::string& endpoint) {
+        {
+            std::lock_guard<std::mutex> lock(wire_mutex_);
+            flow_endpoints_.erase(endpoint);
+        }
+        shard_for(endpoint).clear_flow_control(endpoint);
+    }
+
+    /**
+     * Apply a CreditGrant from endpoint's receiver. Called by ZmqReceiver;
+     * held messages it makes room for are sent on the calling thread.
+     */
+    void grant(const std::string& endpoint, std::uint64_t session,
+               std::uint64_t consumed, std::uint64_t limit) {
+        shard_for(endpoint).grant(endpoint, session, consumed, limit);
+    }
+
+    /// Flow control counters for endpoint, including its in-flight count
+    FlowStats flow_stats(const std::string& endpoint) const {
+        return shard_for(endpoint).flow_stats(endpoint);
+    }
+
+    /// flow_stats() of every endpoint that has had flow control
+    std::unordered_map<std::string, FlowStats> flow_stats() const {
+        std::unordered_map<std::string, FlowStats> stats;
+        for (const auto& shard : shards_)
+            shard->collect_flow_stats(stats);
+        return stats;
+    }
+
+    /// Tags this sender's messages carry; a new ZmqSender starts a new one
+    std::uint64_t flow_session() const { return flow_session_; }
+
+    size_t shard_count() const { return shards_.size(); }
+
+    /// Shard that carries all messages to endpoint
+    size_t shard_of(const std::string& endpoint) const {
+        return shards_.size() == 1 ? 0 : std::hash<std::string>{}(endpoint) % shards_.size();
     }
 
     const std::string& local_endpoint() const { return local_endpoint_; }
 
+    /**
+     * Send binary frames to endpoint from now on. Called by ZmqReceiver
+     * when the peer answers with a WireHello; ids are the peer's interned
+     * receiver IDs (receivers missing from it are addressed by name), and
+     * session the hello's, echoed in every frame (0 = none, older peer).
+     */
+    void enable_binary(const std::string& endpoint,
+                       const std::vector<std::string>& actors,
+                       const std::vector<std::uint32_t>& ids,
+                       std::uint64_t session = 0) {
+        std::lock_guard<std::mutex> lock(wire_mutex_);
+        auto& peer = binary_peers_[endpoint];
+        peer.session = session;
+        peer.ids.clear();
+        for (size_t i = 0; i < actors.size() && i < ids.size(); i++)
+            peer.ids[actors[i]] = ids[i];
+    }
+
+    /// Go back to JSON envelopes for endpoint
+    void disable_binary(const std::string& endpoint) {
+        std::lock_guard<std::mutex> lock(wire_mutex_);
+        binary_peers_.erase(endpoint);
+    }
+
+    /**
+     * Go back to JSON for every endpoint negotiated in session. Called by
+     * ZmqReceiver on a WireReset: the peer no longer knows those IDs, and
+     * the next JSON envelope asks it for new ones.
+     */
+    void reset_binary(std::uint64_t session) {
+        if (session == 0)
+            return;
+        std::lock_guard<std::mutex> lock(wire_mutex_);
+        std::erase_if(binary_peers_, [&](const auto& p) {
+            if (p.second.session != session)
+                return false;
+            adverts_.erase(p.first);  // Offer the format afresh
+            return true;
+        });
+    }
+
+    bool is_binary(const std::string& endpoint) const {
+        std::lock_guard<std::mutex> lock(wire_mutex_);
+        return binary_peers_.count(endpoint) != 0;
+    }
+
+    /**
+     * Stop advertising the binary format, so peers keep using JSON.
+     * Otherwise the first ACTOR_WIRE_ADVERTS JSON envelopes to each
+     * endpoint offer it, and again after a WireReset. Call before init().
+     */
+    void set_advertise_binary(bool advertise) { advertise_binary_ = advertise; }
+
 private:
     void on_start(const msg::Start*) noexcept {
-        // Ready to send
+        // Static registration is done by now; make lookups lock-free
+        serialization::seal();
+
+        if (shard_threads_.empty())
+            for (size_t i = 1; i < shards_.size(); i++)
+                shard_threads_.emplace_back([shard = shards_[i].get()] { (*shard)(); });
     }
 
+    // Shard 0's I/O runs here; the others get theirs in their own mailbox
     void on_send_request(const RemoteSendRequest* req) noexcept {
-        // Build envelope
-        nlohmann::json envelope;
-        if (!req->sender_name.empty()) {
-            envelope["sender_actor"] = req->sender_name;
-            envelope["sender_endpoint"] = req->sender_endpoint;
-        } else {
-            envelope["sender_actor"] = nullptr;
-            envelope["sender_endpoint"] = nullptr;
+        shards_[0]->write(req, mailbox_drained());
+    }
+
+    void end() override {
+        fail_asks();
+        stop_shards();
+        shards_[0]->flush_all();
+    }
+
+    void on_timeout(const msg::Timeout* t) noexcept {
+        if (t->data == ASK_TIMER) {
+            expire_asks();
+            return;
         }
-        envelope["receiver"] = req->actor_name;
-        envelope["message_type"] = req->message_type;
-        envelope["message"] = nlohmann::json::parse(req->message_json);
+        shards_[0]->on_flush_timer();
+    }
 
-        // Serialize and send
-        std::string data = envelope.dump();
-        send_raw(req->endpoint, data);
+    ZmqSenderShard& shard_for(const std::string& endpoint) const {
+        return *shards_[shard_of(endpoint)];
     }
 
-    void send_raw(const std::string& endpoint, const std::string& data) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    // Queue encoded bytes to the endpoint's shard
+    void post(const std::string& endpoint, std::string data, std::vector<std::string> more = {},
+              bool flow = false) {
+        auto* req = new RemoteSendRequest(endpoint, std::move(data), std::move(more));
+        req->flow = flow;
+        ZmqSenderShard& shard = shard_for(endpoint);
+        if (shard.index() == 0)
+            this->Actor::send(req, nullptr);
+        else
+            shard.send(req, nullptr);
+    }
 
-        // Get or create socket
-        auto it = sockets_.find(endpoint);
-        if (it == sockets_.end()) {
-            zmq::socket_t socket(context_, zmq::socket_type::push);
+    // Shut down shards 1..N-1 once their queued sends are written
+    void stop_shards() noexcept {
+        for (size_t i = 1; i < shards_.size() && !shard_threads_.empty(); i++)
+            shards_[i]->send(new msg::Shutdown(), nullptr);
+        for (auto& t : shard_threads_)
+            if (t.joinable())
+                t.join();
+        shard_threads_.clear();
+    }
 
-            // Convert endpoint for connection
-            std::string connect_endpoint = endpoint;
-            // Replace *: with localhost: for connection
-            size_t pos = connect_endpoint.find("*:");
-            if (pos != std::string::npos) {
-                connect_endpoint.replace(pos, 2, "localhost:");
-            }
-            // Replace 0.0.0.0: with localhost: for connection
-            pos = connect_endpoint.find("0.0.0.0:");
-            if (pos != std::string::npos) {
-                connect_endpoint.replace(pos, 8, "localhost:");
+    // Outstanding ask(): its completion and when it times out
+    struct PendingAsk {
+        AskCallback done;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    static constexpr int ASK_TIMER = 1;  // Timeout data; the batching timer uses 0
+
+    // One timer for the earliest deadline. Caller holds ask_mutex_.
+    void arm_ask_timer(std::chrono::steady_clock::time_point deadline) {
+        if (ask_timer_ && deadline >= ask_timer_at_)
+            return;
+        if (ask_timer_)
+            TimerWheel::instance().cancel(ask_timer_);
+        auto ms = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        ask_timer_ = TimerWheel::instance().schedule(this, std::max(ms, std::chrono::milliseconds(1)), ASK_TIMER);
+        ask_timer_at_ = deadline;
+    }
+
+    // Complete every ask whose deadline has passed with nullptr
+    void expire_asks() {
+        std::vector<AskCallback> expired;
+        {
+            std::lock_guard<std::mutex> lock(ask_mutex_);
+            ask_timer_ = {};
+            auto now = std::chrono::steady_clock::now();
+            while (!ask_deadlines_.empty() && ask_deadlines_.begin()->first <= now) {
+                auto it = asks_.find(ask_deadlines_.begin()->second);
+                ask_deadlines_.erase(ask_deadlines_.begin());
+                if (it != asks_.end()) {
+                    expired.push_back(std::move(it->second.done));
+                    asks_.erase(it);
+                }
             }
+            if (!ask_deadlines_.empty())
+                arm_ask_timer(ask_deadlines_.begin()->first);
+        }
+        for (auto& done : expired)
+            if (done)
+                done(nullptr);
+    }
 
-            socket.connect(connect_endpoint);
-            auto result = sockets_.emplace(endpoint, std::move(socket));
-            it = result.first;
+    // Complete every outstanding ask with nullptr (shutting down)
+    void fail_asks() {
+        std::unordered_map<std::uint64_t, PendingAsk> asks;
+        {
+            std::lock_guard<std::mutex> lock(ask_mutex_);
+            asks.swap(asks_);
+            ask_deadlines_.clear();
+            if (ask_timer_)
+                TimerWheel::instance().cancel(ask_timer_);
+            ask_timer_ = {};
+        }
+        for (auto& [id, a] : asks)
+            if (a.done)
+                a.done(nullptr);
+    }
+
+    // Forget an ask that was never sent
+    void drop_ask(std::uint64_t id) {
+        std::lock_guard<std::mutex> lock(ask_mutex_);
+        auto it = asks_.find(id);
+        if (it == asks_.end())
+            return;
+        ask_deadlines_.erase({it->second.deadline, id});
+        asks_.erase(it);
+    }
+
+    // Tag messages for actor_name at endpoint for flow control? Control
+    // messages ("$wire", "$flow") never are, so they can't be held up.
+    bool flowing(const std::string& endpoint, std::string_view actor_name) const {
+        if (!has_flow_.load(std::memory_order_relaxed) || actor_name == "$wire" || actor_name == FLOW_RECEIVER)
+            return false;
+        std::lock_guard<std::mutex> lock(wire_mutex_);
+        return flow_endpoints_.count(endpoint) != 0;
+    }
+
+    void tag_flow(nlohmann::json& envelope, const std::string& endpoint) const {
+        envelope["flow_session"] = flow_session_;
+        envelope["flow_reply_to"] = local_endpoint_;
+        envelope["flow_endpoint"] = endpoint;
+    }
+
+    static std::uint64_t new_flow_session() { return wire::new_session(); }
+
+    /*
+     * Offer the binary format in the first ACTOR_WIRE_ADVERTS envelopes to
+     * endpoint; Rust/Python receivers ignore the keys, and never answer.
+     * wire_session lets a receiver tell a restarted sender from this one.
+     */
+    void advertise(nlohmann::json& envelope, const std::string& endpoint) const {
+        if (!advertise_binary_)
+            return;
+        {
+            std::lock_guard<std::mutex> lock(wire_mutex_);
+            unsigned& sent = adverts_[endpoint];
+            if (sent >= ACTOR_WIRE_ADVERTS)
+                return;
+            sent++;
         }
+        envelope["wire_formats"] = nlohmann::json::array({wire::FORMAT_NAME});
+        envelope["wire_endpoint"] = endpoint;
+        envelope["wire_reply_to"] = local_endpoint_;
+        envelope["wire_session"] = flow_session_;
+    }
 
-        // Send message
-        zmq::message_t message(data.data(), data.size());
-        it->second.send(message, zmq::send_flags::none);
+    bool binary_peer(const std::string& endpoint, const std::string& actor_name,
+                     std::uint32_t& receiver_id, std::uint64_t& session) const {
+        std::lock_guard<std::mutex> lock(wire_mutex_);
+        auto peer = binary_peers_.find(endpoint);
+        if (peer == binary_peers_.end())
+            return false;
+        auto it = peer->second.ids.find(actor_name);
+        receiver_id = it == peer->second.ids.end() ? 0 : it->second;
+        session = peer->second.session;
+        return true;
     }
 
 private:
-    zmq::context_t context_;
-    std::unordered_map<std::string, zmq::socket_t> sockets_;
-    std::mutex mutex_;
+    zmq::context_t context_;  // Before shards_: their sockets close first
+    std::vector<std::unique_ptr<ZmqSenderShard>> shards_;
+    std::vector<std::thread> shard_threads_;  // Shards 1..N-1
     std::string local_endpoint_;
+
+    // A peer accepting binary frames, as its WireHello described it
+    struct BinaryPeer {
+        std::uint64_t session = 0;                              // Echoed in every frame
+        std::unordered_map<std::string, std::uint32_t> ids;     // Receiver name -> interned id
+    };
+    std::unordered_map<std::string, BinaryPeer> binary_peers_;  // By endpoint
+    mutable std::unordered_map<std::string, unsigned> adverts_;  // Envelopes that offered binary, by endpoint
+    std::unordered_set<std::string> flow_endpoints_;  // set_flow_control() in effect
+    std::atomic<bool> has_flow_{false};               // Ever set: skip the lock until then
+    std::uint64_t flow_session_;
+    mutable std::mutex wire_mutex_;
+    bool advertise_binary_ = true;
+
+    std::atomic<std::uint64_t> next_ask_id_{1};  // 0 means "not an ask"
+    std::unordered_map<std::uint64_t, PendingAsk> asks_;
+    std::set<std::pair<std::chrono::steady_clock::time_point, std::uint64_t>> ask_deadlines_;
+    TimerHandle ask_timer_;
+    std::chrono::steady_clock::time_point ask_timer_at_;
+    mutable std::mutex ask_mutex_;
 };
 
-// Implementation of RemoteActorRef::send (declared in ActorRef.hpp)
-inline void RemoteActorRef::send(const Message* m, Actor* sender) {
-    sender_->send_to(endpoint_, name_, m, sender);
+// RemoteActorRef's members are implemented in RemoteActorRef.cpp
+
+// Implementation of ActorRef::ask (declared in ActorRef.hpp)
+inline AskFuture ActorRef::ask(const Message* m, std::chrono::milliseconds timeout) {
+    if (auto* local = std::get_if<LocalActorRef>(&ref_)) {
+        if (!local->actor()->accepts_fast_send()) {
+            m->release();
+            throw std::runtime_error("ask to a running ASYNC_ONLY actor");
+        }
+        std::promise<std::unique_ptr<const Message>> promise;
+        promise.set_value(local->fast_send(m, nullptr));
+        m->release();
+        return promise.get_future();
+    }
+    if (is_rust()) {
+        m->release();
+        throw std::runtime_error("ask not supported for Rust actors");
+    }
+    return remote_ref().ask(m, timeout);  // shared-memory refs ask over TCP
+}
+
+inline void ActorRef::ask(const Message* m, AskCallback done, std::chrono::milliseconds timeout) {
+    if (auto* local = std::get_if<LocalActorRef>(&ref_)) {
+        if (!local->actor()->accepts_fast_send()) {
+            m->release();
+            throw std::runtime_error("ask to a running ASYNC_ONLY actor");
+        }
+        auto reply = local->fast_send(m, nullptr);
+        m->release();
+        done(std::move(reply));
+        return;
+    }
+    if (is_rust()) {
+        m->release();
+        throw std::runtime_error("ask not supported for Rust actors");
+    }
+    remote_ref().ask(m, std::move(done), timeout);
 }
 
 // Implementation of ZmqSender::remote_ref
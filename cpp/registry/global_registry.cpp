@@ -0,0 +1,162 @@
+/*
+
+THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
+
+Copyright 2025 Vincent Maciejewski, & M2 Tech
+
+global_registry - Native GlobalRegistry server
+
+Speaks the same JSON REQ/REP protocol as the Python registry
+(python -m actors.registry), so Python and Rust clients work unchanged.
+Pushed liveness events go out through a ZmqSender as ordinary actor
+messages.
+
+Usage:
+  global_registry [--endpoint tcp://0.0.0.0:5555] [--config registry.json]
+                  [--snapshot /var/lib/actors/registry.snap]
+
+REGISTRY_ENDPOINT and REGISTRY_CONFIG are used when the options are not
+given. Config keys: registry_endpoint, heartbeat_timeout_s,
+heartbeat_check_interval_s, heartbeat_miss_threshold, snapshot_path,
+snapshot_interval_s.
+
+*/
+
+#include "actors/act/Manager.hpp"
+#include "actors/registry/GlobalRegistry.hpp"
+#include "actors/registry/RegistryServer.hpp"
+#include "actors/remote/ZmqSender.hpp"
+#include <nlohmann/json.hpp>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace actors;
+using namespace actors::registry;
+using namespace std;
+
+namespace {
+
+struct Options {
+    string endpoint = "tcp://0.0.0.0:5555";
+    string config;
+    string snapshot;
+    double heartbeat_timeout_s = ACTOR_REGISTRY_HEARTBEAT_TIMEOUT_MS / 1000.0;
+    double check_interval_s = ACTOR_REGISTRY_SWEEP_MS / 1000.0;
+    unsigned miss_threshold = ACTOR_REGISTRY_MISS_THRESHOLD;
+    double snapshot_interval_s = 5.0;
+};
+
+void load_config(Options& opt, bool endpoint_given) {
+    ifstream in(opt.config);
+    if (!in) {
+        cerr << "Config file not found: " << opt.config << endl;
+        return;
+    }
+    auto config = nlohmann::json::parse(in);
+    if (!endpoint_given) {
+        opt.endpoint = config.value("registry_endpoint", opt.endpoint);
+    }
+    opt.heartbeat_timeout_s = config.value("heartbeat_timeout_s", opt.heartbeat_timeout_s);
+    opt.check_interval_s = config.value("heartbeat_check_interval_s", opt.check_interval_s);
+    opt.miss_threshold = config.value("heartbeat_miss_threshold", opt.miss_threshold);
+    if (opt.snapshot.empty()) {
+        opt.snapshot = config.value("snapshot_path", opt.snapshot);
+    }
+    opt.snapshot_interval_s = config.value("snapshot_interval_s", opt.snapshot_interval_s);
+}
+
+chrono::milliseconds ms(double seconds) {
+    return chrono::milliseconds(static_cast<long long>(seconds * 1000));
+}
+
+Manager* g_manager = nullptr;
+
+void signal_handler(int) {
+    if (g_manager) {
+        g_manager->terminate();
+    }
+}
+
+/**
+ * RegistryManager - GlobalRegistry, its JSON front end, and the sender
+ * for pushed events
+ */
+class RegistryManager : public Manager {
+    shared_ptr<ZmqSender> zmq_sender_;
+
+public:
+    explicit RegistryManager(const Options& opt) {
+        zmq_sender_ = make_shared<ZmqSender>(opt.endpoint);
+        manage(zmq_sender_.get());
+
+        auto* registry = new GlobalRegistry();
+        registry->set_heartbeat_timeout(ms(opt.heartbeat_timeout_s));
+        registry->set_sweep_interval(ms(opt.check_interval_s));
+        registry->set_miss_threshold(opt.miss_threshold);
+        if (!opt.snapshot.empty()) {
+            if (registry->load_snapshot(opt.snapshot)) {
+                auto s = registry->stats();
+                cout << "Restored " << s.actors << " actors from " << s.managers
+                     << " managers (" << opt.snapshot << ")" << endl;
+            }
+            registry->set_snapshot(opt.snapshot, ms(opt.snapshot_interval_s));
+        }
+        auto sender = zmq_sender_;
+        registry->set_push([sender](const string& subscriber, const string& endpoint, const Message* event) {
+            sender->send_to(endpoint, subscriber, event, nullptr);
+        });
+        manage(registry);
+
+        manage(new RegistryServer(opt.endpoint, registry));
+    }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options opt;
+    bool endpoint_given = false;
+    if (const char* env = getenv("REGISTRY_ENDPOINT")) {
+        opt.endpoint = env;
+        endpoint_given = true;
+    }
+    if (const char* env = getenv("REGISTRY_CONFIG")) {
+        opt.config = env;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 < argc && arg == "--endpoint") {
+            opt.endpoint = argv[++i];
+            endpoint_given = true;
+        } else if (i + 1 < argc && arg == "--config") {
+            opt.config = argv[++i];
+        } else if (i + 1 < argc && arg == "--snapshot") {
+            opt.snapshot = argv[++i];
+        } else {
+            cerr << "Usage: " << argv[0]
+                 << " [--endpoint E] [--config registry.json] [--snapshot PATH]" << endl;
+            return 1;
+        }
+    }
+    if (!opt.config.empty()) {
+        load_config(opt, endpoint_given);
+    }
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    RegistryManager mgr(opt);
+    g_manager = &mgr;
+
+    mgr.init();
+    cout << "GlobalRegistry ready on " << opt.endpoint << endl;
+
+    mgr.end();
+    cout << "GlobalRegistry stopped" << endl;
+    return 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * Tests for ActorId assignment and the IdTable behind it
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "actors/Actor.hpp"
+#include "actors/ActorId.hpp"
+#include "actors/ActorRef.hpp"
+#include "actors/act/Manager.hpp"
+
+using namespace actors;
+
+namespace {
+
+class Named : public Actor {
+public:
+    explicit Named(const char* actor_name) { strncpy(name, actor_name, sizeof(name) - 1); }
+};
+
+class IdManager : public Manager {
+public:
+    IdManager() { strncpy(name, "IdManager", sizeof(name) - 1); }
+};
+
+} // namespace
+
+TEST(IdTableTest, GetSetAndBounds) {
+    auto table = std::make_unique<IdTable<int>>();
+    int a = 1, b = 2;
+
+    EXPECT_EQ(table->get(0), nullptr);
+    EXPECT_EQ(table->get(5000), nullptr);  // Chunk not allocated yet
+
+    EXPECT_TRUE(table->set(1, &a));
+    EXPECT_TRUE(table->set(1024, &b));  // First ID of the second chunk
+    EXPECT_EQ(table->get(1), &a);
+    EXPECT_EQ(table->get(1024), &b);
+    EXPECT_EQ(table->get(1023), nullptr);
+
+    EXPECT_TRUE(table->set(IdTable<int>::MAX_ID, &a));
+    EXPECT_EQ(table->get(IdTable<int>::MAX_ID), &a);
+    EXPECT_FALSE(table->set(IdTable<int>::MAX_ID + 1, &a));
+    EXPECT_EQ(table->get(IdTable<int>::MAX_ID + 1), nullptr);
+
+    EXPECT_TRUE(table->set(1, nullptr));
+    EXPECT_EQ(table->get(1), nullptr);
+}
+
+TEST(ActorIdTest, ManageAssignsDenseIds) {
+    IdManager mgr;
+    Named a("a"), b("b"), unmanaged("c");
+    mgr.manage(&a);
+    mgr.manage(&b);
+
+    EXPECT_EQ(a.get_id(), 1u);
+    EXPECT_EQ(b.get_id(), 2u);
+    EXPECT_EQ(unmanaged.get_id(), NO_ACTOR_ID);
+
+    EXPECT_EQ(mgr.get_actor_id("b"), b.get_id());
+    EXPECT_EQ(mgr.get_actor_id("c"), NO_ACTOR_ID);
+    EXPECT_EQ(mgr.get_local_actor(a.get_id()), &a);
+    EXPECT_EQ(mgr.get_local_actor(ActorId(3)), nullptr);
+    EXPECT_EQ(mgr.get_local_actor(NO_ACTOR_ID), nullptr);
+
+    EXPECT_EQ(ActorRef(&b).id(), b.get_id());
+    EXPECT_EQ(ActorRef().id(), NO_ACTOR_ID);
+}
@@ -0,0 +1,165 @@
+/*
+ * Tests for bounded mailboxes, overflow policies and watermarks
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/MailboxFull.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+using namespace actors;
+
+namespace {
+
+struct Work : public Message_N<4201> {
+    int n;
+    explicit Work(int v) : n(v) {}
+};
+
+struct Tracked : public Message_N<4202> {
+    static inline std::atomic<int> alive{0};
+    Tracked() { alive++; }
+    ~Tracked() override { alive--; }
+};
+
+class Sink : public Actor {
+public:
+    std::vector<int> seen;
+    std::atomic<bool> gate{true};
+    std::atomic<int> received{0};
+
+    explicit Sink(const char* actor_name = "Sink") {
+        strncpy(name, actor_name, sizeof(name) - 1);
+        MESSAGE_HANDLER(Work, on_work);
+    }
+
+    void on_work(const Work* m) noexcept {
+        while (!gate.load())
+            std::this_thread::yield();
+        seen.push_back(m->n);
+        received++;
+    }
+};
+
+class WatermarkManager : public Manager {
+public:
+    std::atomic<int> highs{0};
+    std::atomic<int> lows{0};
+
+    WatermarkManager() { strncpy(name, "WatermarkManager", sizeof(name) - 1); }
+
+    void on_mailbox_watermark(Actor*, std::size_t, bool high) noexcept override {
+        (high ? highs : lows)++;
+    }
+};
+
+}  // namespace
+
+TEST(BackpressureTest, UnboundedByDefault) {
+    Sink sink;
+    for (int i = 0; i < 500; i++)
+        sink.send(new Work(i));
+    EXPECT_EQ(sink.queue_length(), 500u);
+    EXPECT_EQ(sink.dropped_count(), 0u);
+    EXPECT_EQ(sink.mailbox_limit(), 0u);
+}
+
+TEST(BackpressureTest, DropNewest) {
+    Sink sink;
+    sink.set_mailbox_limit(3, OverflowPolicy::DROP_NEWEST);
+    int before = Tracked::alive.load();
+    for (int i = 0; i < 5; i++)
+        sink.send(new Tracked());
+    EXPECT_EQ(sink.queue_length(), 3u);
+    EXPECT_EQ(sink.dropped_count(), 2u);
+    EXPECT_EQ(Tracked::alive.load() - before, 3);  // dropped ones were deleted
+}
+
+TEST(BackpressureTest, DropOldest) {
+    Sink sink;
+    sink.set_mailbox_limit(3, OverflowPolicy::DROP_OLDEST);
+    for (int i = 0; i < 5; i++)
+        sink.send(new Work(i));
+    EXPECT_EQ(sink.queue_length(), 3u);
+    EXPECT_EQ(sink.dropped_count(), 2u);
+    EXPECT_EQ(static_cast<const Work*>(sink.peek())->n, 2);
+}
+
+TEST(BackpressureTest, RejectReturnsToSender) {
+    Sink sink("Full");
+    Sink sender("Sender");
+    sink.set_mailbox_limit(1, OverflowPolicy::REJECT);
+
+    sink.send(new Work(1), &sender);
+    sink.send(new Work(2), &sender);
+    EXPECT_EQ(sink.queue_length(), 1u);
+    EXPECT_EQ(sink.dropped_count(), 1u);
+
+    ASSERT_EQ(sender.queue_length(), 1u);
+    auto* r = dynamic_cast<const msg::MailboxFull*>(sender.peek());
+    ASSERT_NE(r, nullptr);
+    EXPECT_EQ(r->rejected_by, &sink);
+    EXPECT_EQ(static_cast<const Work*>(r->rejected.get())->n, 2);
+}
+
+TEST(BackpressureTest, RejectWithoutSenderDrops) {
+    Sink sink;
+    sink.set_mailbox_limit(1, OverflowPolicy::REJECT);
+    sink.send(new Work(1));
+    sink.send(new Work(2));
+    EXPECT_EQ(sink.queue_length(), 1u);
+    EXPECT_EQ(sink.dropped_count(), 1u);
+}
+
+TEST(BackpressureTest, BlockHoldsProducerAndKeepsEverything) {
+    WatermarkManager mgr;
+    auto* sink = new Sink();
+    sink->set_mailbox_limit(4, OverflowPolicy::BLOCK);
+    mgr.manage(sink);
+    mgr.init();
+
+    constexpr int COUNT = 2000;
+    for (int i = 0; i < COUNT; i++) {
+        sink->send(new Work(i));
+        EXPECT_LE(sink->queue_length(), 4u);
+    }
+    sink->send(new msg::Shutdown());
+    mgr.end();
+
+    ASSERT_EQ(sink->seen.size(), size_t(COUNT));
+    for (int i = 0; i < COUNT; i++)
+        EXPECT_EQ(sink->seen[i], i);
+    EXPECT_EQ(sink->dropped_count(), 0u);
+    delete sink;
+}
+
+TEST(BackpressureTest, WatermarksNotifyManager) {
+    WatermarkManager mgr;
+    auto* sink = new Sink();
+    sink->set_mailbox_limit(0, OverflowPolicy::BLOCK, 8, 2);
+    sink->gate = false;  // hold the actor in its first handler
+    mgr.manage(sink);
+    mgr.init();
+
+    for (int i = 0; i < 20; i++)
+        sink->send(new Work(i));
+    EXPECT_EQ(mgr.highs.load(), 1);  // reported once, not per message
+    EXPECT_TRUE(sink->above_watermark());
+    EXPECT_EQ(mgr.get_backpressured().size(), 1u);
+
+    sink->gate = true;
+    for (int i = 0; i < 10000 && mgr.lows.load() == 0; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    EXPECT_EQ(mgr.lows.load(), 1);
+    EXPECT_FALSE(sink->above_watermark());
+
+    sink->send(new msg::Shutdown());
+    mgr.end();
+    EXPECT_EQ(sink->received.load(), 20);
+    delete sink;
+}
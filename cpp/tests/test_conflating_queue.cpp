@@ -0,0 +1,230 @@
+/*
+ * Tests for the conflating mailbox (ConflatingQueue, Actor::conflate)
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "actors/ConflatingQueue.hpp"
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+using namespace actors;
+
+namespace {
+
+// (key, value); key < 0 means no key
+using Item = std::pair<int, int>;
+
+ConflatingQueue<Item, int> make_queue(std::vector<Item>* replaced = nullptr) {
+    return ConflatingQueue<Item, int>(
+        16,
+        [](const Item& x, int& key) { key = x.first; return x.first >= 0; },
+        [replaced](const Item& old) { if (replaced) replaced->push_back(old); });
+}
+
+struct Quote : public Message_N<4701> {
+    std::string symbol;
+    int px;
+    Quote(std::string s, int p) : symbol(std::move(s)), px(p) {}
+    const std::string& conflation_key() const { return symbol; }
+};
+
+struct Level : public Message_N<4702> {
+    int venue;
+    int px;
+    Level(int v, int p) : venue(v), px(p) {}
+    int conflation_key() const { return venue; }
+};
+
+struct Trade : public Message_N<4703> {
+    std::string symbol;
+    explicit Trade(std::string s) : symbol(std::move(s)) {}
+    const std::string& conflation_key() const { return symbol; }  // not conflated
+};
+
+struct Tracked : public Message_N<4704> {
+    static inline std::atomic<int> alive{0};
+    Tracked() { alive++; }
+    ~Tracked() override { alive--; }
+    int conflation_key() const { return 0; }
+};
+
+class Book : public Actor {
+public:
+    std::vector<std::string> seen;
+    std::atomic<bool> gate{true};
+    std::atomic<int> received{0};
+
+    Book() {
+        strncpy(name, "Book", sizeof(name) - 1);
+        MESSAGE_HANDLER(Quote, on_quote);
+        MESSAGE_HANDLER(Level, on_level);
+        MESSAGE_HANDLER(Trade, on_trade);
+        conflate<Quote>();
+        conflate<Level>();
+        conflate<Tracked>();
+    }
+
+    void on_quote(const Quote* m) noexcept {
+        while (!gate.load())
+            std::this_thread::yield();
+        seen.push_back(m->symbol + "=" + std::to_string(m->px));
+        received++;
+    }
+    void on_level(const Level* m) noexcept {
+        seen.push_back("L" + std::to_string(m->venue) + "=" + std::to_string(m->px));
+        received++;
+    }
+    void on_trade(const Trade* m) noexcept {
+        seen.push_back("T" + m->symbol);
+        received++;
+    }
+};
+
+class BookManager : public Manager {
+public:
+    BookManager() { strncpy(name, "BookManager", sizeof(name) - 1); }
+};
+
+}  // namespace
+
+TEST(ConflatingQueueTest, ReplacesInPlaceKeepingFirstArrivalOrder) {
+    std::vector<Item> replaced;
+    auto q = make_queue(&replaced);
+    q.push({1, 10});
+    q.push({2, 20});
+    q.push({-1, 99});
+    q.push({1, 11});
+    q.push({-1, 98});
+    q.push({1, 12});
+    EXPECT_EQ(q.length(), 4u);
+    EXPECT_EQ(q.conflated(), 2u);
+    ASSERT_EQ(replaced.size(), 2u);
+    EXPECT_EQ(replaced[0], Item(1, 10));
+    EXPECT_EQ(replaced[1], Item(1, 11));
+
+    Item out[8];
+    bool last = false;
+    ASSERT_EQ(q.try_pop_batch(out, 8, last), 4u);
+    EXPECT_TRUE(last);
+    EXPECT_EQ(out[0], Item(1, 12));
+    EXPECT_EQ(out[1], Item(2, 20));
+    EXPECT_EQ(out[2], Item(-1, 99));
+    EXPECT_EQ(out[3], Item(-1, 98));
+}
+
+TEST(ConflatingQueueTest, PoppedKeyQueuesAgain) {
+    auto q = make_queue();
+    q.push({1, 10});
+    q.push({2, 20});
+    EXPECT_EQ(std::get<0>(q.pop()), Item(1, 10));
+
+    q.push({1, 11});  // 1 is no longer queued: goes to the back
+    q.push({2, 21});  // 2 still is: replaced in place
+    EXPECT_EQ(q.length(), 2u);
+    EXPECT_EQ(std::get<0>(q.pop()), Item(2, 21));
+    auto [last_item, last] = q.pop();
+    EXPECT_EQ(last_item, Item(1, 11));
+    EXPECT_TRUE(last);
+    EXPECT_TRUE(q.is_empty());
+    EXPECT_EQ(q.conflated(), 1u);
+}
+
+TEST(ConflatingQueueTest, ReplacementIgnoresLimit) {
+    auto q = make_queue();
+    EXPECT_TRUE(q.try_push({1, 10}, 2));
+    EXPECT_TRUE(q.try_push({2, 20}, 2));
+    EXPECT_FALSE(q.try_push({3, 30}, 2));
+    EXPECT_TRUE(q.try_push({1, 11}, 2));
+    q.push_wait({2, 21}, 2);  // would block if it needed a new slot
+
+    Item evicted{};
+    bool queued = false;
+    EXPECT_FALSE(q.push_evict({1, 12}, 2, evicted, queued));
+    EXPECT_TRUE(queued);
+    EXPECT_TRUE(q.push_evict({4, 40}, 2, evicted, queued));
+    EXPECT_TRUE(queued);
+    EXPECT_EQ(evicted, Item(1, 12));
+    EXPECT_EQ(q.length(), 2u);
+    EXPECT_EQ(q.peek(), Item(2, 21));
+}
+
+TEST(ConflatingMailboxTest, ConflatesRegisteredTypesPerKey) {
+    BookManager mgr;
+    auto* book = new Book();
+    mgr.manage(book, {}, 0, SCHED_OTHER, MailboxType::CONFLATING);
+    EXPECT_EQ(book->mailbox_type(), MailboxType::CONFLATING);
+
+    book->send(new Quote("AAPL", 1));
+    book->send(new Quote("MSFT", 1));
+    book->send(new Trade("AAPL"));
+    book->send(new Trade("AAPL"));
+    book->send(new Level(7, 1));
+    book->send(new Quote("AAPL", 2));
+    book->send(new Level(7, 2));
+    book->send(new Quote("AAPL", 3));
+    EXPECT_EQ(book->queue_length(), 5u);
+    EXPECT_EQ(book->conflated_count(), 3u);
+    EXPECT_EQ(static_cast<const Quote*>(book->peek())->px, 3);
+
+    auto counts = mgr.get_conflation_counts();
+    ASSERT_EQ(counts.size(), 1u);
+    EXPECT_EQ(counts["Book"], 3u);
+
+    mgr.init();
+    book->send(new msg::Shutdown());
+    mgr.end();
+
+    std::vector<std::string> expected = {"AAPL=3", "MSFT=1", "TAAPL", "TAAPL", "L7=2"};
+    EXPECT_EQ(book->seen, expected);
+    delete book;
+}
+
+TEST(ConflatingMailboxTest, ReleasesReplacedMessages) {
+    BookManager mgr;
+    auto* book = new Book();
+    int before = Tracked::alive.load();
+    book->send(new Tracked());  // sent before managed: carried into the new mailbox
+    mgr.manage(book, {}, 0, SCHED_OTHER, MailboxType::CONFLATING);
+    for (int i = 0; i < 10; i++)
+        book->send(new Tracked());
+    EXPECT_EQ(book->queue_length(), 1u);
+    EXPECT_EQ(book->conflated_count(), 10u);
+    EXPECT_EQ(Tracked::alive.load() - before, 1);
+
+    mgr.init();
+    book->send(new msg::Shutdown());
+    mgr.end();
+    EXPECT_EQ(Tracked::alive.load() - before, 0);
+    delete book;
+}
+
+TEST(ConflatingMailboxTest, RunningActorSeesLatestValue) {
+    BookManager mgr;
+    auto* book = new Book();
+    book->gate = false;  // hold the actor in its first handler
+    mgr.manage(book, {}, 0, SCHED_OTHER, MailboxType::CONFLATING);
+    mgr.init();
+
+    book->send(new Quote("AAPL", 0));
+    while (book->queue_length() != 0)
+        std::this_thread::yield();
+    for (int i = 1; i <= 1000; i++)
+        book->send(new Quote("AAPL", i));
+    book->gate = true;
+    for (int i = 0; i < 10000 && book->received.load() < 2; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    book->send(new msg::Shutdown());
+    mgr.end();
+    ASSERT_GE(book->seen.size(), 2u);
+    EXPECT_EQ(book->seen.back(), "AAPL=1000");
+    EXPECT_EQ(book->conflated_count() + book->seen.size(), 1001u);
+    delete book;
+}
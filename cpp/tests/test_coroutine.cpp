@@ -0,0 +1,223 @@
+/*
+ * Tests for coroutine message handlers: ask, sleep_for and frame pooling
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "actors/Coroutine.hpp"
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+using namespace actors;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Query : public Message_N<4931> {
+    int value;
+    explicit Query(int v) : value(v) {}
+};
+struct Answer : public Message_N<4932> {
+    int value;
+    explicit Answer(int v) : value(v) {}
+};
+struct Request : public Message_N<4933> {
+    int value;
+    std::chrono::milliseconds timeout;
+    Request(int v, std::chrono::milliseconds t = 1000ms) : value(v), timeout(t) {}
+};
+struct Nap : public Message_N<4934> {};
+struct Note : public Message_N<4935> {};
+
+// Replies to a Query with value * 10; ignores it when value is negative
+class Doubler : public Actor {
+public:
+    Doubler() {
+        strncpy(name, "Doubler", sizeof(name) - 1);
+        MESSAGE_HANDLER(Query, on_query);
+    }
+    void on_query(const Query* m) noexcept {
+        if (m->value >= 0)
+            reply(new Answer(m->value * 10));
+    }
+};
+
+class Frontend : public Actor {
+public:
+    Actor* backend = nullptr;
+    std::mutex mut;
+    std::vector<std::string> log;
+    std::vector<std::thread::id> threads;
+    std::atomic<int> finished{0};
+
+    Frontend() {
+        strncpy(name, "Frontend", sizeof(name) - 1);
+        MESSAGE_HANDLER(Request, on_request);
+        MESSAGE_HANDLER(Nap, on_nap);
+        MESSAGE_HANDLER(Note, on_note);
+    }
+
+    void record(const std::string& s) {
+        std::lock_guard<std::mutex> lock(mut);
+        log.push_back(s);
+        threads.push_back(std::this_thread::get_id());
+    }
+
+    Task on_request(const Request* m) {
+        Reply r = co_await ask(backend, new Query(m->value), m->timeout);
+        if (!r) {
+            record("timeout " + std::to_string(m->value));
+        } else {
+            int v = static_cast<const Answer*>(r.get())->value;
+            record("answer " + std::to_string(v));
+            // The request and its sender are ours again
+            EXPECT_EQ(current_message(), m);
+            reply(new Answer(v + m->value));
+        }
+        finished++;
+    }
+
+    Task on_nap(const Nap*) {
+        record("nap");
+        co_await sleep_for(30ms);
+        record("woke");
+        finished++;
+    }
+
+    void on_note(const Note*) noexcept { record("note"); }
+};
+
+// Sends requests and collects the answers
+class Client : public Actor {
+public:
+    std::atomic<int> last{0};
+    std::atomic<int> answers{0};
+
+    Client() {
+        strncpy(name, "Client", sizeof(name) - 1);
+        MESSAGE_HANDLER(Answer, on_answer);
+    }
+    void on_answer(const Answer* m) noexcept {
+        last = m->value;
+        answers++;
+    }
+};
+
+class CoroutineManager : public Manager {
+public:
+    CoroutineManager() { strncpy(name, "CoroutineManager", sizeof(name) - 1); }
+};
+
+template <class Pred>
+bool wait_for(Pred pred) {
+    for (int i = 0; i < 500 && !pred(); i++)
+        std::this_thread::sleep_for(10ms);
+    return pred();
+}
+
+}  // namespace
+
+TEST(CoroutineTest, AskResumesWithReplyAndRepliesToSender) {
+    CoroutineManager mgr;
+    auto* doubler = new Doubler();
+    auto* front = new Frontend();
+    auto* client = new Client();
+    front->backend = doubler;
+    mgr.manage(doubler);
+    mgr.manage(front);
+    mgr.manage(client);
+    mgr.init();
+
+    front->send(new Request(4), client);
+    ASSERT_TRUE(wait_for([&] { return client->answers == 1; }));
+    EXPECT_EQ(client->last, 44);
+    ASSERT_TRUE(wait_for([&] { return front->finished == 1; }));
+
+    // Many outstanding at once; each gets its own reply
+    for (int i = 1; i <= 20; i++)
+        front->send(new Request(i), client);
+    ASSERT_TRUE(wait_for([&] { return client->answers == 21; }));
+    EXPECT_EQ(front->finished, 21);
+
+    for (Actor* a : std::vector<Actor*>{doubler, front, client})
+        a->send(new msg::Shutdown());
+    mgr.end();
+    delete doubler;
+    delete front;
+    delete client;
+}
+
+TEST(CoroutineTest, SleepDoesNotBlockTheActor) {
+    CoroutineManager mgr;
+    auto* front = new Frontend();
+    mgr.manage(front);
+    mgr.init();
+
+    front->send(new Nap());
+    front->send(new Note());
+    ASSERT_TRUE(wait_for([&] { return front->finished == 1; }));
+
+    {
+        std::lock_guard<std::mutex> lock(front->mut);
+        std::vector<std::string> expected = {"nap", "note", "woke"};
+        EXPECT_EQ(front->log, expected);
+        // Resumed on the actor's own thread
+        EXPECT_EQ(front->threads[0], front->threads[2]);
+        EXPECT_NE(front->threads[0], std::this_thread::get_id());
+    }
+
+    front->send(new msg::Shutdown());
+    mgr.end();
+    delete front;
+}
+
+TEST(CoroutineTest, AskTimesOutWithNullReply) {
+    CoroutineManager mgr;
+    auto* doubler = new Doubler();
+    auto* front = new Frontend();
+    front->backend = doubler;
+    mgr.manage(doubler);
+    mgr.manage(front);
+    mgr.init();
+
+    front->send(new Request(-1, 20ms));
+    ASSERT_TRUE(wait_for([&] { return front->finished == 1; }));
+    {
+        std::lock_guard<std::mutex> lock(front->mut);
+        ASSERT_EQ(front->log.size(), 1u);
+        EXPECT_EQ(front->log[0], "timeout -1");
+    }
+
+    // Still suspended at shutdown: destroyed with the actor
+    front->send(new Request(-2, 60s));
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(front->coroutine_host().suspended(), 1u);
+
+    doubler->send(new msg::Shutdown());
+    front->send(new msg::Shutdown());
+    mgr.end();
+    delete doubler;
+    delete front;
+}
+
+TEST(CoroutineTest, FramePoolReusesBlocks) {
+    void* a = FramePool::allocate(100);
+    std::size_t before = FramePool::cached();
+    FramePool::deallocate(a, 100);
+    EXPECT_EQ(FramePool::cached(), before + 1);
+
+    void* b = FramePool::allocate(120);  // Same 128-byte class
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(FramePool::cached(), before);
+    FramePool::deallocate(b, 120);
+
+    void* big = FramePool::allocate(ACTOR_FRAME_POOL_MAX + 1);
+    FramePool::deallocate(big, ACTOR_FRAME_POOL_MAX + 1);
+    EXPECT_EQ(FramePool::cached(), before + 1);
+}
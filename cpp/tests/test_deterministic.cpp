@@ -0,0 +1,166 @@
+/*
+ * Tests for Manager::run_deterministic() and its virtual clock
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/act/Timer.hpp"
+#include "actors/act/TimerWheel.hpp"
+#include "actors/msg/Start.hpp"
+#include "actors/msg/Timeout.hpp"
+
+using namespace actors;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Hit : public Message_N<4961> {
+    int n;
+    explicit Hit(int v) : n(v) {}
+};
+
+// Hits its peers round-robin until the count runs out, logging every call
+class Player : public Actor {
+public:
+    std::vector<std::string>* log = nullptr;
+    std::vector<Player*> peers;
+    std::thread::id ran_on;
+    bool ended = false;
+
+    explicit Player(const char* n) {
+        strncpy(name, n, sizeof(name) - 1);
+        MESSAGE_HANDLER(Hit, on_hit);
+    }
+    void on_hit(const Hit* m) noexcept {
+        ran_on = std::this_thread::get_id();
+        log->push_back(std::string(name) + ":" + std::to_string(m->n));
+        if (m->n > 0)
+            for (auto* p : peers)
+                p->send(new Hit(m->n - 1), this);
+    }
+    void end() override { ended = true; }
+};
+
+class Clock : public Actor {
+public:
+    std::vector<std::chrono::steady_clock::duration> fired;
+    std::chrono::steady_clock::time_point t0;
+    TimerHandle tick;
+
+    Clock() {
+        strncpy(name, "Clock", sizeof(name) - 1);
+        MESSAGE_HANDLER(msg::Start, on_start);
+        MESSAGE_HANDLER(msg::Timeout, on_timeout);
+    }
+    void on_start(const msg::Start*) noexcept {
+        t0 = TimerWheel::instance().now();
+        Timer::wake_up_in(this, 3600);             // An hour, in no time
+        tick = Timer::wake_up_every(this, 250, 1);
+    }
+    void on_timeout(const msg::Timeout* m) noexcept {
+        if (m->data == 0)
+            Timer::cancel(tick);
+        fired.push_back(TimerWheel::instance().now() - t0);
+    }
+};
+
+class StepManager : public Manager {
+public:
+    StepManager() { strncpy(name, "StepManager", sizeof(name) - 1); }
+};
+
+std::vector<std::string> play(std::thread::id& ran_on) {
+    std::vector<std::string> log;
+    StepManager mgr;
+    std::vector<Player*> players;
+    for (const char* n : {"P1", "P2", "P3"}) {
+        players.push_back(new Player(n));
+        players.back()->log = &log;
+        mgr.manage(players.back());
+    }
+    for (auto* p : players)
+        for (auto* q : players)
+            if (p != q)
+                p->peers.push_back(q);
+
+    mgr.run_deterministic();
+    players[0]->send(new Hit(6));
+    std::size_t handled = mgr.run_deterministic();
+    EXPECT_EQ(handled, log.size());
+    ran_on = players[1]->ran_on;
+
+    mgr.end();
+    for (auto* p : players) {
+        EXPECT_TRUE(p->ended);
+        delete p;
+    }
+    return log;
+}
+
+}  // namespace
+
+TEST(DeterministicTest, SameInputSameOrder) {
+    std::thread::id first_on, second_on;
+    auto first = play(first_on);
+    auto second = play(second_on);
+
+    EXPECT_EQ(first.size(), 127u);  // 1 + 2 + 4 + ... + 64
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first_on, std::this_thread::get_id());
+    EXPECT_EQ(second_on, std::this_thread::get_id());
+}
+
+TEST(DeterministicTest, TimersRunOnVirtualClock) {
+    StepManager mgr;
+    auto* clock = new Clock();
+    mgr.manage(clock);
+
+    auto start = std::chrono::steady_clock::now();
+    mgr.run_deterministic(1s);  // Only the ticks within the first second
+    ASSERT_EQ(clock->fired.size(), 4u);
+    EXPECT_EQ(clock->fired[0], 250ms);
+    EXPECT_EQ(clock->fired[3], 1000ms);
+
+    mgr.run_deterministic();  // Runs to the hour, which cancels the ticks
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+    ASSERT_EQ(clock->fired.size(), 14401u);
+    EXPECT_EQ(clock->fired.back(), std::chrono::hours(1));
+    EXPECT_TRUE(TimerWheel::instance().is_virtual());
+
+    mgr.end();
+    EXPECT_FALSE(TimerWheel::instance().is_virtual());
+    delete clock;
+}
+
+TEST(DeterministicTest, TerminateStopsTheRun) {
+    StepManager mgr;
+    std::vector<std::string> log;
+    auto* a = new Player("A");
+    auto* b = new Player("B");
+    a->log = b->log = &log;
+    a->peers = {b};
+    b->peers = {a};
+    mgr.manage(a);
+    mgr.manage(b);
+
+    mgr.run_deterministic();
+    a->send(new Hit(1000000));
+    std::thread stopper([&]() {
+        std::this_thread::sleep_for(20ms);
+        mgr.terminate();
+    });
+    mgr.run_deterministic();  // Would take far longer without terminate()
+    stopper.join();
+    EXPECT_LT(log.size(), 1000000u);
+
+    mgr.shutdown(10ms);  // Drains the rest until the deadline
+    EXPECT_TRUE(a->ended);
+    EXPECT_TRUE(b->ended);
+    delete a;
+    delete b;
+}
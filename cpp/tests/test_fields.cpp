@@ -0,0 +1,202 @@
+/*
+ * Tests for field descriptors and the codecs generated from them
+ */
+
+#include <gtest/gtest.h>
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+#include "actors/remote/Serialization.hpp"
+
+using namespace actors;
+
+namespace {
+
+enum class Side : std::uint8_t { BUY = 1, SELL = 2 };
+
+struct Level {
+    double price = 0;
+    std::int64_t qty = 0;
+    static constexpr auto fields() {
+        return std::make_tuple(ACTOR_FIELD(Level, price), ACTOR_FIELD(Level, qty));
+    }
+};
+
+struct Book : public Message_N<160> {
+    std::string symbol;
+    Side side = Side::BUY;
+    std::vector<Level> levels;
+    std::array<double, 3> stats{};
+    std::array<Level, 2> best{};
+    std::vector<std::vector<int>> grid;
+    static constexpr auto fields() {
+        return std::make_tuple(ACTOR_FIELD(Book, symbol), ACTOR_FIELD(Book, side),
+                               ACTOR_FIELD(Book, levels), ACTOR_FIELD(Book, stats),
+                               ACTOR_FIELD(Book, best), ACTOR_FIELD(Book, grid));
+    }
+};
+
+// More fields than the numbered macros allow
+struct Wide : public Message_N<161> {
+    int a = 0, b = 0, c = 0, d = 0, e = 0, f = 0, g = 0, h = 0, i = 0, j = 0, k = 0, l = 0;
+    static constexpr auto fields() {
+        return std::make_tuple(ACTOR_FIELD(Wide, a), ACTOR_FIELD(Wide, b), ACTOR_FIELD(Wide, c),
+                               ACTOR_FIELD(Wide, d), ACTOR_FIELD(Wide, e), ACTOR_FIELD(Wide, f),
+                               ACTOR_FIELD(Wide, g), ACTOR_FIELD(Wide, h), ACTOR_FIELD(Wide, i),
+                               ACTOR_FIELD(Wide, j), ACTOR_FIELD(Wide, k), ACTOR_FIELD(Wide, l));
+    }
+};
+
+// A member without a binary encoding keeps the message JSON-only
+using Tags = std::map<std::string, int>;
+
+struct Tagged : public Message_N<162> {
+    Tags tags;
+    std::vector<Level> levels;
+    static constexpr auto fields() {
+        return std::make_tuple(ACTOR_FIELD(Tagged, tags), ACTOR_FIELD(Tagged, levels));
+    }
+};
+
+template <class T>
+std::unique_ptr<T> binary_round_trip(const T& in) {
+    std::string buf;
+    wire::BinaryWriter w(buf);
+    EXPECT_TRUE(serialization::MessageRegistry::instance().encode(&in, w));
+    wire::BinaryReader r(buf.data(), buf.size());
+    std::unique_ptr<Message> out(serialization::MessageRegistry::instance().decode(in.id(), r));
+    EXPECT_EQ(r.remaining(), 0u);
+    return std::unique_ptr<T>(static_cast<T*>(out.release()));
+}
+
+Book sample_book() {
+    Book b;
+    b.symbol = "ES";
+    b.side = Side::SELL;
+    b.levels = {{100.25, 3}, {100.5, 7}};
+    b.stats = {1.5, 2.5, 3.5};
+    b.best = {Level{99.0, 1}, Level{101.0, 2}};
+    b.grid = {{1, 2}, {}, {3}};
+    return b;
+}
+
+void expect_same(const Book& a, const Book& b) {
+    EXPECT_EQ(a.symbol, b.symbol);
+    EXPECT_EQ(a.side, b.side);
+    ASSERT_EQ(a.levels.size(), b.levels.size());
+    for (size_t i = 0; i < a.levels.size(); i++) {
+        EXPECT_EQ(a.levels[i].price, b.levels[i].price);
+        EXPECT_EQ(a.levels[i].qty, b.levels[i].qty);
+    }
+    EXPECT_EQ(a.stats, b.stats);
+    EXPECT_EQ(a.best[1].price, b.best[1].price);
+    EXPECT_EQ(a.best[1].qty, b.best[1].qty);
+    EXPECT_EQ(a.grid, b.grid);
+}
+
+} // namespace
+
+REGISTER_REMOTE_FIELDS(Book)
+REGISTER_REMOTE_FIELDS(Wide)
+REGISTER_REMOTE_FIELDS(Tagged)
+
+TEST(FieldsTest, EncodableTraits) {
+    static_assert(serialization::has_fields<Level>);
+    static_assert(!serialization::has_fields<int>);
+    static_assert(wire::is_encodable_v<Level>);
+    static_assert(wire::is_encodable_v<std::array<Level, 4>>);
+    static_assert(wire::is_encodable_v<Book>);
+    static_assert(!wire::is_encodable_v<Tagged>);
+    static_assert(wire::min_encoded_size<Level>() == 16);
+    static_assert(wire::min_encoded_size<std::array<std::int32_t, 3>>() == 12);
+    SUCCEED();
+}
+
+TEST(FieldsTest, JsonNestedRoundTrip) {
+    Book in = sample_book();
+    nlohmann::json j = serialization::serialize(&in);
+    EXPECT_EQ(j["symbol"], "ES");
+    EXPECT_EQ(j["levels"][1]["qty"], 7);
+    EXPECT_EQ(j["best"][0]["price"], 99.0);
+    EXPECT_EQ(j["stats"].size(), 3u);
+
+    std::unique_ptr<Message> m(serialization::deserialize("Book", j));
+    ASSERT_NE(m, nullptr);
+    expect_same(in, *static_cast<Book*>(m.get()));
+}
+
+TEST(FieldsTest, JsonFromOtherLanguagesIgnoresExtraKeys) {
+    auto j = nlohmann::json::parse(R"({"zzz": 1, "symbol": "NQ", "side": 1,
+        "levels": [{"qty": 2, "price": 5.5}], "stats": [0, 0, 9],
+        "best": [{"price": 1, "qty": 1}, {"price": 2, "qty": 2}], "grid": []})");
+    std::unique_ptr<Message> m(serialization::deserialize("Book", j));
+    ASSERT_NE(m, nullptr);
+    auto* b = static_cast<Book*>(m.get());
+    EXPECT_EQ(b->symbol, "NQ");
+    ASSERT_EQ(b->levels.size(), 1u);
+    EXPECT_EQ(b->levels[0].qty, 2);
+    EXPECT_EQ(b->stats[2], 9.0);
+}
+
+TEST(FieldsTest, JsonMissingFieldThrows) {
+    auto j = nlohmann::json::parse(R"({"symbol": "ES"})");
+    EXPECT_THROW(serialization::deserialize("Book", j), nlohmann::json::exception);
+    auto nested = nlohmann::json::parse(R"({"symbol": "ES", "side": 1, "levels": [{"price": 1}],
+        "stats": [0, 0, 0], "best": [{"price": 1, "qty": 1}, {"price": 2, "qty": 2}], "grid": []})");
+    EXPECT_THROW(serialization::deserialize("Book", nested), nlohmann::json::exception);
+    EXPECT_THROW(serialization::deserialize("Book", nlohmann::json(5)), nlohmann::json::exception);
+}
+
+TEST(FieldsTest, BinaryNestedRoundTrip) {
+    EXPECT_TRUE(serialization::MessageRegistry::instance().has_binary(160));
+    Book in = sample_book();
+    auto out = binary_round_trip(in);
+    ASSERT_NE(out, nullptr);
+    expect_same(in, *out);
+}
+
+TEST(FieldsTest, BinaryRejectsImpossibleVectorLength) {
+    std::string buf;
+    wire::BinaryWriter w(buf);
+    w.put(std::uint32_t(1000));  // 1000 Levels need 16000 bytes
+    buf.append(64, '\0');
+    wire::BinaryReader r(buf.data(), buf.size());
+    EXPECT_THROW(r.get<std::vector<Level>>(), wire::WireError);
+}
+
+TEST(FieldsTest, NoFieldLimit) {
+    Wide in;
+    in.a = 1;
+    in.l = 12;
+    auto out = binary_round_trip(in);
+    ASSERT_NE(out, nullptr);
+    EXPECT_EQ(out->a, 1);
+    EXPECT_EQ(out->l, 12);
+
+    std::unique_ptr<Message> m(serialization::deserialize("Wide", serialization::serialize(&in)));
+    ASSERT_NE(m, nullptr);
+    EXPECT_EQ(static_cast<Wide*>(m.get())->l, 12);
+}
+
+TEST(FieldsTest, NonEncodableMemberStaysJson) {
+    EXPECT_FALSE(serialization::MessageRegistry::instance().has_binary(162));
+    Tagged in;
+    in.tags = {{"x", 1}};
+    in.levels = {{1.0, 2}};
+    std::unique_ptr<Message> m(serialization::deserialize("Tagged", serialization::serialize(&in)));
+    ASSERT_NE(m, nullptr);
+    auto* t = static_cast<Tagged*>(m.get());
+    EXPECT_EQ(t->tags, in.tags);
+    ASSERT_EQ(t->levels.size(), 1u);
+    EXPECT_EQ(t->levels[0].qty, 2);
+}
+
+TEST(FieldsTest, GeneratedCodecUsesFunctionPointers) {
+    const serialization::RegistryEntry* e = serialization::MessageRegistry::instance().find(160);
+    ASSERT_NE(e, nullptr);
+    EXPECT_NE(e->codec.to_json, nullptr);
+    EXPECT_NE(e->codec.decode, nullptr);
+    EXPECT_FALSE(e->serialize);
+    EXPECT_FALSE(e->encode);
+}
@@ -0,0 +1,216 @@
+/*
+ * Tests for credit-based remote flow control (CreditWindow, CreditLedger)
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "actors/Actor.hpp"
+#include "actors/msg/Shutdown.hpp"
+#include "actors/remote/CreditGrant.hpp"
+#include "actors/remote/FlowControl.hpp"
+
+using namespace actors;
+
+namespace {
+
+struct Work : public Message_N<4991> {};
+
+class Sink : public Actor {
+public:
+    explicit Sink(const char* actor_name = "Sink") {
+        strncpy(name, actor_name, sizeof(name) - 1);
+        MESSAGE_HANDLER(Work, on_work);
+    }
+
+    void on_work(const Work*) noexcept {}
+};
+
+using Window = CreditWindow<std::string>;
+
+const char* const REPLY_TO = "tcp://localhost:5002";
+const char* const ENDPOINT = "tcp://localhost:5001";
+
+}  // namespace
+
+TEST(FlowControlTest, WindowUnmeteredUntilFirstGrant) {
+    Window w;
+    w.set_session(7);
+    for (int i = 0; i < 10000; i++) {
+        ASSERT_TRUE(w.can_send());
+        w.sent(1);
+    }
+    FlowStats s = w.stats();
+    EXPECT_TRUE(s.enabled);
+    EXPECT_FALSE(s.metered);
+    EXPECT_EQ(s.sent, 10000u);
+}
+
+TEST(FlowControlTest, WindowHoldsThenReleasesInOrder) {
+    Window w(FlowPolicy{3});
+    w.set_session(7);
+    EXPECT_TRUE(w.grant(7, 0, 2));
+
+    w.sent(1);
+    w.sent(1);
+    EXPECT_FALSE(w.can_send());
+    EXPECT_EQ(w.stats().in_flight(), 2u);
+
+    EXPECT_TRUE(w.hold("a", 1));
+    EXPECT_TRUE(w.hold("b", 2));
+    EXPECT_FALSE(w.hold("c", 1));  // max_queued reached
+    EXPECT_EQ(w.stats().queued, 3u);
+    EXPECT_EQ(w.stats().rejected, 1u);
+
+    std::vector<std::string> out;
+    auto send = [&](std::string& s) { out.push_back(s); };
+    w.grant(7, 2, 3);
+    w.release(send);
+    EXPECT_EQ(out, (std::vector<std::string>{"a"}));
+    EXPECT_FALSE(w.can_send());  // "b" still waits, so nothing overtakes it
+
+    // A multipart item needs one credit; it may overshoot the limit
+    w.grant(7, 3, 4);
+    w.release(send);
+    EXPECT_EQ(out, (std::vector<std::string>{"a", "b"}));
+    FlowStats s = w.stats();
+    EXPECT_EQ(s.sent, 5u);
+    EXPECT_EQ(s.acked, 3u);
+    EXPECT_EQ(s.in_flight(), 2u);
+    EXPECT_EQ(s.queued, 0u);
+}
+
+TEST(FlowControlTest, WindowIgnoresStaleAndOldGrants) {
+    Window w;
+    w.set_session(7);
+    EXPECT_FALSE(w.grant(8, 0, 100));
+    EXPECT_FALSE(w.stats().metered);
+
+    w.sent(10);
+    EXPECT_TRUE(w.grant(7, 10, 20));
+    EXPECT_TRUE(w.grant(7, 4, 12));  // Reordered: counts never go back
+    EXPECT_EQ(w.stats().limit, 20u);
+    EXPECT_EQ(w.stats().acked, 10u);
+}
+
+TEST(FlowControlTest, WindowRejectsAtOnceWithNoQueue) {
+    Window w(FlowPolicy{0});
+    w.grant(0, 0, 0);
+    EXPECT_FALSE(w.can_send());
+    EXPECT_FALSE(w.hold("a", 1));
+    EXPECT_EQ(w.stats().rejected, 1u);
+}
+
+TEST(FlowControlTest, DisableReleasesEverything) {
+    Window w;
+    w.grant(0, 0, 1);
+    w.sent(1);
+    w.hold("a", 1);
+    w.hold("b", 1);
+
+    std::vector<std::string> out;
+    w.disable([&](std::string& s) { out.push_back(s); });
+    EXPECT_EQ(out.size(), 2u);
+    EXPECT_FALSE(w.stats().enabled);
+    EXPECT_EQ(w.stats().sent, 3u);
+
+    w.set_policy(FlowPolicy{});
+    EXPECT_TRUE(w.stats().enabled);
+    EXPECT_EQ(w.stats().sent, 3u);  // Counters carry on
+}
+
+TEST(FlowControlTest, LedgerGrantsOnFirstMessageAndEachHalfWindow) {
+    CreditLedger ledger(100, 1000);
+    CreditLedger::Grant g;
+    ASSERT_TRUE(ledger.consume(REPLY_TO, ENDPOINT, 7, nullptr, g));
+    EXPECT_EQ(g.reply_to, REPLY_TO);
+    EXPECT_EQ(g.endpoint, ENDPOINT);
+    EXPECT_EQ(g.session, 7u);
+    EXPECT_EQ(g.consumed, 1u);
+    EXPECT_EQ(g.limit, 101u);
+
+    int grants = 0;
+    for (int i = 0; i < 200; i++)
+        if (ledger.consume(REPLY_TO, ENDPOINT, 7, nullptr, g))
+            grants++;
+    EXPECT_EQ(grants, 4);  // Every 50 messages
+    EXPECT_EQ(g.limit, g.consumed + 100);
+    EXPECT_EQ(ledger.peers(), 1u);
+}
+
+TEST(FlowControlTest, LedgerScalesGrantByMailboxDepth) {
+    Sink sink;
+    CreditLedger ledger(100, 150);
+    for (int i = 0; i < 90; i++)
+        sink.send(new Work());
+
+    CreditLedger::Grant g;
+    ASSERT_TRUE(ledger.consume(REPLY_TO, ENDPOINT, 1, &sink, g));
+    EXPECT_EQ(g.limit - g.consumed, 60u);  // max_depth - depth
+}
+
+TEST(FlowControlTest, LedgerWithholdsUntilMailboxDrains) {
+    Sink sink;
+    CreditLedger ledger(100, 100);
+    for (int i = 0; i < 100; i++)
+        sink.send(new Work());
+
+    CreditLedger::Grant g;
+    EXPECT_FALSE(ledger.consume(REPLY_TO, ENDPOINT, 1, &sink, g));
+    EXPECT_EQ(ledger.withheld(), 1u);
+    EXPECT_FALSE(ledger.consume(REPLY_TO, ENDPOINT, 1, &sink, g));
+
+    std::vector<CreditLedger::Grant> grants;
+    ledger.recheck(grants);
+    EXPECT_TRUE(grants.empty());
+    EXPECT_EQ(ledger.withheld(), 1u);
+
+    // Let the sink handle its mailbox
+    std::thread runner([&] { sink(); });
+    sink.send(new msg::Shutdown());
+    runner.join();
+    ledger.recheck(grants);
+    ASSERT_EQ(grants.size(), 1u);
+    EXPECT_EQ(grants[0].consumed, 2u);
+    EXPECT_EQ(grants[0].limit, 102u);
+    EXPECT_EQ(ledger.withheld(), 0u);
+}
+
+TEST(FlowControlTest, LedgerKeepsSendersApart) {
+    CreditLedger ledger(10, 100);
+    CreditLedger::Grant g;
+    EXPECT_TRUE(ledger.consume("tcp://a:1", ENDPOINT, 1, nullptr, g));
+    EXPECT_TRUE(ledger.consume("tcp://b:1", ENDPOINT, 1, nullptr, g));
+    EXPECT_EQ(g.reply_to, "tcp://b:1");
+    EXPECT_EQ(g.consumed, 1u);
+    EXPECT_EQ(ledger.peers(), 2u);
+
+    // A new session from the same sender starts its counts over
+    for (int i = 0; i < 5; i++)
+        ledger.consume("tcp://a:1", ENDPOINT, 1, nullptr, g);
+    ASSERT_TRUE(ledger.consume("tcp://a:1", ENDPOINT, 2, nullptr, g));
+    EXPECT_EQ(g.session, 2u);
+    EXPECT_EQ(g.consumed, 1u);
+    EXPECT_EQ(ledger.peers(), 2u);
+}
+
+TEST(FlowControlTest, LedgerWindowZeroNeverGrants) {
+    CreditLedger ledger(0, 100);
+    CreditLedger::Grant g;
+    EXPECT_FALSE(ledger.consume(REPLY_TO, ENDPOINT, 1, nullptr, g));
+    EXPECT_EQ(ledger.peers(), 0u);
+}
+
+TEST(FlowControlTest, CreditGrantJsonRoundTrip) {
+    msg::CreditGrant grant(ENDPOINT, 0xFFFFFFFFFFFFull, 10, 522);
+    nlohmann::json j = serialization::serialize(&grant);
+    std::unique_ptr<Message> m(serialization::deserialize("CreditGrant", j));
+    auto* d = dynamic_cast<msg::CreditGrant*>(m.get());
+    ASSERT_NE(d, nullptr);
+    EXPECT_EQ(d->endpoint, ENDPOINT);
+    EXPECT_EQ(d->session, 0xFFFFFFFFFFFFull);
+    EXPECT_EQ(d->consumed, 10u);
+    EXPECT_EQ(d->limit, 522u);
+}
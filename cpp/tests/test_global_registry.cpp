@@ -0,0 +1,203 @@
+/*
+ * Tests for the native GlobalRegistry and its JSON protocol
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "actors/registry/GlobalRegistry.hpp"
+#include "actors/registry/RegistryClient.hpp"
+#include "actors/registry/RegistryServer.hpp"
+
+using namespace actors;
+using namespace actors::registry;
+using namespace std::chrono_literals;
+
+namespace {
+
+// Records pushed events as "<subscriber> <type> <name>"
+struct PushLog {
+    std::vector<std::string> events;
+
+    GlobalRegistry::PushFn fn() {
+        return [this](const std::string& subscriber, const std::string&, const Message* event) {
+            std::unique_ptr<const Message> owned(event);
+            if (auto* m = dynamic_cast<const ActorMoved*>(event))
+                events.push_back(subscriber + " moved " + m->actor_name + " " + m->actor_endpoint);
+            else if (auto* off = dynamic_cast<const ManagerOffline*>(event))
+                events.push_back(subscriber + " offline " + off->manager_id + " " +
+                                 std::to_string(off->actor_names.size()));
+            else if (auto* on = dynamic_cast<const ManagerOnline*>(event))
+                events.push_back(subscriber + " online " + on->manager_id);
+        };
+    }
+};
+
+} // namespace
+
+TEST(GlobalRegistryTest, ClientRegistersAndLooksUp) {
+    GlobalRegistry registry;
+    RegistryClient client("mgr1", ActorRef(&registry));
+
+    EXPECT_TRUE(client.register_actors({"a", "b"}, "tcp://host:5001").empty());
+    EXPECT_EQ(client.lookup("a"), "tcp://host:5001");
+    EXPECT_THROW(client.lookup("ghost"), ActorNotFoundError);
+
+    RegistryStats stats = registry.stats();
+    EXPECT_EQ(stats.actors, 2u);
+    EXPECT_EQ(stats.managers, 1u);
+    EXPECT_EQ(stats.managers_online, 1u);
+}
+
+TEST(GlobalRegistryTest, NameHeldByOnlineManagerIsRejected) {
+    GlobalRegistry registry;
+    EXPECT_EQ(registry.register_actor("mgr1", "a", "tcp://host:5001"), "");
+    EXPECT_EQ(registry.register_actor("mgr2", "a", "tcp://host:5002"), "Name already registered");
+
+    // The same manager may register again, e.g. after a quick restart
+    EXPECT_EQ(registry.register_actor("mgr1", "a", "tcp://host:5003"), "");
+    EXPECT_EQ(registry.lookup("a").endpoint, "tcp://host:5003");
+}
+
+TEST(GlobalRegistryTest, ExpiryUsesAnnouncedInterval) {
+    GlobalRegistry registry;
+    auto t0 = GlobalRegistry::Clock::now();
+    registry.register_actor("mgr1", "a", "tcp://host:5001");
+    registry.heartbeat("mgr1", 1000);
+    EXPECT_EQ(registry.heartbeat_timeout("mgr1"), 3000ms);
+
+    EXPECT_EQ(registry.expire(t0 + 2900ms), 0u);
+    EXPECT_TRUE(registry.is_manager_online("mgr1"));
+
+    EXPECT_EQ(registry.expire(t0 + 4000ms), 1u);
+    EXPECT_FALSE(registry.is_manager_online("mgr1"));
+    EXPECT_EQ(registry.expire(t0 + 8000ms), 0u);  // Already offline
+
+    // Offline actors still resolve, and another manager may take them over
+    auto found = registry.lookup("a");
+    EXPECT_TRUE(found.found);
+    EXPECT_FALSE(found.online);
+    EXPECT_EQ(registry.register_actor("mgr2", "a", "tcp://host:5002"), "");
+    EXPECT_TRUE(registry.lookup("a").online);
+    EXPECT_EQ(registry.stats().expired, 1u);
+}
+
+TEST(GlobalRegistryTest, PushesLivenessEvents) {
+    GlobalRegistry registry;
+    PushLog log;
+    registry.set_push(log.fn());
+    registry.subscribe("watcher", "tcp://me:6000", {"a"}, {});
+
+    auto t0 = GlobalRegistry::Clock::now();
+    registry.register_actor("mgr1", "a", "tcp://host:5001");
+    registry.register_actor("mgr1", "b", "tcp://host:5001");  // Not watched
+    registry.expire(t0 + 10s);
+    registry.heartbeat("mgr1");
+    registry.unregister_actor("a");
+
+    std::vector<std::string> expected = {
+        "watcher online mgr1",
+        "watcher moved a tcp://host:5001",
+        "watcher offline mgr1 2",
+        "watcher online mgr1",
+        "watcher moved a ",
+    };
+    EXPECT_EQ(log.events, expected);
+
+    registry.unsubscribe("watcher", "tcp://me:6000", {}, {});
+    registry.register_actor("mgr1", "a", "tcp://host:5001");
+    EXPECT_EQ(log.events.size(), expected.size());
+    EXPECT_EQ(registry.stats().subscriptions, 0u);
+}
+
+TEST(GlobalRegistryTest, ClientSubscriptionReachesRegistry) {
+    GlobalRegistry registry;
+    PushLog log;
+    registry.set_push(log.fn());
+    RegistryClient client("mgr0", ActorRef(&registry));
+
+    client.subscribe({}, {"mgr1"}, "tcp://me:6000");
+    registry.heartbeat("mgr1", 500);
+    ASSERT_EQ(log.events.size(), 1u);
+    EXPECT_EQ(log.events[0], client.listener_name() + " online mgr1");
+}
+
+TEST(GlobalRegistryTest, SnapshotRoundTrip) {
+    std::string path = testing::TempDir() + "registry_test.snap";
+    {
+        GlobalRegistry registry;
+        registry.register_actor("mgr1", "a", "tcp://host:5001");
+        registry.register_actor("mgr2", "b", "tcp://host:5002");
+        registry.heartbeat("mgr2", 250);
+        registry.subscribe("watcher", "tcp://me:6000", {"a"}, {"mgr2"});
+        ASSERT_TRUE(registry.save_snapshot(path));
+    }
+
+    GlobalRegistry restored;
+    ASSERT_TRUE(restored.load_snapshot(path));
+    EXPECT_EQ(restored.lookup("b").endpoint, "tcp://host:5002");
+    EXPECT_TRUE(restored.lookup("a").online);  // Grace period until a heartbeat is due
+    EXPECT_EQ(restored.heartbeat_timeout("mgr2"), 750ms);
+
+    RegistryStats stats = restored.stats();
+    EXPECT_EQ(stats.actors, 2u);
+    EXPECT_EQ(stats.managers, 2u);
+    EXPECT_EQ(stats.subscriptions, 1u);
+    std::remove(path.c_str());
+
+    std::ofstream(path) << "not a snapshot\n";
+    EXPECT_FALSE(restored.load_snapshot(path));
+    EXPECT_EQ(restored.stats().actors, 2u);  // Unchanged
+    std::remove(path.c_str());
+}
+
+TEST(RegistryJsonTest, SpeaksPythonClientProtocol) {
+    using nlohmann::json;
+    GlobalRegistry registry;
+
+    auto ok = handle_json_request(registry, {{"message_type", "RegisterActor"}, {"manager_id", "py"},
+                                             {"actor_name", "a"}, {"actor_endpoint", "tcp://host:5001"}});
+    EXPECT_EQ(ok["message_type"], "RegistrationOk");
+
+    auto bulk = handle_json_request(registry, json::parse(R"({
+        "message_type": "RegisterActors", "manager_id": "rs",
+        "actors": [{"actor_name": "a", "actor_endpoint": "tcp://h:1"},
+                   {"actor_name": "b", "actor_endpoint": "tcp://h:1"}]})"));
+    EXPECT_EQ(bulk["message_type"], "RegisterActorsResult");
+    EXPECT_EQ(bulk["registered"], 1);
+    ASSERT_EQ(bulk["failed"].size(), 1u);
+    EXPECT_EQ(bulk["failed"][0]["actor_name"], "a");
+    EXPECT_EQ(bulk["failed"][0]["reason"], "Name already registered");
+
+    auto found = handle_json_request(registry, {{"message_type", "LookupActor"}, {"actor_name", "b"}});
+    EXPECT_EQ(found["message_type"], "LookupResult");
+    EXPECT_EQ(found["endpoint"], "tcp://h:1");
+    EXPECT_EQ(found["online"], true);
+
+    auto missing = handle_json_request(registry, {{"message_type", "LookupActor"}, {"actor_name", "x"}});
+    EXPECT_TRUE(missing["endpoint"].is_null());
+    EXPECT_EQ(missing["online"], false);
+
+    auto ack = handle_json_request(registry, {{"message_type", "Heartbeat"}, {"manager_id", "rs"},
+                                              {"timestamp_ms", 1}, {"interval_ms", 100}});
+    EXPECT_EQ(ack["message_type"], "HeartbeatAck");
+    EXPECT_EQ(registry.heartbeat_timeout("rs"), 300ms);
+
+    auto sub = handle_json_request(registry, {{"message_type", "SubscribeRegistry"}, {"subscriber", "w"},
+                                              {"subscriber_endpoint", "tcp://me:6000"},
+                                              {"actor_names", {"a"}}, {"manager_ids", json::array()}});
+    EXPECT_EQ(sub["message_type"], "SubscriptionOk");
+
+    auto gone = handle_json_request(registry, {{"message_type", "UnregisterActor"}, {"actor_name", "b"}});
+    EXPECT_EQ(gone["message_type"], "RegistrationOk");
+    EXPECT_FALSE(registry.lookup("b").found);
+
+    auto unknown = handle_json_request(registry, {{"message_type", "Bogus"}});
+    EXPECT_EQ(unknown["error"], "Unknown message type: Bogus");
+
+    EXPECT_THROW(handle_json_request(registry, {{"message_type", "LookupActor"}}), json::exception);
+}
@@ -0,0 +1,142 @@
+/*
+ * Tests for Group: members sharing one thread and one mailbox
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "actors/Actor.hpp"
+#include "actors/act/Group.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Shutdown.hpp"
+#include "actors/msg/Start.hpp"
+
+using namespace actors;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Tick : public Message_N<4301> {
+    int n;
+    explicit Tick(int v) : n(v) {}
+};
+
+std::vector<std::string> g_log;   // Written only by the group's thread
+std::atomic<int> g_done{0};
+
+// Logs each Tick and forwards it to next (if any)
+class Stage : public Actor {
+public:
+    Actor* next = nullptr;
+    std::thread::id thread;
+    bool stopped = false;
+
+    explicit Stage(const char* stage_name) {
+        strncpy(name, stage_name, sizeof(name) - 1);
+        MESSAGE_HANDLER(Tick, on_tick);
+        MESSAGE_HANDLER(msg::Shutdown, on_shutdown);
+    }
+
+    void on_tick(const Tick* m) noexcept {
+        thread = std::this_thread::get_id();
+        g_log.push_back(std::string(name) + std::to_string(m->n));
+        if (next)
+            next->send(new Tick(m->n), this);
+        else
+            g_done++;
+    }
+
+    void on_shutdown(const msg::Shutdown*) noexcept { stopped = true; }
+};
+
+// A member that never takes fast_send(), not even for Start
+class AsyncStage : public Stage {
+public:
+    std::atomic<int> starts{0};
+
+    explicit AsyncStage(const char* stage_name) : Stage(stage_name) {
+        dispatch_mode = DispatchMode::ASYNC_ONLY;
+        MESSAGE_HANDLER(msg::Start, on_start);
+    }
+
+    void on_start(const msg::Start*) noexcept { starts++; }
+};
+
+class GroupManager : public Manager {
+public:
+    GroupManager() { strncpy(name, "GroupManager", sizeof(name) - 1); }
+};
+
+bool wait_for(int n) {
+    for (int i = 0; i < 500 && g_done.load() < n; i++)
+        std::this_thread::sleep_for(2ms);
+    return g_done.load() >= n;
+}
+
+} // namespace
+
+TEST(GroupTest, MembersShareThreadAndRunLocalSendsFirst) {
+    g_log.clear();
+    g_done = 0;
+
+    GroupManager mgr;
+    Group grp("pipeline");
+    Stage a("a"), b("b"), c("c");
+    a.next = &b;
+    b.next = &c;
+    grp.add(&a);
+    grp.add(&b);
+    grp.add(&c);
+    mgr.manage(&grp);
+
+    // Members are addressable, the group is the only managed actor
+    EXPECT_EQ(mgr.get_local_actor("b"), &b);
+    EXPECT_NE(b.get_id(), NO_ACTOR_ID);
+    EXPECT_EQ(mgr.get_local_actor(b.get_id()), &b);
+    EXPECT_EQ(mgr.get_managed_actors().size(), 1u);
+
+    mgr.init();
+    a.send(new Tick(1));
+    a.send(new Tick(2));
+    ASSERT_TRUE(wait_for(2));
+
+    // Each tick runs through the whole pipeline before the next is taken
+    std::vector<std::string> expected = {"a1", "b1", "c1", "a2", "b2", "c2"};
+    EXPECT_EQ(g_log, expected);
+    EXPECT_EQ(a.thread, b.thread);
+    EXPECT_EQ(b.thread, c.thread);
+    EXPECT_NE(a.thread, std::this_thread::get_id());
+
+    // Shutdown to a member stops only that member
+    b.send(new msg::Shutdown());
+    a.send(new Tick(3));
+    c.send(new Tick(4));
+    ASSERT_TRUE(wait_for(3));
+    EXPECT_TRUE(b.stopped);
+    EXPECT_FALSE(a.stopped);
+    EXPECT_EQ(g_log.back(), "c4");
+
+    grp.send(new msg::Shutdown());
+    mgr.end();
+    EXPECT_TRUE(a.stopped);
+    EXPECT_TRUE(c.stopped);
+}
+
+TEST(GroupTest, AsyncOnlyMemberGetsStartOnGroupThread) {
+    GroupManager mgr;
+    Group grp("async");
+    AsyncStage a("a");
+    grp.add(&a);
+    mgr.manage(&grp);
+
+    mgr.init();
+    EXPECT_EQ(a.starts.load(), 1);
+    EXPECT_FALSE(a.accepts_fast_send());
+
+    grp.send(new msg::Shutdown());
+    mgr.end();
+    EXPECT_TRUE(a.stopped);
+}
@@ -0,0 +1,122 @@
+/*
+ * Tests for HandlerTable and Actor message dispatch
+ */
+
+#include <gtest/gtest.h>
+#include <climits>
+#include "actors/Actor.hpp"
+#include "actors/HandlerTable.hpp"
+
+using namespace actors;
+
+TEST(HandlerTableTest, EmptyTableMisses) {
+    HandlerTable<int*> t;
+    t.build({});
+    EXPECT_EQ(t.find(0), nullptr);
+    EXPECT_EQ(t.find(INT_MAX), nullptr);
+    EXPECT_EQ(t.slots(), 0u);
+}
+
+TEST(HandlerTableTest, DenseForClusteredIds) {
+    int a, b, c;
+    HandlerTable<int*> t;
+    t.build({{102, &c}, {100, &a}, {101, &b}});
+    EXPECT_TRUE(t.is_dense());
+    EXPECT_EQ(t.slots(), 3u);
+    EXPECT_EQ(t.find(100), &a);
+    EXPECT_EQ(t.find(101), &b);
+    EXPECT_EQ(t.find(102), &c);
+    EXPECT_EQ(t.find(99), nullptr);
+    EXPECT_EQ(t.find(103), nullptr);
+    EXPECT_EQ(t.find(INT_MIN), nullptr);
+}
+
+TEST(HandlerTableTest, SparseForScatteredIds) {
+    int a, b, c;
+    HandlerTable<int*> t;
+    t.build({{5, &a}, {900, &b}, {1 << 30, &c}});
+    EXPECT_FALSE(t.is_dense());
+    EXPECT_EQ(t.slots(), 3u);
+    EXPECT_EQ(t.find(5), &a);
+    EXPECT_EQ(t.find(900), &b);
+    EXPECT_EQ(t.find(1 << 30), &c);
+    EXPECT_EQ(t.find(6), nullptr);
+    EXPECT_EQ(t.find(-1), nullptr);
+}
+
+TEST(HandlerTableTest, NegativeIds) {
+    int a, b;
+    HandlerTable<int*> t;
+    t.build({{-3, &a}, {-1, &b}});
+    EXPECT_EQ(t.find(-3), &a);
+    EXPECT_EQ(t.find(-1), &b);
+    EXPECT_EQ(t.find(-2), nullptr);
+}
+
+struct LowMsg : public Message_N<6000> {};
+struct HighMsg : public Message_N<(1 << 30)> {};
+struct UnhandledMsg : public Message_N<7000> {};
+
+class DispatchActor : public Actor {
+public:
+    int low = 0;
+    int high = 0;
+    int fallback = 0;
+
+    DispatchActor() {
+        MESSAGE_HANDLER(LowMsg, on_low);
+        MESSAGE_HANDLER(HighMsg, on_high);
+    }
+
+    void on_low(const LowMsg*) noexcept { low++; }
+    void on_high(const HighMsg*) noexcept { high++; }
+
+protected:
+    void process_message(const Message*) override { fallback++; }
+};
+
+class CurrentActor : public Actor {
+public:
+    const Message* seen = nullptr;
+
+    CurrentActor() {
+        MESSAGE_HANDLER(LowMsg, on_low);
+    }
+
+    void on_low(const LowMsg*) noexcept { seen = current_message(); }
+};
+
+TEST(HandlerTableTest, CurrentMessageDuringHandler) {
+    CurrentActor actor;
+    LowMsg low;
+    EXPECT_EQ(actor.current_message(), nullptr);
+    actor.fast_send(&low, nullptr);
+    EXPECT_EQ(actor.seen, &low);
+    EXPECT_EQ(actor.current_message(), nullptr);
+}
+
+TEST(HandlerTableTest, ActorDispatchesLargeIds) {
+    // IDs beyond the old 2048-entry cache must dispatch safely
+    DispatchActor actor;
+    LowMsg low;
+    HighMsg high;
+    UnhandledMsg other;
+
+    actor.fast_send(&low, nullptr);
+    actor.fast_send(&high, nullptr);
+    actor.fast_send(&high, nullptr);
+    actor.fast_send(&other, nullptr);
+
+    EXPECT_EQ(actor.low, 1);
+    EXPECT_EQ(actor.high, 2);
+    EXPECT_EQ(actor.fallback, 1);
+}
+
+TEST(HandlerTableTest, MessageHeaderId) {
+    LowMsg m;
+    EXPECT_EQ(m.id(), 6000);
+    EXPECT_EQ(m.id(), m.get_message_id());
+
+    LowMsg copy(m);
+    EXPECT_EQ(copy.id(), 6000);
+}
@@ -0,0 +1,204 @@
+/*
+ * Tests for the message journal and its replay driver
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include "actors/Actor.hpp"
+#include "actors/Journal.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/remote/Serialization.hpp"
+
+using namespace actors;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Tick : public Message_N<4951> {
+    int value = 0;
+    std::string note;
+    Tick() = default;
+    Tick(int v, std::string n) : value(v), note(std::move(n)) {}
+};
+
+struct Unjournaled : public Message_N<4952> {};  // No binary codec
+
+class Recorder : public Actor {
+public:
+    std::vector<int> values;
+    std::atomic<int> ticks{0};
+
+    explicit Recorder(const char* n) {
+        strncpy(name, n, sizeof(name) - 1);
+        MESSAGE_HANDLER(Tick, on_tick);
+        MESSAGE_HANDLER(Unjournaled, on_other);
+    }
+    void on_tick(const Tick* m) noexcept {
+        values.push_back(m->value);
+        ticks++;
+    }
+    void on_other(const Unjournaled*) noexcept {}
+};
+
+class JournalManager : public Manager {
+public:
+    JournalManager() { strncpy(name, "JournalManager", sizeof(name) - 1); }
+};
+
+// Fresh directory under the gtest temp dir, removed again on destruction
+struct TempDir {
+    std::string path;
+    explicit TempDir(const char* n) : path(testing::TempDir() + n) {
+        std::filesystem::remove_all(path);
+    }
+    ~TempDir() { std::filesystem::remove_all(path); }
+};
+
+void wait_for(const std::atomic<int>& n, int want) {
+    for (int i = 0; i < 2000 && n < want; i++)
+        std::this_thread::sleep_for(1ms);
+}
+
+}  // namespace
+
+REGISTER_REMOTE_MESSAGE_2(Tick, value, int, note, std::string)
+
+TEST(JournalTest, RecordsAndReadsBack) {
+    TempDir dir("journal_basic");
+    {
+        Journal j(dir.path, "a");
+        Tick t1(1, "one"), t2(2, "two");
+        Unjournaled u;
+        EXPECT_TRUE(j.append(&t1));
+        EXPECT_FALSE(j.append(&u));
+        EXPECT_TRUE(j.append(&t2));
+        EXPECT_EQ(j.recorded(), 2u);
+        EXPECT_EQ(j.skipped(), 1u);
+        EXPECT_TRUE(j.sync());
+    }
+
+    JournalReader r(dir.path, "a");
+    JournalReader::Entry e;
+    ASSERT_TRUE(r.next(e));
+    EXPECT_EQ(e.seq, 1u);
+    EXPECT_EQ(e.msg_id, 4951);
+    auto* t = dynamic_cast<const Tick*>(e.msg.get());
+    ASSERT_NE(t, nullptr);
+    EXPECT_EQ(t->value, 1);
+    EXPECT_EQ(t->note, "one");
+    std::uint64_t first_ns = e.time_ns;
+
+    ASSERT_TRUE(r.next(e));
+    EXPECT_EQ(e.seq, 2u);
+    EXPECT_GE(e.time_ns, first_ns);
+    EXPECT_EQ(static_cast<const Tick*>(e.msg.get())->note, "two");
+    EXPECT_FALSE(r.next(e));
+
+    EXPECT_THROW(JournalReader(dir.path, "missing"), std::runtime_error);
+}
+
+TEST(JournalTest, RotatesSegmentsAndContinues) {
+    TempDir dir("journal_rotate");
+    {
+        Journal j(dir.path, "a", 256);
+        for (int i = 0; i < 40; i++) {
+            Tick t(i, "x");
+            ASSERT_TRUE(j.append(&t));
+        }
+        // Bigger than a whole segment: gets one of its own
+        Tick big(40, std::string(1000, 'b'));
+        ASSERT_TRUE(j.append(&big));
+    }
+    EXPECT_GT(journal::segments(dir.path, "a").size(), 4u);
+    {
+        Journal again(dir.path, "a", 256);
+        EXPECT_EQ(again.next_seq(), 42u);
+        Tick t(41, "y");
+        ASSERT_TRUE(again.append(&t));
+    }
+
+    JournalReader r(dir.path, "a");
+    JournalReader::Entry e;
+    int n = 0;
+    while (r.next(e)) {
+        EXPECT_EQ(e.seq, std::uint64_t(n + 1));
+        EXPECT_EQ(static_cast<const Tick*>(e.msg.get())->value, n);
+        n++;
+    }
+    EXPECT_EQ(n, 42);
+}
+
+TEST(JournalTest, ActorJournalReplaysIntoFreshActor) {
+    TempDir dir("journal_actor");
+    {
+        Journal j(dir.path, "rec");
+        JournalManager mgr;
+        auto* rec = new Recorder("Rec");
+        rec->set_journal(&j);
+        mgr.manage(rec);
+        mgr.init();
+        for (int i = 0; i < 100; i++) {
+            rec->send(new Tick(i, "v"), nullptr);
+            if (i % 10 == 0)
+                rec->send(new Unjournaled(), nullptr);
+        }
+        wait_for(rec->ticks, 100);
+        mgr.shutdown(1s);
+        mgr.end();
+        EXPECT_EQ(j.recorded(), 100u);
+        EXPECT_GE(j.skipped(), 10u);  // Also Start and Shutdown
+        delete rec;
+    }
+
+    JournalManager mgr;
+    auto* copy = new Recorder("Copy");
+    mgr.manage(copy);
+    mgr.init();
+    JournalReader r(dir.path, "rec");
+    EXPECT_EQ(replay(r, copy), 100u);
+    wait_for(copy->ticks, 100);
+    mgr.shutdown(1s);
+    mgr.end();
+
+    ASSERT_EQ(copy->values.size(), 100u);
+    for (int i = 0; i < 100; i++)
+        EXPECT_EQ(copy->values[i], i);
+    delete copy;
+}
+
+TEST(JournalTest, ReplayAtRecordedSpeedKeepsGaps) {
+    TempDir dir("journal_speed");
+    {
+        Journal j(dir.path, "a");
+        Tick t1(1, ""), t2(2, "");
+        j.append(&t1);
+        std::this_thread::sleep_for(40ms);
+        j.append(&t2);
+    }
+
+    JournalManager mgr;
+    auto* rec = new Recorder("Paced");
+    mgr.manage(rec);
+    mgr.init();
+
+    JournalReader fast(dir.path, "a");
+    auto t0 = std::chrono::steady_clock::now();
+    EXPECT_EQ(replay(fast, rec, ReplaySpeed::MAX), 2u);
+    EXPECT_LT(std::chrono::steady_clock::now() - t0, 30ms);
+
+    JournalReader paced(dir.path, "a");
+    t0 = std::chrono::steady_clock::now();
+    EXPECT_EQ(replay(paced, rec, ReplaySpeed::RECORDED), 2u);
+    EXPECT_GE(std::chrono::steady_clock::now() - t0, 35ms);
+
+    wait_for(rec->ticks, 4);
+    mgr.shutdown(1s);
+    mgr.end();
+    EXPECT_EQ(rec->ticks, 4);
+    delete rec;
+}
@@ -0,0 +1,90 @@
+/*
+ * Tests for latency histograms and instrumentation
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "actors/Actor.hpp"
+#include "actors/Latency.hpp"
+
+using namespace actors;
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    for (std::uint64_t v = 0; v < 32; v++) {
+        int i = LatencyHistogram::index(v);
+        EXPECT_EQ(LatencyHistogram::upper(i), v);
+    }
+}
+
+TEST(LatencyHistogramTest, BucketsWithinPrecision) {
+    for (std::uint64_t v = 1; v < (std::uint64_t(1) << 39); v = v * 3 + 7) {
+        int i = LatencyHistogram::index(v);
+        ASSERT_LT(i, LatencyHistogram::BUCKETS);
+        std::uint64_t up = LatencyHistogram::upper(i);
+        EXPECT_GE(up, v);
+        EXPECT_LE(double(up - v), double(v) / LatencyHistogram::SUB);
+    }
+    // Beyond the tracked range everything shares the last bucket
+    EXPECT_EQ(LatencyHistogram::index(UINT64_MAX), LatencyHistogram::BUCKETS - 1);
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+    LatencyHistogram h;
+    EXPECT_EQ(h.summary(1.0).count, 0u);
+
+    for (int v = 1; v <= 1000; v++)
+        h.record(v);
+    auto s = h.summary(1.0);
+    EXPECT_EQ(s.count, 1000u);
+    EXPECT_DOUBLE_EQ(s.min, 1.0);
+    EXPECT_DOUBLE_EQ(s.max, 1000.0);
+    EXPECT_NEAR(s.mean, 500.5, 0.01);
+    EXPECT_NEAR(s.p50, 500, 500 / 16.0 + 1);
+    EXPECT_NEAR(s.p90, 900, 900 / 16.0 + 1);
+    EXPECT_NEAR(s.p99, 990, 990 / 16.0 + 1);
+    EXPECT_LE(s.p999, s.max);
+
+    // ns_per_tick scales everything
+    auto scaled = h.summary(2.0);
+    EXPECT_DOUBLE_EQ(scaled.max, 2000.0);
+}
+
+TEST(LatencyHistogramTest, TscAdvances) {
+    auto a = read_tsc();
+    auto b = read_tsc();
+    EXPECT_GE(b, a);
+    EXPECT_GT(tsc_ns_per_tick(), 0.0);
+}
+
+namespace {
+
+struct Ping : public Message_N<4301> {};
+
+class Timed : public Actor {
+public:
+    Timed() {
+        latency_by_id = true;
+        MESSAGE_HANDLER(Ping, on_ping);
+    }
+    void on_ping(const Ping*) noexcept {}
+};
+
+}  // namespace
+
+TEST(LatencyTest, FastSendRecordsHandlerTime) {
+    Timed actor;
+    Ping p;
+    actor.fast_send(&p, nullptr);
+    actor.fast_send(&p, nullptr);
+
+#ifdef ACTOR_LATENCY
+    ASSERT_NE(actor.latency(), nullptr);
+    EXPECT_EQ(actor.latency()->handler.count(), 2u);
+    EXPECT_EQ(actor.latency()->queue_wait.count(), 0u);
+    auto by_id = actor.latency()->report_by_id(1.0);
+    ASSERT_EQ(by_id.count(4301), 1u);
+    EXPECT_EQ(by_id[4301].handler.count, 2u);
+#else
+    EXPECT_EQ(actor.latency(), nullptr);  // compiled out
+#endif
+}
@@ -0,0 +1,150 @@
+/*
+ * Tests for Manager startup barrier and drain-with-deadline shutdown
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Start.hpp"
+
+using namespace actors;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Work : public Message_N<4941> {};
+struct Burst : public Message_N<4942> {
+    int count;
+    explicit Burst(int n) : count(n) {}
+};
+
+std::atomic<int> inits{0};
+
+class Worker : public Actor {
+public:
+    Actor* next = nullptr;
+    Manager* mgr = nullptr;
+    std::chrono::milliseconds cost{0};
+    std::atomic<int> worked{0};
+    int inits_at_start = -1;
+
+    explicit Worker(const char* n) {
+        strncpy(name, n, sizeof(name) - 1);
+        MESSAGE_HANDLER(msg::Start, on_start);
+        MESSAGE_HANDLER(Work, on_work);
+        MESSAGE_HANDLER(Burst, on_burst);
+    }
+
+    void init() override {
+        std::this_thread::sleep_for(5ms);
+        inits++;
+    }
+    void on_start(const msg::Start*) noexcept { inits_at_start = inits; }
+    void on_work(const Work*) noexcept {
+        if (cost.count())
+            std::this_thread::sleep_for(cost);
+        worked++;
+    }
+    // Hand out work, then ask for shutdown while it is still queued
+    void on_burst(const Burst* m) noexcept {
+        for (int i = 0; i < m->count; i++)
+            next->send(new Work(), this);
+        mgr->terminate();
+    }
+};
+
+class LifecycleManager : public Manager {
+public:
+    LifecycleManager() { strncpy(name, "LifecycleManager", sizeof(name) - 1); }
+};
+
+}  // namespace
+
+TEST(LifecycleTest, StartWaitsForEveryActor) {
+    inits = 0;
+    LifecycleManager mgr;
+    std::vector<Worker*> workers;
+    for (const char* n : {"W1", "W2", "W3", "W4"}) {
+        workers.push_back(new Worker(n));
+        mgr.manage(workers.back());
+    }
+    mgr.init();
+
+    // init() returned after every Start was handled, each after every init()
+    for (auto* w : workers)
+        EXPECT_EQ(w->inits_at_start, 4);
+    EXPECT_GT(mgr.lifecycle().ready.count(), 0);
+
+    mgr.shutdown(1s);
+    EXPECT_TRUE(mgr.lifecycle().drained);
+    mgr.end();  // Already stopped: returns at once
+    for (auto* w : workers)
+        delete w;
+}
+
+TEST(LifecycleTest, TerminateDrainsInFlightWork) {
+    LifecycleManager mgr;
+    auto* producer = new Worker("Producer");
+    auto* consumer = new Worker("Consumer");
+    producer->next = consumer;
+    producer->mgr = &mgr;
+    consumer->cost = 1ms;
+    mgr.manage(producer);
+    mgr.manage(consumer);
+    mgr.init();
+
+    producer->send(new Burst(50));
+    mgr.end();  // Woken by terminate(); drains before stopping
+
+    EXPECT_EQ(consumer->worked, 50);
+    EXPECT_TRUE(mgr.lifecycle().drained);
+    EXPECT_EQ(mgr.lifecycle().discarded, 0u);
+    delete producer;
+    delete consumer;
+}
+
+TEST(LifecycleTest, DeadlineDiscardsBacklog) {
+    LifecycleManager mgr;
+    auto* slow = new Worker("Slow");
+    slow->cost = 5ms;
+    mgr.manage(slow);
+    mgr.init();
+
+    for (int i = 0; i < 100; i++)
+        slow->send(new Work());
+    mgr.shutdown(20ms);
+
+    const LifecycleReport& report = mgr.lifecycle();
+    EXPECT_FALSE(report.drained);
+    EXPECT_GT(report.discarded, 0u);
+    EXPECT_LT(slow->worked, 100);
+    EXPECT_LT(report.join, 1s);
+    delete slow;
+}
+
+TEST(LifecycleTest, DrainRefusesOutsideSenders) {
+    LifecycleManager mgr;
+    auto* sink = new Worker("Sink");
+    mgr.manage(sink);
+    mgr.init();
+
+    std::atomic<bool> stop{false};
+    std::thread outside([&]() {
+        while (!stop) {
+            sink->send(new Work());
+            std::this_thread::sleep_for(20us);
+        }
+    });
+    std::this_thread::sleep_for(10ms);
+    mgr.shutdown(1s);
+    stop = true;
+    outside.join();
+
+    EXPECT_TRUE(mgr.lifecycle().drained);
+    EXPECT_GT(sink->counters().dropped.load(), 0u);
+    delete sink;
+}
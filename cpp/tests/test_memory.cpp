@@ -0,0 +1,128 @@
+/*
+ * Tests for huge-page rings, prefaulting and Manager's MemoryMode::LOCKED
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "actors/Actor.hpp"
+#include "actors/MPSCQueue.hpp"
+#include "actors/Memory.hpp"
+#include "actors/act/Manager.hpp"
+
+using namespace actors;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Poke : public Message_N<4971> {};
+
+class Poked : public Actor {
+public:
+    std::atomic<int> pokes{0};
+
+    explicit Poked(const char* n) {
+        strncpy(name, n, sizeof(name) - 1);
+        MESSAGE_HANDLER(Poke, on_poke);
+    }
+    void on_poke(const Poke*) noexcept { pokes++; }
+};
+
+class LockedManager : public Manager {
+public:
+    LockedManager() { strncpy(name, "LockedManager", sizeof(name) - 1); }
+};
+
+// Turns huge pages on for one test, and off again after it
+struct HugePages {
+    HugePages() { memory::set_huge_pages(true); }
+    ~HugePages() { memory::set_huge_pages(false); }
+};
+
+}  // namespace
+
+TEST(MemoryTest, PageArrayUsesWholeHugePages) {
+    const std::size_t huge = memory::huge_page_size();
+    const std::size_t before = memory::huge_bytes();
+    {
+        HugePages on;
+        PageArray<std::uint64_t> a(1000);
+        EXPECT_TRUE(a.on_huge_pages());
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a.data()) % huge, 0u);
+        EXPECT_EQ(memory::huge_bytes(), before + huge);
+        for (std::size_t i = 0; i < 1000; i++)
+            a[i] = i;
+        EXPECT_EQ(a[999], 999u);
+    }
+    EXPECT_EQ(memory::huge_bytes(), before);
+
+    PageArray<std::uint64_t> heap(10);
+    EXPECT_FALSE(heap.on_huge_pages());
+    EXPECT_EQ(heap.bytes(), 80u);
+}
+
+TEST(MemoryTest, RingsGoOnHugePagesWhenEnabled) {
+    HugePages on;
+    MPSCQueue<int> q(64);
+    auto ring = q.storage();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ring.first) % memory::huge_page_size(), 0u);
+    EXPECT_GE(ring.second, 64 * sizeof(int));
+
+    q.push(7);
+    EXPECT_EQ(std::get<0>(q.pop()), 7);
+}
+
+TEST(MemoryTest, PrefaultKeepsContents) {
+    std::vector<char> buf(3 * 4096 + 100);
+    for (std::size_t i = 0; i < buf.size(); i++)
+        buf[i] = char(i * 7);
+    EXPECT_EQ(memory::prefault(buf.data() + 1, buf.size() - 1), buf.size() - 1);
+    for (std::size_t i = 0; i < buf.size(); i++)
+        ASSERT_EQ(buf[i], char(i * 7));
+    EXPECT_EQ(memory::prefault(nullptr, 10), 0u);
+}
+
+TEST(MemoryTest, SlabsComeFromTheArena) {
+    HugePages on;
+    EXPECT_GT(memory::reserve_slabs(), 0u);
+    auto* a = static_cast<char*>(memory::slab(100, 64));
+    auto* b = static_cast<char*>(memory::slab(100, 64));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(a) % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 64, 0u);
+    EXPECT_EQ(b - a, 128);  // Carved back to back
+}
+
+TEST(MemoryTest, LockedModePrefaultsAndReports) {
+    LockedManager mgr;
+    mgr.set_memory_mode(MemoryMode::LOCKED);
+    auto* spsc = new Poked("Spsc");
+    auto* blocking = new Poked("Blocking");
+    mgr.manage(spsc, {}, 0, SCHED_OTHER, MailboxType::SPSC, 1024);
+    mgr.manage(blocking);
+    mgr.init();
+
+    const MemoryReport& r = mgr.memory_report();
+    EXPECT_EQ(r.stack_bytes, 2u * ACTOR_PREFAULT_STACK_BYTES);
+    EXPECT_GE(r.mailbox_bytes, 1024 * sizeof(Delivery));
+    EXPECT_GT(r.pool_bytes, 0u);
+    EXPECT_GE(r.huge_bytes, memory::huge_page_size());
+    if (r.locked) {
+        EXPECT_GT(r.locked_bytes, 0u);
+    } else {
+        EXPECT_NE(r.lock_error, 0);  // Unprivileged: prefaulted but not locked
+    }
+
+    spsc->send(new Poke());
+    blocking->send(new Poke());
+    mgr.shutdown(1s);
+    EXPECT_EQ(spsc->pokes, 1);
+    EXPECT_EQ(blocking->pokes, 1);
+    if (r.locked) {
+        EXPECT_EQ(memory::locked_bytes(), 0u);  // Unlocked after the join
+    }
+    mgr.set_memory_mode(MemoryMode::DEFAULT);
+    delete spsc;
+    delete blocking;
+}
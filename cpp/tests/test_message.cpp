@@ -40,10 +40,8 @@ TEST(MessageTest, MessageWithData) {
 
 TEST(MessageTest, MessageDefaultFields) {
     TestMessage msg;
-    EXPECT_EQ(msg.sender, nullptr);
-    EXPECT_EQ(msg.destination, nullptr);
-    EXPECT_FALSE(msg.is_fast);
-    EXPECT_FALSE(msg.last);
+    EXPECT_FALSE(msg.is_shared());
+    EXPECT_EQ(msg.id(), 100);
 }
 
 TEST(MessageTest, StartMessageId) {
@@ -68,14 +66,12 @@ TEST(MessageTest, TimeoutWithData) {
 }
 
 TEST(MessageTest, MessageCopy) {
-    TestMessage original(42);
-    original.is_fast = true;
-    original.last = true;
+    auto original = make_shared_message<TestMessage>(42);
 
-    TestMessage copy(original);
+    TestMessage copy(*original);
     EXPECT_EQ(copy.value, 42);
-    EXPECT_EQ(copy.is_fast, true);
-    EXPECT_EQ(copy.last, true);
-    // destination should be reset on copy
-    EXPECT_EQ(copy.destination, nullptr);
+    EXPECT_EQ(copy.id(), 100);
+    // A copy of a shared message is a plain one
+    EXPECT_TRUE(original->is_shared());
+    EXPECT_FALSE(copy.is_shared());
 }
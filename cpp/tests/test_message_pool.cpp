@@ -0,0 +1,111 @@
+/*
+ * Tests for pooled message allocation
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "actors/MessagePool.hpp"
+
+using namespace actors;
+
+struct PooledPing : public PooledMessage_N<PooledPing, 300> {
+    int count;
+    PooledPing(int c = 0) : count(c) {}
+};
+
+struct BigPooledPing : public PooledPing {
+    char payload[128];
+};
+
+struct CrossThreadMsg : public PooledMessage_N<CrossThreadMsg, 301> {
+    long value;
+    CrossThreadMsg(long v = 0) : value(v) {}
+};
+
+TEST(MessagePoolTest, MessageIdUnchanged) {
+    PooledPing msg(3);
+    EXPECT_EQ(msg.get_message_id(), 300);
+    EXPECT_EQ(msg.count, 3);
+}
+
+TEST(MessagePoolTest, ReusesFreedBlock) {
+    const Message* a = new PooledPing(1);
+    delete a;
+    const Message* b = new PooledPing(2);
+    EXPECT_EQ(a, b);  // LIFO free list hands back the same block
+    delete b;
+}
+
+TEST(MessagePoolTest, CountsHitsAndMisses) {
+    auto before = PooledPing::pool_stats();
+    std::vector<const Message*> msgs;
+    for (int i = 0; i < 10; i++) {
+        msgs.push_back(new PooledPing(i));
+    }
+    for (auto* m : msgs) {
+        delete m;
+    }
+
+    // Force the thread-local hit counter to publish by draining the cache
+    std::vector<const Message*> drain;
+    for (int i = 0; i < 3 * ACTOR_POOL_BATCH; i++) {
+        drain.push_back(new PooledPing(i));
+    }
+    for (auto* m : drain) {
+        delete m;
+    }
+
+    auto after = PooledPing::pool_stats();
+    EXPECT_GT(after.hits, before.hits);
+    EXPECT_GT(after.misses, before.misses);
+    EXPECT_GE(after.blocks, 3u * ACTOR_POOL_BATCH);
+    EXPECT_GE(after.block_size, sizeof(PooledPing));
+}
+
+TEST(MessagePoolTest, DerivedTypeFallsBackToHeap) {
+    auto before = PooledPing::pool_stats();
+    const Message* m = new BigPooledPing();
+    delete m;
+    auto after = PooledPing::pool_stats();
+    EXPECT_EQ(after.misses, before.misses);
+    EXPECT_EQ(after.blocks, before.blocks);
+}
+
+TEST(MessagePoolTest, CrossThreadReturn) {
+    // Allocate on one thread, free on another, like sender -> receiver
+    const int count = 10 * ACTOR_POOL_BATCH;
+    std::vector<const Message*> msgs(count);
+
+    std::thread producer([&msgs, count]() {
+        for (int i = 0; i < count; i++) {
+            msgs[i] = new CrossThreadMsg(i);
+        }
+    });
+    producer.join();
+
+    for (int i = 0; i < count; i++) {
+        EXPECT_EQ(static_cast<const CrossThreadMsg*>(msgs[i])->value, i);
+        delete msgs[i];
+    }
+
+    auto stats = CrossThreadMsg::pool_stats();
+    EXPECT_GE(stats.returns, 1u);  // freed blocks went back to the depot
+
+    // The depot feeds the next allocations instead of new slabs
+    auto blocks = stats.blocks;
+    std::vector<const Message*> again;
+    for (int i = 0; i < count; i++) {
+        again.push_back(new CrossThreadMsg(i));
+    }
+    for (auto* m : again) {
+        delete m;
+    }
+    EXPECT_EQ(CrossThreadMsg::pool_stats().blocks, blocks);
+}
+
+TEST(MessagePoolTest, StatsDirectory) {
+    delete new PooledPing(1);
+    auto all = message_pool_stats();
+    EXPECT_NE(all.find(typeid(PooledPing).name()), all.end());
+}
@@ -0,0 +1,152 @@
+/*
+ * Tests for per-actor counters and the Prometheus metrics exporter
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/act/MetricsExporter.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+using namespace actors;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Job : public Message_N<4911> {};
+
+class Worker : public Actor {
+public:
+    std::atomic<bool> gate{true};
+
+    explicit Worker(const char* n) {
+        strncpy(name, n, sizeof(name) - 1);
+        MESSAGE_HANDLER(Job, on_job);
+    }
+    void on_job(const Job*) noexcept {
+        while (!gate.load())
+            std::this_thread::yield();
+    }
+};
+
+class MetricsManager : public Manager {
+public:
+    MetricsManager() { strncpy(name, "MetricsManager", sizeof(name) - 1); }
+};
+
+bool wait_for(const std::function<bool()>& done) {
+    for (int i = 0; i < 500 && !done(); i++)
+        std::this_thread::sleep_for(10ms);
+    return done();
+}
+
+std::string http_get(std::uint16_t port, const std::string& path) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0) {
+        ::close(fd);
+        return "";
+    }
+    std::string req = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    ::send(fd, req.data(), req.size(), 0);
+    std::string out;
+    char buf[4096];
+    ssize_t n;
+    while ((n = ::recv(fd, buf, sizeof buf, 0)) > 0)
+        out.append(buf, size_t(n));
+    ::close(fd);
+    return out;
+}
+
+}  // namespace
+
+TEST(MetricsTest, SplitsDropsFromRejects) {
+    Worker drop("Dropper");
+    Worker reject("Rejecter");
+    drop.set_mailbox_limit(2, OverflowPolicy::DROP_NEWEST);
+    reject.set_mailbox_limit(1, OverflowPolicy::REJECT);
+
+    for (int i = 0; i < 5; i++) {
+        drop.send(new Job());
+        reject.send(new Job());
+    }
+
+    EXPECT_EQ(drop.counters().dropped.load(), 3u);
+    EXPECT_EQ(drop.counters().rejected.load(), 0u);
+    EXPECT_EQ(reject.rejected_count(), 4u);
+    EXPECT_EQ(reject.counters().dropped.load(), 0u);
+    EXPECT_EQ(reject.dropped_count(), 4u);  // Still counts both
+}
+
+TEST(MetricsTest, CountsMessagesAndHighWater) {
+    MetricsManager mgr;
+    auto* w = new Worker("Counted");
+    mgr.manage(w);
+    w->gate = false;
+    mgr.init();
+
+    w->send(new Job());  // Blocks the handler
+    ASSERT_TRUE(wait_for([&] { return w->queue_length() == 0; }));
+    for (int i = 0; i < 9; i++)
+        w->send(new Job());
+    w->gate = true;
+    ASSERT_TRUE(wait_for([&] { return w->message_count() >= 11; }));  // Start + 10 jobs
+
+    auto m = mgr.get_metrics()["Counted"];
+    EXPECT_EQ(m.messages, 11u);
+    EXPECT_EQ(m.queue_high_water, 9u);
+    EXPECT_EQ(m.queue_length, 0u);
+    EXPECT_EQ(m.dropped, 0u);
+    EXPECT_EQ(m.id, w->get_id());
+    EXPECT_EQ(std::get<1>(mgr.get_message_counts()["Counted"]), 11u);
+
+    w->send(new msg::Shutdown());
+    mgr.end();
+    delete w;
+}
+
+TEST(MetricsExporterTest, RendersPrometheusText) {
+    ActorMetrics m;
+    m.messages = 7;
+    m.queue_high_water = 3;
+    std::string text = MetricsExporter::render({{"a \"b\"", m}});
+    EXPECT_NE(text.find("# TYPE actors_messages_total counter\n"), std::string::npos);
+    EXPECT_NE(text.find("actors_messages_total{actor=\"a \\\"b\\\"\"} 7\n"), std::string::npos);
+    EXPECT_NE(text.find("actors_queue_high_water{actor=\"a \\\"b\\\"\"} 3\n"), std::string::npos);
+}
+
+TEST(MetricsExporterTest, ServesScrapes) {
+    MetricsManager mgr;
+    auto* w = new Worker("Scraped");
+    auto* exporter = new MetricsExporter(mgr, 0, "Exporter", "127.0.0.1");
+    ASSERT_NE(exporter->port(), 0);
+    mgr.manage(w);
+    mgr.manage(exporter);
+    mgr.init();
+
+    for (int i = 0; i < 4; i++)
+        w->send(new Job());
+    ASSERT_TRUE(wait_for([&] { return w->message_count() >= 5; }));
+
+    std::string page = http_get(exporter->port(), "/metrics");
+    EXPECT_EQ(page.rfind("HTTP/1.1 200 OK\r\n", 0), 0u);
+    EXPECT_NE(page.find("actors_messages_total{actor=\"Scraped\"} 5\n"), std::string::npos);
+    EXPECT_EQ(http_get(exporter->port(), "/nope").rfind("HTTP/1.1 404", 0), 0u);
+
+    w->send(new msg::Shutdown());
+    exporter->send(new msg::Shutdown());
+    mgr.end();
+    delete w;
+    delete exporter;
+}
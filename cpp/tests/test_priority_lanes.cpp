@@ -0,0 +1,167 @@
+/*
+ * Tests for priority lanes (LaneQueue, MailboxType::PRIORITY)
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "actors/LaneQueue.hpp"
+#include "actors/Actor.hpp"
+#include "actors/ActorRef.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Shutdown.hpp"
+#include "actors/msg/Timeout.hpp"
+
+using namespace actors;
+
+namespace {
+
+// (lane, value)
+using Item = std::pair<std::size_t, int>;
+
+LaneQueue<Item, 3> make_queue() {
+    return LaneQueue<Item, 3>(16, [](const Item& x) { return x.first; });
+}
+
+struct Data : public Message_N<4801> {
+    int n;
+    explicit Data(int v) : n(v) {}
+};
+
+struct Kill : public Message_N<4802> {};
+
+class Risk : public Actor {
+public:
+    std::vector<std::string> seen;
+    std::atomic<bool> gate{true};
+
+    Risk() {
+        strncpy(name, "Risk", sizeof(name) - 1);
+        MESSAGE_HANDLER(Data, on_data);
+        MESSAGE_HANDLER(Kill, on_kill);
+        set_lane<Kill>(Lane::CONTROL);
+    }
+
+    void on_data(const Data* m) noexcept {
+        while (!gate.load())
+            std::this_thread::yield();
+        seen.push_back("D" + std::to_string(m->n));
+    }
+    void on_kill(const Kill*) noexcept { seen.push_back("K"); }
+};
+
+class RiskManager : public Manager {
+public:
+    RiskManager() { strncpy(name, "RiskManager", sizeof(name) - 1); }
+};
+
+}  // namespace
+
+TEST(LaneQueueTest, DrainsHighestLaneFirst) {
+    auto q = make_queue();
+    q.push({0, 1});
+    q.push({1, 2});
+    q.push({0, 3});
+    q.push({2, 4});
+    q.push({1, 5});
+    EXPECT_EQ(q.length(), 5u);
+    EXPECT_EQ(q.length(0), 2u);
+    EXPECT_EQ(q.length(2), 1u);
+    EXPECT_EQ(q.peek(), Item(2, 4));
+
+    Item out[8];
+    bool last = false;
+    ASSERT_EQ(q.try_pop_batch(out, 3, last), 3u);
+    EXPECT_FALSE(last);
+    EXPECT_EQ(out[0], Item(2, 4));
+    EXPECT_EQ(out[1], Item(1, 2));
+    EXPECT_EQ(out[2], Item(1, 5));
+
+    q.push({2, 6});  // arrives later but still goes first
+    EXPECT_EQ(std::get<0>(q.pop()), Item(2, 6));
+    EXPECT_EQ(std::get<0>(q.pop()), Item(0, 1));
+    auto [item, was_last] = q.pop();
+    EXPECT_EQ(item, Item(0, 3));
+    EXPECT_TRUE(was_last);
+}
+
+TEST(LaneQueueTest, EvictsFromLowestLane) {
+    auto q = make_queue();
+    q.push({2, 1});
+    q.push({0, 2});
+    q.push({1, 3});
+    Item evicted{};
+    bool queued = false;
+    EXPECT_TRUE(q.push_evict({1, 4}, 3, evicted, queued));
+    EXPECT_TRUE(queued);
+    EXPECT_EQ(evicted, Item(0, 2));
+    EXPECT_FALSE(q.try_push({2, 5}, 3));
+    EXPECT_EQ(q.length(0), 0u);
+    EXPECT_EQ(q.length(1), 2u);
+}
+
+TEST(PriorityMailboxTest, ControlBypassesBacklog) {
+    RiskManager mgr;
+    auto* risk = new Risk();
+    mgr.manage(risk, {}, 0, SCHED_OTHER, MailboxType::PRIORITY);
+
+    for (int i = 0; i < 5; i++)
+        risk->send(new Data(i));
+    risk->send(new Kill());
+    ActorRef(risk).send(new Data(99), Lane::HIGH);
+    risk->send_lane(new Data(-1), Lane::LOW);
+
+    EXPECT_EQ(risk->queue_length(), 8u);
+    EXPECT_EQ(risk->queue_length(Lane::CONTROL), 1u);
+    EXPECT_EQ(risk->queue_length(Lane::NORMAL), 5u);
+    auto lengths = mgr.get_queue_lengths(Lane::HIGH);
+    EXPECT_EQ(lengths["Risk"], 1u);
+    EXPECT_EQ(mgr.get_queue_lengths()["Risk"], 8u);
+
+    risk->send(new msg::Shutdown());
+    mgr.init();  // Start goes in CONTROL behind Kill and Shutdown
+    mgr.end();
+
+    // Shutdown overtook everything but the messages ahead of it in CONTROL
+    std::vector<std::string> expected = {"K"};
+    EXPECT_EQ(risk->seen, expected);
+    delete risk;
+}
+
+TEST(PriorityMailboxTest, RunningActorTakesControlNext) {
+    RiskManager mgr;
+    auto* risk = new Risk();
+    risk->set_mailbox_limit(4, OverflowPolicy::DROP_NEWEST);
+    risk->gate = false;  // hold the actor in its first handler
+    mgr.manage(risk, {}, 0, SCHED_OTHER, MailboxType::PRIORITY);
+    mgr.init();
+
+    risk->send(new Data(0));
+    while (risk->queue_length() != 0)
+        std::this_thread::yield();
+    for (int i = 1; i <= 10; i++)
+        risk->send(new Data(i));
+    EXPECT_EQ(risk->dropped_count(), 6u);
+    risk->send(new Kill());  // CONTROL ignores the limit
+    EXPECT_EQ(risk->queue_length(), 5u);
+
+    risk->gate = true;
+    risk->send(new msg::Shutdown());
+    mgr.end();
+
+    std::vector<std::string> expected = {"D0", "K"};
+    EXPECT_EQ(risk->seen, expected);
+    delete risk;
+}
+
+TEST(PriorityMailboxTest, OtherMailboxesIgnoreLanes) {
+    Risk risk;
+    risk.send(new Kill());
+    risk.send_lane(new Data(1), Lane::CONTROL);
+    EXPECT_EQ(risk.queue_length(Lane::NORMAL), 2u);
+    EXPECT_EQ(risk.queue_length(Lane::CONTROL), 0u);
+    EXPECT_EQ(risk.peek()->get_message_id(), Kill::message_id);
+}
@@ -0,0 +1,110 @@
+/*
+ * Tests for ProxyCache (reply proxy LRU)
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include "actors/remote/ProxyCache.hpp"
+
+using namespace actors;
+
+namespace {
+
+struct FakeProxy {
+    static int live;
+    std::string actor;
+    std::string endpoint;
+    int deliveries = 0;
+    bool in_use() const noexcept { return deliveries != 0; }
+    FakeProxy(std::string a, std::string e) : actor(std::move(a)), endpoint(std::move(e)) { live++; }
+    ~FakeProxy() { live--; }
+};
+int FakeProxy::live = 0;
+
+FakeProxy* make(const std::string& a, const std::string& e) { return new FakeProxy(a, e); }
+
+} // namespace
+
+TEST(ProxyCacheTest, HitReturnsSameProxy) {
+    ProxyCache<FakeProxy> cache(4);
+    int made = 0;
+    auto factory = [&](const std::string& a, const std::string& e) { made++; return make(a, e); };
+
+    FakeProxy* p1 = cache.get("ping", "tcp://localhost:5002", factory);
+    FakeProxy* p2 = cache.get(std::string("ping"), std::string("tcp://localhost:5002"), factory);
+    EXPECT_EQ(p1, p2);
+    EXPECT_EQ(made, 1);
+    EXPECT_EQ(p1->actor, "ping");
+    EXPECT_EQ(p1->endpoint, "tcp://localhost:5002");
+
+    // Same actor name at another endpoint is a different sender
+    FakeProxy* p3 = cache.get("ping", "tcp://localhost:5003", factory);
+    EXPECT_NE(p1, p3);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(ProxyCacheTest, EvictsLeastRecentlyUsed) {
+    ProxyCache<FakeProxy> cache(2);
+    FakeProxy* a = cache.get("a", "ep", make);
+    cache.get("b", "ep", make);
+    EXPECT_EQ(cache.get("a", "ep", make), a);  // a is now most recent
+
+    cache.get("c", "ep", make);  // evicts b
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.evictions(), 1u);
+    EXPECT_EQ(cache.get("a", "ep", make), a);
+
+    int before = FakeProxy::live;
+    cache.get("b", "ep", make);  // b is new again; evicts c
+    EXPECT_EQ(cache.evictions(), 2u);
+    EXPECT_LE(FakeProxy::live, before + 1);
+}
+
+TEST(ProxyCacheTest, EvictedProxiesInUseSurvive) {
+    int before = FakeProxy::live;
+    {
+        ProxyCache<FakeProxy> cache(1);
+        FakeProxy* a = cache.get("a", "ep", make);
+        a->deliveries = 1;
+        cache.get("b", "ep", make);
+        EXPECT_EQ(cache.retired(), 1u);
+        EXPECT_EQ(a->actor, "a");  // still alive for its queued delivery
+        EXPECT_EQ(FakeProxy::live, before + 2);
+
+        cache.collect();
+        EXPECT_EQ(cache.retired(), 1u);
+        a->deliveries = 0;
+        cache.collect();
+        EXPECT_EQ(cache.retired(), 0u);
+        EXPECT_EQ(FakeProxy::live, before + 1);
+    }
+    EXPECT_EQ(FakeProxy::live, before);
+}
+
+TEST(ProxyCacheTest, IdleProxiesFreedOnEviction) {
+    int before = FakeProxy::live;
+    ProxyCache<FakeProxy> cache(1);
+    cache.get("a", "ep", make);
+    cache.get("b", "ep", make)->deliveries = 2;
+    cache.get("c", "ep", make);  // frees a, retires b
+    EXPECT_EQ(cache.retired(), 1u);
+    EXPECT_EQ(FakeProxy::live, before + 2);
+}
+
+TEST(ProxyCacheTest, SetCapacityShrinks) {
+    ProxyCache<FakeProxy> cache(8);
+    for (int i = 0; i < 8; i++)
+        cache.get("a" + std::to_string(i), "ep", make);
+    cache.set_capacity(3);
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_EQ(cache.capacity(), 3u);
+    EXPECT_EQ(cache.evictions(), 5u);
+}
+
+TEST(ProxyCacheTest, BoundedUnderChurn) {
+    ProxyCache<FakeProxy> cache(16);
+    for (int i = 0; i < 10000; i++)
+        cache.get("actor" + std::to_string(i % 100), "ep", make);
+    EXPECT_EQ(cache.size(), 16u);
+    EXPECT_EQ(cache.retired(), 0u);
+}
@@ -0,0 +1,114 @@
+/*
+ * Tests for Publisher topic subscriptions and fan-out
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include "actors/Actor.hpp"
+#include "actors/ActorRef.hpp"
+#include "actors/act/Publisher.hpp"
+#include "actors/msg/Subscribe.hpp"
+#include "actors/msg/Unsubscribe.hpp"
+
+using namespace actors;
+
+namespace {
+
+struct Quote : public Message_N<4501> {
+    std::string symbol;
+    double px = 0;
+    Quote(std::string s, double p) : symbol(std::move(s)), px(p) {}
+};
+
+// Never started: published messages stay queued for inspection
+class Subscriber : public Actor {
+public:
+    explicit Subscriber(const std::string& subscriber_name) {
+        strncpy(name, subscriber_name.c_str(), sizeof(name) - 1);
+    }
+
+    void join(Publisher& pub, const std::string& topic) {
+        msg::Subscribe m(topic);
+        pub.fast_send(&m, this);
+    }
+
+    void leave(Publisher& pub, const std::string& topic) {
+        msg::Unsubscribe m(topic);
+        pub.fast_send(&m, this);
+    }
+};
+
+} // namespace
+
+TEST(PublisherTest, SubscribeMessagesFilterByTopic) {
+    Publisher pub("pub");
+    Subscriber a("a"), b("b");
+    a.join(pub, "AAPL");
+    b.join(pub, "MSFT");
+
+    EXPECT_EQ(pub.publish("AAPL", Quote("AAPL", 1.5)), 1u);
+    EXPECT_EQ(pub.publish("IBM", Quote("IBM", 2.0)), 0u);
+    ASSERT_EQ(a.queue_length(), 1u);
+    EXPECT_EQ(b.queue_length(), 0u);
+
+    Delivery d = a.peek_delivery();
+    EXPECT_EQ(d.sender, &pub);
+    EXPECT_EQ(static_cast<const Quote*>(d.msg)->px, 1.5);
+}
+
+TEST(PublisherTest, EverySubscriberGetsOwnCopy) {
+    Publisher pub("pub");
+    Subscriber a("a"), b("b");
+    a.join(pub, "AAPL");
+    b.join(pub, "AAPL");
+
+    EXPECT_EQ(pub.publish("AAPL", Quote("AAPL", 1.0)), 2u);
+    ASSERT_EQ(a.queue_length(), 1u);
+    ASSERT_EQ(b.queue_length(), 1u);
+    EXPECT_NE(a.peek(), b.peek());
+}
+
+TEST(PublisherTest, AllTopicsSubscriberGetsMessageOnce) {
+    Publisher pub("pub");
+    Subscriber a("a"), all("all");
+    a.join(pub, "AAPL");
+    all.join(pub, "");
+    all.join(pub, "AAPL");
+
+    EXPECT_EQ(pub.subscriber_count("AAPL"), 2u);
+    EXPECT_EQ(pub.subscriber_count("IBM"), 1u);
+    pub.publish("AAPL", Quote("AAPL", 1.0));
+    pub.publish("IBM", Quote("IBM", 1.0));
+    EXPECT_EQ(a.queue_length(), 1u);
+    EXPECT_EQ(all.queue_length(), 2u);
+}
+
+TEST(PublisherTest, UnsubscribeOneOrAllTopics) {
+    Publisher pub("pub");
+    Subscriber a("a");
+    EXPECT_TRUE(pub.subscribe("AAPL", ActorRef(&a)));
+    EXPECT_FALSE(pub.subscribe("AAPL", ActorRef(&a)));
+    a.join(pub, "MSFT");
+    a.join(pub, "");
+
+    a.leave(pub, "AAPL");
+    EXPECT_EQ(pub.subscriber_count("AAPL"), 1u);  // Still subscribed to all
+    EXPECT_EQ(pub.unsubscribe("", ActorRef(&a)), 2u);
+    EXPECT_EQ(pub.subscriber_count("MSFT"), 0u);
+    EXPECT_TRUE(pub.topics().empty());
+}
+
+// Remote refs without a ZmqSender: subscriptions only, nothing is published
+TEST(PublisherTest, RemoteSubscribersCountedOncePerName) {
+    Publisher pub("pub");
+    Subscriber a("a");
+    a.join(pub, "AAPL");
+    EXPECT_TRUE(pub.subscribe("AAPL", ActorRef("r1", "tcp://h:1", nullptr)));
+    EXPECT_TRUE(pub.subscribe("AAPL", ActorRef("r2", "tcp://h:1", nullptr)));
+    EXPECT_TRUE(pub.subscribe("AAPL", ActorRef("r1", "tcp://h:2", nullptr)));
+    EXPECT_FALSE(pub.subscribe("AAPL", ActorRef("r1", "tcp://h:1", nullptr)));
+    EXPECT_EQ(pub.subscriber_count("AAPL"), 4u);
+
+    EXPECT_EQ(pub.unsubscribe("AAPL", ActorRef("r2", "tcp://h:1", nullptr)), 1u);
+    EXPECT_EQ(pub.subscriber_count("AAPL"), 3u);
+}
@@ -1,11 +1,16 @@
 /*
- * Tests for BQueue class (Queue is abstract base)
+ * Tests for Queue implementations (Queue is abstract base)
  */
 
 #include <gtest/gtest.h>
 #include <thread>
+#include <atomic>
 #include "actors/Queue.hpp"
 #include "actors/BQueue.hpp"
+#include "actors/SPSCQueue.hpp"
+#include "actors/MPSCQueue.hpp"
+#include <vector>
+#include <chrono>
 
 using namespace actors;
 
@@ -82,6 +87,59 @@ TEST(BQueueTest, Overflow) {
     }
 }
 
+TEST(BQueueTest, BoundedTryPush) {
+    BQueue<int> q(4);
+    EXPECT_TRUE(q.try_push(1, 2));
+    EXPECT_TRUE(q.try_push(2, 2));
+    EXPECT_FALSE(q.try_push(3, 2));
+    EXPECT_EQ(q.length(), 2u);
+}
+
+TEST(BQueueTest, BoundedPushEvict) {
+    BQueue<int> q(4);
+    int evicted = -1;
+    bool queued = false;
+    EXPECT_FALSE(q.push_evict(1, 2, evicted, queued));
+    EXPECT_TRUE(queued);
+    EXPECT_FALSE(q.push_evict(2, 2, evicted, queued));
+    EXPECT_TRUE(q.push_evict(3, 2, evicted, queued));
+    EXPECT_TRUE(queued);
+    EXPECT_EQ(evicted, 1);
+    EXPECT_EQ(q.length(), 2u);
+    EXPECT_EQ(std::get<0>(q.pop()), 2);
+    EXPECT_EQ(std::get<0>(q.pop()), 3);
+}
+
+TEST(BQueueTest, BoundedPushWaitBlocksUntilPop) {
+    BQueue<int> q(4);
+    q.push_wait(1, 1);
+    std::atomic<bool> pushed{false};
+
+    std::thread producer([&]() {
+        q.push_wait(2, 1);
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(pushed.load());
+    EXPECT_EQ(std::get<0>(q.pop()), 1);
+    producer.join();
+    EXPECT_TRUE(pushed.load());
+    EXPECT_EQ(std::get<0>(q.pop()), 2);
+}
+
+TEST(QueueTest, LockFreePushEvictDropsNewItem) {
+    MPSCQueue<int> q(8);
+    int evicted = -1;
+    bool queued = false;
+    EXPECT_FALSE(q.push_evict(1, 1, evicted, queued));
+    EXPECT_TRUE(queued);
+    EXPECT_TRUE(q.push_evict(2, 1, evicted, queued));
+    EXPECT_FALSE(queued);
+    EXPECT_EQ(evicted, 2);
+    EXPECT_EQ(q.length(), 1u);
+}
+
 TEST(BQueueTest, ThreadSafety) {
     BQueue<int> q(1024);
     const int count = 100;
@@ -122,3 +180,302 @@ TEST(BQueueTest, PolymorphicUsage) {
     auto [val, last] = q->pop();
     EXPECT_EQ(val, 1);
 }
+
+TEST(SPSCQueueTest, BasicPushPop) {
+    SPSCQueue<int> q(16);
+    q.push(1);
+    q.push(2);
+
+    auto [val1, last1] = q.pop();
+    EXPECT_EQ(val1, 1);
+    EXPECT_FALSE(last1);
+
+    auto [val2, last2] = q.pop();
+    EXPECT_EQ(val2, 2);
+    EXPECT_TRUE(last2);
+}
+
+TEST(SPSCQueueTest, CapacityRoundsUp) {
+    SPSCQueue<int> q(100);
+    EXPECT_EQ(q.capacity(), 128u);
+}
+
+TEST(SPSCQueueTest, LengthAndPeek) {
+    SPSCQueue<int*> q(4);
+    EXPECT_TRUE(q.is_empty());
+    EXPECT_EQ(q.peek(), nullptr);
+
+    int a = 7;
+    q.push(&a);
+    EXPECT_EQ(q.length(), 1u);
+    EXPECT_EQ(q.peek(), &a);
+    EXPECT_FALSE(q.is_empty());
+}
+
+TEST(SPSCQueueTest, WrapAround) {
+    SPSCQueue<int> q(4);
+    for (int i = 0; i < 100; i++) {
+        q.push(i);
+        auto [val, last] = q.pop();
+        EXPECT_EQ(val, i);
+        EXPECT_TRUE(last);
+    }
+}
+
+TEST(SPSCQueueTest, ThreadSafety) {
+    // Ring smaller than the item count exercises the full-ring spin
+    SPSCQueue<int> q(64);
+    const int count = 100000;
+
+    std::thread producer([&q, count]() {
+        for (int i = 0; i < count; i++) {
+            q.push(i);
+        }
+    });
+
+    for (int i = 0; i < count; i++) {
+        auto [val, last] = q.pop();
+        ASSERT_EQ(val, i);
+    }
+    producer.join();
+    EXPECT_TRUE(q.is_empty());
+}
+
+TEST(SPSCQueueTest, ControlKeepsRingOrder) {
+    SPSCQueue<int> q(16);
+    q.push(1);
+    q.push(2);
+    q.push_control(100);  // after 1 and 2, before 3
+    q.push(3);
+    EXPECT_EQ(q.length(), 4u);
+
+    int out[8];
+    bool last = true;
+    ASSERT_EQ(q.pop_batch(out, 8, last), 2u);  // stops at the side item
+    EXPECT_FALSE(last);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 2);
+    EXPECT_EQ(q.peek(), 100);
+
+    auto [val, last1] = q.pop();
+    EXPECT_EQ(val, 100);
+    EXPECT_FALSE(last1);
+    ASSERT_EQ(q.try_pop_batch(out, 8, last), 1u);
+    EXPECT_EQ(out[0], 3);
+    EXPECT_TRUE(last);
+    EXPECT_TRUE(q.is_empty());
+}
+
+TEST(SPSCQueueTest, ControlFromOtherThreads) {
+    // One producer on the ring, two more threads on the side channel
+    SPSCQueue<int> q(64);
+    const int count = 50000;
+    const int control = 1000;
+
+    std::thread producer([&q, count]() {
+        for (int i = 0; i < count; i++) {
+            q.push(i);
+        }
+    });
+    std::vector<std::thread> others;
+    for (int t = 0; t < 2; t++) {
+        others.emplace_back([&q, control]() {
+            for (int i = 0; i < control; i++) {
+                q.push_control(-1);
+            }
+        });
+    }
+
+    int out[32];
+    int expected = 0;
+    int side = 0;
+    while (expected < count || side < 2 * control) {
+        bool last;
+        std::size_t n = q.pop_batch(out, 32, last);
+        for (std::size_t i = 0; i < n; i++) {
+            if (out[i] < 0) {
+                side++;
+            } else {
+                ASSERT_EQ(out[i], expected++);
+            }
+        }
+    }
+    producer.join();
+    for (auto& t : others) {
+        t.join();
+    }
+    EXPECT_EQ(side, 2 * control);
+    EXPECT_TRUE(q.is_empty());
+}
+
+TEST(MPSCQueueTest, BasicPushPop) {
+    MPSCQueue<int> q(16);
+    q.push(1);
+    q.push(2);
+
+    auto [val1, last1] = q.pop();
+    EXPECT_EQ(val1, 1);
+    EXPECT_FALSE(last1);
+
+    auto [val2, last2] = q.pop();
+    EXPECT_EQ(val2, 2);
+    EXPECT_TRUE(last2);
+}
+
+TEST(MPSCQueueTest, LengthAndPeek) {
+    MPSCQueue<int> q(8);
+    EXPECT_TRUE(q.is_empty());
+    q.push(5);
+    q.push(6);
+    EXPECT_EQ(q.length(), 2u);
+    EXPECT_EQ(q.peek(), 5);
+    EXPECT_EQ(q.length(), 2u);  // peek doesn't remove
+}
+
+TEST(MPSCQueueTest, MultipleProducers) {
+    MPSCQueue<int> q(256);
+    const int producers = 4;
+    const int per_producer = 50000;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&q, p, per_producer]() {
+            for (int i = 0; i < per_producer; i++) {
+                q.push(p * per_producer + i);
+            }
+        });
+    }
+
+    // Per-producer FIFO order must hold
+    std::vector<int> next(producers, 0);
+    for (int n = 0; n < producers * per_producer; n++) {
+        auto [val, last] = q.pop();
+        int p = val / per_producer;
+        ASSERT_EQ(val % per_producer, next[p]);
+        next[p]++;
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_TRUE(q.is_empty());
+}
+
+TEST(MPSCQueueTest, PolymorphicUsage) {
+    MPSCQueue<int> mq(16);
+    Queue<int>* q = &mq;
+
+    q->push(1);
+    EXPECT_EQ(q->length(), 1u);
+    auto [val, last] = q->pop();
+    EXPECT_EQ(val, 1);
+    EXPECT_TRUE(last);
+}
+
+TEST(QueueTest, TryPopEmpty) {
+    BQueue<int> bq(4);
+    SPSCQueue<int> sq(4);
+    MPSCQueue<int> mq(4);
+    std::tuple<int, bool> out{-1, false};
+
+    EXPECT_FALSE(bq.try_pop(out));
+    EXPECT_FALSE(sq.try_pop(out));
+    EXPECT_FALSE(mq.try_pop(out));
+    EXPECT_EQ(std::get<0>(out), -1);  // untouched
+}
+
+TEST(QueueTest, TryPopLastFlag) {
+    BQueue<int> bq(4);
+    SPSCQueue<int> sq(4);
+    MPSCQueue<int> mq(4);
+    Queue<int>* queues[] = {&bq, &sq, &mq};
+
+    for (auto* q : queues) {
+        q->push(1);
+        q->push(2);
+        std::tuple<int, bool> out;
+        ASSERT_TRUE(q->try_pop(out));
+        EXPECT_EQ(out, std::make_tuple(1, false));
+        ASSERT_TRUE(q->try_pop(out));
+        EXPECT_EQ(out, std::make_tuple(2, true));
+        EXPECT_FALSE(q->try_pop(out));
+    }
+}
+
+TEST(QueueTest, ParkedConsumerWakes) {
+    // Consumer parks before the producer starts pushing
+    SPSCQueue<int> sq(8);
+    MPSCQueue<int> mq(8);
+    Queue<int>* queues[] = {&sq, &mq};
+
+    for (auto* q : queues) {
+        std::thread producer([q]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            for (int i = 0; i < 1000; i++) {
+                q->push(i);
+            }
+        });
+        for (int i = 0; i < 1000; i++) {
+            auto [val, last] = q->pop();
+            ASSERT_EQ(val, i);
+        }
+        producer.join();
+    }
+}
+
+TEST(QueueTest, PopBatch) {
+    BQueue<int> bq(4);  // small ring so the batch spans the overflow
+    SPSCQueue<int> sq(16);
+    MPSCQueue<int> mq(16);
+    Queue<int>* queues[] = {&bq, &sq, &mq};
+
+    for (auto* q : queues) {
+        for (int i = 0; i < 10; i++) {
+            q->push(i);
+        }
+
+        int out[8];
+        bool last = true;
+        ASSERT_EQ(q->pop_batch(out, 8, last), 8u);
+        EXPECT_FALSE(last);
+        for (int i = 0; i < 8; i++) {
+            EXPECT_EQ(out[i], i);
+        }
+
+        ASSERT_EQ(q->pop_batch(out, 8, last), 2u);
+        EXPECT_TRUE(last);
+        EXPECT_EQ(out[0], 8);
+        EXPECT_EQ(out[1], 9);
+
+        EXPECT_EQ(q->try_pop_batch(out, 8, last), 0u);
+        EXPECT_TRUE(q->is_empty());
+    }
+}
+
+TEST(QueueTest, PopBatchAcrossThreads) {
+    SPSCQueue<int> sq(64);
+    MPSCQueue<int> mq(64);
+    BQueue<int> bq(64);
+    Queue<int>* queues[] = {&bq, &sq, &mq};
+    const int count = 20000;
+
+    for (auto* q : queues) {
+        std::thread producer([q, count]() {
+            for (int i = 0; i < count; i++) {
+                q->push(i);
+            }
+        });
+
+        int out[32];
+        int expected = 0;
+        while (expected < count) {
+            bool last;
+            std::size_t n = q->pop_batch(out, 32, last);
+            ASSERT_GE(n, 1u);
+            for (std::size_t i = 0; i < n; i++) {
+                ASSERT_EQ(out[i], expected++);
+            }
+        }
+        producer.join();
+    }
+}
@@ -0,0 +1,240 @@
+/*
+ * Tests for RegistryClient's lookup cache
+ */
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "actors/Actor.hpp"
+#include "actors/registry/RegistryClient.hpp"
+
+using namespace actors;
+using namespace actors::registry;
+
+namespace {
+
+// Local stand-in for GlobalRegistry: answers lookups from a table
+class FakeRegistry : public Actor {
+public:
+    struct Entry {
+        ActorRef ref;
+        bool online;
+        std::string manager_id;
+    };
+    std::map<std::string, Entry> actors;
+    std::map<std::string, std::string> endpoints;  // From RegisterActors
+    int lookups = 0;
+    int bulk_requests = 0;
+
+    FakeRegistry() {
+        MESSAGE_HANDLER(LookupActor, on_lookup);
+        MESSAGE_HANDLER(RegisterActors, on_register_actors);
+        MESSAGE_HANDLER(SubscribeRegistry, on_subscribe);
+    }
+
+    std::string subscriber, subscriber_endpoint;
+    std::vector<std::string> watched_actors, watched_managers;
+
+    void on_subscribe(const SubscribeRegistry* m) noexcept {
+        subscriber = m->subscriber;
+        subscriber_endpoint = m->subscriber_endpoint;
+        watched_actors = m->actor_names;
+        watched_managers = m->manager_ids;
+        reply(new SubscriptionOk(m->subscriber));
+    }
+
+    void on_register_actors(const RegisterActors* m) noexcept {
+        bulk_requests++;
+        std::vector<RegisterActorsResult::Failure> failed;
+        for (const auto& e : m->actors) {
+            if (endpoints.count(e.actor_name) || actors.count(e.actor_name))
+                failed.push_back({e.actor_name, "Name already registered"});
+            else
+                endpoints[e.actor_name] = e.actor_endpoint;
+        }
+        reply(new RegisterActorsResult(m->actors.size() - failed.size(), std::move(failed)));
+    }
+
+    void on_lookup(const LookupActor* m) noexcept {
+        lookups++;
+        auto it = actors.find(m->actor_name);
+        if (it == actors.end())
+            reply(new LookupResult(m->actor_name, std::nullopt, false));
+        else
+            reply(new LookupResult(m->actor_name, it->second.ref, it->second.online, it->second.manager_id));
+    }
+};
+
+} // namespace
+
+TEST(RegistryClientTest, CachesFoundActors) {
+    FakeRegistry registry;
+    Actor target;
+    registry.actors["pong"] = {ActorRef(&target), true, "mgr1"};
+    RegistryClient client("mgr0", ActorRef(&registry));
+
+    EXPECT_EQ(client.lookup("pong"), "");
+    EXPECT_EQ(client.lookup("pong"), "");
+    EXPECT_EQ(registry.lookups, 1);
+
+    LookupCacheStats stats = client.cache_stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+}
+
+TEST(RegistryClientTest, CachesNotFound) {
+    FakeRegistry registry;
+    RegistryClient client("mgr0", ActorRef(&registry));
+
+    EXPECT_THROW(client.lookup("ghost"), ActorNotFoundError);
+    EXPECT_THROW(client.lookup("ghost"), ActorNotFoundError);
+    EXPECT_THROW(client.lookup_allow_offline("ghost"), ActorNotFoundError);
+    EXPECT_EQ(registry.lookups, 1);
+}
+
+TEST(RegistryClientTest, OfflineUsesNegativeTtl) {
+    FakeRegistry registry;
+    Actor target;
+    registry.actors["pong"] = {ActorRef(&target), false, "mgr1"};
+    RegistryClient client("mgr0", ActorRef(&registry));
+    client.set_cache_ttl(std::chrono::seconds(60), std::chrono::milliseconds(20));
+
+    EXPECT_THROW(client.lookup("pong"), ActorOfflineError);
+    EXPECT_FALSE(client.lookup_allow_offline("pong").second);
+    EXPECT_EQ(registry.lookups, 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    registry.actors["pong"].online = true;
+    EXPECT_EQ(client.lookup("pong"), "");
+    EXPECT_EQ(registry.lookups, 2);
+}
+
+TEST(RegistryClientTest, ZeroTtlDisablesCache) {
+    FakeRegistry registry;
+    RegistryClient client("mgr0", ActorRef(&registry));
+    client.set_cache_ttl(std::chrono::milliseconds(0), std::chrono::milliseconds(0));
+
+    EXPECT_THROW(client.lookup("ghost"), ActorNotFoundError);
+    EXPECT_THROW(client.lookup("ghost"), ActorNotFoundError);
+    EXPECT_EQ(registry.lookups, 2);
+    EXPECT_EQ(client.cache_stats().hits, 0u);
+}
+
+TEST(RegistryClientTest, ActorMovedInvalidates) {
+    FakeRegistry registry;
+    Actor target;
+    registry.actors["pong"] = {ActorRef(&target), true, "mgr1"};
+    RegistryClient client("mgr0", ActorRef(&registry));
+
+    client.lookup("pong");
+    ActorMoved moved("pong");
+    EXPECT_TRUE(client.handle_update(&moved));
+    client.lookup("pong");
+    EXPECT_EQ(registry.lookups, 2);
+    EXPECT_EQ(client.cache_stats().invalidations, 1u);
+
+    LookupActor other("pong");
+    EXPECT_FALSE(client.handle_update(&other));
+}
+
+TEST(RegistryClientTest, ManagerOfflineInvalidatesItsActors) {
+    FakeRegistry registry;
+    Actor a, b, c;
+    registry.actors["a"] = {ActorRef(&a), true, "mgr1"};
+    registry.actors["b"] = {ActorRef(&b), true, "mgr1"};
+    registry.actors["c"] = {ActorRef(&c), true, "mgr2"};
+    RegistryClient client("mgr0", ActorRef(&registry));
+
+    client.lookup("a");
+    client.lookup("b");
+    client.lookup("c");
+    ManagerOffline offline("mgr1");
+    EXPECT_TRUE(client.handle_update(&offline));
+    EXPECT_EQ(client.cache_stats().invalidations, 2u);
+
+    client.lookup("c");
+    EXPECT_EQ(registry.lookups, 3);
+    client.lookup("a");
+    EXPECT_EQ(registry.lookups, 4);
+}
+
+TEST(RegistryClientTest, RegisterActorsInOneRequest) {
+    FakeRegistry registry;
+    RegistryClient client("mgr0", ActorRef(&registry));
+
+    auto failed = client.register_actors({"a", "b", "c"}, "tcp://localhost:5001");
+    EXPECT_TRUE(failed.empty());
+    EXPECT_EQ(registry.bulk_requests, 1);
+    EXPECT_EQ(registry.endpoints.size(), 3u);
+    EXPECT_EQ(registry.endpoints["b"], "tcp://localhost:5001");
+}
+
+TEST(RegistryClientTest, RegisterActorsListsEachFailure) {
+    FakeRegistry registry;
+    Actor taken;
+    registry.actors["b"] = {ActorRef(&taken), true, "mgr1"};
+    RegistryClient client("mgr0", ActorRef(&registry));
+
+    auto failed = client.register_actors({"a", "b", "a"}, "tcp://localhost:5001");
+    ASSERT_EQ(failed.size(), 2u);
+    EXPECT_EQ(failed[0].actor_name, "b");
+    EXPECT_EQ(failed[1].actor_name, "a");
+    EXPECT_EQ(failed[0].reason, "Name already registered");
+    EXPECT_EQ(registry.endpoints.count("a"), 1u);
+}
+
+TEST(RegistryClientTest, HeartbeatsFromTimerWheel) {
+    FakeRegistry registry;
+    RegistryClient client("mgr0", ActorRef(&registry));
+    client.set_heartbeat_interval(std::chrono::milliseconds(10));
+
+    client.start_heartbeat();
+    EXPECT_TRUE(client.is_heartbeat_running());
+    EXPECT_EQ(registry.queue_length(), 1u);  // One right away
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    client.stop_heartbeat();
+    EXPECT_FALSE(client.is_heartbeat_running());
+
+    size_t sent = registry.queue_length();
+    EXPECT_GE(sent, 3u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    EXPECT_EQ(registry.queue_length(), sent);
+}
+
+TEST(RegistryClientTest, SubscribeNamesListener) {
+    FakeRegistry registry;
+    RegistryClient client("mgr0", ActorRef(&registry));
+
+    client.subscribe({"pong"}, {"mgr1"}, "tcp://localhost:5001");
+    EXPECT_EQ(registry.subscriber, "$registry:mgr0");
+    EXPECT_EQ(registry.subscriber, client.listener_name());
+    EXPECT_EQ(registry.subscriber_endpoint, "tcp://localhost:5001");
+    EXPECT_EQ(registry.watched_actors, std::vector<std::string>{"pong"});
+    EXPECT_EQ(registry.watched_managers, std::vector<std::string>{"mgr1"});
+}
+
+TEST(RegistryClientTest, PushedEventsUpdateCacheAndCallBack) {
+    FakeRegistry registry;
+    Actor target;
+    registry.actors["pong"] = {ActorRef(&target), false, "mgr1"};
+    RegistryClient client("mgr0", ActorRef(&registry));
+
+    std::vector<int> seen;
+    client.on_event([&](const Message& e) { seen.push_back(e.get_message_id()); });
+
+    EXPECT_THROW(client.lookup("pong"), ActorOfflineError);
+    registry.actors["pong"].online = true;
+
+    // The listener handles events inside send() and frees them
+    client.listener()->send(new ManagerOnline("mgr1"));
+    EXPECT_EQ(client.lookup("pong"), "");
+    EXPECT_EQ(registry.lookups, 2);
+
+    client.listener()->send(new ManagerOffline("mgr1", {"pong"}));
+    client.listener()->send(new ActorMoved("pong", "tcp://elsewhere:5001"));
+    EXPECT_EQ(seen, (std::vector<int>{MSG_MANAGER_ONLINE, MSG_MANAGER_OFFLINE, MSG_ACTOR_MOVED}));
+    EXPECT_EQ(client.cache_stats().invalidations, 2u);
+}
@@ -95,6 +95,37 @@ TEST(RegistryMessagesTest, HeartbeatAckMessageId) {
     EXPECT_EQ(msg.get_message_id(), 907);
 }
 
+TEST(RegistryMessagesTest, RegisterActorsWithData) {
+    RegisterActors msg("mgr1", {{"ping", "tcp://localhost:5001"}, {"pong", "tcp://localhost:5001"}});
+    EXPECT_EQ(msg.get_message_id(), MSG_REGISTER_ACTORS);
+    EXPECT_EQ(msg.get_message_id(), 910);
+    EXPECT_EQ(msg.manager_id, "mgr1");
+    ASSERT_EQ(msg.actors.size(), 2u);
+    EXPECT_EQ(msg.actors[1].actor_name, "pong");
+}
+
+TEST(RegistryMessagesTest, RegisterActorsResultDefault) {
+    RegisterActorsResult msg;
+    EXPECT_EQ(msg.get_message_id(), MSG_REGISTER_ACTORS_RESULT);
+    EXPECT_EQ(msg.registered, 0u);
+    EXPECT_TRUE(msg.failed.empty());
+}
+
+TEST(RegistryMessagesTest, HeartbeatCarriesInterval) {
+    Heartbeat def("mgr1");
+    EXPECT_EQ(def.interval_ms, 2000u);
+    Heartbeat fast("mgr1", 250);
+    EXPECT_EQ(fast.interval_ms, 250u);
+}
+
+TEST(RegistryMessagesTest, SubscribeRegistryWithData) {
+    SubscribeRegistry msg("$registry:mgr0", "tcp://localhost:5001", {"pong"}, {"mgr1", "mgr2"});
+    EXPECT_EQ(msg.get_message_id(), MSG_SUBSCRIBE_REGISTRY);
+    EXPECT_EQ(msg.subscriber, "$registry:mgr0");
+    EXPECT_EQ(msg.actor_names.size(), 1u);
+    EXPECT_EQ(msg.manager_ids.size(), 2u);
+}
+
 TEST(RegistryMessagesTest, AllMessageIdsUnique) {
     // Verify all registry message IDs are unique
     RegisterActor reg;
@@ -105,6 +136,14 @@ TEST(RegistryMessagesTest, AllMessageIdsUnique) {
     LookupResult result;
     Heartbeat hb;
     HeartbeatAck hback;
+    ActorMoved moved;
+    ManagerOffline offline;
+    RegisterActors bulk;
+    RegisterActorsResult bulk_result;
+    SubscribeRegistry sub;
+    UnsubscribeRegistry unsub;
+    SubscriptionOk sub_ok;
+    ManagerOnline online;
 
     std::set<int> ids = {
         reg.get_message_id(),
@@ -114,8 +153,16 @@ TEST(RegistryMessagesTest, AllMessageIdsUnique) {
         lookup.get_message_id(),
         result.get_message_id(),
         hb.get_message_id(),
-        hback.get_message_id()
+        hback.get_message_id(),
+        moved.get_message_id(),
+        offline.get_message_id(),
+        bulk.get_message_id(),
+        bulk_result.get_message_id(),
+        sub.get_message_id(),
+        unsub.get_message_id(),
+        sub_ok.get_message_id(),
+        online.get_message_id()
     };
 
-    EXPECT_EQ(ids.size(), 8u);  // All unique
+    EXPECT_EQ(ids.size(), 16u);  // All unique
 }
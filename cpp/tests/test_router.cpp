@@ -0,0 +1,145 @@
+/*
+ * Tests for Router strategies and worker management
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/act/Router.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+using namespace actors;
+
+namespace {
+
+struct Job : public Message_N<4401> {
+    std::uint64_t key;
+    explicit Job(std::uint64_t k = 0) : key(k) {}
+};
+
+struct Note : public Message_N<4402> {};
+
+// Never started: routed messages stay queued for inspection
+class Worker : public Actor {
+public:
+    explicit Worker(const std::string& worker_name) {
+        strncpy(name, worker_name.c_str(), sizeof(name) - 1);
+    }
+};
+
+struct Pool {
+    std::vector<std::unique_ptr<Worker>> workers;
+    Router router;
+
+    explicit Pool(RouteStrategy strategy, int n = 3) : router("router", strategy) {
+        for (int i = 0; i < n; i++) {
+            workers.push_back(std::make_unique<Worker>("w" + std::to_string(i)));
+            router.add(workers.back().get());
+        }
+    }
+
+    std::vector<std::size_t> lengths() const {
+        std::vector<std::size_t> out;
+        for (auto& w : workers)
+            out.push_back(w->queue_length());
+        return out;
+    }
+};
+
+class RouterManager : public Manager {
+public:
+    RouterManager() { strncpy(name, "RouterManager", sizeof(name) - 1); }
+};
+
+} // namespace
+
+TEST(RouterTest, RoundRobinKeepsOriginalSender) {
+    Pool pool(RouteStrategy::ROUND_ROBIN);
+    Worker client("client");
+    for (int i = 0; i < 7; i++)
+        pool.router.send(new Job(), &client);
+
+    EXPECT_EQ(pool.lengths(), (std::vector<std::size_t>{3, 2, 2}));
+    EXPECT_EQ(pool.router.queue_length(), 0u);
+    EXPECT_EQ(pool.workers[1]->peek_delivery().sender, &client);  // reply() reaches the client
+}
+
+TEST(RouterTest, LeastLoadedPicksShortestMailbox) {
+    Pool pool(RouteStrategy::LEAST_LOADED);
+    pool.workers[0]->send(new Job());
+    pool.workers[0]->send(new Job());
+    pool.workers[2]->send(new Job());
+
+    pool.router.send(new Job());
+    EXPECT_EQ(pool.lengths(), (std::vector<std::size_t>{2, 1, 1}));
+    pool.router.send(new Job());
+    pool.router.send(new Job());
+    EXPECT_EQ(pool.lengths(), (std::vector<std::size_t>{2, 2, 2}));
+}
+
+TEST(RouterTest, HashSendsEqualKeysToOneWorker) {
+    Pool pool(RouteStrategy::HASH, 4);
+    pool.router.key_by<Job>([](const Job& j) { return j.key; });
+
+    std::set<Actor*> used;
+    for (std::uint64_t key = 0; key < 200; key++) {
+        Job probe(key);
+        Actor* first = pool.router.pick(&probe);
+        for (int i = 0; i < 3; i++)
+            EXPECT_EQ(pool.router.pick(&probe), first);
+        used.insert(first);
+    }
+    EXPECT_EQ(used.size(), 4u);
+
+    // Growing the pool only moves keys onto the new worker
+    Job probe(12345);
+    Actor* before = pool.router.pick(&probe);
+    Worker extra("w4");
+    pool.router.add(&extra);
+    Actor* after = pool.router.pick(&probe);
+    EXPECT_TRUE(after == before || after == &extra);
+
+    // No key for Note: round-robin
+    Note n;
+    EXPECT_NE(pool.router.pick(&n), pool.router.pick(&n));
+}
+
+TEST(RouterTest, BroadcastCopiesRegisteredTypes) {
+    Pool pool(RouteStrategy::BROADCAST);
+    pool.router.copyable<Job>();
+
+    pool.router.send(new Job(7));
+    EXPECT_EQ(pool.lengths(), (std::vector<std::size_t>{1, 1, 1}));
+    for (auto& w : pool.workers)
+        EXPECT_EQ(static_cast<const Job*>(w->peek())->key, 7u);
+
+    pool.router.send(new Note());  // Not copyable: one worker
+    EXPECT_EQ(pool.workers[0]->queue_length() + pool.workers[1]->queue_length() +
+              pool.workers[2]->queue_length(), 4u);
+}
+
+TEST(RouterTest, ShutdownReachesEveryWorker) {
+    Pool pool(RouteStrategy::ROUND_ROBIN);
+    pool.router.send(new msg::Shutdown());
+    EXPECT_EQ(pool.lengths(), (std::vector<std::size_t>{1, 1, 1}));
+    EXPECT_EQ(pool.router.queue_length(), 1u);
+}
+
+TEST(RouterTest, ManagerManagesWorkersWithAffinity) {
+    RouterManager mgr;
+    auto w0 = std::make_unique<Worker>("a0");
+    auto w1 = std::make_unique<Worker>("a1");
+    Router router("pool");
+    router.add(w0.get(), {0});
+    router.add(w1.get());
+    mgr.manage(&router);
+
+    EXPECT_EQ(mgr.get_local_actor("a0"), w0.get());
+    EXPECT_EQ(mgr.get_local_actor("a1"), w1.get());
+    EXPECT_EQ(router.worker_affinity(0), std::set<int>{0});
+    EXPECT_EQ(mgr.get_managed_actors().size(), 3u);
+}
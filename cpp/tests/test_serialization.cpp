@@ -0,0 +1,125 @@
+/*
+ * Tests for MessageRegistry registration, sealing and lookups
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "actors/remote/Serialization.hpp"
+
+using namespace actors;
+
+namespace {
+
+struct RegPing : public Message_N<150> {
+    int count;
+    RegPing(int c = 0) : count(c) {}
+};
+
+struct RegLate : public Message_N<151> {
+    std::string text;
+    RegLate() = default;
+    RegLate(std::string t) : text(std::move(t)) {}
+};
+
+struct RegFar : public Message_N<70000> {
+    int v;
+    RegFar(int x = 0) : v(x) {}
+};
+
+} // namespace
+
+REGISTER_REMOTE_MESSAGE_1(RegPing, count, int)
+REGISTER_REMOTE_MESSAGE_1(RegFar, v, int)
+
+TEST(SerializationTest, JsonRoundTrip) {
+    RegPing p(5);
+    nlohmann::json j = serialization::serialize(&p);
+    EXPECT_EQ(j["count"], 5);
+    std::unique_ptr<Message> m(serialization::deserialize("RegPing", j));
+    ASSERT_NE(m, nullptr);
+    EXPECT_EQ(static_cast<RegPing*>(m.get())->count, 5);
+}
+
+TEST(SerializationTest, UnknownLookups) {
+    EXPECT_EQ(serialization::get_type_name(99999), "");
+    EXPECT_EQ(serialization::deserialize("NoSuchType", nlohmann::json::object()), nullptr);
+    EXPECT_FALSE(serialization::is_registered("NoSuchType"));
+    RegLate never_registered;
+    if (!serialization::is_registered("RegLate")) {
+        EXPECT_THROW(serialization::serialize(&never_registered), std::runtime_error);
+    }
+}
+
+TEST(SerializationTest, SealKeepsRegistrations) {
+    serialization::seal();
+    serialization::seal();  // idempotent
+    auto& reg = serialization::MessageRegistry::instance();
+    EXPECT_TRUE(reg.is_sealed());
+
+    const serialization::RegistryEntry* byid = reg.find(150);
+    const serialization::RegistryEntry* byname = reg.find(std::string_view("RegPing"));
+    ASSERT_NE(byid, nullptr);
+    EXPECT_EQ(byid, byname);
+    EXPECT_EQ(byid->type_name, "RegPing");
+
+    // Far-apart IDs still resolve (sparse layout)
+    EXPECT_EQ(serialization::get_type_name(70000), "RegFar");
+    EXPECT_EQ(reg.find(149), nullptr);
+    EXPECT_EQ(reg.find(-1), nullptr);
+}
+
+TEST(SerializationTest, LateRegistrationAfterSeal) {
+    serialization::seal();
+    const serialization::RegistryEntry* before = serialization::MessageRegistry::instance().find(150);
+
+    serialization::register_message(151, "RegLate",
+        [](const Message* m) -> nlohmann::json {
+            return nlohmann::json{{"text", static_cast<const RegLate*>(m)->text}};
+        },
+        [](const nlohmann::json& j) -> Message* {
+            return new RegLate(j["text"].get<std::string>());
+        });
+
+    EXPECT_TRUE(serialization::is_registered("RegLate"));
+    EXPECT_EQ(serialization::get_type_name(151), "RegLate");
+    RegLate l("hi");
+    std::unique_ptr<Message> m(serialization::deserialize("RegLate", serialization::serialize(&l)));
+    ASSERT_NE(m, nullptr);
+    EXPECT_EQ(static_cast<RegLate*>(m.get())->text, "hi");
+
+    // Entries published earlier stay valid across republishing
+    EXPECT_EQ(serialization::MessageRegistry::instance().find(150), before);
+    EXPECT_EQ(before->type_name, "RegPing");
+}
+
+TEST(SerializationTest, ConcurrentReadsDuringLateRegistration) {
+    serialization::seal();
+    std::atomic<bool> stop{false};
+    std::atomic<int> misses{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&] {
+            RegPing p(1);
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (serialization::get_type_name(150) != "RegPing")
+                    misses++;
+                if (serialization::serialize(&p)["count"] != 1)
+                    misses++;
+            }
+        });
+    }
+    for (int id = 160; id < 200; id++) {
+        serialization::register_message(id, "RegDyn" + std::to_string(id),
+            [](const Message*) -> nlohmann::json { return nlohmann::json::object(); },
+            [](const nlohmann::json&) -> Message* { return nullptr; });
+    }
+    stop = true;
+    for (auto& r : readers)
+        r.join();
+
+    EXPECT_EQ(misses.load(), 0);
+    EXPECT_EQ(serialization::get_type_name(199), "RegDyn199");
+}
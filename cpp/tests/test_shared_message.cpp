@@ -0,0 +1,130 @@
+/*
+ * Tests for shared (refcounted) messages and per-delivery metadata
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+using namespace actors;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Depth : public Message_N<4601> {
+    static inline std::atomic<int> alive{0};
+    int levels;
+    explicit Depth(int n) : levels(n) { alive++; }
+    Depth(const Depth& other) : Message_N(other), levels(other.levels) { alive++; }
+    ~Depth() override { alive--; }
+};
+
+std::atomic<int> g_seen{0};
+
+// Records what each delivery of a Depth looked like
+class Strategy : public Actor {
+public:
+    std::atomic<const Message*> got{nullptr};
+    std::atomic<Actor*> from{nullptr};
+
+    explicit Strategy(const char* strategy_name) {
+        strncpy(name, strategy_name, sizeof(name) - 1);
+        MESSAGE_HANDLER(Depth, on_depth);
+    }
+
+    void on_depth(const Depth* m) noexcept {
+        got = m;
+        from = current_sender();
+        g_seen++;
+    }
+};
+
+class SharedManager : public Manager {
+public:
+    SharedManager() { strncpy(name, "SharedManager", sizeof(name) - 1); }
+};
+
+} // namespace
+
+TEST(SharedMessageTest, HandleCountsReferences) {
+    int before = Depth::alive.load();
+    {
+        auto depth = make_shared_message<Depth>(10);
+        EXPECT_TRUE(depth->is_shared());
+        EXPECT_EQ(depth.use_count(), 1u);
+
+        auto copy = depth;
+        EXPECT_EQ(depth.use_count(), 2u);
+        const Depth* ref = depth.share();
+        EXPECT_EQ(ref, copy.get());
+        EXPECT_EQ(depth.use_count(), 3u);
+        ref->release();
+        EXPECT_EQ(depth.use_count(), 2u);
+        EXPECT_EQ(Depth::alive.load() - before, 1);
+    }
+    EXPECT_EQ(Depth::alive.load(), before);
+}
+
+TEST(SharedMessageTest, DroppedDeliveryReleasesItsReference) {
+    Strategy s("s");
+    s.set_mailbox_limit(1, OverflowPolicy::DROP_NEWEST);
+    auto depth = make_shared_message<Depth>(5);
+    s.send(depth.share());
+    s.send(depth.share());
+    EXPECT_EQ(s.dropped_count(), 1u);
+    EXPECT_EQ(depth.use_count(), 2u);  // The handle and the queued delivery
+    EXPECT_EQ(s.peek(), depth.get());
+}
+
+TEST(SharedMessageTest, DropOldestEvictsEarlierDeliveryOfSameMessage) {
+    Strategy s("s");
+    s.set_mailbox_limit(1, OverflowPolicy::DROP_OLDEST);
+    auto depth = make_shared_message<Depth>(5);
+    s.send(depth.share());
+    s.send(depth.share());  // Evicts the first delivery, queues the second
+    EXPECT_EQ(s.dropped_count(), 1u);
+    EXPECT_EQ(s.queue_length(), 1u);
+    EXPECT_EQ(depth.use_count(), 2u);
+    EXPECT_EQ(s.peek(), depth.get());
+}
+
+TEST(SharedMessageTest, BroadcastWithoutCopies) {
+    g_seen = 0;
+    int before = Depth::alive.load();
+
+    SharedManager mgr;
+    Strategy a("a"), b("b"), c("c");
+    Strategy client("client");
+    mgr.manage(&a);
+    mgr.manage(&b);
+    mgr.manage(&c);
+    mgr.init();
+
+    {
+        auto depth = make_shared_message<Depth>(20);
+        for (Strategy* s : {&a, &b, &c})
+            s->send(depth.share(), &client);
+        for (int i = 0; i < 500 && g_seen.load() < 3; i++)
+            std::this_thread::sleep_for(2ms);
+        ASSERT_EQ(g_seen.load(), 3);
+
+        // Every actor got the one message, each with its own sender
+        for (Strategy* s : {&a, &b, &c}) {
+            EXPECT_EQ(s->got.load(), depth.get());
+            EXPECT_EQ(s->from.load(), &client);
+        }
+        EXPECT_EQ(Depth::alive.load() - before, 1);
+        for (int i = 0; i < 500 && depth.use_count() > 1; i++)
+            std::this_thread::sleep_for(2ms);
+        EXPECT_EQ(depth.use_count(), 1u);  // Each delivery released its reference
+    }
+    EXPECT_EQ(Depth::alive.load(), before);
+
+    for (Strategy* s : {&a, &b, &c})
+        s->send(new msg::Shutdown());
+    mgr.end();
+}
@@ -0,0 +1,217 @@
+/*
+ * Tests for ShmRing and the shared-memory transport helpers
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "actors/remote/ShmRing.hpp"
+#include "actors/remote/ShmTransport.hpp"
+
+using namespace actors;
+
+namespace {
+
+std::string test_ring_name(const char* tag) {
+    return "/actors-test-" + std::to_string(::getpid()) + "-" + tag;
+}
+
+std::vector<std::string> drain(ShmRing& ring) {
+    std::vector<std::string> out;
+    ring.pop([&](const char* d, size_t n) { out.emplace_back(d, n); });
+    return out;
+}
+
+} // namespace
+
+TEST(ShmRingTest, PushPopThroughSecondMapping) {
+    auto consumer = ShmRing::create(test_ring_name("basic"), 8, 128);
+    auto producer = ShmRing::open(test_ring_name("basic"));
+    ASSERT_NE(producer, nullptr);
+    EXPECT_EQ(producer->capacity(), 8u);
+
+    EXPECT_TRUE(consumer->empty());
+    EXPECT_TRUE(producer->try_push("hello", 5));
+    EXPECT_TRUE(producer->try_push("", 0));
+    EXPECT_FALSE(consumer->empty());
+
+    auto got = drain(*consumer);
+    ASSERT_EQ(got.size(), 2u);
+    EXPECT_EQ(got[0], "hello");
+    EXPECT_EQ(got[1], "");
+    EXPECT_TRUE(consumer->empty());
+}
+
+TEST(ShmRingTest, OpenMissingRingReturnsNull) {
+    EXPECT_EQ(ShmRing::open(test_ring_name("missing")), nullptr);
+}
+
+TEST(ShmRingTest, RejectsBadGeometry) {
+    EXPECT_THROW(ShmRing::create(test_ring_name("geom"), 6, 128), std::invalid_argument);
+}
+
+TEST(ShmRingTest, FullAndOversized) {
+    auto ring = ShmRing::create(test_ring_name("full"), 4, 64);
+    std::string big(ring->max_record() + 1, 'x');
+    EXPECT_FALSE(ring->try_push(big.data(), big.size()));
+    EXPECT_FALSE(ring->push(big.data(), big.size()));
+
+    for (int i = 0; i < 4; i++)
+        EXPECT_TRUE(ring->try_push(&i, sizeof(i)));
+    int extra = 99;
+    EXPECT_FALSE(ring->try_push(&extra, sizeof(extra)));
+
+    // Slots are reused after a pop, in order
+    EXPECT_EQ(ring->pop([](const char*, size_t) {}, 1), 1u);
+    EXPECT_TRUE(ring->try_push(&extra, sizeof(extra)));
+    std::vector<int> vals;
+    ring->pop([&](const char* d, size_t n) {
+        ASSERT_EQ(n, sizeof(int));
+        int v;
+        std::memcpy(&v, d, sizeof(v));
+        vals.push_back(v);
+    });
+    EXPECT_EQ(vals, (std::vector<int>{1, 2, 3, 99}));
+}
+
+TEST(ShmRingTest, ClosedWhenConsumerGoesAway) {
+    auto consumer = ShmRing::create(test_ring_name("closed"), 8, 64);
+    auto producer = ShmRing::open(test_ring_name("closed"));
+    ASSERT_NE(producer, nullptr);
+    EXPECT_FALSE(producer->closed());
+
+    consumer.reset();
+    EXPECT_TRUE(producer->closed());
+    EXPECT_FALSE(producer->push("x", 1));
+    EXPECT_EQ(ShmRing::open(test_ring_name("closed")), nullptr);  // unlinked
+}
+
+TEST(ShmRingTest, ClosedWhenConsumerDies) {
+    // A child process creates the ring and is killed without closing it
+    const std::string name = test_ring_name("crash");
+    int ready[2];
+    ASSERT_EQ(::pipe(ready), 0);
+    pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        auto ring = ShmRing::create(name, 8, 64);
+        char c = 1;
+        (void)!::write(ready[1], &c, 1);
+        ::pause();
+        ::_exit(0);
+    }
+    char c = 0;
+    (void)!::read(ready[0], &c, 1);
+    ::close(ready[0]);
+    ::close(ready[1]);
+    auto producer = ShmRing::open(name);
+    bool pushed = producer && producer->push("x", 1);
+    ::kill(child, SIGKILL);
+    ::waitpid(child, nullptr, 0);
+
+    ASSERT_NE(producer, nullptr);
+    EXPECT_TRUE(pushed);
+    EXPECT_TRUE(producer->closed());
+    EXPECT_FALSE(producer->push("y", 1));
+    EXPECT_EQ(ShmRing::open(name), nullptr);  // still there, but orphaned
+    ::shm_unlink(name.c_str());
+}
+
+TEST(ShmRingTest, FullRingGivesUpAfterMaxWait) {
+    auto ring = ShmRing::create(test_ring_name("stuck"), 4, 64);
+    int v = 0;
+    for (int i = 0; i < 4; i++)
+        ASSERT_TRUE(ring->push(&v, sizeof(v)));
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(ring->push(&v, sizeof(v), std::chrono::milliseconds(20)));
+    auto waited = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(waited, std::chrono::milliseconds(20));
+    EXPECT_LT(waited, std::chrono::seconds(2));
+    EXPECT_FALSE(ring->closed());
+}
+
+TEST(ShmRingTest, MultipleProducersKeepPerProducerOrder) {
+    auto consumer = ShmRing::create(test_ring_name("mp"), 64, 64);
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 5000;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; p++) {
+        producers.emplace_back([p] {
+            auto ring = ShmRing::open(test_ring_name("mp"));
+            for (int i = 0; i < kPerProducer; i++) {
+                int rec[2] = {p, i};
+                ring->push(rec, sizeof(rec), std::chrono::seconds(20));  // Never give up here
+            }
+        });
+    }
+
+    std::vector<int> next(kProducers, 0);
+    int total = 0;
+    bool in_order = true;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    while (total < kProducers * kPerProducer && std::chrono::steady_clock::now() < deadline) {
+        total += int(consumer->pop([&](const char* d, size_t) {
+            int rec[2];
+            std::memcpy(rec, d, sizeof(rec));
+            if (rec[1] != next[rec[0]])
+                in_order = false;
+            next[rec[0]] = rec[1] + 1;
+        }));
+    }
+    for (auto& t : producers)
+        t.join();
+
+    EXPECT_EQ(total, kProducers * kPerProducer);
+    EXPECT_TRUE(in_order);
+}
+
+TEST(ShmRingTest, DoorbellWakesSleepingConsumer) {
+    auto consumer = ShmRing::create(test_ring_name("bell"), 8, 64);
+    auto producer = ShmRing::open(test_ring_name("bell"));
+
+    std::thread t([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        producer->push("wake", 4);
+    });
+    auto start = std::chrono::steady_clock::now();
+    while (consumer->empty())
+        consumer->wait(std::chrono::milliseconds(5000));
+    auto waited = std::chrono::steady_clock::now() - start;
+    t.join();
+
+    EXPECT_LT(waited, std::chrono::seconds(4));
+    EXPECT_EQ(drain(*consumer), (std::vector<std::string>{"wake"}));
+}
+
+TEST(ShmRingTest, WaitTimesOutWhenIdle) {
+    auto ring = ShmRing::create(test_ring_name("idle"), 8, 64);
+    auto start = std::chrono::steady_clock::now();
+    ring->wait(std::chrono::milliseconds(20));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(15));
+}
+
+TEST(ShmTransportTest, RingNames) {
+    EXPECT_EQ(shm::ring_name("tcp://localhost:5001"), "/actors-5001");
+    EXPECT_EQ(shm::ring_name("tcp://0.0.0.0:5001"), "/actors-5001");
+    EXPECT_EQ(shm::ring_name("tcp://*:5001"), "/actors-5001");
+    EXPECT_EQ(shm::ring_name("ipc:///tmp/x"), "");
+    EXPECT_EQ(shm::ring_name("tcp://localhost"), "");
+}
+
+TEST(ShmTransportTest, LocalHostDetection) {
+    EXPECT_TRUE(shm::is_local_host("tcp://localhost:5001"));
+    EXPECT_TRUE(shm::is_local_host("tcp://127.0.0.1:5001"));
+    EXPECT_TRUE(shm::is_local_host("tcp://*:5001"));
+    EXPECT_FALSE(shm::is_local_host("tcp://10.255.255.1:5001"));
+    EXPECT_FALSE(shm::is_local_host("ipc:///tmp/x"));
+
+    char self[256] = {0};
+    ASSERT_EQ(::gethostname(self, sizeof(self) - 1), 0);
+    EXPECT_TRUE(shm::is_local_host(std::string("tcp://") + self + ":5001"));
+}
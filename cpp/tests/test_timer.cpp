@@ -0,0 +1,257 @@
+/*
+ * Tests for TimerWheel and Timer
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/act/Timer.hpp"
+#include "actors/act/TimerWheel.hpp"
+#include "actors/msg/Timeout.hpp"
+
+using namespace actors;
+using namespace std::chrono;
+
+namespace {
+
+// Not run by a thread: fired timeouts simply accumulate in the mailbox
+class Target : public Actor {
+public:
+    int first_data() const {
+        auto* t = dynamic_cast<const msg::Timeout*>(peek());
+        return t ? t->data : -1;
+    }
+};
+
+struct Tick : public Message_N<4985> {};
+
+// Fed by the test thread on an SPSC mailbox while a periodic timer fires
+class SpscTicker : public Actor {
+public:
+    std::atomic<int> ticks{0};
+    std::atomic<int> timeouts{0};
+
+    SpscTicker() {
+        strncpy(name, "SpscTicker", sizeof(name) - 1);
+        MESSAGE_HANDLER(Tick, on_tick);
+        MESSAGE_HANDLER(msg::Timeout, on_timeout);
+    }
+    void on_tick(const Tick*) noexcept { ticks++; }
+    void on_timeout(const msg::Timeout*) noexcept { timeouts++; }
+};
+
+// Handles each Timeout inside send(), on the wheel's thread, slowly
+class SlowTarget : public Actor {
+public:
+    TimerWheel* wheel = nullptr;
+    TimerHandle self;  // Cancelled from inside send() when set
+    std::atomic<bool> in_send{false};
+    std::atomic<int> sent{0};
+
+    void send(const Message* m, Actor* = nullptr) noexcept override {
+        in_send = true;
+        if (self)
+            wheel->cancel_and_wait(self);
+        std::this_thread::sleep_for(milliseconds(50));
+        m->release();
+        sent++;
+        in_send = false;
+    }
+};
+
+class TimerManager : public Manager {
+public:
+    TimerManager() { strncpy(name, "TimerManager", sizeof(name) - 1); }
+};
+
+template <class Pred>
+bool wait_for(Pred pred, int ms = 5000) {
+    for (int i = 0; i < ms; i++) {
+        if (pred())
+            return true;
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST(TimerWheelTest, OneShotFires) {
+    TimerWheel wheel(milliseconds(1));
+    Target t;
+    auto start = steady_clock::now();
+    auto h = wheel.schedule(&t, milliseconds(20), 42);
+    EXPECT_TRUE(h);
+    EXPECT_EQ(wheel.pending(), 1u);
+
+    ASSERT_TRUE(wait_for([&]() { return t.queue_length() == 1; }));
+    EXPECT_GE(steady_clock::now() - start, milliseconds(20));
+    EXPECT_EQ(t.first_data(), 42);
+    EXPECT_EQ(wheel.pending(), 0u);
+    EXPECT_FALSE(wheel.cancel(h));  // already fired
+}
+
+TEST(TimerWheelTest, CancelBeforeFire) {
+    TimerWheel wheel(milliseconds(1));
+    Target t;
+    auto h = wheel.schedule(&t, milliseconds(30), 1);
+    EXPECT_TRUE(wheel.cancel(h));
+    EXPECT_FALSE(wheel.cancel(h));
+    EXPECT_FALSE(wheel.cancel(TimerHandle{}));
+    std::this_thread::sleep_for(milliseconds(60));
+    EXPECT_EQ(t.queue_length(), 0u);
+}
+
+TEST(TimerWheelTest, PeriodicUntilCancelled) {
+    TimerWheel wheel(milliseconds(1));
+    Target t;
+    auto h = wheel.schedule(&t, milliseconds(5), 3, milliseconds(5));
+
+    ASSERT_TRUE(wait_for([&]() { return t.queue_length() >= 4; }));
+    EXPECT_TRUE(wheel.cancel(h));
+    auto n = t.queue_length();
+    std::this_thread::sleep_for(milliseconds(30));
+    EXPECT_LE(t.queue_length(), n + 1);  // at most one already in flight
+    EXPECT_EQ(t.first_data(), 3);
+}
+
+TEST(TimerWheelTest, VirtualTimeAdvancesOnDemand) {
+    TimerWheel wheel(milliseconds(1));
+    Target a, b, c;
+    wheel.set_virtual(true);
+    auto t0 = wheel.now();
+    wheel.schedule(&b, hours(2), 2);
+    wheel.schedule(&a, hours(1), 1);
+    wheel.schedule(&c, hours(1), 3);
+    std::this_thread::sleep_for(milliseconds(5));
+    EXPECT_EQ(wheel.now(), t0);  // Stands still
+
+    EXPECT_EQ(wheel.advance(t0 + minutes(30)), 0u);
+    EXPECT_EQ(wheel.advance(steady_clock::time_point::max()), 2u);
+    EXPECT_EQ(wheel.now() - t0, hours(1));
+    EXPECT_EQ(a.first_data(), 1);
+    EXPECT_EQ(c.first_data(), 3);
+    EXPECT_EQ(b.queue_length(), 0u);
+
+    EXPECT_EQ(wheel.advance(steady_clock::time_point::max()), 1u);
+    EXPECT_EQ(wheel.now() - t0, hours(2));
+    EXPECT_EQ(wheel.advance(steady_clock::time_point::max()), 0u);
+
+    // Back on the clock, time carries on from the virtual present
+    wheel.set_virtual(false);
+    EXPECT_GE(wheel.now() - t0, hours(2));
+    wheel.schedule(&a, milliseconds(5), 4);
+    ASSERT_TRUE(wait_for([&]() { return a.queue_length() == 2; }));
+}
+
+TEST(TimerWheelTest, CascadesFromCoarseLevels) {
+    // 100 us ticks: 60 ms is 600 ticks, past the 256-slot first level
+    TimerWheel wheel(microseconds(100));
+    Target early, late;
+    auto start = steady_clock::now();
+    wheel.schedule(&late, milliseconds(60), 2);
+    wheel.schedule(&early, milliseconds(10), 1);
+
+    ASSERT_TRUE(wait_for([&]() { return early.queue_length() == 1; }));
+    EXPECT_EQ(late.queue_length(), 0u);
+    ASSERT_TRUE(wait_for([&]() { return late.queue_length() == 1; }));
+    EXPECT_GE(steady_clock::now() - start, milliseconds(60));
+    EXPECT_EQ(late.first_data(), 2);
+}
+
+TEST(TimerWheelTest, CascadesFromThirdLevel) {
+    // 10 us ticks: 200 ms is 20000 ticks, past the first two levels
+    TimerWheel wheel(microseconds(10));
+    Target t;
+    auto start = steady_clock::now();
+    wheel.schedule(&t, milliseconds(200), 5);
+
+    ASSERT_TRUE(wait_for([&]() { return t.queue_length() == 1; }));
+    auto elapsed = steady_clock::now() - start;
+    EXPECT_GE(elapsed, milliseconds(200));
+    EXPECT_LT(elapsed, milliseconds(1000));
+}
+
+TEST(TimerWheelTest, EarlierTimerWakesSleepingThread) {
+    TimerWheel wheel(milliseconds(1));
+    Target slow, fast;
+    wheel.schedule(&slow, seconds(10), 1);
+    std::this_thread::sleep_for(milliseconds(10));  // Thread now sleeps until the 10 s slot
+
+    auto start = steady_clock::now();
+    wheel.schedule(&fast, milliseconds(5), 2);
+    ASSERT_TRUE(wait_for([&]() { return fast.queue_length() == 1; }));
+    EXPECT_LT(steady_clock::now() - start, milliseconds(1000));
+    EXPECT_EQ(slow.queue_length(), 0u);
+    EXPECT_EQ(wheel.pending(), 1u);
+}
+
+TEST(TimerWheelTest, CancelAndWaitWaitsForDelivery) {
+    TimerWheel wheel(milliseconds(1));
+    SlowTarget t;
+    auto h = wheel.schedule(&t, milliseconds(1), 0, milliseconds(1));
+    ASSERT_TRUE(wait_for([&]() { return t.in_send.load(); }));
+
+    wheel.cancel_and_wait(h);
+    EXPECT_FALSE(t.in_send);
+    int n = t.sent;
+    std::this_thread::sleep_for(milliseconds(20));
+    EXPECT_EQ(t.sent, n);  // Fired ticks still queued were dropped
+}
+
+TEST(TimerWheelTest, CancelAndWaitFromOwnDelivery) {
+    TimerWheel wheel(milliseconds(1));
+    SlowTarget t;
+    t.wheel = &wheel;
+    t.self = wheel.schedule(&t, milliseconds(20), 0, milliseconds(1));
+    ASSERT_TRUE(wait_for([&]() { return t.sent == 1; }));  // No deadlock
+    std::this_thread::sleep_for(milliseconds(20));
+    EXPECT_EQ(t.sent, 1);
+    EXPECT_EQ(wheel.pending(), 0u);
+}
+
+TEST(TimerWheelTest, ManyTimersOneThread) {
+    TimerWheel wheel(milliseconds(1));
+    Target t;
+    std::vector<TimerHandle> handles;
+    for (int i = 0; i < 1000; i++)
+        handles.push_back(wheel.schedule(&t, milliseconds(1 + i % 40), i));
+    for (int i = 0; i < 1000; i += 2)
+        EXPECT_TRUE(wheel.cancel(handles[i]));
+
+    ASSERT_TRUE(wait_for([&]() { return t.queue_length() == 500; }));
+    std::this_thread::sleep_for(milliseconds(10));
+    EXPECT_EQ(t.queue_length(), 500u);
+    EXPECT_EQ(wheel.pending(), 0u);
+}
+
+TEST(TimerWheelTest, TimerFacadeUsesSharedWheel) {
+    Target t;
+    auto h = Timer::wake_up_in(&t, 0, 5, 9);
+    EXPECT_TRUE(h);
+    ASSERT_TRUE(wait_for([&]() { return t.queue_length() == 1; }));
+    EXPECT_EQ(t.first_data(), 9);
+
+    auto p = Timer::wake_up_every(&t, 1000);
+    EXPECT_TRUE(Timer::cancel(p));
+}
+
+TEST(TimerWheelTest, TimersReachSpscMailbox) {
+    // Timeouts come from the wheel's thread, Ticks from this one
+    TimerManager mgr;
+    auto* a = new SpscTicker();
+    mgr.manage(a, {}, 0, SCHED_OTHER, MailboxType::SPSC, 64);
+    mgr.init();
+
+    auto h = Timer::wake_up_every(a, 1);
+    for (int i = 0; i < 20000; i++)
+        a->send(new Tick());
+    ASSERT_TRUE(wait_for([&]() { return a->ticks == 20000 && a->timeouts >= 3; }));
+    EXPECT_TRUE(Timer::cancel(h));
+
+    mgr.shutdown(std::chrono::seconds(1));
+    delete a;
+}
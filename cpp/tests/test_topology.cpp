@@ -0,0 +1,156 @@
+/*
+ * Tests for CPU topology discovery and traffic-based actor placement
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include "actors/Topology.hpp"
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+using namespace actors;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Hop : public Message_N<4921> {};
+
+class Peer : public Actor {
+public:
+    Actor* next = nullptr;
+    std::atomic<int> hops{0};
+
+    explicit Peer(const char* n) {
+        strncpy(name, n, sizeof(name) - 1);
+        MESSAGE_HANDLER(Hop, on_hop);
+    }
+    void on_hop(const Hop*) noexcept {
+        if (++hops < 20 && next)
+            next->send(new Hop(), this);
+    }
+};
+
+class PlacementManager : public Manager {
+public:
+    PlacementManager() { strncpy(name, "PlacementManager", sizeof(name) - 1); }
+};
+
+// 2 nodes x 2 cores x 2 hyperthreads; siblings are n and n + 4 as on most x86 boxes
+Topology two_sockets() {
+    std::vector<CpuInfo> cpus;
+    for (int cpu = 0; cpu < 8; cpu++) {
+        int core = cpu % 4;
+        cpus.push_back({cpu, core, core / 2, core / 2});
+    }
+    return Topology(cpus);
+}
+
+void write_file(const std::filesystem::path& p, const std::string& text) {
+    std::filesystem::create_directories(p.parent_path());
+    std::ofstream(p) << text << "\n";
+}
+
+}  // namespace
+
+TEST(TopologyTest, DiscoversFromSysfs) {
+    auto root = std::filesystem::path(testing::TempDir()) / "topology_test";
+    std::filesystem::remove_all(root);
+    write_file(root / "cpu/online", "0-2,5");
+    int core[] = {0, 1, 0, 0, 0, 1};
+    int package[] = {0, 0, 1, 0, 0, 1};
+    for (int cpu : {0, 1, 2, 5}) {
+        auto dir = root / ("cpu/cpu" + std::to_string(cpu)) / "topology";
+        write_file(dir / "core_id", std::to_string(core[cpu]));
+        write_file(dir / "physical_package_id", std::to_string(package[cpu]));
+    }
+    write_file(root / "node/node0/cpulist", "0-1");
+    write_file(root / "node/node1/cpulist", "2-3,5");
+
+    Topology topo = Topology::discover(root.string());
+    std::filesystem::remove_all(root);
+
+    ASSERT_EQ(topo.cpus().size(), 4u);
+    EXPECT_EQ(topo.node_count(), 2);
+    EXPECT_EQ(topo.node_of(1), 0);
+    EXPECT_EQ(topo.node_of(5), 1);
+    EXPECT_EQ(topo.node_of(3), -1);  // Offline
+    EXPECT_EQ(topo.node_of(std::set<int>{2, 5}), 1);
+    EXPECT_EQ(topo.node_of(std::set<int>{1, 2}), -1);
+    EXPECT_EQ(topo.distance(0, 1), 2);
+    EXPECT_EQ(topo.distance(2, 5), 2);
+    EXPECT_EQ(topo.distance(0, 5), 4);
+}
+
+TEST(TopologyTest, Distances) {
+    Topology topo = two_sockets();
+    EXPECT_EQ(topo.distance(1, 1), 0);
+    EXPECT_EQ(topo.distance(1, 5), 1);  // Siblings
+    EXPECT_EQ(topo.distance(0, 1), 2);
+    EXPECT_EQ(topo.distance(0, 2), 4);
+    EXPECT_EQ(topo.cpus()[1].cpu, 4);  // Ordered by core, so siblings are adjacent
+}
+
+TEST(PlacementTest, TalkersShareACore) {
+    Topology topo = two_sockets();
+    std::vector<ActorId> actors = {1, 2, 3, 4, 5};
+    std::vector<Traffic> traffic = {
+        {1, 3, 1000}, {3, 1, 900},   // 1 <-> 3 heaviest
+        {2, 4, 800},                 // then 2 <-> 4
+        {1, 2, 10},
+    };
+    auto cpus = place_by_traffic(topo, {0, 1, 2, 3, 4, 5, 6, 7}, actors, traffic);
+    ASSERT_EQ(cpus.size(), 5u);
+    EXPECT_EQ(topo.distance(cpus[0], cpus[2]), 1);
+    EXPECT_EQ(topo.distance(cpus[1], cpus[3]), 1);
+    std::set<int> distinct(cpus.begin(), cpus.end());
+    EXPECT_EQ(distinct.size(), 5u);
+
+    // Fewer CPUs than actors: CPUs are shared, none left out
+    auto shared = place_by_traffic(topo, {2, 6}, actors, traffic);
+    for (int cpu : shared)
+        EXPECT_TRUE(cpu == 2 || cpu == 6);
+    EXPECT_EQ(shared[0], shared[2] == 2 ? 6 : 2);
+}
+
+TEST(PlacementTest, ManagerCountsTrafficAndColocates) {
+    PlacementManager mgr;
+    mgr.set_placement(Placement::NUMA);
+    auto* a = new Peer("PeerA");
+    auto* b = new Peer("PeerB");
+    a->next = b;
+    b->next = a;
+    mgr.manage(a);
+    mgr.manage(b);
+    mgr.init();
+
+    a->send(new Hop(), b);
+    for (int i = 0; i < 500 && a->hops + b->hops < 20; i++)
+        std::this_thread::sleep_for(10ms);
+    ASSERT_GE(a->hops + b->hops, 20);
+
+    uint64_t a_to_b = 0;
+    for (auto& t : mgr.get_traffic())
+        if (t.from == a->get_id() && t.to == b->get_id())
+            a_to_b = t.messages;
+    EXPECT_GE(a_to_b, 9u);
+
+    auto plan = mgr.colocate();
+    ASSERT_EQ(plan.size(), 2u);
+    const Topology& topo = Topology::system();
+    EXPECT_NE(topo.find(plan["PeerA"]), nullptr);
+    if (topo.cpus().size() > 1) {
+        EXPECT_NE(plan["PeerA"], plan["PeerB"]);
+    }
+
+    a->send(new msg::Shutdown());
+    b->send(new msg::Shutdown());
+    mgr.end();
+    delete a;
+    delete b;
+}
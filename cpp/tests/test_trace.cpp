@@ -0,0 +1,162 @@
+/*
+ * Tests for binary event tracing and the Chrome trace export
+ */
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "actors/Trace.hpp"
+#include "actors/Actor.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+using namespace actors;
+using nlohmann::json;
+
+namespace {
+
+struct Tick : public Message_N<4901> {};
+
+class Echo : public Actor {
+public:
+    explicit Echo(const char* n) {
+        strncpy(name, n, sizeof(name) - 1);
+        MESSAGE_HANDLER(Tick, on_tick);
+    }
+    void on_tick(const Tick*) noexcept {}
+};
+
+class TraceManager : public Manager {
+public:
+    TraceManager() { strncpy(name, "TraceManager", sizeof(name) - 1); }
+};
+
+// Runs fn on a new thread so it records into a ring of its own
+template <class Fn>
+std::vector<trace::Event> on_thread(Fn fn) {
+    pid_t tid = 0;
+    std::thread([&] {
+        tid = static_cast<pid_t>(syscall(SYS_gettid));
+        fn();
+    }).join();
+    for (auto& t : trace::snapshot())
+        if (t.tid == tid)
+            return t.events;
+    return {};
+}
+
+json read_json(const std::string& path) {
+    std::ifstream f(path);
+    return json::parse(f);
+}
+
+}  // namespace
+
+TEST(TraceTest, RecordsNothingWhileDisabled) {
+    trace::enable(false);
+    auto events = on_thread([] {
+        trace::record(trace::Kind::ENQUEUE, 1, 1, 2);
+        EXPECT_EQ(trace::new_flow(), 0u);
+    });
+    EXPECT_TRUE(events.empty());
+}
+
+TEST(TraceTest, RingKeepsNewestEvents) {
+    trace::enable(true);
+    const int n = int(trace::Ring::SIZE) + 100;
+    auto events = on_thread([n] {
+        for (int i = 0; i < n; i++)
+            trace::record(trace::Kind::DEQUEUE, i, 0, 0);
+    });
+    trace::enable(false);
+
+    // The slot to be written next is treated as overwritten
+    ASSERT_EQ(events.size(), trace::Ring::SIZE - 1);
+    EXPECT_EQ(events.back().msg_id, n - 1);
+    EXPECT_EQ(events.front().msg_id, n - int(trace::Ring::SIZE) + 1);
+    for (size_t i = 1; i < events.size(); i++)
+        ASSERT_LE(events[i - 1].tsc, events[i].tsc);
+
+    trace::clear();
+    auto again = on_thread([] {});
+    EXPECT_TRUE(again.empty());
+}
+
+TEST(TraceTest, WritesChromeJsonWithFlows) {
+    trace::clear();
+    trace::enable(true);
+    trace::name_actor(4901, "sender");
+    trace::name_actor(4902, "receiver \"q\"");
+    on_thread([] {
+        trace::record(trace::Kind::HANDLER_END, 7, 0, 4902);  // Orphan: its begin was lost
+        uint64_t flow = trace::new_flow();
+        EXPECT_NE(flow, 0u);
+        trace::record(trace::Kind::ENQUEUE, 7, 4901, 4902, flow);
+        trace::record(trace::Kind::DEQUEUE, 7, 4901, 4902, flow);
+        trace::record(trace::Kind::HANDLER_BEGIN, 7, 4901, 4902, flow);
+        trace::record(trace::Kind::HANDLER_END, 7, 4901, 4902);
+    });
+    trace::enable(false);
+
+    std::string path = testing::TempDir() + "trace_test.json";
+    ASSERT_TRUE(trace::write_chrome_json(path));
+    json doc = read_json(path);
+    std::remove(path.c_str());
+
+    std::multiset<std::string> phases;
+    std::string flow_start, flow_end;
+    for (auto& e : doc["traceEvents"]) {
+        phases.insert(e["ph"].get<std::string>());
+        if (e["ph"] == "B") {
+            EXPECT_EQ(e["name"], "receiver \"q\" msg 7");
+            EXPECT_EQ(e["args"]["from"], "sender");
+        }
+        if (e["ph"] == "s")
+            flow_start = e["id"];
+        if (e["ph"] == "f")
+            flow_end = e["id"];
+    }
+    EXPECT_EQ(phases.count("B"), 1u);
+    EXPECT_EQ(phases.count("E"), 1u);
+    EXPECT_EQ(phases.count("i"), 2u);
+    EXPECT_FALSE(flow_start.empty());
+    EXPECT_EQ(flow_start, flow_end);
+    trace::clear();
+}
+
+TEST(TraceTest, ActorsRecordSendAndHandler) {
+#ifndef ACTOR_TRACE
+    GTEST_SKIP() << "build with make TRACE=1";
+#else
+    trace::clear();
+    TraceManager mgr;
+    auto* echo = new Echo("TraceEcho");
+    mgr.manage(echo);
+    mgr.init();
+
+    trace::enable(true);
+    echo->send(new Tick());
+    echo->send(new msg::Shutdown());
+    mgr.end();
+    trace::enable(false);
+
+    std::string path = testing::TempDir() + "trace_actor.json";
+    ASSERT_TRUE(trace::write_chrome_json(path));
+    json doc = read_json(path);
+    std::remove(path.c_str());
+
+    bool handled = false;
+    for (auto& e : doc["traceEvents"])
+        if (e["ph"] == "B" && e["name"] == "TraceEcho msg 4901")
+            handled = true;
+    EXPECT_TRUE(handled);
+    trace::clear();
+    delete echo;
+#endif
+}
@@ -0,0 +1,130 @@
+/*
+ * Tests for TypedRef, the statically typed local actor reference
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+#include "actors/Actor.hpp"
+#include "actors/TypedRef.hpp"
+#include "actors/act/Manager.hpp"
+#include "actors/msg/Shutdown.hpp"
+
+using namespace actors;
+using namespace std::chrono_literals;
+
+namespace {
+
+struct Order : public Message_N<4981> {
+    int qty;
+    explicit Order(int q) : qty(q) {}
+};
+struct Cancel : public Message_N<4982> {};
+struct Filled : public Message_N<4983> {
+    int qty;
+    explicit Filled(int q) : qty(q) {}
+};
+struct Quote : public Message_N<4984> {};
+
+class Book : public Actor {
+public:
+    std::atomic<int> ordered{0};
+    std::atomic<int> cancels{0};
+    std::atomic<int> fills{0};
+
+    Book() {
+        strncpy(name, "Book", sizeof(name) - 1);
+        MESSAGE_HANDLER(Order, on_order);
+        MESSAGE_HANDLER(Cancel, on_cancel);
+        MESSAGE_HANDLER(Filled, on_filled);
+    }
+    void on_order(const Order* m) noexcept {
+        ordered += m->qty;
+        reply(new Filled(m->qty));
+    }
+    void on_cancel(const Cancel*) noexcept { cancels++; }
+    void on_filled(const Filled*) noexcept { fills++; }
+};
+
+// Handlers only ever run on its own thread once it is running
+class AsyncBook : public Book {
+public:
+    AsyncBook() { dispatch_mode = DispatchMode::ASYNC_ONLY; }
+};
+
+class TypedManager : public Manager {
+public:
+    TypedManager() { strncpy(name, "TypedManager", sizeof(name) - 1); }
+};
+
+using BookRef = TypedRef<Order, Cancel>;
+
+// What send() accepts is decided at compile time
+static_assert(BookRef::accepts<Order> && BookRef::accepts<const Cancel>);
+static_assert(!BookRef::accepts<Quote> && !BookRef::accepts<Filled>);
+static_assert(sizeof(BookRef) == sizeof(Actor*) && std::is_trivially_copyable_v<BookRef>);
+static_assert(std::is_convertible_v<BookRef, TypedRef<Cancel>>);
+static_assert(!std::is_convertible_v<TypedRef<Cancel>, BookRef>);
+static_assert(!std::is_convertible_v<BookRef, TypedRef<Quote>>);
+
+}  // namespace
+
+TEST(TypedRefTest, SendsToTheActor) {
+    TypedManager mgr;
+    auto* book = new Book();
+    mgr.manage(book);
+    BookRef ref(book);
+    TypedRef<Cancel> canceller = ref;
+    mgr.init();
+
+    ref.send(new Order(3), book);  // Replies come back to book itself
+    ref.send(new Order(4), Lane::HIGH, book);
+    canceller.send(new Cancel());
+    mgr.shutdown(1s);
+
+    EXPECT_EQ(book->ordered, 7);
+    EXPECT_EQ(book->fills, 2);
+    EXPECT_EQ(book->cancels, 1);
+    EXPECT_EQ(canceller.actor(), book);
+    EXPECT_EQ(ref.id(), book->get_id());
+    delete book;
+}
+
+TEST(TypedRefTest, FastSendAndDynamicRef) {
+    Book book;
+    BookRef ref(&book);
+    Order order(5);
+    auto reply = ref.fast_send(&order, nullptr);
+    ASSERT_NE(reply, nullptr);
+    EXPECT_EQ(static_cast<const Filled*>(reply.get())->qty, 5);
+
+    ActorRef dynamic = ref.ref();
+    EXPECT_TRUE(dynamic.is_local());
+    EXPECT_EQ(dynamic.actor(), &book);
+    EXPECT_STREQ(ref.name(), "Book");
+
+    BookRef empty;
+    EXPECT_FALSE(empty);
+    EXPECT_EQ(empty.id(), NO_ACTOR_ID);
+    EXPECT_TRUE(ref == BookRef(&book));
+}
+
+TEST(TypedRefTest, DynamicFastSendRefusesRunningAsyncOnlyActor) {
+    TypedManager mgr;
+    auto* book = new AsyncBook();
+    mgr.manage(book);
+    ActorRef dynamic(book);
+    Order order(3);
+    EXPECT_TRUE(book->accepts_fast_send());
+    EXPECT_NE(dynamic.fast_send(&order, nullptr), nullptr);
+
+    mgr.init();
+    EXPECT_FALSE(book->accepts_fast_send());
+    EXPECT_THROW(dynamic.fast_send(&order, nullptr), std::runtime_error);
+    EXPECT_EQ(book->ordered.load(), 3);
+
+    book->send(new msg::Shutdown());
+    mgr.end();
+    delete book;
+}
@@ -0,0 +1,348 @@
+/*
+ * Tests for the binary wire format and binary message codecs
+ */
+
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include "actors/remote/Serialization.hpp"
+#include "actors/remote/Wire.hpp"
+#include "actors/remote/WireHello.hpp"
+
+using namespace actors;
+
+namespace {
+
+enum class Side : std::uint8_t { BUY = 1, SELL = 2 };
+
+struct WirePing : public Message_N<140> {
+    int count;
+    WirePing(int c = 0) : count(c) {}
+};
+
+struct WireQuote : public Message_N<141> {
+    std::string symbol;
+    double price;
+    std::int64_t qty;
+    Side side;
+    std::vector<int> levels;
+    WireQuote() : price(0), qty(0), side(Side::BUY) {}
+    WireQuote(std::string s, double p, std::int64_t q, Side sd, std::vector<int> l)
+        : symbol(std::move(s)), price(p), qty(q), side(sd), levels(std::move(l)) {}
+};
+
+struct WireEmpty : public Message_N<142> {};
+
+// A field type without a binary encoding keeps the message JSON-only
+using ValueMap = std::map<std::string, int>;
+
+struct WireMapped : public Message_N<143> {
+    ValueMap values;
+    WireMapped() = default;
+    WireMapped(ValueMap v) : values(std::move(v)) {}
+};
+
+} // namespace
+
+REGISTER_REMOTE_MESSAGE_1(WirePing, count, int)
+REGISTER_REMOTE_MESSAGE_5(WireQuote, symbol, std::string, price, double, qty, std::int64_t, side, Side, levels, std::vector<int>)
+REGISTER_REMOTE_MESSAGE_0(WireEmpty)
+REGISTER_REMOTE_MESSAGE_1(WireMapped, values, ValueMap)
+
+TEST(WireTest, ScalarsRoundTrip) {
+    std::string buf;
+    wire::BinaryWriter w(buf);
+    w.put(true);
+    w.put(std::int8_t(-3));
+    w.put(std::uint16_t(0xBEEF));
+    w.put(-123456789);
+    w.put(std::uint64_t(0x0102030405060708ULL));
+    w.put(1.5f);
+    w.put(-2.25);
+    w.put(Side::SELL);
+    EXPECT_EQ(buf.size(), 1u + 1 + 2 + 4 + 8 + 4 + 8 + 1);
+
+    wire::BinaryReader r(buf.data(), buf.size());
+    EXPECT_TRUE(r.get<bool>());
+    EXPECT_EQ(r.get<std::int8_t>(), -3);
+    EXPECT_EQ(r.get<std::uint16_t>(), 0xBEEF);
+    EXPECT_EQ(r.get<int>(), -123456789);
+    EXPECT_EQ(r.get<std::uint64_t>(), 0x0102030405060708ULL);
+    EXPECT_EQ(r.get<float>(), 1.5f);
+    EXPECT_EQ(r.get<double>(), -2.25);
+    EXPECT_EQ(r.get<Side>(), Side::SELL);
+    EXPECT_EQ(r.remaining(), 0u);
+}
+
+TEST(WireTest, IntegersAreLittleEndian) {
+    std::string buf;
+    wire::BinaryWriter w(buf);
+    w.put(std::uint32_t(0x11223344));
+    ASSERT_EQ(buf.size(), 4u);
+    EXPECT_EQ(std::uint8_t(buf[0]), 0x44);
+    EXPECT_EQ(std::uint8_t(buf[3]), 0x11);
+}
+
+TEST(WireTest, StringsAndVectorsRoundTrip) {
+    std::string buf;
+    wire::BinaryWriter w(buf);
+    w.put(std::string("hello"));
+    w.put(std::string());
+    w.put(std::vector<std::string>{"a", "bc"});
+    w.put(std::vector<double>{1.0, 2.0, 3.0});
+
+    wire::BinaryReader r(buf.data(), buf.size());
+    EXPECT_EQ(r.get<std::string>(), "hello");
+    EXPECT_EQ(r.get<std::string>(), "");
+    EXPECT_EQ(r.get<std::vector<std::string>>(), (std::vector<std::string>{"a", "bc"}));
+    EXPECT_EQ(r.get<std::vector<double>>(), (std::vector<double>{1.0, 2.0, 3.0}));
+    EXPECT_EQ(r.remaining(), 0u);
+}
+
+TEST(WireTest, TruncatedReadThrows) {
+    std::string buf;
+    wire::BinaryWriter w(buf);
+    w.put(std::string("hello"));
+    buf.pop_back();
+
+    wire::BinaryReader r(buf.data(), buf.size());
+    EXPECT_THROW(r.get<std::string>(), wire::WireError);
+}
+
+TEST(WireTest, OversizedVectorLengthThrows) {
+    std::string buf;
+    wire::BinaryWriter w(buf);
+    w.put(std::uint32_t(1000000));
+
+    wire::BinaryReader r(buf.data(), buf.size());
+    EXPECT_THROW(r.get<std::vector<int>>(), wire::WireError);
+}
+
+TEST(WireTest, EncodableTraits) {
+    EXPECT_TRUE(wire::is_encodable_v<int>);
+    EXPECT_TRUE(wire::is_encodable_v<Side>);
+    EXPECT_TRUE(wire::is_encodable_v<std::string>);
+    EXPECT_TRUE(wire::is_encodable_v<std::vector<std::vector<int>>>);
+    EXPECT_FALSE(wire::is_encodable_v<std::vector<bool>>);
+    EXPECT_FALSE(wire::is_encodable_v<ValueMap>);
+}
+
+TEST(WireTest, FrameHeaderByName) {
+    std::string frame;
+    wire::begin_frame(frame, 140, 0, "pong", "ping", "tcp://localhost:5002");
+    size_t start = frame.size();
+    wire::BinaryWriter w(frame);
+    w.put(7);
+    wire::finish_frame(frame, start);
+
+    ASSERT_TRUE(wire::is_binary(frame.data(), frame.size()));
+    wire::Frame f = wire::parse_frame(frame.data(), frame.size());
+    EXPECT_EQ(f.message_id, 140);
+    EXPECT_EQ(f.receiver_id, 0u);
+    EXPECT_EQ(f.receiver, "pong");
+    EXPECT_TRUE(f.has_sender);
+    EXPECT_EQ(f.sender_actor, "ping");
+    EXPECT_EQ(f.sender_endpoint, "tcp://localhost:5002");
+    ASSERT_EQ(f.payload_len, 4u);
+
+    wire::BinaryReader r(f.payload, f.payload_len);
+    EXPECT_EQ(r.get<int>(), 7);
+}
+
+TEST(WireTest, FrameHeaderByIdWithoutSender) {
+    std::string frame;
+    wire::begin_frame(frame, 140, 3, "pong", "", "");
+    size_t start = frame.size();
+    wire::BinaryWriter w(frame);
+    w.put(7);
+    wire::finish_frame(frame, start);
+
+    // Interned receiver and no sender: just the fixed header and payload
+    EXPECT_EQ(frame.size(), wire::HEADER_SIZE + 4);
+    wire::Frame f = wire::parse_frame(frame.data(), frame.size());
+    EXPECT_EQ(f.receiver_id, 3u);
+    EXPECT_TRUE(f.receiver.empty());
+    EXPECT_FALSE(f.has_sender);
+}
+
+TEST(WireTest, FrameCarriesCorrelationId) {
+    std::string request;
+    wire::begin_frame(request, 140, 0, "pong", "$ask:42", "tcp://localhost:5002", 42);
+    wire::finish_frame(request, request.size());
+    wire::Frame f = wire::parse_frame(request.data(), request.size());
+    EXPECT_TRUE(f.is_request);
+    EXPECT_FALSE(f.is_reply);
+    EXPECT_EQ(f.correlation_id, 42u);
+    EXPECT_EQ(f.sender_actor, "$ask:42");
+    EXPECT_EQ(f.payload_len, 0u);
+
+    std::string reply;
+    wire::begin_frame(reply, 140, 0, "$ask:42", "", "", 42, true);
+    size_t start = reply.size();
+    wire::BinaryWriter w(reply);
+    w.put(7);
+    wire::finish_frame(reply, start);
+    f = wire::parse_frame(reply.data(), reply.size());
+    EXPECT_FALSE(f.is_request);
+    EXPECT_TRUE(f.is_reply);
+    EXPECT_EQ(f.correlation_id, 42u);
+    EXPECT_EQ(f.payload_len, 4u);
+
+    // No correlation: no id on the wire
+    std::string plain;
+    wire::begin_frame(plain, 140, 3, "pong", "", "");
+    f = wire::parse_frame(plain.data(), plain.size());
+    EXPECT_FALSE(f.is_request || f.is_reply);
+    EXPECT_EQ(f.correlation_id, 0u);
+}
+
+TEST(WireTest, FrameCarriesFlowTag) {
+    wire::FlowTag tag{77, "tcp://localhost:5002", "tcp://localhost:5001"};
+    std::string out;
+    wire::begin_frame(out, 140, 0, "pong", "$ask:9", "tcp://localhost:5002", 9, false, &tag);
+    size_t start = out.size();
+    wire::BinaryWriter w(out);
+    w.put(5);
+    wire::finish_frame(out, start);
+    wire::Frame f = wire::parse_frame(out.data(), out.size());
+    ASSERT_TRUE(f.has_flow);
+    EXPECT_EQ(f.flow.session, 77u);
+    EXPECT_EQ(f.flow.reply_to, "tcp://localhost:5002");
+    EXPECT_EQ(f.flow.endpoint, "tcp://localhost:5001");
+    EXPECT_EQ(f.correlation_id, 9u);
+    EXPECT_EQ(f.payload_len, 4u);
+
+    std::string plain;
+    wire::begin_frame(plain, 140, 3, "pong", "", "");
+    EXPECT_FALSE(wire::parse_frame(plain.data(), plain.size()).has_flow);
+}
+
+TEST(WireTest, FrameCarriesSessionTag) {
+    // Without a sender the tag says where a WireReset goes
+    wire::SessionTag tag{0x1234567890ull, "tcp://localhost:5002"};
+    std::string out;
+    wire::begin_frame(out, 140, 3, "", "", "", 0, false, nullptr, &tag);
+    size_t start = out.size();
+    wire::BinaryWriter w(out);
+    w.put(5);
+    wire::finish_frame(out, start);
+    wire::Frame f = wire::parse_frame(out.data(), out.size());
+    ASSERT_TRUE(f.has_session);
+    EXPECT_EQ(f.session.session, 0x1234567890ull);
+    EXPECT_EQ(f.session.reply_to, "tcp://localhost:5002");
+    EXPECT_EQ(f.receiver_id, 3u);
+    EXPECT_EQ(f.payload_len, 4u);
+
+    // With one, the sender endpoint doubles as reply_to
+    std::string sent;
+    wire::begin_frame(sent, 140, 3, "", "ping", "tcp://localhost:5003", 0, false, nullptr, &tag);
+    wire::Frame g = wire::parse_frame(sent.data(), sent.size());
+    ASSERT_TRUE(g.has_session);
+    EXPECT_EQ(g.session.reply_to, "tcp://localhost:5003");
+
+    std::string plain;
+    wire::begin_frame(plain, 140, 3, "pong", "", "");
+    EXPECT_FALSE(wire::parse_frame(plain.data(), plain.size()).has_session);
+}
+
+TEST(WireTest, JsonIsNotBinary) {
+    std::string json = R"({"receiver":"pong","message_type":"Ping"})";
+    EXPECT_FALSE(wire::is_binary(json.data(), json.size()));
+}
+
+TEST(WireTest, MalformedFramesThrow) {
+    std::string frame;
+    wire::begin_frame(frame, 140, 0, "pong", "", "");
+    size_t start = frame.size();
+    wire::BinaryWriter w(frame);
+    w.put(7);
+    wire::finish_frame(frame, start);
+
+    std::string truncated = frame.substr(0, frame.size() - 1);
+    EXPECT_THROW(wire::parse_frame(truncated.data(), truncated.size()), wire::WireError);
+
+    std::string bad_version = frame;
+    bad_version[1] = 99;
+    EXPECT_THROW(wire::parse_frame(bad_version.data(), bad_version.size()), wire::WireError);
+}
+
+TEST(WireTest, RegisteredMessagesGetBinaryCodecs) {
+    auto& reg = serialization::MessageRegistry::instance();
+    EXPECT_TRUE(reg.has_binary(140));
+    EXPECT_TRUE(reg.has_binary(141));
+    EXPECT_TRUE(reg.has_binary(142));
+    EXPECT_FALSE(reg.has_binary(143));  // std::map field: JSON only
+    EXPECT_TRUE(serialization::is_registered("WireMapped"));
+    EXPECT_FALSE(reg.has_binary(11));   // WireHello is JSON only
+    EXPECT_FALSE(reg.has_binary(15));   // and so is WireReset
+}
+
+TEST(WireTest, MessageRoundTrip) {
+    auto& reg = serialization::MessageRegistry::instance();
+    WireQuote q("AAPL", 187.25, 300, Side::SELL, {1, 2, 3});
+
+    std::string buf;
+    wire::BinaryWriter w(buf);
+    ASSERT_TRUE(reg.encode(&q, w));
+
+    wire::BinaryReader r(buf.data(), buf.size());
+    std::unique_ptr<Message> m(reg.decode(141, r));
+    ASSERT_NE(m, nullptr);
+    EXPECT_EQ(r.remaining(), 0u);
+    auto* d = dynamic_cast<WireQuote*>(m.get());
+    ASSERT_NE(d, nullptr);
+    EXPECT_EQ(d->symbol, "AAPL");
+    EXPECT_EQ(d->price, 187.25);
+    EXPECT_EQ(d->qty, 300);
+    EXPECT_EQ(d->side, Side::SELL);
+    EXPECT_EQ(d->levels, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(WireTest, BinaryIsSmallerThanJson) {
+    WirePing p(42);
+    std::string frame;
+    wire::begin_frame(frame, p.id(), 1, "pong", "", "");
+    size_t start = frame.size();
+    wire::BinaryWriter w(frame);
+    ASSERT_TRUE(serialization::MessageRegistry::instance().encode(&p, w));
+    wire::finish_frame(frame, start);
+    EXPECT_EQ(frame.size(), wire::HEADER_SIZE + sizeof(int));
+
+    std::unique_ptr<Message> empty(new WireEmpty());
+    std::string buf;
+    wire::BinaryWriter w2(buf);
+    EXPECT_TRUE(serialization::MessageRegistry::instance().encode(empty.get(), w2));
+    EXPECT_TRUE(buf.empty());
+}
+
+TEST(WireTest, UnknownIdDecodesToNull) {
+    std::string buf;
+    wire::BinaryReader r(buf.data(), buf.size());
+    EXPECT_EQ(serialization::MessageRegistry::instance().decode(12345, r), nullptr);
+}
+
+TEST(WireTest, WireHelloJsonRoundTrip) {
+    msg::WireHello h("tcp://localhost:5001", {"pong", "quotes"}, {1, 2}, 99);
+    nlohmann::json j = serialization::serialize(&h);
+    std::unique_ptr<Message> m(serialization::deserialize("WireHello", j));
+    auto* d = dynamic_cast<msg::WireHello*>(m.get());
+    ASSERT_NE(d, nullptr);
+    EXPECT_EQ(d->endpoint, "tcp://localhost:5001");
+    EXPECT_EQ(d->actors, (std::vector<std::string>{"pong", "quotes"}));
+    EXPECT_EQ(d->ids, (std::vector<std::uint32_t>{1, 2}));
+    EXPECT_EQ(d->session, 99u);
+
+    // Hellos from peers without sessions
+    j.erase("session");
+    std::unique_ptr<Message> old(serialization::deserialize("WireHello", j));
+    EXPECT_EQ(dynamic_cast<msg::WireHello*>(old.get())->session, 0u);
+}
+
+TEST(WireTest, WireResetJsonRoundTrip) {
+    msg::WireReset r(0xFEDCBA9876543210ull);
+    nlohmann::json j = serialization::serialize(&r);
+    std::unique_ptr<Message> m(serialization::deserialize("WireReset", j));
+    auto* d = dynamic_cast<msg::WireReset*>(m.get());
+    ASSERT_NE(d, nullptr);
+    EXPECT_EQ(d->session, 0xFEDCBA9876543210ull);
+}
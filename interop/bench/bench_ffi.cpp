@@ -0,0 +1,151 @@
+/*
+ * C++ <-> Rust FFI benchmark
+ *
+ * round trip: the C++ "cpp_bench" actor sends a Ping through an ActorRef
+ *   from InteropManager::get_ref() (RustActorRef -> rust_actor_send_h),
+ *   the Rust echo actor answers through CppActorIF (cpp_actor_send_h),
+ *   and cpp_bench times the round trip.
+ * cpp_actor_send_h: the C++ half of a Rust -> C++ send, called in a loop
+ *   from this thread into a C++ actor: C struct conversion, sender proxy
+ *   lookup and enqueue. Receiving all of them ends the run.
+ *
+ * Build and run with `make bench` in this directory (needs cargo).
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "Bench.hpp"
+#include "actors/Actor.hpp"
+#include "actors/ActorRef.hpp"
+#include "actors/msg/Shutdown.hpp"
+#include "actors/msg/Start.hpp"
+#include "InteropMessages.hpp"
+#include "InteropManager.hpp"
+#include "CppActorBridge.hpp"
+
+extern "C" {
+    void create_rust_manager();
+    void* register_rust_echo_actor();
+    void rust_manager_init();
+    void rust_manager_end();
+    void rust_actor_init(const void* mgr);
+    void rust_actor_shutdown();
+}
+
+class BenchActor : public actors::Actor {
+    actors::Actor* manager_;
+    actors::ActorRef echo_;
+    long warmup_, count_;
+    int sent_ = 0;
+    std::uint64_t t0_ = 0;
+
+public:
+    std::vector<std::uint64_t> rtt;
+    std::atomic<bool> done{false};
+
+    BenchActor(actors::Actor* mgr, long warmup, long count)
+        : manager_(mgr), warmup_(warmup), count_(count)
+    {
+        strncpy(name, "cpp_bench", sizeof(name));
+        rtt.reserve(count);
+        MESSAGE_HANDLER(actors::msg::Start, on_start);
+        MESSAGE_HANDLER(msg::Pong, on_pong);
+    }
+
+    void on_start(const actors::msg::Start*) noexcept {
+        echo_ = static_cast<interop::InteropManager*>(manager_)->get_ref("rust_echo");
+        ping();
+    }
+
+    void on_pong(const msg::Pong*) noexcept {
+        std::uint64_t t1 = bench::now_ns();
+        if (sent_ > warmup_)
+            rtt.push_back(t1 - t0_);
+        if (sent_ < warmup_ + count_)
+            ping();
+        else
+            done.store(true, std::memory_order_release);
+    }
+
+private:
+    void ping() {
+        sent_++;
+        t0_ = bench::now_ns();
+        echo_.send(new msg::Ping{sent_}, this);
+    }
+};
+
+class SinkActor : public actors::Actor {
+public:
+    long received = 0;
+    long expected = 0;
+    std::atomic<std::uint64_t> done_ns{0};
+
+    SinkActor() {
+        strncpy(name, "cpp_sink", sizeof(name));
+        MESSAGE_HANDLER(msg::Pong, on_pong);
+    }
+
+    void on_pong(const msg::Pong*) noexcept {
+        if (++received == expected)
+            done_ns.store(bench::now_ns(), std::memory_order_release);
+    }
+};
+
+class BenchManager : public interop::InteropManager {
+public:
+    BenchActor* bench;
+    SinkActor* sink;
+
+    BenchManager(long warmup, long count) {
+        bench = new BenchActor(this, warmup, count);
+        sink = new SinkActor();
+        manage(bench);
+        manage(sink);
+    }
+};
+
+int main() {
+    const long warmup = bench::scaled(5000);
+    const long count = bench::scaled(100000);
+    const long sends = bench::scaled(1000000);
+    bench::Report report("ffi");
+
+    BenchManager mgr(warmup, count);
+    cpp_actor_init(&mgr);
+    create_rust_manager();
+    rust_actor_init(register_rust_echo_actor());
+    mgr.sink->expected = sends;
+    mgr.init();
+    rust_manager_init();
+
+    while (!mgr.bench->done.load(std::memory_order_acquire))
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    report.add_latency("C++ -> Rust -> C++ round trip", mgr.bench->rtt);
+
+    int32_t sink = cpp_actor_resolve("cpp_sink");
+    ::Pong c{};
+    std::uint64_t t0 = bench::now_ns();
+    for (long i = 0; i < sends; i++) {
+        c.count = int32_t(i);
+        cpp_actor_send_h(sink, 0, 1001, &c);
+    }
+    std::uint64_t t1 = bench::now_ns();
+    while (mgr.sink->done_ns.load(std::memory_order_acquire) == 0)
+        std::this_thread::yield();
+    std::uint64_t t2 = mgr.sink->done_ns.load();
+    report.add("cpp_actor_send_h", "cost", double(t1 - t0) / double(sends), "ns/msg");
+    report.add("cpp_actor_send_h to handled", "throughput", double(sends) / (double(t2 - t0) / 1e3), "Mmsg/s");
+
+    mgr.bench->send(new actors::msg::Shutdown());
+    mgr.sink->send(new actors::msg::Shutdown());
+    mgr.end();
+    rust_manager_end();
+    rust_actor_shutdown();
+    cpp_actor_shutdown();
+
+    report.print();
+    return 0;
+}
@@ -0,0 +1,31 @@
+//! Rust echo actor for bench_ffi
+//!
+//! Answers each Ping from the C++ "cpp_bench" actor with a Pong of the
+//! same count, without printing, so the benchmark times only the FFI path.
+
+use actors::{handle_messages, ActorContext, ManagerHandle};
+use crate::interop_messages::{Ping, Pong};
+use crate::cpp_actor_if::CppActorIF;
+
+pub struct RustEchoActor {
+    cpp_bench: CppActorIF,
+    #[allow(dead_code)]
+    manager_handle: ManagerHandle,
+}
+
+impl RustEchoActor {
+    pub fn new(manager_handle: ManagerHandle) -> Self {
+        RustEchoActor {
+            cpp_bench: CppActorIF::new("cpp_bench", Some("rust_echo")),
+            manager_handle,
+        }
+    }
+
+    fn on_ping(&mut self, msg: &Ping, _ctx: &mut ActorContext) {
+        self.cpp_bench.send(&Pong { count: msg.count });
+    }
+}
+
+handle_messages!(RustEchoActor,
+    Ping => on_ping
+);
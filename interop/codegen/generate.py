@@ -137,12 +137,90 @@ def generate_cpp_messages(messages: List[Message], output_dir: str):
 
 #include <string>
 #include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <algorithm>
 #include "actors/Message.hpp"
 #include "interop_messages.h"
 
-namespace msg {
+// In-place views use their message's ID plus this offset, so an actor can
+// handle both the copied message and its view
+#ifndef INTEROP_VIEW_ID_OFFSET
+#define INTEROP_VIEW_ID_OFFSET 10000
+#endif
+
+''')
+
+        sizes = ', '.join(f'sizeof(::{msg.name})' for msg in messages)
+        f.write(f'''namespace interop {{
+
+// Largest interop C struct; the payload size of an in-place slot
+inline constexpr std::size_t IN_PLACE_MAX = std::max({{{sizes}}});
+
+/**
+ * One slot of a C++ actor's in-place ring (see cpp_actor_claim()).
+ * Rust writes the C struct into data; the bridge constructs the view
+ * message in view and sends it, and deleting the view frees the slot.
+ */
+struct alignas(64) InPlaceSlot {{
+    alignas(std::max_align_t) unsigned char view[sizeof(actors::Message)];
+    std::atomic<uint64_t> seq{{0}};   // Ring position this slot is free for
+    uint64_t release_seq = 0;       // seq to publish on release
+    alignas(std::max_align_t) unsigned char data[IN_PLACE_MAX];
+
+    void release() noexcept {{ seq.store(release_seq, std::memory_order_release); }}
+}};
+
+}} // namespace interop
+
+namespace msg {{
+
+/**
+ * Read-only view of a C struct that Rust wrote straight into the
+ * receiving actor's ring. Nothing is copied or allocated; the slot is
+ * released when the actor deletes the message after the handler returns,
+ * so copy out anything needed later.
+ *
+ * Usage:
+ *   MESSAGE_HANDLER(msg::MarketDepthView, on_depth);
+ *   void on_depth(const msg::MarketDepthView* m) {{ use(m->get().bid_prices[0]); }}
+ */
+template <class C, int N>
+class InPlace : public actors::Message_N<N> {{
+public:
+    static constexpr int32_t ID = N;
+
+    InPlace() = default;
+    InPlace(const InPlace&) = delete;
+    InPlace& operator=(const InPlace&) = delete;
+
+    const C& get() const noexcept {{
+        return *reinterpret_cast<const C*>(slot()->data);
+    }}
+    const C* operator->() const noexcept {{ return &get(); }}
+
+    // Only constructed in a slot by the bridge; delete releases the slot
+    static void* operator new(std::size_t size, interop::InPlaceSlot* slot) noexcept {{
+        static_assert(sizeof(InPlace) <= sizeof(slot->view), "view does not fit its slot");
+        static_assert(sizeof(C) <= interop::IN_PLACE_MAX, "C struct does not fit its slot");
+        (void)size;
+        return slot->view;
+    }}
+    static void operator delete(void* p) noexcept {{
+        static_cast<interop::InPlaceSlot*>(p)->release();
+    }}
+    static void operator delete(void* p, interop::InPlaceSlot*) noexcept {{
+        static_cast<interop::InPlaceSlot*>(p)->release();
+    }}
+
+private:
+    // The view is the slot's first member
+    const interop::InPlaceSlot* slot() const noexcept {{
+        return reinterpret_cast<const interop::InPlaceSlot*>(this);
+    }}
+}};
 
 ''')
 
@@ -215,7 +293,11 @@ namespace msg {
 
             f.write('};\n\n')
 
-        f.write('} // namespace msg\n')
+        # In-place views, one per message
+        for msg in messages:
+            f.write(f'using {msg.name}View = InPlace<::{msg.name}, {msg.msg_id} + INTEROP_VIEW_ID_OFFSET>;\n')
+
+        f.write('\n} // namespace msg\n')
 
 def generate_rust_messages(messages: List[Message], output_dir: str):
     """Generate Rust message structs."""
@@ -263,6 +345,14 @@ impl CInteropString {
     }
 }
 
+/// One message in a batch send (matches C interop_envelope)
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct CInteropEnvelope {
+    pub msg_type: i32,
+    pub msg_data: *const std::ffi::c_void,
+}
+
 ''')
 
         # Message ID constants
@@ -368,6 +458,7 @@ def generate_cpp_bridge(messages: List[Message], output_dir: str):
 #pragma once
 
 #include <cstdint>
+#include "interop_messages.h"
 
 // Forward declaration
 namespace actors { class Manager; }
@@ -386,6 +477,8 @@ int32_t cpp_actor_exists(const char* name);
 
 // Send a message to a C++ actor (async - called from Rust)
 // sender_name is used to create an ActorRef for replies
+// Resolves both names on every call; resolve once and use cpp_actor_send_h()
+// for repeated sends
 // Returns 0 on success, -1 if actor not found, -2 if unknown message type
 int32_t cpp_actor_send(
     const char* actor_name,
@@ -394,6 +487,48 @@ int32_t cpp_actor_send(
     const void* msg_data
 );
 
+// Resolve a C++ actor name to a handle for cpp_actor_send_h()
+// Returns a positive handle, or 0 if the actor doesn't exist
+// The handle is the actor's ActorId, valid until cpp_actor_shutdown()
+int32_t cpp_actor_resolve(const char* name);
+
+// Send a message to a C++ actor by handle (async - called from Rust)
+// sender_handle is the Rust sender's rust_actor_resolve() handle, used to
+// route replies (0 for none)
+// Returns 0 on success, -1 if the handle is invalid, -2 if unknown message type
+int32_t cpp_actor_send_h(
+    int32_t actor_handle,
+    int32_t sender_handle,
+    int32_t msg_type,
+    const void* msg_data
+);
+
+// Send count messages to a C++ actor in one call (async - called from Rust)
+// Messages with an unknown type or null data are skipped
+// Returns the number of messages sent, or -1 if the handle is invalid
+int32_t cpp_actor_send_batch(
+    int32_t actor_handle,
+    int32_t sender_handle,
+    const interop_envelope* msgs,
+    int32_t count
+);
+
+// Claim a slot in a C++ actor's in-place ring (called from Rust)
+// Write any interop C struct into the returned memory, then pass it to
+// cpp_actor_publish(); every claimed slot must be published
+// Returns null if the handle is invalid or the ring is full
+void* cpp_actor_claim(int32_t actor_handle);
+
+// Send a claimed slot to its actor as msg::<Name>View, without copying
+// An unknown message type releases the slot unsent
+// Returns 0 on success, -1 if the handle or slot is invalid, -2 if unknown message type
+int32_t cpp_actor_publish(
+    int32_t actor_handle,
+    int32_t sender_handle,
+    int32_t msg_type,
+    void* slot_data
+);
+
 } // extern "C"
 ''')
 
@@ -412,10 +547,27 @@ int32_t cpp_actor_send(
 #include "actors/Actor.hpp"
 #include "actors/act/Manager.hpp"
 
+#include <atomic>
 #include <string>
 #include <mutex>
 #include <memory>
 #include <unordered_map>
+#include <vector>
+
+// Slots in the lock-free sender proxy table (power of two)
+#ifndef INTEROP_PROXY_SLOTS
+#define INTEROP_PROXY_SLOTS 8192
+#endif
+
+// Slots in each actor's in-place ring (power of two)
+#ifndef INTEROP_RING_SLOTS
+#define INTEROP_RING_SLOTS 1024
+#endif
+
+static_assert((INTEROP_PROXY_SLOTS & (INTEROP_PROXY_SLOTS - 1)) == 0,
+              "INTEROP_PROXY_SLOTS must be a power of two");
+static_assert((INTEROP_RING_SLOTS & (INTEROP_RING_SLOTS - 1)) == 0,
+              "INTEROP_RING_SLOTS must be a power of two");
 
 namespace {
 
@@ -433,60 +585,196 @@ class RustSenderProxy : public actors::Actor {
     interop::RustActorIF rust_actor_;
 
 public:
-    RustSenderProxy(const std::string& rust_actor_name, const std::string& cpp_actor_name)
-        : rust_actor_(rust_actor_name, cpp_actor_name)
+    RustSenderProxy(const std::string& rust_actor_name, int32_t rust_handle, int32_t cpp_handle)
+        : rust_actor_(rust_actor_name, rust_handle, cpp_handle)
     {
         strncpy(name, rust_actor_name.c_str(), sizeof(name) - 1);
         name[sizeof(name) - 1] = '\\0';
     }
 
     // Override send to forward to Rust
-    void send(const actors::Message* m, actors::Actor* sender) noexcept override {
-        // Forward to Rust based on message type
+    void send(const actors::Message* m, actors::Actor*) noexcept override {
+        rust_actor_.forward(*m);  // Unknown message types are dropped
+        m->release();
+    }
+};
+
+/**
+ * Convert a C struct to its C++ message and send it to actor.
+ * Returns 0 on success, -2 if unknown message type.
+ */
+int32_t deliver(actors::Actor* actor, actors::Actor* sender, int32_t msg_type, const void* msg_data) {
+    // Dispatch based on message type (a jump table over the IDs)
+    switch (msg_type) {
 ''')
 
-        # Generate dispatch for each message type
         for msg in messages:
-            f.write(f'''        if (m->get_message_id() == {msg.msg_id}) {{
-            rust_actor_.send(*static_cast<const msg::{msg.name}*>(m));
-            delete m;
-            return;
-        }}
-''')
+            f.write(f'        case {msg.msg_id}:\n')
+            f.write(f'            actor->send(new msg::{msg.name}(\n')
+            f.write(f'                msg::{msg.name}::from_c_struct(*static_cast<const ::{msg.name}*>(msg_data))\n')
+            f.write(f'            ), sender);\n')
+            f.write(f'            return 0;\n')
 
-        f.write('''        // Unknown message type, just delete it
-        delete m;
+        f.write('''        default:
+            return -2; // Unknown message type
     }
-};
+}
 
-// Cache of proxy actors (reused across multiple messages from same sender)
-std::unordered_map<std::string, std::unique_ptr<RustSenderProxy>> proxy_cache;
-std::mutex proxy_mutex;
+/**
+ * Slots that Rust writes C structs into for an actor's in-place views.
+ * Producers claim positions in order with a CAS on tail, like ShmRing;
+ * a slot is free for the next lap once its view is deleted, so slots may
+ * be released out of order and a claim only fails while the slot it
+ * lands on is still in use.
+ */
+struct InPlaceRing {
+    interop::InPlaceSlot slots[INTEROP_RING_SLOTS];
+    alignas(64) std::atomic<uint64_t> tail{0};
+
+    InPlaceRing() {
+        for (uint64_t i = 0; i < INTEROP_RING_SLOTS; i++) {
+            slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    interop::InPlaceSlot* claim() {
+        uint64_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            interop::InPlaceSlot& slot = slots[pos & (INTEROP_RING_SLOTS - 1)];
+            int64_t dif = int64_t(slot.seq.load(std::memory_order_acquire) - pos);
+            if (dif == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.release_seq = pos + INTEROP_RING_SLOTS;
+                    return &slot;
+                }
+            } else if (dif < 0) {
+                return nullptr;  // Still in use from the previous lap
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Slot whose data pointer is p, or nullptr if p isn't one
+    interop::InPlaceSlot* slot_of(void* p) {
+        auto addr = reinterpret_cast<uintptr_t>(p);
+        auto first = reinterpret_cast<uintptr_t>(slots[0].data);
+        if (addr < first) return nullptr;
+        uintptr_t off = addr - first;
+        if (off % sizeof(interop::InPlaceSlot) != 0) return nullptr;
+        uintptr_t i = off / sizeof(interop::InPlaceSlot);
+        return i < INTEROP_RING_SLOTS ? &slots[i] : nullptr;
+    }
+};
 
 /**
- * Get or create a proxy actor for a Rust sender.
- * The proxy enables C++ actors to use reply() naturally.
+ * C++ handles are the Manager's ActorIds, so sends find the actor in its
+ * lock-free ID table without touching a name.
  */
-actors::Actor* get_sender_proxy(const char* sender_name, const char* receiver_name) {
-    if (!sender_name || sender_name[0] == '\\0') {
-        return nullptr;
+actors::Actor* actor_for(int32_t handle) {
+    if (handle <= 0 || !g_manager) return nullptr;
+    return g_manager->get_local_actor(actors::ActorId(handle));
+}
+
+// In-place rings by ActorId, created on first claim; the mutex only
+// guards creating them
+actors::IdTable<InPlaceRing> g_rings;
+std::vector<std::unique_ptr<InPlaceRing>> g_ring_owner;
+std::vector<int32_t> g_ring_handles;
+std::mutex ring_mutex;
+
+InPlaceRing* ring_for(int32_t handle) {
+    if (handle <= 0) return nullptr;
+    return g_rings.get(uint32_t(handle));
+}
+
+InPlaceRing* add_ring(int32_t handle) {
+    std::lock_guard<std::mutex> lock(ring_mutex);
+    InPlaceRing* ring = g_rings.get(uint32_t(handle));
+    if (!ring) {
+        g_ring_owner.push_back(std::make_unique<InPlaceRing>());
+        ring = g_ring_owner.back().get();
+        g_ring_handles.push_back(handle);
+        g_rings.set(uint32_t(handle), ring);
     }
+    return ring;
+}
+
+/**
+ * Sender proxies keyed by (receiver handle, sender handle). Lookups probe
+ * an open-addressed table without locking; a slot's proxy is written
+ * before its key is published and neither changes until shutdown. Once
+ * the table is 3/4 full, further proxies go to a map under the mutex.
+ */
+struct ProxySlot {
+    std::atomic<uint64_t> key{0};     // 0 = empty
+    RustSenderProxy* proxy = nullptr;
+};
+ProxySlot g_proxy_slots[INTEROP_PROXY_SLOTS];
+size_t g_proxy_slots_used = 0;
+std::unordered_map<uint64_t, RustSenderProxy*> g_proxy_overflow;
+std::vector<std::unique_ptr<RustSenderProxy>> g_proxies;     // Owns every proxy
+std::mutex proxy_mutex;
 
-    std::string key = std::string(sender_name) + "->" + (receiver_name ? receiver_name : "");
+size_t proxy_slot(uint64_t key) {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & (INTEROP_PROXY_SLOTS - 1);
+}
 
+actors::Actor* add_sender_proxy(int32_t receiver, int32_t sender, uint64_t key) {
     std::lock_guard<std::mutex> lock(proxy_mutex);
-    auto it = proxy_cache.find(key);
-    if (it != proxy_cache.end()) {
-        return it->second.get();
+    auto it = g_proxy_overflow.find(key);
+    if (it != g_proxy_overflow.end()) {
+        return it->second;
+    }
+
+    // Another thread may have added it since the lock-free probe
+    size_t i = proxy_slot(key);
+    for (;;) {
+        uint64_t k = g_proxy_slots[i].key.load(std::memory_order_relaxed);
+        if (k == key) return g_proxy_slots[i].proxy;
+        if (k == 0) break;
+        i = (i + 1) & (INTEROP_PROXY_SLOTS - 1);
+    }
+
+    const char* rust_name = rust_actor_name(sender);
+    if (!rust_name) {
+        return nullptr;  // Not a Rust actor handle; no reply route
     }
 
     // Create new proxy
-    auto proxy = std::make_unique<RustSenderProxy>(sender_name, receiver_name ? receiver_name : "");
+    auto proxy = std::make_unique<RustSenderProxy>(rust_name, sender, receiver);
     auto* ptr = proxy.get();
-    proxy_cache[key] = std::move(proxy);
+    g_proxies.push_back(std::move(proxy));
+    if (g_proxy_slots_used < INTEROP_PROXY_SLOTS / 4 * 3) {
+        g_proxy_slots[i].proxy = ptr;
+        g_proxy_slots[i].key.store(key, std::memory_order_release);
+        g_proxy_slots_used++;
+    } else {
+        g_proxy_overflow[key] = ptr;
+    }
     return ptr;
 }
 
+/**
+ * Get or create a proxy actor for a Rust sender.
+ * The proxy enables C++ actors to use reply() naturally.
+ */
+actors::Actor* get_sender_proxy(int32_t receiver, int32_t sender) {
+    if (sender <= 0) {
+        return nullptr;
+    }
+
+    const uint64_t key = (uint64_t(uint32_t(receiver)) << 32) | uint32_t(sender);
+    size_t i = proxy_slot(key);
+    for (;;) {
+        uint64_t k = g_proxy_slots[i].key.load(std::memory_order_acquire);
+        if (k == key) return g_proxy_slots[i].proxy;
+        if (k == 0) break;
+        i = (i + 1) & (INTEROP_PROXY_SLOTS - 1);
+    }
+    return add_sender_proxy(receiver, sender, key);
+}
+
 } // anonymous namespace
 
 extern "C" {
@@ -496,8 +784,24 @@ void cpp_actor_init(actors::Manager* mgr) {
 }
 
 void cpp_actor_shutdown() {
-    std::lock_guard<std::mutex> lock(proxy_mutex);
-    proxy_cache.clear();
+    {
+        std::lock_guard<std::mutex> lock(proxy_mutex);
+        for (auto& slot : g_proxy_slots) {
+            slot.key.store(0, std::memory_order_relaxed);
+            slot.proxy = nullptr;
+        }
+        g_proxy_slots_used = 0;
+        g_proxy_overflow.clear();
+        g_proxies.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(ring_mutex);
+        for (int32_t h : g_ring_handles) {
+            g_rings.set(uint32_t(h), nullptr);
+        }
+        g_ring_handles.clear();
+        g_ring_owner.clear();
+    }
     g_manager = nullptr;
 }
 
@@ -506,6 +810,11 @@ int32_t cpp_actor_exists(const char* name) {
     return g_manager->get_local_actor(name) != nullptr ? 1 : 0;
 }
 
+int32_t cpp_actor_resolve(const char* name) {
+    if (!name || !g_manager) return 0;
+    return int32_t(g_manager->get_actor_id(name));
+}
+
 int32_t cpp_actor_send(
     const char* actor_name,
     const char* sender_name,
@@ -514,31 +823,86 @@ int32_t cpp_actor_send(
 ) {
     if (!actor_name || !msg_data || !g_manager) return -1;
 
-    actors::Actor* actor = g_manager->get_local_actor(actor_name);
-    if (!actor) return -1;  // Actor not found
+    int32_t actor = cpp_actor_resolve(actor_name);
+    if (actor <= 0) return -1;  // Actor not found
+
+    int32_t sender = (sender_name && sender_name[0] != '\\0') ? rust_actor_resolve(sender_name) : 0;
+    return cpp_actor_send_h(actor, sender, msg_type, msg_data);
+}
+
+int32_t cpp_actor_send_h(
+    int32_t actor_handle,
+    int32_t sender_handle,
+    int32_t msg_type,
+    const void* msg_data
+) {
+    if (!msg_data) return -1;
+
+    actors::Actor* actor = actor_for(actor_handle);
+    if (!actor) return -1;  // Invalid handle
+
+    actors::Actor* sender = get_sender_proxy(actor_handle, sender_handle);
+    return deliver(actor, sender, msg_type, msg_data);
+}
 
-    actors::Actor* sender = get_sender_proxy(sender_name, actor_name);
+int32_t cpp_actor_send_batch(
+    int32_t actor_handle,
+    int32_t sender_handle,
+    const interop_envelope* msgs,
+    int32_t count
+) {
+    actors::Actor* actor = actor_for(actor_handle);
+    if (!actor) return -1;  // Invalid handle
+    if (count <= 0) return 0;
+    if (!msgs) return -1;
+
+    // One handle and proxy lookup for the whole batch
+    actors::Actor* sender = get_sender_proxy(actor_handle, sender_handle);
+    int32_t sent = 0;
+    for (int32_t i = 0; i < count; i++) {
+        if (msgs[i].msg_data && deliver(actor, sender, msgs[i].msg_type, msgs[i].msg_data) == 0) {
+            sent++;
+        }
+    }
+    return sent;
+}
 
-    // Dispatch based on message type
+void* cpp_actor_claim(int32_t actor_handle) {
+    if (!actor_for(actor_handle)) return nullptr;  // Invalid handle
+
+    InPlaceRing* ring = ring_for(actor_handle);
+    if (!ring && !(ring = add_ring(actor_handle))) return nullptr;
+
+    interop::InPlaceSlot* slot = ring->claim();
+    return slot ? slot->data : nullptr;
+}
+
+int32_t cpp_actor_publish(
+    int32_t actor_handle,
+    int32_t sender_handle,
+    int32_t msg_type,
+    void* slot_data
+) {
+    actors::Actor* actor = actor_for(actor_handle);
+    InPlaceRing* ring = ring_for(actor_handle);
+    if (!actor || !ring) return -1;  // Invalid handle
+
+    interop::InPlaceSlot* slot = ring->slot_of(slot_data);
+    if (!slot) return -1;  // Not a slot of this actor's ring
+
+    actors::Actor* sender = get_sender_proxy(actor_handle, sender_handle);
     switch (msg_type) {
 ''')
 
         for msg in messages:
-            f.write(f'        case {msg.msg_id}: {{\n')
-            f.write(f'            auto* cpp_msg = new msg::{msg.name}(\n')
-            f.write(f'                msg::{msg.name}::from_c_struct(\n')
-            f.write(f'                    *static_cast<const ::{msg.name}*>(msg_data)\n')
-            f.write(f'                )\n')
-            f.write(f'            );\n')
-            f.write(f'            actor->send(cpp_msg, sender);\n')
-            f.write(f'            break;\n')
-            f.write(f'        }}\n')
+            f.write(f'        case {msg.msg_id}:\n')
+            f.write(f'            actor->send(new (slot) msg::{msg.name}View(), sender);\n')
+            f.write(f'            return 0;\n')
 
         f.write('''        default:
+            slot->release();
             return -2; // Unknown message type
     }
-
-    return 0;
 }
 
 } // extern "C"
@@ -558,9 +922,10 @@ def generate_rust_bridge(messages: List[Message], output_dir: str):
 
 #![allow(dead_code)]
 
-use std::ffi::CStr;
+use std::collections::HashMap;
+use std::ffi::{CStr, CString};
 use std::os::raw::{c_char, c_int, c_void};
-use std::sync::Mutex;
+use std::sync::{Mutex, RwLock};
 
 use actors::{ActorRef, Manager};
 use crate::interop_messages::*;
@@ -574,6 +939,19 @@ unsafe impl Sync for ManagerPtr {}
 // We use Mutex with a wrapper type since raw pointers don't impl Send/Sync
 static MANAGER: Mutex<ManagerPtr> = Mutex::new(ManagerPtr(std::ptr::null()));
 
+/// Resolved actors for rust_actor_send_h(), indexed by handle - 1
+///
+/// A handle is handed out once per name and stays valid until
+/// rust_actor_shutdown(). Sends only take the read lock.
+struct HandleTable {
+    entries: Vec<(CString, ActorRef)>,
+    by_name: HashMap<String, c_int>,
+}
+unsafe impl Send for HandleTable {}
+unsafe impl Sync for HandleTable {}
+
+static HANDLES: RwLock<Option<HandleTable>> = RwLock::new(None);
+
 /// Get reference to the global Manager
 fn get_manager() -> Option<&'static Manager> {
     let guard = MANAGER.lock().ok()?;
@@ -591,6 +969,42 @@ fn create_cpp_sender_ref(sender_name: &str, receiver_name: &str) -> Option<Actor
     None
 }
 
+/// Resolve an actor name to a handle (0 if not found)
+/// Also used by CppActorIF to pass its sender as a handle
+pub fn resolve_handle(name: &str) -> c_int {
+    if let Ok(guard) = HANDLES.read() {
+        if let Some(&h) = guard.as_ref().and_then(|t| t.by_name.get(name)) {
+            return h;
+        }
+    }
+
+    let mgr = match get_manager() {
+        Some(m) => m,
+        None => return 0,
+    };
+    let actor_ref = match mgr.get_ref(name) {
+        Some(r) => r,
+        None => return 0,
+    };
+    let c_name = match CString::new(name) {
+        Ok(c) => c,
+        Err(_) => return 0,
+    };
+
+    let mut guard = match HANDLES.write() {
+        Ok(g) => g,
+        Err(_) => return 0,
+    };
+    let table = guard.get_or_insert_with(|| HandleTable { entries: Vec::new(), by_name: HashMap::new() });
+    if let Some(&h) = table.by_name.get(name) {
+        return h;
+    }
+    table.entries.push((c_name, actor_ref));
+    let h = table.entries.len() as c_int;
+    table.by_name.insert(name.to_string(), h);
+    h
+}
+
 /// Initialize the Rust actor bridge with a Manager pointer
 /// The Manager's registry is used to look up actors by name
 #[no_mangle]
@@ -603,6 +1017,9 @@ pub extern "C" fn rust_actor_init(mgr: *const Manager) {
 /// Shutdown the Rust actor runtime
 #[no_mangle]
 pub extern "C" fn rust_actor_shutdown() {
+    if let Ok(mut guard) = HANDLES.write() {
+        *guard = None;
+    }
     if let Ok(mut guard) = MANAGER.lock() {
         guard.0 = std::ptr::null();
     }
@@ -625,8 +1042,36 @@ pub extern "C" fn rust_actor_exists(name: *const c_char) -> c_int {
     if mgr.get_ref(name_str).is_some() { 1 } else { 0 }
 }
 
+/// Resolve a Rust actor name to a handle for rust_actor_send_h()
+/// Returns a positive handle, or 0 if the actor doesn't exist
+#[no_mangle]
+pub extern "C" fn rust_actor_resolve(name: *const c_char) -> c_int {
+    if name.is_null() {
+        return 0;
+    }
+    match unsafe { CStr::from_ptr(name).to_str() } {
+        Ok(s) => resolve_handle(s),
+        Err(_) => 0,
+    }
+}
+
+/// Name of a resolved actor, or null for an invalid handle
+/// The pointer stays valid until rust_actor_shutdown()
+#[no_mangle]
+pub extern "C" fn rust_actor_name(handle: c_int) -> *const c_char {
+    let guard = match HANDLES.read() {
+        Ok(g) => g,
+        Err(_) => return std::ptr::null(),
+    };
+    match guard.as_ref().and_then(|t| t.entries.get((handle as usize).wrapping_sub(1))) {
+        Some((name, _)) => name.as_ptr(),
+        None => std::ptr::null(),
+    }
+}
+
 /// Send a message to a Rust actor (async - called from C++)
 /// sender_name is used to create a sender ActorRef for replies
+/// Resolves the name on every call; prefer rust_actor_send_h()
 /// Returns 0 on success, -1 if actor not found, -2 if unknown message type
 #[no_mangle]
 pub extern "C" fn rust_actor_send(
@@ -639,30 +1084,89 @@ pub extern "C" fn rust_actor_send(
         return -1;
     }
 
-    let name = match unsafe { CStr::from_ptr(actor_name).to_str() } {
-        Ok(s) => s,
+    let handle = rust_actor_resolve(actor_name);
+    if handle <= 0 {
+        return -1;  // Actor not found
+    }
+
+    // C++ senders aren't routed back yet, see rust_actor_send_h()
+    let _ = sender_name;
+    rust_actor_send_h(handle, 0, msg_type, msg_data)
+}
+
+/// Send a message to a Rust actor by handle (async - called from C++)
+/// sender_handle is the C++ sender's cpp_actor_resolve() handle (0 for none)
+/// Returns 0 on success, -1 if the handle is invalid, -2 if unknown message type
+#[no_mangle]
+pub extern "C" fn rust_actor_send_h(
+    actor_handle: c_int,
+    sender_handle: c_int,
+    msg_type: c_int,
+    msg_data: *const c_void,
+) -> c_int {
+    if msg_data.is_null() {
+        return -1;
+    }
+
+    let guard = match HANDLES.read() {
+        Ok(g) => g,
         Err(_) => return -1,
     };
-
-    let mgr = match get_manager() {
-        Some(m) => m,
-        None => return -1,
+    let actor_ref = match guard.as_ref().and_then(|t| t.entries.get((actor_handle as usize).wrapping_sub(1))) {
+        Some((_, r)) => r,
+        None => return -1,  // Invalid handle
     };
 
-    let actor_ref = match mgr.get_ref(name) {
-        Some(r) => r,
-        None => return -1,  // Actor not found
-    };
+    // For C++ senders, we create a special ActorRef that routes back via FFI
+    // This is handled by the CppSenderProxy in the actor
+    let _ = sender_handle;
+    deliver(actor_ref, None, msg_type, msg_data) // TODO: Implement CppActorRef
+}
 
-    // Create sender ref for replies (if sender name provided)
-    let sender_ref: Option<ActorRef> = if sender_name.is_null() {
-        None
-    } else {
-        // For C++ senders, we create a special ActorRef that routes back via FFI
-        // This is handled by the CppSenderProxy in the actor
-        None // TODO: Implement CppActorRef
+/// Send count messages to a Rust actor in one call (async - called from C++)
+/// Messages with an unknown type or null data are skipped
+/// Returns the number of messages sent, or -1 if the handle is invalid
+#[no_mangle]
+pub extern "C" fn rust_actor_send_batch(
+    actor_handle: c_int,
+    sender_handle: c_int,
+    msgs: *const CInteropEnvelope,
+    count: c_int,
+) -> c_int {
+    let guard = match HANDLES.read() {
+        Ok(g) => g,
+        Err(_) => return -1,
     };
+    let actor_ref = match guard.as_ref().and_then(|t| t.entries.get((actor_handle as usize).wrapping_sub(1))) {
+        Some((_, r)) => r,
+        None => return -1,  // Invalid handle
+    };
+    if count <= 0 {
+        return 0;
+    }
+    if msgs.is_null() {
+        return -1;
+    }
 
+    let _ = sender_handle;
+    let batch = unsafe { std::slice::from_raw_parts(msgs, count as usize) };
+    let mut sent = 0;
+    for e in batch {
+        if !e.msg_data.is_null() && deliver(actor_ref, None, e.msg_type, e.msg_data) == 0 {
+            sent += 1;
+        }
+    }
+    sent
+}
+
+/// Convert a C struct to its Rust message and send it to actor_ref
+/// Returns 0 on success, -2 if unknown message type
+fn deliver(
+    actor_ref: &ActorRef,
+    sender_ref: Option<ActorRef>,
+    msg_type: c_int,
+    msg_data: *const c_void,
+) -> c_int {
     // Convert C struct to Rust message and send
     match msg_type {
 ''')
@@ -696,8 +1200,11 @@ def generate_rust_actor_if(messages: List[Message], output_dir: str):
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <string>
 #include <cstring>
+#include <vector>
 #include "InteropMessages.hpp"
 
 // Forward declare the Rust bridge functions
@@ -710,6 +1217,26 @@ extern "C" {
     );
 
     int32_t rust_actor_exists(const char* name);
+
+    // Handle API: resolve once, then send without name lookups
+    int32_t rust_actor_resolve(const char* name);
+    const char* rust_actor_name(int32_t handle);
+    int32_t rust_actor_send_h(
+        int32_t actor_handle,
+        int32_t sender_handle,
+        int32_t msg_type,
+        const void* msg_data
+    );
+
+    int32_t rust_actor_send_batch(
+        int32_t actor_handle,
+        int32_t sender_handle,
+        const interop_envelope* msgs,
+        int32_t count
+    );
+
+    // Implemented in CppActorBridge.cpp
+    int32_t cpp_actor_resolve(const char* name);
 }
 
 namespace interop {
@@ -717,6 +1244,9 @@ namespace interop {
 /**
  * RustActorIF - Interface for C++ actors to send messages to Rust actors
  *
+ * Names are resolved to handles on the first send and cached, so later
+ * sends skip the name lookup on both sides of the bridge.
+ *
  * Usage:
  *   RustActorIF rust_actor("my_rust_actor", "my_cpp_actor");
  *   rust_actor.send(msg::Ping{42});           // async (fire-and-forget)
@@ -727,32 +1257,109 @@ public:
         : actor_name_(actor_name)
         , sender_name_(sender_name) {}
 
+    // From handles already resolved with rust_actor_resolve() / cpp_actor_resolve()
+    RustActorIF(const std::string& actor_name, int32_t handle, int32_t sender_handle)
+        : actor_name_(actor_name)
+        , handle_(handle)
+        , sender_handle_(sender_handle) {}
+
+    RustActorIF(const RustActorIF& o)
+        : actor_name_(o.actor_name_)
+        , sender_name_(o.sender_name_)
+        , handle_(o.handle_.load(std::memory_order_relaxed))
+        , sender_handle_(o.sender_handle_.load(std::memory_order_relaxed)) {}
+
+    RustActorIF& operator=(const RustActorIF& o) {
+        actor_name_ = o.actor_name_;
+        sender_name_ = o.sender_name_;
+        handle_.store(o.handle_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        sender_handle_.store(o.sender_handle_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
     /**
      * Send a message asynchronously (fire-and-forget)
      * Returns 0 on success, -1 if actor not found
      */
     template<typename Msg>
     int send(const Msg& msg) const {
+        int32_t h = handle();
+        if (h <= 0) return -1;
         auto c_msg = msg.to_c_struct();
-        return rust_actor_send(
-            actor_name_.c_str(),
-            sender_name_.empty() ? nullptr : sender_name_.c_str(),
-            Msg::ID,
-            &c_msg
-        );
+        return rust_actor_send_h(h, sender_handle(), Msg::ID, &c_msg);
+    }
+
+    /**
+     * Send n messages of one type with a single FFI call
+     * Returns the number sent, or -1 if actor not found
+     */
+    template<typename Msg>
+    int send_batch(const Msg* msgs, size_t n) const {
+        int32_t h = handle();
+        if (h <= 0) return -1;
+        std::vector<decltype(msgs->to_c_struct())> c_msgs;
+        std::vector<interop_envelope> envelopes(n);
+        c_msgs.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            c_msgs.push_back(msgs[i].to_c_struct());
+            envelopes[i] = {Msg::ID, &c_msgs[i]};
+        }
+        return rust_actor_send_batch(h, sender_handle(), envelopes.data(), static_cast<int32_t>(n));
     }
 
+    /**
+     * Send any interop message by its runtime ID (the caller keeps ownership)
+     * Returns 0 on success, -1 if actor not found, -2 if unknown message type
+     */
+    int forward(const actors::Message& m) const;
+
     bool exists() const {
         return rust_actor_exists(actor_name_.c_str()) != 0;
     }
 
     const std::string& name() const { return actor_name_; }
 
+    // Rust handle of the target; resolved on first use, 0 while not found
+    int32_t handle() const {
+        int32_t h = handle_.load(std::memory_order_relaxed);
+        if (h == 0) {
+            h = rust_actor_resolve(actor_name_.c_str());
+            if (h > 0) handle_.store(h, std::memory_order_relaxed);
+        }
+        return h;
+    }
+
+    // C++ handle of the sender, 0 if there is none
+    int32_t sender_handle() const {
+        int32_t h = sender_handle_.load(std::memory_order_relaxed);
+        if (h == 0 && !sender_name_.empty()) {
+            h = cpp_actor_resolve(sender_name_.c_str());
+            if (h > 0) sender_handle_.store(h, std::memory_order_relaxed);
+        }
+        return h > 0 ? h : 0;
+    }
+
 private:
     std::string actor_name_;
     std::string sender_name_;
+    mutable std::atomic<int32_t> handle_{0};
+    mutable std::atomic<int32_t> sender_handle_{0};
 };
 
+inline int RustActorIF::forward(const actors::Message& m) const {
+    // Dispatch based on message type (a jump table over the IDs)
+    switch (m.get_message_id()) {
+''')
+
+        for msg in messages:
+            f.write(f'        case {msg.msg_id}:\n')
+            f.write(f'            return send(static_cast<const msg::{msg.name}&>(m));\n')
+
+        f.write('''        default:
+            return -2; // Unknown message type
+    }
+}
+
 } // namespace interop
 ''')
 
@@ -770,8 +1377,10 @@ def generate_cpp_actor_if(messages: List[Message], output_dir: str):
 
 use std::ffi::CString;
 use std::os::raw::{c_char, c_int, c_void};
+use std::sync::atomic::{AtomicI32, Ordering};
 
 use crate::interop_messages::*;
+use crate::rust_actor_bridge::resolve_handle;
 
 // C++ bridge functions - resolved at final link time (no #[link] attribute)
 // The final executable must link both Rust and C++ code together
@@ -784,6 +1393,33 @@ extern "C" {
     ) -> c_int;
 
     fn cpp_actor_exists(name: *const c_char) -> c_int;
+
+    // Handle API: resolve once, then send without name lookups
+    fn cpp_actor_resolve(name: *const c_char) -> c_int;
+
+    fn cpp_actor_send_h(
+        actor_handle: c_int,
+        sender_handle: c_int,
+        msg_type: c_int,
+        msg_data: *const c_void,
+    ) -> c_int;
+
+    fn cpp_actor_send_batch(
+        actor_handle: c_int,
+        sender_handle: c_int,
+        msgs: *const CInteropEnvelope,
+        count: c_int,
+    ) -> c_int;
+
+    // In-place API: write the C struct straight into the C++ actor's ring
+    fn cpp_actor_claim(actor_handle: c_int) -> *mut c_void;
+
+    fn cpp_actor_publish(
+        actor_handle: c_int,
+        sender_handle: c_int,
+        msg_type: c_int,
+        slot_data: *mut c_void,
+    ) -> c_int;
 }
 
 /// Trait for messages that can be sent via FFI
@@ -793,7 +1429,19 @@ pub trait InteropMessage {
     fn to_c_struct(&self) -> Self::CStruct;
 }
 
+/// Trait for C structs that can be built in place with send_in_place()
+pub trait InteropCStruct: Default {
+    const MSG_ID: i32;
+}
+
+''')
+        for msg in messages:
+            f.write(f'''impl InteropCStruct for C{msg.name} {{
+    const MSG_ID: i32 = {msg.msg_id};
+}}
+
 ''')
+
         # Implement InteropMessage for each message type
         for msg in messages:
             f.write(f'''impl InteropMessage for {msg.name} {{
@@ -808,12 +1456,17 @@ pub trait InteropMessage {
 
         f.write('''/// CppActorIF - Interface for Rust actors to send messages to C++ actors
 ///
+/// Names are resolved to handles on the first send and cached, so later
+/// sends skip the name lookup on both sides of the bridge.
+///
 /// Usage:
 ///   let cpp_actor = CppActorIF::new("my_cpp_actor", "my_rust_actor");
 ///   cpp_actor.send(&Ping { count: 42 });           // async (fire-and-forget)
 pub struct CppActorIF {
     actor_name: CString,
     sender_name: Option<CString>,
+    handle: AtomicI32,          // 0 until resolved
+    sender_handle: AtomicI32,   // 0 until resolved
 }
 
 impl CppActorIF {
@@ -821,27 +1474,71 @@ impl CppActorIF {
         CppActorIF {
             actor_name: CString::new(actor_name).unwrap(),
             sender_name: sender_name.map(|s| CString::new(s).unwrap()),
+            handle: AtomicI32::new(0),
+            sender_handle: AtomicI32::new(0),
         }
     }
 
     /// Send a message asynchronously (fire-and-forget)
     /// Returns 0 on success, -1 if actor not found
     pub fn send<M: InteropMessage>(&self, msg: &M) -> i32 {
+        let handle = self.handle();
+        if handle <= 0 {
+            return -1;
+        }
         let c_msg = msg.to_c_struct();
-        let sender_ptr = self.sender_name
-            .as_ref()
-            .map(|s| s.as_ptr())
-            .unwrap_or(std::ptr::null());
         unsafe {
-            cpp_actor_send(
-                self.actor_name.as_ptr(),
-                sender_ptr,
+            cpp_actor_send_h(
+                handle,
+                self.sender_handle(),
                 M::MSG_ID,
                 &c_msg as *const _ as *const c_void,
             )
         }
     }
 
+    /// Send messages of one type with a single FFI call
+    /// Returns the number sent, or -1 if actor not found
+    pub fn send_batch<M: InteropMessage>(&self, msgs: &[M]) -> i32 {
+        let handle = self.handle();
+        if handle <= 0 {
+            return -1;
+        }
+        let c_msgs: Vec<M::CStruct> = msgs.iter().map(|m| m.to_c_struct()).collect();
+        let envelopes: Vec<CInteropEnvelope> = c_msgs
+            .iter()
+            .map(|c| CInteropEnvelope { msg_type: M::MSG_ID, msg_data: c as *const _ as *const c_void })
+            .collect();
+        unsafe {
+            cpp_actor_send_batch(
+                handle,
+                self.sender_handle(),
+                envelopes.as_ptr(),
+                envelopes.len() as c_int,
+            )
+        }
+    }
+
+    /// Build a C struct directly in a slot of the C++ actor's ring
+    /// The C++ handler receives it as msg::<Name>View, with no copy or
+    /// allocation on either side
+    /// Returns 0 on success, -1 if actor not found, -3 if the ring is full
+    pub fn send_in_place<C: InteropCStruct, F: FnOnce(&mut C)>(&self, fill: F) -> i32 {
+        let handle = self.handle();
+        if handle <= 0 {
+            return -1;
+        }
+        let slot = unsafe { cpp_actor_claim(handle) } as *mut C;
+        if slot.is_null() {
+            return -3;
+        }
+        unsafe {
+            slot.write(C::default());
+            fill(&mut *slot);
+            cpp_actor_publish(handle, self.sender_handle(), C::MSG_ID, slot as *mut c_void)
+        }
+    }
+
     pub fn exists(&self) -> bool {
         unsafe { cpp_actor_exists(self.actor_name.as_ptr()) != 0 }
     }
@@ -849,6 +1546,35 @@ impl CppActorIF {
     pub fn name(&self) -> &str {
         self.actor_name.to_str().unwrap()
     }
+
+    /// C++ handle of the target; resolved on first use, 0 while not found
+    pub fn handle(&self) -> i32 {
+        let h = self.handle.load(Ordering::Relaxed);
+        if h != 0 {
+            return h;
+        }
+        let h = unsafe { cpp_actor_resolve(self.actor_name.as_ptr()) };
+        if h > 0 {
+            self.handle.store(h, Ordering::Relaxed);
+        }
+        h
+    }
+
+    /// Rust handle of the sender, so C++ can reply; 0 if there is none
+    pub fn sender_handle(&self) -> i32 {
+        let h = self.sender_handle.load(Ordering::Relaxed);
+        if h != 0 {
+            return h;
+        }
+        let h = match self.sender_name.as_ref().and_then(|s| s.to_str().ok()) {
+            Some(s) => resolve_handle(s),
+            None => 0,
+        };
+        if h > 0 {
+            self.sender_handle.store(h, Ordering::Relaxed);
+        }
+        h.max(0)
+    }
 }
 ''')
 
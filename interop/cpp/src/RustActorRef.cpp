@@ -8,7 +8,7 @@
 #include "actors/ActorRef.hpp"
 #include "InteropMessages.hpp"
 
-// Forward declare the Rust bridge function
+// Forward declare the Rust bridge functions
 extern "C" {
     int32_t rust_actor_send(
         const char* actor_name,
@@ -16,53 +16,73 @@ extern "C" {
         int32_t msg_type,
         const void* msg_data
     );
+
+    int32_t rust_actor_send_h(
+        int32_t actor_handle,
+        int32_t sender_handle,
+        int32_t msg_type,
+        const void* msg_data
+    );
 }
 
 namespace actors {
 
-void RustActorRef::send(const Message* m, [[maybe_unused]] Actor* sender) {
-    const char* sender_name_cstr = sender_name_.empty() ? nullptr : sender_name_.c_str();
+namespace {
 
+// Refs resolved by InteropManager::get_ref() skip the name lookup in Rust.
+// A sender name still goes by name, since the ref holds no sender handle.
+int32_t forward(const RustActorRef& ref, int32_t msg_type, const void* msg_data) {
+    if (ref.handle() > 0 && ref.sender().empty()) {
+        return rust_actor_send_h(ref.handle(), 0, msg_type, msg_data);
+    }
+    return rust_actor_send(ref.name().c_str(),
+                           ref.sender().empty() ? nullptr : ref.sender().c_str(),
+                           msg_type, msg_data);
+}
+
+} // namespace
+
+void RustActorRef::send(const Message* m, [[maybe_unused]] Actor* sender) {
     // Dispatch by message ID
     switch (m->get_message_id()) {
         case 1000: {  // Ping
             auto c_msg = static_cast<const msg::Ping*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_cstr, 1000, &c_msg);
+            forward(*this, 1000, &c_msg);
             break;
         }
         case 1001: {  // Pong
             auto c_msg = static_cast<const msg::Pong*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_cstr, 1001, &c_msg);
+            forward(*this, 1001, &c_msg);
             break;
         }
         case 1002: {  // DataRequest
             auto c_msg = static_cast<const msg::DataRequest*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_cstr, 1002, &c_msg);
+            forward(*this, 1002, &c_msg);
             break;
         }
         case 1003: {  // DataResponse
             auto c_msg = static_cast<const msg::DataResponse*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_cstr, 1003, &c_msg);
+            forward(*this, 1003, &c_msg);
             break;
         }
         case 1010: {  // Subscribe
             auto c_msg = static_cast<const msg::Subscribe*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_cstr, 1010, &c_msg);
+            forward(*this, 1010, &c_msg);
             break;
         }
         case 1011: {  // Unsubscribe
             auto c_msg = static_cast<const msg::Unsubscribe*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_cstr, 1011, &c_msg);
+            forward(*this, 1011, &c_msg);
             break;
         }
         case 1012: {  // MarketUpdate
             auto c_msg = static_cast<const msg::MarketUpdate*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_cstr, 1012, &c_msg);
+            forward(*this, 1012, &c_msg);
             break;
         }
         case 1013: {  // MarketDepth
             auto c_msg = static_cast<const msg::MarketDepth*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_cstr, 1013, &c_msg);
+            forward(*this, 1013, &c_msg);
             break;
         }
         default:
@@ -70,8 +90,8 @@ void RustActorRef::send(const Message* m, [[maybe_unused]] Actor* sender) {
             break;
     }
 
-    // Delete the message (caller expects us to take ownership)
-    delete m;
+    // Release the message (caller expects us to take ownership)
+    m->release();
 }
 
 } // namespace actors
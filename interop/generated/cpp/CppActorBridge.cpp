@@ -11,10 +11,27 @@
 #include "actors/Actor.hpp"
 #include "actors/act/Manager.hpp"
 
+#include <atomic>
 #include <string>
 #include <mutex>
 #include <memory>
 #include <unordered_map>
+#include <vector>
+
+// Slots in the lock-free sender proxy table (power of two)
+#ifndef INTEROP_PROXY_SLOTS
+#define INTEROP_PROXY_SLOTS 8192
+#endif
+
+// Slots in each actor's in-place ring (power of two)
+#ifndef INTEROP_RING_SLOTS
+#define INTEROP_RING_SLOTS 1024
+#endif
+
+static_assert((INTEROP_PROXY_SLOTS & (INTEROP_PROXY_SLOTS - 1)) == 0,
+              "INTEROP_PROXY_SLOTS must be a power of two");
+static_assert((INTEROP_RING_SLOTS & (INTEROP_RING_SLOTS - 1)) == 0,
+              "INTEROP_RING_SLOTS must be a power of two");
 
 namespace {
 
@@ -32,89 +49,227 @@ class RustSenderProxy : public actors::Actor {
     interop::RustActorIF rust_actor_;
 
 public:
-    RustSenderProxy(const std::string& rust_actor_name, const std::string& cpp_actor_name)
-        : rust_actor_(rust_actor_name, cpp_actor_name)
+    RustSenderProxy(const std::string& rust_actor_name, int32_t rust_handle, int32_t cpp_handle)
+        : rust_actor_(rust_actor_name, rust_handle, cpp_handle)
     {
         strncpy(name, rust_actor_name.c_str(), sizeof(name) - 1);
         name[sizeof(name) - 1] = '\0';
     }
 
     // Override send to forward to Rust
-    void send(const actors::Message* m, actors::Actor* sender) noexcept override {
-        // Forward to Rust based on message type
-        if (m->get_message_id() == 1000) {
-            rust_actor_.send(*static_cast<const msg::Ping*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1001) {
-            rust_actor_.send(*static_cast<const msg::Pong*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1002) {
-            rust_actor_.send(*static_cast<const msg::DataRequest*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1003) {
-            rust_actor_.send(*static_cast<const msg::DataResponse*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1010) {
-            rust_actor_.send(*static_cast<const msg::Subscribe*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1011) {
-            rust_actor_.send(*static_cast<const msg::Unsubscribe*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1012) {
-            rust_actor_.send(*static_cast<const msg::MarketUpdate*>(m));
-            delete m;
-            return;
+    void send(const actors::Message* m, actors::Actor*) noexcept override {
+        rust_actor_.forward(*m);  // Unknown message types are dropped
+        m->release();
+    }
+};
+
+/**
+ * Convert a C struct to its C++ message and send it to actor.
+ * Returns 0 on success, -2 if unknown message type.
+ */
+int32_t deliver(actors::Actor* actor, actors::Actor* sender, int32_t msg_type, const void* msg_data) {
+    // Dispatch based on message type (a jump table over the IDs)
+    switch (msg_type) {
+        case 1000:
+            actor->send(new msg::Ping(
+                msg::Ping::from_c_struct(*static_cast<const ::Ping*>(msg_data))
+            ), sender);
+            return 0;
+        case 1001:
+            actor->send(new msg::Pong(
+                msg::Pong::from_c_struct(*static_cast<const ::Pong*>(msg_data))
+            ), sender);
+            return 0;
+        case 1002:
+            actor->send(new msg::DataRequest(
+                msg::DataRequest::from_c_struct(*static_cast<const ::DataRequest*>(msg_data))
+            ), sender);
+            return 0;
+        case 1003:
+            actor->send(new msg::DataResponse(
+                msg::DataResponse::from_c_struct(*static_cast<const ::DataResponse*>(msg_data))
+            ), sender);
+            return 0;
+        case 1010:
+            actor->send(new msg::Subscribe(
+                msg::Subscribe::from_c_struct(*static_cast<const ::Subscribe*>(msg_data))
+            ), sender);
+            return 0;
+        case 1011:
+            actor->send(new msg::Unsubscribe(
+                msg::Unsubscribe::from_c_struct(*static_cast<const ::Unsubscribe*>(msg_data))
+            ), sender);
+            return 0;
+        case 1012:
+            actor->send(new msg::MarketUpdate(
+                msg::MarketUpdate::from_c_struct(*static_cast<const ::MarketUpdate*>(msg_data))
+            ), sender);
+            return 0;
+        case 1013:
+            actor->send(new msg::MarketDepth(
+                msg::MarketDepth::from_c_struct(*static_cast<const ::MarketDepth*>(msg_data))
+            ), sender);
+            return 0;
+        default:
+            return -2; // Unknown message type
+    }
+}
+
+/**
+ * Slots that Rust writes C structs into for an actor's in-place views.
+ * Producers claim positions in order with a CAS on tail, like ShmRing;
+ * a slot is free for the next lap once its view is deleted, so slots may
+ * be released out of order and a claim only fails while the slot it
+ * lands on is still in use.
+ */
+struct InPlaceRing {
+    interop::InPlaceSlot slots[INTEROP_RING_SLOTS];
+    alignas(64) std::atomic<uint64_t> tail{0};
+
+    InPlaceRing() {
+        for (uint64_t i = 0; i < INTEROP_RING_SLOTS; i++) {
+            slots[i].seq.store(i, std::memory_order_relaxed);
         }
-        if (m->get_message_id() == 1013) {
-            rust_actor_.send(*static_cast<const msg::MarketDepth*>(m));
-            delete m;
-            return;
+    }
+
+    interop::InPlaceSlot* claim() {
+        uint64_t pos = tail.load(std::memory_order_relaxed);
+        for (;;) {
+            interop::InPlaceSlot& slot = slots[pos & (INTEROP_RING_SLOTS - 1)];
+            int64_t dif = int64_t(slot.seq.load(std::memory_order_acquire) - pos);
+            if (dif == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.release_seq = pos + INTEROP_RING_SLOTS;
+                    return &slot;
+                }
+            } else if (dif < 0) {
+                return nullptr;  // Still in use from the previous lap
+            } else {
+                pos = tail.load(std::memory_order_relaxed);
+            }
         }
-        // Unknown message type, just delete it
-        delete m;
     }
-};
 
-// Cache of proxy actors (reused across multiple messages from same sender)
-std::unordered_map<std::string, std::unique_ptr<RustSenderProxy>> proxy_cache;
-std::mutex proxy_mutex;
+    // Slot whose data pointer is p, or nullptr if p isn't one
+    interop::InPlaceSlot* slot_of(void* p) {
+        auto addr = reinterpret_cast<uintptr_t>(p);
+        auto first = reinterpret_cast<uintptr_t>(slots[0].data);
+        if (addr < first) return nullptr;
+        uintptr_t off = addr - first;
+        if (off % sizeof(interop::InPlaceSlot) != 0) return nullptr;
+        uintptr_t i = off / sizeof(interop::InPlaceSlot);
+        return i < INTEROP_RING_SLOTS ? &slots[i] : nullptr;
+    }
+};
 
 /**
- * Get or create a proxy actor for a Rust sender.
- * The proxy enables C++ actors to use reply() naturally.
+ * C++ handles are the Manager's ActorIds, so sends find the actor in its
+ * lock-free ID table without touching a name.
  */
-actors::Actor* get_sender_proxy(const char* sender_name, const char* receiver_name) {
-    if (!sender_name || sender_name[0] == '\0') {
-        return nullptr;
+actors::Actor* actor_for(int32_t handle) {
+    if (handle <= 0 || !g_manager) return nullptr;
+    return g_manager->get_local_actor(actors::ActorId(handle));
+}
+
+// In-place rings by ActorId, created on first claim; the mutex only
+// guards creating them
+actors::IdTable<InPlaceRing> g_rings;
+std::vector<std::unique_ptr<InPlaceRing>> g_ring_owner;
+std::vector<int32_t> g_ring_handles;
+std::mutex ring_mutex;
+
+InPlaceRing* ring_for(int32_t handle) {
+    if (handle <= 0) return nullptr;
+    return g_rings.get(uint32_t(handle));
+}
+
+InPlaceRing* add_ring(int32_t handle) {
+    std::lock_guard<std::mutex> lock(ring_mutex);
+    InPlaceRing* ring = g_rings.get(uint32_t(handle));
+    if (!ring) {
+        g_ring_owner.push_back(std::make_unique<InPlaceRing>());
+        ring = g_ring_owner.back().get();
+        g_ring_handles.push_back(handle);
+        g_rings.set(uint32_t(handle), ring);
     }
+    return ring;
+}
 
-    std::string key = std::string(sender_name) + "->" + (receiver_name ? receiver_name : "");
+/**
+ * Sender proxies keyed by (receiver handle, sender handle). Lookups probe
+ * an open-addressed table without locking; a slot's proxy is written
+ * before its key is published and neither changes until shutdown. Once
+ * the table is 3/4 full, further proxies go to a map under the mutex.
+ */
+struct ProxySlot {
+    std::atomic<uint64_t> key{0};     // 0 = empty
+    RustSenderProxy* proxy = nullptr;
+};
+ProxySlot g_proxy_slots[INTEROP_PROXY_SLOTS];
+size_t g_proxy_slots_used = 0;
+std::unordered_map<uint64_t, RustSenderProxy*> g_proxy_overflow;
+std::vector<std::unique_ptr<RustSenderProxy>> g_proxies;     // Owns every proxy
+std::mutex proxy_mutex;
+
+size_t proxy_slot(uint64_t key) {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & (INTEROP_PROXY_SLOTS - 1);
+}
 
+actors::Actor* add_sender_proxy(int32_t receiver, int32_t sender, uint64_t key) {
     std::lock_guard<std::mutex> lock(proxy_mutex);
-    auto it = proxy_cache.find(key);
-    if (it != proxy_cache.end()) {
-        return it->second.get();
+    auto it = g_proxy_overflow.find(key);
+    if (it != g_proxy_overflow.end()) {
+        return it->second;
+    }
+
+    // Another thread may have added it since the lock-free probe
+    size_t i = proxy_slot(key);
+    for (;;) {
+        uint64_t k = g_proxy_slots[i].key.load(std::memory_order_relaxed);
+        if (k == key) return g_proxy_slots[i].proxy;
+        if (k == 0) break;
+        i = (i + 1) & (INTEROP_PROXY_SLOTS - 1);
+    }
+
+    const char* rust_name = rust_actor_name(sender);
+    if (!rust_name) {
+        return nullptr;  // Not a Rust actor handle; no reply route
     }
 
     // Create new proxy
-    auto proxy = std::make_unique<RustSenderProxy>(sender_name, receiver_name ? receiver_name : "");
+    auto proxy = std::make_unique<RustSenderProxy>(rust_name, sender, receiver);
     auto* ptr = proxy.get();
-    proxy_cache[key] = std::move(proxy);
+    g_proxies.push_back(std::move(proxy));
+    if (g_proxy_slots_used < INTEROP_PROXY_SLOTS / 4 * 3) {
+        g_proxy_slots[i].proxy = ptr;
+        g_proxy_slots[i].key.store(key, std::memory_order_release);
+        g_proxy_slots_used++;
+    } else {
+        g_proxy_overflow[key] = ptr;
+    }
     return ptr;
 }
 
+/**
+ * Get or create a proxy actor for a Rust sender.
+ * The proxy enables C++ actors to use reply() naturally.
+ */
+actors::Actor* get_sender_proxy(int32_t receiver, int32_t sender) {
+    if (sender <= 0) {
+        return nullptr;
+    }
+
+    const uint64_t key = (uint64_t(uint32_t(receiver)) << 32) | uint32_t(sender);
+    size_t i = proxy_slot(key);
+    for (;;) {
+        uint64_t k = g_proxy_slots[i].key.load(std::memory_order_acquire);
+        if (k == key) return g_proxy_slots[i].proxy;
+        if (k == 0) break;
+        i = (i + 1) & (INTEROP_PROXY_SLOTS - 1);
+    }
+    return add_sender_proxy(receiver, sender, key);
+}
+
 } // anonymous namespace
 
 extern "C" {
@@ -124,8 +279,24 @@ void cpp_actor_init(actors::Manager* mgr) {
 }
 
 void cpp_actor_shutdown() {
-    std::lock_guard<std::mutex> lock(proxy_mutex);
-    proxy_cache.clear();
+    {
+        std::lock_guard<std::mutex> lock(proxy_mutex);
+        for (auto& slot : g_proxy_slots) {
+            slot.key.store(0, std::memory_order_relaxed);
+            slot.proxy = nullptr;
+        }
+        g_proxy_slots_used = 0;
+        g_proxy_overflow.clear();
+        g_proxies.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(ring_mutex);
+        for (int32_t h : g_ring_handles) {
+            g_rings.set(uint32_t(h), nullptr);
+        }
+        g_ring_handles.clear();
+        g_ring_owner.clear();
+    }
     g_manager = nullptr;
 }
 
@@ -134,6 +305,11 @@ int32_t cpp_actor_exists(const char* name) {
     return g_manager->get_local_actor(name) != nullptr ? 1 : 0;
 }
 
+int32_t cpp_actor_resolve(const char* name) {
+    if (!name || !g_manager) return 0;
+    return int32_t(g_manager->get_actor_id(name));
+}
+
 int32_t cpp_actor_send(
     const char* actor_name,
     const char* sender_name,
@@ -142,90 +318,103 @@ int32_t cpp_actor_send(
 ) {
     if (!actor_name || !msg_data || !g_manager) return -1;
 
-    actors::Actor* actor = g_manager->get_local_actor(actor_name);
-    if (!actor) return -1;  // Actor not found
+    int32_t actor = cpp_actor_resolve(actor_name);
+    if (actor <= 0) return -1;  // Actor not found
 
-    actors::Actor* sender = get_sender_proxy(sender_name, actor_name);
+    int32_t sender = (sender_name && sender_name[0] != '\0') ? rust_actor_resolve(sender_name) : 0;
+    return cpp_actor_send_h(actor, sender, msg_type, msg_data);
+}
 
-    // Dispatch based on message type
-    switch (msg_type) {
-        case 1000: {
-            auto* cpp_msg = new msg::Ping(
-                msg::Ping::from_c_struct(
-                    *static_cast<const ::Ping*>(msg_data)
-                )
-            );
-            actor->send(cpp_msg, sender);
-            break;
-        }
-        case 1001: {
-            auto* cpp_msg = new msg::Pong(
-                msg::Pong::from_c_struct(
-                    *static_cast<const ::Pong*>(msg_data)
-                )
-            );
-            actor->send(cpp_msg, sender);
-            break;
-        }
-        case 1002: {
-            auto* cpp_msg = new msg::DataRequest(
-                msg::DataRequest::from_c_struct(
-                    *static_cast<const ::DataRequest*>(msg_data)
-                )
-            );
-            actor->send(cpp_msg, sender);
-            break;
-        }
-        case 1003: {
-            auto* cpp_msg = new msg::DataResponse(
-                msg::DataResponse::from_c_struct(
-                    *static_cast<const ::DataResponse*>(msg_data)
-                )
-            );
-            actor->send(cpp_msg, sender);
-            break;
-        }
-        case 1010: {
-            auto* cpp_msg = new msg::Subscribe(
-                msg::Subscribe::from_c_struct(
-                    *static_cast<const ::Subscribe*>(msg_data)
-                )
-            );
-            actor->send(cpp_msg, sender);
-            break;
-        }
-        case 1011: {
-            auto* cpp_msg = new msg::Unsubscribe(
-                msg::Unsubscribe::from_c_struct(
-                    *static_cast<const ::Unsubscribe*>(msg_data)
-                )
-            );
-            actor->send(cpp_msg, sender);
-            break;
-        }
-        case 1012: {
-            auto* cpp_msg = new msg::MarketUpdate(
-                msg::MarketUpdate::from_c_struct(
-                    *static_cast<const ::MarketUpdate*>(msg_data)
-                )
-            );
-            actor->send(cpp_msg, sender);
-            break;
-        }
-        case 1013: {
-            auto* cpp_msg = new msg::MarketDepth(
-                msg::MarketDepth::from_c_struct(
-                    *static_cast<const ::MarketDepth*>(msg_data)
-                )
-            );
-            actor->send(cpp_msg, sender);
-            break;
+int32_t cpp_actor_send_h(
+    int32_t actor_handle,
+    int32_t sender_handle,
+    int32_t msg_type,
+    const void* msg_data
+) {
+    if (!msg_data) return -1;
+
+    actors::Actor* actor = actor_for(actor_handle);
+    if (!actor) return -1;  // Invalid handle
+
+    actors::Actor* sender = get_sender_proxy(actor_handle, sender_handle);
+    return deliver(actor, sender, msg_type, msg_data);
+}
+
+int32_t cpp_actor_send_batch(
+    int32_t actor_handle,
+    int32_t sender_handle,
+    const interop_envelope* msgs,
+    int32_t count
+) {
+    actors::Actor* actor = actor_for(actor_handle);
+    if (!actor) return -1;  // Invalid handle
+    if (count <= 0) return 0;
+    if (!msgs) return -1;
+
+    // One handle and proxy lookup for the whole batch
+    actors::Actor* sender = get_sender_proxy(actor_handle, sender_handle);
+    int32_t sent = 0;
+    for (int32_t i = 0; i < count; i++) {
+        if (msgs[i].msg_data && deliver(actor, sender, msgs[i].msg_type, msgs[i].msg_data) == 0) {
+            sent++;
         }
+    }
+    return sent;
+}
+
+void* cpp_actor_claim(int32_t actor_handle) {
+    if (!actor_for(actor_handle)) return nullptr;  // Invalid handle
+
+    InPlaceRing* ring = ring_for(actor_handle);
+    if (!ring && !(ring = add_ring(actor_handle))) return nullptr;
+
+    interop::InPlaceSlot* slot = ring->claim();
+    return slot ? slot->data : nullptr;
+}
+
+int32_t cpp_actor_publish(
+    int32_t actor_handle,
+    int32_t sender_handle,
+    int32_t msg_type,
+    void* slot_data
+) {
+    actors::Actor* actor = actor_for(actor_handle);
+    InPlaceRing* ring = ring_for(actor_handle);
+    if (!actor || !ring) return -1;  // Invalid handle
+
+    interop::InPlaceSlot* slot = ring->slot_of(slot_data);
+    if (!slot) return -1;  // Not a slot of this actor's ring
+
+    actors::Actor* sender = get_sender_proxy(actor_handle, sender_handle);
+    switch (msg_type) {
+        case 1000:
+            actor->send(new (slot) msg::PingView(), sender);
+            return 0;
+        case 1001:
+            actor->send(new (slot) msg::PongView(), sender);
+            return 0;
+        case 1002:
+            actor->send(new (slot) msg::DataRequestView(), sender);
+            return 0;
+        case 1003:
+            actor->send(new (slot) msg::DataResponseView(), sender);
+            return 0;
+        case 1010:
+            actor->send(new (slot) msg::SubscribeView(), sender);
+            return 0;
+        case 1011:
+            actor->send(new (slot) msg::UnsubscribeView(), sender);
+            return 0;
+        case 1012:
+            actor->send(new (slot) msg::MarketUpdateView(), sender);
+            return 0;
+        case 1013:
+            actor->send(new (slot) msg::MarketDepthView(), sender);
+            return 0;
         default:
+            slot->release();
             return -2; // Unknown message type
     }
-
-    return 0;
 }
 
 } // extern "C"
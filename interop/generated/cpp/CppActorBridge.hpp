@@ -9,6 +9,7 @@
 #pragma once
 
 #include <cstdint>
+#include "interop_messages.h"
 
 // Forward declaration
 namespace actors { class Manager; }
@@ -27,6 +28,8 @@ int32_t cpp_actor_exists(const char* name);
 
 // Send a message to a C++ actor (async - called from Rust)
 // sender_name is used to create an ActorRef for replies
+// Resolves both names on every call; resolve once and use cpp_actor_send_h()
+// for repeated sends
 // Returns 0 on success, -1 if actor not found, -2 if unknown message type
 int32_t cpp_actor_send(
     const char* actor_name,
@@ -35,4 +38,46 @@ int32_t cpp_actor_send(
     const void* msg_data
 );
 
+// Resolve a C++ actor name to a handle for cpp_actor_send_h()
+// Returns a positive handle, or 0 if the actor doesn't exist
+// The handle is the actor's ActorId, valid until cpp_actor_shutdown()
+int32_t cpp_actor_resolve(const char* name);
+
+// Send a message to a C++ actor by handle (async - called from Rust)
+// sender_handle is the Rust sender's rust_actor_resolve() handle, used to
+// route replies (0 for none)
+// Returns 0 on success, -1 if the handle is invalid, -2 if unknown message type
+int32_t cpp_actor_send_h(
+    int32_t actor_handle,
+    int32_t sender_handle,
+    int32_t msg_type,
+    const void* msg_data
+);
+
+// Send count messages to a C++ actor in one call (async - called from Rust)
+// Messages with an unknown type or null data are skipped
+// Returns the number of messages sent, or -1 if the handle is invalid
+int32_t cpp_actor_send_batch(
+    int32_t actor_handle,
+    int32_t sender_handle,
+    const interop_envelope* msgs,
+    int32_t count
+);
+
+// Claim a slot in a C++ actor's in-place ring (called from Rust)
+// Write any interop C struct into the returned memory, then pass it to
+// cpp_actor_publish(); every claimed slot must be published
+// Returns null if the handle is invalid or the ring is full
+void* cpp_actor_claim(int32_t actor_handle);
+
+// Send a claimed slot to its actor as msg::<Name>View, without copying
+// An unknown message type releases the slot unsent
+// Returns 0 on success, -1 if the handle or slot is invalid, -2 if unknown message type
+int32_t cpp_actor_publish(
+    int32_t actor_handle,
+    int32_t sender_handle,
+    int32_t msg_type,
+    void* slot_data
+);
+
 } // extern "C"
@@ -52,59 +52,63 @@ public:
 
         int msg_id = m->get_message_id();
 
-        // Dispatch based on message ID
+        // Dispatch based on message ID (a jump table over the IDs)
         // Generated dispatch code for each interop message type
-        if (msg_id == 1000) {
-            auto c_msg = static_cast<const msg::Ping*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_ptr, 1000, &c_msg);
-            delete m;
-            return;
-        }
-        if (msg_id == 1001) {
-            auto c_msg = static_cast<const msg::Pong*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_ptr, 1001, &c_msg);
-            delete m;
-            return;
-        }
-        if (msg_id == 1002) {
-            auto c_msg = static_cast<const msg::DataRequest*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_ptr, 1002, &c_msg);
-            delete m;
-            return;
-        }
-        if (msg_id == 1003) {
-            auto c_msg = static_cast<const msg::DataResponse*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_ptr, 1003, &c_msg);
-            delete m;
-            return;
-        }
-        if (msg_id == 1010) {
-            auto c_msg = static_cast<const msg::Subscribe*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_ptr, 1010, &c_msg);
-            delete m;
-            return;
-        }
-        if (msg_id == 1011) {
-            auto c_msg = static_cast<const msg::Unsubscribe*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_ptr, 1011, &c_msg);
-            delete m;
-            return;
-        }
-        if (msg_id == 1012) {
-            auto c_msg = static_cast<const msg::MarketUpdate*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_ptr, 1012, &c_msg);
-            delete m;
-            return;
-        }
-        if (msg_id == 1013) {
-            auto c_msg = static_cast<const msg::MarketDepth*>(m)->to_c_struct();
-            rust_actor_send(target_name_.c_str(), sender_name_ptr, 1013, &c_msg);
-            delete m;
-            return;
+        switch (msg_id) {
+            case 1000: {
+                auto c_msg = static_cast<const msg::Ping*>(m)->to_c_struct();
+                rust_actor_send(target_name_.c_str(), sender_name_ptr, 1000, &c_msg);
+                m->release();
+                return;
+            }
+            case 1001: {
+                auto c_msg = static_cast<const msg::Pong*>(m)->to_c_struct();
+                rust_actor_send(target_name_.c_str(), sender_name_ptr, 1001, &c_msg);
+                m->release();
+                return;
+            }
+            case 1002: {
+                auto c_msg = static_cast<const msg::DataRequest*>(m)->to_c_struct();
+                rust_actor_send(target_name_.c_str(), sender_name_ptr, 1002, &c_msg);
+                m->release();
+                return;
+            }
+            case 1003: {
+                auto c_msg = static_cast<const msg::DataResponse*>(m)->to_c_struct();
+                rust_actor_send(target_name_.c_str(), sender_name_ptr, 1003, &c_msg);
+                m->release();
+                return;
+            }
+            case 1010: {
+                auto c_msg = static_cast<const msg::Subscribe*>(m)->to_c_struct();
+                rust_actor_send(target_name_.c_str(), sender_name_ptr, 1010, &c_msg);
+                m->release();
+                return;
+            }
+            case 1011: {
+                auto c_msg = static_cast<const msg::Unsubscribe*>(m)->to_c_struct();
+                rust_actor_send(target_name_.c_str(), sender_name_ptr, 1011, &c_msg);
+                m->release();
+                return;
+            }
+            case 1012: {
+                auto c_msg = static_cast<const msg::MarketUpdate*>(m)->to_c_struct();
+                rust_actor_send(target_name_.c_str(), sender_name_ptr, 1012, &c_msg);
+                m->release();
+                return;
+            }
+            case 1013: {
+                auto c_msg = static_cast<const msg::MarketDepth*>(m)->to_c_struct();
+                rust_actor_send(target_name_.c_str(), sender_name_ptr, 1013, &c_msg);
+                m->release();
+                return;
+            }
+            default:
+                break;
         }
 
         // Unknown message type - can't send across FFI
-        delete m;
+        m->release();
         throw std::runtime_error("Unknown message type for FFI: " + std::to_string(msg_id));
     }
 
@@ -32,7 +32,7 @@
 
 // Forward declare the Rust bridge function
 extern "C" {
-    int32_t rust_actor_exists(const char* name);
+    int32_t rust_actor_resolve(const char* name);
 }
 
 namespace interop {
@@ -42,64 +42,24 @@ namespace interop {
  *
  * This provides location transparency: C++ actors get a pointer to this
  * proxy (just like any other Actor*), and call send() on it. The proxy
- * forwards messages to the Rust actor via FFI.
+ * forwards messages to the Rust actor via FFI, by the handle resolved
+ * when it was created.
  */
 class RustActorProxy : public actors::Actor {
     RustActorIF rust_actor_;
 
 public:
-    RustActorProxy(const std::string& rust_actor_name)
-        : rust_actor_(rust_actor_name, "")
+    RustActorProxy(const std::string& rust_actor_name, int32_t handle)
+        : rust_actor_(rust_actor_name, handle, 0)
     {
         strncpy(name, rust_actor_name.c_str(), sizeof(name) - 1);
         name[sizeof(name) - 1] = '\0';
     }
 
     // Override send to forward to Rust
-    void send(const actors::Message* m, actors::Actor* sender) noexcept override {
-        // Forward to Rust based on message type
-        if (m->get_message_id() == 1000) {
-            rust_actor_.send(*static_cast<const msg::Ping*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1001) {
-            rust_actor_.send(*static_cast<const msg::Pong*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1002) {
-            rust_actor_.send(*static_cast<const msg::DataRequest*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1003) {
-            rust_actor_.send(*static_cast<const msg::DataResponse*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1010) {
-            rust_actor_.send(*static_cast<const msg::Subscribe*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1011) {
-            rust_actor_.send(*static_cast<const msg::Unsubscribe*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1012) {
-            rust_actor_.send(*static_cast<const msg::MarketUpdate*>(m));
-            delete m;
-            return;
-        }
-        if (m->get_message_id() == 1013) {
-            rust_actor_.send(*static_cast<const msg::MarketDepth*>(m));
-            delete m;
-            return;
-        }
-        // Unknown message type, just delete it
-        delete m;
+    void send(const actors::Message* m, actors::Actor*) noexcept override {
+        rust_actor_.forward(*m);  // Unknown message types are dropped
+        m->release();
     }
 };
 
@@ -130,7 +90,8 @@ public:
         }
 
         // Check Rust actors - return proxy if found
-        if (rust_actor_exists(name.c_str())) {
+        int32_t handle = rust_actor_resolve(name.c_str());
+        if (handle > 0) {
             std::lock_guard<std::mutex> lock(proxy_mutex_);
 
             // Check cache first
@@ -140,7 +101,7 @@ public:
             }
 
             // Create new proxy
-            auto proxy = std::make_unique<RustActorProxy>(name);
+            auto proxy = std::make_unique<RustActorProxy>(name, handle);
             auto* ptr = proxy.get();
             rust_proxies_[name] = std::move(proxy);
             return ptr;
@@ -168,8 +129,9 @@ public:
         }
 
         // Check Rust actors - return RustActorRef variant
-        if (rust_actor_exists(name.c_str())) {
-            return actors::ActorRef(actors::RustActorRef(name));
+        int32_t handle = rust_actor_resolve(name.c_str());
+        if (handle > 0) {
+            return actors::ActorRef(actors::RustActorRef(name, "", handle));
         }
 
         throw std::runtime_error("Actor not found: " + name);
@@ -7,13 +7,88 @@
 
 #include <string>
 #include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <algorithm>
 #include "actors/Message.hpp"
 #include "interop_messages.h"
 
+// In-place views use their message's ID plus this offset, so an actor can
+// handle both the copied message and its view
+#ifndef INTEROP_VIEW_ID_OFFSET
+#define INTEROP_VIEW_ID_OFFSET 10000
+#endif
+
+namespace interop {
+
+// Largest interop C struct; the payload size of an in-place slot
+inline constexpr std::size_t IN_PLACE_MAX = std::max({sizeof(::Ping), sizeof(::Pong), sizeof(::DataRequest), sizeof(::DataResponse), sizeof(::Subscribe), sizeof(::Unsubscribe), sizeof(::MarketUpdate), sizeof(::MarketDepth)});
+
+/**
+ * One slot of a C++ actor's in-place ring (see cpp_actor_claim()).
+ * Rust writes the C struct into data; the bridge constructs the view
+ * message in view and sends it, and deleting the view frees the slot.
+ */
+struct alignas(64) InPlaceSlot {
+    alignas(std::max_align_t) unsigned char view[sizeof(actors::Message)];
+    std::atomic<uint64_t> seq{0};   // Ring position this slot is free for
+    uint64_t release_seq = 0;       // seq to publish on release
+    alignas(std::max_align_t) unsigned char data[IN_PLACE_MAX];
+
+    void release() noexcept { seq.store(release_seq, std::memory_order_release); }
+};
+
+} // namespace interop
+
 namespace msg {
 
+/**
+ * Read-only view of a C struct that Rust wrote straight into the
+ * receiving actor's ring. Nothing is copied or allocated; the slot is
+ * released when the actor deletes the message after the handler returns,
+ * so copy out anything needed later.
+ *
+ * Usage:
+ *   MESSAGE_HANDLER(msg::MarketDepthView, on_depth);
+ *   void on_depth(const msg::MarketDepthView* m) { use(m->get().bid_prices[0]); }
+ */
+template <class C, int N>
+class InPlace : public actors::Message_N<N> {
+public:
+    static constexpr int32_t ID = N;
+
+    InPlace() = default;
+    InPlace(const InPlace&) = delete;
+    InPlace& operator=(const InPlace&) = delete;
+
+    const C& get() const noexcept {
+        return *reinterpret_cast<const C*>(slot()->data);
+    }
+    const C* operator->() const noexcept { return &get(); }
+
+    // Only constructed in a slot by the bridge; delete releases the slot
+    static void* operator new(std::size_t size, interop::InPlaceSlot* slot) noexcept {
+        static_assert(sizeof(InPlace) <= sizeof(slot->view), "view does not fit its slot");
+        static_assert(sizeof(C) <= interop::IN_PLACE_MAX, "C struct does not fit its slot");
+        (void)size;
+        return slot->view;
+    }
+    static void operator delete(void* p) noexcept {
+        static_cast<interop::InPlaceSlot*>(p)->release();
+    }
+    static void operator delete(void* p, interop::InPlaceSlot*) noexcept {
+        static_cast<interop::InPlaceSlot*>(p)->release();
+    }
+
+private:
+    // The view is the slot's first member
+    const interop::InPlaceSlot* slot() const noexcept {
+        return reinterpret_cast<const interop::InPlaceSlot*>(this);
+    }
+};
+
 class Ping : public actors::Message_N<1000> {
 public:
     static constexpr int32_t ID = 1000;
@@ -241,4 +316,13 @@ public:
     }
 };
 
+using PingView = InPlace<::Ping, 1000 + INTEROP_VIEW_ID_OFFSET>;
+using PongView = InPlace<::Pong, 1001 + INTEROP_VIEW_ID_OFFSET>;
+using DataRequestView = InPlace<::DataRequest, 1002 + INTEROP_VIEW_ID_OFFSET>;
+using DataResponseView = InPlace<::DataResponse, 1003 + INTEROP_VIEW_ID_OFFSET>;
+using SubscribeView = InPlace<::Subscribe, 1010 + INTEROP_VIEW_ID_OFFSET>;
+using UnsubscribeView = InPlace<::Unsubscribe, 1011 + INTEROP_VIEW_ID_OFFSET>;
+using MarketUpdateView = InPlace<::MarketUpdate, 1012 + INTEROP_VIEW_ID_OFFSET>;
+using MarketDepthView = InPlace<::MarketDepth, 1013 + INTEROP_VIEW_ID_OFFSET>;
+
 } // namespace msg
@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <string>
 #include <cstring>
+#include <vector>
 #include "InteropMessages.hpp"
 
 // Forward declare the Rust bridge functions
@@ -21,6 +24,26 @@ extern "C" {
     );
 
     int32_t rust_actor_exists(const char* name);
+
+    // Handle API: resolve once, then send without name lookups
+    int32_t rust_actor_resolve(const char* name);
+    const char* rust_actor_name(int32_t handle);
+    int32_t rust_actor_send_h(
+        int32_t actor_handle,
+        int32_t sender_handle,
+        int32_t msg_type,
+        const void* msg_data
+    );
+
+    int32_t rust_actor_send_batch(
+        int32_t actor_handle,
+        int32_t sender_handle,
+        const interop_envelope* msgs,
+        int32_t count
+    );
+
+    // Implemented in CppActorBridge.cpp
+    int32_t cpp_actor_resolve(const char* name);
 }
 
 namespace interop {
@@ -28,6 +51,9 @@ namespace interop {
 /**
  * RustActorIF - Interface for C++ actors to send messages to Rust actors
  *
+ * Names are resolved to handles on the first send and cached, so later
+ * sends skip the name lookup on both sides of the bridge.
+ *
  * Usage:
  *   RustActorIF rust_actor("my_rust_actor", "my_cpp_actor");
  *   rust_actor.send(msg::Ping{42});           // async (fire-and-forget)
@@ -38,30 +64,117 @@ public:
         : actor_name_(actor_name)
         , sender_name_(sender_name) {}
 
+    // From handles already resolved with rust_actor_resolve() / cpp_actor_resolve()
+    RustActorIF(const std::string& actor_name, int32_t handle, int32_t sender_handle)
+        : actor_name_(actor_name)
+        , handle_(handle)
+        , sender_handle_(sender_handle) {}
+
+    RustActorIF(const RustActorIF& o)
+        : actor_name_(o.actor_name_)
+        , sender_name_(o.sender_name_)
+        , handle_(o.handle_.load(std::memory_order_relaxed))
+        , sender_handle_(o.sender_handle_.load(std::memory_order_relaxed)) {}
+
+    RustActorIF& operator=(const RustActorIF& o) {
+        actor_name_ = o.actor_name_;
+        sender_name_ = o.sender_name_;
+        handle_.store(o.handle_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        sender_handle_.store(o.sender_handle_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+
     /**
      * Send a message asynchronously (fire-and-forget)
      * Returns 0 on success, -1 if actor not found
      */
     template<typename Msg>
     int send(const Msg& msg) const {
+        int32_t h = handle();
+        if (h <= 0) return -1;
         auto c_msg = msg.to_c_struct();
-        return rust_actor_send(
-            actor_name_.c_str(),
-            sender_name_.empty() ? nullptr : sender_name_.c_str(),
-            Msg::ID,
-            &c_msg
-        );
+        return rust_actor_send_h(h, sender_handle(), Msg::ID, &c_msg);
+    }
+
+    /**
+     * Send n messages of one type with a single FFI call
+     * Returns the number sent, or -1 if actor not found
+     */
+    template<typename Msg>
+    int send_batch(const Msg* msgs, size_t n) const {
+        int32_t h = handle();
+        if (h <= 0) return -1;
+        std::vector<decltype(msgs->to_c_struct())> c_msgs;
+        std::vector<interop_envelope> envelopes(n);
+        c_msgs.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            c_msgs.push_back(msgs[i].to_c_struct());
+            envelopes[i] = {Msg::ID, &c_msgs[i]};
+        }
+        return rust_actor_send_batch(h, sender_handle(), envelopes.data(), static_cast<int32_t>(n));
     }
 
+    /**
+     * Send any interop message by its runtime ID (the caller keeps ownership)
+     * Returns 0 on success, -1 if actor not found, -2 if unknown message type
+     */
+    int forward(const actors::Message& m) const;
+
     bool exists() const {
         return rust_actor_exists(actor_name_.c_str()) != 0;
     }
 
     const std::string& name() const { return actor_name_; }
 
+    // Rust handle of the target; resolved on first use, 0 while not found
+    int32_t handle() const {
+        int32_t h = handle_.load(std::memory_order_relaxed);
+        if (h == 0) {
+            h = rust_actor_resolve(actor_name_.c_str());
+            if (h > 0) handle_.store(h, std::memory_order_relaxed);
+        }
+        return h;
+    }
+
+    // C++ handle of the sender, 0 if there is none
+    int32_t sender_handle() const {
+        int32_t h = sender_handle_.load(std::memory_order_relaxed);
+        if (h == 0 && !sender_name_.empty()) {
+            h = cpp_actor_resolve(sender_name_.c_str());
+            if (h > 0) sender_handle_.store(h, std::memory_order_relaxed);
+        }
+        return h > 0 ? h : 0;
+    }
+
 private:
     std::string actor_name_;
     std::string sender_name_;
+    mutable std::atomic<int32_t> handle_{0};
+    mutable std::atomic<int32_t> sender_handle_{0};
 };
 
+inline int RustActorIF::forward(const actors::Message& m) const {
+    // Dispatch based on message type (a jump table over the IDs)
+    switch (m.get_message_id()) {
+        case 1000:
+            return send(static_cast<const msg::Ping&>(m));
+        case 1001:
+            return send(static_cast<const msg::Pong&>(m));
+        case 1002:
+            return send(static_cast<const msg::DataRequest&>(m));
+        case 1003:
+            return send(static_cast<const msg::DataResponse&>(m));
+        case 1010:
+            return send(static_cast<const msg::Subscribe&>(m));
+        case 1011:
+            return send(static_cast<const msg::Unsubscribe&>(m));
+        case 1012:
+            return send(static_cast<const msg::MarketUpdate&>(m));
+        case 1013:
+            return send(static_cast<const msg::MarketDepth&>(m));
+        default:
+            return -2; // Unknown message type
+    }
+}
+
 } // namespace interop
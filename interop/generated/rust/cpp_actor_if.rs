@@ -7,8 +7,10 @@
 
 use std::ffi::CString;
 use std::os::raw::{c_char, c_int, c_void};
+use std::sync::atomic::{AtomicI32, Ordering};
 
 use crate::interop_messages::*;
+use crate::rust_actor_bridge::resolve_handle;
 
 // C++ bridge functions - resolved at final link time (no #[link] attribute)
 // The final executable must link both Rust and C++ code together
@@ -21,6 +23,33 @@ extern "C" {
     ) -> c_int;
 
     fn cpp_actor_exists(name: *const c_char) -> c_int;
+
+    // Handle API: resolve once, then send without name lookups
+    fn cpp_actor_resolve(name: *const c_char) -> c_int;
+
+    fn cpp_actor_send_h(
+        actor_handle: c_int,
+        sender_handle: c_int,
+        msg_type: c_int,
+        msg_data: *const c_void,
+    ) -> c_int;
+
+    fn cpp_actor_send_batch(
+        actor_handle: c_int,
+        sender_handle: c_int,
+        msgs: *const CInteropEnvelope,
+        count: c_int,
+    ) -> c_int;
+
+    // In-place API: write the C struct straight into the C++ actor's ring
+    fn cpp_actor_claim(actor_handle: c_int) -> *mut c_void;
+
+    fn cpp_actor_publish(
+        actor_handle: c_int,
+        sender_handle: c_int,
+        msg_type: c_int,
+        slot_data: *mut c_void,
+    ) -> c_int;
 }
 
 /// Trait for messages that can be sent via FFI
@@ -30,6 +59,43 @@ pub trait InteropMessage {
     fn to_c_struct(&self) -> Self::CStruct;
 }
 
+/// Trait for C structs that can be built in place with send_in_place()
+pub trait InteropCStruct: Default {
+    const MSG_ID: i32;
+}
+
+impl InteropCStruct for CPing {
+    const MSG_ID: i32 = 1000;
+}
+
+impl InteropCStruct for CPong {
+    const MSG_ID: i32 = 1001;
+}
+
+impl InteropCStruct for CDataRequest {
+    const MSG_ID: i32 = 1002;
+}
+
+impl InteropCStruct for CDataResponse {
+    const MSG_ID: i32 = 1003;
+}
+
+impl InteropCStruct for CSubscribe {
+    const MSG_ID: i32 = 1010;
+}
+
+impl InteropCStruct for CUnsubscribe {
+    const MSG_ID: i32 = 1011;
+}
+
+impl InteropCStruct for CMarketUpdate {
+    const MSG_ID: i32 = 1012;
+}
+
+impl InteropCStruct for CMarketDepth {
+    const MSG_ID: i32 = 1013;
+}
+
 impl InteropMessage for Ping {
     type CStruct = CPing;
     const MSG_ID: i32 = 1000;
@@ -96,12 +162,17 @@ impl InteropMessage for MarketDepth {
 
 /// CppActorIF - Interface for Rust actors to send messages to C++ actors
 ///
+/// Names are resolved to handles on the first send and cached, so later
+/// sends skip the name lookup on both sides of the bridge.
+///
 /// Usage:
 ///   let cpp_actor = CppActorIF::new("my_cpp_actor", "my_rust_actor");
 ///   cpp_actor.send(&Ping { count: 42 });           // async (fire-and-forget)
 pub struct CppActorIF {
     actor_name: CString,
     sender_name: Option<CString>,
+    handle: AtomicI32,          // 0 until resolved
+    sender_handle: AtomicI32,   // 0 until resolved
 }
 
 impl CppActorIF {
@@ -109,27 +180,71 @@ impl CppActorIF {
         CppActorIF {
             actor_name: CString::new(actor_name).unwrap(),
             sender_name: sender_name.map(|s| CString::new(s).unwrap()),
+            handle: AtomicI32::new(0),
+            sender_handle: AtomicI32::new(0),
         }
     }
 
     /// Send a message asynchronously (fire-and-forget)
     /// Returns 0 on success, -1 if actor not found
     pub fn send<M: InteropMessage>(&self, msg: &M) -> i32 {
+        let handle = self.handle();
+        if handle <= 0 {
+            return -1;
+        }
         let c_msg = msg.to_c_struct();
-        let sender_ptr = self.sender_name
-            .as_ref()
-            .map(|s| s.as_ptr())
-            .unwrap_or(std::ptr::null());
         unsafe {
-            cpp_actor_send(
-                self.actor_name.as_ptr(),
-                sender_ptr,
+            cpp_actor_send_h(
+                handle,
+                self.sender_handle(),
                 M::MSG_ID,
                 &c_msg as *const _ as *const c_void,
             )
         }
     }
 
+    /// Send messages of one type with a single FFI call
+    /// Returns the number sent, or -1 if actor not found
+    pub fn send_batch<M: InteropMessage>(&self, msgs: &[M]) -> i32 {
+        let handle = self.handle();
+        if handle <= 0 {
+            return -1;
+        }
+        let c_msgs: Vec<M::CStruct> = msgs.iter().map(|m| m.to_c_struct()).collect();
+        let envelopes: Vec<CInteropEnvelope> = c_msgs
+            .iter()
+            .map(|c| CInteropEnvelope { msg_type: M::MSG_ID, msg_data: c as *const _ as *const c_void })
+            .collect();
+        unsafe {
+            cpp_actor_send_batch(
+                handle,
+                self.sender_handle(),
+                envelopes.as_ptr(),
+                envelopes.len() as c_int,
+            )
+        }
+    }
+
+    /// Build a C struct directly in a slot of the C++ actor's ring
+    /// The C++ handler receives it as msg::<Name>View, with no copy or
+    /// allocation on either side
+    /// Returns 0 on success, -1 if actor not found, -3 if the ring is full
+    pub fn send_in_place<C: InteropCStruct, F: FnOnce(&mut C)>(&self, fill: F) -> i32 {
+        let handle = self.handle();
+        if handle <= 0 {
+            return -1;
+        }
+        let slot = unsafe { cpp_actor_claim(handle) } as *mut C;
+        if slot.is_null() {
+            return -3;
+        }
+        unsafe {
+            slot.write(C::default());
+            fill(&mut *slot);
+            cpp_actor_publish(handle, self.sender_handle(), C::MSG_ID, slot as *mut c_void)
+        }
+    }
+
     pub fn exists(&self) -> bool {
         unsafe { cpp_actor_exists(self.actor_name.as_ptr()) != 0 }
     }
@@ -137,4 +252,33 @@ impl CppActorIF {
     pub fn name(&self) -> &str {
         self.actor_name.to_str().unwrap()
     }
+
+    /// C++ handle of the target; resolved on first use, 0 while not found
+    pub fn handle(&self) -> i32 {
+        let h = self.handle.load(Ordering::Relaxed);
+        if h != 0 {
+            return h;
+        }
+        let h = unsafe { cpp_actor_resolve(self.actor_name.as_ptr()) };
+        if h > 0 {
+            self.handle.store(h, Ordering::Relaxed);
+        }
+        h
+    }
+
+    /// Rust handle of the sender, so C++ can reply; 0 if there is none
+    pub fn sender_handle(&self) -> i32 {
+        let h = self.sender_handle.load(Ordering::Relaxed);
+        if h != 0 {
+            return h;
+        }
+        let h = match self.sender_name.as_ref().and_then(|s| s.to_str().ok()) {
+            Some(s) => resolve_handle(s),
+            None => 0,
+        };
+        if h > 0 {
+            self.sender_handle.store(h, Ordering::Relaxed);
+        }
+        h.max(0)
+    }
 }
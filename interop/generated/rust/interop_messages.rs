@@ -38,6 +38,14 @@ impl CInteropString {
     }
 }
 
+/// One message in a batch send (matches C interop_envelope)
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct CInteropEnvelope {
+    pub msg_type: i32,
+    pub msg_data: *const std::ffi::c_void,
+}
+
 // Message ID constants
 pub const MSG_PING: i32 = 1000;
 pub const MSG_PONG: i32 = 1001;
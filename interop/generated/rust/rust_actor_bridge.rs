@@ -7,9 +7,10 @@
 
 #![allow(dead_code)]
 
-use std::ffi::CStr;
+use std::collections::HashMap;
+use std::ffi::{CStr, CString};
 use std::os::raw::{c_char, c_int, c_void};
-use std::sync::Mutex;
+use std::sync::{Mutex, RwLock};
 
 use actors::{ActorRef, Manager};
 use crate::interop_messages::*;
@@ -23,6 +24,19 @@ unsafe impl Sync for ManagerPtr {}
 // We use Mutex with a wrapper type since raw pointers don't impl Send/Sync
 static MANAGER: Mutex<ManagerPtr> = Mutex::new(ManagerPtr(std::ptr::null()));
 
+/// Resolved actors for rust_actor_send_h(), indexed by handle - 1
+///
+/// A handle is handed out once per name and stays valid until
+/// rust_actor_shutdown(). Sends only take the read lock.
+struct HandleTable {
+    entries: Vec<(CString, ActorRef)>,
+    by_name: HashMap<String, c_int>,
+}
+unsafe impl Send for HandleTable {}
+unsafe impl Sync for HandleTable {}
+
+static HANDLES: RwLock<Option<HandleTable>> = RwLock::new(None);
+
 /// Get reference to the global Manager
 fn get_manager() -> Option<&'static Manager> {
     let guard = MANAGER.lock().ok()?;
@@ -40,6 +54,42 @@ fn create_cpp_sender_ref(sender_name: &str, receiver_name: &str) -> Option<Actor
     None
 }
 
+/// Resolve an actor name to a handle (0 if not found)
+/// Also used by CppActorIF to pass its sender as a handle
+pub fn resolve_handle(name: &str) -> c_int {
+    if let Ok(guard) = HANDLES.read() {
+        if let Some(&h) = guard.as_ref().and_then(|t| t.by_name.get(name)) {
+            return h;
+        }
+    }
+
+    let mgr = match get_manager() {
+        Some(m) => m,
+        None => return 0,
+    };
+    let actor_ref = match mgr.get_ref(name) {
+        Some(r) => r,
+        None => return 0,
+    };
+    let c_name = match CString::new(name) {
+        Ok(c) => c,
+        Err(_) => return 0,
+    };
+
+    let mut guard = match HANDLES.write() {
+        Ok(g) => g,
+        Err(_) => return 0,
+    };
+    let table = guard.get_or_insert_with(|| HandleTable { entries: Vec::new(), by_name: HashMap::new() });
+    if let Some(&h) = table.by_name.get(name) {
+        return h;
+    }
+    table.entries.push((c_name, actor_ref));
+    let h = table.entries.len() as c_int;
+    table.by_name.insert(name.to_string(), h);
+    h
+}
+
 /// Initialize the Rust actor bridge with a Manager pointer
 /// The Manager's registry is used to look up actors by name
 #[no_mangle]
@@ -52,6 +102,9 @@ pub extern "C" fn rust_actor_init(mgr: *const Manager) {
 /// Shutdown the Rust actor runtime
 #[no_mangle]
 pub extern "C" fn rust_actor_shutdown() {
+    if let Ok(mut guard) = HANDLES.write() {
+        *guard = None;
+    }
     if let Ok(mut guard) = MANAGER.lock() {
         guard.0 = std::ptr::null();
     }
@@ -74,8 +127,36 @@ pub extern "C" fn rust_actor_exists(name: *const c_char) -> c_int {
     if mgr.get_ref(name_str).is_some() { 1 } else { 0 }
 }
 
+/// Resolve a Rust actor name to a handle for rust_actor_send_h()
+/// Returns a positive handle, or 0 if the actor doesn't exist
+#[no_mangle]
+pub extern "C" fn rust_actor_resolve(name: *const c_char) -> c_int {
+    if name.is_null() {
+        return 0;
+    }
+    match unsafe { CStr::from_ptr(name).to_str() } {
+        Ok(s) => resolve_handle(s),
+        Err(_) => 0,
+    }
+}
+
+/// Name of a resolved actor, or null for an invalid handle
+/// The pointer stays valid until rust_actor_shutdown()
+#[no_mangle]
+pub extern "C" fn rust_actor_name(handle: c_int) -> *const c_char {
+    let guard = match HANDLES.read() {
+        Ok(g) => g,
+        Err(_) => return std::ptr::null(),
+    };
+    match guard.as_ref().and_then(|t| t.entries.get((handle as usize).wrapping_sub(1))) {
+        Some((name, _)) => name.as_ptr(),
+        None => std::ptr::null(),
+    }
+}
+
 /// Send a message to a Rust actor (async - called from C++)
 /// sender_name is used to create a sender ActorRef for replies
+/// Resolves the name on every call; prefer rust_actor_send_h()
 /// Returns 0 on success, -1 if actor not found, -2 if unknown message type
 #[no_mangle]
 pub extern "C" fn rust_actor_send(
@@ -88,30 +169,89 @@ pub extern "C" fn rust_actor_send(
         return -1;
     }
 
-    let name = match unsafe { CStr::from_ptr(actor_name).to_str() } {
-        Ok(s) => s,
+    let handle = rust_actor_resolve(actor_name);
+    if handle <= 0 {
+        return -1;  // Actor not found
+    }
+
+    // C++ senders aren't routed back yet, see rust_actor_send_h()
+    let _ = sender_name;
+    rust_actor_send_h(handle, 0, msg_type, msg_data)
+}
+
+/// Send a message to a Rust actor by handle (async - called from C++)
+/// sender_handle is the C++ sender's cpp_actor_resolve() handle (0 for none)
+/// Returns 0 on success, -1 if the handle is invalid, -2 if unknown message type
+#[no_mangle]
+pub extern "C" fn rust_actor_send_h(
+    actor_handle: c_int,
+    sender_handle: c_int,
+    msg_type: c_int,
+    msg_data: *const c_void,
+) -> c_int {
+    if msg_data.is_null() {
+        return -1;
+    }
+
+    let guard = match HANDLES.read() {
+        Ok(g) => g,
         Err(_) => return -1,
     };
-
-    let mgr = match get_manager() {
-        Some(m) => m,
-        None => return -1,
+    let actor_ref = match guard.as_ref().and_then(|t| t.entries.get((actor_handle as usize).wrapping_sub(1))) {
+        Some((_, r)) => r,
+        None => return -1,  // Invalid handle
     };
 
-    let actor_ref = match mgr.get_ref(name) {
-        Some(r) => r,
-        None => return -1,  // Actor not found
-    };
+    // For C++ senders, we create a special ActorRef that routes back via FFI
+    // This is handled by the CppSenderProxy in the actor
+    let _ = sender_handle;
+    deliver(actor_ref, None, msg_type, msg_data) // TODO: Implement CppActorRef
+}
 
-    // Create sender ref for replies (if sender name provided)
-    let sender_ref: Option<ActorRef> = if sender_name.is_null() {
-        None
-    } else {
-        // For C++ senders, we create a special ActorRef that routes back via FFI
-        // This is handled by the CppSenderProxy in the actor
-        None // TODO: Implement CppActorRef
+/// Send count messages to a Rust actor in one call (async - called from C++)
+/// Messages with an unknown type or null data are skipped
+/// Returns the number of messages sent, or -1 if the handle is invalid
+#[no_mangle]
+pub extern "C" fn rust_actor_send_batch(
+    actor_handle: c_int,
+    sender_handle: c_int,
+    msgs: *const CInteropEnvelope,
+    count: c_int,
+) -> c_int {
+    let guard = match HANDLES.read() {
+        Ok(g) => g,
+        Err(_) => return -1,
     };
+    let actor_ref = match guard.as_ref().and_then(|t| t.entries.get((actor_handle as usize).wrapping_sub(1))) {
+        Some((_, r)) => r,
+        None => return -1,  // Invalid handle
+    };
+    if count <= 0 {
+        return 0;
+    }
+    if msgs.is_null() {
+        return -1;
+    }
+
+    let _ = sender_handle;
+    let batch = unsafe { std::slice::from_raw_parts(msgs, count as usize) };
+    let mut sent = 0;
+    for e in batch {
+        if !e.msg_data.is_null() && deliver(actor_ref, None, e.msg_type, e.msg_data) == 0 {
+            sent += 1;
+        }
+    }
+    sent
+}
 
+/// Convert a C struct to its Rust message and send it to actor_ref
+/// Returns 0 on success, -2 if unknown message type
+fn deliver(
+    actor_ref: &ActorRef,
+    sender_ref: Option<ActorRef>,
+    msg_type: c_int,
+    msg_data: *const c_void,
+) -> c_int {
     // Convert C struct to Rust message and send
     match msg_type {
         1000 => {
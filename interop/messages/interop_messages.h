@@ -64,6 +64,12 @@ typedef struct {
     uint32_t len;
 } interop_string;
 
+/* One message in a batch (cpp_actor_send_batch / rust_actor_send_batch) */
+typedef struct {
+    int32_t msg_type;
+    const void* msg_data;
+} interop_envelope;
+
 /* ============================================================
  * Message Definitions
  * ============================================================ */
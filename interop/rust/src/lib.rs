@@ -37,3 +37,7 @@ pub mod rust_ping;
 
 #[path = "../../examples/rust_subscribes_cpp_publisher/rust_subscriber.rs"]
 pub mod rust_subscriber;
+
+// Benchmark actors (bench/bench_ffi.cpp)
+#[path = "../../bench/rust_echo.rs"]
+pub mod rust_echo;
@@ -7,13 +7,16 @@
 //! - Shutdown
 //! - Register C++ actor lookup for cross-language transparency
 
+use std::collections::HashMap;
 use std::ffi::CString;
-use std::sync::Mutex;
+use std::sync::{Mutex, RwLock};
 use actors::{register_cpp_lookup, ActorRef, CppActorRef, Manager, ThreadConfig};
 use crate::ping_pong::RustPongActor;
 use crate::rust_ping::PingActor;
 use crate::pubsub::RustPublisher;
 use crate::rust_subscriber::RustSubscriber;
+use crate::rust_echo::RustEchoActor;
+use crate::rust_actor_bridge::resolve_handle;
 
 // Wrapper to make Manager pointer safe for static storage
 struct ManagerPtr(*mut Manager);
@@ -73,6 +76,22 @@ pub extern "C" fn register_rust_pong_actor() -> *const Manager {
     }
 }
 
+/// Register the RustEchoActor (bench_ffi) with the Rust Manager
+/// Returns the Manager pointer for rust_actor_init()
+#[no_mangle]
+pub extern "C" fn register_rust_echo_actor() -> *const Manager {
+    let mut guard = RUST_MANAGER.lock().unwrap();
+    if !guard.0.is_null() {
+        let mgr = unsafe { &mut *guard.0 };
+        let handle = mgr.get_handle();
+        let actor = RustEchoActor::new(handle);
+        mgr.manage("rust_echo", Box::new(actor), ThreadConfig::default());
+        guard.0 as *const Manager
+    } else {
+        std::ptr::null()
+    }
+}
+
 /// Get pointer to the Rust Manager
 /// For passing to rust_actor_init()
 #[no_mangle]
@@ -163,14 +182,36 @@ use std::os::raw::{c_char, c_int, c_void};
 
 // FFI functions to send to C++ actors
 extern "C" {
-    fn cpp_actor_send(
-        actor_name: *const c_char,
-        sender_name: *const c_char,
+    fn cpp_actor_exists(name: *const c_char) -> c_int;
+
+    fn cpp_actor_resolve(name: *const c_char) -> c_int;
+
+    fn cpp_actor_send_h(
+        actor_handle: c_int,
+        sender_handle: c_int,
         msg_type: c_int,
         msg_data: *const c_void,
     ) -> c_int;
+}
 
-    fn cpp_actor_exists(name: *const c_char) -> c_int;
+// C++ handles by actor name, so sends after the first to each actor don't
+// allocate CStrings or go through the C++ name lookup
+static CPP_HANDLES: RwLock<Option<HashMap<String, c_int>>> = RwLock::new(None);
+
+/// C++ handle for name (0 if not found)
+fn cpp_handle(name: &str) -> c_int {
+    if let Some(&h) = CPP_HANDLES.read().unwrap().as_ref().and_then(|m| m.get(name)) {
+        return h;
+    }
+    let name_cstr = match CString::new(name) {
+        Ok(c) => c,
+        Err(_) => return 0,
+    };
+    let h = unsafe { cpp_actor_resolve(name_cstr.as_ptr()) };
+    if h > 0 {
+        CPP_HANDLES.write().unwrap().get_or_insert_with(HashMap::new).insert(name.to_string(), h);
+    }
+    h
 }
 
 /// The send function that will be passed to CppActorRef.
@@ -179,13 +220,11 @@ extern "C" {
 fn cpp_send_fn(target: &str, sender: &str, msg: &dyn actors::Message) -> i32 {
     use crate::interop_messages::*;
 
-    let target_cstr = CString::new(target).unwrap();
-    let sender_cstr = if sender.is_empty() {
-        None
-    } else {
-        Some(CString::new(sender).unwrap())
-    };
-    let sender_ptr = sender_cstr.as_ref().map_or(std::ptr::null(), |s| s.as_ptr());
+    let target_handle = cpp_handle(target);
+    if target_handle <= 0 {
+        return -1;  // Actor not found
+    }
+    let sender_handle = if sender.is_empty() { 0 } else { resolve_handle(sender) };
 
     let msg_id = msg.message_id();
 
@@ -194,25 +233,25 @@ fn cpp_send_fn(target: &str, sender: &str, msg: &dyn actors::Message) -> i32 {
         MSG_PING => {
             if let Some(m) = msg.as_any().downcast_ref::<Ping>() {
                 let c_msg = m.to_c_struct();
-                unsafe { cpp_actor_send(target_cstr.as_ptr(), sender_ptr, msg_id, &c_msg as *const _ as *const c_void) }
+                unsafe { cpp_actor_send_h(target_handle, sender_handle, msg_id, &c_msg as *const _ as *const c_void) }
             } else { -3 }
         }
         MSG_PONG => {
             if let Some(m) = msg.as_any().downcast_ref::<Pong>() {
                 let c_msg = m.to_c_struct();
-                unsafe { cpp_actor_send(target_cstr.as_ptr(), sender_ptr, msg_id, &c_msg as *const _ as *const c_void) }
+                unsafe { cpp_actor_send_h(target_handle, sender_handle, msg_id, &c_msg as *const _ as *const c_void) }
             } else { -3 }
         }
         MSG_SUBSCRIBE => {
             if let Some(m) = msg.as_any().downcast_ref::<Subscribe>() {
                 let c_msg = m.to_c_struct();
-                unsafe { cpp_actor_send(target_cstr.as_ptr(), sender_ptr, msg_id, &c_msg as *const _ as *const c_void) }
+                unsafe { cpp_actor_send_h(target_handle, sender_handle, msg_id, &c_msg as *const _ as *const c_void) }
             } else { -3 }
         }
         MSG_MARKETUPDATE => {
             if let Some(m) = msg.as_any().downcast_ref::<MarketUpdate>() {
                 let c_msg = m.to_c_struct();
-                unsafe { cpp_actor_send(target_cstr.as_ptr(), sender_ptr, msg_id, &c_msg as *const _ as *const c_void) }
+                unsafe { cpp_actor_send_h(target_handle, sender_handle, msg_id, &c_msg as *const _ as *const c_void) }
             } else { -3 }
         }
         _ => -2  // Unknown message type
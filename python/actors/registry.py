@@ -11,13 +11,16 @@ import threading
 import time
 from dataclasses import dataclass, field
 from pathlib import Path
-from typing import Dict, List, Optional, Set
+from typing import Callable, Dict, List, Optional, Set, Tuple
 import logging
 
 from actors import Actor, Manager, LocalActorRef
 from .registry_messages import (
-    RegisterActor, UnregisterActor, RegistrationOk, RegistrationFailed,
+    RegisterActor, RegisterActors, RegisterActorsResult,
+    UnregisterActor, RegistrationOk, RegistrationFailed,
     LookupActor, LookupResult, Heartbeat, HeartbeatAck,
+    SubscribeRegistry, UnsubscribeRegistry, SubscriptionOk,
+    ActorMoved, ManagerOffline, ManagerOnline,
     StartManager, StopManager, RestartManager, ManagerStatus
 )
 
@@ -31,6 +34,13 @@ class ActorEntry:
     manager_id: str
 
 
+@dataclass
+class Subscription:
+    """What one subscriber wants pushed (see SubscribeRegistry)."""
+    actor_names: Set[str] = field(default_factory=set)
+    manager_ids: Set[str] = field(default_factory=set)
+
+
 @dataclass
 class HostConfig:
     """Configuration for a remote host."""
@@ -43,9 +53,12 @@ class GlobalRegistry(Actor):
 
     The GlobalRegistry:
     - Maintains actor name -> endpoint mappings from all Managers
-    - Tracks Manager health via heartbeats (2s interval, 6s timeout)
+    - Tracks Manager health via heartbeats (each Manager states its
+      interval; offline after 3 missed intervals, 6s by default)
     - Provides sync lookup for actors by name
     - Marks actors offline when their Manager misses heartbeats
+    - Pushes ActorMoved / ManagerOnline / ManagerOffline to subscribers
+      through the push callable, so clients need not poll
     - Can restart Managers via SSH + systemctl
 
     Usage:
@@ -56,8 +69,9 @@ class GlobalRegistry(Actor):
         manager.run()
     """
 
-    HEARTBEAT_TIMEOUT_S = 6.0  # 3 missed heartbeats (2s each)
+    HEARTBEAT_TIMEOUT_S = 6.0  # For managers that don't state an interval
     HEARTBEAT_CHECK_INTERVAL_S = 1.0
+    HEARTBEAT_MISS_THRESHOLD = 3  # Missed intervals before a manager is offline
 
     def __init__(self, config_path: Optional[str] = None):
         super().__init__()
@@ -68,9 +82,19 @@ class GlobalRegistry(Actor):
         # manager_id -> last_heartbeat_time (monotonic)
         self._heartbeats: Dict[str, float] = {}
 
+        # manager_id -> heartbeat interval it announced (seconds)
+        self._intervals: Dict[str, float] = {}
+
         # manager_id -> set of actor_names
         self._manager_actors: Dict[str, Set[str]] = {}
 
+        # (subscriber, subscriber_endpoint) -> Subscription
+        self._subscriptions: Dict[Tuple[str, str], Subscription] = {}
+
+        # push(subscriber, endpoint, event) delivers an event; run_registry
+        # sends it over ZMQ, tests record it
+        self.push: Optional[Callable[[str, str, object], None]] = None
+
         # Host configuration for SSH control
         self._hosts: Dict[str, HostConfig] = {}
 
@@ -95,6 +119,12 @@ class GlobalRegistry(Actor):
         with open(path) as f:
             config = json.load(f)
 
+        self.HEARTBEAT_TIMEOUT_S = config.get("heartbeat_timeout_s", self.HEARTBEAT_TIMEOUT_S)
+        self.HEARTBEAT_CHECK_INTERVAL_S = config.get(
+            "heartbeat_check_interval_s", self.HEARTBEAT_CHECK_INTERVAL_S)
+        self.HEARTBEAT_MISS_THRESHOLD = config.get(
+            "heartbeat_miss_threshold", self.HEARTBEAT_MISS_THRESHOLD)
+
         for host_id, host_data in config.get("hosts", {}).items():
             self._hosts[host_id] = HostConfig(
                 ssh=host_data.get("ssh", ""),
@@ -136,7 +166,7 @@ class GlobalRegistry(Actor):
         stale_managers = []
 
         for manager_id, last_hb in self._heartbeats.items():
-            if now - last_hb > self.HEARTBEAT_TIMEOUT_S:
+            if now - last_hb > self.heartbeat_timeout(manager_id):
                 stale_managers.append(manager_id)
 
         for manager_id in stale_managers:
@@ -148,6 +178,9 @@ class GlobalRegistry(Actor):
         # Get actors for this manager
         actor_names = self._manager_actors.pop(manager_id, set())
 
+        self._notify_manager(ManagerOffline(manager_id=manager_id, actor_names=sorted(actor_names)),
+                             manager_id, actor_names)
+
         # Remove each actor from registry
         for actor_name in actor_names:
             if actor_name in self._registry:
@@ -156,13 +189,86 @@ class GlobalRegistry(Actor):
 
         # Remove heartbeat tracking
         self._heartbeats.pop(manager_id, None)
+        self._intervals.pop(manager_id, None)
+
+    def heartbeat_timeout(self, manager_id: str) -> float:
+        """Seconds of silence after which manager_id counts as offline."""
+        interval = self._intervals.get(manager_id)
+        if interval is None:
+            return self.HEARTBEAT_TIMEOUT_S
+        return interval * self.HEARTBEAT_MISS_THRESHOLD
 
     def is_manager_online(self, manager_id: str) -> bool:
         """Check if a manager has recent heartbeat."""
         if manager_id not in self._heartbeats:
             return False
         elapsed = time.monotonic() - self._heartbeats[manager_id]
-        return elapsed < self.HEARTBEAT_TIMEOUT_S
+        return elapsed < self.heartbeat_timeout(manager_id)
+
+    def heartbeat(self, manager_id: str, interval_ms: Optional[int] = None) -> None:
+        """Record a heartbeat; pushes ManagerOnline if manager_id was offline."""
+        was_online = self.is_manager_online(manager_id)
+        self._heartbeats[manager_id] = time.monotonic()
+        if interval_ms:
+            self._intervals[manager_id] = interval_ms / 1000.0
+        if not was_online:
+            self._notify_manager(ManagerOnline(manager_id=manager_id), manager_id,
+                                 self._manager_actors.get(manager_id, set()))
+
+    def unregister(self, actor_name: str) -> bool:
+        """Unregister one actor. Returns False if it was not registered."""
+        entry = self._registry.pop(actor_name, None)
+        if entry is None:
+            return False
+
+        # Remove from manager's actor set
+        if entry.manager_id in self._manager_actors:
+            self._manager_actors[entry.manager_id].discard(actor_name)
+
+        self._notify_actor(ActorMoved(actor_name=actor_name, actor_endpoint=""), actor_name)
+        return True
+
+    # Subscriptions
+
+    def subscribe(self, msg: SubscribeRegistry) -> SubscriptionOk:
+        """Add msg's actors and managers to its subscriber's subscription."""
+        key = (msg.subscriber, msg.subscriber_endpoint)
+        sub = self._subscriptions.setdefault(key, Subscription())
+        sub.actor_names.update(msg.actor_names)
+        sub.manager_ids.update(msg.manager_ids)
+        logger.info(f"'{msg.subscriber}' at {msg.subscriber_endpoint} subscribed to "
+                    f"{len(sub.actor_names)} actors, {len(sub.manager_ids)} managers")
+        return SubscriptionOk(subscriber=msg.subscriber)
+
+    def unsubscribe(self, msg: UnsubscribeRegistry) -> SubscriptionOk:
+        """Remove msg's actors and managers, or the whole subscription if both are empty."""
+        key = (msg.subscriber, msg.subscriber_endpoint)
+        sub = self._subscriptions.get(key)
+        if sub is not None:
+            sub.actor_names.difference_update(msg.actor_names)
+            sub.manager_ids.difference_update(msg.manager_ids)
+            if not (msg.actor_names or msg.manager_ids) or not (sub.actor_names or sub.manager_ids):
+                del self._subscriptions[key]
+        return SubscriptionOk(subscriber=msg.subscriber)
+
+    def _notify_actor(self, event, actor_name: str) -> None:
+        """Push event to everyone subscribed to actor_name."""
+        self._notify(event, lambda sub: actor_name in sub.actor_names)
+
+    def _notify_manager(self, event, manager_id: str, actor_names: Set[str]) -> None:
+        """Push event to everyone subscribed to manager_id or one of its actors."""
+        self._notify(event, lambda sub: manager_id in sub.manager_ids
+                     or not sub.actor_names.isdisjoint(actor_names))
+
+    def _notify(self, event, wants) -> None:
+        if self.push is None:
+            return
+        for (subscriber, endpoint), sub in list(self._subscriptions.items()):
+            if wants(sub):
+                try:
+                    self.push(subscriber, endpoint, event)
+                except Exception as e:
+                    logger.warning(f"Push to '{subscriber}' at {endpoint} failed: {e}")
 
     def lookup(self, actor_name: str) -> Optional[str]:
         """Synchronous lookup - returns endpoint or None."""
@@ -179,46 +285,64 @@ class GlobalRegistry(Actor):
         """Get list of all registered manager IDs."""
         return list(self._manager_actors.keys())
 
+    def register(self, manager_id: str, actor_name: str, endpoint: str) -> Optional[str]:
+        """Register one actor. Returns None on success, else the failure reason."""
+        if actor_name in self._registry:
+            logger.warning(f"Registration failed: '{actor_name}' already registered")
+            return "Name already registered"
+
+        # Register the actor
+        self._registry[actor_name] = ActorEntry(
+            endpoint=endpoint,
+            manager_id=manager_id
+        )
+
+        # Track which actors belong to which manager
+        if manager_id not in self._manager_actors:
+            self._manager_actors[manager_id] = set()
+        self._manager_actors[manager_id].add(actor_name)
+
+        # Registration counts as heartbeat
+        self.heartbeat(manager_id)
+        self._notify_actor(ActorMoved(actor_name=actor_name, actor_endpoint=endpoint), actor_name)
+        return None
+
+    def register_all(self, msg: RegisterActors) -> RegisterActorsResult:
+        """Register each actor of a RegisterActors batch."""
+        failed = []
+        for actor_name, endpoint in msg.actors:
+            reason = self.register(msg.manager_id, actor_name, endpoint)
+            if reason is not None:
+                failed.append((actor_name, reason))
+        registered = len(msg.actors) - len(failed)
+        logger.info(f"Registered {registered} of {len(msg.actors)} actors from manager '{msg.manager_id}'")
+        return RegisterActorsResult(registered=registered, failed=failed)
+
     # Message handlers
 
     def _on_register(self, msg: RegisterActor, ctx) -> None:
         """Handle actor registration."""
-        if msg.actor_name in self._registry:
-            logger.warning(f"Registration failed: '{msg.actor_name}' already registered")
+        reason = self.register(msg.manager_id, msg.actor_name, msg.actor_endpoint)
+        if reason is not None:
             ctx.reply(RegistrationFailed(
                 actor_name=msg.actor_name,
-                reason="Name already registered"
+                reason=reason
             ))
             return
 
-        # Register the actor
-        self._registry[msg.actor_name] = ActorEntry(
-            endpoint=msg.actor_endpoint,
-            manager_id=msg.manager_id
-        )
-
-        # Track which actors belong to which manager
-        if msg.manager_id not in self._manager_actors:
-            self._manager_actors[msg.manager_id] = set()
-        self._manager_actors[msg.manager_id].add(msg.actor_name)
-
-        # Registration counts as heartbeat
-        self._heartbeats[msg.manager_id] = time.monotonic()
-
         logger.info(f"Registered '{msg.actor_name}' from manager '{msg.manager_id}'")
         ctx.reply(RegistrationOk(actor_name=msg.actor_name))
 
+    def _on_register_actors(self, msg: RegisterActors, ctx) -> None:
+        """Handle bulk actor registration."""
+        ctx.reply(self.register_all(msg))
+
     def _on_unregister(self, msg: UnregisterActor, ctx) -> None:
         """Handle actor unregistration."""
-        entry = self._registry.pop(msg.actor_name, None)
-        if entry is None:
+        if not self.unregister(msg.actor_name):
             logger.warning(f"Unregister failed: '{msg.actor_name}' not found")
             return
 
-        # Remove from manager's actor set
-        if entry.manager_id in self._manager_actors:
-            self._manager_actors[entry.manager_id].discard(msg.actor_name)
-
         logger.info(f"Unregistered '{msg.actor_name}'")
 
     def _on_lookup(self, msg: LookupActor, ctx) -> None:
@@ -242,9 +366,17 @@ class GlobalRegistry(Actor):
 
     def _on_heartbeat(self, msg: Heartbeat, ctx) -> None:
         """Handle heartbeat from manager."""
-        self._heartbeats[msg.manager_id] = time.monotonic()
+        self.heartbeat(msg.manager_id, msg.interval_ms)
         ctx.reply(HeartbeatAck())
 
+    def _on_subscribe(self, msg: SubscribeRegistry, ctx) -> None:
+        """Handle a liveness subscription."""
+        ctx.reply(self.subscribe(msg))
+
+    def _on_unsubscribe(self, msg: UnsubscribeRegistry, ctx) -> None:
+        """Handle removal of a liveness subscription."""
+        ctx.reply(self.unsubscribe(msg))
+
     # Process management via SSH
 
     def _on_start_manager(self, msg: StartManager, ctx) -> None:
@@ -333,9 +465,11 @@ def run_registry(endpoint: str = "tcp://0.0.0.0:5555", config_path: str = None):
     import zmq
     import signal
     from .registry_messages import (
-        RegisterActor, UnregisterActor, LookupActor, Heartbeat,
-        RegistrationOk, RegistrationFailed, LookupResult, HeartbeatAck
+        RegisterActor, RegisterActors, UnregisterActor, LookupActor, Heartbeat,
+        RegistrationOk, RegistrationFailed, LookupResult, HeartbeatAck,
+        SubscribeRegistry, UnsubscribeRegistry
     )
+    from .remote import ZmqSender
 
     logging.basicConfig(
         level=logging.INFO,
@@ -353,6 +487,11 @@ def run_registry(endpoint: str = "tcp://0.0.0.0:5555", config_path: str = None):
     socket = context.socket(zmq.REP)
     socket.bind(endpoint)
 
+    # Events go to subscribers as ordinary actor messages over PUSH sockets
+    push_sender = ZmqSender(context)
+    registry.push = lambda subscriber, sub_endpoint, event: push_sender.send_to(
+        sub_endpoint, subscriber, event, None)
+
     running = True
 
     def signal_handler(sig, frame):
@@ -381,28 +520,26 @@ def run_registry(endpoint: str = "tcp://0.0.0.0:5555", config_path: str = None):
                         actor_name=msg_json['actor_name'],
                         actor_endpoint=msg_json['actor_endpoint']
                     )
-                    if msg.actor_name in registry._registry:
+                    reason = registry.register(msg.manager_id, msg.actor_name, msg.actor_endpoint)
+                    if reason is not None:
                         reply = RegistrationFailed(
                             actor_name=msg.actor_name,
-                            reason="Name already registered"
+                            reason=reason
                         )
                     else:
-                        registry._registry[msg.actor_name] = ActorEntry(
-                            endpoint=msg.actor_endpoint,
-                            manager_id=msg.manager_id
-                        )
-                        if msg.manager_id not in registry._manager_actors:
-                            registry._manager_actors[msg.manager_id] = set()
-                        registry._manager_actors[msg.manager_id].add(msg.actor_name)
-                        registry._heartbeats[msg.manager_id] = time.monotonic()
                         logger.info(f"Registered '{msg.actor_name}' from '{msg.manager_id}'")
                         reply = RegistrationOk(actor_name=msg.actor_name)
 
+                elif msg_type == 'RegisterActors':
+                    msg = RegisterActors(
+                        manager_id=msg_json['manager_id'],
+                        actors=[(a['actor_name'], a['actor_endpoint']) for a in msg_json['actors']]
+                    )
+                    reply = registry.register_all(msg)
+
                 elif msg_type == 'UnregisterActor':
                     actor_name = msg_json['actor_name']
-                    entry = registry._registry.pop(actor_name, None)
-                    if entry and entry.manager_id in registry._manager_actors:
-                        registry._manager_actors[entry.manager_id].discard(actor_name)
+                    registry.unregister(actor_name)
                     logger.info(f"Unregistered '{actor_name}'")
                     reply = RegistrationOk(actor_name=actor_name)
 
@@ -424,10 +561,21 @@ def run_registry(endpoint: str = "tcp://0.0.0.0:5555", config_path: str = None):
                         )
 
                 elif msg_type == 'Heartbeat':
-                    manager_id = msg_json['manager_id']
-                    registry._heartbeats[manager_id] = time.monotonic()
+                    registry.heartbeat(msg_json['manager_id'], msg_json.get('interval_ms'))
                     reply = HeartbeatAck()
 
+                elif msg_type in ('SubscribeRegistry', 'UnsubscribeRegistry'):
+                    fields = dict(
+                        subscriber=msg_json['subscriber'],
+                        subscriber_endpoint=msg_json['subscriber_endpoint'],
+                        actor_names=msg_json.get('actor_names', []),
+                        manager_ids=msg_json.get('manager_ids', [])
+                    )
+                    if msg_type == 'SubscribeRegistry':
+                        reply = registry.subscribe(SubscribeRegistry(**fields))
+                    else:
+                        reply = registry.unsubscribe(UnsubscribeRegistry(**fields))
+
                 else:
                     logger.warning(f"Unknown message type: {msg_type}")
                     reply = {'error': f'Unknown message type: {msg_type}'}
@@ -445,6 +593,7 @@ def run_registry(endpoint: str = "tcp://0.0.0.0:5555", config_path: str = None):
 
     # Cleanup
     registry.end()
+    push_sender.close()
     socket.close()
     context.term()
     logger.info("GlobalRegistry stopped")
@@ -8,12 +8,13 @@ Copyright 2025 Vincent Maciejewski, & M2 Tech
 import json
 import threading
 import time
-from typing import Optional, Tuple
+from typing import List, Optional, Tuple
 
 import zmq
 
 from .registry_messages import (
-    RegisterActor, LookupActor, Heartbeat
+    RegisterActor, RegisterActors, LookupActor, Heartbeat,
+    SubscribeRegistry, UnsubscribeRegistry
 )
 
 
@@ -53,9 +54,10 @@ class RegistryClient:
     """Client for communicating with the GlobalRegistry.
 
     The RegistryClient:
-    - Sends heartbeats every 2 seconds in a background thread
+    - Sends heartbeats every 2 seconds (heartbeat_interval_s) in a background thread
     - Provides sync lookup for actors by name
     - Handles registration of local actors
+    - Subscribes actors to pushed liveness events
 
     Example:
         client = RegistryClient("MyManager", "tcp://localhost:5555")
@@ -67,20 +69,27 @@ class RegistryClient:
         # Lookup a remote actor
         endpoint = client.lookup("OtherActor")
 
+        # Have ActorMoved / ManagerOffline / ManagerOnline pushed to a local actor
+        client.subscribe("Watcher", "tcp://localhost:5001", actor_names=["OtherActor"])
+
         client.stop_heartbeat()
     """
 
     HEARTBEAT_INTERVAL_S = 2.0
 
-    def __init__(self, manager_id: str, registry_endpoint: str):
+    def __init__(self, manager_id: str, registry_endpoint: str,
+                 heartbeat_interval_s: float = HEARTBEAT_INTERVAL_S):
         """Create a new registry client.
 
         Args:
             manager_id: Unique identifier for this manager
             registry_endpoint: ZMQ endpoint of the GlobalRegistry (e.g., "tcp://localhost:5555")
+            heartbeat_interval_s: Time between heartbeats; sent with each one so
+                the registry times this manager out after missed intervals
         """
         self.manager_id = manager_id
         self.registry_endpoint = registry_endpoint
+        self.heartbeat_interval_s = heartbeat_interval_s
 
         self._context = zmq.Context.instance()
         self._socket: Optional[zmq.Socket] = None
@@ -128,13 +137,14 @@ class RegistryClient:
         """Background thread that sends heartbeats."""
         while self._running:
             try:
-                hb = Heartbeat(manager_id=self.manager_id)
+                hb = Heartbeat(manager_id=self.manager_id,
+                               interval_ms=int(self.heartbeat_interval_s * 1000))
                 self._send_recv(hb.to_dict())
             except Exception as e:
                 # Log but don't crash on heartbeat failures
                 pass
 
-            time.sleep(self.HEARTBEAT_INTERVAL_S)
+            time.sleep(self.heartbeat_interval_s)
 
     def register(self, actor_name: str, endpoint: str) -> None:
         """Register an actor with the GlobalRegistry.
@@ -168,6 +178,36 @@ class RegistryClient:
         else:
             raise RegistryError(f"Unexpected response: {reply}")
 
+    def register_actors(self, actor_names: List[str], endpoint: str) -> List[Tuple[str, str]]:
+        """Register several actors reachable at endpoint in one round trip.
+
+        The registry handles each name separately, so some may fail while
+        the rest are registered.
+
+        Args:
+            actor_names: Unique names for the actors
+            endpoint: ZMQ endpoint where the actors can be reached
+
+        Returns:
+            (actor_name, reason) for each actor the registry rejected
+
+        Raises:
+            TimeoutError: If no response from registry
+        """
+        msg = RegisterActors(
+            manager_id=self.manager_id,
+            actors=[(name, endpoint) for name in actor_names]
+        )
+
+        try:
+            reply = self._send_recv(msg.to_dict())
+        except zmq.Again:
+            raise TimeoutError("No response from registry for bulk registration")
+
+        if reply.get('message_type') != 'RegisterActorsResult':
+            raise RegistryError(f"Unexpected response: {reply}")
+        return [(f.get('actor_name', ''), f.get('reason', 'Unknown')) for f in reply.get('failed', [])]
+
     def lookup(self, actor_name: str) -> str:
         """Lookup an actor by name.
 
@@ -234,6 +274,57 @@ class RegistryClient:
         else:
             raise RegistryError(f"Unexpected response: {reply}")
 
+    def subscribe(self, subscriber: str, endpoint: str,
+                  actor_names: Optional[List[str]] = None,
+                  manager_ids: Optional[List[str]] = None) -> None:
+        """Have the registry push liveness events to a local actor.
+
+        ActorMoved is pushed for actor_names, and ManagerOnline /
+        ManagerOffline for manager_ids and for the managers of actor_names.
+        Subscribing again adds to the lists.
+
+        Args:
+            subscriber: Name of the actor that receives the events
+            endpoint: ZmqReceiver endpoint where subscriber can be reached
+            actor_names: Actors to watch
+            manager_ids: Managers to watch
+
+        Raises:
+            TimeoutError: If no response from registry
+        """
+        msg = SubscribeRegistry(
+            subscriber=subscriber,
+            subscriber_endpoint=endpoint,
+            actor_names=list(actor_names or []),
+            manager_ids=list(manager_ids or [])
+        )
+        self._subscription_request(msg.to_dict(), "subscription")
+
+    def unsubscribe(self, subscriber: str, endpoint: str,
+                    actor_names: Optional[List[str]] = None,
+                    manager_ids: Optional[List[str]] = None) -> None:
+        """Stop events for actor_names and manager_ids, or for everything if both are empty.
+
+        Raises:
+            TimeoutError: If no response from registry
+        """
+        msg = UnsubscribeRegistry(
+            subscriber=subscriber,
+            subscriber_endpoint=endpoint,
+            actor_names=list(actor_names or []),
+            manager_ids=list(manager_ids or [])
+        )
+        self._subscription_request(msg.to_dict(), "unsubscription")
+
+    def _subscription_request(self, msg: dict, what: str) -> None:
+        try:
+            reply = self._send_recv(msg)
+        except zmq.Again:
+            raise TimeoutError(f"No response from registry for {what}")
+
+        if reply.get('message_type') != 'SubscriptionOk':
+            raise RegistryError(f"Unexpected response: {reply}")
+
     def close(self) -> None:
         """Close the registry client and stop heartbeats."""
         self.stop_heartbeat()
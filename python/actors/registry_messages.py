@@ -5,10 +5,12 @@ THIS SOFTWARE IS OPEN SOURCE UNDER THE MIT LICENSE
 Copyright 2025 Vincent Maciejewski, & M2 Tech
 """
 
-from dataclasses import dataclass, asdict
-from typing import Optional
+from dataclasses import dataclass, asdict, field
+from typing import List, Optional, Tuple
 import time
 
+from .serialization import register_message
+
 
 @dataclass
 class RegisterActor:
@@ -30,6 +32,49 @@ class RegisterActor:
         }
 
 
+@dataclass
+class RegisterActors:
+    """Register many actors in one round trip.
+
+    Sent once by Manager.init() with every managed actor. Each actor is
+    registered as if by its own RegisterActor; one failing does not stop
+    the rest. GlobalRegistry replies with RegisterActorsResult.
+    """
+    manager_id: str
+    actors: List[Tuple[str, str]]  # (actor_name, actor_endpoint)
+
+    def to_dict(self):
+        return {
+            'message_type': 'RegisterActors',
+            'manager_id': self.manager_id,
+            'actors': [
+                {'actor_name': name, 'actor_endpoint': endpoint}
+                for name, endpoint in self.actors
+            ]
+        }
+
+
+@dataclass
+class RegisterActorsResult:
+    """Reply to RegisterActors.
+
+    registered counts the actors that were registered; failed lists the
+    others as (actor_name, reason), empty when all succeeded.
+    """
+    registered: int
+    failed: List[Tuple[str, str]] = field(default_factory=list)
+
+    def to_dict(self):
+        return {
+            'message_type': 'RegisterActorsResult',
+            'registered': self.registered,
+            'failed': [
+                {'actor_name': name, 'reason': reason}
+                for name, reason in self.failed
+            ]
+        }
+
+
 @dataclass
 class UnregisterActor:
     """Remove an actor from the registry.
@@ -115,11 +160,13 @@ class LookupResult:
 class Heartbeat:
     """Manager health check.
 
-    Managers send this every 2 seconds.
-    GlobalRegistry marks Manager offline after 6 seconds without heartbeat.
+    Managers send this every interval_ms (2 seconds by default).
+    GlobalRegistry marks a Manager offline once it misses its configured
+    number of intervals (3 by default, so 6 seconds).
     """
     manager_id: str
     timestamp_ms: int = 0
+    interval_ms: int = 2000
 
     def __post_init__(self):
         if self.timestamp_ms == 0:
@@ -129,7 +176,8 @@ class Heartbeat:
         return {
             'message_type': 'Heartbeat',
             'manager_id': self.manager_id,
-            'timestamp_ms': self.timestamp_ms
+            'timestamp_ms': self.timestamp_ms,
+            'interval_ms': self.interval_ms
         }
 
 
@@ -143,6 +191,114 @@ class HeartbeatAck:
         }
 
 
+# Liveness subscriptions. The pushed events are registered so a
+# ZmqReceiver can deliver them to the subscribing actor.
+
+@dataclass
+class SubscribeRegistry:
+    """Ask GlobalRegistry to push liveness events.
+
+    The registry sends ActorMoved for the listed actors, and ManagerOnline /
+    ManagerOffline for the listed managers and for the managers of the
+    listed actors, to the actor named subscriber at subscriber_endpoint.
+    Subscribing again adds to the lists. Replied to with SubscriptionOk.
+    """
+    subscriber: str
+    subscriber_endpoint: str
+    actor_names: List[str] = field(default_factory=list)
+    manager_ids: List[str] = field(default_factory=list)
+
+    def to_dict(self):
+        return {
+            'message_type': 'SubscribeRegistry',
+            'subscriber': self.subscriber,
+            'subscriber_endpoint': self.subscriber_endpoint,
+            'actor_names': list(self.actor_names),
+            'manager_ids': list(self.manager_ids)
+        }
+
+
+@dataclass
+class UnsubscribeRegistry:
+    """Stop events for the listed actors and managers, or for everything
+    when both lists are empty. Replied to with SubscriptionOk.
+    """
+    subscriber: str
+    subscriber_endpoint: str
+    actor_names: List[str] = field(default_factory=list)
+    manager_ids: List[str] = field(default_factory=list)
+
+    def to_dict(self):
+        return {
+            'message_type': 'UnsubscribeRegistry',
+            'subscriber': self.subscriber,
+            'subscriber_endpoint': self.subscriber_endpoint,
+            'actor_names': list(self.actor_names),
+            'manager_ids': list(self.manager_ids)
+        }
+
+
+@dataclass
+class SubscriptionOk:
+    """Reply to SubscribeRegistry and UnsubscribeRegistry."""
+    subscriber: str
+
+    def to_dict(self):
+        return {
+            'message_type': 'SubscriptionOk',
+            'subscriber': self.subscriber
+        }
+
+
+@register_message
+@dataclass
+class ActorMoved:
+    """Pushed when an actor is unregistered or registered again.
+
+    actor_endpoint is the new endpoint, or empty if the actor is gone.
+    """
+    actor_name: str
+    actor_endpoint: str = ""
+
+    def to_dict(self):
+        return {
+            'message_type': 'ActorMoved',
+            'actor_name': self.actor_name,
+            'actor_endpoint': self.actor_endpoint
+        }
+
+
+@register_message
+@dataclass
+class ManagerOffline:
+    """Pushed when a Manager misses its heartbeats.
+
+    actor_names lists the actors it had registered.
+    """
+    manager_id: str
+    actor_names: List[str] = field(default_factory=list)
+
+    def to_dict(self):
+        return {
+            'message_type': 'ManagerOffline',
+            'manager_id': self.manager_id,
+            'actor_names': list(self.actor_names)
+        }
+
+
+@register_message
+@dataclass
+class ManagerOnline:
+    """Pushed when a Manager first checks in, or comes back after being offline."""
+    manager_id: str
+
+    def to_dict(self):
+        return {
+            'message_type': 'ManagerOnline',
+            'manager_id': self.manager_id
+        }
+
+
 # Process management messages
 
 @dataclass
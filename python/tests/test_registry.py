@@ -4,6 +4,10 @@ import pytest
 import time
 from unittest.mock import patch
 from actors.registry import GlobalRegistry, ActorEntry
+from actors.registry_messages import (
+    RegisterActors, SubscribeRegistry, UnsubscribeRegistry,
+    ActorMoved, ManagerOffline, ManagerOnline
+)
 
 
 class TestGlobalRegistryState:
@@ -93,6 +97,40 @@ class TestGlobalRegistryUnregister:
         assert "mgr2" in registry._manager_actors
 
 
+class TestBulkRegistration:
+    """Tests for RegisterActors handling."""
+
+    def test_register_all_registers_each_actor(self):
+        """register_all() registers every actor in the batch."""
+        registry = GlobalRegistry()
+        result = registry.register_all(RegisterActors(
+            manager_id="mgr1",
+            actors=[("actor1", "tcp://host:5001"), ("actor2", "tcp://host:5001")]
+        ))
+
+        assert result.registered == 2
+        assert result.failed == []
+        assert registry.lookup("actor2") == "tcp://host:5001"
+        assert registry._manager_actors["mgr1"] == {"actor1", "actor2"}
+        assert registry.is_manager_online("mgr1") is True
+
+    def test_register_all_lists_each_failure(self):
+        """A taken name fails on its own; the rest are registered."""
+        registry = GlobalRegistry()
+        registry._registry["actor2"] = ActorEntry("tcp://host:5002", "mgr2")
+
+        result = registry.register_all(RegisterActors(
+            manager_id="mgr1",
+            actors=[("actor1", "tcp://host:5001"), ("actor2", "tcp://host:5001"),
+                    ("actor1", "tcp://host:5001")]
+        ))
+
+        assert result.registered == 1
+        assert result.failed == [("actor2", "Name already registered"),
+                                 ("actor1", "Name already registered")]
+        assert registry.lookup("actor2") == "tcp://host:5002"
+
+
 class TestHeartbeatTimeout:
     """Tests for heartbeat timeout detection."""
 
@@ -125,6 +163,91 @@ class TestHeartbeatTimeout:
         assert "mgr1" in registry._heartbeats
 
 
+class TestPerManagerInterval:
+    """Tests for heartbeat intervals announced by managers."""
+
+    def test_timeout_follows_announced_interval(self):
+        """A manager is offline after HEARTBEAT_MISS_THRESHOLD of its own intervals."""
+        registry = GlobalRegistry()
+        registry.heartbeat("fast", interval_ms=100)
+        registry.heartbeat("default")
+
+        assert registry.heartbeat_timeout("fast") == pytest.approx(0.3)
+        assert registry.heartbeat_timeout("default") == GlobalRegistry.HEARTBEAT_TIMEOUT_S
+
+        registry._heartbeats["fast"] = time.monotonic() - 1
+        registry._heartbeats["default"] = time.monotonic() - 1
+        assert registry.is_manager_online("fast") is False
+        assert registry.is_manager_online("default") is True
+
+
+class TestSubscriptions:
+    """Tests for pushed liveness events."""
+
+    def _registry(self):
+        registry = GlobalRegistry()
+        pushed = []
+        registry.push = lambda subscriber, endpoint, event: pushed.append((subscriber, endpoint, event))
+        return registry, pushed
+
+    def test_actor_subscriber_sees_manager_go_offline(self):
+        """Watching an actor also reports its manager's liveness."""
+        registry, pushed = self._registry()
+        registry.register("mgr1", "actor1", "tcp://host:5001")
+        registry.subscribe(SubscribeRegistry("watcher", "tcp://me:6000", actor_names=["actor1"]))
+
+        registry._heartbeats["mgr1"] = time.monotonic() - 10
+        registry._check_heartbeats()
+
+        assert pushed == [("watcher", "tcp://me:6000", ManagerOffline("mgr1", ["actor1"]))]
+
+    def test_manager_subscriber_sees_return(self):
+        """ManagerOnline is pushed when a manager first checks in, and only then."""
+        registry, pushed = self._registry()
+        registry.subscribe(SubscribeRegistry("watcher", "tcp://me:6000", manager_ids=["mgr1"]))
+
+        registry.heartbeat("mgr1")
+        registry.heartbeat("mgr1")
+        registry.heartbeat("mgr2")
+
+        assert [e for _, _, e in pushed] == [ManagerOnline("mgr1")]
+
+    def test_register_and_unregister_push_actor_moved(self):
+        registry, pushed = self._registry()
+        registry.subscribe(SubscribeRegistry("watcher", "tcp://me:6000", actor_names=["actor1"]))
+
+        registry.register("mgr1", "actor1", "tcp://host:5001")
+        registry.unregister("actor1")
+
+        events = [e for _, _, e in pushed]
+        assert ActorMoved("actor1", "tcp://host:5001") in events
+        assert events[-1] == ActorMoved("actor1", "")
+
+    def test_unsubscribe_stops_events(self):
+        registry, pushed = self._registry()
+        registry.subscribe(SubscribeRegistry("watcher", "tcp://me:6000", manager_ids=["mgr1", "mgr2"]))
+
+        registry.unsubscribe(UnsubscribeRegistry("watcher", "tcp://me:6000", manager_ids=["mgr1"]))
+        registry.heartbeat("mgr1")
+        assert pushed == []
+        registry.heartbeat("mgr2")
+        assert len(pushed) == 1
+
+        registry.unsubscribe(UnsubscribeRegistry("watcher", "tcp://me:6000"))
+        assert registry._subscriptions == {}
+
+    def test_failed_push_does_not_raise(self):
+        registry = GlobalRegistry()
+
+        def fail(subscriber, endpoint, event):
+            raise RuntimeError("unreachable")
+        registry.push = fail
+        registry.subscribe(SubscribeRegistry("watcher", "tcp://me:6000", manager_ids=["mgr1"]))
+
+        registry.heartbeat("mgr1")
+        assert registry.is_manager_online("mgr1") is True
+
+
 class TestGlobalRegistryLifecycle:
     """Tests for GlobalRegistry init/end lifecycle."""
 
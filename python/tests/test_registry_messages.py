@@ -3,8 +3,11 @@
 import pytest
 import time
 from actors.registry_messages import (
-    RegisterActor, UnregisterActor, RegistrationOk, RegistrationFailed,
-    LookupActor, LookupResult, Heartbeat, HeartbeatAck
+    RegisterActor, RegisterActors, RegisterActorsResult,
+    UnregisterActor, RegistrationOk, RegistrationFailed,
+    LookupActor, LookupResult, Heartbeat, HeartbeatAck,
+    SubscribeRegistry, UnsubscribeRegistry, SubscriptionOk,
+    ActorMoved, ManagerOffline, ManagerOnline
 )
 
 
@@ -26,6 +29,32 @@ class TestRegisterActor:
         assert result["actor_endpoint"] == "tcp://localhost:5001"
 
 
+class TestRegisterActors:
+    """Tests for RegisterActors and RegisterActorsResult messages."""
+
+    def test_to_dict_lists_actors(self):
+        msg = RegisterActors(
+            manager_id="mgr1",
+            actors=[("ping", "tcp://localhost:5001"), ("pong", "tcp://localhost:5001")]
+        )
+        result = msg.to_dict()
+
+        assert result["message_type"] == "RegisterActors"
+        assert result["manager_id"] == "mgr1"
+        assert result["actors"][1] == {"actor_name": "pong", "actor_endpoint": "tcp://localhost:5001"}
+
+    def test_result_to_dict(self):
+        msg = RegisterActorsResult(registered=1, failed=[("pong", "Name already registered")])
+        result = msg.to_dict()
+
+        assert result["message_type"] == "RegisterActorsResult"
+        assert result["registered"] == 1
+        assert result["failed"] == [{"actor_name": "pong", "reason": "Name already registered"}]
+
+    def test_result_defaults_to_no_failures(self):
+        assert RegisterActorsResult(registered=3).to_dict()["failed"] == []
+
+
 class TestUnregisterActor:
     """Tests for UnregisterActor message."""
 
@@ -115,6 +144,10 @@ class TestHeartbeat:
 
         assert result["timestamp_ms"] == 12345
 
+    def test_to_dict_includes_interval(self):
+        assert Heartbeat(manager_id="mgr1").to_dict()["interval_ms"] == 2000
+        assert Heartbeat(manager_id="mgr1", interval_ms=500).to_dict()["interval_ms"] == 500
+
 
 class TestHeartbeatAck:
     """Tests for HeartbeatAck message."""
@@ -124,3 +157,35 @@ class TestHeartbeatAck:
         result = msg.to_dict()
 
         assert result["message_type"] == "HeartbeatAck"
+
+class TestSubscriptions:
+    """Tests for liveness subscription messages."""
+
+    def test_subscribe_to_dict(self):
+        msg = SubscribeRegistry(subscriber="watcher", subscriber_endpoint="tcp://host:5001",
+                                actor_names=["actor1"], manager_ids=["mgr1"])
+        result = msg.to_dict()
+
+        assert result["message_type"] == "SubscribeRegistry"
+        assert result["subscriber"] == "watcher"
+        assert result["subscriber_endpoint"] == "tcp://host:5001"
+        assert result["actor_names"] == ["actor1"]
+        assert result["manager_ids"] == ["mgr1"]
+
+    def test_unsubscribe_defaults_to_everything(self):
+        result = UnsubscribeRegistry(subscriber="watcher", subscriber_endpoint="tcp://host:5001").to_dict()
+
+        assert result["message_type"] == "UnsubscribeRegistry"
+        assert result["actor_names"] == []
+        assert result["manager_ids"] == []
+
+    def test_subscription_ok_to_dict(self):
+        assert SubscriptionOk(subscriber="watcher").to_dict() == {
+            "message_type": "SubscriptionOk", "subscriber": "watcher"}
+
+    def test_events_to_dict(self):
+        assert ActorMoved(actor_name="actor1").to_dict()["actor_endpoint"] == ""
+        assert ManagerOffline(manager_id="mgr1", actor_names=["actor1"]).to_dict() == {
+            "message_type": "ManagerOffline", "manager_id": "mgr1", "actor_names": ["actor1"]}
+        assert ManagerOnline(manager_id="mgr1").to_dict() == {
+            "message_type": "ManagerOnline", "manager_id": "mgr1"}
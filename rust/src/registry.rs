@@ -16,6 +16,10 @@ use serde_json::json;
 use tokio::runtime::Runtime;
 use zeromq::{ReqSocket, Socket, SocketRecv, SocketSend};
 
+/// Time between heartbeats; sent with each one so the registry can time
+/// this manager out after missed intervals.
+const HEARTBEAT_INTERVAL: Duration = Duration::from_secs(2);
+
 /// Error types for registry operations.
 #[derive(Debug, Clone)]
 pub enum RegistryError {
@@ -178,7 +182,8 @@ impl RegistryClient {
                     let msg = json!({
                         "message_type": "Heartbeat",
                         "manager_id": manager_id,
-                        "timestamp_ms": timestamp_ms
+                        "timestamp_ms": timestamp_ms,
+                        "interval_ms": HEARTBEAT_INTERVAL.as_millis() as u64
                     });
 
                     let data = msg.to_string().into_bytes();
@@ -186,8 +191,7 @@ impl RegistryClient {
                         let _ = socket.recv().await; // Ignore reply
                     }
 
-                    // Sleep for 2 seconds
-                    tokio::time::sleep(Duration::from_secs(2)).await;
+                    tokio::time::sleep(HEARTBEAT_INTERVAL).await;
                 }
             });
         });
@@ -238,6 +242,47 @@ impl RegistryClient {
         }
     }
 
+    /// Register several actors reachable at one endpoint in one round trip.
+    ///
+    /// The registry handles each name separately, so some may fail while
+    /// the rest are registered.
+    ///
+    /// # Arguments
+    /// * `actor_names` - Unique names for the actors
+    /// * `endpoint` - ZMQ endpoint where the actors can be reached
+    ///
+    /// # Returns
+    /// * `Ok(failed)` with (actor_name, reason) for each rejected actor
+    /// * `Err(RegistryError)` if the registry did not answer
+    pub fn register_actors(&self, actor_names: &[&str], endpoint: &str) -> Result<Vec<(String, String)>, RegistryError> {
+        let actors: Vec<serde_json::Value> = actor_names
+            .iter()
+            .map(|name| json!({ "actor_name": name, "actor_endpoint": endpoint }))
+            .collect();
+        let msg = json!({
+            "message_type": "RegisterActors",
+            "manager_id": self.manager_id,
+            "actors": actors
+        });
+
+        let reply = self.send_recv(msg)?;
+
+        match reply.get("message_type").and_then(|v| v.as_str()) {
+            Some("RegisterActorsResult") => {
+                let failed = reply.get("failed")
+                    .and_then(|v| v.as_array())
+                    .map(|items| items.iter().map(|f| {
+                        let name = f.get("actor_name").and_then(|v| v.as_str()).unwrap_or("");
+                        let reason = f.get("reason").and_then(|v| v.as_str()).unwrap_or("Unknown");
+                        (name.to_string(), reason.to_string())
+                    }).collect())
+                    .unwrap_or_default();
+                Ok(failed)
+            }
+            _ => Err(RegistryError::ConnectionError("Unexpected response".to_string())),
+        }
+    }
+
     /// Lookup an actor by name.
     ///
     /// # Arguments
@@ -363,6 +408,24 @@ mod tests {
         assert_eq!(msg["actor_endpoint"], "tcp://localhost:5001");
     }
 
+    #[test]
+    fn test_register_actors_message_format() {
+        let actors: Vec<serde_json::Value> = ["ping", "pong"]
+            .iter()
+            .map(|name| json!({ "actor_name": name, "actor_endpoint": "tcp://localhost:5001" }))
+            .collect();
+        let msg = json!({
+            "message_type": "RegisterActors",
+            "manager_id": "mgr1",
+            "actors": actors
+        });
+
+        assert_eq!(msg["message_type"], "RegisterActors");
+        assert_eq!(msg["actors"].as_array().unwrap().len(), 2);
+        assert_eq!(msg["actors"][1]["actor_name"], "pong");
+        assert_eq!(msg["actors"][1]["actor_endpoint"], "tcp://localhost:5001");
+    }
+
     #[test]
     fn test_lookup_message_format() {
         let msg = json!({
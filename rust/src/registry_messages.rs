@@ -23,6 +23,26 @@ pub struct RegisterActor {
 }
 define_message!(RegisterActor);
 
+/// RegisterActors - Register many actors in one round trip
+///
+/// Each actor is registered as if by its own RegisterActor; one failing
+/// does not stop the rest. GlobalRegistry replies with RegisterActorsResult.
+pub struct RegisterActors {
+    pub manager_id: String,
+    pub actors: Vec<(String, String)>,  // (actor_name, actor_endpoint)
+}
+define_message!(RegisterActors);
+
+/// RegisterActorsResult - Reply to RegisterActors
+///
+/// `registered` counts the actors that were registered; `failed` lists the
+/// others as (actor_name, reason), empty when all succeeded.
+pub struct RegisterActorsResult {
+    pub registered: usize,
+    pub failed: Vec<(String, String)>,
+}
+define_message!(RegisterActorsResult);
+
 /// UnregisterActor - Remove an actor from the registry
 ///
 /// Sent when an actor is stopped or Manager shuts down.